@@ -0,0 +1,235 @@
+// ============================================================================
+// CAPTURE_SCHEDULER.CPP - Deadline-based capture scheduling
+// ============================================================================
+
+#include "capture_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace {
+
+int64_t SteadyClockMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Idle gaps (nothing submitted for a while) shouldn't inflate the tick estimate
+constexpr int64_t MAX_TICK_SAMPLE_US = 100000;
+
+int64_t PeriodForFps(int fps) { return fps > 0 ? (1000000 + fps / 2) / fps : 0; }
+
+// Grid point k of a rate is k seconds / fps, measured from the clock epoch and rounded down. Every point is
+// computed exactly from k, so grids of related rates (30 and 20 fps every 100 ms) coincide no matter how far
+// the clock is from its epoch, and every scheduler instance shares them.
+int64_t GridTimeUs(int fps, int64_t k) { return k * 1000000 / fps; }
+
+// Index of the last grid point at or before t
+int64_t GridIndexAtOrBefore(int fps, int64_t t) {
+    const int64_t scaled = t * fps;
+    int64_t k = scaled / 1000000;
+    if (scaled < 0 && scaled % 1000000 != 0) { k--; }
+    while (GridTimeUs(fps, k + 1) <= t) k++; // Rounding of GridTimeUs
+    return k;
+}
+
+} // namespace
+
+CaptureScheduler::CaptureScheduler(ClockFn clock) : m_clock(clock ? std::move(clock) : ClockFn(SteadyClockMicros)) {}
+
+void CaptureScheduler::SetRates(const std::vector<std::pair<std::string, int>>& rates) {
+    if (rates.size() == m_elements.size()) {
+        bool unchanged = true;
+        for (size_t i = 0; i < rates.size() && unchanged; i++) {
+            unchanged = rates[i].first == m_elements[i].key && rates[i].second == m_elements[i].fps;
+        }
+        if (unchanged) return;
+    }
+
+    // Configs changed (rare): carry elements over by key, then rebuild the heap for the new indices
+    const int64_t now = m_clock();
+    std::vector<Element> previous = std::move(m_elements);
+    std::vector<bool> taken(previous.size(), false);
+    m_elements.assign(rates.size(), Element{});
+    m_heap.clear();
+    m_dueIndices.clear();
+
+    for (size_t i = 0; i < rates.size(); i++) {
+        const auto& [key, fps] = rates[i];
+        Element& e = m_elements[i];
+        bool carried = false;
+        for (size_t j = 0; j < previous.size(); j++) {
+            if (taken[j] || previous[j].key != key) continue;
+            taken[j] = true;
+            if (previous[j].fps == fps) {
+                e = std::move(previous[j]);
+                e.generation++; // Old heap entries are gone; Schedule() pushes a fresh one
+                carried = true;
+            }
+            break;
+        }
+        if (!carried) {
+            // New or retuned: restart statistics and capture on the next tick, on the new grid
+            e.key = key;
+            e.fps = fps;
+            e.periodUs = PeriodForFps(fps);
+            if (e.periodUs > 0) {
+                e.gridIndex = GridIndexAtOrBefore(fps, now);
+                e.deadlineUs = GridTimeUs(fps, e.gridIndex);
+            }
+        }
+        if (!e.due) Schedule(i);
+        if (e.due) m_dueIndices.push_back(i);
+    }
+}
+
+void CaptureScheduler::RequestImmediate(size_t index) {
+    if (index < m_elements.size()) { m_elements[index].immediate = true; }
+}
+
+int64_t CaptureScheduler::ToleranceUs(const Element& e) const { return (std::min)(m_tickIntervalUs / 2, e.periodUs / 2); }
+
+void CaptureScheduler::Schedule(size_t index) {
+    const Element& e = m_elements[index];
+    if (e.periodUs <= 0) return; // Every-tick elements never wait on the heap
+    m_heap.push_back({ e.deadlineUs, index, e.generation });
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+}
+
+size_t CaptureScheduler::CollectDue() {
+    const int64_t now = m_clock();
+    if (m_lastTickUs >= 0) {
+        const int64_t dt = (std::min)(now - m_lastTickUs, MAX_TICK_SAMPLE_US);
+        m_tickIntervalUs = (m_tickIntervalUs == 0) ? dt : (m_tickIntervalUs * 7 + dt) / 8;
+    }
+    m_lastTickUs = now;
+
+    for (auto& e : m_elements) {
+        if (e.periodUs <= 0 || e.immediate) { e.due = true; }
+    }
+
+    // Pop every deadline that falls closer to this tick than to the next one
+    m_notYet.clear();
+    while (!m_heap.empty() && m_heap.front().deadlineUs <= now + m_tickIntervalUs / 2) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+        const HeapEntry top = m_heap.back();
+        m_heap.pop_back();
+
+        Element& e = m_elements[top.index];
+        if (e.generation != top.generation) continue; // Stale entry
+        if (top.deadlineUs <= now + ToleranceUs(e)) {
+            e.due = true;
+        } else {
+            m_notYet.push_back(top); // Within half a tick, but more than half its own period early
+        }
+    }
+    for (const auto& entry : m_notYet) {
+        m_heap.push_back(entry);
+        std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+    }
+
+    m_dueIndices.clear();
+    for (size_t i = 0; i < m_elements.size(); i++) {
+        if (m_elements[i].due) { m_dueIndices.push_back(i); }
+    }
+    return m_dueIndices.size();
+}
+
+void CaptureScheduler::MarkCaptured(size_t index) {
+    if (index >= m_elements.size()) return;
+    Element& e = m_elements[index];
+    const int64_t now = m_clock();
+
+    if (e.lastCaptureUs >= 0) {
+        const double interval = static_cast<double>(now - e.lastCaptureUs);
+        e.intervals++;
+        e.sumIntervalUs += interval;
+        if (e.periodUs > 0) {
+            const double jitter = std::fabs(interval - static_cast<double>(e.periodUs));
+            e.sumJitterUs += jitter;
+            e.maxJitterUs = (std::max)(e.maxJitterUs, jitter);
+        }
+    }
+    e.lastCaptureUs = now;
+    e.captures++;
+
+    const bool servedDeadline = e.due && !(e.immediate && e.deadlineUs > now + ToleranceUs(e));
+    e.due = false;
+    e.immediate = false;
+    e.generation++; // Drops any heap entry left over from an immediate request
+    if (e.periodUs > 0) {
+        // Advance one grid point from the served deadline; an immediate capture ahead of its deadline keeps it.
+        // If that point would already be due (first capture, or a capture late by most of a period after a
+        // stall), move to the first point after this tick's tolerance window instead of capturing again on
+        // the next tick.
+        if (servedDeadline) { e.gridIndex++; }
+        e.deadlineUs = GridTimeUs(e.fps, e.gridIndex);
+        if (e.deadlineUs <= now + ToleranceUs(e)) {
+            e.gridIndex = GridIndexAtOrBefore(e.fps, now + ToleranceUs(e)) + 1;
+            e.deadlineUs = GridTimeUs(e.fps, e.gridIndex);
+        }
+        Schedule(index);
+    }
+}
+
+int64_t CaptureScheduler::MicrosUntilNextDeadline() const {
+    int64_t earliest = -1;
+    for (const auto& e : m_elements) {
+        if (e.due || e.immediate || e.periodUs <= 0) return 0;
+    }
+    for (const auto& entry : m_heap) {
+        if (m_elements[entry.index].generation != entry.generation) continue;
+        if (earliest < 0 || entry.deadlineUs < earliest) { earliest = entry.deadlineUs; }
+    }
+    if (earliest < 0) return -1;
+    return (std::max)(earliest - m_clock(), static_cast<int64_t>(0));
+}
+
+bool CaptureScheduler::GetStats(size_t index, CaptureScheduleStats& out) const {
+    if (index >= m_elements.size()) return false;
+    const Element& e = m_elements[index];
+    out = CaptureScheduleStats{};
+    out.targetFps = e.fps;
+    out.captures = e.captures;
+    if (e.intervals > 0) {
+        out.meanIntervalMs = e.sumIntervalUs / static_cast<double>(e.intervals) / 1000.0;
+        out.meanJitterMs = e.sumJitterUs / static_cast<double>(e.intervals) / 1000.0;
+        out.maxJitterMs = e.maxJitterUs / 1000.0;
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, CaptureScheduleStats>> CaptureScheduler::GetAllStats() const {
+    std::vector<std::pair<std::string, CaptureScheduleStats>> result;
+    result.reserve(m_elements.size());
+    for (size_t i = 0; i < m_elements.size(); i++) {
+        CaptureScheduleStats stats;
+        GetStats(i, stats);
+        result.emplace_back(m_elements[i].key, stats);
+    }
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return result;
+}
+
+// ============================================================================
+// Published statistics
+// ============================================================================
+
+static std::mutex g_captureScheduleStatsMutex;
+static std::map<std::string, std::vector<std::pair<std::string, CaptureScheduleStats>>> g_captureScheduleStats;
+
+void PublishCaptureScheduleStats(const std::string& source, std::vector<std::pair<std::string, CaptureScheduleStats>> stats) {
+    std::lock_guard<std::mutex> lock(g_captureScheduleStatsMutex);
+    if (stats.empty()) {
+        g_captureScheduleStats.erase(source);
+    } else {
+        g_captureScheduleStats[source] = std::move(stats);
+    }
+}
+
+std::vector<std::pair<std::string, std::vector<std::pair<std::string, CaptureScheduleStats>>>> GetCaptureScheduleStats() {
+    std::lock_guard<std::mutex> lock(g_captureScheduleStatsMutex);
+    return { g_captureScheduleStats.begin(), g_captureScheduleStats.end() };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+// ============================================================================
+// CAPTURE_SCHEDULER.H - Deadline-based capture scheduling for mirrors and window overlays
+// ============================================================================
+// Each scheduled element (a mirror or a window overlay) has a target rate. Its
+// capture deadlines sit on a fixed grid (k seconds / fps, measured from the
+// clock epoch), so elements with related rates (e.g. 30 and 20 fps)
+// come due on the same ticks and their captures are batched together.
+//
+// The owner calls CollectDue() once per tick (the mirror thread once per game
+// frame). Deadlines closer than half a tick are treated as due now: they are
+// closer to this frame than to the next one. MarkCaptured() moves an element's
+// deadline to the next grid point after the one it served and records the
+// interval it actually got, which is reported as jitter against its target rate.
+//
+// Captures can only happen on ticks, so when the tick rate is not a multiple of
+// an element's rate its intervals alternate between neighbouring tick counts:
+// expect jitter up to one tick interval (16.7 ms at 60 fps), more if the owner
+// skips ticks.
+//
+// The clock is injectable (microseconds, monotonic) so the scheduler can be
+// driven by a simulated clock; it has no Windows or GL dependency.
+// ============================================================================
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct CaptureScheduleStats {
+    int targetFps = 0;              // <= 0: captured on every tick
+    uint64_t captures = 0;          // Since the rate was last changed
+    double meanIntervalMs = 0.0;    // Average time between captures
+    double meanJitterMs = 0.0;      // Average |interval - target interval|
+    double maxJitterMs = 0.0;       // Worst |interval - target interval|
+};
+
+class CaptureScheduler {
+public:
+    using ClockFn = std::function<int64_t()>; // Monotonic microseconds
+
+    // Defaults to std::chrono::steady_clock
+    explicit CaptureScheduler(ClockFn clock = ClockFn());
+
+    // Makes the schedule match `rates` (key, fps). Element i is rates[i]: every other call takes that index,
+    // so the per-tick calls never touch the keys. Elements with an unchanged key and rate keep their deadlines
+    // and statistics even if their index moved. Calling it again with the same list is cheap (no allocation).
+    void SetRates(const std::vector<std::pair<std::string, int>>& rates);
+    size_t Size() const { return m_elements.size(); }
+
+    // Makes an element due at the next CollectDue(), regardless of its deadline.
+    void RequestImmediate(size_t index);
+
+    // Starts a tick: computes the set of elements due now. Elements that were due on the
+    // previous tick but not captured stay due. Returns the number of due elements.
+    size_t CollectDue();
+    bool IsDue(size_t index) const { return index < m_elements.size() && m_elements[index].due; }
+    const std::vector<size_t>& DueIndices() const { return m_dueIndices; } // Ascending
+
+    // Records a capture for a due element and schedules its next deadline.
+    void MarkCaptured(size_t index);
+
+    // Microseconds until the earliest pending deadline (0 if something is due, -1 if nothing is scheduled).
+    int64_t MicrosUntilNextDeadline() const;
+
+    int64_t Now() const { return m_clock(); }
+    int64_t TickIntervalEstimateUs() const { return m_tickIntervalUs; }
+
+    bool GetStats(size_t index, CaptureScheduleStats& out) const;
+    std::vector<std::pair<std::string, CaptureScheduleStats>> GetAllStats() const; // Sorted by key
+
+private:
+    struct Element {
+        std::string key;
+        int fps = 0;
+        int64_t periodUs = 0;    // 0 = every tick
+        int64_t gridIndex = 0;   // Next deadline is grid point gridIndex (see GridTimeUs)
+        int64_t deadlineUs = 0;  // Time of that grid point
+        uint32_t generation = 0; // Invalidates stale heap entries
+        bool due = false;
+        bool immediate = false;
+
+        int64_t lastCaptureUs = -1;
+        uint64_t captures = 0;
+        uint64_t intervals = 0;
+        double sumIntervalUs = 0.0;
+        double sumJitterUs = 0.0;
+        double maxJitterUs = 0.0;
+    };
+    struct HeapEntry {
+        int64_t deadlineUs;
+        size_t index;
+        uint32_t generation;
+        bool operator>(const HeapEntry& o) const { return deadlineUs > o.deadlineUs; }
+    };
+
+    int64_t ToleranceUs(const Element& e) const;
+    void Schedule(size_t index);
+
+    ClockFn m_clock;
+    std::vector<Element> m_elements;
+    std::vector<HeapEntry> m_heap;    // Min-heap on deadline (std::greater)
+    std::vector<HeapEntry> m_notYet;  // CollectDue scratch
+    std::vector<size_t> m_dueIndices;
+
+    int64_t m_lastTickUs = -1;
+    int64_t m_tickIntervalUs = 0; // Smoothed interval between CollectDue() calls
+};
+
+// --- Published statistics (thread-safe) ---
+// Owners publish their scheduler's stats periodically under a source name ("Mirror", "Window Overlay").
+void PublishCaptureScheduleStats(const std::string& source, std::vector<std::pair<std::string, CaptureScheduleStats>> stats);
+std::vector<std::pair<std::string, std::vector<std::pair<std::string, CaptureScheduleStats>>>> GetCaptureScheduleStats();
@@ -59,6 +59,7 @@ constexpr int MIRROR_FPS = 30;
 constexpr bool MIRROR_RAW_OUTPUT = false;
 constexpr bool MIRROR_COLOR_PASSTHROUGH = false;
 constexpr bool MIRROR_ONLY_ON_MY_SCREEN = false;
+constexpr bool MIRROR_CONTENT_STATS = false;
 
 // ============================================================================
 // MirrorBorderConfig Defaults
@@ -155,11 +156,17 @@ constexpr int HOTKEY_DEBOUNCE = 100;
 constexpr bool DEBUG_GLOBAL_SHOW_PERFORMANCE_OVERLAY = false;
 constexpr bool DEBUG_GLOBAL_SHOW_PROFILER = false;
 constexpr float DEBUG_GLOBAL_PROFILER_SCALE = 0.8f;
+constexpr bool DEBUG_GLOBAL_PROFILER_SHOW_PERCENTILES = true;
+constexpr float DEBUG_GLOBAL_PROFILER_THRESHOLD_1_MS = 1.0f;
+constexpr float DEBUG_GLOBAL_PROFILER_THRESHOLD_2_MS = 16.0f;
 constexpr bool DEBUG_GLOBAL_SHOW_HOTKEY_DEBUG = false;
 constexpr bool DEBUG_GLOBAL_FAKE_CURSOR = false;
 constexpr bool DEBUG_GLOBAL_SHOW_TEXTURE_GRID = false;
 constexpr bool DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_FINISHED = false;
 constexpr bool DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_BLITTED = false;
+constexpr bool DEBUG_GLOBAL_FLIGHT_RECORDER_ENABLED = false;
+constexpr int DEBUG_GLOBAL_FLIGHT_RECORDER_SECONDS = 10;
+constexpr float DEBUG_GLOBAL_FLIGHT_RECORDER_HITCH_MS = 50.0f;
 constexpr bool DEBUG_GLOBAL_LOG_MODE_SWITCH = false;
 constexpr bool DEBUG_GLOBAL_LOG_ANIMATION = false;
 constexpr bool DEBUG_GLOBAL_LOG_HOTKEY = false;
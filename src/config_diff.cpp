@@ -0,0 +1,189 @@
+// ============================================================================
+// CONFIG_DIFF.CPP - Typed change set between two config snapshots
+// ============================================================================
+
+#include "config_diff.h"
+
+#include "config_lookup.h"
+#include "config_types.h"
+#include "profiler.h"
+
+#include <atomic>
+
+// Publisher side (gui.h, defined in dllmain.cpp). Declared here so the diff builds without the GUI headers.
+std::shared_ptr<const Config> GetConfigSnapshot();
+extern std::atomic<uint64_t> g_configSnapshotVersion;
+
+// ============================================================================
+// FIELD CLASSIFICATION
+// ============================================================================
+// Each classifier returns the change bits for two versions of the same
+// element. Fields not named by a bit still make the element Modified (via
+// operator==), so consumers that only care about some bits can ignore the rest.
+
+static uint32_t ClassifyMirrorChange(const MirrorConfig& a, const MirrorConfig& b) {
+    uint32_t bits = 0;
+    if (a.input != b.input || a.captureWidth != b.captureWidth || a.captureHeight != b.captureHeight) bits |= MIRROR_CHANGE_CAPTURE;
+    if (!(a.colors == b.colors) || a.colorSensitivity != b.colorSensitivity || !(a.border == b.border) || a.rawOutput != b.rawOutput ||
+        a.colorPassthrough != b.colorPassthrough) {
+        bits |= MIRROR_CHANGE_FILTER;
+    }
+    if (!(a.output == b.output)) bits |= MIRROR_CHANGE_OUTPUT;
+    if (a.fps != b.fps || a.contentStats != b.contentStats) bits |= MIRROR_CHANGE_RATE;
+    if (a.opacity != b.opacity || a.onlyOnMyScreen != b.onlyOnMyScreen) bits |= MIRROR_CHANGE_APPEARANCE;
+    return bits;
+}
+
+static uint32_t ClassifyMirrorGroupChange(const MirrorGroupConfig& a, const MirrorGroupConfig& b) {
+    uint32_t bits = 0;
+    if (!(a.output == b.output)) bits |= MIRROR_GROUP_CHANGE_OUTPUT;
+    if (a.mirrors != b.mirrors) bits |= MIRROR_GROUP_CHANGE_ITEMS;
+    return bits;
+}
+
+static uint32_t ClassifyImageChange(const ImageConfig& a, const ImageConfig& b) {
+    uint32_t bits = 0;
+    if (a.path != b.path) bits |= IMAGE_CHANGE_SOURCE;
+    if (a.x != b.x || a.y != b.y || a.scale != b.scale || a.relativeTo != b.relativeTo || a.crop_top != b.crop_top ||
+        a.crop_bottom != b.crop_bottom || a.crop_left != b.crop_left || a.crop_right != b.crop_right) {
+        bits |= IMAGE_CHANGE_LAYOUT;
+    }
+    if (a.enableColorKey != b.enableColorKey || a.colorKeys != b.colorKeys || !(a.colorKey == b.colorKey) ||
+        a.colorKeySensitivity != b.colorKeySensitivity || a.opacity != b.opacity || !(a.background == b.background) ||
+        a.pixelatedScaling != b.pixelatedScaling || a.onlyOnMyScreen != b.onlyOnMyScreen || !(a.border == b.border)) {
+        bits |= IMAGE_CHANGE_APPEARANCE;
+    }
+    return bits;
+}
+
+static uint32_t ClassifyWindowOverlayChange(const WindowOverlayConfig& a, const WindowOverlayConfig& b) {
+    uint32_t bits = 0;
+    if (a.windowTitle != b.windowTitle || a.windowClass != b.windowClass || a.executableName != b.executableName ||
+        a.windowMatchPriority != b.windowMatchPriority || a.captureMethod != b.captureMethod) {
+        bits |= WINDOW_OVERLAY_CHANGE_TARGET;
+    }
+    if (a.fps != b.fps || a.searchInterval != b.searchInterval || a.enableInteraction != b.enableInteraction) {
+        bits |= WINDOW_OVERLAY_CHANGE_CAPTURE;
+    }
+    if (a.x != b.x || a.y != b.y || a.scale != b.scale || a.relativeTo != b.relativeTo || a.crop_top != b.crop_top ||
+        a.crop_bottom != b.crop_bottom || a.crop_left != b.crop_left || a.crop_right != b.crop_right) {
+        bits |= WINDOW_OVERLAY_CHANGE_LAYOUT;
+    }
+    if (a.enableColorKey != b.enableColorKey || a.colorKeys != b.colorKeys || !(a.colorKey == b.colorKey) ||
+        a.colorKeySensitivity != b.colorKeySensitivity || a.opacity != b.opacity || !(a.background == b.background) ||
+        a.pixelatedScaling != b.pixelatedScaling || a.onlyOnMyScreen != b.onlyOnMyScreen || !(a.border == b.border)) {
+        bits |= WINDOW_OVERLAY_CHANGE_APPEARANCE;
+    }
+    return bits;
+}
+
+static uint32_t ClassifyModeChange(const ModeConfig& a, const ModeConfig& b) {
+    uint32_t bits = 0;
+    if (a.width != b.width || a.height != b.height || a.useRelativeSize != b.useRelativeSize || a.relativeWidth != b.relativeWidth ||
+        a.relativeHeight != b.relativeHeight || a.widthExpr != b.widthExpr || a.heightExpr != b.heightExpr || !(a.stretch == b.stretch)) {
+        bits |= MODE_CHANGE_SIZE;
+    }
+    if (a.background.selectedMode != b.background.selectedMode || a.background.image != b.background.image) {
+        bits |= MODE_CHANGE_BACKGROUND_SOURCE;
+    }
+    if (!(a.background == b.background)) bits |= MODE_CHANGE_BACKGROUND;
+    if (a.mirrorIds != b.mirrorIds || a.mirrorGroupIds != b.mirrorGroupIds || a.imageIds != b.imageIds ||
+        a.windowOverlayIds != b.windowOverlayIds) {
+        bits |= MODE_CHANGE_ELEMENTS;
+    }
+    if (a.gameTransition != b.gameTransition || a.overlayTransition != b.overlayTransition ||
+        a.backgroundTransition != b.backgroundTransition || a.transitionDurationMs != b.transitionDurationMs ||
+        a.easeInPower != b.easeInPower || a.easeOutPower != b.easeOutPower || a.bounceCount != b.bounceCount ||
+        a.bounceIntensity != b.bounceIntensity || a.bounceDurationMs != b.bounceDurationMs || a.relativeStretching != b.relativeStretching ||
+        a.skipAnimateX != b.skipAnimateX || a.skipAnimateY != b.skipAnimateY || a.slideMirrorsIn != b.slideMirrorsIn ||
+        !(a.border == b.border) || a.sensitivityOverrideEnabled != b.sensitivityOverrideEnabled || a.modeSensitivity != b.modeSensitivity ||
+        a.separateXYSensitivity != b.separateXYSensitivity || a.modeSensitivityX != b.modeSensitivityX ||
+        a.modeSensitivityY != b.modeSensitivityY) {
+        bits |= MODE_CHANGE_OTHER;
+    }
+    return bits;
+}
+
+// ============================================================================
+// SECTION DIFF
+// ============================================================================
+
+static const MirrorConfig* FindIn(const Config& c, const MirrorConfig& e) { return GetMirrorFromSnapshot(c, e.name); }
+static const MirrorGroupConfig* FindIn(const Config& c, const MirrorGroupConfig& e) { return GetMirrorGroupFromSnapshot(c, e.name); }
+static const ImageConfig* FindIn(const Config& c, const ImageConfig& e) { return GetImageFromSnapshot(c, e.name); }
+static const WindowOverlayConfig* FindIn(const Config& c, const WindowOverlayConfig& e) { return GetWindowOverlayFromSnapshot(c, e.name); }
+static const ModeConfig* FindIn(const Config& c, const ModeConfig& e) { return GetModeFromSnapshot(c, e.id); }
+
+static const std::string& NameOf(const ModeConfig& e) { return e.id; }
+template <typename T> static const std::string& NameOf(const T& e) { return e.name; }
+
+template <typename T, typename Classify>
+static void DiffSection(const Config& oldConfig, const SharedVector<T>& oldSection, const Config& newConfig, const SharedVector<T>& newSection,
+                        Classify&& classify, std::vector<ConfigElementChange>& out) {
+    if (oldSection.SharesStorageWith(newSection)) return;
+
+    for (const T& element : newSection) {
+        // Only the first element with a name is reachable by lookup; later duplicates are skipped like everywhere else
+        if (FindIn(newConfig, element) != &element) continue;
+
+        const T* previous = FindIn(oldConfig, element);
+        if (!previous) {
+            out.push_back({ ConfigChangeKind::Added, NameOf(element), CONFIG_CHANGE_ALL });
+            continue;
+        }
+        if (previous == &element) continue; // Shared node: unchanged, not even compared
+        if (*previous == element) continue; // Moved or re-published without edits
+
+        const uint32_t fields = classify(*previous, element);
+        out.push_back({ ConfigChangeKind::Modified, NameOf(element), fields ? fields : CONFIG_CHANGE_ALL });
+    }
+
+    for (const T& element : oldSection) {
+        if (FindIn(oldConfig, element) != &element) continue; // Shadowed duplicate
+        if (!FindIn(newConfig, element)) out.push_back({ ConfigChangeKind::Removed, NameOf(element), CONFIG_CHANGE_ALL });
+    }
+}
+
+ConfigChangeSet DiffConfigs(const Config& oldConfig, const Config& newConfig) {
+    PROFILE_SCOPE_CAT("DiffConfigs", "Config");
+
+    ConfigChangeSet changes;
+    DiffSection(oldConfig, oldConfig.mirrors, newConfig, newConfig.mirrors, ClassifyMirrorChange, changes.mirrors);
+    DiffSection(oldConfig, oldConfig.mirrorGroups, newConfig, newConfig.mirrorGroups, ClassifyMirrorGroupChange, changes.mirrorGroups);
+    DiffSection(oldConfig, oldConfig.images, newConfig, newConfig.images, ClassifyImageChange, changes.images);
+    DiffSection(oldConfig, oldConfig.windowOverlays, newConfig, newConfig.windowOverlays, ClassifyWindowOverlayChange,
+                changes.windowOverlays);
+    DiffSection(oldConfig, oldConfig.modes, newConfig, newConfig.modes, ClassifyModeChange, changes.modes);
+    changes.hotkeysChanged =
+        !oldConfig.hotkeys.SharesStorageWith(newConfig.hotkeys) || !oldConfig.sensitivityHotkeys.SharesStorageWith(newConfig.sensitivityHotkeys);
+    return changes;
+}
+
+const ConfigElementChange* ConfigChangeSet::Find(const std::vector<ConfigElementChange>& changes, const std::string& name) {
+    for (const auto& change : changes) {
+        if (change.name == name) return &change;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// CHANGE TRACKER
+// ============================================================================
+
+bool ConfigChangeTracker::Poll(std::shared_ptr<const Config>& outCurrent, ConfigChangeSet& outChanges) {
+    // Version first: a publish racing with the load below is simply picked up next poll
+    const uint64_t version = g_configSnapshotVersion.load(std::memory_order_acquire);
+    if (m_last && version == m_lastVersion) return false;
+
+    auto current = GetConfigSnapshot();
+    if (!current) return false;
+
+    auto previous = std::move(m_last);
+    m_last = current;
+    m_lastVersion = version;
+    if (!previous || previous == current) return false; // Baseline, or a version bump we already consumed
+
+    outChanges = DiffConfigs(*previous, *current);
+    outCurrent = std::move(current);
+    return true;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// ============================================================================
+// CONFIG_DIFF.H - Typed change set between two config snapshots
+// ============================================================================
+// DiffConfigs(old, new) lists the mirrors, mirror groups, images, window
+// overlays and modes that were added, removed or modified, with a bitmask of
+// which field groups changed. Elements are matched by name (modes by id,
+// case-insensitive, like every other mode lookup); a rename is a removal
+// plus an addition.
+//
+// Snapshots share unchanged storage (see shared_vector.h), so an untouched
+// section costs one pointer compare and an untouched element one more.
+//
+// Resource owners (mirror capture configs, GPU textures, window capture
+// entries) each keep a ConfigChangeTracker and rebuild only what the change
+// set names. GUI edits and hot-reloaded config.toml edits take the same path.
+// ============================================================================
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Config;
+
+enum class ConfigChangeKind : uint8_t { Added, Removed, Modified };
+
+// Field groups per section. Added/Removed changes carry CONFIG_CHANGE_ALL.
+enum MirrorChangeBits : uint32_t {
+    MIRROR_CHANGE_CAPTURE = 1 << 0,    // input regions, capture size
+    MIRROR_CHANGE_FILTER = 1 << 1,     // colors, sensitivity, border, raw output / passthrough
+    MIRROR_CHANGE_OUTPUT = 1 << 2,     // output position / scale
+    MIRROR_CHANGE_RATE = 1 << 3,       // fps, content stats
+    MIRROR_CHANGE_APPEARANCE = 1 << 4, // opacity, onlyOnMyScreen (render thread only)
+};
+
+enum MirrorGroupChangeBits : uint32_t {
+    MIRROR_GROUP_CHANGE_OUTPUT = 1 << 0,
+    MIRROR_GROUP_CHANGE_ITEMS = 1 << 1,
+};
+
+enum ImageChangeBits : uint32_t {
+    IMAGE_CHANGE_SOURCE = 1 << 0,     // path: the texture must be decoded again
+    IMAGE_CHANGE_LAYOUT = 1 << 1,     // position, scale, anchor, crop
+    IMAGE_CHANGE_APPEARANCE = 1 << 2, // everything else
+};
+
+enum WindowOverlayChangeBits : uint32_t {
+    WINDOW_OVERLAY_CHANGE_TARGET = 1 << 0,  // window match fields, capture method
+    WINDOW_OVERLAY_CHANGE_CAPTURE = 1 << 1, // fps, search interval, interaction
+    WINDOW_OVERLAY_CHANGE_LAYOUT = 1 << 2,
+    WINDOW_OVERLAY_CHANGE_APPEARANCE = 1 << 3,
+};
+
+enum ModeChangeBits : uint32_t {
+    MODE_CHANGE_SIZE = 1 << 0,              // dimensions, relative/expression sizing, stretch
+    MODE_CHANGE_BACKGROUND_SOURCE = 1 << 1, // background mode or image path
+    MODE_CHANGE_BACKGROUND = 1 << 2,        // other background settings
+    MODE_CHANGE_ELEMENTS = 1 << 3,          // mirror / group / image / overlay lists
+    MODE_CHANGE_OTHER = 1 << 4,             // transitions, slide-in, border, sensitivity
+};
+
+constexpr uint32_t CONFIG_CHANGE_ALL = 0xFFFFFFFFu;
+
+struct ConfigElementChange {
+    ConfigChangeKind kind = ConfigChangeKind::Modified;
+    std::string name;
+    uint32_t fields = 0;
+};
+
+struct ConfigChangeSet {
+    std::vector<ConfigElementChange> mirrors;
+    std::vector<ConfigElementChange> mirrorGroups;
+    std::vector<ConfigElementChange> images;
+    std::vector<ConfigElementChange> windowOverlays;
+    std::vector<ConfigElementChange> modes;
+    bool hotkeysChanged = false; // hotkeys or sensitivity hotkeys (compiled into the snapshot's dispatch table)
+
+    bool Empty() const {
+        return mirrors.empty() && mirrorGroups.empty() && images.empty() && windowOverlays.empty() && modes.empty() && !hotkeysChanged;
+    }
+
+    // Change recorded for name in one section, or nullptr
+    static const ConfigElementChange* Find(const std::vector<ConfigElementChange>& changes, const std::string& name);
+};
+
+ConfigChangeSet DiffConfigs(const Config& oldConfig, const Config& newConfig);
+
+// Per-consumer cursor over published snapshots. Each consumer diffs against the last snapshot *it* applied, so a
+// consumer that skips intermediate publishes still sees every change.
+class ConfigChangeTracker {
+public:
+    // True when a snapshot newer than the last consumed one exists: outCurrent receives it and outChanges the diff.
+    // The first call only records the baseline (startup code has already built resources from it) and returns false.
+    bool Poll(std::shared_ptr<const Config>& outCurrent, ConfigChangeSet& outChanges);
+
+private:
+    std::shared_ptr<const Config> m_last;
+    uint64_t m_lastVersion = 0;
+};
@@ -0,0 +1,163 @@
+// ============================================================================
+// CONFIG_LOOKUP.CPP - Element lookups in config snapshots
+// ============================================================================
+
+#include "config_lookup.h"
+
+#include "config_types.h"
+
+#include <algorithm>
+#include <cctype>
+
+bool EqualsIgnoreCase(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) { return false; }
+
+    return std::equal(a.begin(), a.end(), b.begin(), [](char a, char b) { return std::tolower(a) == std::tolower(b); });
+}
+
+const ModeConfig* GetModeFromSnapshot(const Config& config, const std::string& id) {
+    if (!config.modeIndexByHandle.empty()) {
+        const ModeHandle handle = FindModeHandle(id);
+        if (handle == NO_MODE_HANDLE && !id.empty()) return nullptr; // Never interned, so in no snapshot
+        return GetModeFromSnapshot(config, handle);
+    }
+    for (const auto& mode : config.modes) {
+        if (EqualsIgnoreCase(mode.id, id)) return &mode;
+    }
+    return nullptr;
+}
+
+const ModeConfig* GetModeFromSnapshot(const Config& config, ModeHandle handle) {
+    if (config.modeIndexByHandle.empty()) {
+        // Unindexed (mutable) config: fall back to the name scan
+        if (config.modes.empty()) return nullptr;
+        const std::string& id = ModeIdName(handle);
+        for (const auto& mode : config.modes) {
+            if (EqualsIgnoreCase(mode.id, id)) return &mode;
+        }
+        return nullptr;
+    }
+    const ModeHandle folded = ModeIdFoldedHandle(handle);
+    if (folded >= config.modeIndexByHandle.size()) return nullptr;
+    const int index = config.modeIndexByHandle[folded];
+    return (index >= 0 && index < static_cast<int>(config.modes.size())) ? &config.modes[index] : nullptr;
+}
+
+void BuildModeHandleIndex(Config& config) {
+    // Handles are assigned when PublishFrom() copies a mode node; read-only here so shared nodes stay shared
+    const auto& modes = config.modes;
+    config.modeIndexByHandle.clear();
+    for (size_t i = 0; i < modes.size(); i++) {
+        const ModeHandle folded = ModeIdFoldedHandle(modes[i].handle);
+        if (folded >= config.modeIndexByHandle.size()) { config.modeIndexByHandle.resize(folded + 1, -1); }
+        // First match wins, like the case-insensitive scan
+        if (config.modeIndexByHandle[folded] < 0) { config.modeIndexByHandle[folded] = static_cast<int>(i); }
+    }
+    // Keep an indexed snapshot distinguishable from an unindexed one even with no modes
+    if (config.modeIndexByHandle.empty()) { config.modeIndexByHandle.push_back(-1); }
+}
+
+template <typename T>
+static std::shared_ptr<const ConfigNameIndex> BuildNameIndex(const SharedVector<T>& section, const SharedVector<T>* previousSection,
+                                                             const std::shared_ptr<const ConfigNameIndex>* previousIndex) {
+    // Shared storage means the same elements at the same positions, so the previous index still holds
+    if (previousSection && *previousIndex && section.SharesStorageWith(*previousSection)) return *previousIndex;
+
+    auto index = std::make_shared<ConfigNameIndex>();
+    index->reserve(section.size());
+    for (size_t i = 0; i < section.size(); i++) { index->emplace(section[i].name, static_cast<uint32_t>(i)); }
+    return index;
+}
+
+template <typename T> static const T* FindByName(const SharedVector<T>& section, const ConfigNameIndex* index, const std::string& name) {
+    if (index) {
+        auto it = index->find(name);
+        return (it != index->end() && it->second < section.size()) ? &section[it->second] : nullptr;
+    }
+    for (const auto& element : section) {
+        if (element.name == name) return &element;
+    }
+    return nullptr;
+}
+
+template <typename T>
+static std::shared_ptr<const ConfigHandleIndex> BuildHandleIndex(const SharedVector<T>& section, const SharedVector<T>* previousSection,
+                                                                 const std::shared_ptr<const ConfigHandleIndex>* previousIndex) {
+    if (previousSection && *previousIndex && section.SharesStorageWith(*previousSection)) return *previousIndex;
+
+    // Handles are assigned when PublishFrom() copies a node; read-only here so shared nodes stay shared
+    auto index = std::make_shared<ConfigHandleIndex>();
+    for (size_t i = 0; i < section.size(); i++) {
+        const ElementHandle handle = section[i].handle;
+        if (handle >= index->size()) { index->resize(handle + 1, -1); }
+        if ((*index)[handle] < 0) { (*index)[handle] = static_cast<int>(i); }
+    }
+    return index;
+}
+
+template <typename T>
+static const T* FindByHandle(const SharedVector<T>& section, const ConfigHandleIndex* index, ElementHandle handle) {
+    if (handle == NO_ELEMENT_HANDLE) return nullptr;
+    if (index) {
+        if (handle >= index->size()) return nullptr;
+        const int i = (*index)[handle];
+        return (i >= 0 && i < static_cast<int>(section.size())) ? &section[i] : nullptr;
+    }
+    const std::string& name = ElementName(handle);
+    for (const auto& element : section) {
+        if (element.name == name) return &element;
+    }
+    return nullptr;
+}
+
+void BuildElementIndexes(Config& config, const Config* previous) {
+    config.mirrorIndexByName = BuildNameIndex(config.mirrors, previous ? &previous->mirrors : nullptr,
+                                              previous ? &previous->mirrorIndexByName : nullptr);
+    config.mirrorGroupIndexByName = BuildNameIndex(config.mirrorGroups, previous ? &previous->mirrorGroups : nullptr,
+                                                   previous ? &previous->mirrorGroupIndexByName : nullptr);
+    config.imageIndexByName =
+        BuildNameIndex(config.images, previous ? &previous->images : nullptr, previous ? &previous->imageIndexByName : nullptr);
+    config.windowOverlayIndexByName = BuildNameIndex(config.windowOverlays, previous ? &previous->windowOverlays : nullptr,
+                                                     previous ? &previous->windowOverlayIndexByName : nullptr);
+
+    config.mirrorIndexByHandle = BuildHandleIndex(config.mirrors, previous ? &previous->mirrors : nullptr,
+                                                  previous ? &previous->mirrorIndexByHandle : nullptr);
+    config.mirrorGroupIndexByHandle = BuildHandleIndex(config.mirrorGroups, previous ? &previous->mirrorGroups : nullptr,
+                                                       previous ? &previous->mirrorGroupIndexByHandle : nullptr);
+    config.imageIndexByHandle =
+        BuildHandleIndex(config.images, previous ? &previous->images : nullptr, previous ? &previous->imageIndexByHandle : nullptr);
+    config.windowOverlayIndexByHandle = BuildHandleIndex(config.windowOverlays, previous ? &previous->windowOverlays : nullptr,
+                                                         previous ? &previous->windowOverlayIndexByHandle : nullptr);
+}
+
+const MirrorConfig* GetMirrorFromSnapshot(const Config& config, const std::string& name) {
+    return FindByName(config.mirrors, config.mirrorIndexByName.get(), name);
+}
+
+const MirrorGroupConfig* GetMirrorGroupFromSnapshot(const Config& config, const std::string& name) {
+    return FindByName(config.mirrorGroups, config.mirrorGroupIndexByName.get(), name);
+}
+
+const ImageConfig* GetImageFromSnapshot(const Config& config, const std::string& name) {
+    return FindByName(config.images, config.imageIndexByName.get(), name);
+}
+
+const WindowOverlayConfig* GetWindowOverlayFromSnapshot(const Config& config, const std::string& name) {
+    return FindByName(config.windowOverlays, config.windowOverlayIndexByName.get(), name);
+}
+
+const MirrorConfig* GetMirrorFromSnapshot(const Config& config, ElementHandle handle) {
+    return FindByHandle(config.mirrors, config.mirrorIndexByHandle.get(), handle);
+}
+
+const MirrorGroupConfig* GetMirrorGroupFromSnapshot(const Config& config, ElementHandle handle) {
+    return FindByHandle(config.mirrorGroups, config.mirrorGroupIndexByHandle.get(), handle);
+}
+
+const ImageConfig* GetImageFromSnapshot(const Config& config, ElementHandle handle) {
+    return FindByHandle(config.images, config.imageIndexByHandle.get(), handle);
+}
+
+const WindowOverlayConfig* GetWindowOverlayFromSnapshot(const Config& config, ElementHandle handle) {
+    return FindByHandle(config.windowOverlays, config.windowOverlayIndexByHandle.get(), handle);
+}
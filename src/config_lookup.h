@@ -0,0 +1,49 @@
+#pragma once
+
+// ============================================================================
+// CONFIG_LOOKUP.H - Element lookups in config snapshots
+// ============================================================================
+// Mode, mirror, mirror group, image and window overlay lookups by name or
+// handle. Published snapshots carry indexes (built here by
+// PublishConfigSnapshot()), so lookups are a hash or array read; the mutable
+// g_config has none and falls back to a scan. On duplicate names the first
+// element wins either way.
+//
+// Pure config code (no GUI, GL or window state), shared by utils.h callers
+// and the config diff.
+// ============================================================================
+
+#include <string>
+
+#include "element_id.h"
+#include "mode_id.h"
+
+struct Config;
+struct ModeConfig;
+struct MirrorConfig;
+struct MirrorGroupConfig;
+struct ImageConfig;
+struct WindowOverlayConfig;
+
+bool EqualsIgnoreCase(const std::string& a, const std::string& b);
+
+// Mode lookups are case-insensitive
+const ModeConfig* GetModeFromSnapshot(const Config& config, const std::string& id);
+const ModeConfig* GetModeFromSnapshot(const Config& config, ModeHandle handle); // O(1) on published snapshots
+// Fills config.modeIndexByHandle from the modes' interned handles. Called on the snapshot PublishConfigSnapshot() publishes.
+void BuildModeHandleIndex(Config& config);
+
+// Name lookups: O(1) through the snapshot's name indexes, linear scan on an unindexed config (g_config)
+const MirrorConfig* GetMirrorFromSnapshot(const Config& config, const std::string& name);
+const MirrorGroupConfig* GetMirrorGroupFromSnapshot(const Config& config, const std::string& name);
+const ImageConfig* GetImageFromSnapshot(const Config& config, const std::string& name);
+const WindowOverlayConfig* GetWindowOverlayFromSnapshot(const Config& config, const std::string& name);
+// Handle lookups (see element_id.h): an array read on a snapshot, a scan by ElementName() on an unindexed config.
+// Handles are process-wide, so a handle from one snapshot resolves in any other.
+const MirrorConfig* GetMirrorFromSnapshot(const Config& config, ElementHandle handle);
+const MirrorGroupConfig* GetMirrorGroupFromSnapshot(const Config& config, ElementHandle handle);
+const ImageConfig* GetImageFromSnapshot(const Config& config, ElementHandle handle);
+const WindowOverlayConfig* GetWindowOverlayFromSnapshot(const Config& config, ElementHandle handle);
+// Fills the config's name and handle indexes, reusing previous's indexes for any section whose storage it shares.
+// Called on the snapshot PublishConfigSnapshot() publishes.
+void BuildElementIndexes(Config& config, const Config* previous);
@@ -0,0 +1,48 @@
+// ============================================================================
+// CONFIG_PUBLISH.CPP - Element sections of a published config snapshot
+// ============================================================================
+
+#include "config_publish.h"
+
+#include "config_types.h"
+#include "element_id.h"
+#include "mode_id.h"
+
+// Runtime handles are assigned when PublishFrom() copies a node; shared nodes already carry theirs
+
+static std::vector<ElementHandle> InternElementNames(const std::vector<std::string>& names) {
+    std::vector<ElementHandle> handles;
+    handles.reserve(names.size());
+    for (const std::string& name : names) { handles.push_back(InternElementName(name)); }
+    return handles;
+}
+
+static void FinalizeMirrorGroup(MirrorGroupConfig& group) {
+    group.handle = InternElementName(group.name);
+    for (MirrorGroupItem& item : group.mirrors) { item.mirrorHandle = InternElementName(item.mirrorId); }
+}
+
+static void FinalizeMode(ModeConfig& mode) {
+    mode.handle = InternModeId(mode.id);
+    mode.mirrorHandles = InternElementNames(mode.mirrorIds);
+    mode.mirrorGroupHandles = InternElementNames(mode.mirrorGroupIds);
+    mode.imageHandles = InternElementNames(mode.imageIds);
+    mode.windowOverlayHandles = InternElementNames(mode.windowOverlayIds);
+}
+
+void PublishConfigSections(const Config& draft, const Config* previous, Config& snapshot) {
+    static_cast<ConfigSettings&>(snapshot) = draft;
+    snapshot.mirrors = SharedVector<MirrorConfig>::PublishFrom(draft.mirrors, previous ? &previous->mirrors : nullptr,
+                                                               [](MirrorConfig& mirror) { mirror.handle = InternElementName(mirror.name); });
+    snapshot.mirrorGroups =
+        SharedVector<MirrorGroupConfig>::PublishFrom(draft.mirrorGroups, previous ? &previous->mirrorGroups : nullptr, FinalizeMirrorGroup);
+    snapshot.images = SharedVector<ImageConfig>::PublishFrom(draft.images, previous ? &previous->images : nullptr,
+                                                             [](ImageConfig& image) { image.handle = InternElementName(image.name); });
+    snapshot.windowOverlays = SharedVector<WindowOverlayConfig>::PublishFrom(
+        draft.windowOverlays, previous ? &previous->windowOverlays : nullptr,
+        [](WindowOverlayConfig& overlay) { overlay.handle = InternElementName(overlay.name); });
+    snapshot.modes = SharedVector<ModeConfig>::PublishFrom(draft.modes, previous ? &previous->modes : nullptr, FinalizeMode);
+    snapshot.hotkeys = SharedVector<HotkeyConfig>::PublishFrom(draft.hotkeys, previous ? &previous->hotkeys : nullptr);
+    snapshot.sensitivityHotkeys =
+        SharedVector<SensitivityHotkeyConfig>::PublishFrom(draft.sensitivityHotkeys, previous ? &previous->sensitivityHotkeys : nullptr);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// ============================================================================
+// CONFIG_PUBLISH.H - Element sections of a published config snapshot
+// ============================================================================
+// PublishConfigSnapshot() builds each snapshot from the mutable draft with
+// PublishConfigSections(), then adds the runtime indexes and hotkey table.
+// Sections are built with SharedVector::PublishFrom: elements that still
+// equal the previous snapshot's share its nodes, so a publish copies only
+// what was edited.
+// ============================================================================
+
+struct Config;
+
+// Fills snapshot's settings and element sections from draft. previous may be null (first publish).
+// Built field by field (never by copying draft): a Config copy would share the draft's section storage, and the
+// draft's next write would then have to clone it out from under the GUI's element references.
+void PublishConfigSections(const Config& draft, const Config* previous, Config& snapshot);
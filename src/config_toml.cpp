@@ -489,6 +489,7 @@ void MirrorConfigToToml(const MirrorConfig& cfg, toml::table& out) {
     out.insert("opacity", std::round(cfg.opacity * 1000.0f) / 1000.0f);
     out.insert("rawOutput", cfg.rawOutput);
     out.insert("colorPassthrough", cfg.colorPassthrough);
+    out.insert("contentStats", cfg.contentStats);
     // Mirrors: onlyOnMyScreen is currently disabled (forced false), but we keep the field
     // in the config for compatibility with older/newer configs.
     out.insert("onlyOnMyScreen", false);
@@ -532,6 +533,7 @@ void MirrorConfigFromToml(const toml::table& tbl, MirrorConfig& cfg) {
     cfg.opacity = GetOr(tbl, "opacity", 1.0f);
     cfg.rawOutput = GetOr(tbl, "rawOutput", ConfigDefaults::MIRROR_RAW_OUTPUT);
     cfg.colorPassthrough = GetOr(tbl, "colorPassthrough", ConfigDefaults::MIRROR_COLOR_PASSTHROUGH);
+    cfg.contentStats = GetOr(tbl, "contentStats", ConfigDefaults::MIRROR_CONTENT_STATS);
     // Mirrors: onlyOnMyScreen is intentionally disabled. We still read the key for
     // backward compatibility, but force the runtime value to false.
     const bool parsedOnlyOnMyScreen = GetOr(tbl, "onlyOnMyScreen", ConfigDefaults::MIRROR_ONLY_ON_MY_SCREEN);
@@ -1205,12 +1207,21 @@ void DebugGlobalConfigToToml(const DebugGlobalConfig& cfg, toml::table& out) {
     out.insert("showPerformanceOverlay", cfg.showPerformanceOverlay);
     out.insert("showProfiler", cfg.showProfiler);
     out.insert("profilerScale", cfg.profilerScale);
+    out.insert("profilerShowPercentiles", cfg.profilerShowPercentiles);
+    out.insert("profilerThreshold1Ms", cfg.profilerThreshold1Ms);
+    out.insert("profilerThreshold2Ms", cfg.profilerThreshold2Ms);
     out.insert("fakeCursor", cfg.fakeCursor);
     out.insert("showTextureGrid", cfg.showTextureGrid);
     out.insert("delayRenderingUntilFinished", cfg.delayRenderingUntilFinished);
     out.insert("delayRenderingUntilBlitted", cfg.delayRenderingUntilBlitted);
     out.insert("virtualCameraEnabled", cfg.virtualCameraEnabled);
     out.insert("virtualCameraFps", cfg.virtualCameraFps);
+    out.insert("flightRecorderEnabled", cfg.flightRecorderEnabled);
+    out.insert("flightRecorderSeconds", cfg.flightRecorderSeconds);
+    out.insert("flightRecorderHitchMs", cfg.flightRecorderHitchMs);
+    toml::array flightRecorderHotkeyArr;
+    for (const auto& key : cfg.flightRecorderHotkey) { flightRecorderHotkeyArr.push_back(static_cast<int64_t>(key)); }
+    out.insert("flightRecorderHotkey", flightRecorderHotkeyArr);
 
     out.insert("logModeSwitch", cfg.logModeSwitch);
     out.insert("logAnimation", cfg.logAnimation);
@@ -1229,6 +1240,9 @@ void DebugGlobalConfigFromToml(const toml::table& tbl, DebugGlobalConfig& cfg) {
     cfg.showPerformanceOverlay = GetOr(tbl, "showPerformanceOverlay", ConfigDefaults::DEBUG_GLOBAL_SHOW_PERFORMANCE_OVERLAY);
     cfg.showProfiler = GetOr(tbl, "showProfiler", ConfigDefaults::DEBUG_GLOBAL_SHOW_PROFILER);
     cfg.profilerScale = GetOr(tbl, "profilerScale", ConfigDefaults::DEBUG_GLOBAL_PROFILER_SCALE);
+    cfg.profilerShowPercentiles = GetOr(tbl, "profilerShowPercentiles", ConfigDefaults::DEBUG_GLOBAL_PROFILER_SHOW_PERCENTILES);
+    cfg.profilerThreshold1Ms = (std::max)(0.0f, GetOr(tbl, "profilerThreshold1Ms", ConfigDefaults::DEBUG_GLOBAL_PROFILER_THRESHOLD_1_MS));
+    cfg.profilerThreshold2Ms = (std::max)(0.0f, GetOr(tbl, "profilerThreshold2Ms", ConfigDefaults::DEBUG_GLOBAL_PROFILER_THRESHOLD_2_MS));
     cfg.fakeCursor = GetOr(tbl, "fakeCursor", ConfigDefaults::DEBUG_GLOBAL_FAKE_CURSOR);
     cfg.showTextureGrid = GetOr(tbl, "showTextureGrid", ConfigDefaults::DEBUG_GLOBAL_SHOW_TEXTURE_GRID);
     cfg.delayRenderingUntilFinished =
@@ -1236,6 +1250,16 @@ void DebugGlobalConfigFromToml(const toml::table& tbl, DebugGlobalConfig& cfg) {
     cfg.delayRenderingUntilBlitted = GetOr(tbl, "delayRenderingUntilBlitted", ConfigDefaults::DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_BLITTED);
     cfg.virtualCameraEnabled = GetOr(tbl, "virtualCameraEnabled", false);
     cfg.virtualCameraFps = GetOr(tbl, "virtualCameraFps", 30);
+    cfg.flightRecorderEnabled = GetOr(tbl, "flightRecorderEnabled", ConfigDefaults::DEBUG_GLOBAL_FLIGHT_RECORDER_ENABLED);
+    cfg.flightRecorderSeconds = GetOr(tbl, "flightRecorderSeconds", ConfigDefaults::DEBUG_GLOBAL_FLIGHT_RECORDER_SECONDS);
+    cfg.flightRecorderSeconds = (std::max)(1, (std::min)(cfg.flightRecorderSeconds, 60));
+    cfg.flightRecorderHitchMs = (std::max)(0.0f, GetOr(tbl, "flightRecorderHitchMs", ConfigDefaults::DEBUG_GLOBAL_FLIGHT_RECORDER_HITCH_MS));
+    cfg.flightRecorderHotkey.clear();
+    if (auto arr = GetArray(tbl, "flightRecorderHotkey")) {
+        for (const auto& elem : *arr) {
+            if (auto val = elem.value<int64_t>()) { cfg.flightRecorderHotkey.push_back(static_cast<DWORD>(*val)); }
+        }
+    }
 
     cfg.logModeSwitch = GetOr(tbl, "logModeSwitch", ConfigDefaults::DEBUG_GLOBAL_LOG_MODE_SWITCH);
     cfg.logAnimation = GetOr(tbl, "logAnimation", ConfigDefaults::DEBUG_GLOBAL_LOG_ANIMATION);
@@ -1805,7 +1829,7 @@ bool SaveConfigToTomlFile(const Config& config, const std::wstring& path) {
         std::vector<std::string> mirrorKeys = { "name",   "captureWidth", "captureHeight",    "input",
                                                 "output", "colors",       "colorSensitivity", "border",
                                                 "fps",    "rawOutput",    "colorPassthrough", "onlyOnMyScreen",
-                                                "debug" };
+                                                "contentStats", "debug" };
         std::vector<std::string> mirrorGroupKeys = { "name", "output", "mirrorIds" };
         std::vector<std::string> imageKeys = { "name",           "path",      "x",           "y",          "scale",
                                                "relativeTo",     "crop_top",  "crop_bottom", "crop_left",  "crop_right",
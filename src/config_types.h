@@ -0,0 +1,625 @@
+#pragma once
+
+// ============================================================================
+// CONFIG_TYPES.H - Config value types (Config, ModeConfig, MirrorConfig, ...)
+// ============================================================================
+// Plain structs shared by the config loader, the GUI and every thread that
+// reads a config snapshot. Kept out of gui.h (ImGui, GUI state, globals) so
+// code that only needs the types, such as the unit tests under tests/, can
+// include them on their own.
+// ============================================================================
+
+#include <Windows.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "element_id.h"
+#include "mode_id.h"
+#include "shared_vector.h"
+
+class HotkeyDispatchTable;
+
+// Config elements compare by value. operator== must cover every serialized field: PublishConfigSnapshot()
+// reuses the previous snapshot's node for any element that compares equal to the draft.
+struct Color {
+    float r = 0.0f, g = 0.0f, b = 0.0f, a = 1.0f;
+    bool operator==(const Color& o) const { return r == o.r && g == o.g && b == o.b && a == o.a; }
+};
+
+// Gradient animation types
+enum class GradientAnimationType {
+    None,   // Static gradient (current behavior)
+    Rotate, // Rotates gradient angle continuously
+    Slide,  // Slides gradient position across screen
+    Wave,   // Sine wave distortion
+    Spiral, // Colors spiral from center outward
+    Fade    // Fade/blend between color stops over time
+};
+
+// A single color stop in a gradient
+struct GradientColorStop {
+    Color color = { 0.0f, 0.0f, 0.0f };
+    float position = 0.0f; // 0.0 to 1.0, position along gradient
+
+    bool operator==(const GradientColorStop& o) const { return color == o.color && position == o.position; }
+};
+
+struct BackgroundConfig {
+    std::string selectedMode = "color"; // "image", "color", or "gradient"
+    std::string image;
+    Color color;
+
+    // Gradient settings (used when selectedMode == "gradient")
+    std::vector<GradientColorStop> gradientStops; // Color stops (minimum 2)
+    float gradientAngle = 0.0f;                   // Angle in degrees (0 = left-to-right, 90 = bottom-to-top)
+
+    // Gradient animation settings
+    GradientAnimationType gradientAnimation = GradientAnimationType::None;
+    float gradientAnimationSpeed = 1.0f; // Multiplier for animation speed (0.1-5.0)
+    bool gradientColorFade = false;      // When true, colors smoothly cycle through stops
+
+    bool operator==(const BackgroundConfig& o) const {
+        return selectedMode == o.selectedMode && image == o.image && color == o.color && gradientStops == o.gradientStops &&
+               gradientAngle == o.gradientAngle && gradientAnimation == o.gradientAnimation &&
+               gradientAnimationSpeed == o.gradientAnimationSpeed && gradientColorFade == o.gradientColorFade;
+    }
+};
+
+struct MirrorCaptureConfig {
+    int x = 0, y = 0;
+    std::string relativeTo = "topLeftScreen";
+
+    bool operator==(const MirrorCaptureConfig& o) const { return x == o.x && y == o.y && relativeTo == o.relativeTo; }
+};
+struct MirrorRenderConfig {
+    int x = 0, y = 0;
+    bool useRelativePosition = false; // When true, x/y are calculated from relativeX/relativeY
+    float relativeX = 0.5f;           // X position as percentage of screen (0.0-1.0, where 0.5 = center)
+    float relativeY = 0.5f;           // Y position as percentage of screen (0.0-1.0, where 0.5 = center)
+    float scale = 1.0f;
+    bool separateScale = false; // When true, use scaleX and scaleY instead of scale
+    float scaleX = 1.0f;        // X-axis scale (used when separateScale is true)
+    float scaleY = 1.0f;        // Y-axis scale (used when separateScale is true)
+    std::string relativeTo = "topLeftScreen";
+
+    bool operator==(const MirrorRenderConfig& o) const {
+        return x == o.x && y == o.y && useRelativePosition == o.useRelativePosition && relativeX == o.relativeX &&
+               relativeY == o.relativeY && scale == o.scale && separateScale == o.separateScale && scaleX == o.scaleX &&
+               scaleY == o.scaleY && relativeTo == o.relativeTo;
+    }
+};
+struct MirrorColors {
+    std::vector<Color> targetColors; // Multiple target colors - any matching pixel is shown
+    Color output, border;
+
+    bool operator==(const MirrorColors& o) const { return targetColors == o.targetColors && output == o.output && border == o.border; }
+};
+
+// How to interpret the captured game texture for color matching.
+// This only affects the filter/matching step (not raw output blit).
+enum class MirrorGammaMode {
+    Auto = 0,       // Auto-detect (best effort) based on framebuffer/texture encoding
+    AssumeSRGB = 1, // Treat captured input as sRGB and linearize for distance comparisons
+    AssumeLinear = 2 // Treat captured input as already linear
+};
+
+// Border type: dynamic (shader-based around content) or static (shape overlay)
+enum class MirrorBorderType {
+    Dynamic, // Existing shader-based border around content pixels
+    Static   // Static shape rendered when mirror has content
+};
+
+// Shape options for static borders
+enum class MirrorBorderShape {
+    Rectangle, // Rectangle (use staticRadius for rounded corners)
+    Circle     // Circle/ellipse that fits mirror dimensions
+};
+
+// When Toolscreen detects a third-party detour on a hooked API, it can optionally chain through
+// the third-party trampoline (compatibility) or bypass it and call our original function.
+enum class HookChainingNextTarget {
+    LatestHook = 0,       // Call the latest (third-party) trampoline captured when chaining
+    OriginalFunction = 1, // Bypass third-party and call Toolscreen's original function
+};
+
+// Custom border configuration for mirrors
+struct MirrorBorderConfig {
+    MirrorBorderType type = MirrorBorderType::Dynamic; // Which border type to use
+
+    // Dynamic border settings (existing behavior)
+    int dynamicThickness = 1; // Thickness for dynamic border (was: borderThickness)
+
+    // Static border settings (new) - rendered if thickness > 0
+    MirrorBorderShape staticShape = MirrorBorderShape::Rectangle;
+    Color staticColor = { 1.0f, 1.0f, 1.0f }; // Static border color (white default)
+    int staticThickness = 2;                  // Static border thickness in pixels (0 = disabled)
+    int staticRadius = 0;                     // Corner radius for Rectangle shape (0 = sharp corners)
+    // Custom position/size offsets (relative to mirror output position)
+    int staticOffsetX = 0; // X offset from mirror position
+    int staticOffsetY = 0; // Y offset from mirror position
+    int staticWidth = 0;   // Custom width (0 = use mirror width)
+    int staticHeight = 0;  // Custom height (0 = use mirror height)
+
+    bool operator==(const MirrorBorderConfig& o) const {
+        return type == o.type && dynamicThickness == o.dynamicThickness && staticShape == o.staticShape &&
+               staticColor == o.staticColor && staticThickness == o.staticThickness && staticRadius == o.staticRadius &&
+               staticOffsetX == o.staticOffsetX && staticOffsetY == o.staticOffsetY && staticWidth == o.staticWidth &&
+               staticHeight == o.staticHeight;
+    }
+};
+
+struct MirrorConfig {
+    std::string name;
+    ElementHandle handle = NO_ELEMENT_HANDLE; // Interned name (runtime only), assigned on published snapshots
+    int captureWidth = 50;
+    int captureHeight = 50;
+    std::vector<MirrorCaptureConfig> input;
+    MirrorRenderConfig output;
+    MirrorColors colors;
+    float colorSensitivity = 0.001f;
+    MirrorBorderConfig border; // Custom border configuration
+    int fps = 30;
+    float opacity = 1.0f;
+    bool rawOutput = false;
+    bool colorPassthrough = false; // If true, output original pixel color instead of Output Color when matching
+    bool onlyOnMyScreen = false;   // If true, render only to user's screen, not to OBS
+    bool contentStats = false;     // If true, publish exact matched-pixel statistics (see mirror_stats.h)
+
+    bool operator==(const MirrorConfig& o) const {
+        return name == o.name && captureWidth == o.captureWidth && captureHeight == o.captureHeight && input == o.input &&
+               output == o.output && colors == o.colors && colorSensitivity == o.colorSensitivity && border == o.border &&
+               fps == o.fps && opacity == o.opacity && rawOutput == o.rawOutput && colorPassthrough == o.colorPassthrough &&
+               onlyOnMyScreen == o.onlyOnMyScreen && contentStats == o.contentStats;
+    }
+};
+// Per-item sizing for mirrors within a group - only applies when rendered as part of group
+struct MirrorGroupItem {
+    std::string mirrorId;
+    ElementHandle mirrorHandle = NO_ELEMENT_HANDLE; // Interned mirrorId (runtime only), assigned on published snapshots
+    bool enabled = true;        // Whether this mirror is rendered as part of the group
+    float widthPercent = 1.0f;  // Width as % of mirror's normal size (1.0 = 100%)
+    float heightPercent = 1.0f; // Height as % of mirror's normal size (1.0 = 100%)
+    int offsetX = 0;            // X offset from group position (pixels)
+    int offsetY = 0;            // Y offset from group position (pixels)
+
+    bool operator==(const MirrorGroupItem& o) const {
+        return mirrorId == o.mirrorId && enabled == o.enabled && widthPercent == o.widthPercent &&
+               heightPercent == o.heightPercent && offsetX == o.offsetX && offsetY == o.offsetY;
+    }
+};
+struct MirrorGroupConfig {
+    std::string name;
+    ElementHandle handle = NO_ELEMENT_HANDLE; // Interned name (runtime only), assigned on published snapshots
+    MirrorRenderConfig output;            // Position/relativeTo for the group (scale fields are IGNORED at render time)
+    std::vector<MirrorGroupItem> mirrors; // Per-item sizing for each mirror in the group
+
+    bool operator==(const MirrorGroupConfig& o) const { return name == o.name && output == o.output && mirrors == o.mirrors; }
+};
+struct ImageBackgroundConfig {
+    bool enabled = false;
+    Color color = { 0.0f, 0.0f, 0.0f };
+    float opacity = 1.0f;
+
+    bool operator==(const ImageBackgroundConfig& o) const { return enabled == o.enabled && color == o.color && opacity == o.opacity; }
+};
+struct StretchConfig {
+    bool enabled = false;
+    int width = 0, height = 0, x = 0, y = 0;
+
+    // Expression-based values (empty = use numeric fields)
+    std::string widthExpr;  // e.g., "screenWidth", "screenWidth - 100"
+    std::string heightExpr; // e.g., "screenHeight", "min(screenHeight, 800)"
+    std::string xExpr;      // e.g., "0", "(screenWidth - 300) / 2"
+    std::string yExpr;      // e.g., "0", "screenHeight - 100"
+
+    bool operator==(const StretchConfig& o) const {
+        return enabled == o.enabled && width == o.width && height == o.height && x == o.x && y == o.y &&
+               widthExpr == o.widthExpr && heightExpr == o.heightExpr && xExpr == o.xExpr && yExpr == o.yExpr;
+    }
+};
+struct BorderConfig {
+    bool enabled = false;
+    Color color = { 1.0f, 1.0f, 1.0f }; // White default
+    int width = 4;                      // Border width in pixels
+    int radius = 0;                     // Corner radius in pixels (0 = sharp corners)
+
+    bool operator==(const BorderConfig& o) const {
+        return enabled == o.enabled && color == o.color && width == o.width && radius == o.radius;
+    }
+};
+// Color key configuration for transparency
+struct ColorKeyConfig {
+    Color color;
+    float sensitivity = 0.05f;
+
+    bool operator==(const ColorKeyConfig& o) const { return color == o.color && sensitivity == o.sensitivity; }
+};
+struct ImageConfig {
+    std::string name;
+    ElementHandle handle = NO_ELEMENT_HANDLE; // Interned name (runtime only), assigned on published snapshots
+    std::string path;
+    int x = 0, y = 0;
+    float scale = 1.0f; // Scale as percentage (1.0 = 100%)
+    std::string relativeTo = "topLeftScreen";
+    int crop_top = 0, crop_bottom = 0, crop_left = 0, crop_right = 0;
+    bool enableColorKey = false;
+    std::vector<ColorKeyConfig> colorKeys; // Multiple color keys (new format)
+    Color colorKey;                        // Single color key (legacy, for backward compat)
+    float colorKeySensitivity = 0.001f;    // Legacy sensitivity
+    float opacity = 1.0f;
+    ImageBackgroundConfig background;
+    bool pixelatedScaling = false;
+    bool onlyOnMyScreen = false; // If true, render only to user's screen, not to OBS
+    BorderConfig border;         // Border around the image overlay
+
+    bool operator==(const ImageConfig& o) const {
+        return name == o.name && path == o.path && x == o.x && y == o.y && scale == o.scale && relativeTo == o.relativeTo &&
+               crop_top == o.crop_top && crop_bottom == o.crop_bottom && crop_left == o.crop_left && crop_right == o.crop_right &&
+               enableColorKey == o.enableColorKey && colorKeys == o.colorKeys && colorKey == o.colorKey &&
+               colorKeySensitivity == o.colorKeySensitivity && opacity == o.opacity && background == o.background &&
+               pixelatedScaling == o.pixelatedScaling && onlyOnMyScreen == o.onlyOnMyScreen && border == o.border;
+    }
+};
+struct WindowOverlayConfig {
+    std::string name;
+    ElementHandle handle = NO_ELEMENT_HANDLE; // Interned name (runtime only), assigned on published snapshots
+    std::string windowTitle;                   // Window title to search for
+    std::string windowClass;                   // Window class name (optional, hidden from GUI but kept in config)
+    std::string executableName;                // Executable name (hidden from GUI but kept in config)
+    std::string windowMatchPriority = "title"; // Match priority: "title", "title_executable"
+    int x = 0, y = 0;
+    float scale = 1.0f; // Scale as percentage (1.0 = 100%)
+    std::string relativeTo = "topLeftScreen";
+    int crop_top = 0, crop_bottom = 0, crop_left = 0, crop_right = 0;
+    bool enableColorKey = false;
+    std::vector<ColorKeyConfig> colorKeys; // Multiple color keys (new format)
+    Color colorKey;                        // Single color key (legacy, for backward compat)
+    float colorKeySensitivity = 0.001f;    // Legacy sensitivity
+    float opacity = 1.0f;
+    ImageBackgroundConfig background;
+    bool pixelatedScaling = false;
+    bool onlyOnMyScreen = false;               // If true, render only to user's screen, not to OBS
+    int fps = 30;                              // Capture framerate
+    int searchInterval = 1000;                 // Window search interval in milliseconds (default 1 second)
+    std::string captureMethod = "Windows 10+"; // Capture method: "Windows 10+" (default) or "BitBlt"
+    bool enableInteraction = false;            // Enable mouse/keyboard interaction forwarding to the real window
+    BorderConfig border;                       // Border around the window overlay
+
+    bool operator==(const WindowOverlayConfig& o) const {
+        return name == o.name && windowTitle == o.windowTitle && windowClass == o.windowClass &&
+               executableName == o.executableName && windowMatchPriority == o.windowMatchPriority && x == o.x && y == o.y &&
+               scale == o.scale && relativeTo == o.relativeTo && crop_top == o.crop_top && crop_bottom == o.crop_bottom &&
+               crop_left == o.crop_left && crop_right == o.crop_right && enableColorKey == o.enableColorKey &&
+               colorKeys == o.colorKeys && colorKey == o.colorKey && colorKeySensitivity == o.colorKeySensitivity &&
+               opacity == o.opacity && background == o.background && pixelatedScaling == o.pixelatedScaling &&
+               onlyOnMyScreen == o.onlyOnMyScreen && fps == o.fps && searchInterval == o.searchInterval &&
+               captureMethod == o.captureMethod && enableInteraction == o.enableInteraction && border == o.border;
+    }
+};
+// StretchConfig and BorderConfig are defined above ImageConfig
+
+enum class GameTransitionType {
+    Cut,   // Instant switch, no animation
+    Bounce // Animate resizing with optional bounce effect at target
+};
+
+enum class OverlayTransitionType {
+    Cut // Instant switch, no animation
+};
+
+enum class BackgroundTransitionType {
+    Cut // Instant switch, no animation
+};
+
+enum class EasingType {
+    Linear,   // No easing, constant speed
+    EaseOut,  // Slow down at end
+    EaseIn,   // Speed up from start
+    EaseInOut // Slow start and end
+};
+
+struct ModeConfig {
+    std::string id;
+    ModeHandle handle = NO_MODE_HANDLE; // Interned id (runtime only), assigned on published snapshots by PublishConfigSnapshot
+    int width = 0, height = 0;
+    bool useRelativeSize = false; // When true, width/height are calculated from relativeWidth/relativeHeight
+    float relativeWidth = 0.5f;   // Width as percentage of screen (0.0-1.0, where 1.0 = 100%)
+    float relativeHeight = 0.5f;  // Height as percentage of screen (0.0-1.0, where 1.0 = 100%)
+
+    // Expression-based dimensions (empty = use numeric/relative fields)
+    std::string widthExpr;  // e.g., "screenWidth", "min(screenWidth, 300)", "screenWidth * 0.9"
+    std::string heightExpr; // e.g., "screenHeight", "screenHeight - 300"
+
+    BackgroundConfig background;
+    std::vector<std::string> mirrorIds;
+    std::vector<std::string> mirrorGroupIds;
+    std::vector<std::string> imageIds;
+    std::vector<std::string> windowOverlayIds;
+    // Interned *Ids (runtime only), index for index. Assigned on published snapshots; empty in g_config.
+    std::vector<ElementHandle> mirrorHandles;
+    std::vector<ElementHandle> mirrorGroupHandles;
+    std::vector<ElementHandle> imageHandles;
+    std::vector<ElementHandle> windowOverlayHandles;
+    StretchConfig stretch;
+
+    // Transition properties (used when switching TO this mode)
+    GameTransitionType gameTransition = GameTransitionType::Bounce;
+    OverlayTransitionType overlayTransition = OverlayTransitionType::Cut;
+    BackgroundTransitionType backgroundTransition = BackgroundTransitionType::Cut;
+    int transitionDurationMs = 500; // Game transition duration in milliseconds
+
+    // Easing settings (for Bounce transition) - separate control for ease in and ease out
+    float easeInPower = 1.0f;        // Power for ease-in (1.0 = linear/no ease-in, higher = more pronounced)
+    float easeOutPower = 3.0f;       // Power for ease-out (1.0 = linear/no ease-out, higher = more pronounced)
+    int bounceCount = 0;             // Number of bounces after reaching target (0 = no bounce)
+    float bounceIntensity = 0.15f;   // How much the bounce goes back towards origin (0.0-0.5)
+    int bounceDurationMs = 150;      // Duration of each bounce cycle in milliseconds
+    bool relativeStretching = false; // When true, viewport-relative overlays scale with viewport during animation
+    bool skipAnimateX = false;       // When true, X axis (width) instantly jumps to target, only Y animates
+    bool skipAnimateY = false;       // When true, Y axis (height) instantly jumps to target, only X animates
+
+    // Border settings
+    BorderConfig border;
+
+    // Mouse sensitivity override for this mode
+    bool sensitivityOverrideEnabled = false; // If true, use modeSensitivity instead of global
+    float modeSensitivity = 1.0f;            // Mode-specific sensitivity (1.0 = normal)
+    bool separateXYSensitivity = false;      // If true, use separate X and Y sensitivity values
+    float modeSensitivityX = 1.0f;           // X-axis sensitivity (when separateXYSensitivity is true)
+    float modeSensitivityY = 1.0f;           // Y-axis sensitivity (when separateXYSensitivity is true)
+
+    // Transition animation
+    bool slideMirrorsIn = false; // If true, mirrors slide in/out from screen edge during transitions
+
+    // handle is runtime-only and deliberately not compared
+    bool operator==(const ModeConfig& o) const {
+        return id == o.id && width == o.width && height == o.height && useRelativeSize == o.useRelativeSize &&
+               relativeWidth == o.relativeWidth && relativeHeight == o.relativeHeight && widthExpr == o.widthExpr &&
+               heightExpr == o.heightExpr && background == o.background && mirrorIds == o.mirrorIds &&
+               mirrorGroupIds == o.mirrorGroupIds && imageIds == o.imageIds && windowOverlayIds == o.windowOverlayIds &&
+               stretch == o.stretch && gameTransition == o.gameTransition && overlayTransition == o.overlayTransition &&
+               backgroundTransition == o.backgroundTransition && transitionDurationMs == o.transitionDurationMs &&
+               easeInPower == o.easeInPower && easeOutPower == o.easeOutPower && bounceCount == o.bounceCount &&
+               bounceIntensity == o.bounceIntensity && bounceDurationMs == o.bounceDurationMs &&
+               relativeStretching == o.relativeStretching && skipAnimateX == o.skipAnimateX && skipAnimateY == o.skipAnimateY &&
+               border == o.border && sensitivityOverrideEnabled == o.sensitivityOverrideEnabled &&
+               modeSensitivity == o.modeSensitivity && separateXYSensitivity == o.separateXYSensitivity &&
+               modeSensitivityX == o.modeSensitivityX && modeSensitivityY == o.modeSensitivityY &&
+               slideMirrorsIn == o.slideMirrorsIn;
+    }
+};
+struct HotkeyConditions {
+    std::vector<std::string> gameState;
+    std::vector<DWORD> exclusions;
+
+    bool operator==(const HotkeyConditions& o) const { return gameState == o.gameState && exclusions == o.exclusions; }
+};
+struct AltSecondaryMode {
+    std::vector<DWORD> keys;
+    std::string mode;
+
+    bool operator==(const AltSecondaryMode& o) const { return keys == o.keys && mode == o.mode; }
+};
+struct HotkeyConfig {
+    std::vector<DWORD> keys;
+
+    std::string mainMode;
+    std::string secondaryMode;
+    std::vector<AltSecondaryMode> altSecondaryModes;
+
+    HotkeyConditions conditions;
+    int debounce = 100;
+    bool triggerOnRelease = false; // When true, hotkey triggers on key release instead of key press
+
+    // When true, the key event that matched this hotkey is consumed and NOT forwarded to the game.
+    // The hotkey still triggers normally.
+    bool blockKeyFromGame = false;
+
+    // When true, exiting the active secondary mode back to Fullscreen is allowed even if
+    // the current game state does not match this hotkey's required game states.
+    // Entering the secondary mode still respects required game states.
+    bool allowExitToFullscreenRegardlessOfGameState = false;
+
+    bool operator==(const HotkeyConfig& o) const {
+        return keys == o.keys && mainMode == o.mainMode && secondaryMode == o.secondaryMode &&
+               altSecondaryModes == o.altSecondaryModes && conditions == o.conditions && debounce == o.debounce &&
+               triggerOnRelease == o.triggerOnRelease && blockKeyFromGame == o.blockKeyFromGame &&
+               allowExitToFullscreenRegardlessOfGameState == o.allowExitToFullscreenRegardlessOfGameState;
+    }
+};
+
+// Sensitivity hotkey - temporarily overrides mouse sensitivity until next mode change
+struct SensitivityHotkeyConfig {
+    std::vector<DWORD> keys;     // Key combination to trigger
+    float sensitivity = 1.0f;    // Sensitivity value to set (same as global/mode sensitivity)
+    bool separateXY = false;     // If true, use separate X/Y sensitivity values
+    float sensitivityX = 1.0f;   // X-axis sensitivity (when separateXY is true)
+    float sensitivityY = 1.0f;   // Y-axis sensitivity (when separateXY is true)
+    bool toggle = false;         // If true, pressing the hotkey again resets sensitivity to normal
+    HotkeyConditions conditions; // Game state conditions and exclusions
+    int debounce = 100;          // Debounce time in milliseconds
+
+    bool operator==(const SensitivityHotkeyConfig& o) const {
+        return keys == o.keys && sensitivity == o.sensitivity && separateXY == o.separateXY &&
+               sensitivityX == o.sensitivityX && sensitivityY == o.sensitivityY && toggle == o.toggle &&
+               conditions == o.conditions && debounce == o.debounce;
+    }
+};
+struct DebugGlobalConfig {
+    bool showPerformanceOverlay = false;
+    bool showProfiler = false;
+    float profilerScale = 0.8f; // Scale of profiler overlay (0.25 to 2.0)
+    bool profilerShowPercentiles = true;     // Latency percentile columns in the profiler overlay
+    float profilerThreshold1Ms = 1.0f;       // Per-scope "calls above" counters (profiler overlay / histogram CSV)
+    float profilerThreshold2Ms = 16.0f;
+    bool showHotkeyDebug = false;
+    bool fakeCursor = false;
+    bool showTextureGrid = false;
+    bool delayRenderingUntilFinished = false; // Call glFinish() before SwapBuffers to ensure all rendering is complete
+    bool delayRenderingUntilBlitted = false;  // Wait on async overlay blit fence before SwapBuffers
+    bool virtualCameraEnabled = false;        // Output to OBS Virtual Camera driver
+    int virtualCameraFps = 60;                // Virtual camera FPS limit
+
+    // Profiler flight recorder: trace dumps of the last few seconds (see Profiler::ConfigureFlightRecorder)
+    bool flightRecorderEnabled = false;
+    int flightRecorderSeconds = 10;               // History kept, 1-60 seconds
+    float flightRecorderHitchMs = 50.0f;          // Dump automatically when a frame takes longer (0 = hotkey only)
+    std::vector<DWORD> flightRecorderHotkey = {}; // Dump now. Empty = disabled/unbound
+
+    // Log category filters (Debug > Advanced Logging)
+    bool logModeSwitch = false;
+    bool logAnimation = false;
+    bool logHotkey = false;
+    bool logObs = false;
+    bool logWindowOverlay = false;
+    bool logFileMonitor = false;
+    bool logImageMonitor = false;
+    bool logPerformance = false;
+    bool logTextureOps = false;
+    bool logGui = false;
+    bool logInit = false;           // Initialization/startup messages
+    bool logCursorTextures = false; // Cursor texture loading messages
+};
+// Cursor selection based on game state
+// Valid cursor values come from dynamically scanned cursors folder
+struct CursorConfig {
+    std::string cursorName = ""; // Selected cursor (empty = use first available)
+    int cursorSize = 64;         // Cursor size in pixels (from STANDARD_SIZES: 16-512px with 24 options, loaded on-demand)
+};
+struct CursorsConfig {
+    bool enabled = false; // Master switch for cursor customization
+    CursorConfig title;   // Cursor for title screen
+    CursorConfig wall;    // Cursor for wall (world preview)
+    CursorConfig ingame;  // Cursor for in-game (everything else)
+};
+struct EyeZoomConfig {
+    int cloneWidth = 24;
+    // Number of overlay grid boxes (and number labels) to render on EACH side of the center line.
+    // Example: cloneWidth=30 => 15 pixels per side sampled; overlayWidth=5 => only render 5 boxes per side (10 total).
+    // Set to cloneWidth/2 to match legacy behavior (overlay covers the full clone width).
+    int overlayWidth = 12;
+    int cloneHeight = 2080;
+    int stretchWidth = 810; // Width of the rendered zoom output on screen
+    int windowWidth = 384;
+    int windowHeight = 16384;
+    int horizontalMargin = 0;   // Horizontal margin on both sides of the eyezoom stretch output
+    int verticalMargin = 0;     // Vertical margin on top and bottom of the eyezoom stretch output
+    // When autoFontSize=true, the renderer will auto-fit the text to the current box size.
+    // When autoFontSize=false, textFontSize is used as-is and bypasses auto-fit clamps.
+    bool autoFontSize = true;
+    int textFontSize = 24;      // Manual font size override for text labels in pixels
+    std::string textFontPath;   // Custom font path for EyeZoom text (empty = use global fontPath)
+    int rectHeight = 24;        // Height of colored overlay rectangles in pixels (linked to textFontSize by default)
+    bool linkRectToFont = true; // If true, rectHeight scales with textFontSize (rectHeight = textFontSize * 1.2)
+    // Overlay colors
+    Color gridColor1 = { 1.0f, 0.714f, 0.757f };   // First alternating grid box color (light pink)
+    float gridColor1Opacity = 1.0f;                // Opacity for gridColor1 (0.0 = transparent, 1.0 = opaque)
+    Color gridColor2 = { 0.678f, 0.847f, 0.902f }; // Second alternating grid box color (light blue)
+    float gridColor2Opacity = 1.0f;                // Opacity for gridColor2 (0.0 = transparent, 1.0 = opaque)
+    Color centerLineColor = { 1.0f, 1.0f, 1.0f };  // Vertical center line color (white)
+    float centerLineColorOpacity = 1.0f;           // Opacity for centerLineColor (0.0 = transparent, 1.0 = opaque)
+    Color textColor = { 0.0f, 0.0f, 0.0f };        // Number text color inside grid boxes (black)
+    float textColorOpacity = 1.0f;                 // Opacity for textColor (0.0 = transparent, 1.0 = opaque)
+    // Transition settings
+    bool slideZoomIn = false;    // If true, zoom slides in from left instead of growing with viewport
+    bool slideMirrorsIn = false; // If true, mirrors slide in from their nearest screen edge (left or right)
+};
+// GUI appearance configuration - ImGui color scheme
+struct AppearanceConfig {
+    std::string theme = "Dark";                // "Dark", "Light", "Classic", or "Custom"
+    std::map<std::string, Color> customColors; // Custom color overrides (only saved for "Custom" theme)
+};
+
+// Key rebinding configuration - intercept and remap keyboard keys
+struct KeyRebind {
+    DWORD fromKey = 0; // Original key to intercept
+    DWORD toKey = 0;   // Key to send instead (virtual key code)
+    bool enabled = true;
+
+    // Optional: Custom output settings (when useCustomOutput is true)
+    bool useCustomOutput = false;   // If true, use custom VK/scancode instead of auto-calculated
+    DWORD customOutputVK = 0;       // Custom virtual key code to output
+    DWORD customOutputScanCode = 0; // Custom scan code to output
+};
+struct KeyRebindsConfig {
+    bool enabled = false; // Master switch for all rebinds
+    std::vector<KeyRebind> rebinds;
+};
+// Everything in Config except the element sections: small, copied by value on every snapshot publish.
+struct ConfigSettings {
+    int configVersion = 1; // Config version for automatic upgrades
+    EyeZoomConfig eyezoom;
+    std::string defaultMode = "fullscreen";
+    DebugGlobalConfig debug;
+    std::vector<DWORD> guiHotkey = { VK_CONTROL, 'E' };
+    // Hotkey to toggle borderless-windowed fullscreen for the game window.
+    // Empty = disabled/unbound.
+    std::vector<DWORD> borderlessHotkey = {};
+    bool autoBorderless = false;
+    // Hotkeys to toggle overlay visibility (runtime only; does not change mode config).
+    // Empty = disabled/unbound.
+    std::vector<DWORD> imageOverlaysHotkey = {};
+    std::vector<DWORD> windowOverlaysHotkey = {};
+    CursorsConfig cursors;
+    std::string fontPath = "c:\\Windows\\Fonts\\Arial.ttf"; // Custom font path for ImGui
+    int fpsLimit = 0;                                       // FPS limit (0 = unlimited, 1-1000 = target FPS)
+    int fpsLimitSleepThreshold = 1000;                      // Microseconds threshold for using timer sleep during high FPS
+    // Global mirror color-matching colorspace/gamma mode (applies to all mirrors)
+    MirrorGammaMode mirrorGammaMode = MirrorGammaMode::Auto;
+    // When true, Toolscreen will NOT attempt to chain hooks behind third-party detours installed after us.
+    // Useful if a specific overlay/driver hook layer is unstable when chained.
+    bool disableHookChaining = true;
+    // When chaining is enabled, controls which function pointer the chained detour calls.
+    // - LatestHook: call the third-party trampoline (more compatible with overlays)
+    // - OriginalFunction: bypass third-party code (more stable if overlay hook is broken)
+    HookChainingNextTarget hookChainingNextTarget = HookChainingNextTarget::LatestHook;
+    bool allowCursorEscape = false;                         // Allow cursor to escape window boundaries
+    float mouseSensitivity = 1.0f;                          // Mouse sensitivity multiplier (1.0 = normal)
+    int windowsMouseSpeed = 0;                              // Windows mouse speed override (0 = disabled, 1-20 = override)
+    bool hideAnimationsInGame = false;                      // Show transition animations only on OBS, not in-game
+    KeyRebindsConfig keyRebinds;                            // Key rebinding configuration
+    AppearanceConfig appearance;                            // GUI color scheme configuration
+    int keyRepeatStartDelay = 0;                            // Key repeat start delay (0 = disabled, 1-500ms = custom)
+    int keyRepeatDelay = 0;                                 // Key repeat delay between repeats (0 = disabled, 1-500ms = custom)
+    bool basicModeEnabled = false;                          // true = Basic mode GUI, false = Advanced mode GUI (default)
+    bool disableFullscreenPrompt = false;                   // Disable fullscreen toast prompt (toast2)
+    bool disableConfigurePrompt = false;                    // Disable configure toast prompt (toast1)
+};
+
+// Element sections are SharedVectors (see shared_vector.h): a published snapshot shares every element node that
+// didn't change with the previous snapshot, so readers can compare sections/elements by identity.
+// Runtime name -> element index for one config section. On duplicate names the first element wins.
+using ConfigNameIndex = std::unordered_map<std::string, uint32_t>;
+// Runtime element handle -> element index (-1 if absent) for one config section. Same first-wins rule.
+using ConfigHandleIndex = std::vector<int>;
+
+struct Config : ConfigSettings {
+    SharedVector<MirrorConfig> mirrors;
+    SharedVector<MirrorGroupConfig> mirrorGroups;
+    SharedVector<ImageConfig> images;
+    SharedVector<WindowOverlayConfig> windowOverlays;
+    SharedVector<ModeConfig> modes;
+    SharedVector<HotkeyConfig> hotkeys;
+    SharedVector<SensitivityHotkeyConfig> sensitivityHotkeys; // Hotkeys for temporary sensitivity override
+
+    // Runtime index (not serialized): folded mode handle -> index into modes, -1 if absent.
+    // Built by PublishConfigSnapshot(); empty in the mutable g_config.
+    std::vector<int> modeIndexByHandle;
+    // Runtime name indexes (not serialized) for the named sections. Built by PublishConfigSnapshot() and shared with the
+    // previous snapshot while the section is; null in g_config, where lookups fall back to a scan.
+    std::shared_ptr<const ConfigNameIndex> mirrorIndexByName;
+    std::shared_ptr<const ConfigNameIndex> mirrorGroupIndexByName;
+    std::shared_ptr<const ConfigNameIndex> imageIndexByName;
+    std::shared_ptr<const ConfigNameIndex> windowOverlayIndexByName;
+    // Runtime handle indexes (not serialized), built and shared the same way as the name indexes
+    std::shared_ptr<const ConfigHandleIndex> mirrorIndexByHandle;
+    std::shared_ptr<const ConfigHandleIndex> mirrorGroupIndexByHandle;
+    std::shared_ptr<const ConfigHandleIndex> imageIndexByHandle;
+    std::shared_ptr<const ConfigHandleIndex> windowOverlayIndexByHandle;
+    // Runtime dispatch table (not serialized) for every key binding above. Built by PublishConfigSnapshot(); null in g_config.
+    std::shared_ptr<const HotkeyDispatchTable> hotkeyTable;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+// ============================================================================
+// CPU_FEATURES.H - Runtime SIMD feature detection for CPU kernels
+// ============================================================================
+// Kernels are compiled for several instruction sets side by side and pick one
+// at runtime, so the DLL keeps running on any x64 CPU (SSE2 is the baseline).
+// Detection runs once; results are cached in function-local statics.
+// ============================================================================
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#include <x86intrin.h>
+#endif
+
+// Function attribute for kernels that use instructions above the compile-time baseline.
+// MSVC allows any intrinsic in any function; GCC/Clang need the target attribute.
+#if defined(_MSC_VER)
+#define CPU_TARGET_SSE41
+#define CPU_TARGET_AVX2
+#else
+#define CPU_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+enum class CpuSimdLevel {
+    Scalar = 0,
+    SSE2 = 1,
+    SSE41 = 2,
+    AVX2 = 3,
+};
+
+inline const char* CpuSimdLevelToString(CpuSimdLevel level) {
+    switch (level) {
+    case CpuSimdLevel::SSE2:
+        return "SSE2";
+    case CpuSimdLevel::SSE41:
+        return "SSE4.1";
+    case CpuSimdLevel::AVX2:
+        return "AVX2";
+    default:
+        return "Scalar";
+    }
+}
+
+namespace cpu_features_detail {
+inline void CpuId(int leaf, int subleaf, int regs[4]) {
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, subleaf);
+#else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    regs[0] = static_cast<int>(a);
+    regs[1] = static_cast<int>(b);
+    regs[2] = static_cast<int>(c);
+    regs[3] = static_cast<int>(d);
+#endif
+}
+
+inline uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+inline CpuSimdLevel DetectSimdLevel() {
+    int regs[4] = { 0, 0, 0, 0 };
+    CpuId(0, 0, regs);
+    const int maxLeaf = regs[0];
+    if (maxLeaf < 1) return CpuSimdLevel::Scalar;
+
+    CpuId(1, 0, regs);
+    const bool sse2 = (regs[3] & (1 << 26)) != 0;
+    const bool sse41 = (regs[2] & (1 << 19)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!sse2) return CpuSimdLevel::Scalar;
+    if (!sse41) return CpuSimdLevel::SSE2;
+
+    // AVX2 requires OS support for saving YMM state (XCR0 bits 1 and 2)
+    if (maxLeaf >= 7 && osxsave && avx && (ReadXcr0() & 0x6) == 0x6) {
+        CpuId(7, 0, regs);
+        if (regs[1] & (1 << 5)) return CpuSimdLevel::AVX2;
+    }
+    return CpuSimdLevel::SSE41;
+}
+
+inline bool DetectInvariantTsc() {
+    int regs[4] = { 0, 0, 0, 0 };
+    CpuId(static_cast<int>(0x80000000u), 0, regs);
+    if (static_cast<unsigned int>(regs[0]) < 0x80000007u) return false;
+    CpuId(static_cast<int>(0x80000007u), 0, regs);
+    return (regs[3] & (1 << 8)) != 0;
+}
+} // namespace cpu_features_detail
+
+// Highest SIMD level supported by this CPU/OS (cached after the first call).
+inline CpuSimdLevel GetCpuSimdLevel() {
+    static const CpuSimdLevel s_level = cpu_features_detail::DetectSimdLevel();
+    return s_level;
+}
+
+// Clamp a requested level (e.g. from a benchmark or debug override) to what the CPU supports.
+inline CpuSimdLevel ResolveCpuSimdLevel(CpuSimdLevel requested) {
+    const CpuSimdLevel supported = GetCpuSimdLevel();
+    return (static_cast<int>(requested) < static_cast<int>(supported)) ? requested : supported;
+}
+
+// Invariant TSC: the time-stamp counter ticks at a constant rate in every P-/C-state and is synchronized across cores,
+// so RDTSC differences measure wall time (CPUID 0x80000007 EDX bit 8). Hypervisors may hide it. Cached after the first call.
+inline bool HasInvariantTsc() {
+    static const bool s_invariant = cpu_features_detail::DetectInvariantTsc();
+    return s_invariant;
+}
+
+inline uint64_t ReadTsc() { return __rdtsc(); }
@@ -0,0 +1,19 @@
+#pragma once
+
+// ============================================================================
+// DIAGNOSTICS_FILE.H - Dump and state files in the toolscreen folder
+// ============================================================================
+// Shared by the profiler's trace dumps and histogram exports, the metrics
+// export and the mirror statistics file. Defined in utils.cpp.
+// ============================================================================
+
+#include <filesystem>
+#include <string>
+
+// Writes a diagnostics dump to <toolscreen>/traces/<prefix>-YYYYMMDD-HHMMSS<extension> (suffixed when that name is
+// taken). pathOut receives the path even on failure.
+bool WriteDiagnosticsFile(const char* prefix, const char* extension, const std::string& contents, std::filesystem::path& pathOut);
+
+// Replaces <toolscreen>/<fileName> with contents: written to a temp file and renamed, so readers never see a partial
+// file. False when the toolscreen folder is unknown or the write failed.
+bool WriteToolscreenFile(const wchar_t* fileName, const std::string& contents);
@@ -1,9 +1,13 @@
+#include "config_publish.h"
 #include "fake_cursor.h"
 #include "gui.h"
+#include "hotkey_table.h"
 #include "imgui_cache.h"
 #include "input_hook.h"
 #include "logic_thread.h"
 #include "mirror_thread.h"
+#include "mouse_sensitivity.h"
+#include "nv12_convert.h"
 #include "obs_thread.h"
 #include "profiler.h"
 #include "render.h"
@@ -58,18 +62,33 @@ std::atomic<uint64_t> g_configSnapshotVersion{ 0 };
 // CONFIG SNAPSHOT (RCU) - Lock-free immutable config for reader threads
 // ============================================================================
 // The mutable g_config is only touched by the GUI/main thread.
-// After any mutation, PublishConfigSnapshot() copies it into a shared_ptr.
+// After any mutation, PublishConfigSnapshot() publishes it as a new immutable snapshot:
+// ConfigSettings are copied by value; each element section shares every node that
+// still equals the previous snapshot's, so only edited elements are copied.
 // Reader threads call GetConfigSnapshot() for a safe, lock-free snapshot.
 // ============================================================================
 static std::shared_ptr<const Config> g_configSnapshot;
 
 void PublishConfigSnapshot() {
-    auto snapshot = std::make_shared<const Config>(g_config);
+    auto previous = GetConfigSnapshot();
+    const Config* prev = previous.get();
+
+    auto snapshot = std::make_shared<Config>();
+    PublishConfigSections(g_config, prev, *snapshot);
+
+    BuildModeHandleIndex(*snapshot);
+    BuildElementIndexes(*snapshot, prev);
+    snapshot->hotkeyTable = CompileHotkeyDispatchTable(*snapshot, prev ? prev->hotkeyTable.get() : nullptr);
+    previous.reset();
+
     // Lock-free publish: atomic store of shared_ptr.
     std::atomic_store_explicit(&g_configSnapshot, std::move(snapshot), std::memory_order_release);
 
     // Bump version AFTER publishing.
     g_configSnapshotVersion.fetch_add(1, std::memory_order_release);
+
+    UpdateLogCategoryMask(g_config.debug);
+    RefreshEffectiveMouseSensitivity();
 }
 
 std::shared_ptr<const Config> GetConfigSnapshot() {
@@ -119,13 +138,70 @@ TempSensitivityOverride g_tempSensitivityOverride;
 std::mutex g_tempSensitivityMutex;
 
 void ClearTempSensitivityOverride() {
-    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-    g_tempSensitivityOverride.active = false;
-    g_tempSensitivityOverride.sensitivityX = 1.0f;
-    g_tempSensitivityOverride.sensitivityY = 1.0f;
-    g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+    {
+        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+        g_tempSensitivityOverride.active = false;
+        g_tempSensitivityOverride.sensitivityX = 1.0f;
+        g_tempSensitivityOverride.sensitivityY = 1.0f;
+        g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+    }
+    RefreshEffectiveMouseSensitivity();
+}
+
+// ============================================================================
+// EFFECTIVE MOUSE SENSITIVITY - Precomputed for the GetRawInputData hook
+// ============================================================================
+// High-polling-rate mice deliver thousands of raw input packets per second, so the hook must not
+// take locks or touch the config snapshot. Every input to the sensitivity (temp override, current
+// mode, transition target, config) republishes the resolved X/Y pair (see mouse_sensitivity.h).
+static PublishedMouseSensitivity g_effectiveMouseSensitivity;
+static std::mutex g_effectiveMouseSensitivityMutex; // Serializes refreshes so a stale result can't overwrite a newer one
+
+void RefreshEffectiveMouseSensitivity() {
+    std::lock_guard<std::mutex> refreshLock(g_effectiveMouseSensitivityMutex);
+
+    float sensitivityX = 1.0f;
+    float sensitivityY = 1.0f;
+    bool sensitivityDetermined = false;
+
+    // Priority 1: Temporary sensitivity override (from sensitivity hotkeys), until mode change
+    {
+        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+        if (g_tempSensitivityOverride.active) {
+            sensitivityX = g_tempSensitivityOverride.sensitivityX;
+            sensitivityY = g_tempSensitivityOverride.sensitivityY;
+            sensitivityDetermined = true;
+        }
+    }
+
+    // Priority 2: Mode-specific or global sensitivity
+    if (!sensitivityDetermined) {
+        const ViewportTransitionSnapshot transitionSnap = g_viewportTransitionSnapshot.Load();
+
+        // Use target mode during transitions, otherwise current mode
+        const ModeHandle modeHandle = transitionSnap.active ? transitionSnap.toModeId : g_currentModeHandle.load(std::memory_order_acquire);
+
+        auto cfgSnap = GetConfigSnapshot();
+        const ModeConfig* mode = cfgSnap ? GetModeFromSnapshot(*cfgSnap, modeHandle) : nullptr;
+        if (mode && mode->sensitivityOverrideEnabled) {
+            if (mode->separateXYSensitivity) {
+                sensitivityX = mode->modeSensitivityX;
+                sensitivityY = mode->modeSensitivityY;
+            } else {
+                sensitivityX = mode->modeSensitivity;
+                sensitivityY = mode->modeSensitivity;
+            }
+        } else if (cfgSnap) {
+            sensitivityX = cfgSnap->mouseSensitivity;
+            sensitivityY = cfgSnap->mouseSensitivity;
+        }
+    }
+
+    g_effectiveMouseSensitivity.Publish(sensitivityX, sensitivityY);
 }
 
+void GetEffectiveMouseSensitivity(float& outX, float& outY) { g_effectiveMouseSensitivity.Load(outX, outY); }
+
 std::atomic<bool> g_cursorsNeedReload{ false };
 std::atomic<bool> g_showGui{ false };
 std::atomic<bool> g_imageOverlaysVisible{ true };
@@ -135,9 +211,8 @@ std::atomic<HWND> g_minecraftHwnd{ NULL };
 std::wstring g_toolscreenPath;
 std::string g_currentModeId = "";
 std::mutex g_modeIdMutex;
-// Lock-free mode ID access (double-buffered) - input handlers read from these without locking
-std::string g_modeIdBuffers[2] = { "", "" };
-std::atomic<int> g_currentModeIdIndex{ 0 };
+// Lock-free current mode - input handlers and hot paths read this without locking
+std::atomic<ModeHandle> g_currentModeHandle{ NO_MODE_HANDLE };
 std::atomic<bool> g_screenshotRequested{ false };
 std::atomic<bool> g_pendingImageLoad{ false };
 std::string g_configLoadError;
@@ -145,7 +220,6 @@ std::mutex g_configErrorMutex;
 std::wstring g_modeFilePath;
 std::atomic<bool> g_configLoadFailed{ false };
 std::atomic<bool> g_configLoaded{ false }; // Set to true once LoadConfig() completes successfully
-std::map<std::string, std::chrono::steady_clock::time_point> g_hotkeyTimestamps;
 std::atomic<bool> g_guiNeedsRecenter{ true };
 std::atomic<bool> g_wasCursorVisible{ true };
 // Lock-free GUI toggle debounce timestamp
@@ -155,11 +229,6 @@ enum CapturingState { NONE = 0, DISABLED = 1, NORMAL = 2 };
 std::atomic<CapturingState> g_capturingMousePos{ CapturingState::NONE };
 std::atomic<std::pair<int, int>> g_nextMouseXY{ std::make_pair(-1, -1) };
 
-std::set<DWORD> g_hotkeyMainKeys;
-std::mutex g_hotkeyMainKeysMutex;
-
-std::mutex g_hotkeyTimestampsMutex;
-
 // Track trigger-on-release hotkeys that are currently pressed
 // Key is the hotkey ID string (from GetKeyComboString)
 std::set<std::string> g_triggerOnReleasePending;
@@ -195,8 +264,7 @@ static std::atomic<HGLRC> g_lastSeenGameGLContext{ NULL };
 ModeTransitionAnimation g_modeTransition;
 std::mutex g_modeTransitionMutex;
 // Lock-free snapshot for viewport hook
-ViewportTransitionSnapshot g_viewportTransitionSnapshots[2];
-std::atomic<int> g_viewportTransitionSnapshotIndex{ 0 };
+VersionedSnapshot<ViewportTransitionSnapshot> g_viewportTransitionSnapshot;
 
 PendingModeSwitch g_pendingModeSwitch;
 std::mutex g_pendingModeSwitchMutex;
@@ -216,13 +284,9 @@ FILTERKEYS g_originalFilterKeys = { sizeof(FILTERKEYS) }; // Original FILTERKEYS
 std::atomic<bool> g_filterKeysApplied{ false };
 std::atomic<bool> g_originalFilterKeysCaptured{ false }; // Track if original FILTERKEYS snapshot has been captured
 
-std::string g_lastFrameModeId = "";
-std::mutex g_lastFrameModeIdMutex;
-// Lock-free last frame mode ID for viewport hook
-std::string g_lastFrameModeIdBuffers[2] = { "", "" };
-std::atomic<int> g_lastFrameModeIdIndex{ 0 };
-std::string g_gameStateBuffers[2] = { "title", "title" };
-std::atomic<int> g_currentGameStateIndex{ 0 };
+// Lock-free last frame mode for viewport hook
+std::atomic<ModeHandle> g_lastFrameModeHandle{ NO_MODE_HANDLE };
+VersionedSnapshot<GameStateText> g_gameState{ GameStateText::From("title") };
 const ModeConfig* g_currentMode = nullptr;
 
 std::atomic<bool> g_gameWindowActive{ false };
@@ -311,113 +375,16 @@ template <typename T> bool CreateHookOrDie(LPVOID pTarget, LPVOID pDetour, T** p
         Log(errorMsg);
         return false;
     }
-    LogCategory("init", "Created hook for " + std::string(hookName));
+    LogCategory(LogCat::Init, "Created hook for " + std::string(hookName));
     return true;
 }
 
-// Internal function to rebuild hotkey main keys cache
-// REQUIRES: g_configMutex and g_hotkeyMainKeysMutex must already be held by caller
-void RebuildHotkeyMainKeys_Internal() {
-    g_hotkeyMainKeys.clear();
-
-    // Helper lambda to check if a key is a modifier
-    auto isModifier = [](DWORD key) {
-        return key == VK_CONTROL || key == VK_LCONTROL || key == VK_RCONTROL || key == VK_SHIFT || key == VK_LSHIFT || key == VK_RSHIFT ||
-               key == VK_MENU || key == VK_LMENU || key == VK_RMENU;
-    };
-
-    // Helper lambda to add the main key from a key list
-    // The main key is the last key in the list, OR if all keys are modifiers,
-    // the last modifier is treated as the main key
-    auto addMainKey = [&](const std::vector<DWORD>& keys) {
-        if (keys.empty()) return;
-        DWORD mainKey = keys.back();
-        g_hotkeyMainKeys.insert(mainKey);
-
-        // For modifier keys, also add the generic version since Windows sends
-        // VK_CONTROL/VK_SHIFT/VK_MENU in wParam, not the left/right-specific codes
-        if (mainKey == VK_LCONTROL || mainKey == VK_RCONTROL) {
-            g_hotkeyMainKeys.insert(VK_CONTROL);
-        } else if (mainKey == VK_CONTROL) {
-            // If the binding uses the generic modifier, also accept left/right variants
-            g_hotkeyMainKeys.insert(VK_LCONTROL);
-            g_hotkeyMainKeys.insert(VK_RCONTROL);
-        } else if (mainKey == VK_LSHIFT || mainKey == VK_RSHIFT) {
-            g_hotkeyMainKeys.insert(VK_SHIFT);
-        } else if (mainKey == VK_SHIFT) {
-            g_hotkeyMainKeys.insert(VK_LSHIFT);
-            g_hotkeyMainKeys.insert(VK_RSHIFT);
-        } else if (mainKey == VK_LMENU || mainKey == VK_RMENU) {
-            g_hotkeyMainKeys.insert(VK_MENU);
-        } else if (mainKey == VK_MENU) {
-            g_hotkeyMainKeys.insert(VK_LMENU);
-            g_hotkeyMainKeys.insert(VK_RMENU);
-        }
-    };
-
-    // Extract main keys from all hotkey configurations
-    for (const auto& hotkey : g_config.hotkeys) {
-        // Main hotkey
-        addMainKey(hotkey.keys);
-
-        // Alt secondary mode hotkeys
-        for (const auto& alt : hotkey.altSecondaryModes) { addMainKey(alt.keys); }
-    }
-
-    // Extract main keys from sensitivity hotkeys
-    for (const auto& sensHotkey : g_config.sensitivityHotkeys) { addMainKey(sensHotkey.keys); }
-
-    // Also include GUI hotkey
-    addMainKey(g_config.guiHotkey);
-
-    // Also include borderless toggle hotkey (optional)
-    addMainKey(g_config.borderlessHotkey);
-
-    // Always include Escape as it can toggle GUI
-    g_hotkeyMainKeys.insert(VK_ESCAPE);
-
-    // Include key rebinds so they're not skipped by the early exit optimization
-    if (g_config.keyRebinds.enabled) {
-        for (const auto& rebind : g_config.keyRebinds.rebinds) {
-            if (rebind.enabled && rebind.fromKey != 0) {
-                g_hotkeyMainKeys.insert(rebind.fromKey);
-
-                // Mirror the modifier normalization rules so rebinding VK_RSHIFT still works even though
-                // Windows may deliver VK_SHIFT in wParam (and vice-versa).
-                if (rebind.fromKey == VK_LCONTROL || rebind.fromKey == VK_RCONTROL) {
-                    g_hotkeyMainKeys.insert(VK_CONTROL);
-                } else if (rebind.fromKey == VK_CONTROL) {
-                    g_hotkeyMainKeys.insert(VK_LCONTROL);
-                    g_hotkeyMainKeys.insert(VK_RCONTROL);
-                } else if (rebind.fromKey == VK_LSHIFT || rebind.fromKey == VK_RSHIFT) {
-                    g_hotkeyMainKeys.insert(VK_SHIFT);
-                } else if (rebind.fromKey == VK_SHIFT) {
-                    g_hotkeyMainKeys.insert(VK_LSHIFT);
-                    g_hotkeyMainKeys.insert(VK_RSHIFT);
-                } else if (rebind.fromKey == VK_LMENU || rebind.fromKey == VK_RMENU) {
-                    g_hotkeyMainKeys.insert(VK_MENU);
-                } else if (rebind.fromKey == VK_MENU) {
-                    g_hotkeyMainKeys.insert(VK_LMENU);
-                    g_hotkeyMainKeys.insert(VK_RMENU);
-                }
-            }
-        }
-    }
-}
-
-// Public function to rebuild the set of main keys used in hotkey bindings
-// This version acquires both required locks - use when you don't already hold them
-void RebuildHotkeyMainKeys() {
-    std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-    RebuildHotkeyMainKeys_Internal();
-}
-
 // Save the original Windows mouse speed setting
 void SaveOriginalWindowsMouseSpeed() {
     int currentSpeed = 0;
     if (SystemParametersInfo(SPI_GETMOUSESPEED, 0, &currentSpeed, 0)) {
         g_originalWindowsMouseSpeed = currentSpeed;
-        LogCategory("init", "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
+        LogCategory(LogCat::Init, "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
     } else {
         Log("WARNING: Failed to get current Windows mouse speed");
         g_originalWindowsMouseSpeed = 10; // Default to middle value
@@ -469,9 +436,9 @@ void SaveOriginalKeyRepeatSettings() {
     g_originalFilterKeys.cbSize = sizeof(FILTERKEYS);
     if (SystemParametersInfo(SPI_GETFILTERKEYS, sizeof(FILTERKEYS), &g_originalFilterKeys, 0)) {
         g_originalFilterKeysCaptured.store(true);
-        LogCategory("init", "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
-                                ", iDelayMSec=" + std::to_string(g_originalFilterKeys.iDelayMSec) +
-                                ", iRepeatMSec=" + std::to_string(g_originalFilterKeys.iRepeatMSec));
+        LogCategory(LogCat::Init, "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
+                                      ", iDelayMSec=" + std::to_string(g_originalFilterKeys.iDelayMSec) +
+                                      ", iRepeatMSec=" + std::to_string(g_originalFilterKeys.iRepeatMSec));
     } else {
         Log("WARNING: Failed to get current FILTERKEYS settings");
         // Initialize with defaults
@@ -631,7 +598,7 @@ static HCURSOR SetCursorHook_Impl(SETCURSORPROC next, HCURSOR hCursor) {
 
     if (g_gameVersion >= GameVersion(1, 13, 0)) { return next(hCursor); }
 
-    std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
+    std::string localGameState = GetCurrentGameState();
 
     if (g_showGui.load()) {
         const CursorTextures::CursorData* cursorData = CursorTextures::GetSelectedCursor(localGameState, 64);
@@ -692,6 +659,19 @@ HCURSOR WINAPI hkSetCursor_ThirdParty(HCURSOR hCursor) {
 static int lastViewportW = 0;
 static int lastViewportH = 0;
 
+// Viewport calls that needed a fullscreen check (profiler counter; each one used to be a live IsFullscreen())
+static std::atomic<uint64_t> s_viewportFullscreenChecks{ 0 };
+
+static void RegisterViewportProfilerCounters() {
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.RegisterCounter("glViewport Hook Calls", "calls",
+                             [] { return static_cast<double>(s_viewportFullscreenChecks.load(std::memory_order_relaxed)); });
+
+    // Estimated: every hook call would have paid one geometry query; the cache pays one per refresh instead.
+    profiler.RegisterCounter("Fullscreen Check Time Saved (est.)", "us",
+                             [] { return static_cast<double>(GetFullscreenCheckTimeSavedNs()) / 1000.0; });
+}
+
 static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsizei width, GLsizei height) {
     // If called before hook installation completed, fail-safe to the unmodified call.
     if (!next) return;
@@ -701,18 +681,19 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
         return next(x, y, width, height);
     }
 
-    if (!IsFullscreen()) {
+    s_viewportFullscreenChecks.fetch_add(1, std::memory_order_relaxed);
+    CountCachedFullscreenCheck();
+    if (!IsFullscreenCached()) {
         // Log("viewport not fullscreen");
         return next(x, y, width, height);
     }
 
     // Lock-free read of transition snapshot
-    const ViewportTransitionSnapshot& transitionSnap =
-        g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
+    const ViewportTransitionSnapshot transitionSnap = g_viewportTransitionSnapshot.Load();
     bool isTransitionActive = transitionSnap.active;
 
     // Lock-free read of cached mode viewport data (updated by logic_thread)
-    const CachedModeViewport& cachedMode = g_viewportModeCache[g_viewportModeCacheIndex.load(std::memory_order_acquire)];
+    const CachedModeViewport cachedMode = g_viewportModeCache.Load();
 
     // During transitions, we can derive dimensions from the transition snapshot even if cache is stale.
     // The snapshot is updated synchronously on mode switch, while cache has ~16ms lag.
@@ -887,7 +868,7 @@ static void AttemptHookGlBlitNamedFramebufferViaGlew() {
     }
 
     s_hooked.store(true, std::memory_order_release);
-    LogCategory("init", "Successfully hooked glBlitNamedFramebuffer via GLEW");
+    LogCategory(LogCat::Init, "Successfully hooked glBlitNamedFramebuffer via GLEW");
 }
 
 static BOOL SetCursorPosHook_Impl(SETCURSORPOSPROC next, int X, int Y) {
@@ -1003,78 +984,18 @@ static UINT GetRawInputDataHook_Impl(GETRAWINPUTDATAPROC next, HRAWINPUT hRawInp
 
     // Handle mouse sensitivity
     if (raw->header.dwType == RIM_TYPEMOUSE) {
-        // Get sensitivity setting using LOCK-FREE access to avoid input delay
-        // This is critical for low-latency input processing
+        // Single atomic load of the precomputed sensitivity (no locks or snapshot access per packet)
         float sensitivityX = 1.0f;
         float sensitivityY = 1.0f;
-        bool sensitivityDetermined = false;
-
-        // Priority 1: Check for temporary sensitivity override (from sensitivity hotkeys)
-        // This takes precedence over all other sensitivity settings until mode change
-        {
-            std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-            if (g_tempSensitivityOverride.active) {
-                sensitivityX = g_tempSensitivityOverride.sensitivityX;
-                sensitivityY = g_tempSensitivityOverride.sensitivityY;
-                sensitivityDetermined = true;
-            }
-        }
-
-        // Priority 2: Mode-specific or global sensitivity (if no temp override)
-        if (!sensitivityDetermined) {
-            // Lock-free read: check transition snapshot first
-            const ViewportTransitionSnapshot& transitionSnap =
-                g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
-
-            // Get mode ID: use target mode during transitions, otherwise current mode
-            std::string modeId;
-            if (transitionSnap.active) {
-                modeId = transitionSnap.toModeId; // Target mode during transition (lock-free from snapshot)
-            } else {
-                // Lock-free read of current mode ID from double-buffer
-                modeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-            }
-
-            // Check if the mode has a sensitivity override (use snapshot for thread safety)
-            auto inputCfgSnap = GetConfigSnapshot();
-            const ModeConfig* mode = inputCfgSnap ? GetModeFromSnapshot(*inputCfgSnap, modeId) : nullptr;
-            if (mode && mode->sensitivityOverrideEnabled) {
-                if (mode->separateXYSensitivity) {
-                    sensitivityX = mode->modeSensitivityX;
-                    sensitivityY = mode->modeSensitivityY;
-                } else {
-                    sensitivityX = mode->modeSensitivity;
-                    sensitivityY = mode->modeSensitivity;
-                }
-            } else if (inputCfgSnap) {
-                sensitivityX = inputCfgSnap->mouseSensitivity;
-                sensitivityY = inputCfgSnap->mouseSensitivity;
-            }
-        }
+        GetEffectiveMouseSensitivity(sensitivityX, sensitivityY);
 
         // Only process if sensitivity is different from default
         if (sensitivityX != 1.0f || sensitivityY != 1.0f) {
             // Only apply to relative mouse movement (not absolute positioning)
             if (!(raw->data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE)) {
-                // Use accumulators to preserve fractional movements that would otherwise be lost
-                // This prevents small movements from being truncated to zero with sub-1.0 sensitivity
-                static float xAccum = 0.0f;
-                static float yAccum = 0.0f;
-
-                // Add scaled movement to accumulator
-                xAccum += raw->data.mouse.lLastX * sensitivityX;
-                yAccum += raw->data.mouse.lLastY * sensitivityY;
-
-                // Extract integer portion for output
-                LONG outputX = static_cast<LONG>(xAccum);
-                LONG outputY = static_cast<LONG>(yAccum);
-
-                // Keep fractional remainder for next frame
-                xAccum -= outputX;
-                yAccum -= outputY;
-
-                raw->data.mouse.lLastX = outputX;
-                raw->data.mouse.lLastY = outputY;
+                // Accumulate so small movements aren't truncated to zero with sub-1.0 sensitivity
+                static RawMouseAccumulator s_accumulator;
+                s_accumulator.Scale(raw->data.mouse.lLastX, raw->data.mouse.lLastY, sensitivityX, sensitivityY);
             }
         }
     }
@@ -1282,7 +1203,7 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
             PROFILE_SCOPE_CAT("GLEW Initialization", "SwapBuffers");
             glewExperimental = GL_TRUE;
             if (glewInit() == GLEW_OK) {
-                LogCategory("init", "[RENDER] GLEW Initialized successfully.");
+                LogCategory(LogCat::Init, "[RENDER] GLEW Initialized successfully.");
                 g_glewLoaded = true;
 
                 // Record the initial context used for sharing.
@@ -1299,7 +1220,7 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
                 HGLRC currentContext = wglGetCurrentContext();
                 if (currentContext) {
                     if (InitializeSharedContexts(currentContext, hDc)) {
-                        LogCategory("init", "[RENDER] Shared contexts initialized - GPU texture sharing enabled for all threads");
+                        LogCategory(LogCat::Init, "[RENDER] Shared contexts initialized - GPU texture sharing enabled for all threads");
                     } else {
                         Log("[RENDER] Shared context initialization failed - starting worker threads in fallback mode");
                     }
@@ -1502,7 +1423,8 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
                         // SubmitFrameCapture already inserts its own fences and flushes after them;
                         // avoid an extra glFlush here (it can reduce FPS by forcing more driver work per frame).
                         if (allowCaptureThisFrame) {
-                            SubmitFrameCapture(gameTexture, viewport.width, viewport.height);
+                            const bool mirrorsOnly = needCaptureForMirrors && !needCaptureForEyeZoom && !needCaptureForObsOrVc;
+                            SubmitFrameCapture(gameTexture, viewport.width, viewport.height, mirrorsOnly);
                         }
                     }
                 }
@@ -1963,22 +1885,20 @@ void main() {
             return next(hDc);
         }
 
-        // Lock-free read of current mode ID from double-buffer
-        std::string desiredModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-
-        // Lock-free read of last frame mode ID from double-buffer
-        std::string lastFrameModeIdCopy = g_lastFrameModeIdBuffers[g_lastFrameModeIdIndex.load(std::memory_order_acquire)];
+        // Lock-free read of current and last frame mode handles
+        const ModeHandle desiredModeHandle = g_currentModeHandle.load(std::memory_order_acquire);
+        const ModeHandle lastFrameModeHandle = g_lastFrameModeHandle.load(std::memory_order_acquire);
 
         // Check if mode transition is active (but DON'T update yet - update after rendering
         // so that glViewport hook and RenderModeInternal use the same snapshot values)
         if (IsModeTransitionActive()) {
             g_isTransitioningMode = true;
-        } else if (lastFrameModeIdCopy != desiredModeId) {
+        } else if (lastFrameModeHandle != desiredModeHandle) {
             // Mode changed but animation already completed or wasn't started
             // This handles cases where SwitchToMode was called and animation is complete
             PROFILE_SCOPE_CAT("Mode Transition Complete", "SwapBuffers");
             g_isTransitioningMode = true;
-            Log("Mode transition detected (no animation): " + lastFrameModeIdCopy + " -> " + desiredModeId);
+            Log("Mode transition detected (no animation): " + ModeIdName(lastFrameModeHandle) + " -> " + ModeIdName(desiredModeHandle));
 
             // Send final WM_SIZE to ensure game has correct dimensions (only in fullscreen mode)
             // In windowed mode, the game manages its own window size - don't override it
@@ -1986,7 +1906,7 @@ void main() {
                 int modeWidth = 0, modeHeight = 0;
                 bool modeValid = false;
                 {
-                    const ModeConfig* newMode = GetMode(desiredModeId);
+                    const ModeConfig* newMode = GetModeFromSnapshot(frameCfg, desiredModeHandle);
                     if (newMode) {
                         modeWidth = newMode->width;
                         modeHeight = newMode->height;
@@ -1999,37 +1919,40 @@ void main() {
 
         // Note: Video player update is now done in render_thread
 
-        std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
+        std::string localGameState = GetCurrentGameState();
 
         bool showPerformanceOverlay = frameCfg.debug.showPerformanceOverlay;
         bool showProfiler = frameCfg.debug.showProfiler;
 
         // Enable/disable profiler based on config
-        Profiler::GetInstance().SetEnabled(showProfiler);
-        if (showProfiler) { Profiler::GetInstance().MarkAsRenderThread(); }
+        static std::once_flag s_profilerCountersRegistered;
+        std::call_once(s_profilerCountersRegistered, RegisterViewportProfilerCounters);
+        const bool flightRecorder = frameCfg.debug.flightRecorderEnabled;
+        Profiler::GetInstance().SetEnabled(showProfiler || flightRecorder);
+        Profiler::GetInstance().ConfigureFlightRecorder(flightRecorder, frameCfg.debug.flightRecorderSeconds,
+                                                        frameCfg.debug.flightRecorderHitchMs);
+        Profiler::GetInstance().SetLatencyThresholds(frameCfg.debug.profilerThreshold1Ms, frameCfg.debug.profilerThreshold2Ms);
+        if (showProfiler || flightRecorder) {
+            Profiler::GetInstance().MarkAsRenderThread();
+            Profiler::GetInstance().SetThreadName("Game");
+        }
 
-        ModeConfig modeToRenderCopy;
-        bool modeFound = false;
-        {
-            // Use target/desired mode - GetMode is lock-free
-            const ModeConfig* tempMode = GetMode(desiredModeId);
-            if (!tempMode && g_isTransitioningMode) {
-                // Fallback to old mode if new mode not found
-                tempMode = GetMode(lastFrameModeIdCopy);
-            }
-            if (tempMode) {
-                modeToRenderCopy = *tempMode;
-                modeFound = true;
-            }
+        // Use target/desired mode from this frame's snapshot (which outlives every use below)
+        ModeHandle modeToRenderHandle = desiredModeHandle;
+        const ModeConfig* modeToRender = GetModeFromSnapshot(frameCfg, desiredModeHandle);
+        if (!modeToRender && g_isTransitioningMode) {
+            // Fallback to old mode if new mode not found
+            modeToRenderHandle = lastFrameModeHandle;
+            modeToRender = GetModeFromSnapshot(frameCfg, lastFrameModeHandle);
         }
 
         // Validate mode before proceeding
-        if (!modeFound) {
+        if (!modeToRender) {
             Log("ERROR: Could not find mode to render, aborting frame");
             return next(hDc);
         }
 
-        bool isEyeZoom = modeToRenderCopy.id == "EyeZoom";
+        bool isEyeZoom = modeToRender->id == "EyeZoom";
         bool shouldRenderGui = g_showGui.load();
 
         // Check if we're transitioning FROM EyeZoom
@@ -2038,13 +1961,13 @@ void main() {
 
         if (IsModeTransitionActive()) {
             ModeTransitionState eyeZoomTransitionState = GetModeTransitionState();
-            std::string fromModeId = eyeZoomTransitionState.fromModeId;
+            const bool fromEyeZoom = (eyeZoomTransitionState.fromModeId == EyeZoomModeHandle());
 
-            if (!isEyeZoom && fromModeId == "EyeZoom") {
+            if (!isEyeZoom && fromEyeZoom) {
                 // Transitioning FROM EyeZoom - animate out with bounce (follow viewport position)
                 isTransitioningFromEyeZoom = true;
                 eyeZoomAnimatedViewportX = eyeZoomTransitionState.x;
-            } else if (isEyeZoom && fromModeId != "EyeZoom") {
+            } else if (isEyeZoom && !fromEyeZoom) {
                 // Transitioning TO EyeZoom - use animated position during transition in
                 eyeZoomAnimatedViewportX = eyeZoomTransitionState.x;
             }
@@ -2074,17 +1997,17 @@ void main() {
         // skip ALL custom rendering work (including expensive GL state backup).
         // This is critical for games like Minecraft where repeated glGet* calls can stall the driver.
         {
-            const bool modeSizesFullscreen = (modeToRenderCopy.width == fullW && modeToRenderCopy.height == fullH);
+            const bool modeSizesFullscreen = (modeToRender->width == fullW && modeToRender->height == fullH);
             const bool stretchIsFullscreen =
-                (!modeToRenderCopy.stretch.enabled) ||
-                (modeToRenderCopy.stretch.width == fullW && modeToRenderCopy.stretch.height == fullH && modeToRenderCopy.stretch.x == 0 &&
-                 modeToRenderCopy.stretch.y == 0);
-            const bool borderVisible = modeToRenderCopy.border.enabled && modeToRenderCopy.border.width > 0;
+                (!modeToRender->stretch.enabled) ||
+                (modeToRender->stretch.width == fullW && modeToRender->stretch.height == fullH && modeToRender->stretch.x == 0 &&
+                 modeToRender->stretch.y == 0);
+            const bool borderVisible = modeToRender->border.enabled && modeToRender->border.width > 0;
 
             const bool anyModeOverlaysConfigured =
-                (!modeToRenderCopy.mirrorIds.empty() || !modeToRenderCopy.mirrorGroupIds.empty() ||
-                 (g_imageOverlaysVisible.load(std::memory_order_acquire) && !modeToRenderCopy.imageIds.empty()) ||
-                 (g_windowOverlaysVisible.load(std::memory_order_acquire) && !modeToRenderCopy.windowOverlayIds.empty()));
+                (!modeToRender->mirrorIds.empty() || !modeToRender->mirrorGroupIds.empty() ||
+                 (g_imageOverlaysVisible.load(std::memory_order_acquire) && !modeToRender->imageIds.empty()) ||
+                 (g_windowOverlaysVisible.load(std::memory_order_acquire) && !modeToRender->windowOverlayIds.empty()));
 
             const bool anyImGuiOrDebugOverlay = shouldRenderGui || showPerformanceOverlay || showProfiler || showEyeZoomOnScreen ||
                                                 frameCfg.debug.showTextureGrid;
@@ -2153,12 +2076,7 @@ void main() {
                 std::chrono::duration<double, std::milli> fp_ms = swapStartTime - startTime;
                 g_lastFrameTimeMs = fp_ms.count();
 
-                {
-                    int nextIndex = 1 - g_lastFrameModeIdIndex.load(std::memory_order_relaxed);
-                    g_lastFrameModeIdBuffers[nextIndex] = desiredModeId;
-                    g_lastFrameModeIdIndex.store(nextIndex, std::memory_order_release);
-                    g_lastFrameModeId = desiredModeId;
-                }
+                g_lastFrameModeHandle.store(desiredModeHandle, std::memory_order_release);
 
                 return result;
             }
@@ -2198,6 +2116,10 @@ void main() {
 
         // Note: Image processing is now done in render_thread
 
+        // Apply a hand-edited config.toml, then rebuild the GPU resources of whatever the published config changed
+        ApplyPendingConfigReload();
+        SyncConfigResources();
+
         if (g_pendingImageLoad) {
             PROFILE_SCOPE_CAT("Pending Image Load", "SwapBuffers");
             LoadAllImages();
@@ -2208,8 +2130,8 @@ void main() {
         // Use mode dimensions for game texture sampling, NOT viewport dimensions
         // The viewport may be animated/stretched during mode transitions, but
         // the game texture always remains at the mode's configured width/height
-        int current_gameW = modeToRenderCopy.width;
-        int current_gameH = modeToRenderCopy.height;
+        int current_gameW = modeToRender->width;
+        int current_gameH = modeToRender->height;
 
         // Reset OBS capture ready flag each frame - only set true when we have fresh animated content
         // This ensures OBS captures from backbuffer normally when not animating
@@ -2236,11 +2158,11 @@ void main() {
                     submission.context.gameW = current_gameW;
                     submission.context.gameH = current_gameH;
                     submission.context.gameTextureId = g_cachedGameTextureId.load();
-                    submission.context.modeId = modeToRenderCopy.id;
-                    submission.context.relativeStretching = modeToRenderCopy.relativeStretching;
-                    submission.context.bgR = modeToRenderCopy.background.color.r;
-                    submission.context.bgG = modeToRenderCopy.background.color.g;
-                    submission.context.bgB = modeToRenderCopy.background.color.b;
+                    submission.context.modeId = modeToRenderHandle;
+                    submission.context.relativeStretching = modeToRender->relativeStretching;
+                    submission.context.bgR = modeToRender->background.color.r;
+                    submission.context.bgG = modeToRender->background.color.g;
+                    submission.context.bgB = modeToRender->background.color.b;
                     submission.context.shouldRenderGui = shouldRenderGui;
                     submission.context.showPerformanceOverlay = showPerformanceOverlay;
                     submission.context.showProfiler = showProfiler;
@@ -2273,7 +2195,7 @@ void main() {
                 if (isFull) {
                     // Render user view - skip animation only if hideAnimationsInGame is enabled
                     PROFILE_SCOPE_CAT("Render for Screen", "Rendering");
-                    RenderMode(&modeToRenderCopy, s, current_gameW, current_gameH, hideAnimOnScreen,
+                    RenderMode(modeToRender, s, current_gameW, current_gameH, hideAnimOnScreen,
                                false); // hideAnimOnScreen controls animation, false = include onlyOnMyScreen
                 }
 
@@ -2281,7 +2203,7 @@ void main() {
             } else {
                 // No OBS hook detected - just render for user's screen (only in fullscreen)
                 // Still respect hideAnimationsInGame setting (hideAnimOnScreen = hideAnimationsInGame && transitioning)
-                if (isFull) { RenderMode(&modeToRenderCopy, s, current_gameW, current_gameH, hideAnimOnScreen, false); }
+                if (isFull) { RenderMode(modeToRender, s, current_gameW, current_gameH, hideAnimOnScreen, false); }
 
                 // Note: EyeZoom rendering is now done inside RenderModeInternal (before async overlay blit)
             }
@@ -2311,14 +2233,8 @@ void main() {
 
         Profiler::GetInstance().EndFrame();
 
-        // Update last frame mode ID using lock-free double-buffer
-        // We're the only writer on this thread, so no lock needed - just atomic swap
-        {
-            int nextIndex = 1 - g_lastFrameModeIdIndex.load(std::memory_order_relaxed);
-            g_lastFrameModeIdBuffers[nextIndex] = desiredModeId;
-            g_lastFrameModeIdIndex.store(nextIndex, std::memory_order_release);
-            g_lastFrameModeId = desiredModeId; // Keep legacy variable in sync (no lock needed - single writer)
-        }
+        // Update last frame mode (single writer, lock-free)
+        g_lastFrameModeHandle.store(desiredModeHandle, std::memory_order_release);
 
         g_isTransitioningMode = false;
 
@@ -2399,13 +2315,8 @@ void main() {
         std::chrono::duration<double, std::milli> fp_ms = swapStartTime - startTime;
         g_lastFrameTimeMs = fp_ms.count();
 
-        // Update last frame mode ID for next frame's viewport calculations (lock-free)
-        {
-            int nextIndex = 1 - g_lastFrameModeIdIndex.load(std::memory_order_relaxed);
-            g_lastFrameModeIdBuffers[nextIndex] = desiredModeId;
-            g_lastFrameModeIdIndex.store(nextIndex, std::memory_order_release);
-            g_lastFrameModeId = desiredModeId; // Keep legacy variable in sync
-        }
+        // Update last frame mode for next frame's viewport calculations (lock-free)
+        g_lastFrameModeHandle.store(desiredModeHandle, std::memory_order_release);
 
         return result;
     } catch (const SE_Exception& e) {
@@ -2442,9 +2353,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         InstallGlobalExceptionHandlers();
 
         // Verify logging works immediately
-        LogCategory("init", "========================================");
-        LogCategory("init", "=== Toolscreen INITIALIZATION START ===");
-        LogCategory("init", "========================================");
+        LogCategory(LogCat::Init, "========================================");
+        LogCategory(LogCat::Init, "=== Toolscreen INITIALIZATION START ===");
+        LogCategory(LogCat::Init, "========================================");
         PrintVersionToStdout();
 
         // Create high-resolution waitable timer for FPS limiting (Windows 10 1803+)
@@ -2454,7 +2365,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                                                 TIMER_ALL_ACCESS                       // Full access
         );
         if (g_highResTimer) {
-            LogCategory("init", "High-resolution waitable timer created successfully for FPS limiting.");
+            LogCategory(LogCat::Init, "High-resolution waitable timer created successfully for FPS limiting.");
         } else {
             Log("Warning: Failed to create high-resolution waitable timer. FPS limiting may be less precise.");
         }
@@ -2544,7 +2455,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
             g_modeFilePath = g_toolscreenPath + L"\\mode.txt";
         }
-        LogCategory("init", "--- DLL instance attached ---");
+        LogCategory(LogCat::Init, "--- DLL instance attached ---");
         LogVersionInfo(); // Log version information
         if (g_toolscreenPath.empty()) { Log("FATAL: Could not get toolscreen directory."); }
 
@@ -2563,10 +2474,10 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             } else {
                 oss << " is outside supported range [1.16.1 - 1.18.2].";
             }
-            LogCategory("init", oss.str());
+            LogCategory(LogCat::Init, oss.str());
         } else {
             // No version detected - enable hook by default for backward compatibility
-            LogCategory("init", "No game version detected from command line.");
+            LogCategory(LogCat::Init, "No game version detected from command line.");
         }
 
         LoadConfig();
@@ -2574,14 +2485,14 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         WCHAR dir[MAX_PATH];
         if (GetCurrentDirectoryW(MAX_PATH, dir) > 0) {
             g_stateFilePath = std::wstring(dir) + L"\\wpstateout.txt";
-            LogCategory("init", "State file path set to: " + WideToUtf8(g_stateFilePath));
+            LogCategory(LogCat::Init, "State file path set to: " + WideToUtf8(g_stateFilePath));
 
             DWORD stateFileAttrs = GetFileAttributesW(g_stateFilePath.c_str());
             bool stateOutputAvailable = (stateFileAttrs != INVALID_FILE_ATTRIBUTES) && !(stateFileAttrs & FILE_ATTRIBUTE_DIRECTORY);
             g_isStateOutputAvailable.store(stateOutputAvailable, std::memory_order_release);
             if (!stateOutputAvailable) {
                 LogCategory(
-                    "init",
+                    LogCat::Init,
                     "WARNING: wpstateout.txt not found. Game-state hotkey restrictions will not apply until State Output is installed.");
             }
         } else {
@@ -2601,7 +2512,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Setting up hooks...");
+        LogCategory(LogCat::Init, "Setting up hooks...");
 
         // Get function addresses
         HMODULE hOpenGL32 = GetModuleHandle(L"opengl32.dll");
@@ -2623,7 +2534,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (IsVersionInRange(g_gameVersion, GameVersion(1, 0, 0), GameVersion(1, 21, 0))) {
             if (HOOK(hOpenGL32, glViewport)) {
                 g_glViewportHookCount.fetch_add(1);
-                LogCategory("init", "Initial glViewport hook created via opengl32.dll");
+                LogCategory(LogCat::Init, "Initial glViewport hook created via opengl32.dll");
             }
         }
         HOOK(hUser32, SetCursorPos);
@@ -2633,7 +2544,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (hGlfw) {
             HOOK(hGlfw, glfwSetInputMode);
         } else {
-            LogCategory("init", "WARNING: glfw.dll not loaded; skipping glfwSetInputMode hook");
+            LogCategory(LogCat::Init, "WARNING: glfw.dll not loaded; skipping glfwSetInputMode hook");
         }
 #undef HOOK
 
@@ -2642,7 +2553,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (pGlBlitNamedFramebuffer != NULL) {
             CreateHookOrDie(pGlBlitNamedFramebuffer, &hkglBlitNamedFramebuffer, &oglBlitNamedFramebuffer, "glBlitNamedFramebuffer");
         } else {
-            LogCategory("init",
+            LogCategory(LogCat::Init,
                         "WARNING: glBlitNamedFramebuffer not found in opengl32.dll - will attempt to hook via GLEW after context init");
         }
 
@@ -2651,7 +2562,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Hooks enabled.");
+        LogCategory(LogCat::Init, "Hooks enabled.");
 
         // Background hook compatibility monitor:
         // Some overlays install their detours AFTER our hooks, and sometimes even bypass our SwapBuffers hook.
@@ -2724,6 +2635,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         // Stop background threads
         StopWindowCaptureThread();
+        ShutdownNV12ConversionWorkers(); // Virtual camera band workers, if the camera is still running
+        Profiler::GetInstance().Shutdown(); // Waits for a trace dump / histogram export still being written
 
         // Cleanup shared OpenGL contexts
         CleanupSharedContexts();
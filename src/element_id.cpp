@@ -0,0 +1,63 @@
+// ============================================================================
+// ELEMENT_ID.CPP - Interned mirror, group, image and window overlay names
+// ============================================================================
+
+#include "element_id.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// Same never-moved chunk layout as the mode ID table (mode_id.cpp): readers index entries without a lock
+constexpr uint32_t ELEMENT_ID_CHUNK_SHIFT = 8;
+constexpr uint32_t ELEMENT_ID_CHUNK_SIZE = 1u << ELEMENT_ID_CHUNK_SHIFT;
+constexpr uint32_t ELEMENT_ID_MAX_CHUNKS = 256; // 65536 distinct names
+
+std::atomic<std::string*> g_elementNameChunks[ELEMENT_ID_MAX_CHUNKS];
+std::atomic<uint32_t> g_elementNameCount{ 0 }; // Published entries (release after the entry is written)
+
+std::mutex g_elementNameInternMutex;
+std::unordered_map<std::string, ElementHandle> g_elementHandleByName; // Guarded by g_elementNameInternMutex
+
+const std::string& EmptyElementName() {
+    static const std::string empty;
+    return empty;
+}
+
+// Requires g_elementNameInternMutex
+ElementHandle AppendEntry(const std::string& name) {
+    const uint32_t handle = g_elementNameCount.load(std::memory_order_relaxed);
+    const uint32_t chunkIndex = handle >> ELEMENT_ID_CHUNK_SHIFT;
+    if (chunkIndex >= ELEMENT_ID_MAX_CHUNKS) return NO_ELEMENT_HANDLE; // Table exhausted: resolves to no element
+
+    std::string* chunk = g_elementNameChunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string[ELEMENT_ID_CHUNK_SIZE]; // Intentionally never freed (readers may hold references)
+        g_elementNameChunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    chunk[handle & (ELEMENT_ID_CHUNK_SIZE - 1)] = name;
+    g_elementHandleByName.emplace(name, handle);
+
+    g_elementNameCount.store(handle + 1, std::memory_order_release);
+    return handle;
+}
+
+} // namespace
+
+ElementHandle InternElementName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(g_elementNameInternMutex);
+    if (g_elementNameCount.load(std::memory_order_relaxed) == 0) { AppendEntry(std::string()); } // Handle 0 is the empty name
+
+    auto it = g_elementHandleByName.find(name);
+    if (it != g_elementHandleByName.end()) return it->second;
+    return AppendEntry(name);
+}
+
+const std::string& ElementName(ElementHandle handle) {
+    if (handle >= g_elementNameCount.load(std::memory_order_acquire)) return EmptyElementName();
+    const std::string* chunk = g_elementNameChunks[handle >> ELEMENT_ID_CHUNK_SHIFT].load(std::memory_order_acquire);
+    return chunk ? chunk[handle & (ELEMENT_ID_CHUNK_SIZE - 1)] : EmptyElementName();
+}
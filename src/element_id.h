@@ -0,0 +1,34 @@
+#pragma once
+
+// ============================================================================
+// ELEMENT_ID.H - Interned mirror, group, image and window overlay names
+// ============================================================================
+// Modes reference their mirrors, mirror groups, images and window overlays
+// by name, and group items reference their mirrors the same way. Published
+// config snapshots also carry an ElementHandle for every such name (on the
+// element itself and alongside each reference), so the per-frame element
+// gathering resolves references with an array read instead of hashing
+// strings (see GetMirrorFromSnapshot(config, handle) and friends).
+//
+// Works like ModeHandle (mode_id.h): process-wide, assigned the first time a
+// name is interned, never recycled. Unlike mode IDs, element names match
+// case-sensitively, so there is no folded handle. One handle space serves
+// every section; each section has its own handle -> index table.
+//
+// Interning takes a mutex and may allocate; it happens at config publish.
+// Name reads are lock-free.
+// ============================================================================
+
+#include <cstdint>
+#include <string>
+
+using ElementHandle = uint32_t;
+
+// Handle of the empty name (no element)
+constexpr ElementHandle NO_ELEMENT_HANDLE = 0;
+
+// Returns the handle for a name, interning it on first use.
+ElementHandle InternElementName(const std::string& name);
+
+// Name the handle was interned with. The reference stays valid for the process lifetime.
+const std::string& ElementName(ElementHandle handle);
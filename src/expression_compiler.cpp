@@ -0,0 +1,505 @@
+// ============================================================================
+// EXPRESSION_COMPILER.CPP - Expression tokenizer, compiler and evaluator
+// ============================================================================
+// Implements a recursive descent compiler from math expressions to a small
+// stack bytecode. Security: Only whitelisted identifiers (screen size, mode
+// sizes) allowed. No eval(), no string execution, no arbitrary code paths.
+// ============================================================================
+
+#include "expression_compiler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// Bounds keep hostile input (e.g. a pasted "((((((...") from exhausting the C++ stack while compiling, and let the
+// evaluator use a fixed-size operand stack.
+static constexpr int kMaxExprNesting = 64;
+static constexpr int kMaxExprStack = 64;
+
+// ============================================================================
+// Tokenizer
+// ============================================================================
+
+// Using Expr prefix to avoid Windows header macro conflicts
+enum class ExprTokenKind {
+    Number,
+    Identifier,
+    Plus,
+    Minus,
+    Star,
+    Slash,
+    LParen,
+    RParen,
+    Comma,
+    End,
+    Invalid
+};
+
+struct ExprToken {
+    ExprTokenKind kind;
+    std::string text;
+    double numValue;
+
+    ExprToken() : kind(ExprTokenKind::End), text(""), numValue(0) {}
+    ExprToken(ExprTokenKind k, const std::string& s, double n) : kind(k), text(s), numValue(n) {}
+};
+
+static bool IsIdentStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+static bool IsIdentChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+static bool IsDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
+
+class Tokenizer {
+public:
+    Tokenizer(const std::string& input) : m_input(input), m_pos(0) {}
+
+    ExprToken next() {
+        skipWhitespace();
+        if (m_pos >= m_input.size()) { return ExprToken(ExprTokenKind::End, "", 0); }
+
+        char c = m_input[m_pos];
+
+        // Single character tokens
+        if (c == '+') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::Plus, "+", 0);
+        }
+        if (c == '-') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::Minus, "-", 0);
+        }
+        if (c == '*') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::Star, "*", 0);
+        }
+        if (c == '/') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::Slash, "/", 0);
+        }
+        if (c == '(') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::LParen, "(", 0);
+        }
+        if (c == ')') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::RParen, ")", 0);
+        }
+        if (c == ',') {
+            m_pos++;
+            return ExprToken(ExprTokenKind::Comma, ",", 0);
+        }
+
+        // Numbers (including decimals)
+        if (IsDigit(c) || c == '.') {
+            size_t start = m_pos;
+            bool hasDecimal = false;
+            bool hasDigit = false;
+            while (m_pos < m_input.size() && (IsDigit(m_input[m_pos]) || m_input[m_pos] == '.')) {
+                if (m_input[m_pos] == '.') {
+                    if (hasDecimal) break;
+                    hasDecimal = true;
+                } else {
+                    hasDigit = true;
+                }
+                m_pos++;
+            }
+            std::string numStr = m_input.substr(start, m_pos - start);
+            if (!hasDigit) { return ExprToken(ExprTokenKind::Invalid, numStr, 0); }
+            double num = std::strtod(numStr.c_str(), nullptr);
+            return ExprToken(ExprTokenKind::Number, numStr, num);
+        }
+
+        // Identifiers (variable names and function names), optionally qualified by a mode: "EyeZoom.width"
+        if (IsIdentStart(c)) {
+            size_t start = m_pos;
+            while (m_pos < m_input.size() && IsIdentChar(m_input[m_pos])) { m_pos++; }
+            if (m_pos + 1 < m_input.size() && m_input[m_pos] == '.' && IsIdentStart(m_input[m_pos + 1])) {
+                m_pos++;
+                while (m_pos < m_input.size() && IsIdentChar(m_input[m_pos])) { m_pos++; }
+            }
+            std::string id = m_input.substr(start, m_pos - start);
+            return ExprToken(ExprTokenKind::Identifier, id, 0);
+        }
+
+        // Invalid character
+        m_pos++;
+        return ExprToken(ExprTokenKind::Invalid, std::string(1, c), 0);
+    }
+
+    size_t position() const { return m_pos; }
+
+private:
+    void skipWhitespace() {
+        while (m_pos < m_input.size() && std::isspace(static_cast<unsigned char>(m_input[m_pos]))) { m_pos++; }
+    }
+
+    std::string m_input;
+    size_t m_pos;
+};
+
+// ============================================================================
+// Bytecode
+// ============================================================================
+
+using ExprOp = CompiledExpression::Op;
+
+static bool IsBinaryOp(ExprOp op) {
+    return op == ExprOp::Add || op == ExprOp::Sub || op == ExprOp::Mul || op == ExprOp::Div || op == ExprOp::Min ||
+           op == ExprOp::Max;
+}
+
+// Applies an operator (b is ignored for unary ones). Shared by constant folding and the evaluator so both agree.
+// Returns false on division by zero.
+static bool ApplyOp(ExprOp op, double a, double b, double& out) {
+    switch (op) {
+    case ExprOp::Add:
+        out = a + b;
+        return true;
+    case ExprOp::Sub:
+        out = a - b;
+        return true;
+    case ExprOp::Mul:
+        out = a * b;
+        return true;
+    case ExprOp::Div:
+        if (b == 0) return false;
+        out = a / b;
+        return true;
+    case ExprOp::Min:
+        out = (std::min)(a, b);
+        return true;
+    case ExprOp::Max:
+        out = (std::max)(a, b);
+        return true;
+    case ExprOp::Neg:
+        out = -a;
+        return true;
+    case ExprOp::Floor:
+        out = std::floor(a);
+        return true;
+    case ExprOp::Ceil:
+        out = std::ceil(a);
+        return true;
+    case ExprOp::Round:
+        out = std::round(a);
+        return true;
+    case ExprOp::Abs:
+        out = std::abs(a);
+        return true;
+    case ExprOp::RoundEven:
+        // Round up to nearest even number: ceil(x/2) * 2
+        out = std::ceil(a / 2.0) * 2.0;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool CompiledExpression::Evaluate(const double* values, double& out) const {
+    double stack[kMaxExprStack];
+    size_t sp = 0;
+    for (const Instruction& ins : m_code) {
+        switch (ins.op) {
+        case Op::Const:
+            stack[sp++] = ins.value;
+            break;
+        case Op::Var:
+            stack[sp++] = values[ins.slot];
+            break;
+        default:
+            if (IsBinaryOp(ins.op)) {
+                const double b = stack[--sp];
+                if (!ApplyOp(ins.op, stack[sp - 1], b, stack[sp - 1])) return false;
+            } else if (!ApplyOp(ins.op, stack[sp - 1], 0.0, stack[sp - 1])) {
+                return false;
+            }
+            break;
+        }
+    }
+    out = stack[0];
+    return std::isfinite(out);
+}
+
+// ============================================================================
+// Compiler
+// ============================================================================
+
+class ExpressionCompiler {
+public:
+    ExpressionCompiler(const std::string& expr, CompiledExpression& out) : m_tokenizer(expr), m_out(out) {
+        m_currentToken = m_tokenizer.next();
+    }
+
+    // Throws std::runtime_error with a human-readable message on a syntax error
+    void compile() {
+        parseExpression();
+        if (m_currentToken.kind != ExprTokenKind::End) { throw std::runtime_error("Unexpected token at end: " + m_currentToken.text); }
+
+        int depth = 0;
+        for (const auto& ins : m_out.m_code) {
+            if (ins.op == ExprOp::Const || ins.op == ExprOp::Var) {
+                if (++depth > kMaxExprStack) { throw std::runtime_error("Expression is too complex"); }
+            } else if (IsBinaryOp(ins.op)) {
+                --depth;
+            }
+        }
+    }
+
+private:
+    // Expression = Term (('+' | '-') Term)*
+    void parseExpression() {
+        parseTerm();
+        while (m_currentToken.kind == ExprTokenKind::Plus || m_currentToken.kind == ExprTokenKind::Minus) {
+            ExprTokenKind op = m_currentToken.kind;
+            advance();
+            parseTerm();
+            emitOp(op == ExprTokenKind::Plus ? ExprOp::Add : ExprOp::Sub);
+        }
+    }
+
+    // Term = Unary (('*' | '/') Unary)*
+    void parseTerm() {
+        parseUnary();
+        while (m_currentToken.kind == ExprTokenKind::Star || m_currentToken.kind == ExprTokenKind::Slash) {
+            ExprTokenKind op = m_currentToken.kind;
+            advance();
+            parseUnary();
+            emitOp(op == ExprTokenKind::Star ? ExprOp::Mul : ExprOp::Div);
+        }
+    }
+
+    // Unary = ('-' | '+')? Unary | Primary
+    void parseUnary() {
+        // Every level of nesting (parentheses, function arguments, sign chains) passes through here
+        if (++m_nesting > kMaxExprNesting) { throw std::runtime_error("Expression is nested too deeply"); }
+
+        if (m_currentToken.kind == ExprTokenKind::Minus) {
+            advance();
+            parseUnary();
+            emitOp(ExprOp::Neg);
+        } else if (m_currentToken.kind == ExprTokenKind::Plus) {
+            advance();
+            parseUnary();
+        } else {
+            parsePrimary();
+        }
+        --m_nesting;
+    }
+
+    // Primary = Number | Identifier | FunctionCall | '(' Expression ')'
+    void parsePrimary() {
+        if (m_currentToken.kind == ExprTokenKind::Number) {
+            emitConst(m_currentToken.numValue);
+            advance();
+            return;
+        }
+
+        if (m_currentToken.kind == ExprTokenKind::Identifier) {
+            std::string id = m_currentToken.text;
+            advance();
+
+            // Check for function call
+            if (m_currentToken.kind == ExprTokenKind::LParen) {
+                parseFunctionCall(id);
+                return;
+            }
+
+            // Variable reference
+            emitVariable(id);
+            return;
+        }
+
+        if (m_currentToken.kind == ExprTokenKind::LParen) {
+            advance();
+            parseExpression();
+            expect(ExprTokenKind::RParen, "Expected ')'");
+            return;
+        }
+
+        throw std::runtime_error("Unexpected token: " + m_currentToken.text);
+    }
+
+    void parseFunctionCall(const std::string& funcName) {
+        // Whitelist of allowed functions
+        struct Function {
+            const char* name;
+            ExprOp op;
+            size_t arity;
+        };
+        static const Function kFunctions[] = { { "min", ExprOp::Min, 2 },     { "max", ExprOp::Max, 2 },   { "floor", ExprOp::Floor, 1 },
+                                                { "ceil", ExprOp::Ceil, 1 },   { "round", ExprOp::Round, 1 }, { "abs", ExprOp::Abs, 1 },
+                                                { "roundEven", ExprOp::RoundEven, 1 } };
+        const Function* function = nullptr;
+        for (const auto& f : kFunctions) {
+            if (funcName == f.name) function = &f;
+        }
+        if (!function) { throw std::runtime_error("Unknown function: " + funcName); }
+
+        expect(ExprTokenKind::LParen, "Expected '(' after function name");
+
+        // Parse arguments
+        size_t args = 0;
+        if (m_currentToken.kind != ExprTokenKind::RParen) {
+            parseExpression();
+            args++;
+            while (m_currentToken.kind == ExprTokenKind::Comma) {
+                advance();
+                parseExpression();
+                args++;
+            }
+        }
+        expect(ExprTokenKind::RParen, "Expected ')' after function arguments");
+
+        if (args != function->arity) {
+            throw std::runtime_error(funcName + "() requires " + std::to_string(function->arity) +
+                                     (function->arity == 1 ? " argument" : " arguments"));
+        }
+        emitOp(function->op);
+    }
+
+    void emitConst(double value) { m_out.m_code.push_back({ ExprOp::Const, 0, value }); }
+
+    void emitVariable(const std::string& name) {
+        // Whitelist of allowed variables
+        const size_t dot = name.find('.');
+        if (dot == std::string::npos) {
+            if (name != "screenWidth" && name != "screenHeight") { throw std::runtime_error("Unknown variable: " + name); }
+        } else {
+            const std::string field = name.substr(dot + 1);
+            if (field != "width" && field != "height") { throw std::runtime_error("Unknown variable: " + name + " (use .width or .height)"); }
+        }
+
+        auto& vars = m_out.m_variables;
+        auto it = std::find(vars.begin(), vars.end(), name);
+        if (it == vars.end()) it = vars.insert(vars.end(), name);
+        m_out.m_code.push_back({ ExprOp::Var, static_cast<uint32_t>(it - vars.begin()), 0.0 });
+    }
+
+    // Emits an operator over the operand(s) just emitted, folding it when they are all constants. A complete
+    // subexpression ending in a Const instruction is that constant alone, so checking the tail of the code suffices.
+    void emitOp(ExprOp op) {
+        auto& code = m_out.m_code;
+        const size_t arity = IsBinaryOp(op) ? 2 : 1;
+        bool constant = code.size() >= arity;
+        for (size_t i = code.size() - (std::min)(arity, code.size()); i < code.size(); ++i) {
+            if (code[i].op != ExprOp::Const) constant = false;
+        }
+
+        if (!constant) {
+            code.push_back({ op, 0, 0.0 });
+            return;
+        }
+
+        const double a = code[code.size() - arity].value;
+        const double b = arity == 2 ? code.back().value : 0.0;
+        double folded = 0.0;
+        if (!ApplyOp(op, a, b, folded)) { throw std::runtime_error("Division by zero"); }
+        code.resize(code.size() - arity);
+        emitConst(folded);
+    }
+
+    void advance() { m_currentToken = m_tokenizer.next(); }
+
+    void expect(ExprTokenKind k, const std::string& error) {
+        if (m_currentToken.kind != k) { throw std::runtime_error(error); }
+        advance();
+    }
+
+    Tokenizer m_tokenizer;
+    ExprToken m_currentToken;
+    CompiledExpression& m_out;
+    int m_nesting = 0;
+};
+
+// ============================================================================
+// Public API
+// ============================================================================
+// Compiled programs are cached by trimmed expression text. Errors are cached
+// too: the GUI validates every visible expression each frame, valid or not.
+// Typing in an expression field adds one entry per keystroke, so the cache is
+// simply dropped when it grows past a bound - configs only hold a few dozen
+// expressions.
+
+struct CompileCacheEntry {
+    std::shared_ptr<const CompiledExpression> program;
+    std::string error;
+};
+
+static constexpr size_t kMaxCompileCacheEntries = 512;
+static std::mutex s_compileCacheMutex;
+static std::unordered_map<std::string, CompileCacheEntry> s_compileCache;
+
+static std::string TrimExpression(const std::string& expr) {
+    size_t start = expr.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) { return std::string(); }
+    size_t end = expr.find_last_not_of(" \t\r\n");
+    return expr.substr(start, end - start + 1);
+}
+
+bool CompileExpressionText(const std::string& expr, CompiledExpression& out, std::string& errorOut) {
+    out = CompiledExpression();
+    try {
+        ExpressionCompiler(expr, out).compile();
+    } catch (const std::exception& e) {
+        errorOut = e.what();
+        out = CompiledExpression();
+        return false;
+    }
+    errorOut.clear();
+    return true;
+}
+
+std::shared_ptr<const CompiledExpression> CompileExpression(const std::string& expr, std::string& errorOut) {
+    std::string trimmed = TrimExpression(expr);
+    if (trimmed.empty()) {
+        errorOut = "Expression cannot be empty";
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_compileCacheMutex);
+        auto it = s_compileCache.find(trimmed);
+        if (it != s_compileCache.end()) {
+            errorOut = it->second.error;
+            return it->second.program;
+        }
+    }
+
+    CompileCacheEntry entry;
+    auto program = std::make_shared<CompiledExpression>();
+    if (CompileExpressionText(trimmed, *program, entry.error)) { entry.program = std::move(program); }
+
+    errorOut = entry.error;
+    std::shared_ptr<const CompiledExpression> compiled = entry.program;
+
+    std::lock_guard<std::mutex> lock(s_compileCacheMutex);
+    if (s_compileCache.size() >= kMaxCompileCacheEntries) { s_compileCache.clear(); }
+    s_compileCache.emplace(std::move(trimmed), std::move(entry));
+    return compiled;
+}
+
+bool IsExpression(const std::string& str) {
+    if (str.empty()) { return false; }
+
+    std::string trimmed = TrimExpression(str);
+    if (trimmed.empty()) { return false; }
+
+    // Check if it's a pure integer (possibly with leading minus)
+    size_t checkStart = 0;
+    if (!trimmed.empty() && trimmed[0] == '-') { checkStart = 1; }
+
+    if (checkStart >= trimmed.size()) { return true; } // Just a minus sign = expression
+
+    for (size_t i = checkStart; i < trimmed.size(); i++) {
+        if (!IsDigit(trimmed[i])) { return true; } // Has non-digit = expression
+    }
+    return false; // Pure integer = not an expression
+}
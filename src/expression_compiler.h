@@ -0,0 +1,59 @@
+#pragma once
+
+// ============================================================================
+// EXPRESSION_COMPILER.H - Expression compilation to stack bytecode
+// ============================================================================
+// Compiles simple math expressions with screen/mode dimension variables.
+// Designed for security: whitelist-only identifiers, no arbitrary code execution.
+//
+// Expressions are compiled once (per distinct text) into a constant-folded
+// stack bytecode and re-evaluated against a variable table, so neither a
+// screen resize nor a GUI redraw re-tokenizes anything. Binding variables to
+// the live config lives in expression_parser.h.
+// ============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Compiled form of an expression. Constant subexpressions are folded at compile time, so "1920 / 2" is a single
+// constant; variables are referenced by slot, see Variables().
+class CompiledExpression {
+public:
+    enum class Op : uint8_t { Const, Var, Add, Sub, Mul, Div, Neg, Min, Max, Floor, Ceil, Round, Abs, RoundEven };
+
+    struct Instruction {
+        Op op;
+        uint32_t slot; // Op::Var
+        double value;  // Op::Const
+    };
+
+    bool IsConstant() const { return m_code.size() == 1 && m_code[0].op == Op::Const; }
+
+    // Distinct variable names in slot order: "screenWidth", "screenHeight", or "<modeId>.width" / "<modeId>.height"
+    const std::vector<std::string>& Variables() const { return m_variables; }
+
+    // Evaluates with values[i] bound to Variables()[i].
+    // Returns false on a runtime error (division by zero, non-finite result).
+    bool Evaluate(const double* values, double& out) const;
+
+private:
+    friend class ExpressionCompiler;
+
+    std::vector<Instruction> m_code;
+    std::vector<std::string> m_variables;
+};
+
+// Compile an expression (cached by text, safe from any thread).
+// Returns nullptr on a syntax error, with a human-readable message in errorOut.
+std::shared_ptr<const CompiledExpression> CompileExpression(const std::string& expr, std::string& errorOut);
+
+// Compile expr into out without the cache (exact text, no trimming). Used by CompileExpression, the fuzz target and
+// the benchmark. Returns false on a syntax error, leaving out empty and a message in errorOut.
+bool CompileExpressionText(const std::string& expr, CompiledExpression& out, std::string& errorOut);
+
+// Check if a string should be treated as an expression (vs a pure integer)
+// Returns true if the string contains non-numeric characters (letters, operators, etc.)
+bool IsExpression(const std::string& str);
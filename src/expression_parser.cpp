@@ -1,432 +1,401 @@
 // ============================================================================
-// EXPRESSION_PARSER.CPP - Safe Expression Evaluation Implementation
+// EXPRESSION_PARSER.CPP - Expression evaluation against the live config
 // ============================================================================
-// Implements a simple recursive descent parser for math expressions.
-// Security: Only whitelisted identifiers (screenWidth, screenHeight) allowed.
-// No eval(), no string execution, no arbitrary code paths.
+// Binds compiled expressions (expression_compiler.cpp) to screen and mode
+// sizes, and maintains the mode dimension graph that re-evaluates them.
 // ============================================================================
 
 #include "expression_parser.h"
 #include "gui.h"
 #include "logic_thread.h"
+#include "profiler.h"
+#include "utils.h"
 #include <algorithm>
-#include <cctype>
+#include <climits>
 #include <cmath>
-#include <stdexcept>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // ============================================================================
-// Tokenizer
+// Public API
 // ============================================================================
 
-// Using Expr prefix to avoid Windows header macro conflicts
-enum class ExprTokenKind {
-    Number,
-    Identifier,
-    Plus,
-    Minus,
-    Star,
-    Slash,
-    LParen,
-    RParen,
-    Comma,
-    End,
-    Invalid
-};
-
-struct ExprToken {
-    ExprTokenKind kind;
-    std::string text;
-    double numValue;
-
-    ExprToken() : kind(ExprTokenKind::End), text(""), numValue(0) {}
-    ExprToken(ExprTokenKind k, const std::string& s, double n) : kind(k), text(s), numValue(n) {}
-};
-
-class Tokenizer {
-public:
-    Tokenizer(const std::string& input) : m_input(input), m_pos(0) {}
-
-    ExprToken next() {
-        skipWhitespace();
-        if (m_pos >= m_input.size()) { return ExprToken(ExprTokenKind::End, "", 0); }
-
-        char c = m_input[m_pos];
-
-        // Single character tokens
-        if (c == '+') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::Plus, "+", 0);
-        }
-        if (c == '-') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::Minus, "-", 0);
-        }
-        if (c == '*') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::Star, "*", 0);
-        }
-        if (c == '/') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::Slash, "/", 0);
-        }
-        if (c == '(') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::LParen, "(", 0);
-        }
-        if (c == ')') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::RParen, ")", 0);
-        }
-        if (c == ',') {
-            m_pos++;
-            return ExprToken(ExprTokenKind::Comma, ",", 0);
-        }
+// Floors an evaluation result to a pixel value; false if it does not fit an int
+static bool ToDimension(double value, int& out) {
+    if (!std::isfinite(value)) return false;
+    const double floored = std::floor(value);
+    if (floored < static_cast<double>(INT_MIN) || floored > static_cast<double>(INT_MAX)) return false;
+    out = static_cast<int>(floored);
+    return true;
+}
 
-        // Numbers (including decimals)
-        if (std::isdigit(c) || c == '.') {
-            size_t start = m_pos;
-            bool hasDecimal = false;
-            while (m_pos < m_input.size() && (std::isdigit(m_input[m_pos]) || m_input[m_pos] == '.')) {
-                if (m_input[m_pos] == '.') {
-                    if (hasDecimal) break;
-                    hasDecimal = true;
-                }
-                m_pos++;
-            }
-            std::string numStr = m_input.substr(start, m_pos - start);
-            double num = std::stod(numStr);
-            return ExprToken(ExprTokenKind::Number, numStr, num);
-        }
+// Splits "<modeId>.width" / "<modeId>.height"; false for the screen variables
+static bool SplitModeReference(const std::string& variable, std::string& modeId, bool& isHeight) {
+    const size_t dot = variable.find('.');
+    if (dot == std::string::npos) return false;
+    modeId = variable.substr(0, dot);
+    isHeight = variable.compare(dot + 1, std::string::npos, "height") == 0;
+    return true;
+}
 
-        // Identifiers (variable names and function names)
-        if (std::isalpha(c) || c == '_') {
-            size_t start = m_pos;
-            while (m_pos < m_input.size() && (std::isalnum(m_input[m_pos]) || m_input[m_pos] == '_')) { m_pos++; }
-            std::string id = m_input.substr(start, m_pos - start);
-            return ExprToken(ExprTokenKind::Identifier, id, 0);
+int EvaluateExpression(const std::string& expr, int screenWidth, int screenHeight, int defaultValue) {
+    std::string error;
+    auto program = CompileExpression(expr, error);
+    if (!program) { return defaultValue; }
+
+    std::vector<double> values;
+    values.reserve(program->Variables().size());
+    for (const auto& variable : program->Variables()) {
+        std::string modeId;
+        bool isHeight = false;
+        if (!SplitModeReference(variable, modeId, isHeight)) {
+            values.push_back(variable == "screenWidth" ? screenWidth : screenHeight);
+            continue;
         }
-
-        // Invalid character
-        m_pos++;
-        return ExprToken(ExprTokenKind::Invalid, std::string(1, c), 0);
+        const ModeConfig* mode = GetMode(modeId);
+        if (!mode) { return defaultValue; }
+        values.push_back(isHeight ? mode->height : mode->width);
     }
 
-    size_t position() const { return m_pos; }
+    double result = 0.0;
+    int value = 0;
+    if (!program->Evaluate(values.data(), result) || !ToDimension(result, value)) { return defaultValue; }
+    return value;
+}
 
-private:
-    void skipWhitespace() {
-        while (m_pos < m_input.size() && std::isspace(m_input[m_pos])) { m_pos++; }
-    }
 
-    std::string m_input;
-    size_t m_pos;
-};
+bool ValidateExpression(const std::string& expr, std::string& errorOut) {
+    auto program = CompileExpression(expr, errorOut);
+    if (!program) { return false; }
+
+    // Syntax is fine; mode references must also name an existing mode
+    for (const auto& variable : program->Variables()) {
+        std::string modeId;
+        bool isHeight = false;
+        if (SplitModeReference(variable, modeId, isHeight) && !GetMode(modeId)) {
+            errorOut = "Unknown mode: " + modeId;
+            return false;
+        }
+    }
+    errorOut.clear();
+    return true;
+}
 
 // ============================================================================
-// Parser
+// Mode Dimension Graph
 // ============================================================================
+// One node per mode width/height (expression-driven or plain) and per stretch
+// expression. Edges run from a referenced mode size or screen dimension to the
+// expressions that read it. The graph is rebuilt only when a mode id or an
+// expression text changes; otherwise a recalculation re-evaluates just the
+// nodes downstream of a changed screen size or plain mode size.
+
+enum class DimensionField : uint8_t { Width, Height, StretchWidth, StretchHeight, StretchX, StretchY };
+static constexpr DimensionField kDimensionFields[] = { DimensionField::Width,        DimensionField::Height,
+                                                       DimensionField::StretchWidth, DimensionField::StretchHeight,
+                                                       DimensionField::StretchX,     DimensionField::StretchY };
+
+// Special inputs (node indices are >= 0)
+static constexpr int kScreenWidthInput = -1;
+static constexpr int kScreenHeightInput = -2;
+static constexpr int kMissingInput = -3; // Reference to a mode that does not exist: the expression keeps its value
+
+struct DimensionNode {
+    size_t modeIndex = 0;
+    DimensionField field = DimensionField::Width;
+    std::shared_ptr<const CompiledExpression> program; // nullptr: plain value, read back from the config
+    std::vector<int> inputs;                           // Per program variable slot
+    int value = 0;
+    bool changed = false; // Value changed during the current pass
+};
 
-class ExpressionParser {
-public:
-    ExpressionParser(const std::string& expr, int screenWidth, int screenHeight)
-        : m_tokenizer(expr), m_screenWidth(screenWidth), m_screenHeight(screenHeight) {
-        m_currentToken = m_tokenizer.next();
-    }
-
-    double parse() {
-        double result = parseExpression();
-        if (m_currentToken.kind != ExprTokenKind::End) { throw std::runtime_error("Unexpected token at end: " + m_currentToken.text); }
-        return result;
+static int ReadDimension(const ModeConfig& mode, DimensionField field) {
+    switch (field) {
+    case DimensionField::Width:
+        return mode.width;
+    case DimensionField::Height:
+        return mode.height;
+    case DimensionField::StretchWidth:
+        return mode.stretch.width;
+    case DimensionField::StretchHeight:
+        return mode.stretch.height;
+    case DimensionField::StretchX:
+        return mode.stretch.x;
+    default:
+        return mode.stretch.y;
     }
+}
 
-    std::string validate() {
-        try {
-            parseExpression();
-            if (m_currentToken.kind != ExprTokenKind::End) { return "Unexpected token at end: " + m_currentToken.text; }
-            return ""; // Valid
-        } catch (const std::exception& e) { return e.what(); }
+static void WriteDimension(ModeConfig& mode, DimensionField field, int value) {
+    switch (field) {
+    case DimensionField::Width:
+        mode.width = value;
+        break;
+    case DimensionField::Height:
+        mode.height = value;
+        break;
+    case DimensionField::StretchWidth:
+        mode.stretch.width = value;
+        break;
+    case DimensionField::StretchHeight:
+        mode.stretch.height = value;
+        break;
+    case DimensionField::StretchX:
+        mode.stretch.x = value;
+        break;
+    default:
+        mode.stretch.y = value;
+        break;
     }
+}
 
-private:
-    // Expression = Term (('+' | '-') Term)*
-    double parseExpression() {
-        double left = parseTerm();
-        while (m_currentToken.kind == ExprTokenKind::Plus || m_currentToken.kind == ExprTokenKind::Minus) {
-            ExprTokenKind op = m_currentToken.kind;
-            advance();
-            double right = parseTerm();
-            if (op == ExprTokenKind::Plus) {
-                left = left + right;
-            } else {
-                left = left - right;
-            }
-        }
-        return left;
+static const std::string& DimensionExpr(const ModeConfig& mode, DimensionField field) {
+    switch (field) {
+    case DimensionField::Width:
+        return mode.widthExpr;
+    case DimensionField::Height:
+        return mode.heightExpr;
+    case DimensionField::StretchWidth:
+        return mode.stretch.widthExpr;
+    case DimensionField::StretchHeight:
+        return mode.stretch.heightExpr;
+    case DimensionField::StretchX:
+        return mode.stretch.xExpr;
+    default:
+        return mode.stretch.yExpr;
     }
+}
 
-    // Term = Unary (('*' | '/') Unary)*
-    double parseTerm() {
-        double left = parseUnary();
-        while (m_currentToken.kind == ExprTokenKind::Star || m_currentToken.kind == ExprTokenKind::Slash) {
-            ExprTokenKind op = m_currentToken.kind;
-            advance();
-            double right = parseUnary();
-            if (op == ExprTokenKind::Star) {
-                left = left * right;
-            } else {
-                if (right == 0) { throw std::runtime_error("Division by zero"); }
-                left = left / right;
-            }
-        }
-        return left;
+static const char* DimensionName(DimensionField field) {
+    switch (field) {
+    case DimensionField::Width:
+        return "width";
+    case DimensionField::Height:
+        return "height";
+    case DimensionField::StretchWidth:
+        return "stretch width";
+    case DimensionField::StretchHeight:
+        return "stretch height";
+    case DimensionField::StretchX:
+        return "stretch x";
+    default:
+        return "stretch y";
     }
+}
 
-    // Unary = ('-')? Primary
-    double parseUnary() {
-        if (m_currentToken.kind == ExprTokenKind::Minus) {
-            advance();
-            return -parseUnary();
-        }
-        if (m_currentToken.kind == ExprTokenKind::Plus) {
-            advance();
-            return parseUnary();
-        }
-        return parsePrimary();
+// Mode sizes must be positive and stretch sizes non-negative; positions may be anything
+static bool AcceptsDimension(DimensionField field, int value) {
+    switch (field) {
+    case DimensionField::Width:
+    case DimensionField::Height:
+        return value > 0;
+    case DimensionField::StretchWidth:
+    case DimensionField::StretchHeight:
+        return value >= 0;
+    default:
+        return true;
     }
+}
 
-    // Primary = Number | Identifier | FunctionCall | '(' Expression ')'
-    double parsePrimary() {
-        if (m_currentToken.kind == ExprTokenKind::Number) {
-            double val = m_currentToken.numValue;
-            advance();
-            return val;
+class ModeDimensionGraph {
+public:
+    void Recalculate(int screenWidth, int screenHeight) {
+        const auto& modes = std::as_const(g_config).modes;
+
+        std::string signature;
+        signature.reserve(m_signature.size());
+        for (const auto& mode : modes) {
+            signature += mode.id;
+            signature.push_back('\0');
+            for (DimensionField field : kDimensionFields) {
+                signature += DimensionExpr(mode, field);
+                signature.push_back('\0');
+            }
         }
 
-        if (m_currentToken.kind == ExprTokenKind::Identifier) {
-            std::string id = m_currentToken.text;
-            advance();
-
-            // Check for function call
-            if (m_currentToken.kind == ExprTokenKind::LParen) { return parseFunctionCall(id); }
-
-            // Variable lookup
-            return lookupVariable(id);
+        const bool rebuilt = !m_built || signature != m_signature;
+        if (rebuilt) {
+            m_signature = std::move(signature);
+            Rebuild(modes);
         }
 
-        if (m_currentToken.kind == ExprTokenKind::LParen) {
-            advance();
-            double val = parseExpression();
-            expect(ExprTokenKind::RParen, "Expected ')'");
-            return val;
-        }
+        const bool screenWidthChanged = rebuilt || screenWidth != m_screenWidth;
+        const bool screenHeightChanged = rebuilt || screenHeight != m_screenHeight;
+        m_screenWidth = screenWidth;
+        m_screenHeight = screenHeight;
 
-        throw std::runtime_error("Unexpected token: " + m_currentToken.text);
-    }
+        for (auto& node : m_nodes) { node.changed = false; }
 
-    double parseFunctionCall(const std::string& funcName) {
-        expect(ExprTokenKind::LParen, "Expected '(' after function name");
+        for (int index : m_order) {
+            DimensionNode& node = m_nodes[index];
+            const int current = ReadDimension(modes[node.modeIndex], node.field);
 
-        // Parse arguments
-        std::vector<double> args;
-        if (m_currentToken.kind != ExprTokenKind::RParen) {
-            args.push_back(parseExpression());
-            while (m_currentToken.kind == ExprTokenKind::Comma) {
-                advance();
-                args.push_back(parseExpression());
+            if (!node.program) {
+                node.changed = (current != node.value);
+                node.value = current;
+                continue;
             }
-        }
-        expect(ExprTokenKind::RParen, "Expected ')' after function arguments");
 
-        return callFunction(funcName, args);
-    }
+            // Re-evaluate when an input changed, or when the stored value was replaced behind the graph's back
+            // (config reload, GUI edit) - the ids and expression texts alone do not capture that
+            bool stale = rebuilt || current != node.value;
+            for (int input : node.inputs) {
+                if (input >= 0) {
+                    stale = stale || m_nodes[input].changed;
+                } else {
+                    stale = stale || (input == kScreenWidthInput && screenWidthChanged) || (input == kScreenHeightInput && screenHeightChanged);
+                }
+            }
+            if (!stale) continue;
+
+            bool resolved = true;
+            m_args.clear();
+            for (int input : node.inputs) {
+                if (input == kScreenWidthInput) {
+                    m_args.push_back(screenWidth);
+                } else if (input == kScreenHeightInput) {
+                    m_args.push_back(screenHeight);
+                } else if (input >= 0) {
+                    m_args.push_back(m_nodes[input].value);
+                } else {
+                    resolved = false;
+                }
+            }
 
-    double lookupVariable(const std::string& name) {
-        // Whitelist of allowed variables
-        if (name == "screenWidth") { return static_cast<double>(m_screenWidth); }
-        if (name == "screenHeight") { return static_cast<double>(m_screenHeight); }
+            // On failure the field keeps its current value, like EvaluateExpression's defaultValue
+            double result = 0.0;
+            int value = current;
+            if (!resolved || !node.program->Evaluate(m_args.data(), result) || !ToDimension(result, value) ||
+                !AcceptsDimension(node.field, value)) {
+                value = current;
+            }
+            if (value != current) { WriteDimension(g_config.modes[node.modeIndex], node.field, value); }
 
-        throw std::runtime_error("Unknown variable: " + name);
+            node.changed = (value != node.value);
+            node.value = value;
+        }
     }
 
-    double callFunction(const std::string& name, const std::vector<double>& args) {
-        // Whitelist of allowed functions
-        if (name == "min") {
-            if (args.size() != 2) { throw std::runtime_error("min() requires 2 arguments"); }
-            return (std::min)(args[0], args[1]);
-        }
-        if (name == "max") {
-            if (args.size() != 2) { throw std::runtime_error("max() requires 2 arguments"); }
-            return (std::max)(args[0], args[1]);
-        }
-        if (name == "floor") {
-            if (args.size() != 1) { throw std::runtime_error("floor() requires 1 argument"); }
-            return std::floor(args[0]);
-        }
-        if (name == "ceil") {
-            if (args.size() != 1) { throw std::runtime_error("ceil() requires 1 argument"); }
-            return std::ceil(args[0]);
+private:
+    void Rebuild(const SharedVector<ModeConfig>& modes) {
+        m_built = true;
+        m_nodes.clear();
+        m_order.clear();
+
+        // Width/height node of each mode, for resolving "<mode>.width" references. Duplicated ids resolve to the
+        // first mode, like every other mode lookup.
+        std::vector<int> sizeNodes(modes.size() * 2, -1);
+        auto findMode = [&](const std::string& id) -> int {
+            for (size_t i = 0; i < modes.size(); ++i) {
+                if (EqualsIgnoreCase(modes[i].id, id)) return static_cast<int>(i);
+            }
+            return -1;
+        };
+
+        // Built-in link: Preemptive always copies EyeZoom's resolution
+        const int eyezoomIndex = findMode("EyeZoom");
+        static const std::string kEyeZoomWidth = "EyeZoom.width";
+        static const std::string kEyeZoomHeight = "EyeZoom.height";
+
+        std::string error;
+        for (size_t i = 0; i < modes.size(); ++i) {
+            const ModeConfig& mode = modes[i];
+            const bool linkedToEyeZoom = eyezoomIndex >= 0 && EqualsIgnoreCase(mode.id, "Preemptive");
+
+            for (DimensionField field : kDimensionFields) {
+                const bool isSize = (field == DimensionField::Width || field == DimensionField::Height);
+                const std::string* text = &DimensionExpr(mode, field);
+                if (linkedToEyeZoom && isSize) { text = (field == DimensionField::Width) ? &kEyeZoomWidth : &kEyeZoomHeight; }
+                if (text->empty() && !isSize) continue; // Stretch fields without an expression are nobody's input
+
+                DimensionNode node;
+                node.modeIndex = i;
+                node.field = field;
+                node.value = ReadDimension(mode, field);
+                if (!text->empty()) { node.program = CompileExpression(*text, error); } // Invalid: treated as plain
+                if (isSize) { sizeNodes[i * 2 + (field == DimensionField::Height ? 1 : 0)] = static_cast<int>(m_nodes.size()); }
+                m_nodes.push_back(std::move(node));
+            }
         }
-        if (name == "round") {
-            if (args.size() != 1) { throw std::runtime_error("round() requires 1 argument"); }
-            return std::round(args[0]);
+
+        // Resolve inputs and order the nodes (Kahn's algorithm)
+        std::vector<std::vector<int>> dependents(m_nodes.size());
+        std::vector<int> pendingInputs(m_nodes.size(), 0);
+        for (size_t n = 0; n < m_nodes.size(); ++n) {
+            DimensionNode& node = m_nodes[n];
+            if (!node.program) continue;
+            for (const auto& variable : node.program->Variables()) {
+                std::string modeId;
+                bool isHeight = false;
+                int input = kMissingInput;
+                if (!SplitModeReference(variable, modeId, isHeight)) {
+                    input = (variable == "screenWidth") ? kScreenWidthInput : kScreenHeightInput;
+                } else {
+                    const int modeIndex = findMode(modeId);
+                    if (modeIndex >= 0) input = sizeNodes[modeIndex * 2 + (isHeight ? 1 : 0)];
+                }
+                node.inputs.push_back(input);
+                if (input >= 0) {
+                    dependents[input].push_back(static_cast<int>(n));
+                    pendingInputs[n]++;
+                }
+            }
         }
-        if (name == "abs") {
-            if (args.size() != 1) { throw std::runtime_error("abs() requires 1 argument"); }
-            return std::abs(args[0]);
+
+        for (size_t n = 0; n < m_nodes.size(); ++n) {
+            if (pendingInputs[n] == 0) m_order.push_back(static_cast<int>(n));
         }
-        if (name == "roundEven") {
-            if (args.size() != 1) { throw std::runtime_error("roundEven() requires 1 argument"); }
-            // Round up to nearest even number: ceil(x/2) * 2
-            return std::ceil(args[0] / 2.0) * 2.0;
+        for (size_t head = 0; head < m_order.size(); ++head) {
+            for (int dependent : dependents[m_order[head]]) {
+                if (--pendingInputs[dependent] == 0) m_order.push_back(dependent);
+            }
         }
 
-        throw std::runtime_error("Unknown function: " + name);
-    }
-
-    void advance() { m_currentToken = m_tokenizer.next(); }
-
-    void expect(ExprTokenKind k, const std::string& error) {
-        if (m_currentToken.kind != k) { throw std::runtime_error(error); }
-        advance();
+        // Whatever is left sits on (or behind) a cycle and keeps its current value
+        for (size_t n = 0; n < m_nodes.size(); ++n) {
+            if (pendingInputs[n] == 0) continue;
+            Log("WARNING: Expression for mode '" + modes[m_nodes[n].modeIndex].id + "' " + DimensionName(m_nodes[n].field) +
+                " is part of a reference cycle and will not be evaluated.");
+        }
     }
 
-    Tokenizer m_tokenizer;
-    ExprToken m_currentToken;
-    int m_screenWidth;
-    int m_screenHeight;
+    std::string m_signature; // Mode ids + expression texts the graph was built from
+    bool m_built = false;
+    std::vector<DimensionNode> m_nodes;
+    std::vector<int> m_order; // Topological evaluation order (excludes nodes on cycles)
+    std::vector<double> m_args;
+    int m_screenWidth = 0;
+    int m_screenHeight = 0;
 };
 
-// ============================================================================
-// Public API
-// ============================================================================
-
-int EvaluateExpression(const std::string& expr, int screenWidth, int screenHeight, int defaultValue) {
-    if (expr.empty()) { return defaultValue; }
-
-    // Trim whitespace
-    std::string trimmed = expr;
-    size_t start = trimmed.find_first_not_of(" \t\r\n");
-    size_t end = trimmed.find_last_not_of(" \t\r\n");
-    if (start == std::string::npos) { return defaultValue; }
-    trimmed = trimmed.substr(start, end - start + 1);
-
-    if (trimmed.empty()) { return defaultValue; }
-
-    try {
-        ExpressionParser parser(trimmed, screenWidth, screenHeight);
-        double result = parser.parse();
-        return static_cast<int>(std::floor(result));
-    } catch (const std::exception&) { return defaultValue; }
-}
-
-bool IsExpression(const std::string& str) {
-    if (str.empty()) { return false; }
-
-    // Trim whitespace
-    std::string trimmed = str;
-    size_t start = trimmed.find_first_not_of(" \t\r\n");
-    size_t end = trimmed.find_last_not_of(" \t\r\n");
-    if (start == std::string::npos) { return false; }
-    trimmed = trimmed.substr(start, end - start + 1);
-
-    // Check if it's a pure integer (possibly with leading minus)
-    size_t checkStart = 0;
-    if (!trimmed.empty() && trimmed[0] == '-') { checkStart = 1; }
-
-    if (checkStart >= trimmed.size()) { return true; } // Just a minus sign = expression
-
-    for (size_t i = checkStart; i < trimmed.size(); i++) {
-        if (!std::isdigit(trimmed[i])) { return true; } // Has non-digit = expression
-    }
-    return false; // Pure integer = not an expression
-}
-
-bool ValidateExpression(const std::string& expr, std::string& errorOut) {
-    if (expr.empty()) {
-        errorOut = "Expression cannot be empty";
-        return false;
-    }
-
-    // Trim whitespace
-    std::string trimmed = expr;
-    size_t start = trimmed.find_first_not_of(" \t\r\n");
-    size_t end = trimmed.find_last_not_of(" \t\r\n");
-    if (start == std::string::npos) {
-        errorOut = "Expression cannot be empty";
-        return false;
-    }
-    trimmed = trimmed.substr(start, end - start + 1);
-
-    try {
-        // Use dummy screen dimensions for validation
-        ExpressionParser parser(trimmed, 1920, 1080);
-        std::string error = parser.validate();
-        if (!error.empty()) {
-            errorOut = error;
-            return false;
-        }
-        errorOut.clear();
-        return true;
-    } catch (const std::exception& e) {
-        errorOut = e.what();
-        return false;
-    }
-}
+static std::mutex s_dimensionGraphMutex;
+static ModeDimensionGraph s_dimensionGraph;
 
 void RecalculateExpressionDimensions() {
+    PROFILE_SCOPE_CAT("Expression Recalc", "Config");
+
     int screenW = GetCachedScreenWidth();
     int screenH = GetCachedScreenHeight();
 
-    // Recalculate mode dimensions from expressions
-    for (auto& mode : g_config.modes) {
-        // Preemptive mode is always resolution-linked to EyeZoom.
-        // It must not be expression-driven.
-        if (mode.id == "Preemptive") {
-            mode.widthExpr.clear();
-            mode.heightExpr.clear();
-        }
-
-        // Width expression
-        if (mode.id != "Preemptive" && !mode.widthExpr.empty()) {
-            int newWidth = EvaluateExpression(mode.widthExpr, screenW, screenH, mode.width);
-            if (newWidth > 0) { mode.width = newWidth; }
-        }
-        // Height expression
-        if (mode.id != "Preemptive" && !mode.heightExpr.empty()) {
-            int newHeight = EvaluateExpression(mode.heightExpr, screenW, screenH, mode.height);
-            if (newHeight > 0) { mode.height = newHeight; }
-        }
-
-        // Stretch expressions
-        if (!mode.stretch.widthExpr.empty()) {
-            int val = EvaluateExpression(mode.stretch.widthExpr, screenW, screenH, mode.stretch.width);
-            if (val >= 0) { mode.stretch.width = val; }
+    // Preemptive mode is always resolution-linked to EyeZoom (a built-in edge of the dimension graph).
+    // It must not be expression- or percentage-driven.
+    for (size_t i = 0; i < g_config.modes.size(); ++i) {
+        const ModeConfig& mode = std::as_const(g_config).modes[i];
+        if (!EqualsIgnoreCase(mode.id, "Preemptive")) continue;
+        if (!mode.widthExpr.empty() || !mode.heightExpr.empty() || mode.useRelativeSize || mode.relativeWidth >= 0.0f ||
+            mode.relativeHeight >= 0.0f) {
+            ModeConfig& preemptiveMode = g_config.modes[i];
+            preemptiveMode.widthExpr.clear();
+            preemptiveMode.heightExpr.clear();
+            preemptiveMode.useRelativeSize = false;
+            preemptiveMode.relativeWidth = -1.0f;
+            preemptiveMode.relativeHeight = -1.0f;
         }
-        if (!mode.stretch.heightExpr.empty()) {
-            int val = EvaluateExpression(mode.stretch.heightExpr, screenW, screenH, mode.stretch.height);
-            if (val >= 0) { mode.stretch.height = val; }
-        }
-        if (!mode.stretch.xExpr.empty()) { mode.stretch.x = EvaluateExpression(mode.stretch.xExpr, screenW, screenH, mode.stretch.x); }
-        if (!mode.stretch.yExpr.empty()) { mode.stretch.y = EvaluateExpression(mode.stretch.yExpr, screenW, screenH, mode.stretch.y); }
     }
 
-    // After expression evaluation, enforce Preemptive resolution sync with EyeZoom.
-    // This makes the linkage resilient even if EyeZoom itself were expression-driven.
-    ModeConfig* eyezoomMode = nullptr;
-    ModeConfig* preemptiveMode = nullptr;
-    for (auto& mode : g_config.modes) {
-        if (!eyezoomMode && mode.id == "EyeZoom") { eyezoomMode = &mode; }
-        if (!preemptiveMode && mode.id == "Preemptive") { preemptiveMode = &mode; }
-    }
-    if (eyezoomMode && preemptiveMode) {
-        preemptiveMode->width = eyezoomMode->width;
-        preemptiveMode->height = eyezoomMode->height;
-        preemptiveMode->useRelativeSize = false;
-        preemptiveMode->relativeWidth = -1.0f;
-        preemptiveMode->relativeHeight = -1.0f;
-        preemptiveMode->widthExpr.clear();
-        preemptiveMode->heightExpr.clear();
-    }
+    std::lock_guard<std::mutex> lock(s_dimensionGraphMutex);
+    s_dimensionGraph.Recalculate(screenW, screenH);
 }
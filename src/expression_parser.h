@@ -4,15 +4,17 @@
 // EXPRESSION_PARSER.H - Safe Expression Evaluation for Dynamic Dimensions
 // ============================================================================
 // Evaluates simple math expressions with screen dimension variables.
-// Designed for security: whitelist-only identifiers, no arbitrary code execution.
+// Compilation and the bytecode itself live in expression_compiler.h; this
+// binds compiled programs to the live config (screen size, mode sizes).
 // ============================================================================
 
 #include <string>
-#include <cmath>
+
+#include "expression_compiler.h"
 
 // Evaluate an expression string with the given screen dimensions.
 // Supported:
-//   Variables: screenWidth, screenHeight
+//   Variables: screenWidth, screenHeight, <mode>.width, <mode>.height (e.g. EyeZoom.width)
 //   Operators: +, -, *, / (standard precedence)
 //   Functions: min(a,b), max(a,b), floor(x), ceil(x), round(x), abs(x), roundEven(x)
 //   Parentheses for grouping
@@ -20,16 +22,14 @@
 // On error: Returns defaultValue
 int EvaluateExpression(const std::string& expr, int screenWidth, int screenHeight, int defaultValue = 0);
 
-// Check if a string should be treated as an expression (vs a pure integer)
-// Returns true if the string contains non-numeric characters (letters, operators, etc.)
-bool IsExpression(const std::string& str);
-
 // Validate expression syntax without evaluating.
 // Returns true if valid, false if invalid.
 // If invalid, errorOut contains a human-readable error message.
 bool ValidateExpression(const std::string& expr, std::string& errorOut);
 
 // Recalculate all expression-based dimensions in the config.
-// Called when screen resolution changes or after config load.
-// This updates the cached integer values (width, height, etc.) from expression strings.
+// Called when screen resolution changes, after config load and after GUI edits.
+// Mode width/height and stretch expressions form a dependency graph (a mode may reference another mode's size, and
+// Preemptive is linked to EyeZoom); only expressions whose inputs changed since the last call are re-evaluated, in
+// topological order, and only changed values are written back to g_config.
 void RecalculateExpressionDimensions();
@@ -54,11 +54,11 @@ static bool g_cursorDefsInitialized = false;
 void InitializeCursorDefinitions() {
     if (g_cursorDefsInitialized) return;
 
-    LogCategory("cursor_textures", "[CursorTextures] InitializeCursorDefinitions starting...");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] InitializeCursorDefinitions starting...");
 
     // Start with system cursors
     AVAILABLE_CURSORS = SYSTEM_CURSORS;
-    LogCategory("cursor_textures", "[CursorTextures] Loaded " + std::to_string(SYSTEM_CURSORS.size()) + " system cursor definitions");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Loaded " + std::to_string(SYSTEM_CURSORS.size()) + " system cursor definitions");
 
     // Verify system cursors exist
     int validSystemCursors = 0;
@@ -66,30 +66,32 @@ void InitializeCursorDefinitions() {
         if (std::filesystem::exists(cursor.path)) {
             validSystemCursors++;
         } else {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: System cursor not found: " + WideToUtf8(cursor.path));
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] WARNING: System cursor not found: " + WideToUtf8(cursor.path));
         }
     }
-    LogCategory("cursor_textures", "[CursorTextures] Verified " + std::to_string(validSystemCursors) + "/" +
-                                       std::to_string(SYSTEM_CURSORS.size()) + " system cursors exist on disk");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Verified " + std::to_string(validSystemCursors) + "/" +
+                                            std::to_string(SYSTEM_CURSORS.size()) + " system cursors exist on disk");
 
     // Scan the .config/toolscreen/cursors folder for .cur and .ico files
     try {
         // Build path to .config/toolscreen/cursors using GetToolscreenPath()
         std::wstring toolscreenPath = GetToolscreenPath();
         if (toolscreenPath.empty()) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to get toolscreen path - custom cursors will not be available");
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] ERROR: Failed to get toolscreen path - custom cursors will not be available");
             g_cursorDefsInitialized = true;
             return;
         }
 
         std::filesystem::path cursorsPath = std::filesystem::path(toolscreenPath) / "cursors";
-        LogCategory("cursor_textures", "[CursorTextures] Scanning for custom cursors at: " + cursorsPath.string());
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] Scanning for custom cursors at: " + cursorsPath.string());
 
         if (!std::filesystem::exists(cursorsPath)) {
-            LogCategory("cursor_textures", "[CursorTextures] Custom cursors folder does not exist: " + cursorsPath.string());
-            LogCategory("cursor_textures", "[CursorTextures] To add custom cursors, create this folder and add .cur or .ico files");
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] Custom cursors folder does not exist: " + cursorsPath.string());
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] To add custom cursors, create this folder and add .cur or .ico files");
         } else if (!std::filesystem::is_directory(cursorsPath)) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Cursors path exists but is not a directory: " + cursorsPath.string());
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] ERROR: Cursors path exists but is not a directory: " + cursorsPath.string());
         } else {
             int customCursorsFound = 0;
             int filesSkipped = 0;
@@ -108,25 +110,27 @@ void InitializeCursorDefinitions() {
 
                         // Add to cursor definitions
                         AVAILABLE_CURSORS.push_back({ filename, filepath, loadType });
-                        LogCategory("cursor_textures", "[CursorTextures] Found custom cursor: " + filename + " (" + ext + ")");
+                        LogCategory(LogCat::CursorTextures, "[CursorTextures] Found custom cursor: " + filename + " (" + ext + ")");
                         customCursorsFound++;
                     } else {
                         filesSkipped++;
                     }
                 }
             }
-            LogCategory("cursor_textures", "[CursorTextures] Found " + std::to_string(customCursorsFound) + " custom cursor(s), skipped " +
-                                               std::to_string(filesSkipped) + " non-cursor file(s)");
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] Found " + std::to_string(customCursorsFound) + " custom cursor(s), skipped " +
+                        std::to_string(filesSkipped) + " non-cursor file(s)");
         }
     } catch (const std::filesystem::filesystem_error& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Filesystem error scanning cursors folder: " + std::string(e.what()));
-        LogCategory("cursor_textures", "[CursorTextures] Error code: " + std::to_string(e.code().value()) + " - " + e.code().message());
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Filesystem error scanning cursors folder: " + std::string(e.what()));
+        LogCategory(LogCat::CursorTextures,
+                    "[CursorTextures] Error code: " + std::to_string(e.code().value()) + " - " + e.code().message());
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Exception scanning cursors folder: " + std::string(e.what()));
-    } catch (...) { LogCategory("cursor_textures", "[CursorTextures] ERROR: Unknown exception scanning cursors folder"); }
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Exception scanning cursors folder: " + std::string(e.what()));
+    } catch (...) { LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Unknown exception scanning cursors folder"); }
 
-    LogCategory("cursor_textures", "[CursorTextures] InitializeCursorDefinitions complete. Total cursors available: " +
-                                       std::to_string(AVAILABLE_CURSORS.size()));
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] InitializeCursorDefinitions complete. Total cursors available: " +
+                                            std::to_string(AVAILABLE_CURSORS.size()));
     g_cursorDefsInitialized = true;
 }
 
@@ -142,11 +146,11 @@ static const std::vector<int> STANDARD_SIZES = {
 static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size, CursorData& outData) {
     // Validate parameters
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadSingleCursor called with empty path");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: LoadSingleCursor called with empty path");
         return false;
     }
     if (size <= 0 || size > 512) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadSingleCursor called with invalid size: " + std::to_string(size));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: LoadSingleCursor called with invalid size: " + std::to_string(size));
         return false;
     }
 
@@ -155,17 +159,17 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     try {
         if (!std::filesystem::path(path).is_absolute()) { resolvedPath = ResolveCwdPath(path); }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to resolve path: " + std::string(e.what()));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Failed to resolve path: " + std::string(e.what()));
         return false;
     }
 
     std::string pathStr = WideToUtf8(resolvedPath);
-    LogCategory("cursor_textures", "[CursorTextures] Loading cursor: " + pathStr + " at size " + std::to_string(size) +
-                                       " (type: " + (loadType == IMAGE_ICON ? "ICON" : "CURSOR") + ")");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Loading cursor: " + pathStr + " at size " + std::to_string(size) +
+                                            " (type: " + (loadType == IMAGE_ICON ? "ICON" : "CURSOR") + ")");
 
     // Check if file exists before attempting to load
     if (!std::filesystem::exists(resolvedPath)) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Cursor file does not exist: " + pathStr);
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Cursor file does not exist: " + pathStr);
         return false;
     }
 
@@ -206,7 +210,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
             errMsg = "Unknown error";
             break;
         }
-        LogCategory("cursor_textures",
+        LogCategory(LogCat::CursorTextures,
                     "[CursorTextures] ERROR: LoadImageW failed for '" + pathStr + "' - Error " + std::to_string(err) + ": " + errMsg);
         return false;
     }
@@ -222,8 +226,8 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
                 hCursor = hScaled;
             }
         } else {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: CopyImage failed to force size to " + std::to_string(size) +
-                                               "px for " + pathStr + " (err=" + std::to_string(GetLastError()) + ")");
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] WARNING: CopyImage failed to force size to " + std::to_string(size) +
+                                                    "px for " + pathStr + " (err=" + std::to_string(GetLastError()) + ")");
         }
     }
 
@@ -236,7 +240,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     if (!hasIconInfoEx) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: GetIconInfoExW failed with error " + std::to_string(err));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: GetIconInfoExW failed with error " + std::to_string(err));
         DestroyCursorOrIcon(hCursor, loadType);
         outData.hCursor = nullptr;
         return false;
@@ -245,18 +249,19 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     // Get bitmap dimensions - handle both color and monochrome cursors
     BITMAP bmp;
     bool isMonochrome = (iconInfoEx.hbmColor == NULL);
-    LogCategory("cursor_textures", "[CursorTextures] Cursor type: " + std::string(isMonochrome ? "monochrome" : "color"));
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Cursor type: " + std::string(isMonochrome ? "monochrome" : "color"));
 
     if (isMonochrome) {
         if (!iconInfoEx.hbmMask) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Monochrome cursor has no mask bitmap");
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Monochrome cursor has no mask bitmap");
             DestroyCursorOrIcon(hCursor, loadType);
             outData.hCursor = nullptr;
             return false;
         }
         if (!GetObject(iconInfoEx.hbmMask, sizeof(BITMAP), &bmp)) {
             DWORD err = GetLastError();
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: GetObject for mask bitmap failed with error " + std::to_string(err));
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] ERROR: GetObject for mask bitmap failed with error " + std::to_string(err));
             DeleteObject(iconInfoEx.hbmMask);
             DestroyCursorOrIcon(hCursor, loadType);
             outData.hCursor = nullptr;
@@ -265,7 +270,8 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     } else {
         if (!GetObject(iconInfoEx.hbmColor, sizeof(BITMAP), &bmp)) {
             DWORD err = GetLastError();
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: GetObject for color bitmap failed with error " + std::to_string(err));
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] ERROR: GetObject for color bitmap failed with error " + std::to_string(err));
             if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
             if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
             DestroyCursorOrIcon(hCursor, loadType);
@@ -279,7 +285,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     // Validate bitmap dimensions
     if (width <= 0 || height <= 0 || width > 1024 || height > 1024) {
-        LogCategory("cursor_textures",
+        LogCategory(LogCat::CursorTextures,
                     "[CursorTextures] ERROR: Invalid bitmap dimensions: " + std::to_string(width) + "x" + std::to_string(height));
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
@@ -288,9 +294,9 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
         return false;
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] Bitmap size: " + std::to_string(width) + "x" + std::to_string(height) +
-                                       ", hotspot: (" + std::to_string(iconInfoEx.xHotspot) + ", " + std::to_string(iconInfoEx.yHotspot) +
-                                       ")");
+    LogCategory(LogCat::CursorTextures,
+                "[CursorTextures] Bitmap size: " + std::to_string(width) + "x" + std::to_string(height) +
+                ", hotspot: (" + std::to_string(iconInfoEx.xHotspot) + ", " + std::to_string(iconInfoEx.yHotspot) + ")");
 
     // Store dimensions and hotspot
     outData.bitmapWidth = width;
@@ -302,7 +308,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     HDC hdcScreen = GetDC(NULL);
     if (!hdcScreen) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: GetDC(NULL) failed with error " + std::to_string(err));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: GetDC(NULL) failed with error " + std::to_string(err));
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
         DestroyCursorOrIcon(hCursor, loadType);
@@ -313,7 +319,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     HDC hdcMem = CreateCompatibleDC(hdcScreen);
     if (!hdcMem) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: CreateCompatibleDC failed with error " + std::to_string(err));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: CreateCompatibleDC failed with error " + std::to_string(err));
         ReleaseDC(NULL, hdcScreen);
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
@@ -421,7 +427,8 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
             glGenTextures(1, &outData.invertMaskTexture);
             if (outData.invertMaskTexture == 0) {
-                LogCategory("cursor_textures", "[CursorTextures] WARNING: Failed to create invert mask texture - glGenTextures returned 0");
+                LogCategory(LogCat::CursorTextures,
+                            "[CursorTextures] WARNING: Failed to create invert mask texture - glGenTextures returned 0");
                 outData.hasInvertedPixels = false; // Disable inversion since we can't render it
             } else {
                 glBindTexture(GL_TEXTURE_2D, outData.invertMaskTexture);
@@ -433,13 +440,13 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
                 GLenum glErr = glGetError();
                 if (glErr != GL_NO_ERROR) {
-                    LogCategory("cursor_textures",
+                    LogCategory(LogCat::CursorTextures,
                                 "[CursorTextures] WARNING: OpenGL error creating invert mask texture: " + std::to_string(glErr));
                     glDeleteTextures(1, &outData.invertMaskTexture);
                     outData.invertMaskTexture = 0;
                     outData.hasInvertedPixels = false;
                 } else {
-                    LogCategory("cursor_textures",
+                    LogCategory(LogCat::CursorTextures,
                                 "[CursorTextures] Created invert mask texture ID " + std::to_string(outData.invertMaskTexture));
                 }
                 glBindTexture(GL_TEXTURE_2D, 0);
@@ -505,7 +512,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     // Create OpenGL texture
     glGenTextures(1, &outData.texture);
     if (outData.texture == 0) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: glGenTextures returned 0 - OpenGL context may not be valid");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: glGenTextures returned 0 - OpenGL context may not be valid");
         DestroyCursorOrIcon(outData.hCursor, outData.loadType);
         outData.hCursor = nullptr;
         return false;
@@ -539,7 +546,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
             errStr = "Unknown (" + std::to_string(err) + ")";
             break;
         }
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: OpenGL error during texture creation: " + errStr);
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: OpenGL error during texture creation: " + errStr);
         glDeleteTextures(1, &outData.texture);
         outData.texture = 0;
         if (outData.invertMaskTexture) {
@@ -553,8 +560,8 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    LogCategory("cursor_textures", "[CursorTextures] Successfully created texture ID " + std::to_string(outData.texture) + " (" +
-                                       std::to_string(width) + "x" + std::to_string(height) + ") for " + WideToUtf8(path));
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Successfully created texture ID " + std::to_string(outData.texture) + " (" +
+                                            std::to_string(width) + "x" + std::to_string(height) + ") for " + WideToUtf8(path));
     return true;
 }
 
@@ -564,7 +571,7 @@ void LoadCursorTextures() {
     // Initialize cursor definitions (scan for custom cursors)
     InitializeCursorDefinitions();
 
-    LogCategory("cursor_textures", "[CursorTextures] LoadCursorTextures called - loading initial cursors at default size (64px)");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] LoadCursorTextures called - loading initial cursors at default size (64px)");
 
     // Only load each cursor type at the default size (64px) initially
     int totalLoaded = 0;
@@ -574,16 +581,16 @@ void LoadCursorTextures() {
         CursorData cursorData;
         if (LoadSingleCursor(cursorDef.path, cursorDef.loadType, defaultSize, cursorData)) {
             g_cursorList.push_back(cursorData);
-            LogCategory("cursor_textures",
+            LogCategory(LogCat::CursorTextures,
                         "[CursorTextures] Loaded " + WideToUtf8(cursorDef.path) + " at size " + std::to_string(defaultSize));
             totalLoaded++;
         } else {
-            LogCategory("cursor_textures",
+            LogCategory(LogCat::CursorTextures,
                         "[CursorTextures] Failed to load " + WideToUtf8(cursorDef.path) + " at size " + std::to_string(defaultSize));
         }
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] Finished loading " + std::to_string(totalLoaded) + " default cursor variants");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Finished loading " + std::to_string(totalLoaded) + " default cursor variants");
 }
 
 // Load a cursor at a specific size if not already loaded
@@ -593,7 +600,7 @@ const CursorData* LoadOrFindCursor(const std::wstring& path, UINT loadType, int
     std::string pathStr = WideToUtf8(path);
 
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadOrFindCursor called with empty path");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: LoadOrFindCursor called with empty path");
         return nullptr;
     }
 
@@ -608,24 +615,24 @@ const CursorData* LoadOrFindCursor(const std::wstring& path, UINT loadType, int
     }
 
     // Not found - load it now
-    LogCategory("cursor_textures", "[CursorTextures] Loading cursor on-demand: " + pathStr + " at size " + std::to_string(size));
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Loading cursor on-demand: " + pathStr + " at size " + std::to_string(size));
     CursorData newCursorData;
     if (LoadSingleCursor(path, loadType, size, newCursorData)) {
         std::lock_guard<std::mutex> lock(g_cursorListMutex);
         g_cursorList.push_back(newCursorData);
-        LogCategory("cursor_textures",
+        LogCategory(LogCat::CursorTextures,
                     "[CursorTextures] Successfully loaded on-demand cursor. Total loaded: " + std::to_string(g_cursorList.size()));
         // Return pointer to the newly added cursor (last element)
         return &g_cursorList.back();
     } else {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to load cursor on-demand: " + pathStr);
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: Failed to load cursor on-demand: " + pathStr);
         return nullptr;
     }
 }
 
 const CursorData* FindCursor(const std::wstring& path, int size) {
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: FindCursor called with empty path");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: FindCursor called with empty path");
         return nullptr;
     }
 
@@ -646,10 +653,11 @@ const CursorData* FindCursor(const std::wstring& path, int size) {
         if (ext == ".ico") {
             loadType = IMAGE_ICON;
         } else if (ext != ".cur" && ext != ".ani") {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: Unexpected cursor file extension: " + ext + ", treating as cursor");
+            LogCategory(LogCat::CursorTextures,
+                        "[CursorTextures] WARNING: Unexpected cursor file extension: " + ext + ", treating as cursor");
         }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures",
+        LogCategory(LogCat::CursorTextures,
                     "[CursorTextures] WARNING: Failed to parse path extension: " + std::string(e.what()) + ", defaulting to IMAGE_CURSOR");
     }
 
@@ -960,22 +968,22 @@ bool GetCursorPathByName(const std::string& cursorName, std::wstring& outPath, U
         return true;
     } else {
         // Unknown cursor name - try to use first available cursor as fallback
-        LogCategory("cursor_textures", "[CursorTextures] WARNING: Unknown cursor name '" + cursorName + "'");
-        LogCategory("cursor_textures", "[CursorTextures] Available cursors: " + std::to_string(AVAILABLE_CURSORS.size()));
-        for (const auto& def : AVAILABLE_CURSORS) { LogCategory("cursor_textures", "[CursorTextures]   - " + def.name); }
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] WARNING: Unknown cursor name '" + cursorName + "'");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] Available cursors: " + std::to_string(AVAILABLE_CURSORS.size()));
+        for (const auto& def : AVAILABLE_CURSORS) { LogCategory(LogCat::CursorTextures, "[CursorTextures]   - " + def.name); }
 
         // Use first available cursor as fallback if any exist
         if (!AVAILABLE_CURSORS.empty()) {
             outPath = AVAILABLE_CURSORS[0].path;
             outLoadType = AVAILABLE_CURSORS[0].loadType;
-            LogCategory("cursor_textures", "[CursorTextures] Using first available cursor as fallback: " + AVAILABLE_CURSORS[0].name);
+            LogCategory(LogCat::CursorTextures, "[CursorTextures] Using first available cursor as fallback: " + AVAILABLE_CURSORS[0].name);
             return false; // Still return false to indicate original cursor wasn't found
         }
 
         // No cursors available at all
         outPath = L"";
         outLoadType = IMAGE_CURSOR;
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: No cursors available for fallback");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] ERROR: No cursors available for fallback");
         return false;
     }
 }
@@ -986,7 +994,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     if (!g_cursorDefsInitialized) { InitializeCursorDefinitions(); }
 
     if (cursorName.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Empty cursor name provided");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] IsCursorFileValid: Empty cursor name provided");
         return false;
     }
 
@@ -1000,7 +1008,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     }
 
     if (!selectedDef) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Cursor '" + cursorName + "' not found in definitions");
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] IsCursorFileValid: Cursor '" + cursorName + "' not found in definitions");
         return false;
     }
 
@@ -1009,7 +1017,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     try {
         if (!std::filesystem::path(selectedDef->path).is_absolute()) { resolvedPath = ResolveCwdPath(selectedDef->path); }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures",
+        LogCategory(LogCat::CursorTextures,
                     "[CursorTextures] IsCursorFileValid: Failed to resolve path for '" + cursorName + "': " + std::string(e.what()));
         return false;
     }
@@ -1017,7 +1025,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     // Check if file exists
     bool exists = std::filesystem::exists(resolvedPath);
     if (!exists) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Cursor file does not exist: " + WideToUtf8(resolvedPath));
+        LogCategory(LogCat::CursorTextures, "[CursorTextures] IsCursorFileValid: Cursor file does not exist: " + WideToUtf8(resolvedPath));
     }
     return exists;
 }
@@ -1025,7 +1033,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
 void Cleanup() {
     std::lock_guard<std::mutex> lock(g_cursorListMutex);
 
-    LogCategory("cursor_textures",
+    LogCategory(LogCat::CursorTextures,
                 "[CursorTextures] Cleanup: Starting cleanup of " + std::to_string(g_cursorList.size()) + " cursor entries");
 
     int texturesDeleted = 0;
@@ -1051,9 +1059,9 @@ void Cleanup() {
     }
 
     g_cursorList.clear();
-    LogCategory("cursor_textures", "[CursorTextures] Cleanup complete: " + std::to_string(texturesDeleted) + " textures, " +
-                                       std::to_string(invertMasksDeleted) + " invert masks, " + std::to_string(cursorsDestroyed) +
-                                       " cursor handles");
+    LogCategory(LogCat::CursorTextures, "[CursorTextures] Cleanup complete: " + std::to_string(texturesDeleted) + " textures, " +
+                                            std::to_string(invertMasksDeleted) + " invert masks, " + std::to_string(cursorsDestroyed) +
+                                            " cursor handles");
 }
 
 std::vector<std::string> GetAvailableCursorNames() {
@@ -1,4 +1,5 @@
 ﻿#include "gui.h"
+#include "capture_scheduler.h"
 #include "config_toml.h"
 #include "expression_parser.h"
 #include "fake_cursor.h"
@@ -6,6 +7,7 @@
 #include "imgui_impl_win32.h"
 #include "imgui_stdlib.h"
 #include "logic_thread.h"
+#include "metrics.h"
 #include "mirror_thread.h"
 #include "profiler.h"
 #include "render.h"
@@ -29,6 +31,7 @@
 #include <future>
 #include <set>
 #include <shared_mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -50,6 +53,13 @@ static constexpr float spinnerHoldInterval = 0.01f; // Interval between repeats
 // Track background save status
 static std::atomic<bool> s_isConfigSaving{ false };
 
+// config.toml hot reload. s_configFileHash is the hash of the text we last loaded or wrote, so the file monitor can tell
+// our own saves from hand edits; an edit is parked in s_pendingConfigText until the game thread applies it.
+static std::mutex s_configFileMutex;
+static uint64_t s_configFileHash = 0;          // Guarded by s_configFileMutex
+static std::string s_pendingConfigText;        // Guarded by s_configFileMutex
+static std::atomic<bool> s_configReloadPending{ false };
+
 // IMAGE VALIDATION AND FILE PICKER HELPERS
 // State for async file picker results
 struct ImagePickerResult {
@@ -1085,6 +1095,38 @@ error_case:
     outColor = { 0.0f, 0.0f, 0.0f };
 }
 
+static uint64_t HashConfigText(const std::string& text) {
+    uint64_t h = 1469598103934665603ull; // FNV-1a
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Records text as the current content of config.toml. Any hand edit parked before this write is superseded by it.
+static void RecordConfigFileText(const std::string& text) {
+    const uint64_t hash = HashConfigText(text);
+    std::lock_guard<std::mutex> lock(s_configFileMutex);
+    s_configFileHash = hash;
+    s_pendingConfigText.clear();
+    s_configReloadPending.store(false, std::memory_order_release);
+}
+
+static toml::table ParseConfigText(const std::string& text, const std::wstring& configPath) {
+    std::istringstream in(text);
+#if TOML_EXCEPTIONS
+    return toml::parse(in, configPath);
+#else
+    toml::parse_result result = toml::parse(in, configPath);
+    if (!result) {
+        const auto& err = result.error();
+        throw std::runtime_error(std::string(err.description()));
+    }
+    return std::move(result).table();
+#endif
+}
+
 void SaveConfig() {
     PROFILE_SCOPE_CAT("Config Save", "IO Operations");
 
@@ -1127,12 +1169,16 @@ void SaveConfig() {
             _set_se_translator(SEHTranslator);
             try {
                 try {
+                    std::ostringstream text;
+                    text << tbl;
+                    RecordConfigFileText(text.str());
+
                     // IMPORTANT (Windows/Unicode): open via std::filesystem::path to support non-ANSI user profiles.
                     std::ofstream o(std::filesystem::path(configPath), std::ios::binary | std::ios::trunc);
                     if (!o.is_open()) {
                         Log("ERROR: Failed to open config file for writing.");
                     } else {
-                        o << tbl;
+                        o << text.str();
                         o.close();
                     }
                 } catch (const std::exception& e) { Log("ERROR: Failed to write config file: " + std::string(e.what())); }
@@ -1185,13 +1231,17 @@ void SaveConfigImmediate() {
         // Publish updated config snapshot for reader threads (RCU pattern)
         PublishConfigSnapshot();
 
+        std::ostringstream text;
+        text << tbl;
+        RecordConfigFileText(text.str());
+
         // IMPORTANT (Windows/Unicode): open via std::filesystem::path to support non-ANSI user profiles.
         std::ofstream o(std::filesystem::path(configPath), std::ios::binary | std::ios::trunc);
         if (!o.is_open()) {
             Log("ERROR: Failed to open config file for writing.");
             return;
         }
-        o << tbl;
+        o << text.str();
         o.close();
 
         Log("Configuration saved to file (immediate).");
@@ -1814,6 +1864,188 @@ void WriteDefaultConfig(const std::wstring& path) {
     }
 }
 
+// Fills in built-in modes, resolves relative sizes and defaults, resets runtime hotkey/mode state and upgrades the
+// config version. Shared by LoadConfig and the config.toml hot reload; expects freshly parsed data in g_config.
+static void NormalizeLoadedConfig() {
+    int screenWidth = GetCachedScreenWidth();
+    int screenHeight = GetCachedScreenHeight();
+
+    // Helper to check if a mode exists
+    auto modeExists = [&](const std::string& id) -> bool {
+        for (const auto& mode : g_config.modes) {
+            if (EqualsIgnoreCase(mode.id, id)) return true;
+        }
+        return false;
+    };
+
+    // Ensure Fullscreen mode exists with current monitor resolution
+    if (!modeExists("Fullscreen")) {
+        ModeConfig fullscreenMode;
+        fullscreenMode.id = "Fullscreen";
+        fullscreenMode.width = screenWidth;
+        fullscreenMode.height = screenHeight;
+        fullscreenMode.stretch.enabled = true;
+        fullscreenMode.stretch.x = 0;
+        fullscreenMode.stretch.y = 0;
+        fullscreenMode.stretch.width = screenWidth;
+        fullscreenMode.stretch.height = screenHeight;
+        fullscreenMode.mirrorIds.push_back("Mapless");
+        g_config.modes.insert(g_config.modes.begin(), fullscreenMode);
+        Log("Created missing Fullscreen mode");
+    }
+    // NOTE: If Fullscreen mode already exists, we preserve its custom resolution.
+    // Users can set a custom resolution in the GUI, and it should persist across mode switches.
+
+    // Ensure EyeZoom mode exists
+    if (!modeExists("EyeZoom")) {
+        ModeConfig eyezoomMode;
+        eyezoomMode.id = "EyeZoom";
+        eyezoomMode.width = 384;
+        eyezoomMode.height = 16384;
+        g_config.modes.push_back(eyezoomMode);
+        Log("Created missing EyeZoom mode");
+    }
+
+    // Ensure Preemptive mode exists.
+    // This is a built-in mode that behaves like a normal mode (no EyeZoom clone rendering),
+    // but its resolution is always kept in sync with EyeZoom.
+    {
+        ModeConfig* eyezoomModePtr = nullptr;
+        for (auto& m : g_config.modes) {
+            if (EqualsIgnoreCase(m.id, "EyeZoom")) {
+                eyezoomModePtr = &m;
+                break;
+            }
+        }
+
+        if (!modeExists("Preemptive")) {
+            ModeConfig preemptiveMode;
+            // Copy mirrors/background/images/etc from EyeZoom so defaults match.
+            if (eyezoomModePtr) { preemptiveMode = *eyezoomModePtr; }
+            preemptiveMode.id = "Preemptive";
+            preemptiveMode.width = eyezoomModePtr ? eyezoomModePtr->width : 384;
+            preemptiveMode.height = eyezoomModePtr ? eyezoomModePtr->height : 16384;
+
+            // Force absolute sizing (this mode copies its resolution).
+            preemptiveMode.useRelativeSize = false;
+            preemptiveMode.widthExpr.clear();
+            preemptiveMode.heightExpr.clear();
+            preemptiveMode.relativeWidth = -1.0f;
+            preemptiveMode.relativeHeight = -1.0f;
+
+            g_config.modes.push_back(preemptiveMode);
+            Log("Created missing Preemptive mode");
+        }
+        // An existing Preemptive mode is sanitized and kept in sync by RecalculateExpressionDimensions(), which every
+        // caller runs next (Preemptive is a built-in edge of the mode dimension graph).
+    }
+
+    // Ensure Thin mode exists
+    if (!modeExists("Thin")) {
+        ModeConfig thinMode;
+        thinMode.id = "Thin";
+        thinMode.width = 300;
+        thinMode.height = screenHeight;
+        thinMode.background.selectedMode = "color";
+        thinMode.background.color = { 45 / 255.0f, 0 / 255.0f, 80 / 255.0f };
+        thinMode.mirrorIds.push_back("Mapless");
+        g_config.modes.push_back(thinMode);
+        Log("Created missing Thin mode");
+    }
+
+    // Ensure Wide mode exists
+    if (!modeExists("Wide")) {
+        ModeConfig wideMode;
+        wideMode.id = "Wide";
+        wideMode.width = screenWidth;
+        wideMode.height = 400;
+        wideMode.background.selectedMode = "color";
+        wideMode.background.color = { 0.0f, 0.0f, 0.0f };
+        wideMode.mirrorIds.push_back("Mapless");
+        g_config.modes.push_back(wideMode);
+        Log("Created missing Wide mode");
+    }
+
+    // Resolve relative sizes to pixel values for all modes
+    // This is necessary when loading configs that use percentage-based sizing
+    for (auto& mode : g_config.modes) {
+        bool widthIsRelative = mode.widthExpr.empty() && mode.relativeWidth >= 0.0f && mode.relativeWidth <= 1.0f;
+        bool heightIsRelative = mode.heightExpr.empty() && mode.relativeHeight >= 0.0f && mode.relativeHeight <= 1.0f;
+
+        if (widthIsRelative) {
+            mode.width = static_cast<int>(mode.relativeWidth * screenWidth);
+            if (mode.width < 1) mode.width = 1;
+        }
+        if (heightIsRelative) {
+            mode.height = static_cast<int>(mode.relativeHeight * screenHeight);
+            if (mode.height < 1) mode.height = 1;
+        }
+    }
+
+    for (auto& hotkey : g_config.hotkeys) {
+        if (hotkey.mainMode.empty()) { hotkey.mainMode = g_config.defaultMode; }
+    }
+
+    // Initialize thread-safe secondary mode state from loaded config
+    ResetAllHotkeySecondaryModes();
+
+    {
+        std::lock_guard<std::mutex> lock(g_modeIdMutex);
+        if (g_currentModeId.empty()) {
+            g_currentModeId = g_config.defaultMode;
+            // Publish the interned handle for lock-free readers
+            g_currentModeHandle.store(InternModeId(g_config.defaultMode), std::memory_order_release);
+        }
+    }
+    RefreshEffectiveMouseSensitivity();
+
+    Log("Config loaded: " + std::to_string(g_config.modes.size()) + " modes, " + std::to_string(g_config.mirrors.size()) +
+        " mirrors, " + std::to_string(g_config.images.size()) + " images, " + std::to_string(g_config.windowOverlays.size()) +
+        " window overlays, " + std::to_string(g_config.hotkeys.size()) + " hotkeys.");
+
+    // Check and handle config version upgrades
+    int loadedConfigVersion = g_config.configVersion;
+    int currentConfigVersion = GetConfigVersion();
+
+    if (loadedConfigVersion < currentConfigVersion) {
+        Log("Config version upgrade detected: v" + std::to_string(loadedConfigVersion) + " -> v" +
+            std::to_string(currentConfigVersion));
+
+        // ================================================================
+        // CONFIG UPGRADE LOGIC
+        // ================================================================
+        // Add version-specific upgrade logic here as needed.
+        // Each upgrade should be idempotent and version-specific.
+        //
+        // Example for future upgrades:
+        // if (loadedConfigVersion < 2) {
+        //     // Upgrade from v1 to v2: Add new field with default value
+        //     for (auto& mode : g_config.modes) {
+        //         if (mode.newFieldFromV2.empty()) {
+        //             mode.newFieldFromV2 = "default_value";
+        //         }
+        //     }
+        //     Log("Applied config upgrade: v1 -> v2");
+        // }
+        // if (loadedConfigVersion < 3) {
+        //     // Upgrade from v2 to v3: Rename or restructure fields
+        //     // ... upgrade logic here ...
+        //     Log("Applied config upgrade: v2 -> v3");
+        // }
+        // ================================================================
+
+        // Update config version to current
+        g_config.configVersion = currentConfigVersion;
+        g_configIsDirty = true; // Mark config as dirty to save the updated version
+        Log("Config upgraded to version " + std::to_string(currentConfigVersion));
+    } else if (loadedConfigVersion > currentConfigVersion) {
+        Log("WARNING: Config version is newer than tool version (config: v" + std::to_string(loadedConfigVersion) + ", tool: v" +
+            std::to_string(currentConfigVersion) + ")");
+    } else {
+        Log("Config version: v" + std::to_string(loadedConfigVersion) + " (current)");
+    }
+}
+
 void LoadConfig() {
     PROFILE_SCOPE_CAT("Config Load", "IO Operations");
     if (g_toolscreenPath.empty()) {
@@ -1844,243 +2076,21 @@ void LoadConfig() {
 
     try {
         g_config = Config(); // Initialize with struct defaults
-        g_hotkeyTimestamps.clear();
 
         // Load TOML config
         std::ifstream in(std::filesystem::path(configPath), std::ios::binary);
         if (!in.is_open()) {
             throw std::runtime_error("Failed to open config.toml for reading.");
         }
+        std::ostringstream text;
+        text << in.rdbuf();
+        RecordConfigFileText(text.str());
 
-        toml::table tbl;
-    #if TOML_EXCEPTIONS
-        tbl = toml::parse(in, configPath);
-    #else
-        toml::parse_result result = toml::parse(in, configPath);
-        if (!result) {
-            const auto& err = result.error();
-            throw std::runtime_error(std::string(err.description()));
-        }
-        tbl = std::move(result).table();
-    #endif
+        toml::table tbl = ParseConfigText(text.str(), configPath);
         ConfigFromToml(tbl, g_config);
         Log("Loaded config from TOML file.");
 
-
-        int screenWidth = GetCachedScreenWidth();
-        int screenHeight = GetCachedScreenHeight();
-
-        // Helper to check if a mode exists
-        auto modeExists = [&](const std::string& id) -> bool {
-            for (const auto& mode : g_config.modes) {
-                if (EqualsIgnoreCase(mode.id, id)) return true;
-            }
-            return false;
-        };
-
-        // Ensure Fullscreen mode exists with current monitor resolution
-        if (!modeExists("Fullscreen")) {
-            ModeConfig fullscreenMode;
-            fullscreenMode.id = "Fullscreen";
-            fullscreenMode.width = screenWidth;
-            fullscreenMode.height = screenHeight;
-            fullscreenMode.stretch.enabled = true;
-            fullscreenMode.stretch.x = 0;
-            fullscreenMode.stretch.y = 0;
-            fullscreenMode.stretch.width = screenWidth;
-            fullscreenMode.stretch.height = screenHeight;
-            fullscreenMode.mirrorIds.push_back("Mapless");
-            g_config.modes.insert(g_config.modes.begin(), fullscreenMode);
-            Log("Created missing Fullscreen mode");
-        }
-        // NOTE: If Fullscreen mode already exists, we preserve its custom resolution.
-        // Users can set a custom resolution in the GUI, and it should persist across mode switches.
-
-        // Ensure EyeZoom mode exists
-        if (!modeExists("EyeZoom")) {
-            ModeConfig eyezoomMode;
-            eyezoomMode.id = "EyeZoom";
-            eyezoomMode.width = 384;
-            eyezoomMode.height = 16384;
-            g_config.modes.push_back(eyezoomMode);
-            Log("Created missing EyeZoom mode");
-        }
-
-        // Ensure Preemptive mode exists.
-        // This is a built-in mode that behaves like a normal mode (no EyeZoom clone rendering),
-        // but its resolution is always kept in sync with EyeZoom.
-        {
-            ModeConfig* eyezoomModePtr = nullptr;
-            for (auto& m : g_config.modes) {
-                if (EqualsIgnoreCase(m.id, "EyeZoom")) {
-                    eyezoomModePtr = &m;
-                    break;
-                }
-            }
-
-            if (!modeExists("Preemptive")) {
-                ModeConfig preemptiveMode;
-                // Copy mirrors/background/images/etc from EyeZoom so defaults match.
-                if (eyezoomModePtr) { preemptiveMode = *eyezoomModePtr; }
-                preemptiveMode.id = "Preemptive";
-                preemptiveMode.width = eyezoomModePtr ? eyezoomModePtr->width : 384;
-                preemptiveMode.height = eyezoomModePtr ? eyezoomModePtr->height : 16384;
-
-                // Force absolute sizing (this mode copies its resolution).
-                preemptiveMode.useRelativeSize = false;
-                preemptiveMode.widthExpr.clear();
-                preemptiveMode.heightExpr.clear();
-                preemptiveMode.relativeWidth = -1.0f;
-                preemptiveMode.relativeHeight = -1.0f;
-
-                g_config.modes.push_back(preemptiveMode);
-                Log("Created missing Preemptive mode");
-            } else {
-                // Keep resolution synced + remove any expression/relative sizing.
-                ModeConfig* preemptiveModePtr = nullptr;
-                for (auto& m : g_config.modes) {
-                    if (EqualsIgnoreCase(m.id, "Preemptive")) {
-                        preemptiveModePtr = &m;
-                        break;
-                    }
-                }
-
-                if (preemptiveModePtr) {
-                    bool changed = false;
-                    if (!preemptiveModePtr->widthExpr.empty() || !preemptiveModePtr->heightExpr.empty()) {
-                        preemptiveModePtr->widthExpr.clear();
-                        preemptiveModePtr->heightExpr.clear();
-                        changed = true;
-                    }
-                    if (preemptiveModePtr->relativeWidth >= 0.0f || preemptiveModePtr->relativeHeight >= 0.0f ||
-                        preemptiveModePtr->useRelativeSize) {
-                        preemptiveModePtr->relativeWidth = -1.0f;
-                        preemptiveModePtr->relativeHeight = -1.0f;
-                        preemptiveModePtr->useRelativeSize = false;
-                        changed = true;
-                    }
-
-                    if (eyezoomModePtr) {
-                        if (preemptiveModePtr->width != eyezoomModePtr->width) {
-                            preemptiveModePtr->width = eyezoomModePtr->width;
-                            changed = true;
-                        }
-                        if (preemptiveModePtr->height != eyezoomModePtr->height) {
-                            preemptiveModePtr->height = eyezoomModePtr->height;
-                            changed = true;
-                        }
-                    }
-
-                    if (changed) { g_configIsDirty = true; }
-                }
-            }
-        }
-
-        // Ensure Thin mode exists
-        if (!modeExists("Thin")) {
-            ModeConfig thinMode;
-            thinMode.id = "Thin";
-            thinMode.width = 300;
-            thinMode.height = screenHeight;
-            thinMode.background.selectedMode = "color";
-            thinMode.background.color = { 45 / 255.0f, 0 / 255.0f, 80 / 255.0f };
-            thinMode.mirrorIds.push_back("Mapless");
-            g_config.modes.push_back(thinMode);
-            Log("Created missing Thin mode");
-        }
-
-        // Ensure Wide mode exists
-        if (!modeExists("Wide")) {
-            ModeConfig wideMode;
-            wideMode.id = "Wide";
-            wideMode.width = screenWidth;
-            wideMode.height = 400;
-            wideMode.background.selectedMode = "color";
-            wideMode.background.color = { 0.0f, 0.0f, 0.0f };
-            wideMode.mirrorIds.push_back("Mapless");
-            g_config.modes.push_back(wideMode);
-            Log("Created missing Wide mode");
-        }
-
-        // Resolve relative sizes to pixel values for all modes
-        // This is necessary when loading configs that use percentage-based sizing
-        for (auto& mode : g_config.modes) {
-            bool widthIsRelative = mode.widthExpr.empty() && mode.relativeWidth >= 0.0f && mode.relativeWidth <= 1.0f;
-            bool heightIsRelative = mode.heightExpr.empty() && mode.relativeHeight >= 0.0f && mode.relativeHeight <= 1.0f;
-
-            if (widthIsRelative) {
-                mode.width = static_cast<int>(mode.relativeWidth * screenWidth);
-                if (mode.width < 1) mode.width = 1;
-            }
-            if (heightIsRelative) {
-                mode.height = static_cast<int>(mode.relativeHeight * screenHeight);
-                if (mode.height < 1) mode.height = 1;
-            }
-        }
-
-        for (auto& hotkey : g_config.hotkeys) {
-            if (hotkey.mainMode.empty()) { hotkey.mainMode = g_config.defaultMode; }
-        }
-
-        // Initialize thread-safe secondary mode state from loaded config
-        ResetAllHotkeySecondaryModes();
-
-        {
-            std::lock_guard<std::mutex> lock(g_modeIdMutex);
-            if (g_currentModeId.empty()) {
-                g_currentModeId = g_config.defaultMode;
-                // Update lock-free double-buffer for input handlers
-                int nextIndex = 1 - g_currentModeIdIndex.load(std::memory_order_relaxed);
-                g_modeIdBuffers[nextIndex] = g_config.defaultMode;
-                g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
-            }
-        }
-
-        Log("Config loaded: " + std::to_string(g_config.modes.size()) + " modes, " + std::to_string(g_config.mirrors.size()) +
-            " mirrors, " + std::to_string(g_config.images.size()) + " images, " + std::to_string(g_config.windowOverlays.size()) +
-            " window overlays, " + std::to_string(g_config.hotkeys.size()) + " hotkeys.");
-
-        // Check and handle config version upgrades
-        int loadedConfigVersion = g_config.configVersion;
-        int currentConfigVersion = GetConfigVersion();
-
-        if (loadedConfigVersion < currentConfigVersion) {
-            Log("Config version upgrade detected: v" + std::to_string(loadedConfigVersion) + " -> v" +
-                std::to_string(currentConfigVersion));
-
-            // ================================================================
-            // CONFIG UPGRADE LOGIC
-            // ================================================================
-            // Add version-specific upgrade logic here as needed.
-            // Each upgrade should be idempotent and version-specific.
-            //
-            // Example for future upgrades:
-            // if (loadedConfigVersion < 2) {
-            //     // Upgrade from v1 to v2: Add new field with default value
-            //     for (auto& mode : g_config.modes) {
-            //         if (mode.newFieldFromV2.empty()) {
-            //             mode.newFieldFromV2 = "default_value";
-            //         }
-            //     }
-            //     Log("Applied config upgrade: v1 -> v2");
-            // }
-            // if (loadedConfigVersion < 3) {
-            //     // Upgrade from v2 to v3: Rename or restructure fields
-            //     // ... upgrade logic here ...
-            //     Log("Applied config upgrade: v2 -> v3");
-            // }
-            // ================================================================
-
-            // Update config version to current
-            g_config.configVersion = currentConfigVersion;
-            g_configIsDirty = true; // Mark config as dirty to save the updated version
-            Log("Config upgraded to version " + std::to_string(currentConfigVersion));
-        } else if (loadedConfigVersion > currentConfigVersion) {
-            Log("WARNING: Config version is newer than tool version (config: v" + std::to_string(loadedConfigVersion) + ", tool: v" +
-                std::to_string(currentConfigVersion) + ")");
-        } else {
-            Log("Config version: v" + std::to_string(loadedConfigVersion) + " (current)");
-        }
+        NormalizeLoadedConfig();
 
         std::string initialMode;
         {
@@ -2095,16 +2105,6 @@ void LoadConfig() {
             g_configLoadError.clear();
         }
 
-        // Rebuild hotkey optimization cache while we still hold the config lock
-        // This is safe because we use the internal version that doesn't try to reacquire the lock
-        {
-            std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-            RebuildHotkeyMainKeys_Internal();
-        }
-
-        // Invalidate config lookup caches to force rebuild with new config data
-        InvalidateConfigLookupCaches();
-
         // Set overlay text font size
         SetOverlayTextFontSize(g_config.eyezoom.textFontSize);
 
@@ -2133,6 +2133,101 @@ void LoadConfig() {
     }
 }
 
+void PollConfigFileForEdits() {
+    // Only the file monitor thread calls this
+    static FILETIME s_lastWriteTime = {};
+    static bool s_haveWriteTime = false;
+    static bool s_settling = false;
+
+    if (g_toolscreenPath.empty()) return;
+    const std::wstring configPath = g_toolscreenPath + L"\\config.toml";
+
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(configPath.c_str(), GetFileExInfoStandard, &attributes)) return;
+
+    if (!s_haveWriteTime) {
+        s_lastWriteTime = attributes.ftLastWriteTime;
+        s_haveWriteTime = true;
+        return;
+    }
+    if (CompareFileTime(&s_lastWriteTime, &attributes.ftLastWriteTime) != 0) {
+        // Editors often save in several writes: read once the write time has held still for a poll
+        s_lastWriteTime = attributes.ftLastWriteTime;
+        s_settling = true;
+        return;
+    }
+    if (!s_settling) return;
+    s_settling = false;
+
+    uint64_t knownHash;
+    {
+        std::lock_guard<std::mutex> lock(s_configFileMutex);
+        knownHash = s_configFileHash;
+    }
+
+    std::ifstream in(std::filesystem::path(configPath), std::ios::binary);
+    if (!in.is_open()) return;
+    std::ostringstream text;
+    text << in.rdbuf();
+    if (HashConfigText(text.str()) == knownHash) return; // Our own save
+
+    std::lock_guard<std::mutex> lock(s_configFileMutex);
+    if (s_configFileHash != knownHash) return; // We saved over it while it was being read
+    s_pendingConfigText = text.str();
+    s_configReloadPending.store(true, std::memory_order_release);
+    Log("config.toml was edited outside the GUI, queueing reload.");
+}
+
+void ApplyPendingConfigReload() {
+    if (!s_configReloadPending.load(std::memory_order_acquire)) return;
+    // Unsaved GUI edits win: their save rewrites the file and drops the parked edit (RecordConfigFileText)
+    if (g_configIsDirty.load() || s_isConfigSaving.load()) return;
+
+    std::string text;
+    {
+        std::lock_guard<std::mutex> lock(s_configFileMutex);
+        if (!s_configReloadPending.load(std::memory_order_relaxed)) return;
+        text = std::move(s_pendingConfigText);
+        s_pendingConfigText.clear();
+        s_configFileHash = HashConfigText(text);
+        s_configReloadPending.store(false, std::memory_order_release);
+    }
+
+    PROFILE_SCOPE_CAT("Config Hot Reload", "IO Operations");
+    const std::wstring configPath = g_toolscreenPath + L"\\config.toml";
+    try {
+        // Parse into a scratch config first so a broken edit leaves the running config untouched
+        Config reloaded;
+        ConfigFromToml(ParseConfigText(text, configPath), reloaded);
+        g_config = std::move(reloaded);
+    } catch (const std::exception& e) {
+        Log("ERROR: Ignoring edited config.toml, keeping the current config: " + std::string(e.what()));
+        return;
+    }
+
+    NormalizeLoadedConfig();
+    g_configIsDirty = false;
+
+    SetOverlayTextFontSize(g_config.eyezoom.textFontSize);
+    RecalculateExpressionDimensions();
+
+    // Elements that compare equal keep their snapshot nodes, so the published diff (see config_diff.h) names only what
+    // the edit touched and every resource owner rebuilds just that
+    PublishConfigSnapshot();
+    SetGlobalMirrorGammaMode(g_config.mirrorGammaMode);
+
+    std::string currentMode;
+    {
+        std::lock_guard<std::mutex> lock(g_modeIdMutex);
+        currentMode = g_currentModeId;
+    }
+    if (!GetModeFromSnapshot(g_config, currentMode)) {
+        Log("Mode '" + currentMode + "' no longer exists after config reload, switching to '" + g_config.defaultMode + "'.");
+        SwitchToMode(g_config.defaultMode, "config reload", /*forceCut=*/true);
+    }
+    Log("Reloaded config.toml after an external edit.");
+}
+
 bool HasDuplicateModeName(const std::string& name, size_t currentIndex) {
     for (size_t i = 0; i < g_config.modes.size(); i++) {
         if (i != currentIndex && g_config.modes[i].id == name) { return true; }
@@ -2544,6 +2639,9 @@ void RenderSettingsGUI() {
                 } else if (s_mainHotkeyToBind == -996) {
                     // Special case for window overlay visibility toggle hotkey
                     g_config.windowOverlaysHotkey = keys;
+                } else if (s_mainHotkeyToBind == -995) {
+                    // Special case for profiler trace dump hotkey
+                    g_config.debug.flightRecorderHotkey = keys;
                 } else {
                     g_config.hotkeys[s_mainHotkeyToBind].keys = keys;
                 }
@@ -2564,12 +2662,6 @@ void RenderSettingsGUI() {
             }
             g_configIsDirty = true;
 
-            // Rebuild hotkey cache
-            {
-                std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                RebuildHotkeyMainKeys_Internal();
-            }
-
             s_bindingKeys.clear();
             s_hadKeysPressed = false;
             s_preHeldKeys.clear();
@@ -3260,12 +3352,16 @@ void main() {
     glBlendFuncSeparate(savedBlendSrcRGB, savedBlendDstRGB, savedBlendSrcA, savedBlendDstA);
 }
 
+// Bottom edge of the performance overlay as of its last render; the profiler overlay is placed below it
+static float s_performanceOverlayBottom = 0.0f;
+
 void RenderPerformanceOverlay(bool showPerformanceOverlay) {
     if (!showPerformanceOverlay) return;
 
-    static auto lastOverlayUpdate = std::chrono::steady_clock::now();
+    static auto lastOverlayUpdate = std::chrono::steady_clock::time_point{};
     static float cachedFrameTime = 0.0f;
     static float cachedOriginalFrameTime = 0.0f;
+    static std::vector<MetricSnapshot> cachedMetrics;
 
     auto currentTime = std::chrono::steady_clock::now();
     auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastOverlayUpdate);
@@ -3273,6 +3369,7 @@ void RenderPerformanceOverlay(bool showPerformanceOverlay) {
     if (timeSinceLastUpdate.count() >= 500) {
         cachedFrameTime = static_cast<float>(g_lastFrameTimeMs.load());
         cachedOriginalFrameTime = static_cast<float>(g_originalFrameTimeMs.load());
+        cachedMetrics = GetMetricsSnapshot();
         lastOverlayUpdate = currentTime;
     }
 
@@ -3283,6 +3380,26 @@ void RenderPerformanceOverlay(bool showPerformanceOverlay) {
                      ImGuiWindowFlags_AlwaysAutoResize);
     ImGui::Text("Render Hook Overhead: %.2f ms", cachedFrameTime);
     ImGui::Text("Original Frame Time: %.2f ms", cachedOriginalFrameTime);
+
+    // Drop / overflow / fallback metrics (metrics.h), totals since startup
+    if (!cachedMetrics.empty() && ImGui::BeginTable("##MetricsTable", 3, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
+        ImGui::TableSetupColumn("Metric", ImGuiTableColumnFlags_WidthFixed, 240.0f);
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Rate", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableHeadersRow();
+        for (const MetricSnapshot& metric : cachedMetrics) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(metric.name);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%lld", static_cast<long long>(metric.value));
+            ImGui::TableSetColumnIndex(2);
+            if (metric.kind == MetricKind::Meter) ImGui::Text("%.1f/s", metric.ratePerSecond);
+        }
+        ImGui::EndTable();
+    }
+
+    s_performanceOverlayBottom = ImGui::GetWindowPos().y + ImGui::GetWindowSize().y;
     ImGui::End();
 }
 
@@ -3291,7 +3408,8 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
 
     auto displayData = Profiler::GetInstance().GetProfileData();
 
-    ImGui::SetNextWindowPos(ImVec2(5.0f, showPerformanceOverlay ? 80.0f : 5.0f));
+    const bool belowPerformanceOverlay = showPerformanceOverlay && s_performanceOverlayBottom > 0.0f;
+    ImGui::SetNextWindowPos(ImVec2(5.0f, belowPerformanceOverlay ? s_performanceOverlayBottom + 5.0f : 5.0f));
     ImGui::SetNextWindowBgAlpha(0.35f);
     ImGui::Begin("ProfilerOverlay", nullptr,
                  ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoInputs |
@@ -3303,9 +3421,16 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
     ImGui::Text("Toolscreen Profiler (Hierarchical)");
     ImGui::Separator();
 
+    // Latency columns: percentiles of single calls since the last histogram reset, and calls above the thresholds
+    const bool showPercentiles = g_config.debug.profilerShowPercentiles;
+    char thresholdLabels[Profiler::LATENCY_THRESHOLD_COUNT][24];
+    for (int t = 0; t < Profiler::LATENCY_THRESHOLD_COUNT; ++t) {
+        snprintf(thresholdLabels[t], sizeof(thresholdLabels[t]), ">%gms", displayData.latencyThresholdsMs[t]);
+    }
+
     // Helper lambda to render a tree section
-    auto renderTreeSection = [](const char* sectionTitle, const std::vector<std::pair<std::string, Profiler::ProfileEntry>>& entries,
-                                ImVec4 headerColor) {
+    auto renderTreeSection = [&](const char* sectionTitle, const std::vector<std::pair<std::string, Profiler::ProfileEntry>>& entries,
+                                 ImVec4 headerColor) {
         if (entries.empty()) return;
 
         // Section header
@@ -3313,12 +3438,23 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         ImGui::Text("%s", sectionTitle);
         ImGui::PopStyleColor();
 
-        if (ImGui::BeginTable("##ProfilerTable", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
+        const int columnCount = showPercentiles ? 9 + Profiler::LATENCY_THRESHOLD_COUNT : 5;
+        if (ImGui::BeginTable("##ProfilerTable", columnCount, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_NoHostExtendX)) {
             ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthFixed, 280.0f);
             ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, 90.0f);
             ImGui::TableSetupColumn("Self", ImGuiTableColumnFlags_WidthFixed, 90.0f);
             ImGui::TableSetupColumn("Of Parent", ImGuiTableColumnFlags_WidthFixed, 70.0f);
             ImGui::TableSetupColumn("Of Total", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+            if (showPercentiles) {
+                ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                ImGui::TableSetupColumn("p90", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                ImGui::TableSetupColumn("p99.9", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                for (int t = 0; t < Profiler::LATENCY_THRESHOLD_COUNT; ++t) {
+                    ImGui::TableSetupColumn(thresholdLabels[t], ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                }
+                ImGui::TableHeadersRow();
+            }
 
             for (size_t i = 0; i < entries.size(); ++i) {
                 const auto& [name, entry] = entries[i];
@@ -3398,6 +3534,25 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
                 } else {
                     ImGui::Text("<1%%");
                 }
+
+                if (showPercentiles && entry.sampleCount > 0) {
+                    const double percentiles[] = { entry.p50Time, entry.p90Time, entry.p99Time, entry.p999Time };
+                    for (int p = 0; p < 4; ++p) {
+                        ImGui::TableSetColumnIndex(5 + p);
+                        if (percentiles[p] >= 0.001) {
+                            ImGui::Text("%.3fms", percentiles[p]);
+                        } else {
+                            ImGui::Text("<0.001");
+                        }
+                    }
+                    for (int t = 0; t < Profiler::LATENCY_THRESHOLD_COUNT; ++t) {
+                        ImGui::TableSetColumnIndex(9 + t);
+                        const uint64_t above = entry.callsAboveThreshold[t];
+                        if (above > 0) { ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.5f, 0.4f, 1.0f)); }
+                        ImGui::Text("%llu", static_cast<unsigned long long>(above));
+                        if (above > 0) { ImGui::PopStyleColor(); }
+                    }
+                }
             }
 
             ImGui::EndTable();
@@ -3413,6 +3568,35 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         renderTreeSection("Other Threads", displayData.otherThreads, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
     }
 
+    // Per-frame counters (averaged over the last display interval)
+    if (!displayData.counters.empty()) {
+        ImGui::Separator();
+        for (const auto& counter : displayData.counters) {
+            ImGui::Text("%s: %.1f %s/frame", counter.name.c_str(), counter.perFrame, counter.unit.c_str());
+        }
+    }
+
+    int filterPassesRun = 0, filterPassesShared = 0;
+    GetMirrorFilterPassCounts(filterPassesRun, filterPassesShared);
+    if (filterPassesRun + filterPassesShared > 0) {
+        ImGui::Separator();
+        ImGui::Text("Mirror filter passes: %d run, %d shared", filterPassesRun, filterPassesShared);
+    }
+
+    // Capture scheduling: achieved rate and jitter against each mirror/overlay's target FPS
+    bool scheduleHeader = false;
+    for (const auto& [source, elements] : GetCaptureScheduleStats()) {
+        for (const auto& [name, st] : elements) {
+            if (st.targetFps <= 0 || st.meanIntervalMs <= 0.0) continue;
+            if (!scheduleHeader) {
+                ImGui::Separator();
+                scheduleHeader = true;
+            }
+            ImGui::Text("%s '%s': %d fps target, %.1f actual, jitter %.2f ms avg / %.2f ms max", source.c_str(), name.c_str(), st.targetFps,
+                        1000.0 / st.meanIntervalMs, st.meanJitterMs, st.maxJitterMs);
+        }
+    }
+
     ImGui::End();
 }
 
@@ -72,8 +72,6 @@ if (ImGui::BeginTabItem("General")) {
         g_config.hotkeys.push_back(newHotkey);
         ResizeHotkeySecondaryModes(g_config.hotkeys.size());               // Sync runtime state
         SetHotkeySecondaryMode(g_config.hotkeys.size() - 1, targetModeId); // Init new entry
-        std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-        RebuildHotkeyMainKeys_Internal();
         g_configIsDirty = true;
     };
 
@@ -91,8 +89,6 @@ if (ImGui::BeginTabItem("General")) {
                                               [&](const HotkeyConfig& h) { return EqualsIgnoreCase(h.secondaryMode, modeId); }),
                                g_config.hotkeys.end());
         ResetAllHotkeySecondaryModes(); // Sync secondary mode state after hotkey removal
-        std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-        RebuildHotkeyMainKeys_Internal();
         g_configIsDirty = true;
 
         // If this was the default mode, reset default to Fullscreen
@@ -371,8 +367,6 @@ if (ImGui::BeginTabItem("General")) {
                 ninjabrainBot.colorKeySensitivity = 0.05f;
                 ninjabrainBot.background = { true, { 0.0f, 0.0f, 0.0f }, 0.5f };
                 g_config.images.push_back(ninjabrainBot);
-                g_allImagesLoaded = false;
-                g_pendingImageLoad = true;
             }
         };
 
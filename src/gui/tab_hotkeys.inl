@@ -406,9 +406,6 @@ if (IsResolutionChangeSupported(g_gameVersion)) {
         if (hotkey_to_remove != -1) {
             g_config.hotkeys.erase(g_config.hotkeys.begin() + hotkey_to_remove);
             ResetAllHotkeySecondaryModes(); // Sync secondary mode state after removal
-            // DEADLOCK FIX: Use internal version since g_configMutex is already held
-            std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-            RebuildHotkeyMainKeys_Internal();
         }
         ImGui::Separator();
         if (ImGui::Button("Add New Hotkey")) {
@@ -423,8 +420,6 @@ if (IsResolutionChangeSupported(g_gameVersion)) {
                 g_config.hotkeys.push_back(std::move(newHotkey));        // Use move semantics
                 ResizeHotkeySecondaryModes(g_config.hotkeys.size());     // Sync runtime state
                 SetHotkeySecondaryMode(g_config.hotkeys.size() - 1, ""); // Init new entry
-                std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                RebuildHotkeyMainKeys_Internal();
                 g_configIsDirty = true;
             } catch (const std::exception& e) { Log(std::string("ERROR: Failed to add new hotkey: ") + e.what()); }
         }
@@ -440,9 +435,6 @@ if (IsResolutionChangeSupported(g_gameVersion)) {
             if (ImGui::Button("Confirm Reset", ImVec2(120, 0))) {
                 g_config.hotkeys = GetDefaultHotkeys();
                 ResetAllHotkeySecondaryModes(); // Sync secondary mode state after reset
-                // DEADLOCK FIX: Use internal version since g_configMutex is already held
-                std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                RebuildHotkeyMainKeys_Internal();
                 g_configIsDirty = true;
                 ImGui::CloseCurrentPopup();
             }
@@ -635,8 +627,6 @@ if (IsResolutionChangeSupported(g_gameVersion)) {
 
         if (sens_hotkey_to_remove != -1) {
             g_config.sensitivityHotkeys.erase(g_config.sensitivityHotkeys.begin() + sens_hotkey_to_remove);
-            std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-            RebuildHotkeyMainKeys_Internal();
         }
 
         if (ImGui::Button("Add Sensitivity Hotkey")) {
@@ -649,8 +639,6 @@ if (IsResolutionChangeSupported(g_gameVersion)) {
                 newSensHotkey.sensitivityY = 1.0f;
                 newSensHotkey.debounce = 100;
                 g_config.sensitivityHotkeys.push_back(std::move(newSensHotkey));
-                std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                RebuildHotkeyMainKeys_Internal();
                 g_configIsDirty = true;
             } catch (const std::exception& e) { Log(std::string("ERROR: Failed to add sensitivity hotkey: ") + e.what()); }
         }
@@ -97,7 +97,6 @@
                         img.path = result.path;
                         ClearImageError(imgErrorKey);
                         g_configIsDirty = true;
-                        LoadImageAsync(DecodedImageData::UserImage, img.name, img.path, g_toolscreenPath);
                     } else if (!result.error.empty()) {
                         SetImageError(imgErrorKey, result.error);
                     }
@@ -282,8 +282,6 @@ if (ImGui::BeginTabItem("Inputs")) {
             // Master toggle
             if (ImGui::Checkbox("Enable Key Rebinding", &g_config.keyRebinds.enabled)) {
                 g_configIsDirty = true;
-                std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                RebuildHotkeyMainKeys_Internal();
             }
             ImGui::SameLine();
             HelpMarker("When enabled, configured key rebinds will intercept keyboard input and send the remapped key to the game instead.");
@@ -356,8 +354,6 @@ if (ImGui::BeginTabItem("Inputs")) {
                                 if (s_rebindFromKeyToBind != -1 && s_rebindFromKeyToBind < (int)g_config.keyRebinds.rebinds.size()) {
                                     g_config.keyRebinds.rebinds[s_rebindFromKeyToBind].fromKey = capturedVk;
                                     g_configIsDirty = true;
-                                    std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                                    RebuildHotkeyMainKeys_Internal();
                                     (void)capturedLParam;
                                     (void)capturedIsMouse;
                                 }
@@ -483,8 +479,6 @@ if (ImGui::BeginTabItem("Inputs")) {
                     // Enable checkbox
                     if (ImGui::Checkbox("##enabled", &rebind.enabled)) {
                         g_configIsDirty = true;
-                        std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                        RebuildHotkeyMainKeys_Internal();
                     }
                     ImGui::SameLine();
 
@@ -564,16 +558,12 @@ if (ImGui::BeginTabItem("Inputs")) {
                 if (rebind_to_remove >= 0 && rebind_to_remove < (int)g_config.keyRebinds.rebinds.size()) {
                     g_config.keyRebinds.rebinds.erase(g_config.keyRebinds.rebinds.begin() + rebind_to_remove);
                     g_configIsDirty = true;
-                    std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                    RebuildHotkeyMainKeys_Internal();
                 }
 
                 ImGui::Spacing();
                 if (ImGui::Button("Add Rebind")) {
                     g_config.keyRebinds.rebinds.push_back(KeyRebind{});
                     g_configIsDirty = true;
-                    std::lock_guard<std::mutex> hotkeyLock(g_hotkeyMainKeysMutex);
-                    RebuildHotkeyMainKeys_Internal();
                 }
             }
 
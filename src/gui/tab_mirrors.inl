@@ -378,7 +378,7 @@ if (ImGui::BeginTabItem("Mirrors")) {
             ImGui::Separator();
 
             // Target Colors section - multiple colors can be matched
-            ImGui::Text("Target Colors (max 8)");
+            ImGui::Text("Target Colors");
             int target_color_to_remove = -1;
             for (size_t j = 0; j < mirror.colors.targetColors.size(); ++j) {
                 ImGui::PushID(static_cast<int>(j));
@@ -427,19 +427,17 @@ if (ImGui::BeginTabItem("Mirrors")) {
                 if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
             }
 
-            // Add new target color button (max 8)
-            if (mirror.colors.targetColors.size() < 8) {
-                if (ImGui::Button("+ Add Target Color")) {
-                    // Add a new default color (green)
-                    Color newColor = { 0.0f, 1.0f, 0.0f };
-                    mirror.colors.targetColors.push_back(newColor);
-                    g_configIsDirty = true;
-                    UpdateMirrorCaptureSettings(mirror.name, mirror.captureWidth, mirror.captureHeight, mirror.border, mirror.colors,
-                                                mirror.colorSensitivity, mirror.rawOutput, mirror.colorPassthrough);
-                    std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
-                    auto it = g_mirrorInstances.find(mirror.name);
-                    if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
-                }
+            // Add new target color button
+            if (ImGui::Button("+ Add Target Color")) {
+                // Add a new default color (green)
+                Color newColor = { 0.0f, 1.0f, 0.0f };
+                mirror.colors.targetColors.push_back(newColor);
+                g_configIsDirty = true;
+                UpdateMirrorCaptureSettings(mirror.name, mirror.captureWidth, mirror.captureHeight, mirror.border, mirror.colors,
+                                            mirror.colorSensitivity, mirror.rawOutput, mirror.colorPassthrough);
+                std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+                auto it = g_mirrorInstances.find(mirror.name);
+                if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
             }
 
             if (ImGui::SliderFloat("Color Sensitivity", &mirror.colorSensitivity, 0.001f, 1.0f)) {
@@ -521,6 +519,14 @@ if (ImGui::BeginTabItem("Mirrors")) {
                     it->second.hasValidContent = false;
                 }
             }
+            if (ImGui::Checkbox("Content Statistics", &mirror.contentStats)) {
+                g_configIsDirty = true;
+                UpdateMirrorContentStats(mirror.name, mirror.contentStats);
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Count matching pixels exactly (total, per target color, bounding box, centroid)\n"
+                                  "and write them to mirrorstats.txt in the toolscreen folder");
+            }
             // Mirrors: "Only on my screen" is intentionally disabled.
             // The config value is forced to false at load/save time for mirrors.
             ImGui::Separator();
@@ -750,8 +756,6 @@ if (ImGui::BeginTabItem("Mirrors")) {
         newMirror.input.push_back(newZone);
         g_config.mirrors.push_back(newMirror);
         g_configIsDirty = true;
-        // Create GPU resources immediately so the mirror renders without requiring a restart
-        CreateMirrorGPUResources(newMirror);
     }
 
     ImGui::SameLine();
@@ -803,11 +807,6 @@ if (ImGui::BeginTabItem("Mirrors")) {
             selectedMirrorName.clear();
             selectedGroupName.clear();
 
-            // Ensure GPU resources exist for any restored default mirrors
-            for (const auto& mirror : g_config.mirrors) {
-                CreateMirrorGPUResources(mirror);
-            }
-
             g_configIsDirty = true;
             ImGui::CloseCurrentPopup();
         }
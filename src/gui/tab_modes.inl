@@ -568,12 +568,6 @@
                         if (mode.background.selectedMode != "image") {
                             mode.background.selectedMode = "image";
                             g_configIsDirty = true;
-                            // Load existing background image if path is set
-                            if (!mode.background.image.empty()) {
-                                g_allImagesLoaded = false;
-                                g_pendingImageLoad = true;
-                                LoadImageAsync(DecodedImageData::Type::Background, mode.id, mode.background.image, g_toolscreenPath);
-                            }
                         }
                     }
 
@@ -660,8 +654,6 @@
                         if (ImGui::InputText("Path", &mode.background.image)) {
                             ClearImageError("eyezoom_bg");
                             g_configIsDirty = true;
-                            g_allImagesLoaded = false;
-                            g_pendingImageLoad = true;
                         }
                         ImGui::SameLine();
                         if (ImGui::Button("Browse...##eyezoom_bg")) {
@@ -673,8 +665,6 @@
                                 if (result.success) {
                                     mode.background.image = result.path;
                                     ClearImageError("eyezoom_bg");
-                                    g_allImagesLoaded = false;
-                                    g_pendingImageLoad = true;
                                     g_configIsDirty = true;
                                 } else if (!result.error.empty()) {
                                     SetImageError("eyezoom_bg", result.error);
@@ -1008,12 +998,6 @@
                         if (mode.background.selectedMode != "image") {
                             mode.background.selectedMode = "image";
                             g_configIsDirty = true;
-                            // Load existing background image if path is set
-                            if (!mode.background.image.empty()) {
-                                g_allImagesLoaded = false;
-                                g_pendingImageLoad = true;
-                                LoadImageAsync(DecodedImageData::Type::Background, mode.id, mode.background.image, g_toolscreenPath);
-                            }
                         }
                     }
 
@@ -1094,8 +1078,6 @@
                         if (ImGui::InputText("Path##preemptive_bg", &mode.background.image)) {
                             ClearImageError("preemptive_bg");
                             g_configIsDirty = true;
-                            g_allImagesLoaded = false;
-                            g_pendingImageLoad = true;
                         }
                         ImGui::SameLine();
                         if (ImGui::Button("Browse...##preemptive_bg")) {
@@ -1107,8 +1089,6 @@
                                 if (result.success) {
                                     mode.background.image = result.path;
                                     ClearImageError("preemptive_bg");
-                                    g_allImagesLoaded = false;
-                                    g_pendingImageLoad = true;
                                     g_configIsDirty = true;
                                 } else if (!result.error.empty()) {
                                     SetImageError("preemptive_bg", result.error);
@@ -1424,12 +1404,6 @@
                         if (mode.background.selectedMode != "image") {
                             mode.background.selectedMode = "image";
                             g_configIsDirty = true;
-                            // Load existing background image if path is set
-                            if (!mode.background.image.empty()) {
-                                g_allImagesLoaded = false;
-                                g_pendingImageLoad = true;
-                                LoadImageAsync(DecodedImageData::Type::Background, mode.id, mode.background.image, g_toolscreenPath);
-                            }
                         }
                     }
                     if (mode.background.selectedMode == "color") {
@@ -1502,8 +1476,6 @@
                         if (ImGui::InputText("Path##Thin", &mode.background.image)) {
                             ClearImageError(thinErrorKey);
                             g_configIsDirty = true;
-                            g_allImagesLoaded = false;
-                            g_pendingImageLoad = true;
                         }
                         ImGui::SameLine();
                         if (ImGui::Button("Browse...##thin_bg")) {
@@ -1513,8 +1485,6 @@
                                 if (result.success) {
                                     mode.background.image = result.path;
                                     ClearImageError(thinErrorKey);
-                                    g_allImagesLoaded = false;
-                                    g_pendingImageLoad = true;
                                     g_configIsDirty = true;
                                 } else if (!result.error.empty()) {
                                     SetImageError(thinErrorKey, result.error);
@@ -1799,12 +1769,6 @@
                         if (mode.background.selectedMode != "image") {
                             mode.background.selectedMode = "image";
                             g_configIsDirty = true;
-                            // Load existing background image if path is set
-                            if (!mode.background.image.empty()) {
-                                g_allImagesLoaded = false;
-                                g_pendingImageLoad = true;
-                                LoadImageAsync(DecodedImageData::Type::Background, mode.id, mode.background.image, g_toolscreenPath);
-                            }
                         }
                     }
                     if (mode.background.selectedMode == "color") {
@@ -1877,8 +1841,6 @@
                         if (ImGui::InputText("Path##Wide", &mode.background.image)) {
                             ClearImageError(wideErrorKey);
                             g_configIsDirty = true;
-                            g_allImagesLoaded = false;
-                            g_pendingImageLoad = true;
                         }
                         ImGui::SameLine();
                         if (ImGui::Button("Browse...##wide_bg")) {
@@ -1888,8 +1850,6 @@
                                 if (result.success) {
                                     mode.background.image = result.path;
                                     ClearImageError(wideErrorKey);
-                                    g_allImagesLoaded = false;
-                                    g_pendingImageLoad = true;
                                     g_configIsDirty = true;
                                 } else if (!result.error.empty()) {
                                     SetImageError(wideErrorKey, result.error);
@@ -2267,12 +2227,6 @@
                         if (mode.background.selectedMode != "image") {
                             mode.background.selectedMode = "image";
                             g_configIsDirty = true;
-                            // Load existing background image if path is set
-                            if (!mode.background.image.empty()) {
-                                g_allImagesLoaded = false;
-                                g_pendingImageLoad = true;
-                                LoadImageAsync(DecodedImageData::Type::Background, mode.id, mode.background.image, g_toolscreenPath);
-                            }
                         }
                     }
 
@@ -2347,8 +2301,6 @@
                         if (ImGui::InputText("Path", &mode.background.image)) {
                             ClearImageError(modeErrorKey);
                             g_configIsDirty = true;
-                            g_allImagesLoaded = false;
-                            g_pendingImageLoad = true;
                         }
                         ImGui::SameLine();
                         if (ImGui::Button(("Browse...##mode_bg_" + mode.id).c_str())) {
@@ -2360,8 +2312,6 @@
                                 if (result.success) {
                                     mode.background.image = result.path;
                                     ClearImageError(modeErrorKey);
-                                    g_allImagesLoaded = false;
-                                    g_pendingImageLoad = true;
                                     g_configIsDirty = true;
                                 } else if (!result.error.empty()) {
                                     SetImageError(modeErrorKey, result.error);
@@ -2526,22 +2476,16 @@
                 // --- EXPRESSIONS SECTION ---
                 if (ImGui::TreeNode("Expressions")) {
                     ImGui::TextWrapped("Use expressions for dynamic dimensions based on screen size.");
-                    ImGui::TextDisabled("Variables: screenWidth, screenHeight");
-                    ImGui::TextDisabled("Functions: min(), max(), floor(), ceil(), round(), abs()");
+                    ImGui::TextDisabled("Variables: screenWidth, screenHeight, <Mode>.width, <Mode>.height");
+                    ImGui::TextDisabled("Functions: min(), max(), floor(), ceil(), round(), abs(), roundEven()");
                     ImGui::Separator();
 
-                    int screenW = GetCachedScreenWidth();
-                    int screenH = GetCachedScreenHeight();
-
                     // Mode Width Expression
                     ImGui::Text("Mode Width:");
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##ModeWidthExpr", &mode.widthExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.widthExpr.empty()) {
-                            int val = EvaluateExpression(mode.widthExpr, screenW, screenH, mode.width);
-                            if (val > 0) mode.width = val;
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.widthExpr.empty()) {
                         std::string err;
@@ -2560,10 +2504,7 @@
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##ModeHeightExpr", &mode.heightExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.heightExpr.empty()) {
-                            int val = EvaluateExpression(mode.heightExpr, screenW, screenH, mode.height);
-                            if (val > 0) mode.height = val;
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.heightExpr.empty()) {
                         std::string err;
@@ -2585,10 +2526,7 @@
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##StretchWidthExpr", &mode.stretch.widthExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.stretch.widthExpr.empty()) {
-                            int val = EvaluateExpression(mode.stretch.widthExpr, screenW, screenH, mode.stretch.width);
-                            if (val >= 0) mode.stretch.width = val;
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.stretch.widthExpr.empty()) {
                         std::string err;
@@ -2607,10 +2545,7 @@
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##StretchHeightExpr", &mode.stretch.heightExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.stretch.heightExpr.empty()) {
-                            int val = EvaluateExpression(mode.stretch.heightExpr, screenW, screenH, mode.stretch.height);
-                            if (val >= 0) mode.stretch.height = val;
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.stretch.heightExpr.empty()) {
                         std::string err;
@@ -2629,9 +2564,7 @@
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##StretchXExpr", &mode.stretch.xExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.stretch.xExpr.empty()) {
-                            mode.stretch.x = EvaluateExpression(mode.stretch.xExpr, screenW, screenH, mode.stretch.x);
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.stretch.xExpr.empty()) {
                         std::string err;
@@ -2650,9 +2583,7 @@
                     ImGui::SetNextItemWidth(250);
                     if (ImGui::InputText("##StretchYExpr", &mode.stretch.yExpr)) {
                         g_configIsDirty = true;
-                        if (!mode.stretch.yExpr.empty()) {
-                            mode.stretch.y = EvaluateExpression(mode.stretch.yExpr, screenW, screenH, mode.stretch.y);
-                        }
+                        RecalculateExpressionDimensions();
                     }
                     if (!mode.stretch.yExpr.empty()) {
                         std::string err;
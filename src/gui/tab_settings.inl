@@ -155,11 +155,77 @@ if (ImGui::BeginTabItem("Settings")) {
                    "May help with capture timing issues while having less performance impact.");
         ImGui::Spacing();
         if (ImGui::Checkbox("Show Performance Overlay", &g_config.debug.showPerformanceOverlay)) { g_configIsDirty = true; }
+        ImGui::SameLine();
+        HelpMarker("Frame timings plus drop, overflow and fallback counters (log lines, input events, capture\n"
+                   "notifications, render requests, virtual camera frames) since the game started.");
+        if (ImGui::Button("Dump Metrics")) {
+            std::filesystem::path path;
+            if (DumpMetricsToFile(path)) {
+                Log("[Metrics] Written to " + path.string());
+            } else {
+                Log("[Metrics] Failed to write " + path.string());
+            }
+        }
+        ImGui::SameLine();
+        HelpMarker("Writes all counters to traces\\metrics-<date>-<time>.txt in the Toolscreen folder.");
         if (ImGui::Checkbox("Show Profiler", &g_config.debug.showProfiler)) { g_configIsDirty = true; }
         ImGui::SetNextItemWidth(300);
         if (ImGui::SliderFloat("Profiler Scale", &g_config.debug.profilerScale, 0.25f, 2.0f, "%.2f")) { g_configIsDirty = true; }
         ImGui::SameLine();
         HelpMarker("Scale of the profiler overlay\n25% = tiny, 50% = half size, 100% = normal, 200% = double size");
+        if (ImGui::Checkbox("Show Latency Percentiles", &g_config.debug.profilerShowPercentiles)) { g_configIsDirty = true; }
+        ImGui::SameLine();
+        HelpMarker("Adds p50/p90/p99/p99.9 of single calls (since the last reset) and the number of calls\n"
+                   "slower than the two thresholds below to the profiler overlay.");
+        ImGui::SetNextItemWidth(145);
+        if (ImGui::SliderFloat("##profilerThreshold1", &g_config.debug.profilerThreshold1Ms, 0.0f, 100.0f, "%.1f ms")) {
+            g_configIsDirty = true;
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(145);
+        if (ImGui::SliderFloat("Latency Thresholds", &g_config.debug.profilerThreshold2Ms, 0.0f, 100.0f, "%.1f ms")) {
+            g_configIsDirty = true;
+        }
+        if (ImGui::Button("Reset Latency Histograms")) { Profiler::GetInstance().RequestHistogramReset(); }
+        ImGui::SameLine();
+        if (ImGui::Button("Export Histograms (CSV)")) { Profiler::GetInstance().RequestHistogramExport(); }
+        ImGui::SameLine();
+        HelpMarker("Writes per-scope percentiles to traces\\histograms-<date>-<time>.csv in the Toolscreen folder.\n"
+                   "Needs the profiler (or the flight recorder) enabled.");
+        if (ImGui::Checkbox("Flight Recorder", &g_config.debug.flightRecorderEnabled)) { g_configIsDirty = true; }
+        ImGui::SameLine();
+        HelpMarker("Keeps the last few seconds of profiler scopes from every thread and writes them to\n"
+                   "traces\\trace-<date>-<time>.json in the Toolscreen folder when a frame is slower than\n"
+                   "the hitch threshold, or when the dump hotkey is pressed.\n\n"
+                   "Open the file in ui.perfetto.dev or chrome://tracing.");
+        if (g_config.debug.flightRecorderEnabled) {
+            ImGui::Indent();
+            ImGui::SetNextItemWidth(300);
+            if (ImGui::SliderInt("History (seconds)", &g_config.debug.flightRecorderSeconds, 1, 60)) { g_configIsDirty = true; }
+            ImGui::SetNextItemWidth(300);
+            if (ImGui::SliderFloat("Hitch Threshold", &g_config.debug.flightRecorderHitchMs, 0.0f, 500.0f, "%.0f ms")) {
+                g_configIsDirty = true;
+            }
+            ImGui::SameLine();
+            HelpMarker("Frames slower than this dump a trace automatically (at most once per history window).\n0 = hotkey only.");
+
+            ImGui::PushID("trace_dump_hotkey");
+            std::string traceKeyStr = GetKeyComboString(g_config.debug.flightRecorderHotkey);
+            ImGui::Text("Dump Hotkey:");
+            ImGui::SameLine();
+            const bool isBindingTrace = (s_mainHotkeyToBind == -995);
+            const char* traceBtnLabel = isBindingTrace ? "[Press Keys...]" : (traceKeyStr.empty() ? "[Click to Bind]" : traceKeyStr.c_str());
+            if (ImGui::Button(traceBtnLabel, ImVec2(150, 0))) {
+                s_mainHotkeyToBind = -995;
+                s_altHotkeyToBind = { -1, -1 };
+                s_exclusionToBind = { -1, -1 };
+                MarkHotkeyBindingActive();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Dump Now")) { Profiler::GetInstance().RequestTraceDump(); }
+            ImGui::PopID();
+            ImGui::Unindent();
+        }
         if (ImGui::Checkbox("Show Hotkey Debug", &g_config.debug.showHotkeyDebug)) { g_configIsDirty = true; }
         if (ImGui::Checkbox("Fake Cursor Overlay", &g_config.debug.fakeCursor)) { g_configIsDirty = true; }
         ImGui::SameLine();
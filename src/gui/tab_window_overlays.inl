@@ -120,8 +120,6 @@ if (ImGui::BeginTabItem("Window Overlays")) {
                                 overlay.windowClass = windowInfo.className;
                                 overlay.executableName = windowInfo.executableName;
                                 g_configIsDirty = true;
-                                // Queue deferred reload to avoid blocking GUI thread
-                                QueueOverlayReload(overlay.name, overlay);
                             }
                         }
                         ImGui::PopStyleColor();
@@ -156,8 +154,6 @@ if (ImGui::BeginTabItem("Window Overlays")) {
             if (ImGui::Combo("##MatchPriority", &currentPriorityIdx, priorityOptions, 2)) {
                 overlay.windowMatchPriority = priorityValues[currentPriorityIdx];
                 g_configIsDirty = true;
-                // Queue deferred reload to avoid blocking GUI thread
-                QueueOverlayReload(overlay.name, overlay);
             }
             ImGui::PopItemWidth();
             ImGui::SeparatorText("Rendering");
@@ -269,8 +265,6 @@ if (ImGui::BeginTabItem("Window Overlays")) {
             if (ImGui::Combo("##captureMethod", &currentMethodIdx, captureMethods, 2)) {
                 overlay.captureMethod = captureMethods[currentMethodIdx];
                 g_configIsDirty = true;
-                // Queue deferred reload to avoid blocking GUI thread
-                QueueOverlayReload(overlay.name, overlay);
             }
             ImGui::PopItemWidth();
             if (ImGui::IsItemHovered()) {
@@ -370,7 +364,6 @@ if (ImGui::BeginTabItem("Window Overlays")) {
 
     if (windowOverlay_to_remove >= 0) {
         std::string deletedOverlayName = g_config.windowOverlays[windowOverlay_to_remove].name;
-        RemoveWindowOverlayFromCache(deletedOverlayName);
         g_config.windowOverlays.erase(g_config.windowOverlays.begin() + windowOverlay_to_remove);
         // Remove deleted window overlay from all modes
         for (auto& mode : g_config.modes) {
@@ -414,8 +407,6 @@ if (ImGui::BeginTabItem("Window Overlays")) {
         ImGui::Text("This action cannot be undone.");
         ImGui::Separator();
         if (ImGui::Button("Confirm Reset", ImVec2(120, 0))) {
-            // Clear window overlay cache before resetting
-            for (const auto& overlay : g_config.windowOverlays) { RemoveWindowOverlayFromCache(overlay.name); }
             g_config.windowOverlays = GetDefaultWindowOverlays();
             g_configIsDirty = true;
             ImGui::CloseCurrentPopup();
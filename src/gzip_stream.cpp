@@ -0,0 +1,596 @@
+// ============================================================================
+// GZIP_STREAM.CPP - LZ77 hash-chain matcher, Huffman block writer, gzip framing
+// ============================================================================
+
+#include "gzip_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+constexpr int32_t WINDOW_SIZE = 32768;
+constexpr int32_t WINDOW_MASK = WINDOW_SIZE - 1;
+constexpr int32_t MIN_MATCH = 3;
+constexpr int32_t MAX_MATCH = 258;
+// Bytes kept ahead of m_strStart while more input may follow, so a match never runs into unread data
+constexpr int32_t MIN_LOOKAHEAD = MAX_MATCH + MIN_MATCH + 1;
+constexpr int32_t MAX_DIST = WINDOW_SIZE - MIN_LOOKAHEAD;
+constexpr int HASH_BITS = 15;
+constexpr int32_t HASH_SIZE = 1 << HASH_BITS;
+constexpr int32_t NIL = -1;
+constexpr size_t TOKEN_BUFFER_SIZE = 16384;
+
+// zlib level 6
+constexpr int32_t GOOD_LENGTH = 8;  // Walk a quarter of the chain once the previous match is this long
+constexpr int32_t MAX_LAZY = 16;    // Don't look for a better match after one this long
+constexpr int32_t NICE_LENGTH = 128; // Stop walking at a match this long
+constexpr int32_t MAX_CHAIN = 128;
+constexpr int32_t TOO_FAR = 4096; // Length-3 matches further back than this cost more than three literals
+
+constexpr int LITLEN_CODES = 286;
+constexpr int DIST_CODES = 30;
+constexpr int CODELEN_CODES = 19;
+constexpr int END_OF_BLOCK = 256;
+constexpr int MAX_BITS = 15;
+constexpr int MAX_CODELEN_BITS = 7;
+
+constexpr uint8_t kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+constexpr uint16_t kLengthBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                       31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+constexpr uint8_t kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+constexpr uint16_t kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                     193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+// Order in which code length code lengths are sent
+constexpr uint8_t kCodeLenOrder[CODELEN_CODES] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+uint16_t ReverseBits(uint16_t v, int bitCount) {
+    uint16_t r = 0;
+    for (int i = 0; i < bitCount; i++) {
+        r = static_cast<uint16_t>((r << 1) | (v & 1u));
+        v >>= 1;
+    }
+    return r;
+}
+
+// Canonical codes, bit-reversed for the LSB-first bit writer
+void BuildCanonicalCodes(const uint8_t* lengths, int count, uint16_t* codes) {
+    int blCount[MAX_BITS + 1] = {};
+    for (int i = 0; i < count; i++) blCount[lengths[i]]++;
+    blCount[0] = 0;
+
+    int nextCode[MAX_BITS + 1] = {};
+    int code = 0;
+    for (int bits = 1; bits <= MAX_BITS; bits++) {
+        code = (code + blCount[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+    for (int symbol = 0; symbol < count; symbol++) {
+        const int len = lengths[symbol];
+        codes[symbol] = len ? ReverseBits(static_cast<uint16_t>(nextCode[len]++), len) : 0;
+    }
+}
+
+// Huffman code lengths for freq[0..count), limited to maxBits. Over-long trees are rebuilt from flattened frequencies,
+// which costs a fraction of a percent against package-merge and only happens on very skewed blocks. Always yields at
+// least two codes so a decoder never sees a lone zero-bit code.
+void BuildCodeLengths(const uint32_t* freq, int count, int maxBits, uint8_t* lengths) {
+    uint32_t weights[LITLEN_CODES];
+    int used = 0;
+    for (int i = 0; i < count; i++) {
+        weights[i] = freq[i];
+        if (freq[i]) used++;
+    }
+    for (int i = 0; used < 2 && i < count; i++) {
+        if (!weights[i]) {
+            weights[i] = 1;
+            used++;
+        }
+    }
+
+    // Leaves are nodes [0, leafCount), internal nodes follow in creation order, so a parent always has a higher index
+    int symbols[LITLEN_CODES];
+    uint32_t nodeWeight[2 * LITLEN_CODES];
+    int parent[2 * LITLEN_CODES];
+    uint8_t depth[2 * LITLEN_CODES];
+    for (;;) {
+        int leafCount = 0;
+        for (int i = 0; i < count; i++) {
+            if (weights[i]) symbols[leafCount++] = i;
+        }
+        std::sort(symbols, symbols + leafCount, [&](int a, int b) { return weights[a] != weights[b] ? weights[a] < weights[b] : a < b; });
+        for (int i = 0; i < leafCount; i++) nodeWeight[i] = weights[symbols[i]];
+
+        // Two-queue merge: sorted leaves and internal nodes (created in non-decreasing weight order)
+        int nextLeaf = 0, nextInternal = leafCount, nodeCount = leafCount;
+        auto takeSmallest = [&]() {
+            if (nextLeaf < leafCount && (nextInternal >= nodeCount || nodeWeight[nextLeaf] <= nodeWeight[nextInternal])) {
+                return nextLeaf++;
+            }
+            return nextInternal++;
+        };
+        while (nodeCount < 2 * leafCount - 1) {
+            const int a = takeSmallest();
+            const int b = takeSmallest();
+            nodeWeight[nodeCount] = nodeWeight[a] + nodeWeight[b];
+            parent[a] = parent[b] = nodeCount;
+            nodeCount++;
+        }
+
+        int maxDepth = 0;
+        depth[nodeCount - 1] = 0;
+        for (int i = nodeCount - 2; i >= 0; i--) {
+            depth[i] = static_cast<uint8_t>(depth[parent[i]] + 1);
+            maxDepth = (std::max)(maxDepth, static_cast<int>(depth[i]));
+        }
+        if (maxDepth <= maxBits) {
+            std::memset(lengths, 0, count);
+            for (int i = 0; i < leafCount; i++) lengths[symbols[i]] = depth[i];
+            return;
+        }
+        for (int i = 0; i < count; i++) {
+            if (weights[i]) weights[i] = (weights[i] >> 1) | 1u;
+        }
+    }
+}
+
+struct CodeTables {
+    uint8_t lengthCode[256];   // Match length - 3 -> length code - 257
+    uint8_t distCode[512];     // Distance - 1 (< 256) or 256 + ((distance - 1) >> 7) -> distance code
+    uint8_t fixedLitLenLengths[288];
+    uint16_t fixedLitLenCodes[288];
+    uint8_t fixedDistLengths[DIST_CODES];
+    uint16_t fixedDistCodes[DIST_CODES];
+
+    CodeTables() {
+        for (int code = 0; code < 29; code++) {
+            for (int i = 0; i < (1 << kLengthExtra[code]); i++) {
+                const int len = kLengthBase[code] + i - MIN_MATCH;
+                if (len < 256) lengthCode[len] = static_cast<uint8_t>(code);
+            }
+        }
+        for (int code = 0; code < DIST_CODES; code++) {
+            for (int i = 0; i < (1 << kDistExtra[code]); i++) {
+                const int d = kDistBase[code] + i - 1;
+                if (d < 256) {
+                    distCode[d] = static_cast<uint8_t>(code);
+                } else {
+                    distCode[256 + (d >> 7)] = static_cast<uint8_t>(code);
+                }
+            }
+        }
+
+        for (int i = 0; i < 288; i++) fixedLitLenLengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        BuildCanonicalCodes(fixedLitLenLengths, 288, fixedLitLenCodes);
+        std::fill(std::begin(fixedDistLengths), std::end(fixedDistLengths), static_cast<uint8_t>(5));
+        BuildCanonicalCodes(fixedDistLengths, DIST_CODES, fixedDistCodes);
+    }
+};
+
+const CodeTables& Tables() {
+    static const CodeTables s_tables;
+    return s_tables;
+}
+
+inline int DistCode(uint32_t distance) {
+    const uint32_t d = distance - 1;
+    return Tables().distCode[d < 256 ? d : 256 + (d >> 7)];
+}
+
+inline uint32_t HashAt(const uint8_t* p) {
+    const uint32_t v = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+inline int CountTrailingZeros64(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+// Length of the common prefix of a and b, starting at start, up to maxLen
+inline int32_t MatchLength(const uint8_t* a, const uint8_t* b, int32_t start, int32_t maxLen) {
+    int32_t len = start;
+    while (len + 8 <= maxLen) {
+        uint64_t va, vb;
+        std::memcpy(&va, a + len, 8);
+        std::memcpy(&vb, b + len, 8);
+        if (va != vb) return len + CountTrailingZeros64(va ^ vb) / 8;
+        len += 8;
+    }
+    while (len < maxLen && a[len] == b[len]) len++;
+    return len;
+}
+
+// Code length sequence for the dynamic block header: symbols 0-15, 16 (repeat previous 3-6x), 17 (zeros 3-10x)
+// and 18 (zeros 11-138x), each with its extra-bit value
+struct CodeLenSymbol {
+    uint8_t symbol;
+    uint8_t extra;
+};
+
+int RunLengthEncode(const uint8_t* lengths, int count, CodeLenSymbol* out) {
+    int n = 0;
+    for (int i = 0; i < count;) {
+        const uint8_t len = lengths[i];
+        int run = 1;
+        while (i + run < count && lengths[i + run] == len) run++;
+        i += run;
+
+        if (len == 0) {
+            while (run >= 11) {
+                const int r = (std::min)(run, 138);
+                out[n++] = { 18, static_cast<uint8_t>(r - 11) };
+                run -= r;
+            }
+            if (run >= 3) {
+                out[n++] = { 17, static_cast<uint8_t>(run - 3) };
+                run = 0;
+            }
+        } else {
+            out[n++] = { len, 0 };
+            run--;
+            while (run >= 3) {
+                const int r = (std::min)(run, 6);
+                out[n++] = { 16, static_cast<uint8_t>(r - 3) };
+                run -= r;
+            }
+        }
+        while (run-- > 0) out[n++] = { len, 0 };
+    }
+    return n;
+}
+
+inline int CodeLenExtraBits(int symbol) { return symbol == 16 ? 2 : symbol == 17 ? 3 : symbol == 18 ? 7 : 0; }
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// DeflateEncoder - matching
+// ----------------------------------------------------------------------------
+
+DeflateEncoder::DeflateEncoder()
+    : m_window(2 * WINDOW_SIZE), m_head(HASH_SIZE, NIL), m_prev(WINDOW_SIZE, NIL), m_tokenLitLen(TOKEN_BUFFER_SIZE),
+      m_tokenDist(TOKEN_BUFFER_SIZE) {}
+
+void DeflateEncoder::Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    if (m_finished) return;
+    m_out = &out;
+    while (size > 0) {
+        if (m_strStart >= WINDOW_SIZE + MAX_DIST) SlideWindow();
+        const size_t room = static_cast<size_t>(2 * WINDOW_SIZE - (m_strStart + m_lookahead));
+        const size_t n = (std::min)(room, size);
+        std::memcpy(m_window.data() + m_strStart + m_lookahead, data, n);
+        m_lookahead += static_cast<int32_t>(n);
+        data += n;
+        size -= n;
+        Compress(false);
+    }
+    m_out = nullptr;
+}
+
+void DeflateEncoder::Finish(std::vector<uint8_t>& out) {
+    if (m_finished) return;
+    m_out = &out;
+    Compress(true);
+    if (m_matchAvailable) {
+        TallyLiteral(m_window[m_strStart - 1]);
+        m_matchAvailable = false;
+    }
+    FlushBlock(true);
+    AlignToByte();
+    m_finished = true;
+    m_out = nullptr;
+}
+
+int32_t DeflateEncoder::InsertHash(int32_t pos) {
+    const uint32_t h = HashAt(m_window.data() + pos);
+    const int32_t head = m_head[h];
+    m_prev[pos & WINDOW_MASK] = head;
+    m_head[h] = pos;
+    return head;
+}
+
+// Walks the hash chain from curMatch for a match longer than m_prevLength; sets m_matchStart when one is found
+int32_t DeflateEncoder::LongestMatch(int32_t curMatch) {
+    const uint8_t* window = m_window.data();
+    const uint8_t* scan = window + m_strStart;
+    const int32_t maxLen = (std::min)(MAX_MATCH, m_lookahead);
+    const int32_t niceLength = (std::min)(NICE_LENGTH, maxLen);
+    const int32_t limit = m_strStart > MAX_DIST ? m_strStart - MAX_DIST : 0;
+    int32_t chainLength = m_prevLength >= GOOD_LENGTH ? MAX_CHAIN >> 2 : MAX_CHAIN;
+    int32_t bestLength = m_prevLength;
+    if (bestLength >= maxLen) return bestLength;
+
+    do {
+        const uint8_t* match = window + curMatch;
+        // Cheap rejects first: the byte that would make this match longer than the best, then the first two
+        if (match[bestLength] != scan[bestLength] || match[0] != scan[0] || match[1] != scan[1]) continue;
+
+        const int32_t len = MatchLength(match, scan, 2, maxLen);
+        if (len > bestLength) {
+            m_matchStart = curMatch;
+            bestLength = len;
+            if (len >= niceLength) break;
+        }
+    } while ((curMatch = m_prev[curMatch & WINDOW_MASK]) > limit && --chainLength != 0);
+    return bestLength;
+}
+
+// Lazy matching as in zlib's deflate_slow: a match is only taken if the match starting one byte later isn't longer.
+// Without flush, stops while fewer than MIN_LOOKAHEAD bytes are buffered.
+void DeflateEncoder::Compress(bool flush) {
+    const uint8_t* window = m_window.data();
+    for (;;) {
+        if (m_lookahead < MIN_LOOKAHEAD && (!flush || m_lookahead == 0)) return;
+
+        int32_t hashHead = NIL;
+        if (m_lookahead >= MIN_MATCH) hashHead = InsertHash(m_strStart);
+
+        m_prevLength = m_matchLength;
+        const int32_t prevMatch = m_matchStart;
+        m_matchLength = MIN_MATCH - 1;
+        if (hashHead != NIL && m_prevLength < MAX_LAZY && m_strStart - hashHead <= MAX_DIST) {
+            m_matchLength = LongestMatch(hashHead);
+            if (m_matchLength == MIN_MATCH && m_strStart - m_matchStart > TOO_FAR) m_matchLength = MIN_MATCH - 1;
+        }
+
+        if (m_prevLength >= MIN_MATCH && m_matchLength <= m_prevLength) {
+            // The previous position's match wins; it starts at m_strStart - 1
+            const int32_t maxInsert = m_strStart + m_lookahead - MIN_MATCH;
+            TallyMatch(static_cast<uint32_t>(m_strStart - 1 - prevMatch), static_cast<uint32_t>(m_prevLength));
+            m_lookahead -= m_prevLength - 1;
+            for (int32_t n = m_prevLength - 2; n > 0; n--) {
+                if (++m_strStart <= maxInsert) InsertHash(m_strStart);
+            }
+            m_matchAvailable = false;
+            m_matchLength = MIN_MATCH - 1;
+            m_strStart++;
+            if (m_tokenCount == TOKEN_BUFFER_SIZE) FlushBlock(false);
+        } else if (m_matchAvailable) {
+            // No better match here: the previous byte goes out as a literal, this one becomes pending
+            TallyLiteral(window[m_strStart - 1]);
+            if (m_tokenCount == TOKEN_BUFFER_SIZE) FlushBlock(false);
+            m_strStart++;
+            m_lookahead--;
+        } else {
+            m_matchAvailable = true;
+            m_strStart++;
+            m_lookahead--;
+        }
+    }
+}
+
+// Moves the upper half of the window down once the lower half is out of match range
+void DeflateEncoder::SlideWindow() {
+    std::memcpy(m_window.data(), m_window.data() + WINDOW_SIZE, WINDOW_SIZE);
+    m_strStart -= WINDOW_SIZE;
+    m_matchStart -= WINDOW_SIZE;
+    m_blockStart -= WINDOW_SIZE;
+    for (int32_t& pos : m_head) pos = pos >= WINDOW_SIZE ? pos - WINDOW_SIZE : NIL;
+    for (int32_t& pos : m_prev) pos = pos >= WINDOW_SIZE ? pos - WINDOW_SIZE : NIL;
+}
+
+// ----------------------------------------------------------------------------
+// DeflateEncoder - blocks
+// ----------------------------------------------------------------------------
+
+void DeflateEncoder::TallyLiteral(uint8_t literal) {
+    m_tokenLitLen[m_tokenCount] = literal;
+    m_tokenDist[m_tokenCount] = 0;
+    m_tokenCount++;
+    m_litLenFreq[literal]++;
+}
+
+void DeflateEncoder::TallyMatch(uint32_t distance, uint32_t length) {
+    m_tokenLitLen[m_tokenCount] = static_cast<uint16_t>(length);
+    m_tokenDist[m_tokenCount] = static_cast<uint16_t>(distance);
+    m_tokenCount++;
+    m_litLenFreq[257 + Tables().lengthCode[length - MIN_MATCH]]++;
+    m_distFreq[DistCode(distance)]++;
+}
+
+void DeflateEncoder::FlushBlock(bool last) {
+    const CodeTables& tables = Tables();
+    m_litLenFreq[END_OF_BLOCK] = 1;
+
+    uint8_t litLenLengths[LITLEN_CODES];
+    uint8_t distLengths[DIST_CODES];
+    BuildCodeLengths(m_litLenFreq, LITLEN_CODES, MAX_BITS, litLenLengths);
+    BuildCodeLengths(m_distFreq, DIST_CODES, MAX_BITS, distLengths);
+
+    int litLenCount = LITLEN_CODES;
+    while (litLenCount > 257 && litLenLengths[litLenCount - 1] == 0) litLenCount--;
+    int distCount = DIST_CODES;
+    while (distCount > 1 && distLengths[distCount - 1] == 0) distCount--;
+
+    // Literal/length and distance code lengths are run-length coded as one sequence
+    uint8_t allLengths[LITLEN_CODES + DIST_CODES];
+    std::memcpy(allLengths, litLenLengths, litLenCount);
+    std::memcpy(allLengths + litLenCount, distLengths, distCount);
+    CodeLenSymbol codeLenSymbols[LITLEN_CODES + DIST_CODES];
+    const int codeLenSymbolCount = RunLengthEncode(allLengths, litLenCount + distCount, codeLenSymbols);
+
+    uint32_t codeLenFreq[CODELEN_CODES] = {};
+    for (int i = 0; i < codeLenSymbolCount; i++) codeLenFreq[codeLenSymbols[i].symbol]++;
+    uint8_t codeLenLengths[CODELEN_CODES];
+    BuildCodeLengths(codeLenFreq, CODELEN_CODES, MAX_CODELEN_BITS, codeLenLengths);
+    int codeLenCount = CODELEN_CODES;
+    while (codeLenCount > 4 && codeLenLengths[kCodeLenOrder[codeLenCount - 1]] == 0) codeLenCount--;
+
+    // Exact sizes in bits of each encoding
+    uint64_t dynamicBits = 3 + 5 + 5 + 4 + 3 * static_cast<uint64_t>(codeLenCount);
+    for (int i = 0; i < codeLenSymbolCount; i++) {
+        dynamicBits += codeLenLengths[codeLenSymbols[i].symbol] + CodeLenExtraBits(codeLenSymbols[i].symbol);
+    }
+    uint64_t fixedBits = 3;
+    uint64_t extraBits = 0;
+    for (int i = 0; i < LITLEN_CODES; i++) {
+        dynamicBits += static_cast<uint64_t>(m_litLenFreq[i]) * litLenLengths[i];
+        fixedBits += static_cast<uint64_t>(m_litLenFreq[i]) * tables.fixedLitLenLengths[i];
+        if (i > END_OF_BLOCK) extraBits += static_cast<uint64_t>(m_litLenFreq[i]) * kLengthExtra[i - 257];
+    }
+    for (int i = 0; i < DIST_CODES; i++) {
+        dynamicBits += static_cast<uint64_t>(m_distFreq[i]) * distLengths[i];
+        fixedBits += static_cast<uint64_t>(m_distFreq[i]) * tables.fixedDistLengths[i];
+        extraBits += static_cast<uint64_t>(m_distFreq[i]) * kDistExtra[i];
+    }
+    dynamicBits += extraBits;
+    fixedBits += extraBits;
+
+    // Stored needs the raw bytes, which are gone once the block start slid out of the window
+    const int32_t blockLength = m_strStart - m_blockStart;
+    const bool canStore = m_blockStart >= 0;
+    const uint64_t storedBits = 8 * (static_cast<uint64_t>(blockLength) + 5 * (blockLength / 65535 + 1)) + 7;
+
+    if (canStore && storedBits < (std::min)(dynamicBits, fixedBits)) {
+        WriteStoredBlocks(m_window.data() + m_blockStart, static_cast<size_t>(blockLength), last);
+    } else if (fixedBits <= dynamicBits) {
+        PutBits(last ? 1u : 0u, 1);
+        PutBits(1, 2);
+        WriteTokens(tables.fixedLitLenLengths, tables.fixedLitLenCodes, tables.fixedDistLengths, tables.fixedDistCodes);
+    } else {
+        uint16_t litLenCodes[LITLEN_CODES];
+        uint16_t distCodes[DIST_CODES];
+        uint16_t codeLenCodes[CODELEN_CODES];
+        BuildCanonicalCodes(litLenLengths, LITLEN_CODES, litLenCodes);
+        BuildCanonicalCodes(distLengths, DIST_CODES, distCodes);
+        BuildCanonicalCodes(codeLenLengths, CODELEN_CODES, codeLenCodes);
+
+        PutBits(last ? 1u : 0u, 1);
+        PutBits(2, 2);
+        PutBits(static_cast<uint32_t>(litLenCount - 257), 5);
+        PutBits(static_cast<uint32_t>(distCount - 1), 5);
+        PutBits(static_cast<uint32_t>(codeLenCount - 4), 4);
+        for (int i = 0; i < codeLenCount; i++) PutBits(codeLenLengths[kCodeLenOrder[i]], 3);
+        for (int i = 0; i < codeLenSymbolCount; i++) {
+            const CodeLenSymbol& s = codeLenSymbols[i];
+            PutBits(codeLenCodes[s.symbol], codeLenLengths[s.symbol]);
+            if (const int extra = CodeLenExtraBits(s.symbol)) PutBits(s.extra, extra);
+        }
+        WriteTokens(litLenLengths, litLenCodes, distLengths, distCodes);
+    }
+
+    m_tokenCount = 0;
+    std::memset(m_litLenFreq, 0, sizeof(m_litLenFreq));
+    std::memset(m_distFreq, 0, sizeof(m_distFreq));
+    m_blockStart = m_strStart;
+}
+
+void DeflateEncoder::WriteTokens(const uint8_t* litLenLengths, const uint16_t* litLenCodes, const uint8_t* distLengths,
+                                 const uint16_t* distCodes) {
+    const CodeTables& tables = Tables();
+    for (size_t i = 0; i < m_tokenCount; i++) {
+        const uint32_t distance = m_tokenDist[i];
+        if (distance == 0) {
+            const uint32_t literal = m_tokenLitLen[i];
+            PutBits(litLenCodes[literal], litLenLengths[literal]);
+            continue;
+        }
+        const uint32_t length = m_tokenLitLen[i];
+        const int lengthCode = tables.lengthCode[length - MIN_MATCH];
+        PutBits(litLenCodes[257 + lengthCode], litLenLengths[257 + lengthCode]);
+        if (kLengthExtra[lengthCode]) PutBits(length - kLengthBase[lengthCode], kLengthExtra[lengthCode]);
+
+        const int distCode = DistCode(distance);
+        PutBits(distCodes[distCode], distLengths[distCode]);
+        if (kDistExtra[distCode]) PutBits(distance - kDistBase[distCode], kDistExtra[distCode]);
+    }
+    PutBits(litLenCodes[END_OF_BLOCK], litLenLengths[END_OF_BLOCK]);
+}
+
+// Stored blocks hold at most 65535 bytes each
+void DeflateEncoder::WriteStoredBlocks(const uint8_t* data, size_t size, bool last) {
+    do {
+        const size_t n = (std::min)(size, static_cast<size_t>(65535));
+        size -= n;
+        PutBits(last && size == 0 ? 1u : 0u, 1);
+        PutBits(0, 2);
+        AlignToByte();
+        PutBits(static_cast<uint32_t>(n), 16);
+        PutBits(static_cast<uint32_t>(~n & 0xFFFFu), 16);
+        AlignToByte();
+        m_out->insert(m_out->end(), data, data + n);
+        data += n;
+    } while (size > 0);
+}
+
+void DeflateEncoder::PutBits(uint32_t value, int count) {
+    m_bitBuffer |= static_cast<uint64_t>(value) << m_bitCount;
+    m_bitCount += count;
+    if (m_bitCount >= 32) {
+        const uint8_t bytes[4] = { static_cast<uint8_t>(m_bitBuffer), static_cast<uint8_t>(m_bitBuffer >> 8),
+                                   static_cast<uint8_t>(m_bitBuffer >> 16), static_cast<uint8_t>(m_bitBuffer >> 24) };
+        m_out->insert(m_out->end(), bytes, bytes + 4);
+        m_bitBuffer >>= 32;
+        m_bitCount -= 32;
+    }
+}
+
+void DeflateEncoder::AlignToByte() {
+    while (m_bitCount > 0) {
+        m_out->push_back(static_cast<uint8_t>(m_bitBuffer));
+        m_bitBuffer >>= 8;
+        m_bitCount -= 8;
+    }
+    m_bitBuffer = 0;
+    m_bitCount = 0;
+}
+
+// ----------------------------------------------------------------------------
+// GzipEncoder
+// ----------------------------------------------------------------------------
+
+void GzipEncoder::WriteHeader(std::vector<uint8_t>& out) {
+    const uint8_t header[10] = {
+        0x1F, 0x8B,             // ID1, ID2
+        0x08,                   // CM=deflate
+        0x00,                   // FLG
+        0x00, 0x00, 0x00, 0x00, // MTIME
+        0x00,                   // XFL
+        0x0B                    // OS=NTFS/Windows
+    };
+    out.insert(out.end(), header, header + sizeof(header));
+    m_headerWritten = true;
+}
+
+void GzipEncoder::Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    if (!m_headerWritten) WriteHeader(out);
+    m_crc = Crc32Update(m_crc, data, size);
+    m_inputSize += static_cast<uint32_t>(size);
+    m_deflate.Write(data, size, out);
+}
+
+void GzipEncoder::Finish(std::vector<uint8_t>& out) {
+    if (!m_headerWritten) WriteHeader(out);
+    m_deflate.Finish(out);
+    for (uint32_t v : { m_crc, m_inputSize }) {
+        const uint8_t bytes[4] = { static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v >> 16),
+                                   static_cast<uint8_t>(v >> 24) };
+        out.insert(out.end(), bytes, bytes + 4);
+    }
+}
+
+uint32_t Crc32Update(uint32_t crc, const uint8_t* data, size_t size) {
+    static const struct Crc32Table {
+        uint32_t entries[256];
+        Crc32Table() {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int j = 0; j < 8; j++) c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1);
+                entries[i] = c;
+            }
+        }
+    } s_table;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = s_table.entries[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+// ============================================================================
+// GZIP_STREAM.H - Streaming DEFLATE (RFC 1951) and gzip (RFC 1952) encoder
+// ============================================================================
+// Used to archive old logs (CompressFileToGzip in utils.cpp). Input is fed in
+// chunks of any size and compressed output is appended to a caller-owned
+// vector, so a file never has to be held in memory.
+//
+// Memory is fixed per encoder (384 KB): a 64 KB sliding window over the last
+// 32 KB of history, hash head/prev chains and a 16K-symbol token buffer.
+//
+// Matching follows zlib's level 6 strategy: 3-byte hash chains with a bounded
+// chain walk and one-step lazy evaluation. Every full token buffer becomes one
+// block, written as whichever of dynamic Huffman, fixed Huffman or stored is
+// smallest.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DeflateEncoder {
+  public:
+    DeflateEncoder();
+
+    // Compresses data. Output may lag behind input until the next block boundary or Finish().
+    void Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    // Compresses what is left and closes the stream with a final block. The encoder can't be reused afterwards.
+    void Finish(std::vector<uint8_t>& out);
+
+  private:
+    void Compress(bool flush);
+    int32_t InsertHash(int32_t pos);
+    int32_t LongestMatch(int32_t curMatch);
+    void SlideWindow();
+
+    void TallyLiteral(uint8_t literal);
+    void TallyMatch(uint32_t distance, uint32_t length);
+    void FlushBlock(bool last);
+    void WriteTokens(const uint8_t* litLenLengths, const uint16_t* litLenCodes, const uint8_t* distLengths,
+                     const uint16_t* distCodes);
+    void WriteStoredBlocks(const uint8_t* data, size_t size, bool last);
+
+    void PutBits(uint32_t value, int count);
+    void AlignToByte();
+
+    std::vector<uint8_t> m_window; // 2 * window size; data before m_strStart is history
+    std::vector<int32_t> m_head;   // Hash -> most recent window position, -1 if none
+    std::vector<int32_t> m_prev;   // Position & window mask -> previous position with the same hash
+    std::vector<uint16_t> m_tokenLitLen; // Literal byte or match length
+    std::vector<uint16_t> m_tokenDist;   // Match distance, 0 for literals
+    size_t m_tokenCount = 0;
+    uint32_t m_litLenFreq[286] = {};
+    uint32_t m_distFreq[30] = {};
+
+    int32_t m_strStart = 0;   // Next position to encode
+    int32_t m_lookahead = 0;  // Bytes buffered from m_strStart on
+    int32_t m_blockStart = 0; // Window position of the current block's first byte; negative once slid out
+    int32_t m_matchLength = 2;
+    int32_t m_matchStart = 0;
+    int32_t m_prevLength = 2;
+    bool m_matchAvailable = false; // Byte before m_strStart is still pending (lazy evaluation)
+
+    std::vector<uint8_t>* m_out = nullptr; // Valid during Write / Finish
+    uint64_t m_bitBuffer = 0;
+    int m_bitCount = 0;
+    bool m_finished = false;
+};
+
+// gzip member around a DeflateEncoder: header, CRC-32 and size trailer.
+class GzipEncoder {
+  public:
+    void Write(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+    void Finish(std::vector<uint8_t>& out);
+
+  private:
+    void WriteHeader(std::vector<uint8_t>& out);
+
+    DeflateEncoder m_deflate;
+    uint32_t m_crc = 0;
+    uint32_t m_inputSize = 0; // Modulo 2^32, as the trailer stores it
+    bool m_headerWritten = false;
+};
+
+uint32_t Crc32Update(uint32_t crc, const uint8_t* data, size_t size);
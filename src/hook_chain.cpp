@@ -306,21 +306,21 @@ static void LogHookChainDetails(const char* apiName, void* startAddress, void* r
     const char* mode =
         (g_config.hookChainingNextTarget == HookChainingNextTarget::OriginalFunction) ? "OriginalFunction" : "LatestHook";
 
-    LogCategory("hookchain",
+    LogCategory(LogCat::HookChain,
                 std::string("[") + apiName + "] chain-detect reason=" + reason + " nextTarget=" + mode + " start=" +
                     HookChain::DescribeAddressWithOwner(startAddress) + " hookTarget=" + HookChain::DescribeAddressWithOwner(resolvedHookTarget));
 
     std::vector<std::string> trace;
     (void)TraceAbsoluteJumpTarget(startAddress, trace);
     for (const auto& line : trace) {
-        LogCategory("hookchain", std::string("[") + apiName + "] " + line);
+        LogCategory(LogCat::HookChain, std::string("[") + apiName + "] " + line);
     }
 }
 
 static void LogIatHookChainDetails(const char* apiName, HMODULE importingModule, void* thunkTarget, void* expectedExport) {
     if (!apiName) apiName = "(unknown api)";
     std::string importerDesc = importingModule ? HookChain::DescribeAddressWithOwner(importingModule) : std::string("(null)");
-    LogCategory("hookchain",
+    LogCategory(LogCat::HookChain,
                 std::string("[") + apiName + "] IAT chain-detect importingModule=" + importerDesc + " iatTarget=" +
                     HookChain::DescribeAddressWithOwner(thunkTarget) + " expectedExport=" + HookChain::DescribeAddressWithOwner(expectedExport));
 }
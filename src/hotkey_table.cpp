@@ -0,0 +1,289 @@
+// ============================================================================
+// HOTKEY_TABLE.CPP - Compiled hotkey dispatch table + message-stream key state
+// ============================================================================
+
+#include "hotkey_table.h"
+
+#include "config_types.h"
+#include "key_names.h"
+
+#include <unordered_map>
+
+// ============================================================================
+// KEY STATE
+// ============================================================================
+
+void HotkeyKeyState::SetBit(DWORD vk, bool down) {
+    const uint64_t bit = 1ull << (vk & 63);
+    if (down) {
+        m_bits[vk >> 6] |= bit;
+    } else {
+        m_bits[vk >> 6] &= ~bit;
+    }
+}
+
+void HotkeyKeyState::SetDown(DWORD vk, bool down) {
+    if (vk == 0 || vk >= 256) return;
+    SetBit(vk, down);
+
+    switch (vk) {
+    // Side-specific modifiers keep the generic VK in sync (down while either side is down)
+    case VK_LCONTROL:
+    case VK_RCONTROL:
+        SetBit(VK_CONTROL, IsDown(VK_LCONTROL) || IsDown(VK_RCONTROL));
+        break;
+    case VK_LSHIFT:
+    case VK_RSHIFT:
+        SetBit(VK_SHIFT, IsDown(VK_LSHIFT) || IsDown(VK_RSHIFT));
+        break;
+    case VK_LMENU:
+    case VK_RMENU:
+        SetBit(VK_MENU, IsDown(VK_LMENU) || IsDown(VK_RMENU));
+        break;
+    // A generic modifier whose side couldn't be resolved: a release releases both sides
+    case VK_CONTROL:
+        if (!down) {
+            SetBit(VK_LCONTROL, false);
+            SetBit(VK_RCONTROL, false);
+        }
+        break;
+    case VK_SHIFT:
+        if (!down) {
+            SetBit(VK_LSHIFT, false);
+            SetBit(VK_RSHIFT, false);
+        }
+        break;
+    case VK_MENU:
+        if (!down) {
+            SetBit(VK_LMENU, false);
+            SetBit(VK_RMENU, false);
+        }
+        break;
+    default:
+        return;
+    }
+    UpdateModifiers();
+}
+
+void HotkeyKeyState::UpdateModifiers() {
+    uint8_t mods = 0;
+    if (IsDown(VK_LCONTROL)) mods |= HOTKEY_MOD_LCTRL;
+    if (IsDown(VK_RCONTROL)) mods |= HOTKEY_MOD_RCTRL;
+    if (IsDown(VK_LSHIFT)) mods |= HOTKEY_MOD_LSHIFT;
+    if (IsDown(VK_RSHIFT)) mods |= HOTKEY_MOD_RSHIFT;
+    if (IsDown(VK_LMENU)) mods |= HOTKEY_MOD_LALT;
+    if (IsDown(VK_RMENU)) mods |= HOTKEY_MOD_RALT;
+    m_modifiers = mods;
+}
+
+void HotkeyKeyState::Clear() {
+    m_bits[0] = m_bits[1] = m_bits[2] = m_bits[3] = 0;
+    m_modifiers = 0;
+}
+
+void HotkeyKeyState::Resync() {
+    Clear();
+    for (DWORD vk = 1; vk < 256; vk++) {
+        if (GetAsyncKeyState(static_cast<int>(vk)) & 0x8000) { SetBit(vk, true); }
+    }
+    UpdateModifiers();
+}
+
+void HotkeyKeyState::ResyncMouseButtons() {
+    static constexpr DWORD kMouseButtons[] = { VK_LBUTTON, VK_RBUTTON, VK_MBUTTON, VK_XBUTTON1, VK_XBUTTON2 };
+    for (DWORD vk : kMouseButtons) {
+        if (!IsDown(vk)) continue; // Nothing held (the common case) costs no call at all
+
+        // GetAsyncKeyState reads physical buttons; the message stream reports logical ones
+        const bool swapped = GetSystemMetrics(SM_SWAPBUTTON) != 0;
+        DWORD physical = vk;
+        if (swapped && vk == VK_LBUTTON) physical = VK_RBUTTON;
+        if (swapped && vk == VK_RBUTTON) physical = VK_LBUTTON;
+        if ((GetAsyncKeyState(static_cast<int>(physical)) & 0x8000) == 0) SetBit(vk, false);
+    }
+}
+
+// ============================================================================
+// DISPATCH TABLE
+// ============================================================================
+
+const CompiledHotkeyBinding* HotkeyDispatchTable::FindRebind(Bucket bucket) const {
+    for (uint32_t i = 0; i < bucket.count; i++) {
+        const CompiledHotkeyBinding& binding = m_bindings[bucket.indices[i]];
+        if (binding.action == HotkeyAction::KeyRebind) return &binding;
+    }
+    return nullptr;
+}
+
+bool HotkeyDispatchTable::Matches(const CompiledHotkeyBinding& binding, DWORD vk, const HotkeyKeyState& keys) {
+    // Release triggers skip state checks: modifiers may have been released before or with the main key
+    if (binding.triggerOnRelease) return true;
+
+    for (DWORD excluded : binding.exclusions) {
+        if (keys.IsDown(excluded)) return false;
+    }
+
+    // Generic VK delivered for a side-specific main key (side unresolved): require that side to be down
+    if (vk != binding.mainKey && (vk == VK_CONTROL || vk == VK_SHIFT || vk == VK_MENU) && !keys.IsDown(binding.mainKey)) return false;
+
+    if ((keys.Modifiers() & binding.requiredModifiers) != binding.requiredModifiers) return false;
+    if ((binding.requiredAnyModifiers & HOTKEY_MOD_CTRL_ANY) && !keys.IsDown(VK_CONTROL)) return false;
+    if ((binding.requiredAnyModifiers & HOTKEY_MOD_SHIFT_ANY) && !keys.IsDown(VK_SHIFT)) return false;
+    if ((binding.requiredAnyModifiers & HOTKEY_MOD_ALT_ANY) && !keys.IsDown(VK_MENU)) return false;
+
+    for (DWORD required : binding.requiredKeys) {
+        if (!keys.IsDown(required)) return false;
+    }
+    return true;
+}
+
+bool HotkeyDispatchTable::TryConsumeDebounce(uint32_t index, int64_t nowMs) const {
+    std::atomic<int64_t>& lastFire = m_lastFireMs[index];
+    int64_t last = lastFire.load(std::memory_order_relaxed);
+    if (last != 0 && nowMs - last < m_bindings[index].debounceMs) return false;
+    // Racing triggers of the same binding: only one wins
+    return lastFire.compare_exchange_strong(last, nowMs, std::memory_order_relaxed);
+}
+
+namespace {
+
+CompiledHotkeyBinding CompileBinding(HotkeyAction action, const std::vector<DWORD>& keys, const std::vector<DWORD>& exclusions,
+                                     bool triggerOnRelease, int debounceMs) {
+    CompiledHotkeyBinding binding;
+    binding.action = action;
+    binding.mainKey = keys.back();
+    binding.triggerOnRelease = triggerOnRelease;
+    binding.debounceMs = debounceMs;
+    binding.exclusions = exclusions;
+    binding.id = GetKeyComboString(keys);
+
+    // Keys before the last one are required modifiers / held keys
+    for (size_t i = 0; i + 1 < keys.size(); i++) {
+        switch (keys[i]) {
+        case VK_LCONTROL: binding.requiredModifiers |= HOTKEY_MOD_LCTRL; break;
+        case VK_RCONTROL: binding.requiredModifiers |= HOTKEY_MOD_RCTRL; break;
+        case VK_CONTROL: binding.requiredAnyModifiers |= HOTKEY_MOD_CTRL_ANY; break;
+        case VK_LSHIFT: binding.requiredModifiers |= HOTKEY_MOD_LSHIFT; break;
+        case VK_RSHIFT: binding.requiredModifiers |= HOTKEY_MOD_RSHIFT; break;
+        case VK_SHIFT: binding.requiredAnyModifiers |= HOTKEY_MOD_SHIFT_ANY; break;
+        case VK_LMENU: binding.requiredModifiers |= HOTKEY_MOD_LALT; break;
+        case VK_RMENU: binding.requiredModifiers |= HOTKEY_MOD_RALT; break;
+        case VK_MENU: binding.requiredAnyModifiers |= HOTKEY_MOD_ALT_ANY; break;
+        case 0: break;
+        default: binding.requiredKeys.push_back(keys[i]); break;
+        }
+    }
+    return binding;
+}
+
+// VKs a main key answers to: itself, both sides of a generic modifier, or the generic VK of a side-specific one
+int BucketKeysFor(DWORD mainKey, DWORD out[3]) {
+    int count = 0;
+    if (mainKey == 0 || mainKey >= 256) return 0;
+    out[count++] = mainKey;
+    switch (mainKey) {
+    case VK_CONTROL: out[count++] = VK_LCONTROL; out[count++] = VK_RCONTROL; break;
+    case VK_SHIFT: out[count++] = VK_LSHIFT; out[count++] = VK_RSHIFT; break;
+    case VK_MENU: out[count++] = VK_LMENU; out[count++] = VK_RMENU; break;
+    case VK_LCONTROL:
+    case VK_RCONTROL: out[count++] = VK_CONTROL; break;
+    case VK_LSHIFT:
+    case VK_RSHIFT: out[count++] = VK_SHIFT; break;
+    case VK_LMENU:
+    case VK_RMENU: out[count++] = VK_MENU; break;
+    default: break;
+    }
+    return count;
+}
+
+} // namespace
+
+std::shared_ptr<const HotkeyDispatchTable> CompileHotkeyDispatchTable(const Config& config, const HotkeyDispatchTable* previous) {
+    auto table = std::make_shared<HotkeyDispatchTable>();
+    std::vector<CompiledHotkeyBinding>& bindings = table->m_bindings;
+
+    // Order matters: handlers take the first match in a bucket, and indices stay ascending per bucket
+    auto addToggle = [&](HotkeyAction action, const std::vector<DWORD>& keys) {
+        if (keys.empty()) return;
+        bindings.push_back(CompileBinding(action, keys, {}, false, 0));
+    };
+    addToggle(HotkeyAction::GuiToggle, config.guiHotkey);
+    addToggle(HotkeyAction::BorderlessToggle, config.borderlessHotkey);
+    addToggle(HotkeyAction::ImageOverlaysToggle, config.imageOverlaysHotkey);
+    addToggle(HotkeyAction::WindowOverlaysToggle, config.windowOverlaysHotkey);
+    addToggle(HotkeyAction::TraceDump, config.debug.flightRecorderHotkey);
+
+    for (size_t i = 0; i < config.hotkeys.size(); i++) {
+        const HotkeyConfig& hotkey = config.hotkeys[i];
+        // Alt secondary modes are checked before the main combo of the same hotkey
+        for (size_t a = 0; a < hotkey.altSecondaryModes.size(); a++) {
+            const AltSecondaryMode& alt = hotkey.altSecondaryModes[a];
+            if (alt.keys.empty()) continue;
+            CompiledHotkeyBinding binding =
+                CompileBinding(HotkeyAction::ModeAlt, alt.keys, hotkey.conditions.exclusions, hotkey.triggerOnRelease, hotkey.debounce);
+            binding.ownerIndex = static_cast<uint32_t>(i);
+            binding.altIndex = static_cast<uint32_t>(a);
+            bindings.push_back(std::move(binding));
+        }
+        if (!hotkey.keys.empty()) {
+            CompiledHotkeyBinding binding =
+                CompileBinding(HotkeyAction::ModeMain, hotkey.keys, hotkey.conditions.exclusions, hotkey.triggerOnRelease, hotkey.debounce);
+            binding.ownerIndex = static_cast<uint32_t>(i);
+            bindings.push_back(std::move(binding));
+        }
+    }
+
+    for (size_t i = 0; i < config.sensitivityHotkeys.size(); i++) {
+        const SensitivityHotkeyConfig& sensHotkey = config.sensitivityHotkeys[i];
+        if (sensHotkey.keys.empty()) continue;
+        CompiledHotkeyBinding binding =
+            CompileBinding(HotkeyAction::Sensitivity, sensHotkey.keys, sensHotkey.conditions.exclusions, false, sensHotkey.debounce);
+        binding.ownerIndex = static_cast<uint32_t>(i);
+        binding.id = "sens_" + binding.id;
+        bindings.push_back(std::move(binding));
+    }
+
+    if (config.keyRebinds.enabled) {
+        for (size_t i = 0; i < config.keyRebinds.rebinds.size(); i++) {
+            const KeyRebind& rebind = config.keyRebinds.rebinds[i];
+            if (!rebind.enabled || rebind.fromKey == 0 || rebind.toKey == 0) continue;
+            // Rebinds match on the source key alone
+            CompiledHotkeyBinding binding = CompileBinding(HotkeyAction::KeyRebind, { rebind.fromKey }, {}, false, 0);
+            binding.ownerIndex = static_cast<uint32_t>(i);
+            bindings.push_back(std::move(binding));
+        }
+    }
+
+    // Bucket by VK (counting sort keeps binding indices ascending within each bucket)
+    std::array<uint32_t, 256> counts = {};
+    for (const CompiledHotkeyBinding& binding : bindings) {
+        DWORD keys[3];
+        const int n = BucketKeysFor(binding.mainKey, keys);
+        for (int k = 0; k < n; k++) { counts[keys[k]]++; }
+    }
+    table->m_bucketStart[0] = 0;
+    for (size_t vk = 0; vk < 256; vk++) { table->m_bucketStart[vk + 1] = table->m_bucketStart[vk] + counts[vk]; }
+    table->m_bucketEntries.resize(table->m_bucketStart[256]);
+    std::array<uint32_t, 256> fill = {};
+    for (uint32_t index = 0; index < bindings.size(); index++) {
+        DWORD keys[3];
+        const int n = BucketKeysFor(bindings[index].mainKey, keys);
+        for (int k = 0; k < n; k++) { table->m_bucketEntries[table->m_bucketStart[keys[k]] + fill[keys[k]]++] = index; }
+    }
+
+    // Debounce state, carried over by (action, combo)
+    table->m_lastFireMs.reset(new std::atomic<int64_t>[bindings.size()]);
+    std::unordered_map<std::string, int64_t> previousFireMs;
+    if (previous) {
+        for (size_t i = 0; i < previous->m_bindings.size(); i++) {
+            const int64_t last = previous->m_lastFireMs[i].load(std::memory_order_relaxed);
+            if (last != 0) { previousFireMs[std::to_string(static_cast<int>(previous->m_bindings[i].action)) + previous->m_bindings[i].id] = last; }
+        }
+    }
+    for (size_t i = 0; i < bindings.size(); i++) {
+        auto it = previousFireMs.find(std::to_string(static_cast<int>(bindings[i].action)) + bindings[i].id);
+        table->m_lastFireMs[i].store(it != previousFireMs.end() ? it->second : 0, std::memory_order_relaxed);
+    }
+
+    return table;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+// ============================================================================
+// HOTKEY_TABLE.H - Compiled hotkey dispatch table + message-stream key state
+// ============================================================================
+// Every key binding in the config (mode hotkeys and their alt secondary modes,
+// sensitivity hotkeys, key rebinds, GUI / borderless / overlay toggles, trace dump) is
+// compiled into one table bucketed by main virtual key. A key message costs a
+// single bucket probe; only the bindings on that key are evaluated, against a
+// required-modifier bitmask and the key state tracked from the message stream
+// (no GetAsyncKeyState per binding).
+//
+// The table is built by PublishConfigSnapshot() and travels with the snapshot
+// (Config::hotkeyTable), so bindings and the config they index never disagree.
+// Binding indices inside a bucket are ascending in config order, which keeps
+// the old "first configured binding wins" behavior.
+// ============================================================================
+
+#include <Windows.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Config;
+
+enum class HotkeyAction : uint8_t {
+    GuiToggle,
+    BorderlessToggle,
+    ImageOverlaysToggle,
+    WindowOverlaysToggle,
+    TraceDump, // Profiler flight recorder dump
+    ModeAlt,     // cfg.hotkeys[ownerIndex].altSecondaryModes[altIndex]
+    ModeMain,    // cfg.hotkeys[ownerIndex]
+    Sensitivity, // cfg.sensitivityHotkeys[ownerIndex]
+    KeyRebind,   // cfg.keyRebinds.rebinds[ownerIndex]
+};
+
+// Side-specific modifier bits
+enum HotkeyModifierBits : uint8_t {
+    HOTKEY_MOD_LCTRL = 1 << 0,
+    HOTKEY_MOD_RCTRL = 1 << 1,
+    HOTKEY_MOD_LSHIFT = 1 << 2,
+    HOTKEY_MOD_RSHIFT = 1 << 3,
+    HOTKEY_MOD_LALT = 1 << 4,
+    HOTKEY_MOD_RALT = 1 << 5,
+
+    HOTKEY_MOD_CTRL_ANY = HOTKEY_MOD_LCTRL | HOTKEY_MOD_RCTRL,
+    HOTKEY_MOD_SHIFT_ANY = HOTKEY_MOD_LSHIFT | HOTKEY_MOD_RSHIFT,
+    HOTKEY_MOD_ALT_ANY = HOTKEY_MOD_LALT | HOTKEY_MOD_RALT,
+};
+
+inline bool IsModifierVk(DWORD vk) {
+    return vk == VK_CONTROL || vk == VK_LCONTROL || vk == VK_RCONTROL || vk == VK_SHIFT || vk == VK_LSHIFT || vk == VK_RSHIFT ||
+           vk == VK_MENU || vk == VK_LMENU || vk == VK_RMENU;
+}
+
+// Pressed-key bitset fed by the window's own key/button messages. Owned by the window thread.
+class HotkeyKeyState {
+public:
+    void SetDown(DWORD vk, bool down);
+    bool IsDown(DWORD vk) const { return vk < 256 && (m_bits[vk >> 6] & (1ull << (vk & 63))) != 0; }
+    uint8_t Modifiers() const { return m_modifiers; }
+
+    void Clear();
+    // Reseeds from GetAsyncKeyState (focus gained: presses made while unfocused never reached us)
+    void Resync();
+    // Releases mouse buttons that GetAsyncKeyState reports up. A button released outside the client area without
+    // capture never sends its button-up here, so held buttons are rechecked before each lookup.
+    void ResyncMouseButtons();
+
+private:
+    void SetBit(DWORD vk, bool down);
+    void UpdateModifiers();
+
+    uint64_t m_bits[4] = {};
+    uint8_t m_modifiers = 0;
+};
+
+struct CompiledHotkeyBinding {
+    HotkeyAction action = HotkeyAction::ModeMain;
+    uint32_t ownerIndex = 0;
+    uint32_t altIndex = 0;
+
+    DWORD mainKey = 0;
+    uint8_t requiredModifiers = 0;   // Every bit must be down (side-specific modifiers)
+    uint8_t requiredAnyModifiers = 0; // For each group present (ctrl/shift/alt), either side must be down
+    bool triggerOnRelease = false;
+    int debounceMs = 0;
+
+    std::vector<DWORD> requiredKeys; // Non-modifier keys before the main key
+    std::vector<DWORD> exclusions;
+
+    std::string id; // Key combo string: debug logs and trigger-on-release tracking
+};
+
+class HotkeyDispatchTable {
+public:
+    struct Bucket {
+        const uint32_t* indices = nullptr;
+        uint32_t count = 0;
+    };
+
+    // One probe: bindings whose main key can be satisfied by this (normalized) VK
+    Bucket Probe(DWORD vk) const {
+        if (vk >= 256) return {};
+        const uint32_t begin = m_bucketStart[vk];
+        return { m_bucketEntries.data() + begin, m_bucketStart[vk + 1] - begin };
+    }
+
+    const CompiledHotkeyBinding& Binding(uint32_t index) const { return m_bindings[index]; }
+    size_t BindingCount() const { return m_bindings.size(); }
+
+    // First enabled rebind in the bucket (rebinds match on the source key alone), or nullptr
+    const CompiledHotkeyBinding* FindRebind(Bucket bucket) const;
+
+    // Modifier/exclusion/required-key check for a binding already found in the VK's bucket
+    static bool Matches(const CompiledHotkeyBinding& binding, DWORD vk, const HotkeyKeyState& keys);
+
+    // Per-binding debounce. Returns false (and leaves the timestamp alone) while debounced.
+    bool TryConsumeDebounce(uint32_t index, int64_t nowMs) const;
+
+private:
+    friend std::shared_ptr<const HotkeyDispatchTable> CompileHotkeyDispatchTable(const Config& config,
+                                                                                 const HotkeyDispatchTable* previous);
+
+    std::vector<CompiledHotkeyBinding> m_bindings;
+    std::array<uint32_t, 257> m_bucketStart = {};
+    std::vector<uint32_t> m_bucketEntries;
+    std::unique_ptr<std::atomic<int64_t>[]> m_lastFireMs; // Parallel to m_bindings
+};
+
+// Compiles every binding in config. Debounce timestamps carry over from previous for bindings with the
+// same action and key combo, so republishing the config mid-game doesn't reset them.
+std::shared_ptr<const HotkeyDispatchTable> CompileHotkeyDispatchTable(const Config& config, const HotkeyDispatchTable* previous);
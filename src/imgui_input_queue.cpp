@@ -2,7 +2,8 @@
 
 #include "imgui.h"
 
-#include <array>
+#include "metrics.h"
+#include "ring_buffer.h"
 
 #include <windowsx.h> // GET_X_LPARAM(), GET_Y_LPARAM(), GET_WHEEL_DELTA_WPARAM(), GET_XBUTTON_WPARAM()
 
@@ -74,38 +75,22 @@ struct Event {
     bool focused = false;
 };
 
-// Single-producer (WndProc thread) / single-consumer (render thread) ring buffer.
-static constexpr uint32_t kQueueSize = 2048; // Must be power-of-two? (not required with modulo but kept large)
-static std::array<Event, kQueueSize> s_queue;
-static std::atomic<uint32_t> s_write{ 0 };
-static std::atomic<uint32_t> s_read{ 0 };
+// Single producer (WndProc thread). Consumers are the render thread (drain) and the WndProc thread
+// itself when the GUI closes (ImGuiInputQueue_Clear), so the consumer side claims with CAS.
+static constexpr size_t kQueueSize = 2048; // Must be a power of two
+static LockFreeRing<Event, kQueueSize, RingProducers::Single, RingConsumers::Multi> s_queue;
 
 // Mouse capture bookkeeping on producer thread.
 static int s_mouseButtonsDownMask = 0;
 
-static bool TryPush(const Event& e) {
-    uint32_t w = s_write.load(std::memory_order_relaxed);
-    uint32_t r = s_read.load(std::memory_order_acquire);
-    uint32_t next = (w + 1) % kQueueSize;
-    if (next == r) {
-        // Queue full: drop event to avoid blocking the window thread.
-        return false;
-    }
-
-    s_queue[w] = e;
-    s_write.store(next, std::memory_order_release);
-    return true;
-}
-
-static bool TryPop(Event& out) {
-    uint32_t r = s_read.load(std::memory_order_relaxed);
-    uint32_t w = s_write.load(std::memory_order_acquire);
-    if (r == w) return false;
+static const MetricId s_metricEventsDropped =
+    RegisterMetric("gui.input_events_dropped", MetricKind::Counter, "ImGui input events lost to a full queue");
 
-    out = s_queue[r];
-    uint32_t next = (r + 1) % kQueueSize;
-    s_read.store(next, std::memory_order_release);
-    return true;
+// Queue full: drop event to avoid blocking the window thread.
+static bool TryPush(const Event& e) {
+    if (s_queue.Push(e)) return true;
+    MetricAdd(s_metricEventsDropped);
+    return false;
 }
 
 static inline int MouseButtonFromMsg(UINT msg, WPARAM wParam) {
@@ -290,9 +275,7 @@ void ImGuiInputQueue_EnqueueFocus(bool focused) {
 }
 
 void ImGuiInputQueue_Clear() {
-    // Drain by moving read to write.
-    const uint32_t w = s_write.load(std::memory_order_acquire);
-    s_read.store(w, std::memory_order_release);
+    s_queue.Clear();
 }
 
 void ImGuiInputQueue_ResetMouseCapture(HWND hWnd) {
@@ -311,8 +294,7 @@ void ImGuiInputQueue_DrainToImGui() {
 
     ImGuiIO& io = ImGui::GetIO();
 
-    Event e;
-    while (TryPop(e)) {
+    s_queue.ConsumeAll([&io](const Event& e) {
         switch (e.type) {
         case EventType::MousePos:
             ApplyMods(io, e.mods);
@@ -340,7 +322,7 @@ void ImGuiInputQueue_DrainToImGui() {
         default:
             break;
         }
-    }
+    });
 }
 
 void ImGuiInputQueue_PublishCaptureState() {
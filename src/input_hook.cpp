@@ -14,7 +14,6 @@
 #include "imgui_input_queue.h"
 
 #include <chrono>
-#include <map>
 #include <set>
 #include <windowsx.h>
 
@@ -32,8 +31,6 @@ extern Config g_config;
 
 extern std::string g_currentModeId;
 extern std::mutex g_modeIdMutex;
-extern std::string g_gameStateBuffers[2];
-extern std::atomic<int> g_currentGameStateIndex;
 extern std::string g_currentlyEditingMirror;
 
 extern std::atomic<bool> g_imageDragMode;
@@ -43,10 +40,6 @@ extern std::atomic<HCURSOR> g_specialCursorHandle;
 extern std::atomic<bool> g_gameWindowActive;
 
 // Hotkey state
-extern std::map<std::string, std::chrono::steady_clock::time_point> g_hotkeyTimestamps;
-extern std::mutex g_hotkeyTimestampsMutex;
-extern std::set<DWORD> g_hotkeyMainKeys;
-extern std::mutex g_hotkeyMainKeysMutex;
 extern std::set<std::string> g_triggerOnReleasePending;
 extern std::set<std::string> g_triggerOnReleaseInvalidated;
 extern std::mutex g_triggerOnReleaseMutex;
@@ -97,6 +90,72 @@ static DWORD NormalizeModifierVkFromKeyMessage(DWORD rawVk, LPARAM lParam) {
     return vk;
 }
 
+// Pressed keys as seen by this window's message stream (window thread only)
+static HotkeyKeyState s_keyState;
+
+// Decodes key/button messages once (VK normalization, up/down), updates s_keyState and probes the hotkey table.
+static KeyMessageInfo DecodeKeyMessage(UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    KeyMessageInfo key;
+    switch (uMsg) {
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+        key.rawVk = static_cast<DWORD>(wParam);
+        key.isKeyDown = (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN);
+        // Normalize modifier VKs to left/right variants (needed for RSHIFT/RCTRL/RALT, etc.).
+        // This mirrors imgui_impl_win32 behavior and enables reliable hotkeys + key rebinding.
+        key.vk = NormalizeModifierVkFromKeyMessage(key.rawVk, lParam);
+        if (key.vk == 0) key.vk = key.rawVk;
+        break;
+    case WM_XBUTTONDOWN:
+    case WM_XBUTTONUP:
+        // Side mouse buttons (Mouse 4/5)
+        key.rawVk = (GET_XBUTTON_WPARAM(wParam) == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
+        key.isKeyDown = (uMsg == WM_XBUTTONDOWN);
+        break;
+    case WM_LBUTTONDOWN:
+    case WM_LBUTTONUP:
+        key.rawVk = VK_LBUTTON;
+        key.isKeyDown = (uMsg == WM_LBUTTONDOWN);
+        break;
+    case WM_RBUTTONDOWN:
+    case WM_RBUTTONUP:
+        key.rawVk = VK_RBUTTON;
+        key.isKeyDown = (uMsg == WM_RBUTTONDOWN);
+        break;
+    case WM_MBUTTONDOWN:
+    case WM_MBUTTONUP:
+        key.rawVk = VK_MBUTTON;
+        key.isKeyDown = (uMsg == WM_MBUTTONDOWN);
+        break;
+    default:
+        return key;
+    }
+    key.isMouseButton = (uMsg != WM_KEYDOWN && uMsg != WM_SYSKEYDOWN && uMsg != WM_KEYUP && uMsg != WM_SYSKEYUP);
+    if (key.isMouseButton) key.vk = key.rawVk;
+
+    s_keyState.ResyncMouseButtons();
+    s_keyState.SetDown(key.vk, key.isKeyDown);
+
+    key.config = GetConfigSnapshot();
+    if (key.config && key.config->hotkeyTable) {
+        key.hotkeys = key.config->hotkeyTable.get();
+        key.bucket = key.hotkeys->Probe(key.vk);
+    }
+    return key;
+}
+
+// True if a binding for this toggle sits on the pressed key and its modifiers/exclusions are satisfied
+static bool MatchesToggleBinding(const KeyMessageInfo& key, HotkeyAction action) {
+    if (!key.hotkeys) return false;
+    for (uint32_t i = 0; i < key.bucket.count; i++) {
+        const CompiledHotkeyBinding& binding = key.hotkeys->Binding(key.bucket.indices[i]);
+        if (binding.action == action && HotkeyDispatchTable::Matches(binding, key.vk, s_keyState)) return true;
+    }
+    return false;
+}
+
 InputHandlerResult HandleMouseMoveViewportOffset(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM& lParam) {
     PROFILE_SCOPE("HandleMouseMoveViewportOffset");
 
@@ -149,7 +208,7 @@ void HandleCharLogging(UINT uMsg, WPARAM wParam, LPARAM lParam) {
     // Only log in debug mode - logging is expensive
     auto cfgSnap = GetConfigSnapshot();
     if (uMsg == WM_CHAR && cfgSnap && cfgSnap->debug.showHotkeyDebug) {
-        Log("WM_CHAR: " + std::to_string(wParam) + " " + std::to_string(lParam));
+        LOG_FMT("WM_CHAR: {} {}", wParam, lParam);
     }
 }
 
@@ -280,39 +339,15 @@ InputHandlerResult HandleImGuiInput(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
     return { false, 0 };
 }
 
-InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
     PROFILE_SCOPE("HandleGuiToggle");
 
-    DWORD vkCode = 0;
-    bool isEscape = false;
-    switch (uMsg) {
-    case WM_KEYDOWN:
-    case WM_SYSKEYDOWN: {
-        vkCode = static_cast<DWORD>(wParam);
-        isEscape = (wParam == VK_ESCAPE);
-        vkCode = NormalizeModifierVkFromKeyMessage(vkCode, lParam);
-        break;
-    }
-    case WM_LBUTTONDOWN:
-        vkCode = VK_LBUTTON;
-        break;
-    case WM_RBUTTONDOWN:
-        vkCode = VK_RBUTTON;
-        break;
-    case WM_MBUTTONDOWN:
-        vkCode = VK_MBUTTON;
-        break;
-    case WM_XBUTTONDOWN: {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        vkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        break;
-    }
-    default:
-        return { false, 0 };
-    }
+    // Presses only: key down and mouse button down
+    if (!key.rawVk || !key.isKeyDown) { return { false, 0 }; }
+    const bool isEscape = !key.isMouseButton && (wParam == VK_ESCAPE);
 
     // Escape always toggles GUI (with additional guards below). Otherwise, require the configured GUI hotkey.
-    if (!isEscape && !CheckHotkeyMatch(g_config.guiHotkey, vkCode)) { return { false, 0 }; }
+    if (!isEscape && !MatchesToggleBinding(key, HotkeyAction::GuiToggle)) { return { false, 0 }; }
 
     // If the GUI is already open, never allow a mouse-button GUI hotkey to close it.
     // Otherwise, binding the GUI hotkey to a mouse button can make the UI effectively unusable.
@@ -425,46 +460,21 @@ InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     return { true, 1 };
 }
 
-InputHandlerResult HandleBorderlessToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+InputHandlerResult HandleBorderlessToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
     PROFILE_SCOPE("HandleBorderlessToggle");
 
     // Never trigger gameplay hotkeys while the settings GUI is open.
     // These handlers run before ImGui input is processed, so consuming mouse clicks here would break the UI.
     if (g_showGui.load(std::memory_order_acquire)) { return { false, 0 }; }
 
-    // Disabled/unbound
-    if (g_config.borderlessHotkey.empty()) { return { false, 0 }; }
+    // Presses only: key down and mouse button down
+    if (!key.rawVk || !key.isKeyDown) { return { false, 0 }; }
 
     // Avoid triggering while the user is actively binding hotkeys/rebinds in the GUI.
     if (IsHotkeyBindingActive() || IsRebindBindingActive()) { return { false, 0 }; }
 
-    DWORD vkCode = 0;
-    switch (uMsg) {
-    case WM_KEYDOWN:
-    case WM_SYSKEYDOWN: {
-        vkCode = static_cast<DWORD>(wParam);
-        vkCode = NormalizeModifierVkFromKeyMessage(vkCode, lParam);
-        break;
-    }
-    case WM_LBUTTONDOWN:
-        vkCode = VK_LBUTTON;
-        break;
-    case WM_RBUTTONDOWN:
-        vkCode = VK_RBUTTON;
-        break;
-    case WM_MBUTTONDOWN:
-        vkCode = VK_MBUTTON;
-        break;
-    case WM_XBUTTONDOWN: {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        vkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        break;
-    }
-    default:
-        return { false, 0 };
-    }
-
-    if (!CheckHotkeyMatch(g_config.borderlessHotkey, vkCode)) { return { false, 0 }; }
+    // Disabled/unbound hotkeys have no binding in the table, so they never match
+    if (!MatchesToggleBinding(key, HotkeyAction::BorderlessToggle)) { return { false, 0 }; }
 
     // Simple debouncing
     static std::atomic<int64_t> s_lastToggleMs{ 0 };
@@ -478,46 +488,21 @@ InputHandlerResult HandleBorderlessToggle(HWND hWnd, UINT uMsg, WPARAM wParam, L
     return { true, 1 };
 }
 
-InputHandlerResult HandleImageOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+InputHandlerResult HandleImageOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
     PROFILE_SCOPE("HandleImageOverlaysToggle");
 
     // Never trigger gameplay hotkeys while the settings GUI is open.
     // This prevents mouse-bound hotkeys from eating clicks intended for the UI.
     if (g_showGui.load(std::memory_order_acquire)) { return { false, 0 }; }
 
-    // Disabled/unbound
-    if (g_config.imageOverlaysHotkey.empty()) { return { false, 0 }; }
+    // Presses only: key down and mouse button down
+    if (!key.rawVk || !key.isKeyDown) { return { false, 0 }; }
 
     // Avoid triggering while the user is actively binding hotkeys/rebinds in the GUI.
     if (IsHotkeyBindingActive() || IsRebindBindingActive()) { return { false, 0 }; }
 
-    DWORD vkCode = 0;
-    switch (uMsg) {
-    case WM_KEYDOWN:
-    case WM_SYSKEYDOWN: {
-        vkCode = static_cast<DWORD>(wParam);
-        vkCode = NormalizeModifierVkFromKeyMessage(vkCode, lParam);
-        break;
-    }
-    case WM_LBUTTONDOWN:
-        vkCode = VK_LBUTTON;
-        break;
-    case WM_RBUTTONDOWN:
-        vkCode = VK_RBUTTON;
-        break;
-    case WM_MBUTTONDOWN:
-        vkCode = VK_MBUTTON;
-        break;
-    case WM_XBUTTONDOWN: {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        vkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        break;
-    }
-    default:
-        return { false, 0 };
-    }
-
-    if (!CheckHotkeyMatch(g_config.imageOverlaysHotkey, vkCode)) { return { false, 0 }; }
+    // Disabled/unbound hotkeys have no binding in the table, so they never match
+    if (!MatchesToggleBinding(key, HotkeyAction::ImageOverlaysToggle)) { return { false, 0 }; }
 
     // Debounce
     static std::atomic<int64_t> s_lastToggleMs{ 0 };
@@ -533,46 +518,21 @@ InputHandlerResult HandleImageOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam
     return { true, 1 };
 }
 
-InputHandlerResult HandleWindowOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+InputHandlerResult HandleWindowOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
     PROFILE_SCOPE("HandleWindowOverlaysToggle");
 
     // Never trigger gameplay hotkeys while the settings GUI is open.
     // This prevents mouse-bound hotkeys from eating clicks intended for the UI.
     if (g_showGui.load(std::memory_order_acquire)) { return { false, 0 }; }
 
-    // Disabled/unbound
-    if (g_config.windowOverlaysHotkey.empty()) { return { false, 0 }; }
+    // Presses only: key down and mouse button down
+    if (!key.rawVk || !key.isKeyDown) { return { false, 0 }; }
 
     // Avoid triggering while the user is actively binding hotkeys/rebinds in the GUI.
     if (IsHotkeyBindingActive() || IsRebindBindingActive()) { return { false, 0 }; }
 
-    DWORD vkCode = 0;
-    switch (uMsg) {
-    case WM_KEYDOWN:
-    case WM_SYSKEYDOWN: {
-        vkCode = static_cast<DWORD>(wParam);
-        vkCode = NormalizeModifierVkFromKeyMessage(vkCode, lParam);
-        break;
-    }
-    case WM_LBUTTONDOWN:
-        vkCode = VK_LBUTTON;
-        break;
-    case WM_RBUTTONDOWN:
-        vkCode = VK_RBUTTON;
-        break;
-    case WM_MBUTTONDOWN:
-        vkCode = VK_MBUTTON;
-        break;
-    case WM_XBUTTONDOWN: {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        vkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        break;
-    }
-    default:
-        return { false, 0 };
-    }
-
-    if (!CheckHotkeyMatch(g_config.windowOverlaysHotkey, vkCode)) { return { false, 0 }; }
+    // Disabled/unbound hotkeys have no binding in the table, so they never match
+    if (!MatchesToggleBinding(key, HotkeyAction::WindowOverlaysToggle)) { return { false, 0 }; }
 
     // Debounce
     static std::atomic<int64_t> s_lastToggleMs{ 0 };
@@ -593,6 +553,37 @@ InputHandlerResult HandleWindowOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wPara
     return { true, 1 };
 }
 
+InputHandlerResult HandleTraceDumpHotkey(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
+    PROFILE_SCOPE("HandleTraceDumpHotkey");
+
+    // Never trigger gameplay hotkeys while the settings GUI is open.
+    if (g_showGui.load(std::memory_order_acquire)) { return { false, 0 }; }
+
+    // Presses only: key down and mouse button down
+    if (!key.rawVk || !key.isKeyDown) { return { false, 0 }; }
+
+    // Avoid triggering while the user is actively binding hotkeys/rebinds in the GUI.
+    if (IsHotkeyBindingActive() || IsRebindBindingActive()) { return { false, 0 }; }
+
+    // Disabled/unbound hotkeys have no binding in the table, so they never match
+    if (!MatchesToggleBinding(key, HotkeyAction::TraceDump)) { return { false, 0 }; }
+
+    // Debounce
+    static std::atomic<int64_t> s_lastDumpMs{ 0 };
+    auto now = std::chrono::steady_clock::now();
+    int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    int64_t lastMs = s_lastDumpMs.load(std::memory_order_relaxed);
+    if (nowMs - lastMs < 1000) { return { true, 1 }; }
+    s_lastDumpMs.store(nowMs, std::memory_order_relaxed);
+
+    if (!key.config || !key.config->debug.flightRecorderEnabled) {
+        Log("[Profiler] Trace dump hotkey pressed, but the flight recorder is disabled (Settings > Debug Options)");
+        return { true, 1 };
+    }
+    Profiler::GetInstance().RequestTraceDump(); // Written after the next frame
+    return { true, 1 };
+}
+
 InputHandlerResult HandleWindowOverlayKeyboard(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     PROFILE_SCOPE("HandleWindowOverlayKeyboard");
 
@@ -767,67 +758,41 @@ InputHandlerResult HandleActivate(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lP
     return { false, 0 };
 }
 
-InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const std::string& currentModeId,
-                                 const std::string& gameState) {
+InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key,
+                                 const std::string& currentModeId, const std::string& gameState) {
     PROFILE_SCOPE("HandleHotkeys");
 
-    // Determine the virtual key code based on message type
-    DWORD rawVkCode = 0;
-    DWORD vkCode = 0; // Normalized (left/right variants for Ctrl/Shift/Alt)
-    bool isKeyDown = false;
-
-    if (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN) {
-        rawVkCode = static_cast<DWORD>(wParam);
-        isKeyDown = true;
-    } else if (uMsg == WM_KEYUP || uMsg == WM_SYSKEYUP) {
-        rawVkCode = static_cast<DWORD>(wParam);
-        isKeyDown = false;
-    } else if (uMsg == WM_XBUTTONDOWN) {
-        // Side mouse buttons (Mouse 4/5)
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        rawVkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        isKeyDown = true;
-    } else if (uMsg == WM_XBUTTONUP) {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        rawVkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        isKeyDown = false;
-    } else if (uMsg == WM_LBUTTONDOWN) {
-        rawVkCode = VK_LBUTTON;
-        isKeyDown = true;
-    } else if (uMsg == WM_LBUTTONUP) {
-        rawVkCode = VK_LBUTTON;
-        isKeyDown = false;
-    } else if (uMsg == WM_RBUTTONDOWN) {
-        rawVkCode = VK_RBUTTON;
-        isKeyDown = true;
-    } else if (uMsg == WM_RBUTTONUP) {
-        rawVkCode = VK_RBUTTON;
-        isKeyDown = false;
-    } else if (uMsg == WM_MBUTTONDOWN) {
-        rawVkCode = VK_MBUTTON;
-        isKeyDown = true;
-    } else if (uMsg == WM_MBUTTONUP) {
-        rawVkCode = VK_MBUTTON;
-        isKeyDown = false;
-    } else {
-        return { false, 0 };
-    }
-
-    // Normalize modifier VKs to left/right variants (needed for RSHIFT/RCTRL/RALT, etc.).
-    // This mirrors imgui_impl_win32 behavior and enables reliable hotkeys + key rebinding.
-    vkCode = rawVkCode;
-    if (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN || uMsg == WM_KEYUP || uMsg == WM_SYSKEYUP) {
-        vkCode = NormalizeModifierVkFromKeyMessage(rawVkCode, lParam);
-        if (vkCode == 0) vkCode = rawVkCode;
-    }
+    if (!key.rawVk) { return { false, 0 }; }
+    const DWORD vkCode = key.vk;
+    const bool isKeyDown = key.isKeyDown;
 
     // Even if resolution-change features are unsupported, we must not short-circuit the input pipeline.
     // Key rebinding, mouse coordinate translation, overlays, etc. may still rely on downstream handlers.
     if (!IsResolutionChangeSupported(g_gameVersion)) { return { false, 0 }; }
 
-    // Lock-free check of hotkey main keys - acceptable to race (worst case: miss one keypress)
-    // Check both raw and normalized VK so Shift/Ctrl/Alt variants and generic VKs are handled.
-    if (g_hotkeyMainKeys.find(rawVkCode) == g_hotkeyMainKeys.end() && g_hotkeyMainKeys.find(vkCode) == g_hotkeyMainKeys.end()) {
+    if (!key.hotkeys) { return { false, 0 }; }
+    const Config& cfg = *key.config;
+    const HotkeyDispatchTable& table = *key.hotkeys;
+
+    // Resolve rebind target so hotkeys can match rebound keys (second probe only when this key is rebound)
+    DWORD rebindTargetVk = 0;
+    if (const CompiledHotkeyBinding* rebindBinding = table.FindRebind(key.bucket)) {
+        const KeyRebind& rebind = cfg.keyRebinds.rebinds[rebindBinding->ownerIndex];
+        rebindTargetVk = (rebind.useCustomOutput && rebind.customOutputVK != 0) ? rebind.customOutputVK : rebind.toKey;
+    }
+    const HotkeyDispatchTable::Bucket direct = key.bucket;
+    const HotkeyDispatchTable::Bucket viaRebind = rebindTargetVk ? table.Probe(rebindTargetVk) : HotkeyDispatchTable::Bucket{};
+
+    auto isHotkeyAction = [](HotkeyAction action) {
+        return action == HotkeyAction::ModeAlt || action == HotkeyAction::ModeMain || action == HotkeyAction::Sensitivity;
+    };
+    bool hasCandidate = false;
+    for (uint32_t i = 0; i < direct.count && !hasCandidate; i++) { hasCandidate = isHotkeyAction(table.Binding(direct.indices[i]).action); }
+    for (uint32_t i = 0; i < viaRebind.count && !hasCandidate; i++) {
+        hasCandidate = isHotkeyAction(table.Binding(viaRebind.indices[i]).action);
+    }
+
+    if (!hasCandidate) {
         // This key is not a hotkey main key, but it might invalidate pending trigger-on-release hotkeys
         if (isKeyDown) {
             std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
@@ -835,315 +800,231 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
             for (const auto& pendingHotkeyId : g_triggerOnReleasePending) { g_triggerOnReleaseInvalidated.insert(pendingHotkeyId); }
         }
         // IMPORTANT: Do not return "consumed" here.
-        // We intentionally skip scanning hotkeys for non-main keys, but we still want later phases
-        // (mouse coordinate translation, key rebinding, etc.) to run and the message to be forwarded once.
+        // Later phases (mouse coordinate translation, key rebinding, etc.) must still run and forward the message once.
         return { false, 0 };
     }
 
-    // Use config snapshot for thread-safe hotkey iteration
-    auto cfgSnap = GetConfigSnapshot();
-    if (!cfgSnap) { return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) }; }
-    const Config& cfg = *cfgSnap;
-
-    // Resolve rebind target so hotkeys can match rebound keys
-    DWORD rebindTargetVk = 0;
-    if (cfg.keyRebinds.enabled) {
-        for (const auto& rebind : cfg.keyRebinds.rebinds) {
-            if (rebind.enabled && rebind.fromKey != 0 && rebind.toKey != 0 &&
-                (vkCode == rebind.fromKey || rawVkCode == rebind.fromKey)) {
-                rebindTargetVk = (rebind.useCustomOutput && rebind.customOutputVK != 0)
-                    ? rebind.customOutputVK : rebind.toKey;
-                break;
-            }
-        }
-    }
-
     bool s_enableHotkeyDebug = cfg.debug.showHotkeyDebug;
 
     if (s_enableHotkeyDebug) {
-        Log("[Hotkey] Key/button pressed: " + std::to_string(vkCode) + " (raw=" + std::to_string(rawVkCode) + ") in mode: " +
-            currentModeId);
-    }
-    if (s_enableHotkeyDebug) {
-        Log("[Hotkey] Current game state: " + gameState);
-        Log("[Hotkey] Evaluating " + std::to_string(cfg.hotkeys.size()) + " configured hotkeys");
+        LOG_FMT("[Hotkey] Key/button pressed: {} (raw={}) in mode: {}", vkCode, key.rawVk, currentModeId);
+        LOG_FMT("[Hotkey] Current game state: {}", gameState);
+        LOG_FMT("[Hotkey] Evaluating {} bindings on this key", direct.count + viaRebind.count);
     }
 
-    for (size_t hotkeyIdx = 0; hotkeyIdx < cfg.hotkeys.size(); ++hotkeyIdx) {
-        const auto& hotkey = cfg.hotkeys[hotkeyIdx];
-        if (s_enableHotkeyDebug) {
-            Log("[Hotkey] Checking: " + GetKeyComboString(hotkey.keys) + " (main: " + hotkey.mainMode + ", sec: " + hotkey.secondaryMode +
-                ")");
+    auto conditionsMatch = [&](const HotkeyConditions& conditions) {
+        return conditions.gameState.empty() ||
+               std::find(conditions.gameState.begin(), conditions.gameState.end(), gameState) != conditions.gameState.end();
+    };
+    auto passThrough = [&](bool blockKey) -> InputHandlerResult {
+        if (blockKey) return { true, 0 };
+        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+    };
+    const int64_t nowMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Walk both buckets in binding order (config order), so the first configured hotkey still wins
+    uint32_t directPos = 0, rebindPos = 0;
+    while (directPos < direct.count || rebindPos < viaRebind.count) {
+        uint32_t index;
+        if (rebindPos >= viaRebind.count || (directPos < direct.count && direct.indices[directPos] <= viaRebind.indices[rebindPos])) {
+            index = direct.indices[directPos];
+        } else {
+            index = viaRebind.indices[rebindPos];
         }
-
-        // Game-state conditions normally gate ALL transitions.
-        // Optional behavior: allow exiting the current secondary mode back to Fullscreen even if game state doesn't match.
-        bool conditionsMet = hotkey.conditions.gameState.empty() ||
-                             std::find(hotkey.conditions.gameState.begin(), hotkey.conditions.gameState.end(), gameState) !=
-                                 hotkey.conditions.gameState.end();
-
-        // Determine if this hotkey is currently in its active secondary mode (meaning main hotkey would exit to Fullscreen).
-        // Note: GetHotkeySecondaryMode is thread-safe.
-        std::string currentSecMode = GetHotkeySecondaryMode(hotkeyIdx);
-        bool wouldExitToFullscreen = !currentSecMode.empty() && EqualsIgnoreCase(currentModeId, currentSecMode);
-
-        if (!conditionsMet) {
-            if (!(hotkey.allowExitToFullscreenRegardlessOfGameState && wouldExitToFullscreen)) {
-                if (s_enableHotkeyDebug) { Log("[Hotkey] SKIP: Game state conditions not met"); }
+        const bool inDirect = directPos < direct.count && direct.indices[directPos] == index;
+        const bool inRebind = rebindPos < viaRebind.count && viaRebind.indices[rebindPos] == index;
+        if (inDirect) directPos++;
+        if (inRebind) rebindPos++;
+
+        const CompiledHotkeyBinding& binding = table.Binding(index);
+        if (!isHotkeyAction(binding.action)) continue;
+        const std::string& hotkeyId = binding.id;
+
+        if (binding.action == HotkeyAction::Sensitivity) {
+            // Check sensitivity hotkeys (temporary sensitivity override)
+            const SensitivityHotkeyConfig& sensHotkey = cfg.sensitivityHotkeys[binding.ownerIndex];
+            const size_t sensIdx = binding.ownerIndex;
+            if (s_enableHotkeyDebug) { LOG_FMT("[Hotkey] Checking sensitivity hotkey: {} -> sens={}", hotkeyId, sensHotkey.sensitivity); }
+
+            if (!conditionsMatch(sensHotkey.conditions)) {
+                if (s_enableHotkeyDebug) { Log("[Hotkey] SKIP sensitivity: Game state conditions not met"); }
                 continue;
             }
-            if (s_enableHotkeyDebug) {
-                Log("[Hotkey] BYPASS: Allowing exit to Fullscreen even though game state conditions are not met");
-            }
-        }
 
-        // Check Alt secondary mode hotkeys first
-        for (const auto& alt : hotkey.altSecondaryModes) {
-            bool matched = CheckHotkeyMatch(alt.keys, vkCode, hotkey.conditions.exclusions, hotkey.triggerOnRelease);
-            bool matchedViaRebind = !matched && rebindTargetVk && CheckHotkeyMatch(alt.keys, rebindTargetVk, hotkey.conditions.exclusions, hotkey.triggerOnRelease);
-            if (matched || matchedViaRebind) {
-                // When matched via rebind target, always block original key from game
-                // (the original key is being rebinded away, and its target matched a hotkey)
-                bool blockKey = hotkey.blockKeyFromGame || matchedViaRebind;
-                std::string hotkeyId = GetKeyComboString(alt.keys);
-
-                // Handle trigger-on-release invalidation tracking
-                if (hotkey.triggerOnRelease) {
-                    if (isKeyDown) {
-                        // Key pressed - add to pending set and invalidate OTHER pending hotkeys
-                        std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
-                        for (const auto& pendingHotkeyId : g_triggerOnReleasePending) {
-                            if (pendingHotkeyId != hotkeyId) { g_triggerOnReleaseInvalidated.insert(pendingHotkeyId); }
-                        }
-                        g_triggerOnReleasePending.insert(hotkeyId);
-                        if (s_enableHotkeyDebug) { Log("[Hotkey] Alt trigger-on-release hotkey pressed, added to pending: " + hotkeyId); }
-                        // Pass through the key-down event to the game so modifier keys work with other combos
-                        if (blockKey) return { true, 0 };
-                        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                    } else {
-                        // Key released - check if invalidated
-                        bool wasInvalidated = false;
-                        {
-                            std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
-                            wasInvalidated = g_triggerOnReleaseInvalidated.count(hotkeyId) > 0;
-                            g_triggerOnReleasePending.erase(hotkeyId);
-                            g_triggerOnReleaseInvalidated.erase(hotkeyId);
-                        }
-
-                        if (wasInvalidated) {
-                            if (s_enableHotkeyDebug) { Log("[Hotkey] Alt trigger-on-release hotkey invalidated: " + hotkeyId); }
-                            if (blockKey) return { true, 0 };
-                            return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                        }
-                    }
-                }
-
-                // Check if this hotkey should trigger based on triggerOnRelease setting
-                // When triggerOnRelease is true, only fire on key UP; when false (default), only fire on key DOWN
-                if (hotkey.triggerOnRelease != isKeyDown) {
-                    auto now = std::chrono::steady_clock::now();
-                    // Lock-free debouncing - race is acceptable (worst case: occasional double-trigger)
-                    if (g_hotkeyTimestamps.count(hotkeyId) &&
-                        std::chrono::duration_cast<std::chrono::milliseconds>(now - g_hotkeyTimestamps[hotkeyId]).count() <
-                            hotkey.debounce) {
-                        if (s_enableHotkeyDebug) { Log("[Hotkey] Alt hotkey matched but debounced: " + hotkeyId); }
-                        if (blockKey) return { true, 0 };
-                        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                    }
-                    g_hotkeyTimestamps[hotkeyId] = now;
+            // Sensitivity hotkeys only trigger on key down (no triggerOnRelease support)
+            if (!isKeyDown) { continue; }
 
-                    std::string currentSecMode = GetHotkeySecondaryMode(hotkeyIdx);
-                    std::string newSecMode = (currentSecMode == alt.mode) ? hotkey.secondaryMode : alt.mode;
-                    SetHotkeySecondaryMode(hotkeyIdx, newSecMode);
+            bool matched = inDirect && HotkeyDispatchTable::Matches(binding, vkCode, s_keyState);
+            bool matchedViaRebind = !matched && inRebind && HotkeyDispatchTable::Matches(binding, rebindTargetVk, s_keyState);
+            if (!matched && !matchedViaRebind) { continue; }
 
-                    if (s_enableHotkeyDebug) { Log("[Hotkey] ✓✓✓ ALT HOTKEY TRIGGERED: " + hotkeyId + " -> " + newSecMode); }
+            // Sensitivity hotkeys have no blockKeyFromGame setting; only block when matched via rebind
+            bool blockKey = matchedViaRebind;
 
-                    if (!newSecMode.empty()) { SwitchToMode(newSecMode, "alt hotkey"); }
-                }
-                if (blockKey) return { true, 0 };
-                return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+            // Debouncing
+            if (!table.TryConsumeDebounce(index, nowMs)) {
+                if (s_enableHotkeyDebug) { Log("[Hotkey] Sensitivity hotkey matched but debounced: " + hotkeyId); }
+                return passThrough(blockKey);
             }
-        }
 
-        // Check Main hotkey
-        {
-            bool matched = CheckHotkeyMatch(hotkey.keys, vkCode, hotkey.conditions.exclusions, hotkey.triggerOnRelease);
-            bool matchedViaRebind = !matched && rebindTargetVk && CheckHotkeyMatch(hotkey.keys, rebindTargetVk, hotkey.conditions.exclusions, hotkey.triggerOnRelease);
-            if (matched || matchedViaRebind) {
-                // When matched via rebind target, always block original key from game
-                // (the original key is being rebinded away, and its target matched a hotkey)
-                bool blockKey = hotkey.blockKeyFromGame || matchedViaRebind;
-                std::string hotkeyId = GetKeyComboString(hotkey.keys);
-
-                // Handle trigger-on-release invalidation tracking
-                if (hotkey.triggerOnRelease) {
-                    if (isKeyDown) {
-                        // Key pressed - add to pending set and invalidate OTHER pending hotkeys
-                        std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
-                        // Invalidate all other pending trigger-on-release hotkeys
-                        for (const auto& pendingHotkeyId : g_triggerOnReleasePending) {
-                            if (pendingHotkeyId != hotkeyId) { g_triggerOnReleaseInvalidated.insert(pendingHotkeyId); }
-                        }
-                        // Add this hotkey to pending
-                        g_triggerOnReleasePending.insert(hotkeyId);
-                        if (s_enableHotkeyDebug) { Log("[Hotkey] Trigger-on-release hotkey pressed, added to pending: " + hotkeyId); }
-                        // Pass through the key-down event to the game so modifier keys work with other combos
-                        if (blockKey) return { true, 0 };
-                        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                    } else {
-                        // Key released - check if invalidated
-                        bool wasInvalidated = false;
-                        {
-                            std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
-                            wasInvalidated = g_triggerOnReleaseInvalidated.count(hotkeyId) > 0;
-                            // Clean up tracking sets
-                            g_triggerOnReleasePending.erase(hotkeyId);
-                            g_triggerOnReleaseInvalidated.erase(hotkeyId);
-                        }
+            // Toggle logic: if this hotkey has toggle enabled and it's the currently active override, clear it
+            if (sensHotkey.toggle) {
+                extern TempSensitivityOverride g_tempSensitivityOverride;
+                extern std::mutex g_tempSensitivityMutex;
+                bool toggledOff = false;
+                {
+                    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
 
-                        if (wasInvalidated) {
-                            if (s_enableHotkeyDebug) {
-                                Log("[Hotkey] Trigger-on-release hotkey invalidated (another key was pressed): " + hotkeyId);
-                            }
-                            if (blockKey) return { true, 0 };
-                            return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+                    if (g_tempSensitivityOverride.active && g_tempSensitivityOverride.activeSensHotkeyIndex == static_cast<int>(sensIdx)) {
+                        // Toggle OFF - clear the override
+                        g_tempSensitivityOverride.active = false;
+                        g_tempSensitivityOverride.sensitivityX = 1.0f;
+                        g_tempSensitivityOverride.sensitivityY = 1.0f;
+                        g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+                        toggledOff = true;
+                    } else {
+                        // Toggle ON - apply the override
+                        g_tempSensitivityOverride.active = true;
+                        if (sensHotkey.separateXY) {
+                            g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
+                            g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
+                        } else {
+                            g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
+                            g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
                         }
-                        // Fall through to trigger the hotkey
+                        g_tempSensitivityOverride.activeSensHotkeyIndex = static_cast<int>(sensIdx);
                     }
                 }
+                RefreshEffectiveMouseSensitivity();
 
-                // Check if this hotkey should trigger based on triggerOnRelease setting
-                // When triggerOnRelease is true, only fire on key UP; when false (default), only fire on key DOWN
-                if (hotkey.triggerOnRelease != isKeyDown) {
-                    auto now = std::chrono::steady_clock::now();
-                    // Lock-free debouncing - race is acceptable (worst case: occasional double-trigger)
-                    if (g_hotkeyTimestamps.count(hotkeyId) &&
-                        std::chrono::duration_cast<std::chrono::milliseconds>(now - g_hotkeyTimestamps[hotkeyId]).count() < hotkey.debounce) {
-                        if (s_enableHotkeyDebug) { Log("[Hotkey] Main hotkey matched but debounced: " + hotkeyId); }
-                        if (blockKey) return { true, 0 };
-                        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                    }
-                    g_hotkeyTimestamps[hotkeyId] = now;
-
-                    // Lock-free read of current mode ID from double-buffer
-                    std::string current = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-                    std::string targetMode;
-
-                if (EqualsIgnoreCase(current, currentSecMode)) {
-                    targetMode = cfg.defaultMode;
-                } else {
-                    targetMode = currentSecMode;
+                if (toggledOff) {
+                    if (s_enableHotkeyDebug) { Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED OFF: " + hotkeyId); }
+                } else if (s_enableHotkeyDebug) {
+                    Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED ON: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
                 }
-
-                    if (s_enableHotkeyDebug) {
-                        Log("[Hotkey] ✓✓✓ MAIN HOTKEY TRIGGERED: " + hotkeyId + " (current: " + current + " -> target: " + targetMode + ")");
+            } else {
+                // Non-toggle: apply the override (one-shot, no toggle tracking)
+                {
+                    extern TempSensitivityOverride g_tempSensitivityOverride;
+                    extern std::mutex g_tempSensitivityMutex;
+                    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+                    g_tempSensitivityOverride.active = true;
+                    if (sensHotkey.separateXY) {
+                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
+                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
+                    } else {
+                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
+                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
                     }
+                    g_tempSensitivityOverride.activeSensHotkeyIndex = -1; // Non-toggle, no index tracking
+                }
+                RefreshEffectiveMouseSensitivity();
 
-                    if (!targetMode.empty()) { SwitchToMode(targetMode, "main hotkey"); }
+                if (s_enableHotkeyDebug) {
+                    Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TRIGGERED: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
                 }
-                if (blockKey) return { true, 0 };
-                return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
             }
+
+            return passThrough(blockKey);
         }
-    }
 
-    // Check sensitivity hotkeys (temporary sensitivity override)
-    for (size_t sensIdx = 0; sensIdx < cfg.sensitivityHotkeys.size(); ++sensIdx) {
-        const auto& sensHotkey = cfg.sensitivityHotkeys[sensIdx];
+        // Mode hotkey: alt secondary mode combo or the main combo
+        const bool isAlt = (binding.action == HotkeyAction::ModeAlt);
+        const size_t hotkeyIdx = binding.ownerIndex;
+        const HotkeyConfig& hotkey = cfg.hotkeys[hotkeyIdx];
         if (s_enableHotkeyDebug) {
-            Log("[Hotkey] Checking sensitivity hotkey: " + GetKeyComboString(sensHotkey.keys) +
-                " -> sens=" + std::to_string(sensHotkey.sensitivity));
+            LOG_FMT("[Hotkey] Checking: {}{} (main: {}, sec: {})", hotkeyId, isAlt ? " (alt)" : "", hotkey.mainMode, hotkey.secondaryMode);
         }
 
-        // Check game state conditions
-        bool conditionsMet = sensHotkey.conditions.gameState.empty() ||
-                             std::find(sensHotkey.conditions.gameState.begin(), sensHotkey.conditions.gameState.end(), gameState) !=
-                                 sensHotkey.conditions.gameState.end();
-        if (!conditionsMet) {
-            if (s_enableHotkeyDebug) { Log("[Hotkey] SKIP sensitivity: Game state conditions not met"); }
-            continue;
+        // Game-state conditions normally gate ALL transitions.
+        // Optional behavior: allow exiting the current secondary mode back to Fullscreen even if game state doesn't match.
+        // Determine if this hotkey is currently in its active secondary mode (meaning main hotkey would exit to Fullscreen).
+        // Note: GetHotkeySecondaryMode is thread-safe.
+        std::string currentSecMode = GetHotkeySecondaryMode(hotkeyIdx);
+        if (!conditionsMatch(hotkey.conditions)) {
+            bool wouldExitToFullscreen = !currentSecMode.empty() && EqualsIgnoreCase(currentModeId, currentSecMode);
+            if (!(hotkey.allowExitToFullscreenRegardlessOfGameState && wouldExitToFullscreen)) {
+                if (s_enableHotkeyDebug) { Log("[Hotkey] SKIP: Game state conditions not met"); }
+                continue;
+            }
+            if (s_enableHotkeyDebug) {
+                Log("[Hotkey] BYPASS: Allowing exit to Fullscreen even though game state conditions are not met");
+            }
         }
 
-        // Sensitivity hotkeys only trigger on key down (no triggerOnRelease support)
-        if (!isKeyDown) { continue; }
-
-        {
-            bool matched = CheckHotkeyMatch(sensHotkey.keys, vkCode, sensHotkey.conditions.exclusions, false);
-            bool matchedViaRebind = !matched && rebindTargetVk && CheckHotkeyMatch(sensHotkey.keys, rebindTargetVk, sensHotkey.conditions.exclusions, false);
-            if (matched || matchedViaRebind) {
-                // Sensitivity hotkeys have no blockKeyFromGame setting; only block when matched via rebind
-                bool blockKey = matchedViaRebind;
-                std::string hotkeyId = "sens_" + GetKeyComboString(sensHotkey.keys);
-
-                auto now = std::chrono::steady_clock::now();
-                // Debouncing
-                if (g_hotkeyTimestamps.count(hotkeyId) &&
-                    std::chrono::duration_cast<std::chrono::milliseconds>(now - g_hotkeyTimestamps[hotkeyId]).count() < sensHotkey.debounce) {
-                    if (s_enableHotkeyDebug) { Log("[Hotkey] Sensitivity hotkey matched but debounced: " + hotkeyId); }
-                    if (blockKey) return { true, 0 };
-                    return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+        bool matched = inDirect && HotkeyDispatchTable::Matches(binding, vkCode, s_keyState);
+        bool matchedViaRebind = !matched && inRebind && HotkeyDispatchTable::Matches(binding, rebindTargetVk, s_keyState);
+        if (!matched && !matchedViaRebind) { continue; }
+
+        // When matched via rebind target, always block original key from game
+        // (the original key is being rebinded away, and its target matched a hotkey)
+        bool blockKey = hotkey.blockKeyFromGame || matchedViaRebind;
+        const char* kindLabel = isAlt ? "Alt trigger-on-release" : "Trigger-on-release";
+
+        // Handle trigger-on-release invalidation tracking
+        if (hotkey.triggerOnRelease) {
+            if (isKeyDown) {
+                // Key pressed - add to pending set and invalidate OTHER pending hotkeys
+                std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
+                for (const auto& pendingHotkeyId : g_triggerOnReleasePending) {
+                    if (pendingHotkeyId != hotkeyId) { g_triggerOnReleaseInvalidated.insert(pendingHotkeyId); }
                 }
-                g_hotkeyTimestamps[hotkeyId] = now;
+                g_triggerOnReleasePending.insert(hotkeyId);
+                if (s_enableHotkeyDebug) { Log(std::string("[Hotkey] ") + kindLabel + " hotkey pressed, added to pending: " + hotkeyId); }
+                // Pass through the key-down event to the game so modifier keys work with other combos
+                return passThrough(blockKey);
+            }
 
-                // Toggle logic: if this hotkey has toggle enabled and it's the currently active override, clear it
-                if (sensHotkey.toggle) {
-                    extern TempSensitivityOverride g_tempSensitivityOverride;
-                    extern std::mutex g_tempSensitivityMutex;
-                    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+            // Key released - check if invalidated
+            bool wasInvalidated = false;
+            {
+                std::lock_guard<std::mutex> lock(g_triggerOnReleaseMutex);
+                wasInvalidated = g_triggerOnReleaseInvalidated.count(hotkeyId) > 0;
+                // Clean up tracking sets
+                g_triggerOnReleasePending.erase(hotkeyId);
+                g_triggerOnReleaseInvalidated.erase(hotkeyId);
+            }
 
-                    if (g_tempSensitivityOverride.active && g_tempSensitivityOverride.activeSensHotkeyIndex == static_cast<int>(sensIdx)) {
-                        // Toggle OFF - clear the override
-                        g_tempSensitivityOverride.active = false;
-                        g_tempSensitivityOverride.sensitivityX = 1.0f;
-                        g_tempSensitivityOverride.sensitivityY = 1.0f;
-                        g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+            if (wasInvalidated) {
+                if (s_enableHotkeyDebug) {
+                    Log(std::string("[Hotkey] ") + kindLabel + " hotkey invalidated (another key was pressed): " + hotkeyId);
+                }
+                return passThrough(blockKey);
+            }
+            // Fall through to trigger the hotkey
+        }
 
-                        if (s_enableHotkeyDebug) { Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED OFF: " + hotkeyId); }
+        // Check if this hotkey should trigger based on triggerOnRelease setting
+        // When triggerOnRelease is true, only fire on key UP; when false (default), only fire on key DOWN
+        if (hotkey.triggerOnRelease != isKeyDown) {
+            // Lock-free debouncing
+            if (!table.TryConsumeDebounce(index, nowMs)) {
+                if (s_enableHotkeyDebug) { Log(std::string("[Hotkey] ") + (isAlt ? "Alt" : "Main") + " hotkey matched but debounced: " + hotkeyId); }
+                return passThrough(blockKey);
+            }
 
-                        if (blockKey) return { true, 0 };
-                        return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
-                    }
+            if (isAlt) {
+                const AltSecondaryMode& alt = hotkey.altSecondaryModes[binding.altIndex];
+                std::string newSecMode = (currentSecMode == alt.mode) ? hotkey.secondaryMode : alt.mode;
+                SetHotkeySecondaryMode(hotkeyIdx, newSecMode);
 
-                    // Toggle ON - apply the override
-                    g_tempSensitivityOverride.active = true;
-                    if (sensHotkey.separateXY) {
-                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
-                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
-                    } else {
-                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
-                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
-                    }
-                    g_tempSensitivityOverride.activeSensHotkeyIndex = static_cast<int>(sensIdx);
+                if (s_enableHotkeyDebug) { Log("[Hotkey] ✓✓✓ ALT HOTKEY TRIGGERED: " + hotkeyId + " -> " + newSecMode); }
 
-                    if (s_enableHotkeyDebug) {
-                        Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED ON: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
-                    }
-                } else {
-                    // Non-toggle: apply the override (one-shot, no toggle tracking)
-                    {
-                        extern TempSensitivityOverride g_tempSensitivityOverride;
-                        extern std::mutex g_tempSensitivityMutex;
-                        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-                        g_tempSensitivityOverride.active = true;
-                        if (sensHotkey.separateXY) {
-                            g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
-                            g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
-                        } else {
-                            g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
-                            g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
-                        }
-                        g_tempSensitivityOverride.activeSensHotkeyIndex = -1; // Non-toggle, no index tracking
-                    }
+                if (!newSecMode.empty()) { SwitchToMode(newSecMode, "alt hotkey"); }
+            } else {
+                // Lock-free read of current mode (interned name, no copy)
+                const std::string& current = ModeIdName(g_currentModeHandle.load(std::memory_order_acquire));
+                std::string targetMode = EqualsIgnoreCase(current, currentSecMode) ? cfg.defaultMode : currentSecMode;
 
-                    if (s_enableHotkeyDebug) {
-                        Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TRIGGERED: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
-                    }
+                if (s_enableHotkeyDebug) {
+                    Log("[Hotkey] ✓✓✓ MAIN HOTKEY TRIGGERED: " + hotkeyId + " (current: " + current + " -> target: " + targetMode + ")");
                 }
 
-                if (blockKey) return { true, 0 };
-                return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+                if (!targetMode.empty()) { SwitchToMode(targetMode, "main hotkey"); }
             }
         }
+        return passThrough(blockKey);
     }
 
     return { false, 0 };
@@ -1286,240 +1167,156 @@ static bool TryTranslateVkToCharWithKeyboardState(DWORD vkCode, const BYTE keybo
     return false;
 }
 
-InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key) {
     PROFILE_SCOPE("HandleKeyRebinding");
 
-    // Determine the virtual key code based on message type
-    DWORD rawVkCode = 0;
-    DWORD vkCode = 0; // Normalized (left/right variants for Ctrl/Shift/Alt)
-    bool isMouseButton = false;
-    bool isKeyDown = false;
-
-    if (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN) {
-        rawVkCode = static_cast<DWORD>(wParam);
-        isKeyDown = true;
-    } else if (uMsg == WM_KEYUP || uMsg == WM_SYSKEYUP) {
-        rawVkCode = static_cast<DWORD>(wParam);
-        isKeyDown = false;
-    } else if (uMsg == WM_XBUTTONDOWN) {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        rawVkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        isMouseButton = true;
-        isKeyDown = true;
-    } else if (uMsg == WM_XBUTTONUP) {
-        WORD xButton = GET_XBUTTON_WPARAM(wParam);
-        rawVkCode = (xButton == XBUTTON1) ? VK_XBUTTON1 : VK_XBUTTON2;
-        isMouseButton = true;
-        isKeyDown = false;
-    } else if (uMsg == WM_LBUTTONDOWN) {
-        rawVkCode = VK_LBUTTON;
-        isMouseButton = true;
-        isKeyDown = true;
-    } else if (uMsg == WM_LBUTTONUP) {
-        rawVkCode = VK_LBUTTON;
-        isMouseButton = true;
-        isKeyDown = false;
-    } else if (uMsg == WM_RBUTTONDOWN) {
-        rawVkCode = VK_RBUTTON;
-        isMouseButton = true;
-        isKeyDown = true;
-    } else if (uMsg == WM_RBUTTONUP) {
-        rawVkCode = VK_RBUTTON;
-        isMouseButton = true;
-        isKeyDown = false;
-    } else if (uMsg == WM_MBUTTONDOWN) {
-        rawVkCode = VK_MBUTTON;
-        isMouseButton = true;
-        isKeyDown = true;
-    } else if (uMsg == WM_MBUTTONUP) {
-        rawVkCode = VK_MBUTTON;
-        isMouseButton = true;
-        isKeyDown = false;
-    } else {
-        return { false, 0 };
-    }
+    if (!key.rawVk) { return { false, 0 }; }
+    const bool isMouseButton = key.isMouseButton;
+    const bool isKeyDown = key.isKeyDown;
 
     // If the config GUI is open, never apply mouse-button rebinds.
     // Rebinding mouse buttons while the GUI is open can steal clicks and make the UI hard/impossible to use.
     // Keyboard rebinds are still allowed (for text fields, etc.), and UI key-binding uses a separate capture path.
     if (isMouseButton && g_showGui.load(std::memory_order_acquire)) { return { false, 0 }; }
 
-    vkCode = rawVkCode;
-    if (!isMouseButton && (uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN || uMsg == WM_KEYUP || uMsg == WM_SYSKEYUP)) {
-        vkCode = NormalizeModifierVkFromKeyMessage(rawVkCode, lParam);
-        if (vkCode == 0) vkCode = rawVkCode;
-    }
-
-    // Use config snapshot for thread-safe access to key rebinds
-    auto rebindCfg = GetConfigSnapshot();
-    if (!rebindCfg || !rebindCfg->keyRebinds.enabled) { return { false, 0 }; }
+    // Enabled rebinds are compiled into the hotkey table (only while rebinding is on), bucketed by source key
+    const CompiledHotkeyBinding* rebindBinding = key.hotkeys ? key.hotkeys->FindRebind(key.bucket) : nullptr;
+    if (!rebindBinding) { return { false, 0 }; }
+    const KeyRebind& rebind = key.config->keyRebinds.rebinds[rebindBinding->ownerIndex];
 
-    auto matchesFromKey = [&](DWORD incomingVk, DWORD incomingRawVk, DWORD fromKey) -> bool {
-        if (fromKey == 0) return false;
-        if (incomingVk == fromKey) return true;
+    DWORD outputVK;
+    UINT outputScanCode;
 
-        if (fromKey == VK_CONTROL) {
-            return incomingVk == VK_LCONTROL || incomingVk == VK_RCONTROL || incomingRawVk == VK_CONTROL;
-        }
-        if (fromKey == VK_SHIFT) {
-            return incomingVk == VK_LSHIFT || incomingVk == VK_RSHIFT || incomingRawVk == VK_SHIFT;
-        }
-        if (fromKey == VK_MENU) {
-            return incomingVk == VK_LMENU || incomingVk == VK_RMENU || incomingRawVk == VK_MENU;
-        }
-
-        if (incomingRawVk == VK_CONTROL && incomingVk == VK_CONTROL && (fromKey == VK_LCONTROL || fromKey == VK_RCONTROL)) return true;
-        if (incomingRawVk == VK_SHIFT && incomingVk == VK_SHIFT && (fromKey == VK_LSHIFT || fromKey == VK_RSHIFT)) return true;
-        if (incomingRawVk == VK_MENU && incomingVk == VK_MENU && (fromKey == VK_LMENU || fromKey == VK_RMENU)) return true;
-
-        return false;
-    };
-
-    for (size_t i = 0; i < rebindCfg->keyRebinds.rebinds.size(); ++i) {
-        const auto& rebind = rebindCfg->keyRebinds.rebinds[i];
+    if (rebind.useCustomOutput) {
+        outputVK = (rebind.customOutputVK != 0) ? rebind.customOutputVK : rebind.toKey;
+        outputScanCode = ResolveOutputScanCode(outputVK, rebind.customOutputScanCode);
+    } else {
+        outputVK = rebind.toKey;
+        outputScanCode = GetScanCodeWithExtendedFlag(rebind.toKey);
+    }
 
-        if (rebind.enabled && rebind.fromKey != 0 && rebind.toKey != 0 && matchesFromKey(vkCode, rawVkCode, rebind.fromKey)) {
-            DWORD outputVK;
-            UINT outputScanCode;
+    // For mouse button output, synthesize the appropriate mouse message
+    if (outputVK == VK_LBUTTON || outputVK == VK_RBUTTON || outputVK == VK_MBUTTON || outputVK == VK_XBUTTON1 ||
+        outputVK == VK_XBUTTON2) {
+        UINT newMsg = 0;
+        auto buildMouseKeyState = [&](DWORD buttonVk, bool buttonDown) -> WORD {
+            WORD mk = 0;
+            if ((GetKeyState(VK_CONTROL) & 0x8000) != 0) mk |= MK_CONTROL;
+            if ((GetKeyState(VK_SHIFT) & 0x8000) != 0) mk |= MK_SHIFT;
+
+            auto setBtn = [&](int vk, WORD mask, bool isThisButton) {
+                bool down = (GetKeyState(vk) & 0x8000) != 0;
+                if (isThisButton) down = buttonDown;
+                if (down) mk |= mask;
+            };
 
-            if (rebind.useCustomOutput) {
-                outputVK = (rebind.customOutputVK != 0) ? rebind.customOutputVK : rebind.toKey;
-                outputScanCode = ResolveOutputScanCode(outputVK, rebind.customOutputScanCode);
+            setBtn(VK_LBUTTON, MK_LBUTTON, buttonVk == VK_LBUTTON);
+            setBtn(VK_RBUTTON, MK_RBUTTON, buttonVk == VK_RBUTTON);
+            setBtn(VK_MBUTTON, MK_MBUTTON, buttonVk == VK_MBUTTON);
+            setBtn(VK_XBUTTON1, MK_XBUTTON1, buttonVk == VK_XBUTTON1);
+            setBtn(VK_XBUTTON2, MK_XBUTTON2, buttonVk == VK_XBUTTON2);
+            return mk;
+        };
+
+        LPARAM mouseLParam = lParam;
+        if (!isMouseButton) {
+            POINT pt{};
+            if (GetCursorPos(&pt) && ScreenToClient(hWnd, &pt)) {
+                mouseLParam = MAKELPARAM(pt.x, pt.y);
             } else {
-                outputVK = rebind.toKey;
-                outputScanCode = GetScanCodeWithExtendedFlag(rebind.toKey);
+                mouseLParam = MAKELPARAM(0, 0);
             }
+        }
 
-            // For mouse button output, synthesize the appropriate mouse message
-            if (outputVK == VK_LBUTTON || outputVK == VK_RBUTTON || outputVK == VK_MBUTTON || outputVK == VK_XBUTTON1 ||
-                outputVK == VK_XBUTTON2) {
-                UINT newMsg = 0;
-                auto buildMouseKeyState = [&](DWORD buttonVk, bool buttonDown) -> WORD {
-                    WORD mk = 0;
-                    if ((GetKeyState(VK_CONTROL) & 0x8000) != 0) mk |= MK_CONTROL;
-                    if ((GetKeyState(VK_SHIFT) & 0x8000) != 0) mk |= MK_SHIFT;
-
-                    auto setBtn = [&](int vk, WORD mask, bool isThisButton) {
-                        bool down = (GetKeyState(vk) & 0x8000) != 0;
-                        if (isThisButton) down = buttonDown;
-                        if (down) mk |= mask;
-                    };
-
-                    setBtn(VK_LBUTTON, MK_LBUTTON, buttonVk == VK_LBUTTON);
-                    setBtn(VK_RBUTTON, MK_RBUTTON, buttonVk == VK_RBUTTON);
-                    setBtn(VK_MBUTTON, MK_MBUTTON, buttonVk == VK_MBUTTON);
-                    setBtn(VK_XBUTTON1, MK_XBUTTON1, buttonVk == VK_XBUTTON1);
-                    setBtn(VK_XBUTTON2, MK_XBUTTON2, buttonVk == VK_XBUTTON2);
-                    return mk;
-                };
-
-                LPARAM mouseLParam = lParam;
-                if (!isMouseButton) {
-                    POINT pt{};
-                    if (GetCursorPos(&pt) && ScreenToClient(hWnd, &pt)) {
-                        mouseLParam = MAKELPARAM(pt.x, pt.y);
-                    } else {
-                        mouseLParam = MAKELPARAM(0, 0);
-                    }
-                }
-
-                WORD mkState = buildMouseKeyState(outputVK, isKeyDown);
-                WPARAM newWParam = mkState;
-
-                if (outputVK == VK_LBUTTON) {
-                    newMsg = isKeyDown ? WM_LBUTTONDOWN : WM_LBUTTONUP;
-                } else if (outputVK == VK_RBUTTON) {
-                    newMsg = isKeyDown ? WM_RBUTTONDOWN : WM_RBUTTONUP;
-                } else if (outputVK == VK_MBUTTON) {
-                    newMsg = isKeyDown ? WM_MBUTTONDOWN : WM_MBUTTONUP;
-                } else if (outputVK == VK_XBUTTON1) {
-                    newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
-                    newWParam = MAKEWPARAM(mkState, XBUTTON1);
-                } else if (outputVK == VK_XBUTTON2) {
-                    newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
-                    newWParam = MAKEWPARAM(mkState, XBUTTON2);
-                }
+        WORD mkState = buildMouseKeyState(outputVK, isKeyDown);
+        WPARAM newWParam = mkState;
+
+        if (outputVK == VK_LBUTTON) {
+            newMsg = isKeyDown ? WM_LBUTTONDOWN : WM_LBUTTONUP;
+        } else if (outputVK == VK_RBUTTON) {
+            newMsg = isKeyDown ? WM_RBUTTONDOWN : WM_RBUTTONUP;
+        } else if (outputVK == VK_MBUTTON) {
+            newMsg = isKeyDown ? WM_MBUTTONDOWN : WM_MBUTTONUP;
+        } else if (outputVK == VK_XBUTTON1) {
+            newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
+            newWParam = MAKEWPARAM(mkState, XBUTTON1);
+        } else if (outputVK == VK_XBUTTON2) {
+            newMsg = isKeyDown ? WM_XBUTTONDOWN : WM_XBUTTONUP;
+            newWParam = MAKEWPARAM(mkState, XBUTTON2);
+        }
 
-                return { true, CallWindowProc(g_originalWndProc, hWnd, newMsg, newWParam, mouseLParam) };
-            }
+        return { true, CallWindowProc(g_originalWndProc, hWnd, newMsg, newWParam, mouseLParam) };
+    }
 
-            // For keyboard output from keyboard/mouse input
-            const bool isSystemKeyMsg = (uMsg == WM_SYSKEYDOWN || uMsg == WM_SYSKEYUP);
-            UINT outputMsg = isKeyDown ? (isSystemKeyMsg ? WM_SYSKEYDOWN : WM_KEYDOWN) : (isSystemKeyMsg ? WM_SYSKEYUP : WM_KEYUP);
+    // For keyboard output from keyboard/mouse input
+    const bool isSystemKeyMsg = (uMsg == WM_SYSKEYDOWN || uMsg == WM_SYSKEYUP);
+    UINT outputMsg = isKeyDown ? (isSystemKeyMsg ? WM_SYSKEYDOWN : WM_KEYDOWN) : (isSystemKeyMsg ? WM_SYSKEYUP : WM_KEYUP);
 
-            UINT repeatCount = 1;
-            bool previousState = !isKeyDown;
-            bool transitionState = !isKeyDown;
-            if (!isMouseButton) {
-                repeatCount = static_cast<UINT>(lParam & 0xFFFF);
-                if (repeatCount == 0) repeatCount = 1;
+    UINT repeatCount = 1;
+    bool previousState = !isKeyDown;
+    bool transitionState = !isKeyDown;
+    if (!isMouseButton) {
+        repeatCount = static_cast<UINT>(lParam & 0xFFFF);
+        if (repeatCount == 0) repeatCount = 1;
 
-                // Mirror source-message semantics (especially for key repeat/down transitions).
-                previousState = ((lParam & (1LL << 30)) != 0);
-                transitionState = ((lParam & (1LL << 31)) != 0);
-            }
+        // Mirror source-message semantics (especially for key repeat/down transitions).
+        previousState = ((lParam & (1LL << 30)) != 0);
+        transitionState = ((lParam & (1LL << 31)) != 0);
+    }
 
-            LPARAM newLParam =
-                BuildKeyboardMessageLParam(outputScanCode, isKeyDown, isSystemKeyMsg, repeatCount, previousState, transitionState);
+    LPARAM newLParam =
+        BuildKeyboardMessageLParam(outputScanCode, isKeyDown, isSystemKeyMsg, repeatCount, previousState, transitionState);
 
-            if (isMouseButton) {
-                PostMessage(hWnd, outputMsg, static_cast<WPARAM>(outputVK), newLParam);
-                return { true, 0 };
-            }
+    if (isMouseButton) {
+        PostMessage(hWnd, outputMsg, static_cast<WPARAM>(outputVK), newLParam);
+        return { true, 0 };
+    }
 
-            LRESULT keyResult = CallWindowProc(g_originalWndProc, hWnd, outputMsg, outputVK, newLParam);
+    LRESULT keyResult = CallWindowProc(g_originalWndProc, hWnd, outputMsg, outputVK, newLParam);
 
-            auto isModifierVk = [](DWORD vk) {
-                return vk == VK_CONTROL || vk == VK_LCONTROL || vk == VK_RCONTROL || vk == VK_SHIFT || vk == VK_LSHIFT || vk == VK_RSHIFT ||
-                       vk == VK_MENU || vk == VK_LMENU || vk == VK_RMENU;
-            };
+    const bool fromKeyIsNonChar = IsModifierVk(rebind.fromKey) || rebind.fromKey == VK_LWIN || rebind.fromKey == VK_RWIN ||
+                                  (rebind.fromKey >= VK_F1 && rebind.fromKey <= VK_F24);
 
-            const bool fromKeyIsNonChar = isModifierVk(rebind.fromKey) || rebind.fromKey == VK_LWIN || rebind.fromKey == VK_RWIN ||
-                                          (rebind.fromKey >= VK_F1 && rebind.fromKey <= VK_F24);
-
-            if (isKeyDown && fromKeyIsNonChar) {
-                WCHAR outChar = 0;
-
-                // Some control keys should always generate WM_CHAR for expected text/edit behavior.
-                if (outputVK == VK_RETURN) {
-                    outChar = L'\r';
-                } else if (outputVK == VK_TAB) {
-                    outChar = L'\t';
-                } else if (outputVK == VK_BACK) {
-                    outChar = L'\b';
-                } else {
-                    BYTE ks[256] = {};
-                    if (GetKeyboardState(ks)) {
-                        // If the source key is a modifier that we're consuming, clear it from the keyboard state
-                        // so it doesn't accidentally affect character translation (e.g. Shift -> capital letters).
-                        if (rebind.fromKey == VK_SHIFT || rebind.fromKey == VK_LSHIFT || rebind.fromKey == VK_RSHIFT) {
-                            ks[VK_SHIFT] = 0;
-                            ks[VK_LSHIFT] = 0;
-                            ks[VK_RSHIFT] = 0;
-                        } else if (rebind.fromKey == VK_CONTROL || rebind.fromKey == VK_LCONTROL || rebind.fromKey == VK_RCONTROL) {
-                            ks[VK_CONTROL] = 0;
-                            ks[VK_LCONTROL] = 0;
-                            ks[VK_RCONTROL] = 0;
-                        } else if (rebind.fromKey == VK_MENU || rebind.fromKey == VK_LMENU || rebind.fromKey == VK_RMENU) {
-                            ks[VK_MENU] = 0;
-                            ks[VK_LMENU] = 0;
-                            ks[VK_RMENU] = 0;
-                        }
+    if (isKeyDown && fromKeyIsNonChar) {
+        WCHAR outChar = 0;
 
-                        (void)TryTranslateVkToCharWithKeyboardState(outputVK, ks, outChar);
-                    }
+        // Some control keys should always generate WM_CHAR for expected text/edit behavior.
+        if (outputVK == VK_RETURN) {
+            outChar = L'\r';
+        } else if (outputVK == VK_TAB) {
+            outChar = L'\t';
+        } else if (outputVK == VK_BACK) {
+            outChar = L'\b';
+        } else {
+            BYTE ks[256] = {};
+            if (GetKeyboardState(ks)) {
+                // If the source key is a modifier that we're consuming, clear it from the keyboard state
+                // so it doesn't accidentally affect character translation (e.g. Shift -> capital letters).
+                if (rebind.fromKey == VK_SHIFT || rebind.fromKey == VK_LSHIFT || rebind.fromKey == VK_RSHIFT) {
+                    ks[VK_SHIFT] = 0;
+                    ks[VK_LSHIFT] = 0;
+                    ks[VK_RSHIFT] = 0;
+                } else if (rebind.fromKey == VK_CONTROL || rebind.fromKey == VK_LCONTROL || rebind.fromKey == VK_RCONTROL) {
+                    ks[VK_CONTROL] = 0;
+                    ks[VK_LCONTROL] = 0;
+                    ks[VK_RCONTROL] = 0;
+                } else if (rebind.fromKey == VK_MENU || rebind.fromKey == VK_LMENU || rebind.fromKey == VK_RMENU) {
+                    ks[VK_MENU] = 0;
+                    ks[VK_LMENU] = 0;
+                    ks[VK_RMENU] = 0;
                 }
 
-                if (outChar != 0) {
-                    const UINT charMsg = isSystemKeyMsg ? WM_SYSCHAR : WM_CHAR;
-                    CallWindowProc(g_originalWndProc, hWnd, charMsg, static_cast<WPARAM>(outChar), newLParam);
-                }
+                (void)TryTranslateVkToCharWithKeyboardState(outputVK, ks, outChar);
             }
+        }
 
-            return { true, keyResult };
+        if (outChar != 0) {
+            const UINT charMsg = isSystemKeyMsg ? WM_SYSCHAR : WM_CHAR;
+            CallWindowProc(g_originalWndProc, hWnd, charMsg, static_cast<WPARAM>(outChar), newLParam);
         }
     }
-    return { false, 0 };
+
+    return { true, keyResult };
 }
 
 InputHandlerResult HandleCharRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -1558,8 +1355,7 @@ InputHandlerResult HandleCharRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPAR
                 if (!TryTranslateVkToChar(outputVK, false, outputChar) || outputChar == 0) { continue; }
             }
 
-            Log("[REBIND WM_CHAR] Remapping char code " + std::to_string(static_cast<unsigned int>(inputChar)) + " -> " +
-                std::to_string(static_cast<unsigned int>(outputChar)));
+            LOG_FMT("[REBIND WM_CHAR] Remapping char code {} -> {}", static_cast<unsigned int>(inputChar), static_cast<unsigned int>(outputChar));
 
             return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, outputChar, lParam) };
         }
@@ -1597,6 +1393,30 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
         break;
     }
 
+    // Republish window geometry for hkglViewport once the window has actually moved/resized
+    // (WM_MOVING/WM_SIZING fire before the change lands, so they're left to the logic thread)
+    switch (uMsg) {
+    case WM_MOVE:
+    case WM_SIZE:
+    case WM_WINDOWPOSCHANGED:
+    case WM_DPICHANGED:
+    case WM_DISPLAYCHANGE:
+        RefreshCachedWindowGeometry();
+        break;
+    default:
+        break;
+    }
+
+    // Keep the message-stream key state honest across focus changes: key-ups while unfocused never arrive here
+    if (uMsg == WM_KILLFOCUS) {
+        s_keyState.Clear();
+    } else if (uMsg == WM_SETFOCUS) {
+        s_keyState.Resync();
+    }
+
+    // Decode key/button messages once and probe the hotkey table
+    const KeyMessageInfo key = DecodeKeyMessage(uMsg, wParam, lParam);
+
     InputHandlerResult result;
 
     // --- Phase 1: Early Processing ---
@@ -1610,13 +1430,15 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     if (result.consumed) return result.result;
 
     // This needs to run even in windowed mode (before HandleNonFullscreenCheck returns early)
-    result = HandleBorderlessToggle(hWnd, uMsg, wParam, lParam);
+    result = HandleBorderlessToggle(hWnd, uMsg, wParam, lParam, key);
     if (result.consumed) return result.result;
 
     // Overlay visibility hotkeys should work even in windowed mode
-    result = HandleImageOverlaysToggle(hWnd, uMsg, wParam, lParam);
+    result = HandleImageOverlaysToggle(hWnd, uMsg, wParam, lParam, key);
+    if (result.consumed) return result.result;
+    result = HandleWindowOverlaysToggle(hWnd, uMsg, wParam, lParam, key);
     if (result.consumed) return result.result;
-    result = HandleWindowOverlaysToggle(hWnd, uMsg, wParam, lParam);
+    result = HandleTraceDumpHotkey(hWnd, uMsg, wParam, lParam, key);
     if (result.consumed) return result.result;
 
     result = HandleNonFullscreenCheck(hWnd, uMsg, wParam, lParam);
@@ -1636,10 +1458,10 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     if (result.consumed) return result.result;
 
     // --- Phase 4: Get Current State (lock-free) ---
-    // Read mode ID from double-buffer atomically
-    std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+    // Current mode name by reference into the intern table (no per-message copy)
+    const std::string& currentModeId = ModeIdName(g_currentModeHandle.load(std::memory_order_acquire));
 
-    std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
+    std::string localGameState = GetCurrentGameState();
 
     // --- Phase 5: Cursor Handling ---
     result = HandleSetCursor(hWnd, uMsg, wParam, lParam, localGameState);
@@ -1654,7 +1476,7 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     result = HandleImGuiInput(hWnd, uMsg, wParam, lParam);
     if (result.consumed) return result.result;
 
-    result = HandleGuiToggle(hWnd, uMsg, wParam, lParam);
+    result = HandleGuiToggle(hWnd, uMsg, wParam, lParam, key);
     if (result.consumed) return result.result;
 
     // --- Phase 7: Window Overlay Interaction ---
@@ -1672,7 +1494,7 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     if (result.consumed) return result.result;
 
     // --- Phase 9: Hotkeys ---
-    result = HandleHotkeys(hWnd, uMsg, wParam, lParam, currentModeId, localGameState);
+    result = HandleHotkeys(hWnd, uMsg, wParam, lParam, key, currentModeId, localGameState);
     if (result.consumed) return result.result;
 
     // --- Phase 10: Mouse Coordinate Translation ---
@@ -1680,7 +1502,7 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     if (result.consumed) return result.result;
 
     // --- Phase 11: Key Rebinding ---
-    result = HandleKeyRebinding(hWnd, uMsg, wParam, lParam);
+    result = HandleKeyRebinding(hWnd, uMsg, wParam, lParam, key);
     if (result.consumed) return result.result;
 
     result = HandleCharRebinding(hWnd, uMsg, wParam, lParam);
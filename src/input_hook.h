@@ -3,6 +3,8 @@
 #include <Windows.h>
 #include <string>
 
+#include "hotkey_table.h"
+
 // Forward declaration
 extern WNDPROC g_originalWndProc;
 
@@ -12,6 +14,19 @@ struct InputHandlerResult {
     LRESULT result; // Return value if consumed
 };
 
+// Key or mouse-button message decoded once per message, with its hotkey table bucket (a single probe)
+struct KeyMessageInfo {
+    DWORD rawVk = 0; // 0 = not a key/button message
+    DWORD vk = 0;    // Normalized (left/right variants for Ctrl/Shift/Alt)
+    bool isKeyDown = false;
+    bool isMouseButton = false;
+
+    // Config snapshot the table belongs to (held for the whole message); null before the first publish
+    std::shared_ptr<const Config> config;
+    const HotkeyDispatchTable* hotkeys = nullptr;
+    HotkeyDispatchTable::Bucket bucket;
+};
+
 // Individual message handlers - each returns whether it consumed the message
 // All handlers include profiling for performance monitoring
 
@@ -49,14 +64,17 @@ InputHandlerResult HandleDestroy(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
 InputHandlerResult HandleImGuiInput(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
 // Handle GUI toggle hotkey
-InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+InputHandlerResult HandleGuiToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
 
 // Handle borderless-windowed fullscreen toggle hotkey
-InputHandlerResult HandleBorderlessToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+InputHandlerResult HandleBorderlessToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
 
 // Handle overlay visibility toggle hotkeys
-InputHandlerResult HandleImageOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-InputHandlerResult HandleWindowOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+InputHandlerResult HandleImageOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
+InputHandlerResult HandleWindowOverlaysToggle(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
+
+// Handle profiler flight recorder dump hotkey
+InputHandlerResult HandleTraceDumpHotkey(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
 
 // Handle keyboard input for focused overlay
 InputHandlerResult HandleWindowOverlayKeyboard(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
@@ -71,14 +89,14 @@ InputHandlerResult HandleGuiInputBlocking(UINT uMsg);
 InputHandlerResult HandleActivate(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const std::string& currentModeId);
 
 // Handle hotkey processing
-InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const std::string& currentModeId,
-                                 const std::string& gameState);
+InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key,
+                                 const std::string& currentModeId, const std::string& gameState);
 
 // Handle mouse coordinate translation
 InputHandlerResult HandleMouseCoordinateTranslationPhase(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM& lParam);
 
 // Handle key rebinding for WM_KEYDOWN/WM_KEYUP
-InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam, const KeyMessageInfo& key);
 
 // Handle WM_CHAR key rebinding
 InputHandlerResult HandleCharRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
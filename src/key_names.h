@@ -0,0 +1,25 @@
+#pragma once
+
+// ============================================================================
+// KEY_NAMES.H - Display names for virtual keys and key combos
+// ============================================================================
+// VkToString is defined in gui.cpp (it falls back to GetKeyNameTextA for keys
+// without a fixed name). Declared here so modules that only need combo names
+// (the hotkey table) don't pull in the GUI header.
+// ============================================================================
+
+#include <Windows.h>
+
+#include <string>
+#include <vector>
+
+std::string VkToString(DWORD vk);
+
+inline std::string GetKeyComboString(const std::vector<DWORD>& keys) {
+    std::string keyStr;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        keyStr += VkToString(keys[k]);
+        if (k < keys.size() - 1) keyStr += "+";
+    }
+    return keyStr;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// ============================================================================
+// LATENCY_HISTOGRAM.H - Fixed-memory log-linear latency histogram (HDR-style)
+// ============================================================================
+// Values (nanoseconds) below 2 * SUB_BUCKETS are counted exactly. Above that,
+// every power of two is split into SUB_BUCKETS equal buckets, so a bucket is
+// never wider than 1/SUB_BUCKETS of its values (~6%) and percentiles keep that
+// relative precision from nanoseconds up to a minute with 528 counters.
+// Counters are 64-bit: a long session (or many merged ones) can pass 2^32
+// samples in a hot bucket, and a wrapped counter would make every
+// percentile collapse to the maximum.
+//
+// Record, Merge and Reset are plain loops over a fixed array - no allocation,
+// no locks. An instance has a single owner thread; other threads ask the owner
+// for resets or snapshots (see Profiler::RequestHistogramReset()).
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_VALUE_BITS = 36; // 2^36 ns ~ 68.7 s; longer values are counted in the last bucket
+    static constexpr uint64_t MAX_VALUE = (1ull << MAX_VALUE_BITS) - 1;
+    static constexpr uint32_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void Record(uint64_t valueNs) {
+        valueNs = (std::min)(valueNs, MAX_VALUE);
+        m_counts[BucketIndex(valueNs)]++;
+        m_totalCount++;
+        m_sum += valueNs;
+        m_max = (std::max)(m_max, valueNs);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) { m_counts[i] += other.m_counts[i]; }
+        m_totalCount += other.m_totalCount;
+        m_sum += other.m_sum;
+        m_max = (std::max)(m_max, other.m_max);
+    }
+
+    void Reset() { *this = LatencyHistogram{}; }
+
+    uint64_t TotalCount() const { return m_totalCount; }
+    uint64_t MaxValue() const { return m_max; }
+    double Mean() const { return m_totalCount > 0 ? static_cast<double>(m_sum) / static_cast<double>(m_totalCount) : 0.0; }
+
+    // Smallest recorded value such that `percentile` percent of all values are <= it, reported as the middle of its
+    // bucket (never above the recorded maximum). 0 when empty.
+    uint64_t ValueAtPercentile(double percentile) const {
+        if (m_totalCount == 0) return 0;
+        const double fraction = (std::min)((std::max)(percentile, 0.0), 100.0) / 100.0;
+        const uint64_t rank = (std::max)(uint64_t{ 1 }, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(m_totalCount))));
+        if (rank >= m_totalCount) return m_max;
+
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_counts[i];
+            if (seen >= rank) return (std::min)(BucketLow(i) + (BucketWidth(i) - 1) / 2, m_max);
+        }
+        return m_max;
+    }
+
+    // Values above thresholdNs, to bucket precision: the bucket containing the threshold is not counted
+    uint64_t CountAbove(uint64_t thresholdNs) const {
+        if (thresholdNs >= MAX_VALUE) return 0;
+        uint64_t count = 0;
+        for (uint32_t i = BucketIndex(thresholdNs) + 1; i < BUCKET_COUNT; ++i) { count += m_counts[i]; }
+        return count;
+    }
+
+private:
+    static uint32_t HighestBit(uint64_t v) { // v != 0
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return static_cast<uint32_t>(index);
+#else
+        return 63u - static_cast<uint32_t>(__builtin_clzll(v));
+#endif
+    }
+    static uint32_t BucketIndex(uint64_t value) {
+        const uint32_t msb = value != 0 ? HighestBit(value) : 0;
+        const uint32_t shift = msb > SUB_BUCKET_BITS ? msb - SUB_BUCKET_BITS : 0;
+        return shift * SUB_BUCKETS + static_cast<uint32_t>(value >> shift);
+    }
+    static uint32_t BucketShift(uint32_t index) { return index < 2 * SUB_BUCKETS ? 0 : index / SUB_BUCKETS - 1; }
+    static uint64_t BucketLow(uint32_t index) {
+        const uint32_t shift = BucketShift(index);
+        return static_cast<uint64_t>(index - shift * SUB_BUCKETS) << shift;
+    }
+    static uint64_t BucketWidth(uint32_t index) { return 1ull << BucketShift(index); }
+
+    std::array<uint64_t, BUCKET_COUNT> m_counts = {};
+    uint64_t m_totalCount = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_max = 0;
+};
@@ -0,0 +1,155 @@
+// ============================================================================
+// LOG_RECORD.CPP - Writer-side formatting of log records
+// ============================================================================
+
+#include "log_record.h"
+
+#include <cstdio>
+#include <ctime>
+
+std::atomic<uint32_t> g_logCategoryMask{ 0 };
+
+namespace {
+
+template <typename T> T ReadValue(const char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+void AppendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | ((codePoint >> 18) & 0x07));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Appends the argument at *offset and advances past it. spec is the text between "{:" and "}" (may be empty):
+// ".Nf" for fixed decimals, "x" for hex.
+void AppendArg(const LogRecord& record, size_t& offset, const char* spec, size_t specLength, std::string& out) {
+    const LogArgType type = static_cast<LogArgType>(record.payload[offset]);
+    const char* value = record.payload + offset + 1;
+    const bool hex = specLength == 1 && spec[0] == 'x';
+    char buffer[64];
+    switch (type) {
+    case LogArgType::Int:
+        std::snprintf(buffer, sizeof(buffer), hex ? "%llx" : "%lld", static_cast<long long>(ReadValue<int64_t>(value)));
+        out += buffer;
+        offset += 1 + sizeof(int64_t);
+        break;
+    case LogArgType::UInt:
+        std::snprintf(buffer, sizeof(buffer), hex ? "%llx" : "%llu", static_cast<unsigned long long>(ReadValue<uint64_t>(value)));
+        out += buffer;
+        offset += 1 + sizeof(uint64_t);
+        break;
+    case LogArgType::Float: {
+        const double v = ReadValue<double>(value);
+        if (specLength == 3 && spec[0] == '.' && spec[1] >= '0' && spec[1] <= '9' && spec[2] == 'f') {
+            std::snprintf(buffer, sizeof(buffer), "%.*f", spec[1] - '0', v);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%g", v);
+        }
+        out += buffer;
+        offset += 1 + sizeof(double);
+        break;
+    }
+    case LogArgType::Bool:
+        out += value[0] ? "true" : "false";
+        offset += 1 + sizeof(uint8_t);
+        break;
+    case LogArgType::Char:
+        AppendUtf8(out, ReadValue<uint32_t>(value));
+        offset += 1 + sizeof(uint32_t);
+        break;
+    case LogArgType::String: {
+        const uint16_t length = ReadValue<uint16_t>(value);
+        out.append(value + sizeof(uint16_t), length);
+        offset += 1 + sizeof(uint16_t) + length;
+        break;
+    }
+    default:
+        offset = record.payloadSize; // Corrupt payload: stop reading arguments
+        break;
+    }
+}
+
+void AppendRecordText(const LogRecord& record, std::string& out) {
+    if (!record.site) {
+        if (record.overflowText) {
+            out += *record.overflowText;
+        } else {
+            out.append(record.payload, record.payloadSize);
+        }
+        return;
+    }
+
+    size_t offset = 0;
+    uint32_t argsLeft = record.argCount;
+    for (const char* p = record.site->format; *p; ++p) {
+        if (p[0] == '{' && p[1] == '{') {
+            out += '{';
+            ++p;
+        } else if (p[0] == '}' && p[1] == '}') {
+            out += '}';
+            ++p;
+        } else if (p[0] == '{') {
+            const char* close = std::strchr(p, '}');
+            if (!close) {
+                out += p;
+                break;
+            }
+            const char* spec = p[1] == ':' ? p + 2 : close;
+            if (argsLeft > 0 && offset < record.payloadSize) {
+                AppendArg(record, offset, spec, static_cast<size_t>(close - spec), out);
+                argsLeft--;
+            } else {
+                out += record.truncated ? "..." : "{?}";
+            }
+            p = close;
+        } else {
+            out += *p;
+        }
+    }
+    if (record.truncated) out += " [truncated]";
+}
+
+} // namespace
+
+void AppendLogRecordLine(const LogRecord& record, std::string& out) {
+    // Local time is converted once per second; lines within the same second only format the milliseconds
+    thread_local int64_t cachedSecond = -1;
+    thread_local char cachedClock[16] = {};
+
+    using namespace std::chrono;
+    const system_clock::time_point time{ system_clock::duration{ record.timestamp } };
+    const int64_t sinceEpochMs = duration_cast<milliseconds>(time.time_since_epoch()).count();
+    const int64_t second = sinceEpochMs / 1000;
+    if (second != cachedSecond) {
+        const std::time_t t = static_cast<std::time_t>(second);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        std::strftime(cachedClock, sizeof(cachedClock), "%H:%M:%S", &local);
+        cachedSecond = second;
+    }
+
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "[%s.%03d] ", cachedClock, static_cast<int>(sinceEpochMs % 1000));
+    out += prefix;
+    AppendRecordText(record, out);
+    out += '\n';
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+// ============================================================================
+// LOG_RECORD.H - Fixed-size log records with deferred formatting
+// ============================================================================
+// Logging threads (often the game, render or window thread) never format or
+// allocate: a log call writes one LogRecord into the lock-free log ring and
+// the writer thread turns records into text in batches (see utils.cpp).
+//
+// A record holds a raw timestamp, a format site and a small argument payload:
+//
+//   LOG_FMT("Resized copy textures to {}x{}", texW, texH);
+//   LOG_FMT_CAT(LogCat::TextureOps, "Capture plan {} region(s)", count);
+//
+// The site is a function-local static holding the format string; "{}" takes
+// the next argument, "{:.Nf}" prints it with N decimals, "{:x}" in hex and
+// "{{" / "}}" are literal braces. Arguments are integers, floating point,
+// bool, characters and strings (const char*, std::string, string_view).
+// Strings are copied into the payload and cut when it is full, so long
+// strings still cost no allocation - the line is marked "[truncated]".
+//
+// Log(std::string) stores preformatted text in the same payload; only text
+// longer than LOG_RECORD_PAYLOAD_BYTES is copied to the heap.
+//
+// Categories are bits in an atomic mask mirrored from g_config.debug by
+// UpdateLogCategoryMask(), so any thread can test them without reading
+// g_config. LOG_FMT_CAT evaluates its arguments only if the category is on.
+// ============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Debug > Advanced Logging categories
+enum class LogCat : uint32_t {
+    ModeSwitch,
+    Animation,
+    Hotkey,
+    Obs,
+    WindowOverlay,
+    FileMonitor,
+    ImageMonitor,
+    Performance,
+    TextureOps,
+    Gui,
+    Init,
+    CursorTextures,
+    HookChain, // No settings toggle: hook chain tracing stays off unless enabled in code
+    Count
+};
+
+extern std::atomic<uint32_t> g_logCategoryMask;
+
+inline bool IsLogCategoryEnabled(LogCat category) {
+    return (g_logCategoryMask.load(std::memory_order_relaxed) >> static_cast<uint32_t>(category)) & 1u;
+}
+
+// Format site: one per LOG_FMT call site (function-local static)
+struct LogSite {
+    const char* format;
+};
+
+enum class LogArgType : uint8_t { Int, UInt, Float, Bool, Char, String };
+
+static constexpr size_t LOG_RECORD_SIZE = 256;
+static constexpr size_t LOG_RECORD_HEADER_BYTES = 32;
+static constexpr size_t LOG_RECORD_PAYLOAD_BYTES = LOG_RECORD_SIZE - LOG_RECORD_HEADER_BYTES;
+
+// Trivially copyable so ring slots are plain memory. overflowText is owned by whoever holds the record last: the ring
+// consumer frees it after formatting, a failed push frees it on the producer side.
+struct LogRecord {
+    int64_t timestamp = 0;              // std::chrono::system_clock ticks
+    const LogSite* site = nullptr;      // Null: payload (or overflowText) is preformatted text
+    std::string* overflowText = nullptr; // Preformatted text longer than the payload
+    uint16_t payloadSize = 0;
+    uint8_t argCount = 0;
+    uint8_t truncated = 0; // A string argument was cut short
+    uint8_t reserved[4] = {};
+    char payload[LOG_RECORD_PAYLOAD_BYTES];
+};
+static_assert(sizeof(LogRecord) == LOG_RECORD_SIZE, "LogRecord layout changed");
+static_assert(std::is_trivially_copyable_v<LogRecord>, "LogRecord must be trivially copyable");
+
+inline int64_t LogTimestampNow() { return std::chrono::system_clock::now().time_since_epoch().count(); }
+
+// Pushes the record into the log ring (utils.cpp). Dropped, and counted, when the ring is full.
+void SubmitLogRecord(const LogRecord& record);
+
+// Preformatted text (utils.cpp). Declared here rather than in utils.h so modules that only log need no Win32 headers.
+void Log(const std::string& message);
+void Log(const std::wstring& message);
+
+// Appends "[HH:MM:SS.mmm] <text>\n" for the record to out. Writer side (one thread at a time).
+void AppendLogRecordLine(const LogRecord& record, std::string& out);
+
+namespace LogRecordDetail {
+
+inline bool Reserve(LogRecord& record, size_t bytes) {
+    if (record.payloadSize + bytes > LOG_RECORD_PAYLOAD_BYTES) {
+        record.truncated = 1;
+        return false;
+    }
+    return true;
+}
+
+inline void PutScalar(LogRecord& record, LogArgType type, const void* value, size_t size) {
+    if (!Reserve(record, 1 + size)) return;
+    record.payload[record.payloadSize] = static_cast<char>(type);
+    std::memcpy(record.payload + record.payloadSize + 1, value, size);
+    record.payloadSize = static_cast<uint16_t>(record.payloadSize + 1 + size);
+    record.argCount++;
+}
+
+// Strings: type byte, uint16 length, bytes. Cut to the remaining space.
+inline void PutString(LogRecord& record, const char* text, size_t length) {
+    if (!Reserve(record, 3)) return;
+    const size_t room = LOG_RECORD_PAYLOAD_BYTES - record.payloadSize - 3;
+    if (length > room) {
+        length = room;
+        record.truncated = 1;
+    }
+    const uint16_t length16 = static_cast<uint16_t>(length);
+    char* out = record.payload + record.payloadSize;
+    out[0] = static_cast<char>(LogArgType::String);
+    std::memcpy(out + 1, &length16, sizeof(length16));
+    std::memcpy(out + 3, text, length);
+    record.payloadSize = static_cast<uint16_t>(record.payloadSize + 3 + length);
+    record.argCount++;
+}
+
+template <typename T> void Put(LogRecord& record, const T& value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        const uint8_t v = value ? 1 : 0;
+        PutScalar(record, LogArgType::Bool, &v, sizeof(v));
+    } else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, wchar_t> || std::is_same_v<U, char16_t>) {
+        const uint32_t v = static_cast<uint32_t>(value);
+        PutScalar(record, LogArgType::Char, &v, sizeof(v));
+    } else if constexpr (std::is_enum_v<U>) {
+        Put(record, static_cast<std::underlying_type_t<U>>(value));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        const int64_t v = value;
+        PutScalar(record, LogArgType::Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U>) {
+        const uint64_t v = value;
+        PutScalar(record, LogArgType::UInt, &v, sizeof(v));
+    } else if constexpr (std::is_floating_point_v<U>) {
+        const double v = static_cast<double>(value);
+        PutScalar(record, LogArgType::Float, &v, sizeof(v));
+    } else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>) {
+        PutString(record, value, strnlen(value, sizeof(T))); // Literals and char buffers: never null, bounded by the array
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        if (value) {
+            PutString(record, value, std::strlen(value));
+        } else {
+            PutString(record, "(null)", 6);
+        }
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        const std::string_view view = value;
+        PutString(record, view.data(), view.size());
+    } else if constexpr (std::is_pointer_v<U>) {
+        const uint64_t v = reinterpret_cast<uintptr_t>(value);
+        PutScalar(record, LogArgType::UInt, &v, sizeof(v));
+    } else {
+        static_assert(sizeof(U) == 0, "Unsupported LOG_FMT argument type");
+    }
+}
+
+template <typename... Args> void Submit(const LogSite& site, const Args&... args) {
+    LogRecord record;
+    record.timestamp = LogTimestampNow();
+    record.site = &site;
+    (Put(record, args), ...);
+    SubmitLogRecord(record);
+}
+
+} // namespace LogRecordDetail
+
+#define LOG_FMT(format, ...)                                                                                                     \
+    do {                                                                                                                         \
+        static const LogSite _logSite{ format };                                                                                \
+        LogRecordDetail::Submit(_logSite, ##__VA_ARGS__);                                                                        \
+    } while (0)
+
+#define LOG_FMT_CAT(category, format, ...)                                                                                       \
+    do {                                                                                                                         \
+        if (IsLogCategoryEnabled(category)) LOG_FMT(format, ##__VA_ARGS__);                                                      \
+    } while (0)
@@ -1,6 +1,8 @@
 #include "logic_thread.h"
+#include "config_diff.h"
 #include "expression_parser.h"
 #include "gui.h"
+#include "mirror_stats.h"
 #include "mirror_thread.h"
 #include "profiler.h"
 #include "render.h"
@@ -22,8 +24,6 @@ extern std::atomic<HWND> g_minecraftHwnd;
 extern std::atomic<bool> g_configLoaded;
 extern Config g_config;
 
-extern std::string g_gameStateBuffers[2];
-extern std::atomic<int> g_currentGameStateIndex;
 
 extern std::atomic<bool> g_windowsMouseSpeedApplied;
 extern int g_originalWindowsMouseSpeed;
@@ -41,10 +41,9 @@ extern GameVersion g_gameVersion;
 // Forward declarations for functions in dllmain.cpp
 void ApplyWindowsMouseSpeed();
 
-// Double-buffered viewport cache for lock-free access by hkglViewport
-CachedModeViewport g_viewportModeCache[2];
-std::atomic<int> g_viewportModeCacheIndex{ 0 };
-static std::string s_lastCachedModeId; // Track which mode ID is cached
+// Viewport cache for lock-free access by hkglViewport
+VersionedSnapshot<CachedModeViewport> g_viewportModeCache;
+static ModeHandle s_lastCachedModeId = NO_MODE_HANDLE; // Track which mode is cached
 
 static bool s_wasInWorld = false;
 static int s_lastAppliedWindowsMouseSpeed = -1;
@@ -108,112 +107,203 @@ void InvalidateCachedScreenMetrics() {
     s_screenMetricsDirty.store(true, std::memory_order_relaxed);
 }
 
+// ============================================================================
+// WINDOW GEOMETRY CACHE
+// ============================================================================
+// Writers (window thread on move/size/display messages, logic thread every tick) skip the publish
+// entirely when nothing changed, so readers only ever retry across a real geometry change.
+
+static VersionedSnapshot<CachedWindowGeometry> s_windowGeometry;
+
+static std::atomic<uint64_t> s_cachedFullscreenChecksSinceRefresh{ 0 };
+static std::atomic<int64_t> s_fullscreenCheckSavedNs{ 0 };
+
+static bool SameRect(const RECT& a, const RECT& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+void RefreshCachedWindowGeometry() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    CachedWindowGeometry next;
+    next.hwnd = g_minecraftHwnd.load(std::memory_order_relaxed);
+    if (next.hwnd && GetWindowRect(next.hwnd, &next.windowRect)) {
+        if (!GetMonitorRectForWindow(next.hwnd, next.monitorRect)) {
+            // Same legacy primary-monitor fallback as IsFullscreen()
+            next.monitorRect = RECT{ 0, 0, GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN) };
+        }
+        next.isFullscreen = IsWindowRectFullscreen(next.windowRect, next.monitorRect);
+        next.valid = true;
+    }
+
+    s_windowGeometry.Update([&next](CachedWindowGeometry& current) {
+        const bool unchanged = current.valid == next.valid && current.hwnd == next.hwnd && current.isFullscreen == next.isFullscreen &&
+                               SameRect(current.windowRect, next.windowRect) && SameRect(current.monitorRect, next.monitorRect);
+        if (unchanged) return false;
+        current = next;
+        return true;
+    });
+
+    // Each cached check since the last refresh would have paid this query's cost; this refresh paid it once
+    const int64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    const uint64_t checks = s_cachedFullscreenChecksSinceRefresh.exchange(0, std::memory_order_relaxed);
+    s_fullscreenCheckSavedNs.fetch_add(static_cast<int64_t>(checks) * elapsedNs - elapsedNs, std::memory_order_relaxed);
+}
+
+bool GetCachedWindowGeometry(CachedWindowGeometry& out, uint64_t* outVersion) {
+    uint64_t version = 0;
+    out = s_windowGeometry.Load(version);
+    if (outVersion) { *outVersion = version; }
+    return out.valid;
+}
+
+bool IsFullscreenCached() {
+    CachedWindowGeometry geometry;
+    if (GetCachedWindowGeometry(geometry) && geometry.hwnd == g_minecraftHwnd.load(std::memory_order_relaxed)) {
+        return geometry.isFullscreen;
+    }
+    // Not populated yet (or the game window was replaced since the last refresh)
+    return IsFullscreen();
+}
+
+void CountCachedFullscreenCheck() { s_cachedFullscreenChecksSinceRefresh.fetch_add(1, std::memory_order_relaxed); }
+
+int64_t GetFullscreenCheckTimeSavedNs() { return s_fullscreenCheckSavedNs.load(std::memory_order_relaxed); }
+
 // Tracked for UpdateActiveMirrorConfigs - detect when active mirrors change
 static std::vector<std::string> s_lastActiveMirrorIds;
-static std::string s_lastMirrorConfigModeId;
-static uint64_t s_lastMirrorConfigSnapshotVersion = 0;
+static ModeHandle s_lastMirrorConfigModeId = NO_MODE_HANDLE;
+static ConfigChangeTracker s_mirrorConfigTracker;
+
+// Capture config for one active mirror: if it is part of a group in the current mode,
+// the group's output settings (position + per-item sizing) are applied on top.
+static MirrorConfig BuildActiveCaptureMirror(const Config& cfg, const ModeConfig& mode, const MirrorConfig& mirror) {
+    MirrorConfig activeMirror = mirror;
+    for (const auto& groupName : mode.mirrorGroupIds) {
+        const MirrorGroupConfig* groupPtr = GetMirrorGroupFromSnapshot(cfg, groupName);
+        if (!groupPtr) continue;
+        const auto& group = *groupPtr;
+        // Check if this mirror is in this group
+        for (const auto& item : group.mirrors) {
+            if (!item.enabled) continue; // Skip disabled items
+            if (item.mirrorId == mirror.name) {
+                // Calculate group position - use relative percentages if enabled
+                int groupX = group.output.x;
+                int groupY = group.output.y;
+                if (group.output.useRelativePosition) {
+                    int screenW = GetCachedScreenWidth();
+                    int screenH = GetCachedScreenHeight();
+                    groupX = static_cast<int>(group.output.relativeX * screenW);
+                    groupY = static_cast<int>(group.output.relativeY * screenH);
+                }
+                // Position from group + per-item offset
+                activeMirror.output.x = groupX + item.offsetX;
+                activeMirror.output.y = groupY + item.offsetY;
+                activeMirror.output.relativeTo = group.output.relativeTo;
+                activeMirror.output.useRelativePosition = group.output.useRelativePosition;
+                activeMirror.output.relativeX = group.output.relativeX;
+                activeMirror.output.relativeY = group.output.relativeY;
+                // Per-item sizing (multiply mirror scale by item percentages)
+                if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
+                    activeMirror.output.separateScale = true;
+                    float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
+                    float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
+                    activeMirror.output.scaleX = baseScaleX * item.widthPercent;
+                    activeMirror.output.scaleY = baseScaleY * item.heightPercent;
+                }
+                break;
+            }
+        }
+    }
+    return activeMirror;
+}
+
+// True if the diff touches anything the capture thread uses for this active mirror
+static bool ActiveMirrorCaptureChanged(const ConfigChangeSet& changes, const ModeConfig& mode, const std::string& mirrorId) {
+    const ConfigElementChange* mirrorChange = ConfigChangeSet::Find(changes.mirrors, mirrorId);
+    if (mirrorChange && (mirrorChange->fields & ~MIRROR_CHANGE_APPEARANCE) != 0) return true; // Opacity is render-thread only
+    for (const auto& groupName : mode.mirrorGroupIds) {
+        if (ConfigChangeSet::Find(changes.mirrorGroups, groupName)) return true;
+    }
+    return false;
+}
 
-// Update mirror capture configs when active mirrors change (mode switch or config edit)
-// This was previously done on every frame in RenderModeInternal - now only when needed
+// Update mirror capture configs when active mirrors change (mode switch or config edit).
+// A changed set of active mirrors rebuilds every capture config; edits to mirrors that stay active
+// only replace those mirrors' configs, driven by the config diff.
 void UpdateActiveMirrorConfigs() {
     PROFILE_SCOPE_CAT("LT Mirror Configs", "Logic Thread");
 
-    // Use config snapshot for thread-safe access to modes/mirrors/mirrorGroups
-    auto cfgSnap = GetConfigSnapshot();
-    if (!cfgSnap) return;
-    const Config& cfg = *cfgSnap;
-
     // If neither mode nor config snapshot changed, skip all work.
     // This avoids rebuilding mirror lists 60 times/sec when nothing is changing.
-    const uint64_t snapVer = g_configSnapshotVersion.load(std::memory_order_acquire);
+    std::shared_ptr<const Config> cfgSnap;
+    ConfigChangeSet changes;
+    const bool configChanged = s_mirrorConfigTracker.Poll(cfgSnap, changes);
 
-    // Get current mode ID from double-buffer (lock-free)
-    std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+    // Get current mode (lock-free)
+    const ModeHandle currentModeId = g_currentModeHandle.load(std::memory_order_acquire);
+
+    if (!configChanged && currentModeId == s_lastMirrorConfigModeId) { return; }
+
+    // Use config snapshot for thread-safe access to modes/mirrors/mirrorGroups
+    if (!cfgSnap) cfgSnap = GetConfigSnapshot();
+    if (!cfgSnap) return;
+    const Config& cfg = *cfgSnap;
 
-    if (currentModeId == s_lastMirrorConfigModeId && snapVer == s_lastMirrorConfigSnapshotVersion) {
+    const ModeConfig* mode = GetModeFromSnapshot(cfg, currentModeId);
+    if (!mode) {
+        // The diff was consumed without applying it: force a full rebuild once the mode resolves again
+        s_lastActiveMirrorIds.clear();
+        s_lastMirrorConfigModeId = NO_MODE_HANDLE;
         return;
     }
-    const ModeConfig* mode = GetModeFromSnapshot(cfg, currentModeId);
-    if (!mode) { return; }
 
     // Collect all mirror IDs from both direct mirrors and mirror groups
     std::vector<std::string> currentMirrorIds = mode->mirrorIds;
     for (const auto& groupName : mode->mirrorGroupIds) {
-        for (const auto& group : cfg.mirrorGroups) {
-            if (group.name == groupName) {
-                for (const auto& item : group.mirrors) {
-                    if (std::find(currentMirrorIds.begin(), currentMirrorIds.end(), item.mirrorId) == currentMirrorIds.end()) {
-                        currentMirrorIds.push_back(item.mirrorId);
-                    }
-                }
+        const MirrorGroupConfig* group = GetMirrorGroupFromSnapshot(cfg, groupName);
+        if (!group) continue;
+        for (const auto& item : group->mirrors) {
+            if (std::find(currentMirrorIds.begin(), currentMirrorIds.end(), item.mirrorId) == currentMirrorIds.end()) {
+                currentMirrorIds.push_back(item.mirrorId);
+            }
+        }
+    }
+
+    // A referenced mirror that appeared or disappeared changes the capture list even though the IDs didn't
+    bool membershipChanged = currentMirrorIds != s_lastActiveMirrorIds;
+    if (!membershipChanged && configChanged) {
+        for (const auto& change : changes.mirrors) {
+            if (change.kind == ConfigChangeKind::Modified) continue;
+            if (std::find(currentMirrorIds.begin(), currentMirrorIds.end(), change.name) != currentMirrorIds.end()) {
+                membershipChanged = true;
                 break;
             }
         }
     }
 
-    // Only update if the list of active mirrors changed
-    if (currentMirrorIds != s_lastActiveMirrorIds) {
+    if (membershipChanged) {
         // Collect MirrorConfig objects for UpdateMirrorCaptureConfigs
         std::vector<MirrorConfig> activeMirrorsForCapture;
         activeMirrorsForCapture.reserve(currentMirrorIds.size());
         for (const auto& mirrorId : currentMirrorIds) {
-            for (const auto& mirror : cfg.mirrors) {
-                if (mirror.name == mirrorId) {
-                    MirrorConfig activeMirror = mirror;
-
-                    // Check if this mirror is part of a group in the current mode
-                    // If so, apply the group's output settings (position + per-item sizing)
-                    for (const auto& groupName : mode->mirrorGroupIds) {
-                        for (const auto& group : cfg.mirrorGroups) {
-                            if (group.name == groupName) {
-                                // Check if this mirror is in this group
-                                for (const auto& item : group.mirrors) {
-                                    if (!item.enabled) continue; // Skip disabled items
-                                    if (item.mirrorId == mirrorId) {
-                                        // Calculate group position - use relative percentages if enabled
-                                        int groupX = group.output.x;
-                                        int groupY = group.output.y;
-                                        if (group.output.useRelativePosition) {
-                                            int screenW = GetCachedScreenWidth();
-                                            int screenH = GetCachedScreenHeight();
-                                            groupX = static_cast<int>(group.output.relativeX * screenW);
-                                            groupY = static_cast<int>(group.output.relativeY * screenH);
-                                        }
-                                        // Position from group + per-item offset
-                                        activeMirror.output.x = groupX + item.offsetX;
-                                        activeMirror.output.y = groupY + item.offsetY;
-                                        activeMirror.output.relativeTo = group.output.relativeTo;
-                                        activeMirror.output.useRelativePosition = group.output.useRelativePosition;
-                                        activeMirror.output.relativeX = group.output.relativeX;
-                                        activeMirror.output.relativeY = group.output.relativeY;
-                                        // Per-item sizing (multiply mirror scale by item percentages)
-                                        if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
-                                            activeMirror.output.separateScale = true;
-                                            float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
-                                            float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
-                                            activeMirror.output.scaleX = baseScaleX * item.widthPercent;
-                                            activeMirror.output.scaleY = baseScaleY * item.heightPercent;
-                                        }
-                                        break;
-                                    }
-                                }
-                                break;
-                            }
-                        }
-                    }
-
-                    activeMirrorsForCapture.push_back(activeMirror);
-                    break;
-                }
-            }
+            const MirrorConfig* mirrorPtr = GetMirrorFromSnapshot(cfg, mirrorId);
+            if (!mirrorPtr) continue;
+            activeMirrorsForCapture.push_back(BuildActiveCaptureMirror(cfg, *mode, *mirrorPtr));
         }
         UpdateMirrorCaptureConfigs(activeMirrorsForCapture);
         s_lastActiveMirrorIds = currentMirrorIds;
+    } else if (configChanged) {
+        for (const auto& mirrorId : currentMirrorIds) {
+            if (!ActiveMirrorCaptureChanged(changes, *mode, mirrorId)) continue;
+            const MirrorConfig* mirrorPtr = GetMirrorFromSnapshot(cfg, mirrorId);
+            if (!mirrorPtr) continue;
+            UpdateMirrorCaptureConfig(BuildActiveCaptureMirror(cfg, *mode, *mirrorPtr));
+        }
     }
 
     // Remember what we processed this tick.
     s_lastMirrorConfigModeId = currentModeId;
-    s_lastMirrorConfigSnapshotVersion = snapVer;
 }
 
 void UpdateCachedScreenMetrics() {
@@ -280,8 +370,8 @@ int GetCachedScreenHeight() {
 void UpdateCachedViewportMode() {
     PROFILE_SCOPE_CAT("LT Viewport Cache", "Logic Thread");
 
-    // Read current mode ID from double-buffer (lock-free)
-    std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+    // Read current mode (lock-free)
+    const ModeHandle currentModeId = g_currentModeHandle.load(std::memory_order_acquire);
 
     // Always update cache when GUI is open (user may be editing width/height/x/y)
     // Also force periodic refresh every 60 ticks (~1 second) as a safety net
@@ -298,10 +388,7 @@ void UpdateCachedViewportMode() {
     if (!cfgSnap) return; // Config not yet published
     const ModeConfig* mode = GetModeFromSnapshot(*cfgSnap, currentModeId);
 
-    // Write to inactive buffer
-    int nextIndex = 1 - g_viewportModeCacheIndex.load(std::memory_order_relaxed);
-    CachedModeViewport& cache = g_viewportModeCache[nextIndex];
-
+    CachedModeViewport cache;
     if (mode) {
         cache.width = mode->width;
         cache.height = mode->height;
@@ -311,12 +398,9 @@ void UpdateCachedViewportMode() {
         cache.stretchWidth = mode->stretch.width;
         cache.stretchHeight = mode->stretch.height;
         cache.valid = true;
-    } else {
-        cache.valid = false;
     }
 
-    // Atomic swap to make new cache visible
-    g_viewportModeCacheIndex.store(nextIndex, std::memory_order_release);
+    g_viewportModeCache.Publish(cache);
     s_lastCachedModeId = currentModeId;
 }
 
@@ -347,7 +431,7 @@ void CheckWorldExitReset() {
     PROFILE_SCOPE_CAT("LT World Exit Check", "Logic Thread");
 
     // Get current game state from lock-free buffer
-    std::string currentGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
+    std::string currentGameState = GetCurrentGameState();
     bool isInWorld = (currentGameState.find("inworld") != std::string::npos);
 
     // Transitioning from "in world" to "not in world" - reset all secondary modes
@@ -397,8 +481,8 @@ void ProcessPendingModeSwitch() {
         SwitchToMode(toModeId, "Preview (animated)");
     } else {
         // Normal mode switch
-        LogCategory("gui", "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
-                               " (source: " + g_pendingModeSwitch.source + ")");
+        LogCategory(LogCat::Gui, "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
+                                     " (source: " + g_pendingModeSwitch.source + ")");
 
         // Use forceCut parameter instead of temporarily mutating g_config.modes
         // This avoids cross-thread mutation of g_config from the logic thread
@@ -444,48 +528,23 @@ void ProcessPendingDimensionChange() {
         const bool hasRelativeHeight = (mode->relativeHeight >= 0.0f && mode->relativeHeight <= 1.0f);
         if (!hasRelativeWidth && !hasRelativeHeight) { mode->useRelativeSize = false; }
 
-        // Preemptive mode always copies EyeZoom resolution.
-        // If EyeZoom was edited (or if Preemptive somehow got edited), resync Preemptive now.
-        ModeConfig* eyezoomMode = GetModeMutable("EyeZoom");
-        ModeConfig* preemptiveMode = GetModeMutable("Preemptive");
-        bool preemptiveWasResynced = false;
-        if (eyezoomMode && preemptiveMode) {
-            // Force Preemptive to absolute sizing.
-            if (!preemptiveMode->widthExpr.empty() || !preemptiveMode->heightExpr.empty() || preemptiveMode->useRelativeSize ||
-                preemptiveMode->relativeWidth >= 0.0f || preemptiveMode->relativeHeight >= 0.0f) {
-                preemptiveMode->widthExpr.clear();
-                preemptiveMode->heightExpr.clear();
-                preemptiveMode->useRelativeSize = false;
-                preemptiveMode->relativeWidth = -1.0f;
-                preemptiveMode->relativeHeight = -1.0f;
-                preemptiveWasResynced = true;
-            }
-
-            if (preemptiveMode->width != eyezoomMode->width) {
-                preemptiveMode->width = eyezoomMode->width;
-                preemptiveWasResynced = true;
-            }
-            if (preemptiveMode->height != eyezoomMode->height) {
-                preemptiveMode->height = eyezoomMode->height;
-                preemptiveWasResynced = true;
-            }
-        }
-
-        // Post WM_SIZE if requested and this is the current mode
-        if (g_pendingDimensionChange.sendWmSize && g_currentModeId == g_pendingDimensionChange.modeId) {
-            HWND hwnd = g_minecraftHwnd.load();
-            if (hwnd) { PostMessage(hwnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(mode->width, mode->height)); }
-        }
+        // Re-evaluate everything that depends on this mode: expressions referencing its size, and Preemptive, which
+        // copies EyeZoom's resolution. If that resizes the current mode, the game window has to follow.
+        const std::string& currentModeId = ModeIdName(g_currentModeHandle.load(std::memory_order_acquire));
+        const ModeConfig* currentMode = GetMode(currentModeId);
+        const int currentWidthBefore = currentMode ? currentMode->width : 0;
+        const int currentHeightBefore = currentMode ? currentMode->height : 0;
+        RecalculateExpressionDimensions();
+        currentMode = GetMode(currentModeId);
 
-        // Special case: changing EyeZoom dimensions also changes Preemptive (it mirrors EyeZoom resolution).
-        if (g_pendingDimensionChange.sendWmSize && g_currentModeId == "Preemptive" && g_pendingDimensionChange.modeId == "EyeZoom" &&
-            preemptiveMode) {
+        // Post WM_SIZE if requested and the current mode was edited or resized as a dependent
+        if (g_pendingDimensionChange.sendWmSize && currentMode &&
+            (EqualsIgnoreCase(currentModeId, g_pendingDimensionChange.modeId) || currentMode->width != currentWidthBefore ||
+             currentMode->height != currentHeightBefore)) {
             HWND hwnd = g_minecraftHwnd.load();
-            if (hwnd) { PostMessage(hwnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(preemptiveMode->width, preemptiveMode->height)); }
+            if (hwnd) { PostMessage(hwnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(currentMode->width, currentMode->height)); }
         }
 
-        if (preemptiveWasResynced) { g_configIsDirty = true; }
-
         g_configIsDirty = true;
     }
 
@@ -503,7 +562,7 @@ void CheckGameStateReset() {
     if (!IsResolutionChangeSupported(g_gameVersion)) { return; }
 
     // Get current game state from lock-free buffer
-    std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
+    std::string localGameState = GetCurrentGameState();
 
     // Check if transitioning from non-wall/title/waiting to wall/title/waiting
     if (isWallTitleOrWaiting(localGameState) && !isWallTitleOrWaiting(s_previousGameStateForReset)) {
@@ -540,7 +599,8 @@ static void CheckAutoBorderless() {
 }
 
 static void LogicThreadFunc() {
-    LogCategory("init", "[LogicThread] Started");
+    LogCategory(LogCat::Init, "[LogicThread] Started");
+    Profiler::GetInstance().SetThreadName("Logic");
 
     // Target ~60Hz tick rate (approximately 16.67ms per tick)
     const auto tickInterval = std::chrono::milliseconds(16);
@@ -563,6 +623,7 @@ static void LogicThreadFunc() {
 
         // Run all logic checks
         UpdateCachedScreenMetrics();
+        RefreshCachedWindowGeometry();
         UpdateCachedViewportMode();
         UpdateActiveMirrorConfigs();
         PollObsGraphicsHook();
@@ -572,6 +633,7 @@ static void LogicThreadFunc() {
         ProcessPendingDimensionChange();
         CheckGameStateReset();
         CheckAutoBorderless();
+        WriteMirrorContentStatsFile();
 
         // Sleep for remaining time in tick
         auto tickEnd = std::chrono::steady_clock::now();
@@ -594,7 +656,7 @@ void StartLogicThread() {
     g_logicThread = std::thread(LogicThreadFunc);
     g_logicThreadRunning.store(true);
 
-    LogCategory("init", "[LogicThread] Logic thread started");
+    LogCategory(LogCat::Init, "[LogicThread] Logic thread started");
 }
 
 void StopLogicThread() {
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <Windows.h>
+
 #include <atomic>
+#include <cstdint>
 #include <string>
 
+#include "versioned_snapshot.h"
+
 // Thread runs independently at ~60Hz, handling logic checks that don't require the GL context
 // This offloads work from the game's render thread (SwapBuffers hook)
 
@@ -19,10 +24,9 @@ struct CachedModeViewport {
     bool valid = false; // True if mode was found and data is valid
 };
 
-// Double-buffered viewport cache for lock-free access
+// Viewport cache for lock-free access
 // Logic thread writes, game thread (hkglViewport) reads
-extern CachedModeViewport g_viewportModeCache[2];
-extern std::atomic<int> g_viewportModeCacheIndex;
+extern VersionedSnapshot<CachedModeViewport> g_viewportModeCache;
 
 // Update the cached viewport mode data (called by logic_thread when mode changes)
 void UpdateCachedViewportMode();
@@ -69,3 +73,31 @@ int GetCachedScreenHeight();
 // Marks cached screen metrics as dirty so the next refresh re-queries the monitor
 // the game window is currently on. Safe to call from any thread.
 void InvalidateCachedScreenMetrics();
+
+// Game window + monitor geometry, kept current by SubclassedWndProc (WM_WINDOWPOSCHANGED, WM_DISPLAYCHANGE, ...)
+// and by the logic thread every tick. Lets per-call hot paths like hkglViewport skip the
+// GetWindowRect/MonitorFromWindow/GetMonitorInfo round trip that IsFullscreen() does.
+struct CachedWindowGeometry {
+    HWND hwnd = NULL;
+    RECT windowRect{};
+    RECT monitorRect{};
+    bool isFullscreen = false;
+    bool valid = false; // False until the window rect could be queried
+};
+
+// Re-queries the game window and publishes it if anything changed. Safe to call from any thread.
+void RefreshCachedWindowGeometry();
+
+// Lock-free consistent copy of the cached geometry. Returns out.valid.
+// outVersion (optional) increments whenever any field changes.
+bool GetCachedWindowGeometry(CachedWindowGeometry& out, uint64_t* outVersion = nullptr);
+
+// IsFullscreen() answered from the geometry cache; falls back to the live query until the cache is populated.
+bool IsFullscreenCached();
+
+// Records one hot-path fullscreen check answered by IsFullscreenCached() instead of a live query
+void CountCachedFullscreenCheck();
+
+// Estimated time saved by the cache so far, for the profiler. At each refresh, the checks counted since the
+// previous one are charged the query cost that refresh just measured, minus the refresh itself. Can be negative.
+int64_t GetFullscreenCheckTimeSavedNs();
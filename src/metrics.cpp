@@ -0,0 +1,132 @@
+// ============================================================================
+// METRICS.CPP - Metric registry, shard storage, snapshots and file dump
+// ============================================================================
+
+#include "metrics.h"
+
+#include "diagnostics_file.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace MetricsDetail {
+
+MetricShard g_shards[SHARD_COUNT];
+std::atomic<int64_t> g_gauges[MAX_METRICS];
+
+uint32_t AssignShard() {
+    static std::atomic<uint32_t> s_nextShard{ 0 };
+    return s_nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+}
+
+} // namespace MetricsDetail
+
+namespace {
+
+struct MetricDescriptor {
+    const char* name;
+    const char* description;
+    MetricKind kind;
+};
+
+// Written under RegistryMutex() before s_metricCount publishes the slot; readers only look below the published count
+MetricDescriptor s_metrics[MAX_METRICS];
+std::atomic<uint32_t> s_metricCount{ 0 };
+
+// Function-local so registrations from other translation units' static initializers find it constructed
+std::mutex& RegistryMutex() {
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+// Meter rate windows (readers only)
+std::mutex s_rateMutex;
+std::chrono::steady_clock::time_point s_rateWindowStart{};
+int64_t s_rateWindowStartValue[MAX_METRICS] = {};
+double s_rates[MAX_METRICS] = {};
+
+int64_t SumShards(uint32_t id) {
+    int64_t sum = 0;
+    for (const auto& shard : MetricsDetail::g_shards) { sum += shard.values[id].load(std::memory_order_relaxed); }
+    return sum;
+}
+
+const char* KindName(MetricKind kind) {
+    switch (kind) {
+    case MetricKind::Counter:
+        return "counter";
+    case MetricKind::Meter:
+        return "meter";
+    case MetricKind::Gauge:
+        return "gauge";
+    }
+    return "?";
+}
+
+} // namespace
+
+MetricId RegisterMetric(const char* name, MetricKind kind, const char* description) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    const uint32_t count = s_metricCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (std::strcmp(s_metrics[i].name, name) == 0) return static_cast<MetricId>(i);
+    }
+    if (count >= MAX_METRICS) return INVALID_METRIC;
+
+    s_metrics[count] = { name, description, kind };
+    s_metricCount.store(count + 1, std::memory_order_release);
+    return static_cast<MetricId>(count);
+}
+
+std::vector<MetricSnapshot> GetMetricsSnapshot() {
+    const uint32_t count = s_metricCount.load(std::memory_order_acquire);
+    std::vector<MetricSnapshot> snapshot(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        MetricSnapshot& metric = snapshot[i];
+        metric.name = s_metrics[i].name;
+        metric.description = s_metrics[i].description;
+        metric.kind = s_metrics[i].kind;
+        metric.value = metric.kind == MetricKind::Gauge ? MetricsDetail::g_gauges[i].load(std::memory_order_relaxed) : SumShards(i);
+    }
+
+    std::lock_guard<std::mutex> lock(s_rateMutex);
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - s_rateWindowStart).count();
+    const bool windowDone = elapsedMs >= METRICS_RATE_WINDOW_MS;
+    const bool firstWindow = s_rateWindowStart == std::chrono::steady_clock::time_point{};
+    for (uint32_t i = 0; i < count; ++i) {
+        if (snapshot[i].kind != MetricKind::Meter) continue;
+        if (windowDone) {
+            s_rates[i] = firstWindow ? 0.0 : static_cast<double>(snapshot[i].value - s_rateWindowStartValue[i]) * 1000.0 / elapsedMs;
+            s_rateWindowStartValue[i] = snapshot[i].value;
+        }
+        snapshot[i].ratePerSecond = s_rates[i];
+    }
+    if (windowDone) s_rateWindowStart = now;
+    return snapshot;
+}
+
+bool DumpMetricsToFile(std::filesystem::path& pathOut) {
+    const std::vector<MetricSnapshot> metrics = GetMetricsSnapshot();
+
+    std::string text = "# Toolscreen metrics - values since the game started\n";
+    char line[512];
+    for (const MetricSnapshot& metric : metrics) {
+        if (metric.kind == MetricKind::Meter) {
+            std::snprintf(line, sizeof(line), "%-40s %-8s %14lld  %10.2f/s", metric.name, KindName(metric.kind),
+                          static_cast<long long>(metric.value), metric.ratePerSecond);
+        } else {
+            std::snprintf(line, sizeof(line), "%-40s %-8s %14lld", metric.name, KindName(metric.kind),
+                          static_cast<long long>(metric.value));
+        }
+        text += line;
+        if (metric.description) {
+            text += "  # ";
+            text += metric.description;
+        }
+        text += '\n';
+    }
+    return WriteDiagnosticsFile("metrics", ".txt", text, pathOut);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+// ============================================================================
+// METRICS.H - Lock-free registry of named counters, gauges and rate meters
+// ============================================================================
+// Degradation paths (queue overflows, dropped log lines, render timeouts,
+// fallback textures, skipped virtual camera frames) bump a metric instead of
+// failing silently. The registry is shown in the performance overlay and can
+// be dumped to <toolscreen>/traces/metrics-*.txt.
+//
+//   - Counter: monotonically increasing total (MetricAdd)
+//   - Meter:   counter that is also reported as events per second
+//   - Gauge:   last value set (MetricSet)
+//
+// Counter and meter updates are one relaxed fetch_add on the calling thread's
+// shard: every thread is assigned one of SHARD_COUNT shards round-robin and
+// each shard is a separate block of cache lines, so threads bumping the same
+// metric don't bounce a line between cores. Readers sum the shards.
+//
+// Metrics are registered by name, usually at namespace scope so they show up
+// (as 0) before the first event:
+//
+//   static const MetricId s_dropped = RegisterMetric("log.dropped", MetricKind::Counter, "Log lines lost to a full ring");
+//   MetricAdd(s_dropped);
+//
+// Registration takes a mutex and may run during static initialization (the
+// registry storage is constant-initialized). Registering an existing name
+// returns its ID. Metrics are never removed.
+// ============================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+enum class MetricKind : uint8_t { Counter, Meter, Gauge };
+
+using MetricId = uint16_t;
+constexpr uint32_t MAX_METRICS = 256;
+constexpr MetricId INVALID_METRIC = 0xFFFF; // Registry full: updates are ignored
+
+namespace MetricsDetail {
+
+constexpr uint32_t SHARD_COUNT = 16;
+
+// Threads share a shard only when there are more than SHARD_COUNT of them; shards never share a cache line
+struct alignas(64) MetricShard {
+    std::atomic<int64_t> values[MAX_METRICS];
+};
+
+extern MetricShard g_shards[SHARD_COUNT];
+extern std::atomic<int64_t> g_gauges[MAX_METRICS];
+
+uint32_t AssignShard();
+
+inline std::atomic<int64_t>* ThreadShardValues() {
+    thread_local const uint32_t shard = AssignShard();
+    return g_shards[shard].values;
+}
+
+} // namespace MetricsDetail
+
+// description must be a static string (it is stored, not copied); name likewise
+MetricId RegisterMetric(const char* name, MetricKind kind, const char* description = nullptr);
+
+// Counter / meter increment. No effect on gauges.
+inline void MetricAdd(MetricId id, int64_t delta = 1) {
+    if (id >= MAX_METRICS) return;
+    MetricsDetail::ThreadShardValues()[id].fetch_add(delta, std::memory_order_relaxed);
+}
+
+// Gauge update (last writer wins)
+inline void MetricSet(MetricId id, int64_t value) {
+    if (id >= MAX_METRICS) return;
+    MetricsDetail::g_gauges[id].store(value, std::memory_order_relaxed);
+}
+
+struct MetricSnapshot {
+    const char* name = nullptr;
+    const char* description = nullptr; // May be null
+    MetricKind kind = MetricKind::Counter;
+    int64_t value = 0;         // Total (counter/meter) or current value (gauge)
+    double ratePerSecond = 0.; // Meters only: average over the last completed rate window
+};
+
+// Current values of all registered metrics, in registration order. Meter rates are recomputed when at least
+// METRICS_RATE_WINDOW_MS passed since the previous window, so callers polling every frame see a stable rate.
+constexpr int METRICS_RATE_WINDOW_MS = 1000;
+std::vector<MetricSnapshot> GetMetricsSnapshot();
+
+// Writes all metrics to <toolscreen>/traces/metrics-YYYYMMDD-HHMMSS.txt. Returns false if the file couldn't be written.
+bool DumpMetricsToFile(std::filesystem::path& pathOut);
@@ -0,0 +1,125 @@
+// ============================================================================
+// MIRROR_CAPTURE_PLAN.CPP - Capture rectangle merging, packing and remapping
+// ============================================================================
+
+#include "mirror_capture_plan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+int AlignUp(int v, int align) { return ((v + align - 1) / align) * align; }
+
+CaptureRect BoundingBox(const CaptureRect& a, const CaptureRect& b) {
+    const int x0 = (std::min)(a.x, b.x);
+    const int y0 = (std::min)(a.y, b.y);
+    const int x1 = (std::max)(a.x + a.w, b.x + b.w);
+    const int y1 = (std::max)(a.y + a.h, b.y + b.h);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+} // namespace
+
+std::vector<CaptureRect> MergeCaptureRects(std::vector<CaptureRect> rects) {
+    rects.erase(std::remove_if(rects.begin(), rects.end(), [](const CaptureRect& r) { return r.w <= 0 || r.h <= 0; }), rects.end());
+
+    // Mirror counts are small (tens of rectangles), so a quadratic fixpoint is plenty.
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; i++) {
+            for (size_t j = i + 1; j < rects.size(); j++) {
+                if (!rects[i].Intersects(rects[j])) continue;
+                rects[i] = BoundingBox(rects[i], rects[j]);
+                rects.erase(rects.begin() + j);
+                merged = true;
+                break;
+            }
+        }
+    }
+    return rects;
+}
+
+void PackCaptureRects(const std::vector<CaptureRect>& rects, int gutter, std::vector<CaptureRect>& outPositions, int& outW, int& outH) {
+    outPositions.assign(rects.size(), CaptureRect{});
+    outW = 0;
+    outH = 0;
+    if (rects.empty()) return;
+
+    // Shelf width: roughly square atlas, but never narrower than the widest block
+    long long area = 0;
+    int maxW = 0;
+    for (const auto& r : rects) {
+        area += static_cast<long long>(r.w + gutter) * (r.h + gutter);
+        maxW = (std::max)(maxW, r.w);
+    }
+    const int shelfWidth = (std::max)(maxW, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+
+    std::vector<size_t> order(rects.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return rects[a].h > rects[b].h; });
+
+    int cursorX = 0, shelfY = 0, shelfH = 0;
+    for (size_t idx : order) {
+        const CaptureRect& r = rects[idx];
+        if (cursorX > 0 && cursorX + r.w > shelfWidth) {
+            shelfY += shelfH + gutter;
+            cursorX = 0;
+            shelfH = 0;
+        }
+        outPositions[idx] = { cursorX, shelfY, r.w, r.h };
+        outW = (std::max)(outW, cursorX + r.w);
+        outH = (std::max)(outH, shelfY + r.h);
+        cursorX += r.w + gutter;
+        shelfH = (std::max)(shelfH, r.h);
+    }
+}
+
+bool CompileMirrorCapturePlan(const std::vector<CaptureRect>& inputRects, int gameW, int gameH, MirrorCapturePlan& outPlan) {
+    outPlan = MirrorCapturePlan{};
+    if (gameW <= 0 || gameH <= 0) return false;
+
+    const CaptureRect game = { 0, 0, gameW, gameH };
+    std::vector<CaptureRect> rects;
+    rects.reserve(inputRects.size());
+    for (const auto& r : inputRects) {
+        if (r.w <= 0 || r.h <= 0) continue;
+        // Regions past the frame edge sample clamped edge texels, which an atlas can't reproduce
+        if (!game.Contains(r)) return false;
+        rects.push_back(r);
+    }
+
+    rects = MergeCaptureRects(std::move(rects));
+    if (rects.empty()) return false;
+
+    std::vector<CaptureRect> positions;
+    int usedW = 0, usedH = 0;
+    PackCaptureRects(rects, CAPTURE_PLAN_GUTTER, positions, usedW, usedH);
+
+    const int atlasW = AlignUp(usedW, CAPTURE_PLAN_ATLAS_ALIGN);
+    const int atlasH = AlignUp(usedH, CAPTURE_PLAN_ATLAS_ALIGN);
+    // The atlas is packed into the corner of full-frame copy storage, so it must fit inside the frame
+    if (atlasW > gameW || atlasH > gameH) return false;
+    const double atlasArea = static_cast<double>(atlasW) * atlasH;
+    if (atlasArea > CAPTURE_PLAN_MAX_AREA_FRACTION * static_cast<double>(gameW) * gameH) return false;
+
+    outPlan.gameW = gameW;
+    outPlan.gameH = gameH;
+    outPlan.atlasW = atlasW;
+    outPlan.atlasH = atlasH;
+    outPlan.entries.reserve(rects.size());
+    for (size_t i = 0; i < rects.size(); i++) { outPlan.entries.push_back({ rects[i], positions[i].x, positions[i].y }); }
+    return true;
+}
+
+bool MapCaptureRectToAtlas(const MirrorCapturePlan& plan, const CaptureRect& gameRect, int& outAtlasX, int& outAtlasY) {
+    for (const auto& e : plan.entries) {
+        if (!e.src.Contains(gameRect)) continue;
+        outAtlasX = e.atlasX + (gameRect.x - e.src.x);
+        outAtlasY = e.atlasY + (gameRect.y - e.src.y);
+        return true;
+    }
+    return false;
+}
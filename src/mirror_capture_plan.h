@@ -0,0 +1,71 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_CAPTURE_PLAN.H - Region-restricted game frame copy for mirrors
+// ============================================================================
+// When mirrors are the only consumer of the per-frame game copy (no EyeZoom,
+// OBS or virtual camera), copying the whole game texture is wasted bandwidth:
+// mirrors usually read a handful of small regions. A capture plan lists the
+// union of all mirror input rectangles (anchors resolved for one game size),
+// packed into a compact atlas. SubmitFrameCapture then blits only those
+// rectangles into the top-left corner of the (full-frame sized) copy texture,
+// and the mirror thread remaps each input region into the atlas.
+//
+// Everything in this header is pure CPU code (no GL). All rectangles use a
+// top-left origin, in game pixels for sources and atlas pixels for placements.
+// ============================================================================
+
+#include <cstdint>
+#include <vector>
+
+struct CaptureRect {
+    int x = 0, y = 0, w = 0, h = 0;
+
+    bool Contains(const CaptureRect& other) const {
+        return other.x >= x && other.y >= y && other.x + other.w <= x + w && other.y + other.h <= y + h;
+    }
+    bool Intersects(const CaptureRect& other) const {
+        return x < other.x + other.w && other.x < x + w && y < other.y + other.h && other.y < y + h;
+    }
+};
+
+// One copied block: game rectangle src lands at (atlasX, atlasY) in the atlas
+struct CapturePlanEntry {
+    CaptureRect src;
+    int atlasX = 0;
+    int atlasY = 0;
+};
+
+struct MirrorCapturePlan {
+    int gameW = 0;  // Game size the anchors were resolved for
+    int gameH = 0;
+    int atlasW = 0; // Atlas extent inside the copy texture (rounded up, never larger than the game)
+    int atlasH = 0;
+    uint64_t configVersion = 0; // g_threadedMirrorConfigsVersion the plan was compiled from
+    std::vector<CapturePlanEntry> entries;
+};
+
+// Atlas texture dimensions are rounded up to this granularity
+constexpr int CAPTURE_PLAN_ATLAS_ALIGN = 64;
+// Empty texels kept between packed blocks
+constexpr int CAPTURE_PLAN_GUTTER = 1;
+// Plans covering more than this fraction of the game area fall back to a full copy
+constexpr float CAPTURE_PLAN_MAX_AREA_FRACTION = 0.5f;
+
+// Merges overlapping rectangles into their bounding boxes until no two remain overlapping.
+// Rectangles contained in others are dropped. Empty rectangles are ignored.
+std::vector<CaptureRect> MergeCaptureRects(std::vector<CaptureRect> rects);
+
+// Shelf-packs rectangles (tallest first) with gutter texels between them.
+// outPositions[i] is the top-left atlas position of rects[i]; outW/outH is the used extent.
+void PackCaptureRects(const std::vector<CaptureRect>& rects, int gutter, std::vector<CaptureRect>& outPositions, int& outW, int& outH);
+
+// Builds a plan from resolved mirror input rectangles. Returns false when a full copy should be
+// used instead: no rectangles, a rectangle leaves the game area (the filter relies on
+// CLAMP_TO_EDGE there), the atlas doesn't fit inside the frame, or it would not be
+// meaningfully smaller than the frame.
+bool CompileMirrorCapturePlan(const std::vector<CaptureRect>& inputRects, int gameW, int gameH, MirrorCapturePlan& outPlan);
+
+// Finds where a game rectangle was copied. Returns false if no plan entry fully contains it
+// (e.g. configs changed after the plan was compiled).
+bool MapCaptureRectToAtlas(const MirrorCapturePlan& plan, const CaptureRect& gameRect, int& outAtlasX, int& outAtlasY);
@@ -0,0 +1,170 @@
+// ============================================================================
+// MIRROR_COLOR_LUT.CPP - Color-match table builder and CPU reference
+// ============================================================================
+// All math is done in float with the same operation order as the GLSL filter
+// shader (distance = sqrt(dx*dx + dy*dy + dz*dz)), so the table reproduces the
+// shader's per-pixel decision for every RGB8 input.
+// ============================================================================
+
+#include "mirror_color_lut.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+float SRGBToLinear(float c) {
+    if (c <= 0.04045f) { return c / 12.92f; }
+    return std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+// Normalized and linearized values for every 8-bit channel value (computed once).
+struct ChannelTables {
+    float srgb[256];
+    float linear[256];
+
+    ChannelTables() {
+        for (int v = 0; v < 256; v++) {
+            srgb[v] = static_cast<float>(v) / 255.0f;
+            linear[v] = SRGBToLinear(srgb[v]);
+        }
+    }
+};
+
+const ChannelTables& GetChannelTables() {
+    static const ChannelTables s_tables;
+    return s_tables;
+}
+
+float Distance(float ax, float ay, float az, float bx, float by, float bz) {
+    const float dx = ax - bx;
+    const float dy = ay - by;
+    const float dz = az - bz;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Inclusive range of channel values whose single-axis distance to target could still pass.
+// Slightly generous so float rounding in sqrt never excludes a value the exact test would accept.
+// Both channel tables are monotonic, so the candidates form one contiguous range.
+bool CandidateRange(const float* values, float target, float sensitivity, int& outLo, int& outHi) {
+    const float limit = sensitivity * 1.0001f + 1e-6f;
+    outLo = 256;
+    outHi = -1;
+    for (int v = 0; v < 256; v++) {
+        if (std::fabs(values[v] - target) <= limit) {
+            if (outLo > v) outLo = v;
+            outHi = v;
+        }
+    }
+    return outHi >= outLo;
+}
+
+// Mark every color whose distance to (tx, ty, tz) in the given channel space is < sensitivity.
+void MarkSphere(const float* values, float tx, float ty, float tz, float sensitivity, uint32_t* words) {
+    int rLo, rHi, gLo, gHi, bLo, bHi;
+    if (!CandidateRange(values, tx, sensitivity, rLo, rHi)) return;
+    if (!CandidateRange(values, ty, sensitivity, gLo, gHi)) return;
+    if (!CandidateRange(values, tz, sensitivity, bLo, bHi)) return;
+
+    for (int r = rLo; r <= rHi; r++) {
+        const float dr = values[r] - tx;
+        const float dr2 = dr * dr;
+        for (int g = gLo; g <= gHi; g++) {
+            const float dg = values[g] - ty;
+            const float drg2 = dr2 + dg * dg;
+            const uint32_t rowBase = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8);
+            for (int b = bLo; b <= bHi; b++) {
+                const float db = values[b] - tz;
+                if (std::sqrt(drg2 + db * db) < sensitivity) {
+                    const uint32_t index = rowBase | static_cast<uint32_t>(b);
+                    words[index >> 5] |= (1u << (index & 31));
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool MirrorColorMatchKey::operator==(const MirrorColorMatchKey& other) const {
+    if (sensitivity != other.sensitivity || gammaMode != other.gammaMode) return false;
+    if (targetColors.size() != other.targetColors.size()) return false;
+    for (size_t i = 0; i < targetColors.size(); i++) {
+        const Color& a = targetColors[i];
+        const Color& b = other.targetColors[i];
+        if (a.r != b.r || a.g != b.g || a.b != b.b) return false;
+    }
+    return true;
+}
+
+MirrorColorMatchKey MakeMirrorColorMatchKey(const std::vector<Color>& targetColors, float sensitivity, MirrorGammaMode gammaMode) {
+    MirrorColorMatchKey key;
+    key.targetColors.reserve(targetColors.size());
+    for (const Color& c : targetColors) {
+        // Alpha never affects matching; normalize it so it can't split otherwise identical keys.
+        key.targetColors.push_back({ c.r, c.g, c.b, 1.0f });
+    }
+    key.sensitivity = sensitivity;
+    key.gammaMode = gammaMode;
+    return key;
+}
+
+void BuildMirrorColorMatchTable(const MirrorColorMatchKey& key, std::vector<uint32_t>& outWords) {
+    outWords.assign(MIRROR_COLOR_LUT_WORDS, 0u);
+    if (!(key.sensitivity > 0.0f)) return; // dist < sensitivity can never hold
+
+    const ChannelTables& tables = GetChannelTables();
+    uint32_t* words = outWords.data();
+
+    for (const Color& t : key.targetColors) {
+        const float tlr = SRGBToLinear(t.r);
+        const float tlg = SRGBToLinear(t.g);
+        const float tlb = SRGBToLinear(t.b);
+
+        switch (key.gammaMode) {
+        case MirrorGammaMode::AssumeLinear:
+            // Input treated as linear: raw input vs linearized target
+            MarkSphere(tables.srgb, tlr, tlg, tlb, key.sensitivity, words);
+            break;
+        case MirrorGammaMode::AssumeSRGB:
+            // Input treated as sRGB: linearized input vs linearized target
+            MarkSphere(tables.linear, tlr, tlg, tlb, key.sensitivity, words);
+            break;
+        default:
+            // Auto: min(distSRGB, distLinear) < s  <=>  distSRGB < s || distLinear < s
+            MarkSphere(tables.srgb, t.r, t.g, t.b, key.sensitivity, words);
+            MarkSphere(tables.linear, tlr, tlg, tlb, key.sensitivity, words);
+            break;
+        }
+    }
+}
+
+bool MirrorColorMatchesReference(const MirrorColorMatchKey& key, uint8_t r, uint8_t g, uint8_t b) {
+    const float sr = static_cast<float>(r) / 255.0f;
+    const float sg = static_cast<float>(g) / 255.0f;
+    const float sb = static_cast<float>(b) / 255.0f;
+    const float lr = SRGBToLinear(sr);
+    const float lg = SRGBToLinear(sg);
+    const float lb = SRGBToLinear(sb);
+
+    for (const Color& t : key.targetColors) {
+        const float tlr = SRGBToLinear(t.r);
+        const float tlg = SRGBToLinear(t.g);
+        const float tlb = SRGBToLinear(t.b);
+
+        float dist;
+        if (key.gammaMode == MirrorGammaMode::AssumeLinear) {
+            dist = Distance(sr, sg, sb, tlr, tlg, tlb);
+        } else if (key.gammaMode == MirrorGammaMode::AssumeSRGB) {
+            dist = Distance(lr, lg, lb, tlr, tlg, tlb);
+        } else {
+            const float distSRGB = Distance(sr, sg, sb, t.r, t.g, t.b);
+            const float distLinear = Distance(lr, lg, lb, tlr, tlg, tlb);
+            dist = (std::min)(distSRGB, distLinear);
+        }
+
+        if (dist < key.sensitivity) return true;
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_COLOR_LUT.H - Precomputed color-match tables for mirror filtering
+// ============================================================================
+// The mirror filter shaders used to evaluate SRGBToLinear (three pow calls) and
+// one or two distances per target color for every pixel, with a hard cap of 8
+// target colors. Instead, each distinct (target colors, sensitivity, gamma mode)
+// combination is baked on the CPU into a 2^24-bit table covering every RGB8
+// value, so per-pixel matching becomes a single texelFetch + bit test no matter
+// how many target colors are configured.
+//
+// Table layout (mirrors the GLSL lookup in mirror_thread.cpp):
+//   index = (r << 16) | (g << 8) | b          (RGB8 quantized input color)
+//   word  = index >> 5, bit = index & 31
+//   texel = (word % MIRROR_COLOR_LUT_WIDTH, word / MIRROR_COLOR_LUT_WIDTH)
+// uploaded as a GL_R32UI texture of MIRROR_COLOR_LUT_WIDTH x MIRROR_COLOR_LUT_HEIGHT.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "config_types.h"
+
+constexpr int MIRROR_COLOR_LUT_WORDS = (1 << 24) / 32;
+constexpr int MIRROR_COLOR_LUT_WIDTH = 2048;
+constexpr int MIRROR_COLOR_LUT_HEIGHT = MIRROR_COLOR_LUT_WORDS / MIRROR_COLOR_LUT_WIDTH;
+
+// Everything that influences whether a pixel matches. Two mirrors with equal keys share one table.
+struct MirrorColorMatchKey {
+    std::vector<Color> targetColors; // Only r/g/b are relevant (alpha is ignored by the filter)
+    float sensitivity = 0.0f;
+    MirrorGammaMode gammaMode = MirrorGammaMode::Auto;
+
+    bool operator==(const MirrorColorMatchKey& other) const;
+    bool operator!=(const MirrorColorMatchKey& other) const { return !(*this == other); }
+};
+
+MirrorColorMatchKey MakeMirrorColorMatchKey(const std::vector<Color>& targetColors, float sensitivity, MirrorGammaMode gammaMode);
+
+// Build the match bitset for a key. outWords is resized to MIRROR_COLOR_LUT_WORDS.
+// Only the bounding box of candidate colors around each target is visited, so small
+// sensitivities (the common case) build in well under a millisecond.
+void BuildMirrorColorMatchTable(const MirrorColorMatchKey& key, std::vector<uint32_t>& outWords);
+
+// Table lookup for an RGB8 color (CPU equivalent of the shader lookup).
+inline bool MirrorColorMatchTableLookup(const std::vector<uint32_t>& words, uint8_t r, uint8_t g, uint8_t b) {
+    const uint32_t index = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+    return (words[index >> 5] >> (index & 31)) & 1u;
+}
+
+// CPU reference of the original per-pixel shader math (SRGBToLinear + distance per target).
+// Tables are validated against it (tests/test_mirror_color_lut.cpp); not used on any hot path.
+bool MirrorColorMatchesReference(const MirrorColorMatchKey& key, uint8_t r, uint8_t g, uint8_t b);
@@ -0,0 +1,330 @@
+// ============================================================================
+// MIRROR_STATS.CPP - Mirror content statistics scan, registry and state file
+// ============================================================================
+
+#include "mirror_stats.h"
+#include "diagnostics_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <immintrin.h>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+// Colors are cached per RGB value; bound the cache so noisy passthrough content can't grow it forever
+constexpr size_t kAttributionCacheLimit = 1 << 16;
+
+inline int CountTrailingZeros64(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+inline int CountLeadingZeros64(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return 63 - static_cast<int>(index);
+#else
+    return __builtin_clzll(v);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Alpha > 0 masks: bit i of the result is set if pixel i (of up to 64) has alpha > 0
+// ---------------------------------------------------------------------------
+
+uint64_t AlphaMaskScalar(const uint8_t* rgba, int n) {
+    uint64_t mask = 0;
+    for (int i = 0; i < n; i++) {
+        if (rgba[i * 4 + 3] != 0) mask |= (1ull << i);
+    }
+    return mask;
+}
+
+uint64_t AlphaMaskSSE2(const uint8_t* rgba, int n) {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+        const __m128i empty = _mm_cmpeq_epi32(_mm_and_si128(px, alpha), zero);
+        const int bits = (~_mm_movemask_ps(_mm_castsi128_ps(empty))) & 0xF;
+        mask |= static_cast<uint64_t>(bits) << i;
+    }
+    if (i < n) mask |= AlphaMaskScalar(rgba + i * 4, n - i) << i;
+    return mask;
+}
+
+CPU_TARGET_AVX2 uint64_t AlphaMaskAVX2(const uint8_t* rgba, int n) {
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba + i * 4));
+        const __m256i empty = _mm256_cmpeq_epi32(_mm256_and_si256(px, alpha), zero);
+        const int bits = (~_mm256_movemask_ps(_mm256_castsi256_ps(empty))) & 0xFF;
+        mask |= static_cast<uint64_t>(bits) << i;
+    }
+    if (i < n) mask |= AlphaMaskScalar(rgba + i * 4, n - i) << i;
+    return mask;
+}
+
+using AlphaMaskFn = uint64_t (*)(const uint8_t*, int);
+
+AlphaMaskFn SelectAlphaMask(CpuSimdLevel level) {
+    switch (ResolveCpuSimdLevel(level)) {
+    case CpuSimdLevel::AVX2:
+        return AlphaMaskAVX2;
+    case CpuSimdLevel::SSE41:
+    case CpuSimdLevel::SSE2:
+        return AlphaMaskSSE2;
+    default:
+        return AlphaMaskScalar;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Early-exit "any alpha > 0" scans
+// ---------------------------------------------------------------------------
+
+bool HasContentScalar(const uint8_t* rgba, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; i++) {
+        if (rgba[i * 4 + 3] != 0) return true;
+    }
+    return false;
+}
+
+bool HasContentSSE2(const uint8_t* rgba, size_t pixelCount) {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    // 16 pixels per iteration, one branch per block
+    for (; i + 16 <= pixelCount; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(rgba + i * 4);
+        const __m128i any = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+                                         _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, alpha), zero)) != 0xFFFF) return true;
+    }
+    return HasContentScalar(rgba + i * 4, pixelCount - i);
+}
+
+CPU_TARGET_AVX2 bool HasContentAVX2(const uint8_t* rgba, size_t pixelCount) {
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    // 32 pixels per iteration, one branch per block
+    for (; i + 32 <= pixelCount; i += 32) {
+        const __m256i* p = reinterpret_cast<const __m256i*>(rgba + i * 4);
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+                                            _mm256_or_si256(_mm256_loadu_si256(p + 2), _mm256_loadu_si256(p + 3)));
+        if (!_mm256_testz_si256(any, alpha)) return true;
+    }
+    return HasContentScalar(rgba + i * 4, pixelCount - i);
+}
+
+// ---------------------------------------------------------------------------
+// Published results
+// ---------------------------------------------------------------------------
+
+std::mutex g_mirrorStatsMutex;
+std::unordered_map<std::string, MirrorContentStats> g_mirrorStats;
+std::atomic<uint64_t> g_mirrorStatsVersion{ 0 };
+
+} // namespace
+
+void MirrorColorAttribution::SetKey(const MirrorColorMatchKey& key) {
+    if (m_hasKey && m_key == key) return;
+
+    m_key = key;
+    m_hasKey = true;
+    m_cache.clear();
+    m_matchIndices.clear();
+    m_targetKeys.clear();
+    m_targetKeys.reserve(key.targetColors.size());
+    for (const Color& c : key.targetColors) { m_targetKeys.push_back(MakeMirrorColorMatchKey({ c }, key.sensitivity, key.gammaMode)); }
+}
+
+MirrorColorAttribution::Matches MirrorColorAttribution::Classify(uint32_t rgb) {
+    rgb &= 0x00FFFFFFu;
+    auto it = m_cache.find(rgb);
+    if (it != m_cache.end()) return { m_matchIndices.data() + it->second.offset, it->second.count };
+
+    if (m_cache.size() >= kAttributionCacheLimit) {
+        m_cache.clear();
+        m_matchIndices.clear();
+    }
+
+    const uint8_t r = static_cast<uint8_t>(rgb & 0xFF);
+    const uint8_t g = static_cast<uint8_t>((rgb >> 8) & 0xFF);
+    const uint8_t b = static_cast<uint8_t>((rgb >> 16) & 0xFF);
+    const CacheEntry entry{ static_cast<uint32_t>(m_matchIndices.size()), 0 };
+    CacheEntry& cached = m_cache.emplace(rgb, entry).first->second;
+    for (size_t i = 0; i < m_targetKeys.size(); i++) {
+        if (MirrorColorMatchesReference(m_targetKeys[i], r, g, b)) {
+            m_matchIndices.push_back(static_cast<uint32_t>(i));
+            cached.count++;
+        }
+    }
+    return { m_matchIndices.data() + cached.offset, cached.count };
+}
+
+bool MirrorScanHasContent(const uint8_t* rgba, size_t pixelCount, CpuSimdLevel level) {
+    if (!rgba || pixelCount == 0) return false;
+    switch (ResolveCpuSimdLevel(level)) {
+    case CpuSimdLevel::AVX2:
+        return HasContentAVX2(rgba, pixelCount);
+    case CpuSimdLevel::SSE41:
+    case CpuSimdLevel::SSE2:
+        return HasContentSSE2(rgba, pixelCount);
+    default:
+        return HasContentScalar(rgba, pixelCount);
+    }
+}
+
+void ComputeMirrorContentStats(const uint8_t* rgba, int width, int height, int padding, MirrorColorAttribution* attribution,
+                               MirrorContentStats& out, CpuSimdLevel level) {
+    const uint64_t sequence = out.sequence;
+    out = MirrorContentStats{};
+    out.sequence = sequence;
+    out.valid = true;
+    out.captureWidth = (std::max)(width - 2 * padding, 0);
+    out.captureHeight = (std::max)(height - 2 * padding, 0);
+    if (!rgba || width <= 0 || height <= 0) return;
+
+    // Per-target counts: each matched pixel's source color is checked against every target on its own
+    const size_t targetCount = attribution ? attribution->TargetCount() : 0;
+    const bool classify = targetCount > 0;
+    if (classify) out.targetColorPixels.assign(targetCount, 0);
+
+    const AlphaMaskFn alphaMask = SelectAlphaMask(level);
+    uint64_t sumX = 0, sumY = 0;
+    int minX = width, maxX = -1, minRow = height, maxRow = -1;
+
+    for (int row = 0; row < height; row++) {
+        const uint8_t* rowPx = rgba + static_cast<size_t>(row) * width * 4;
+        uint64_t rowCount = 0;
+        for (int x0 = 0; x0 < width; x0 += 64) {
+            const int n = (std::min)(64, width - x0);
+            uint64_t bits = alphaMask(rowPx + static_cast<size_t>(x0) * 4, n);
+            if (!bits) continue;
+
+            minX = (std::min)(minX, x0 + CountTrailingZeros64(bits));
+            maxX = (std::max)(maxX, x0 + 63 - CountLeadingZeros64(bits));
+            while (bits) {
+                const int x = x0 + CountTrailingZeros64(bits);
+                bits &= bits - 1;
+                rowCount++;
+                sumX += static_cast<uint64_t>(x);
+                if (classify) {
+                    uint32_t px;
+                    std::memcpy(&px, rowPx + static_cast<size_t>(x) * 4, 4);
+                    const MirrorColorAttribution::Matches matches = attribution->Classify(px);
+                    for (uint32_t m = 0; m < matches.count; m++) out.targetColorPixels[matches.indices[m]]++;
+                    if (matches.count == 0) out.unattributedPixels++;
+                }
+            }
+        }
+        if (rowCount == 0) continue;
+
+        out.matchedPixels += rowCount;
+        sumY += rowCount * static_cast<uint64_t>(height - 1 - row); // glReadPixels rows are bottom-up
+        minRow = (std::min)(minRow, row);
+        maxRow = (std::max)(maxRow, row);
+    }
+
+    if (out.matchedPixels == 0) return;
+
+    // FBO space -> capture space (top-left origin, padding removed)
+    out.hasContent = true;
+    out.minX = minX - padding;
+    out.maxX = maxX - padding;
+    out.minY = (height - 1 - maxRow) - padding;
+    out.maxY = (height - 1 - minRow) - padding;
+    out.centroidX = static_cast<float>(static_cast<double>(sumX) / out.matchedPixels) - padding;
+    out.centroidY = static_cast<float>(static_cast<double>(sumY) / out.matchedPixels) - padding;
+}
+
+void PublishMirrorContentStats(const std::string& mirrorName, const MirrorContentStats& stats) {
+    std::lock_guard<std::mutex> lock(g_mirrorStatsMutex);
+    MirrorContentStats& entry = g_mirrorStats[mirrorName];
+    const uint64_t sequence = entry.sequence + 1;
+    entry = stats;
+    entry.sequence = sequence;
+    g_mirrorStatsVersion.fetch_add(1, std::memory_order_release);
+}
+
+void PruneMirrorContentStats(const std::vector<std::string>& activeMirrorNames) {
+    std::lock_guard<std::mutex> lock(g_mirrorStatsMutex);
+    bool removed = false;
+    for (auto it = g_mirrorStats.begin(); it != g_mirrorStats.end();) {
+        if (std::find(activeMirrorNames.begin(), activeMirrorNames.end(), it->first) == activeMirrorNames.end()) {
+            it = g_mirrorStats.erase(it);
+            removed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (removed) g_mirrorStatsVersion.fetch_add(1, std::memory_order_release);
+}
+
+bool GetMirrorContentStats(const std::string& mirrorName, MirrorContentStats& out) {
+    std::lock_guard<std::mutex> lock(g_mirrorStatsMutex);
+    auto it = g_mirrorStats.find(mirrorName);
+    if (it == g_mirrorStats.end()) return false;
+    out = it->second;
+    return true;
+}
+
+std::vector<std::pair<std::string, MirrorContentStats>> GetAllMirrorContentStats() {
+    std::vector<std::pair<std::string, MirrorContentStats>> result;
+    {
+        std::lock_guard<std::mutex> lock(g_mirrorStatsMutex);
+        result.reserve(g_mirrorStats.size());
+        for (const auto& kv : g_mirrorStats) { result.emplace_back(kv.first, kv.second); }
+    }
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return result;
+}
+
+void WriteMirrorContentStatsFile() {
+    static uint64_t s_writtenVersion = 0;
+    static std::chrono::steady_clock::time_point s_lastWrite;
+
+    const uint64_t version = g_mirrorStatsVersion.load(std::memory_order_acquire);
+    if (version == s_writtenVersion) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - s_lastWrite < std::chrono::milliseconds(100)) return;
+    s_lastWrite = now;
+
+    // One line per mirror:
+    // <name> matched=<n> bbox=<minX>,<minY>,<maxX>,<maxY> centroid=<x>,<y> targets=<n,...> unattributed=<n>
+    // (a pixel counts under every target it matches, so targets= need not add up to matched=)
+    std::ostringstream oss;
+    oss.setf(std::ios::fixed);
+    oss.precision(2);
+    for (const auto& [name, s] : GetAllMirrorContentStats()) {
+        oss << name << " matched=" << s.matchedPixels;
+        if (s.hasContent) {
+            oss << " bbox=" << s.minX << "," << s.minY << "," << s.maxX << "," << s.maxY << " centroid=" << s.centroidX << ","
+                << s.centroidY;
+        } else {
+            oss << " bbox=none centroid=none";
+        }
+        oss << " targets=";
+        for (size_t i = 0; i < s.targetColorPixels.size(); i++) { oss << (i ? "," : "") << s.targetColorPixels[i]; }
+        oss << " unattributed=" << s.unattributedPixels << "\n";
+    }
+
+    if (WriteToolscreenFile(L"mirrorstats.txt", oss.str())) s_writtenVersion = version; // Else retried 100 ms later
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_STATS.H - Mirror content statistics (pixel counts, bounds, centroid)
+// ============================================================================
+// The mirror thread reads back each non-raw mirror's filter FBO asynchronously.
+// Mirrors without "Content Statistics" enabled only need the early-exit
+// "any alpha > 0" scan that drives hasFrameContent. Mirrors with it enabled
+// are read back at full resolution and scanned exactly:
+//   - matched pixel count (alpha > 0, same test as content detection)
+//   - bounding box and centroid in capture coordinates (top-left origin,
+//     dynamic-border padding removed)
+//   - matched pixels per target color, from the matched pixels' source colors
+//     (the filter output with Color Passthrough, otherwise a second filter pass
+//     that keeps them). A pixel is counted under every target it matches, so
+//     with overlapping targets the per-target counts add up to more than the
+//     total, and pixels matching no single target (overlapping input regions
+//     blend their colors) add up to less
+//
+// Results are published per mirror name. Other threads read them through
+// GetMirrorContentStats(), and WriteMirrorContentStatsFile() mirrors them into
+// mirrorstats.txt in the toolscreen folder for external tools.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpu_features.h"
+#include "mirror_color_lut.h"
+
+struct MirrorContentStats {
+    bool valid = false;         // False until the first full-resolution readback completed
+    bool hasContent = false;    // Any matched pixel
+    uint64_t matchedPixels = 0; // Pixels with alpha > 0 in the filter output
+    int captureWidth = 0;       // Coordinate space of the fields below
+    int captureHeight = 0;
+
+    // Inclusive bounding box of matched pixels (only meaningful when hasContent)
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    float centroidX = 0.0f, centroidY = 0.0f;
+
+    // Per target color (same order as the mirror's target colors); empty when the readback held no source colors.
+    // A pixel counts under every target it matches, so these need not add up to matchedPixels.
+    std::vector<uint64_t> targetColorPixels;
+    uint64_t unattributedPixels = 0; // Matched, but the source color matches none of the targets on its own
+
+    uint64_t sequence = 0; // Incremented on every publish for this mirror
+};
+
+// Maps filter-output colors back to the target color that produced them.
+// Results are cached per RGB value; matched content typically has only a few distinct colors.
+class MirrorColorAttribution {
+public:
+    // Re-targets the cache. Cheap when the key is unchanged.
+    void SetKey(const MirrorColorMatchKey& key);
+
+    struct Matches {
+        const uint32_t* indices; // Target indices in ascending order
+        uint32_t count;
+    };
+
+    // Every target color matching rgb (0x00BBGGRR). Valid until the next Classify or SetKey.
+    Matches Classify(uint32_t rgb);
+
+    size_t TargetCount() const { return m_targetKeys.size(); }
+
+private:
+    struct CacheEntry {
+        uint32_t offset; // Into m_matchIndices
+        uint32_t count;
+    };
+
+    MirrorColorMatchKey m_key;
+    std::vector<MirrorColorMatchKey> m_targetKeys; // One single-color key per target
+    std::unordered_map<uint32_t, CacheEntry> m_cache;
+    std::vector<uint32_t> m_matchIndices; // Match lists of all cached colors, back to back
+    bool m_hasKey = false;
+};
+
+// Early-exit scan: true if any pixel in the RGBA8 buffer has alpha > 0.
+bool MirrorScanHasContent(const uint8_t* rgba, size_t pixelCount, CpuSimdLevel level = GetCpuSimdLevel());
+
+// Exact statistics for a bottom-up RGBA8 readback of a filter FBO (glReadPixels order).
+// padding is the dynamic-border padding around the capture area. With attribution, matched pixels
+// must hold their source colors (Color Passthrough output); null skips the per-target counts.
+void ComputeMirrorContentStats(const uint8_t* rgba, int width, int height, int padding, MirrorColorAttribution* attribution,
+                               MirrorContentStats& out, CpuSimdLevel level = GetCpuSimdLevel());
+
+// --- Published results (thread-safe) ---
+
+// Called by the mirror thread after each full-resolution scan.
+void PublishMirrorContentStats(const std::string& mirrorName, const MirrorContentStats& stats);
+
+// Drops results for mirrors that are no longer active or no longer have statistics enabled.
+void PruneMirrorContentStats(const std::vector<std::string>& activeMirrorNames);
+
+// Latest statistics for a mirror. Returns false if none have been published.
+bool GetMirrorContentStats(const std::string& mirrorName, MirrorContentStats& out);
+
+// Snapshot of all published statistics.
+std::vector<std::pair<std::string, MirrorContentStats>> GetAllMirrorContentStats();
+
+// Writes mirrorstats.txt (toolscreen folder) when statistics changed, at most ~10 times per second.
+// Called from the logic thread.
+void WriteMirrorContentStatsFile();
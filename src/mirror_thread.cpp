@@ -1,12 +1,18 @@
 #include "mirror_thread.h"
+#include "capture_scheduler.h"
 #include "gui.h"
 #include "logic_thread.h"
+#include "metrics.h"
+#include "mirror_capture_plan.h"
+#include "mirror_color_lut.h"
+#include "mirror_stats.h"
 #include "profiler.h"
 #include "render.h"
 #include "shared_contexts.h"
 #include "utils.h"
 #include <algorithm>
 #include <condition_variable>
+#include <memory>
 #include <chrono>
 #include <unordered_map>
 #include <thread>
@@ -110,9 +116,13 @@ std::atomic<int> g_captureFinalW{ 0 };
 std::atomic<int> g_captureFinalH{ 0 };
 
 // Lock-free SPSC ring buffer for capture notifications
-FrameCaptureNotification g_captureQueue[CAPTURE_QUEUE_SIZE];
-std::atomic<int> g_captureQueueHead{ 0 };
-std::atomic<int> g_captureQueueTail{ 0 };
+CaptureQueue g_captureQueue;
+static const MetricId g_metricCaptureNotificationsDropped =
+    RegisterMetric("capture.notifications_dropped", MetricKind::Meter, "Capture notifications evicted before the mirror thread saw them");
+static const MetricId g_metricCaptureNotificationsCoalesced =
+    RegisterMetric("capture.notifications_coalesced", MetricKind::Meter, "Queued captures skipped by the mirror thread for a newer one");
+static const MetricId g_metricCaptureQueueBacklog =
+    RegisterMetric("capture.queue_backlog", MetricKind::Gauge, "Notifications queued at the mirror thread's last check");
 
 // CPU optimization: avoid polling the queue at 1ms intervals when nothing is submitting captures.
 static std::mutex g_captureSignalMutex;
@@ -140,6 +150,17 @@ static std::atomic<int> g_readyFrameIndex{ -1 }; // Index of guaranteed-complete
 static std::atomic<int> g_readyFrameWidth{ 0 };  // Width of ready frame content
 static std::atomic<int> g_readyFrameHeight{ 0 }; // Height of ready frame content
 
+// Region-restricted capture (see mirror_capture_plan.h): when only mirrors need the copy, a copy
+// texture may hold a packed atlas of mirror input regions instead of the full frame.
+// The plan for each copy texture is published before its notification is queued (null = full frame).
+// g_copyTextureIsAtlas is the cheap check for full-frame consumers (OBS, EyeZoom, virtual camera).
+static std::shared_ptr<const MirrorCapturePlan> g_copyTexturePlans[2];
+static std::atomic<bool> g_copyTextureIsAtlas[2] = { false, false };
+
+// Filter passes in the mirror thread's last processed frame (mirrors sharing an identical filter pass count as shared)
+static std::atomic<int> g_mirrorFilterPassesRun{ 0 };
+static std::atomic<int> g_mirrorFilterPassesShared{ 0 };
+
 // Global mirror colorspace matching mode (applies to all mirrors)
 static std::atomic<int> g_globalMirrorGammaMode{ static_cast<int>(MirrorGammaMode::Auto) };
 
@@ -162,16 +183,16 @@ static void MT_LogSharedContextHealthOnce() {
     const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
     const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
-    LogCategory("init", std::string("Mirror Capture Thread: GL_VENDOR=") + (vendor ? vendor : "<null>"));
-    LogCategory("init", std::string("Mirror Capture Thread: GL_RENDERER=") + (renderer ? renderer : "<null>"));
-    LogCategory("init", std::string("Mirror Capture Thread: GL_VERSION=") + (version ? version : "<null>"));
+    LogCategory(LogCat::Init, std::string("Mirror Capture Thread: GL_VENDOR=") + (vendor ? vendor : "<null>"));
+    LogCategory(LogCat::Init, std::string("Mirror Capture Thread: GL_RENDERER=") + (renderer ? renderer : "<null>"));
+    LogCategory(LogCat::Init, std::string("Mirror Capture Thread: GL_VERSION=") + (version ? version : "<null>"));
 
     // Validate that the shared copy textures created on the game context are visible here.
     // If these are not visible, mirrors/raw output will never work.
     for (int i = 0; i < 2; i++) {
         GLuint tex = g_copyTextures[i];
         if (tex == 0) {
-            LogCategory("init", "Mirror Capture Thread: g_copyTextures[" + std::to_string(i) + "] = 0 (not initialized yet)");
+            LogCategory(LogCat::Init, "Mirror Capture Thread: g_copyTextures[" + std::to_string(i) + "] = 0 (not initialized yet)");
             continue;
         }
 
@@ -183,9 +204,9 @@ static void MT_LogSharedContextHealthOnce() {
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &ifmt);
         glBindTexture(GL_TEXTURE_2D, 0);
 
-        LogCategory("init", "Mirror Capture Thread: shared copy tex[" + std::to_string(i) + "] id=" + std::to_string(tex) +
-                                " glIsTexture=" + std::to_string((int)isTex) + " size=" + std::to_string(w) + "x" +
-                                std::to_string(h) + " ifmt=" + std::to_string(ifmt));
+        LogCategory(LogCat::Init, "Mirror Capture Thread: shared copy tex[" + std::to_string(i) + "] id=" + std::to_string(tex) +
+                                      " glIsTexture=" + std::to_string((int)isTex) + " size=" + std::to_string(w) + "x" +
+                                      std::to_string(h) + " ifmt=" + std::to_string(ifmt));
     }
 
     // Clear any errors so subsequent GL error checks are meaningful.
@@ -211,55 +232,30 @@ void main() {
     TexCoord = aTexCoord;
 })";
 
-// Filter shader - applies color filter to captured content (supports multiple target colors)
-static const char* mt_filter_frag_shader = R"(#version 330 core
+// Shared GLSL for color matching via the precomputed match table (see mirror_color_lut.h).
+// Target colors, sensitivity and gamma mode are baked into a 2^24-bit table, so matching is one
+// texelFetch regardless of how many target colors are configured.
+#define MT_COLOR_LUT_GLSL                                                                                                                  \
+    "uniform usampler2D u_matchLut;\n"                                                                                                    \
+    "bool MatchesTargetColor(vec3 c) {\n"                                                                                                 \
+    "    ivec3 q = ivec3(clamp(c, 0.0, 1.0) * 255.0 + 0.5);\n"                                                                            \
+    "    int idx = (q.r << 16) | (q.g << 8) | q.b;\n"                                                                                     \
+    "    int word = idx >> 5;\n"                                                                                                          \
+    "    uint bits = texelFetch(u_matchLut, ivec2(word & 2047, word >> 11), 0).r;\n"                                                      \
+    "    return ((bits >> uint(idx & 31)) & 1u) != 0u;\n"                                                                                 \
+    "}\n"
+
+// Filter shader - applies color filter to captured content (any number of target colors)
+static const char* mt_filter_frag_shader = "#version 330 core\n" MT_COLOR_LUT_GLSL R"(
 out vec4 FragColor;
 in vec2 TexCoord;
 uniform sampler2D screenTexture;
 uniform vec4 u_sourceRect;
-uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
-uniform vec3 u_targetColors[8];  // Support up to 8 target colors
-uniform int u_targetColorCount;  // Number of active target colors
 uniform vec4 outputColor;
-uniform float u_sensitivity;
-
-vec3 SRGBToLinear(vec3 c) {
-    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
-    vec3 low = c / 12.92;
-    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
-    return mix(high, low, vec3(cutoff));
-}
 void main() {
     vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
     vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
-        vec3 targetColorSRGB = u_targetColors[i];
-        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
-
-        float dist;
-        if (u_gammaMode == 2) {
-            // Assume input is linear (targets are sRGB -> convert targets only)
-            dist = distance(screenColor, targetColorLinear);
-        } else if (u_gammaMode == 1) {
-            // Assume input is sRGB (convert both input+target to linear)
-            dist = distance(screenColorLinear, targetColorLinear);
-        } else {
-            // Auto: evaluate both distances and accept the better match.
-            float distSRGB = distance(screenColor, targetColorSRGB);
-            float distLinear = distance(screenColorLinear, targetColorLinear);
-            dist = min(distSRGB, distLinear);
-        }
-
-        if (dist < u_sensitivity) {
-            matches = true;
-            break;
-        }
-    }
-    
-    if (matches) {
+    if (MatchesTargetColor(screenColor)) {
         FragColor = outputColor;
     } else {
         FragColor = vec4(0.0, 0.0, 0.0, 0.0);
@@ -268,50 +264,15 @@ void main() {
 
 // Color Passthrough filter shader - outputs original pixel color when matching target colors
 // Unlike the regular filter shader, this preserves the original pixel color instead of replacing it
-static const char* mt_filter_passthrough_frag_shader = R"(#version 330 core
+static const char* mt_filter_passthrough_frag_shader = "#version 330 core\n" MT_COLOR_LUT_GLSL R"(
 out vec4 FragColor;
 in vec2 TexCoord;
 uniform sampler2D screenTexture;
 uniform vec4 u_sourceRect;
-uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
-uniform vec3 u_targetColors[8];  // Support up to 8 target colors
-uniform int u_targetColorCount;  // Number of active target colors
-uniform float u_sensitivity;
-
-vec3 SRGBToLinear(vec3 c) {
-    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
-    vec3 low = c / 12.92;
-    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
-    return mix(high, low, vec3(cutoff));
-}
 void main() {
     vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
     vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
-        vec3 targetColorSRGB = u_targetColors[i];
-        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
-
-        float dist;
-        if (u_gammaMode == 2) {
-            dist = distance(screenColor, targetColorLinear);
-        } else if (u_gammaMode == 1) {
-            dist = distance(screenColorLinear, targetColorLinear);
-        } else {
-            float distSRGB = distance(screenColor, targetColorSRGB);
-            float distLinear = distance(screenColorLinear, targetColorLinear);
-            dist = min(distSRGB, distLinear);
-        }
-
-        if (dist < u_sensitivity) {
-            matches = true;
-            break;
-        }
-    }
-    
-    if (matches) {
+    if (MatchesTargetColor(screenColor)) {
         // Output the original pixel color (passthrough)
         FragColor = vec4(screenColor, 1.0);
     } else {
@@ -343,29 +304,58 @@ void main() {
     FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
 })";
 
-// Render shader - brute force border rendering
-static const char* mt_render_frag_shader = R"(#version 330 core
+// Dynamic border engine (separable dilation)
+// The border test "any covered texel in the (2w+1)^2 window" is a max filter, which is separable:
+//   Pass A (mt_border_dilate_frag_shader): horizontal max of the coverage mask into an R8 scratch
+//          texture that is 2w rows taller than the final image (rows -w..h+w-1), so the vertical
+//          taps of Pass B never leave the texture and edge clamping matches the original shader.
+//   Pass B (render shaders): center test + vertical max over 2w+1 scratch texels.
+// Cost per output pixel is 4w+2 taps instead of (2w+1)^2. MirrorCpuFinalPassReference in
+// tests/mirror_cpu_filter.cpp keeps the brute-force version for pixel-exact comparison.
+static const char* mt_border_dilate_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+uniform sampler2D filterTexture;
+uniform int u_borderWidth;
+uniform vec2 u_screenPixel;
+void main() {
+    // Scratch row r holds final row r - borderWidth
+    vec2 texCoord = vec2(gl_FragCoord.x, gl_FragCoord.y - float(u_borderWidth)) * u_screenPixel;
+    float covered = 0.0;
+    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
+        vec2 offset = vec2(float(x) * u_screenPixel.x, 0.0);
+        if (texture(filterTexture, texCoord + offset).a > 0.5) {
+            covered = 1.0;
+            break;
+        }
+    }
+    FragColor = vec4(covered, 0.0, 0.0, 0.0);
+})";
+
+// Vertical half of the border dilation, shared by both render shaders
+#define MT_BORDER_DILATE_GLSL                                                                                                              \
+    "uniform sampler2D u_dilateTexture;\n"                                                                                                \
+    "bool HasBorderCoverage(int borderWidth) {\n"                                                                                         \
+    "    ivec2 p = ivec2(gl_FragCoord.xy);\n"                                                                                             \
+    "    for (int k = 0; k <= 2 * borderWidth; k++) {\n"                                                                                  \
+    "        if (texelFetch(u_dilateTexture, ivec2(p.x, p.y + k), 0).r > 0.5) return true;\n"                                             \
+    "    }\n"                                                                                                                             \
+    "    return false;\n"                                                                                                                 \
+    "}\n"
+
+// Render shader - dynamic border from the separable dilation
+static const char* mt_render_frag_shader = "#version 330 core\n" MT_BORDER_DILATE_GLSL R"(
 out vec4 FragColor;
 in vec2 TexCoord;
 uniform sampler2D filterTexture;
 uniform int u_borderWidth;
 uniform vec4 u_outputColor;
 uniform vec4 u_borderColor;
-uniform vec2 u_screenPixel;
 void main() {
     if (texture(filterTexture, TexCoord).a > 0.5) {
         FragColor = u_outputColor;
         return;
     }
-    float maxA = 0.0;
-    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
-        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
-            if (x == 0 && y == 0) continue;
-            vec2 offset = vec2(x, y) * u_screenPixel;
-            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
-        }
-    }
-    if (maxA > 0.5) {
+    if (u_borderWidth > 0 && HasBorderCoverage(u_borderWidth)) {
         FragColor = u_borderColor;
     } else {
         discard;
@@ -373,13 +363,12 @@ void main() {
 })";
 
 // Render shader for color passthrough - preserves original pixel color from filter texture
-static const char* mt_render_passthrough_frag_shader = R"(#version 330 core
+static const char* mt_render_passthrough_frag_shader = "#version 330 core\n" MT_BORDER_DILATE_GLSL R"(
 out vec4 FragColor;
 in vec2 TexCoord;
 uniform sampler2D filterTexture;
 uniform int u_borderWidth;
 uniform vec4 u_borderColor;
-uniform vec2 u_screenPixel;
 void main() {
     vec4 texColor = texture(filterTexture, TexCoord);
     if (texColor.a > 0.5) {
@@ -387,15 +376,7 @@ void main() {
         FragColor = vec4(texColor.rgb, 1.0);
         return;
     }
-    float maxA = 0.0;
-    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
-        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
-            if (x == 0 && y == 0) continue;
-            vec2 offset = vec2(x, y) * u_screenPixel;
-            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
-        }
-    }
-    if (maxA > 0.5) {
+    if (u_borderWidth > 0 && HasBorderCoverage(u_borderWidth)) {
         FragColor = u_borderColor;
     } else {
         discard;
@@ -490,23 +471,19 @@ static GLuint mt_passthroughProgram = 0;
 static GLuint mt_backgroundProgram = 0;
 static GLuint mt_renderProgram = 0;
 static GLuint mt_renderPassthroughProgram = 0; // Color passthrough render shader
+static GLuint mt_borderDilateProgram = 0;      // Horizontal pass of the dynamic border dilation
 static GLuint mt_staticBorderProgram = 0;      // Static border shape shader
 
 // Uniform locations for local shaders
 struct MT_FilterShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
-    GLint gammaMode = -1;
-    GLint targetColors = -1;     // Array of target colors (up to 8)
-    GLint targetColorCount = -1; // Number of active target colors
-    GLint outputColor = -1, sensitivity = -1;
+    GLint matchLut = -1; // usampler2D color-match table (texture unit 1)
+    GLint outputColor = -1;
 };
 // Color passthrough filter shader uniform locations (no outputColor since it uses original pixel)
 struct MT_FilterPassthroughShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
-    GLint gammaMode = -1;
-    GLint targetColors = -1;     // Array of target colors (up to 8)
-    GLint targetColorCount = -1; // Number of active target colors
-    GLint sensitivity = -1;
+    GLint matchLut = -1; // usampler2D color-match table (texture unit 1)
 };
 struct MT_PassthroughShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
@@ -515,11 +492,15 @@ struct MT_BackgroundShaderLocs {
     GLint backgroundTexture = -1, opacity = -1;
 };
 struct MT_RenderShaderLocs {
-    GLint filterTexture = -1, borderWidth = -1, outputColor = -1, borderColor = -1, screenPixel = -1;
+    GLint filterTexture = -1, dilateTexture = -1, borderWidth = -1, outputColor = -1, borderColor = -1;
 };
 // Color passthrough render shader uniform locations (no outputColor since it uses original pixel)
 struct MT_RenderPassthroughShaderLocs {
-    GLint filterTexture = -1, borderWidth = -1, borderColor = -1, screenPixel = -1;
+    GLint filterTexture = -1, dilateTexture = -1, borderWidth = -1, borderColor = -1;
+};
+
+struct MT_BorderDilateShaderLocs {
+    GLint filterTexture = -1, borderWidth = -1, screenPixel = -1;
 };
 // Static border shader uniform locations
 struct MT_StaticBorderShaderLocs {
@@ -531,6 +512,7 @@ static MT_PassthroughShaderLocs mt_passthroughShaderLocs;
 static MT_BackgroundShaderLocs mt_backgroundShaderLocs;
 static MT_RenderShaderLocs mt_renderShaderLocs;
 static MT_RenderPassthroughShaderLocs mt_renderPassthroughShaderLocs;
+static MT_BorderDilateShaderLocs mt_borderDilateShaderLocs;
 static MT_StaticBorderShaderLocs mt_staticBorderShaderLocs;
 
 static MT_FilterPassthroughShaderLocs mt_filterPassthroughShaderLocs;
@@ -579,7 +561,7 @@ static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
 }
 
 static bool MT_InitializeShaders() {
-    LogCategory("init", "Mirror Thread: Initializing local shaders...");
+    LogCategory(LogCat::Init, "Mirror Thread: Initializing local shaders...");
 
     mt_filterProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_frag_shader);
     mt_filterPassthroughProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_passthrough_frag_shader);
@@ -587,10 +569,11 @@ static bool MT_InitializeShaders() {
     mt_backgroundProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_background_frag_shader);
     mt_renderProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_render_frag_shader);
     mt_renderPassthroughProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_render_passthrough_frag_shader);
+    mt_borderDilateProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_border_dilate_frag_shader);
     mt_staticBorderProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_static_border_frag_shader);
 
     if (!mt_filterProgram || !mt_filterPassthroughProgram || !mt_passthroughProgram || !mt_backgroundProgram || !mt_renderProgram ||
-        !mt_renderPassthroughProgram || !mt_staticBorderProgram) {
+        !mt_renderPassthroughProgram || !mt_borderDilateProgram || !mt_staticBorderProgram) {
         Log("Mirror Thread: FATAL - Failed to create basic shader programs");
         return false;
     }
@@ -598,19 +581,13 @@ static bool MT_InitializeShaders() {
     // Get uniform locations for basic shaders
     mt_filterShaderLocs.screenTexture = glGetUniformLocation(mt_filterProgram, "screenTexture");
     mt_filterShaderLocs.sourceRect = glGetUniformLocation(mt_filterProgram, "u_sourceRect");
-    mt_filterShaderLocs.gammaMode = glGetUniformLocation(mt_filterProgram, "u_gammaMode");
-    mt_filterShaderLocs.targetColors = glGetUniformLocation(mt_filterProgram, "u_targetColors");
-    mt_filterShaderLocs.targetColorCount = glGetUniformLocation(mt_filterProgram, "u_targetColorCount");
+    mt_filterShaderLocs.matchLut = glGetUniformLocation(mt_filterProgram, "u_matchLut");
     mt_filterShaderLocs.outputColor = glGetUniformLocation(mt_filterProgram, "outputColor");
-    mt_filterShaderLocs.sensitivity = glGetUniformLocation(mt_filterProgram, "u_sensitivity");
 
     // Get uniform locations for color passthrough filter shader
     mt_filterPassthroughShaderLocs.screenTexture = glGetUniformLocation(mt_filterPassthroughProgram, "screenTexture");
     mt_filterPassthroughShaderLocs.sourceRect = glGetUniformLocation(mt_filterPassthroughProgram, "u_sourceRect");
-    mt_filterPassthroughShaderLocs.gammaMode = glGetUniformLocation(mt_filterPassthroughProgram, "u_gammaMode");
-    mt_filterPassthroughShaderLocs.targetColors = glGetUniformLocation(mt_filterPassthroughProgram, "u_targetColors");
-    mt_filterPassthroughShaderLocs.targetColorCount = glGetUniformLocation(mt_filterPassthroughProgram, "u_targetColorCount");
-    mt_filterPassthroughShaderLocs.sensitivity = glGetUniformLocation(mt_filterPassthroughProgram, "u_sensitivity");
+    mt_filterPassthroughShaderLocs.matchLut = glGetUniformLocation(mt_filterPassthroughProgram, "u_matchLut");
 
     mt_passthroughShaderLocs.screenTexture = glGetUniformLocation(mt_passthroughProgram, "screenTexture");
     mt_passthroughShaderLocs.sourceRect = glGetUniformLocation(mt_passthroughProgram, "u_sourceRect");
@@ -619,16 +596,20 @@ static bool MT_InitializeShaders() {
     mt_backgroundShaderLocs.opacity = glGetUniformLocation(mt_backgroundProgram, "u_opacity");
 
     mt_renderShaderLocs.filterTexture = glGetUniformLocation(mt_renderProgram, "filterTexture");
+    mt_renderShaderLocs.dilateTexture = glGetUniformLocation(mt_renderProgram, "u_dilateTexture");
     mt_renderShaderLocs.borderWidth = glGetUniformLocation(mt_renderProgram, "u_borderWidth");
     mt_renderShaderLocs.outputColor = glGetUniformLocation(mt_renderProgram, "u_outputColor");
     mt_renderShaderLocs.borderColor = glGetUniformLocation(mt_renderProgram, "u_borderColor");
-    mt_renderShaderLocs.screenPixel = glGetUniformLocation(mt_renderProgram, "u_screenPixel");
 
     // Get uniform locations for color passthrough render shader
     mt_renderPassthroughShaderLocs.filterTexture = glGetUniformLocation(mt_renderPassthroughProgram, "filterTexture");
+    mt_renderPassthroughShaderLocs.dilateTexture = glGetUniformLocation(mt_renderPassthroughProgram, "u_dilateTexture");
     mt_renderPassthroughShaderLocs.borderWidth = glGetUniformLocation(mt_renderPassthroughProgram, "u_borderWidth");
     mt_renderPassthroughShaderLocs.borderColor = glGetUniformLocation(mt_renderPassthroughProgram, "u_borderColor");
-    mt_renderPassthroughShaderLocs.screenPixel = glGetUniformLocation(mt_renderPassthroughProgram, "u_screenPixel");
+
+    mt_borderDilateShaderLocs.filterTexture = glGetUniformLocation(mt_borderDilateProgram, "filterTexture");
+    mt_borderDilateShaderLocs.borderWidth = glGetUniformLocation(mt_borderDilateProgram, "u_borderWidth");
+    mt_borderDilateShaderLocs.screenPixel = glGetUniformLocation(mt_borderDilateProgram, "u_screenPixel");
 
     // Get uniform locations for static border shader
     mt_staticBorderShaderLocs.shape = glGetUniformLocation(mt_staticBorderProgram, "u_shape");
@@ -640,11 +621,11 @@ static bool MT_InitializeShaders() {
     // Set texture sampler uniforms once
     glUseProgram(mt_filterProgram);
     glUniform1i(mt_filterShaderLocs.screenTexture, 0);
-    if (mt_filterShaderLocs.gammaMode >= 0) { glUniform1i(mt_filterShaderLocs.gammaMode, 0); }
+    glUniform1i(mt_filterShaderLocs.matchLut, 1);
 
     glUseProgram(mt_filterPassthroughProgram);
     glUniform1i(mt_filterPassthroughShaderLocs.screenTexture, 0);
-    if (mt_filterPassthroughShaderLocs.gammaMode >= 0) { glUniform1i(mt_filterPassthroughShaderLocs.gammaMode, 0); }
+    glUniform1i(mt_filterPassthroughShaderLocs.matchLut, 1);
 
     glUseProgram(mt_passthroughProgram);
     glUniform1i(mt_passthroughShaderLocs.screenTexture, 0);
@@ -654,13 +635,18 @@ static bool MT_InitializeShaders() {
 
     glUseProgram(mt_renderProgram);
     glUniform1i(mt_renderShaderLocs.filterTexture, 0);
+    glUniform1i(mt_renderShaderLocs.dilateTexture, 1);
 
     glUseProgram(mt_renderPassthroughProgram);
     glUniform1i(mt_renderPassthroughShaderLocs.filterTexture, 0);
+    glUniform1i(mt_renderPassthroughShaderLocs.dilateTexture, 1);
+
+    glUseProgram(mt_borderDilateProgram);
+    glUniform1i(mt_borderDilateShaderLocs.filterTexture, 0);
 
     glUseProgram(0);
 
-    LogCategory("init", "Mirror Thread: Local shaders initialized successfully");
+    LogCategory(LogCat::Init, "Mirror Thread: Local shaders initialized successfully");
     return true;
 }
 
@@ -689,12 +675,21 @@ static void MT_CleanupShaders() {
         glDeleteProgram(mt_renderPassthroughProgram);
         mt_renderPassthroughProgram = 0;
     }
+    if (mt_borderDilateProgram) {
+        glDeleteProgram(mt_borderDilateProgram);
+        mt_borderDilateProgram = 0;
+    }
     if (mt_staticBorderProgram) {
         glDeleteProgram(mt_staticBorderProgram);
         mt_staticBorderProgram = 0;
     }
 }
 
+void GetMirrorFilterPassCounts(int& outRun, int& outShared) {
+    outRun = g_mirrorFilterPassesRun.load(std::memory_order_relaxed);
+    outShared = g_mirrorFilterPassesShared.load(std::memory_order_relaxed);
+}
+
 // Get the most recent copy texture (for OBS/render_thread to use)
 GLuint GetGameCopyTexture() {
     int readIndex = g_lastCopyReadIndex.load(std::memory_order_acquire);
@@ -734,6 +729,7 @@ GLuint GetSafeReadTexture() {
     int writeIndex = g_copyTextureWriteIndex.load(std::memory_order_acquire);
     int readIndex = 1 - writeIndex; // The OTHER buffer is always safe to read
     if (g_copyTextures[readIndex] == 0) return 0;
+    if (g_copyTextureIsAtlas[readIndex].load(std::memory_order_acquire)) return 0; // Mirror atlas, not a game frame
     return g_copyTextures[readIndex];
 }
 
@@ -762,17 +758,16 @@ void InitCaptureTexture(int width, int height) {
     g_copyTextureWriteIndex.store(0);
     g_copyTextureReadIndex.store(-1);
 
-    LogCategory("init", "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
-                            std::to_string(height));
+    LogCategory(LogCat::Init, "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
+                                  std::to_string(height));
 }
 
 void CleanupCaptureTexture() {
     // Cleanup capture resources - call from capture thread or main thread with GL context current
     // Drain the lock-free queue and delete any remaining fences
-    FrameCaptureNotification notif;
-    while (CaptureQueuePop(notif)) {
+    g_captureQueue.ConsumeAll([](FrameCaptureNotification& notif) {
         if (notif.fence && glIsSync(notif.fence)) { glDeleteSync(notif.fence); }
-    }
+    });
 
     // Also clear the render-thread fallback fence. This fence may have been created in a different
     // share group if the game recreates its GL context; deleting it later from the wrong context
@@ -786,6 +781,10 @@ void CleanupCaptureTexture() {
         g_readyFrameIndex.store(-1, std::memory_order_release);
         g_readyFrameWidth.store(0, std::memory_order_release);
         g_readyFrameHeight.store(0, std::memory_order_release);
+        for (int i = 0; i < 2; i++) {
+            std::atomic_store_explicit(&g_copyTexturePlans[i], std::shared_ptr<const MirrorCapturePlan>(), std::memory_order_release);
+            g_copyTextureIsAtlas[i].store(false, std::memory_order_release);
+        }
     }
 
     // Delete textures and FBO
@@ -803,10 +802,76 @@ void CleanupCaptureTexture() {
     Log("CleanupCaptureTexture: Cleaned up FBO and textures");
 }
 
-void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
+// Returns the capture plan for the current mirror configs at the given game size, or null when a
+// full-frame copy should be used. Recompiled only when configs or the game size change.
+// Called from the game thread (SwapBuffers hook).
+static std::shared_ptr<const MirrorCapturePlan> MT_GetCapturePlan(int gameW, int gameH) {
+    static std::shared_ptr<const MirrorCapturePlan> s_plan;
+    static uint64_t s_planVersion = 0;
+    static int s_planGameW = 0, s_planGameH = 0;
+
+    const uint64_t v = g_threadedMirrorConfigsVersion.load(std::memory_order_acquire);
+    if (v == s_planVersion && gameW == s_planGameW && gameH == s_planGameH) { return s_plan; }
+
+    PROFILE_SCOPE_CAT("Compile Capture Plan", "SwapBuffers");
+    std::vector<CaptureRect> rects;
+    {
+        std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
+        for (const auto& conf : g_threadedMirrorConfigs) {
+            for (const auto& r : conf.input) {
+                int capX = 0, capY = 0;
+                GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+                rects.push_back({ capX, capY, conf.captureWidth, conf.captureHeight });
+            }
+        }
+    }
+
+    auto plan = std::make_shared<MirrorCapturePlan>();
+    if (CompileMirrorCapturePlan(rects, gameW, gameH, *plan)) {
+        plan->configVersion = v;
+        s_plan = std::move(plan);
+        LOG_FMT_CAT(LogCat::TextureOps, "SubmitFrameCapture: Capture plan {} region(s), atlas {}x{} for game {}x{}", s_plan->entries.size(),
+                    s_plan->atlasW, s_plan->atlasH, gameW, gameH);
+    } else {
+        s_plan.reset();
+    }
+
+    s_planVersion = v;
+    s_planGameW = gameW;
+    s_planGameH = gameH;
+    return s_plan;
+}
+
+// Maps a mirror input region to its rectangle in a copy texture (GL bottom-up origin).
+// Without a plan the copy texture is the full game frame. Returns false if the plan doesn't cover it.
+static bool MT_ResolveCopySourceRect(const MirrorCapturePlan* plan, const ThreadedMirrorConfig& conf, const MirrorCaptureConfig& r, int gameW,
+                                     int gameH, int& outX, int& outY_gl, int& outTexW, int& outTexH) {
+    int capX = 0, capY = 0;
+    GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+    if (!plan) {
+        outX = capX;
+        outY_gl = gameH - capY - conf.captureHeight;
+        outTexW = gameW;
+        outTexH = gameH;
+        return true;
+    }
+
+    int atlasX = 0, atlasY = 0;
+    if (!MapCaptureRectToAtlas(*plan, { capX, capY, conf.captureWidth, conf.captureHeight }, atlasX, atlasY)) { return false; }
+    // The atlas sits in the top-left corner of full-frame copy storage
+    outX = atlasX;
+    outY_gl = plan->gameH - atlasY - conf.captureHeight;
+    outTexW = plan->gameW;
+    outTexH = plan->gameH;
+    return true;
+}
+
+void SubmitFrameCapture(GLuint gameTexture, int width, int height, bool mirrorsOnly) {
     // Called from SwapBuffers hook - does ASYNC GPU blit (non-blocking)
     // The GPU executes the blit in the background while SwapBuffers continues.
     // Consumers wait on the fence before reading the copy.
+    // mirrorsOnly: no full-frame consumer (OBS, EyeZoom, virtual camera) needs this frame, so only the
+    // mirror input regions are copied into a packed atlas when that is meaningfully smaller.
 
     if (g_copyFBO == 0) {
         // Not initialized yet
@@ -861,11 +926,18 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     glDisable(GL_DITHER);
     if (hasFramebufferSRGB) { glDisable(GL_FRAMEBUFFER_SRGB); }
 
+    std::shared_ptr<const MirrorCapturePlan> plan;
+    if (mirrorsOnly) { plan = MT_GetCapturePlan(width, height); }
+    // Copy textures always have full-frame storage; an atlas is packed into their top-left corner.
+    // Switching between full and region copies therefore never reallocates or waits on a fence.
+    const int texW = width;
+    const int texH = height;
+
     // Resize copy textures to match game content EXACTLY
     // This ensures UV coordinates work correctly for mirrors (no need to scale UVs)
     // IMPORTANT: Only resize the WRITE texture, not the read texture that other threads may be using
     int writeIndex = g_copyTextureWriteIndex.load(std::memory_order_acquire);
-    bool dimensionsChanged = (width != g_copyTextureW || height != g_copyTextureH);
+    bool dimensionsChanged = (texW != g_copyTextureW || texH != g_copyTextureH);
 
     if (dimensionsChanged) {
         // Resize BOTH textures since dimensions have changed
@@ -884,7 +956,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
 
         for (int i = 0; i < 2; i++) {
             glBindTexture(GL_TEXTURE_2D, g_copyTextures[i]);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texW, texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         }
         glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -895,13 +967,14 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
         GLsync resizeFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
         glFlush(); // Ensure fence and resize commands are submitted to GPU
         if (resizeFence) {
+            PROFILE_SCOPE_CAT("Wait for Resize Fence", "Wait");
             glClientWaitSync(resizeFence, GL_SYNC_FLUSH_COMMANDS_BIT, 500000000ULL); // 500ms timeout
             if (glIsSync(resizeFence)) { glDeleteSync(resizeFence); }
         }
 
-        g_copyTextureW = width;
-        g_copyTextureH = height;
-        LogCategory("texture_ops", "SubmitFrameCapture: Resized copy textures to " + std::to_string(width) + "x" + std::to_string(height));
+        g_copyTextureW = texW;
+        g_copyTextureH = texH;
+        LOG_FMT_CAT(LogCat::TextureOps, "SubmitFrameCapture: Resized copy textures to {}x{}", texW, texH);
     }
 
     // Reuse a cached FBO for reading from the game texture (avoid per-frame create/delete)
@@ -915,7 +988,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (srcStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_srcIncompleteLog = 0;
         if ((++s_srcIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
+            LogCategory(LogCat::TextureOps,
                         "SubmitFrameCapture: Source FBO incomplete (status " + std::to_string(srcStatus) + ") gameTex=" +
                             std::to_string(gameTexture) + " size=" + std::to_string(width) + "x" + std::to_string(height));
         }
@@ -936,7 +1009,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (dstStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_dstIncompleteLog = 0;
         if ((++s_dstIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
+            LogCategory(LogCat::TextureOps,
                         "SubmitFrameCapture: Destination FBO incomplete (status " + std::to_string(dstStatus) + ") writeIdx=" +
                             std::to_string(writeIndex) + " dstTex=" + std::to_string(g_copyTextures[writeIndex]) + " size=" +
                             std::to_string(width) + "x" + std::to_string(height));
@@ -948,8 +1021,26 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
         return;
     }
 
-    // Async GPU-to-GPU blit - this is queued but executed by GPU in background
-    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    if (plan) {
+        // The write texture is about to hold an atlas: never let OBS keep reading it as a ready frame
+        if (g_readyFrameIndex.load(std::memory_order_acquire) == writeIndex) {
+            g_readyFrameIndex.store(-1, std::memory_order_release);
+            g_readyFrameWidth.store(0, std::memory_order_release);
+            g_readyFrameHeight.store(0, std::memory_order_release);
+        }
+
+        // Async GPU-to-GPU blit of each planned region (plan rects are top-left origin, GL is bottom-up).
+        // Texels outside the atlas keep whatever the last full copy left there; nothing samples them.
+        for (const auto& e : plan->entries) {
+            const int srcY = height - e.src.y - e.src.h;
+            const int dstY = texH - e.atlasY - e.src.h;
+            glBlitFramebuffer(e.src.x, srcY, e.src.x + e.src.w, srcY + e.src.h, e.atlasX, dstY, e.atlasX + e.src.w, dstY + e.src.h,
+                              GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+    } else {
+        // Async GPU-to-GPU blit - this is queued but executed by GPU in background
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
 
     // Unbind FBOs (srcFBO is cached and reused across frames)
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
@@ -973,6 +1064,10 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     // CRITICAL: Flush to ensure commands are submitted and fence is visible to other contexts
     glFlush();
 
+    // Record what this copy texture holds before it becomes readable
+    g_copyTextureIsAtlas[writeIndex].store(plan != nullptr, std::memory_order_release);
+    std::atomic_store_explicit(&g_copyTexturePlans[writeIndex], plan, std::memory_order_release);
+
     // Swap write index for next frame (double buffering)
     int nextWriteIndex = 1 - writeIndex;
     g_copyTextureWriteIndex.store(nextWriteIndex, std::memory_order_release);
@@ -981,19 +1076,20 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     // Delete old fence before storing new one (render thread fence management)
     GLsync oldFence = g_lastCopyFence.exchange(fenceForRenderThread, std::memory_order_acq_rel);
     if (oldFence && glIsSync(oldFence)) { glDeleteSync(oldFence); }
-    g_lastCopyReadIndex.store(writeIndex, std::memory_order_release);
-    g_lastCopyWidth.store(width, std::memory_order_release);
-    g_lastCopyHeight.store(height, std::memory_order_release);
+    // An atlas is not a game frame: render-thread fallbacks must not pick it up
+    g_lastCopyReadIndex.store(plan ? -1 : writeIndex, std::memory_order_release);
+    g_lastCopyWidth.store(plan ? 0 : width, std::memory_order_release);
+    g_lastCopyHeight.store(plan ? 0 : height, std::memory_order_release);
 
     // Notify mirror thread (lock-free queue) - include texture index so mirror thread uses correct texture
     FrameCaptureNotification notif = { 0, fenceForMirrorThread, width, height, writeIndex };
-    if (!CaptureQueuePush(notif)) {
-        // Queue full - delete the fence since mirror thread won't get it
-        if (glIsSync(fenceForMirrorThread)) { glDeleteSync(fenceForMirrorThread); }
-    } else {
-        // Wake mirror thread so it doesn't have to poll.
-        g_captureSignalCV.notify_one();
-    }
+    g_captureQueue.Push(notif, [](FrameCaptureNotification& stale) {
+        // Queue full - the mirror thread will never see the evicted frame, delete its fence
+        MetricAdd(g_metricCaptureNotificationsDropped);
+        if (stale.fence && glIsSync(stale.fence)) { glDeleteSync(stale.fence); }
+    });
+    // Wake mirror thread so it doesn't have to poll.
+    g_captureSignalCV.notify_one();
 
     restoreState();
 }
@@ -1072,13 +1168,57 @@ static void ComputeMirrorRenderCache(MirrorInstance* inst, const ThreadedMirrorC
     cache.isValid = true;
 }
 
-// Helper: Render a single mirror to its back buffer
-// Returns true if rendering succeeded
-static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint validCopyTexture, GLuint captureVAO,
-                                     GLuint captureVBO, GLuint captureBackFbo, GLuint captureFinalBackFbo, MirrorGammaMode gammaMode,
-                                     int gameW, int gameH) {
-    PROFILE_SCOPE_CAT("Capture Single Mirror", "Mirror Thread");
+// Mirror-thread local scratch target for the horizontal border dilation pass.
+// One R8 texture shared by all mirrors (they render sequentially); it only ever grows.
+struct MT_BorderDilateTarget {
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+};
 
+static bool MT_EnsureBorderDilateTarget(MT_BorderDilateTarget& target, int w, int h) {
+    if (w <= 0 || h <= 0) return false;
+    if (target.fbo != 0 && target.texture != 0 && target.width >= w && target.height >= h) return true;
+
+    const int newW = (std::max)(w, target.width);
+    const int newH = (std::max)(h, target.height);
+    if (target.fbo == 0) { glGenFramebuffers(1, &target.fbo); }
+    if (target.texture == 0) { glGenTextures(1, &target.texture); }
+
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, newW, newH, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    GLenum st = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (st != GL_FRAMEBUFFER_COMPLETE) {
+        Log("Mirror Capture Thread: border dilation FBO incomplete (status " + std::to_string(st) + ")");
+        target.width = target.height = 0;
+        return false;
+    }
+
+    target.width = newW;
+    target.height = newH;
+    return true;
+}
+
+static void MT_CleanupBorderDilateTarget(MT_BorderDilateTarget& target) {
+    if (target.fbo != 0) { glDeleteFramebuffers(1, &target.fbo); }
+    if (target.texture != 0) { glDeleteTextures(1, &target.texture); }
+    target = MT_BorderDilateTarget{};
+}
+
+// Helper: Pass 1 - filter (or raw-copy) every input region of a mirror into its filter FBO (inst->fboTextureBack)
+// sourceColors: keep the matched pixels' source colors even without Color Passthrough (content statistics readback)
+static void RenderMirrorFilterPass(MirrorInstance* inst, const ThreadedMirrorConfig& conf, bool useRawOutput, GLuint validCopyTexture,
+                                   GLuint captureVAO, GLuint captureVBO, GLuint captureBackFbo, GLuint colorLutTexture,
+                                   const MirrorCapturePlan* capturePlan, int gameW, int gameH, bool sourceColors = false) {
     // Capture to back buffer
     glBindFramebuffer(GL_FRAMEBUFFER, captureBackFbo);
     if (oglViewport)
@@ -1100,9 +1240,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, validCopyTexture);
 
-    // Read rawOutput state directly from instance
-    bool useRawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
-    bool useColorPassthrough = conf.colorPassthrough;
+    bool useColorPassthrough = conf.colorPassthrough || sourceColors;
 
     // Use appropriate shader (local shader programs - not shared between GL contexts)
     if (useRawOutput) {
@@ -1112,39 +1250,19 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
         // Color passthrough mode: output original pixel color when matching target colors
         glUseProgram(mt_filterPassthroughProgram);
         glUniform1i(mt_filterPassthroughShaderLocs.screenTexture, 0);
-        if (mt_filterPassthroughShaderLocs.gammaMode >= 0) {
-            glUniform1i(mt_filterPassthroughShaderLocs.gammaMode, static_cast<int>(gammaMode));
-        }
-
-        // Pass multiple target colors to shader (max 8)
-        int colorCount = (std::min)(static_cast<int>(conf.targetColors.size()), 8);
-        glUniform1i(mt_filterPassthroughShaderLocs.targetColorCount, colorCount);
-
-        // Set each target color in the array
-        for (int i = 0; i < colorCount; i++) {
-            glUniform3f(mt_filterPassthroughShaderLocs.targetColors + i, conf.targetColors[i].r, conf.targetColors[i].g,
-                        conf.targetColors[i].b);
-        }
-
-        glUniform1f(mt_filterPassthroughShaderLocs.sensitivity, conf.colorSensitivity);
+        glUniform1i(mt_filterPassthroughShaderLocs.matchLut, 1);
     } else {
         glUseProgram(mt_filterProgram);
         glUniform1i(mt_filterShaderLocs.screenTexture, 0);
-        if (mt_filterShaderLocs.gammaMode >= 0) {
-            glUniform1i(mt_filterShaderLocs.gammaMode, static_cast<int>(gammaMode));
-        }
-
-        // Pass multiple target colors to shader (max 8)
-        int colorCount = (std::min)(static_cast<int>(conf.targetColors.size()), 8);
-        glUniform1i(mt_filterShaderLocs.targetColorCount, colorCount);
-
-        // Set each target color in the array
-        for (int i = 0; i < colorCount; i++) {
-            glUniform3f(mt_filterShaderLocs.targetColors + i, conf.targetColors[i].r, conf.targetColors[i].g, conf.targetColors[i].b);
-        }
-
+        glUniform1i(mt_filterShaderLocs.matchLut, 1);
         glUniform4f(mt_filterShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b, conf.outputColor.a);
-        glUniform1f(mt_filterShaderLocs.sensitivity, conf.colorSensitivity);
+    }
+
+    // Bind the precomputed color-match table (target colors + sensitivity + gamma baked in)
+    if (!useRawOutput) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, colorLutTexture);
+        glActiveTexture(GL_TEXTURE0);
     }
 
     glBindVertexArray(captureVAO);
@@ -1171,14 +1289,17 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     else
         glViewport(padding, padding, conf.captureWidth, conf.captureHeight);
 
+    // No table yet (first build still running on the builder): nothing matches, so the cleared FBO is the output
+    const bool tableReady = useRawOutput || colorLutTexture != 0;
+
     for (const auto& r : conf.input) {
-        int capX, capY;
-        GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
-        int capY_gl = gameH - capY - conf.captureHeight;
-        float sx = static_cast<float>(capX) / gameW;
-        float sy = static_cast<float>(capY_gl) / gameH;
-        float sw = static_cast<float>(conf.captureWidth) / gameW;
-        float sh = static_cast<float>(conf.captureHeight) / gameH;
+        if (!tableReady) { break; }
+        int srcX, srcY_gl, texW, texH;
+        if (!MT_ResolveCopySourceRect(capturePlan, conf, r, gameW, gameH, srcX, srcY_gl, texW, texH)) { continue; }
+        float sx = static_cast<float>(srcX) / texW;
+        float sy = static_cast<float>(srcY_gl) / texH;
+        float sw = static_cast<float>(conf.captureWidth) / texW;
+        float sh = static_cast<float>(conf.captureHeight) / texH;
 
         if (useRawOutput) {
             glUniform4f(mt_passthroughShaderLocs.sourceRect, sx, sy, sw, sh);
@@ -1192,6 +1313,36 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
 
     // Reset GL state after pass 1
     glDisable(GL_BLEND);
+}
+
+// Helper: Render a single mirror to its back buffer
+// sharedFilterTexture: filter output of another mirror with identical filter inputs rendered this frame
+// (0 = run this mirror's own filter pass). Only the border/output pass runs for shared mirrors.
+// Returns true if rendering succeeded
+static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint validCopyTexture, GLuint captureVAO,
+                                     GLuint captureVBO, GLuint captureBackFbo, GLuint captureFinalBackFbo, GLuint colorLutTexture,
+                                     MT_BorderDilateTarget& borderDilate, const MirrorCapturePlan* capturePlan, int gameW, int gameH,
+                                     GLuint sharedFilterTexture) {
+    PROFILE_SCOPE_CAT("Capture Single Mirror", "Mirror Thread");
+
+    // Read rawOutput state directly from instance
+    bool useRawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
+    bool useColorPassthrough = conf.colorPassthrough;
+
+    GLuint filterTexture = sharedFilterTexture;
+    if (filterTexture == 0) {
+        RenderMirrorFilterPass(inst, conf, useRawOutput, validCopyTexture, captureVAO, captureVBO, captureBackFbo, colorLutTexture,
+                               capturePlan, gameW, gameH);
+        filterTexture = inst->fboTextureBack;
+    } else {
+        glBindVertexArray(captureVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_STENCIL_TEST);
+        glDisable(GL_SCISSOR_TEST);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glActiveTexture(GL_TEXTURE0);
+    }
 
     // === Content Detection: Async PBO readback for non-zero alpha check ===
     // This is used by static borders to avoid rendering when mirror has no matching pixels.
@@ -1221,7 +1372,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Opaque for raw output
             glClear(GL_COLOR_BUFFER_BIT);
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+            glBindTexture(GL_TEXTURE_2D, filterTexture);
             glUseProgram(mt_backgroundProgram);
             glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
             glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
@@ -1240,7 +1391,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent
             glClear(GL_COLOR_BUFFER_BIT);
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+            glBindTexture(GL_TEXTURE_2D, filterTexture);
             glUseProgram(mt_backgroundProgram);
             glUniform1i(mt_backgroundShaderLocs.backgroundTexture, 0);
             glUniform1f(mt_backgroundShaderLocs.opacity, 1.0f);
@@ -1249,7 +1400,37 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
             glDrawArrays(GL_TRIANGLES, 0, 6);
         } else {
-            // Dynamic border mode: apply the border render shader
+            // Dynamic border mode: separable dilation (horizontal pass into scratch, vertical pass in the render shader)
+            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
+
+            int borderWidth = (std::max)(conf.dynamicBorderThickness, 0);
+            const int dilateH = inst->final_h_back + 2 * borderWidth;
+            if (borderWidth > 0 && !MT_EnsureBorderDilateTarget(borderDilate, inst->final_w_back, dilateH)) {
+                borderWidth = 0; // No scratch target: still draw the content, just without the border
+            }
+
+            glBindTexture(GL_TEXTURE_2D, filterTexture);
+            if (borderWidth > 0) {
+                // Pass A: horizontal max of the coverage mask, 2 * borderWidth extra rows
+                glBindFramebuffer(GL_FRAMEBUFFER, borderDilate.fbo);
+                if (oglViewport)
+                    oglViewport(0, 0, inst->final_w_back, dilateH);
+                else
+                    glViewport(0, 0, inst->final_w_back, dilateH);
+
+                glUseProgram(mt_borderDilateProgram);
+                glUniform1i(mt_borderDilateShaderLocs.borderWidth, borderWidth);
+                glUniform2f(mt_borderDilateShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+            }
+
+            // Always rebind unit 1 so the render shaders never see the color-match table from pass 1
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, borderDilate.texture);
+            glActiveTexture(GL_TEXTURE0);
+
+            // Pass B: content + vertical max
             glBindFramebuffer(GL_FRAMEBUFFER, captureFinalBackFbo);
             if (oglViewport)
                 oglViewport(0, 0, inst->final_w_back, inst->final_h_back);
@@ -1258,27 +1439,21 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent for non-raw
             glClear(GL_COLOR_BUFFER_BIT);
 
-            glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
             if (useColorPassthrough) {
                 // Use passthrough render shader - preserves original pixel color
                 glUseProgram(mt_renderPassthroughProgram);
-                glUniform1i(mt_renderPassthroughShaderLocs.borderWidth, conf.dynamicBorderThickness);
+                glUniform1i(mt_renderPassthroughShaderLocs.borderWidth, borderWidth);
                 glUniform4f(mt_renderPassthroughShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
                             conf.borderColor.a);
-                glUniform2f(mt_renderPassthroughShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
             } else {
                 // Use normal render shader - replaces pixel color with outputColor
                 glUseProgram(mt_renderProgram);
-                glUniform1i(mt_renderShaderLocs.borderWidth, conf.dynamicBorderThickness);
+                glUniform1i(mt_renderShaderLocs.borderWidth, borderWidth);
                 glUniform4f(mt_renderShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b,
                             conf.outputColor.a);
                 glUniform4f(mt_renderShaderLocs.borderColor, conf.borderColor.r, conf.borderColor.g, conf.borderColor.b,
                             conf.borderColor.a);
-                glUniform2f(mt_renderShaderLocs.screenPixel, 1.0f / inst->final_w_back, 1.0f / inst->final_h_back);
             }
-
-            static const float fullscreenVerts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullscreenVerts), fullscreenVerts);
             glDrawArrays(GL_TRIANGLES, 0, 6);
         }
 
@@ -1315,13 +1490,278 @@ struct MT_MirrorFbos {
     GLuint contentDownsampleTex = 0;
     int contentDownW = 0;
     int contentDownH = 0;
+
+    // Content statistics (mirror_stats.h): when enabled, the PBO holds the full-resolution
+    // filter FBO instead of the downsampled mask and is scanned exactly on harvest.
+    // Without Color Passthrough the filter output is the flat output color, so the filter
+    // pass is repeated with source colors into this target for the readback.
+    GLuint contentSourceFbo = 0;
+    GLuint contentSourceTex = 0;
+    int contentSourceW = 0;
+    int contentSourceH = 0;
+    bool contentReadbackIsFullRes = false;
+    bool contentReadbackHasSourceColors = false; // Matched pixels hold source colors (per-target counts possible)
+    int contentReadbackPadding = 0;
+    MirrorColorAttribution contentAttribution;
+    MirrorContentStats contentStats;
 };
 
+// Source-color target for a content-statistics mirror without Color Passthrough, sized like its filter FBO
+static bool MT_EnsureContentSourceTarget(MT_MirrorFbos& fb, int w, int h) {
+    if (fb.contentSourceFbo != 0 && fb.contentSourceTex != 0 && fb.contentSourceW == w && fb.contentSourceH == h) return true;
+
+    if (fb.contentSourceFbo == 0) { glGenFramebuffers(1, &fb.contentSourceFbo); }
+    if (fb.contentSourceTex == 0) { glGenTextures(1, &fb.contentSourceTex); }
+    glBindTexture(GL_TEXTURE_2D, fb.contentSourceTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fb.contentSourceFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fb.contentSourceTex, 0);
+    const GLenum st = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (st != GL_FRAMEBUFFER_COMPLETE) {
+        Log("Mirror Capture Thread: content statistics FBO incomplete (status " + std::to_string(st) + ")");
+        fb.contentSourceW = fb.contentSourceH = 0;
+        return false;
+    }
+    fb.contentSourceW = w;
+    fb.contentSourceH = h;
+    return true;
+}
+
+// Mirror-thread local color-match table texture (see mirror_color_lut.h).
+// Mirrors whose (target colors, sensitivity, gamma mode) are identical share one texture.
+struct MT_ColorLut {
+    MirrorColorMatchKey key;
+    GLuint texture = 0;
+    uint64_t lastUsedRefresh = 0; // MT_ColorLutCache::refreshCount when a mirror last referenced it
+};
+
+// Tables no mirror references are kept for a while so dragging a slider back and forth doesn't rebuild them
+static constexpr size_t kMaxUnusedColorLuts = 4;
+
+// Bakes color-match tables on a worker thread so a new key never stalls the capture loop.
+// Only the most recent set of wanted keys is queued: keys that went stale while a slider was being
+// dragged are dropped before they are built. Finished tables are handed back for upload on the mirror thread.
+class MT_ColorLutBuilder {
+  public:
+    ~MT_ColorLutBuilder() { Stop(); }
+
+    // Replaces the queue with the wanted keys that are not already being built or waiting for upload
+    void SetWanted(const std::vector<MirrorColorMatchKey>& keys) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.clear();
+        for (const MirrorColorMatchKey& key : keys) {
+            if (m_building && m_buildingKey == key) continue;
+            bool known = false;
+            for (const auto& done : m_finished) {
+                if (done.first == key) {
+                    known = true;
+                    break;
+                }
+            }
+            for (const MirrorColorMatchKey& queued : m_queue) {
+                if (queued == key) {
+                    known = true;
+                    break;
+                }
+            }
+            if (!known) m_queue.push_back(key);
+        }
+        if (m_queue.empty()) return;
+        if (!m_thread.joinable()) m_thread = std::thread(&MT_ColorLutBuilder::WorkerMain, this);
+        m_cv.notify_one();
+    }
+
+    // Takes one finished table, if any
+    bool TakeFinished(MirrorColorMatchKey& outKey, std::vector<uint32_t>& outWords) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_finished.empty()) return false;
+        outKey = std::move(m_finished.front().first);
+        outWords.swap(m_finished.front().second);
+        m_finished.erase(m_finished.begin());
+        return true;
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_queue.clear();
+        }
+        m_cv.notify_one();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+  private:
+    void WorkerMain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+
+            m_buildingKey = std::move(m_queue.front());
+            m_queue.erase(m_queue.begin());
+            m_building = true;
+            lock.unlock();
+
+            std::vector<uint32_t> words;
+            {
+                PROFILE_SCOPE_CAT("Build Color Match Table", "Mirror Thread");
+                BuildMirrorColorMatchTable(m_buildingKey, words);
+            }
+
+            lock.lock();
+            m_building = false;
+            m_finished.emplace_back(std::move(m_buildingKey), std::move(words));
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+    std::vector<MirrorColorMatchKey> m_queue;
+    MirrorColorMatchKey m_buildingKey; // Owned by the worker while m_building is set
+    bool m_building = false;
+    std::vector<std::pair<MirrorColorMatchKey, std::vector<uint32_t>>> m_finished;
+    bool m_stop = false;
+};
+
+struct MT_ColorLutCache {
+    std::vector<MT_ColorLut> luts;
+    std::unordered_map<std::string, GLuint> lastTextureForMirror; // Shown until the mirror's new table is ready
+    MT_ColorLutBuilder builder;
+    std::vector<uint32_t> uploadWords;
+    uint64_t refreshCount = 0;
+};
+
+// Uploads at most one finished table per call (a 2 MB texture upload). Returns true if one was added.
+static bool MT_UploadFinishedColorLut(MT_ColorLutCache& cache) {
+    MT_ColorLut lut;
+    if (!cache.builder.TakeFinished(lut.key, cache.uploadWords)) return false;
+
+    PROFILE_SCOPE_CAT("Upload Color Match Table", "Mirror Thread");
+    glGenTextures(1, &lut.texture);
+    glBindTexture(GL_TEXTURE_2D, lut.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, MIRROR_COLOR_LUT_WIDTH, MIRROR_COLOR_LUT_HEIGHT, 0, GL_RED_INTEGER, GL_UNSIGNED_INT,
+                 cache.uploadWords.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    lut.lastUsedRefresh = cache.refreshCount;
+    cache.luts.push_back(std::move(lut));
+    return true;
+}
+
+// Rebuild the per-config color-match table assignment without blocking: cached keys are assigned
+// directly, missing keys are queued on the builder and the mirror keeps its previous table (or none)
+// until the new one has been uploaded (MT_UploadFinishedColorLut marks the assignment dirty again).
+static void MT_RefreshColorLuts(const std::vector<ThreadedMirrorConfig>& configs, MirrorGammaMode gammaMode, MT_ColorLutCache& cache,
+                                std::vector<GLuint>& lutForConfig) {
+    PROFILE_SCOPE_CAT("Assign Color Match Tables", "Mirror Thread");
+
+    const uint64_t refresh = ++cache.refreshCount;
+    std::vector<MirrorColorMatchKey> missing;
+    std::unordered_map<std::string, GLuint> shownTextures;
+    lutForConfig.assign(configs.size(), 0);
+
+    for (size_t i = 0; i < configs.size(); i++) {
+        MirrorColorMatchKey key = MakeMirrorColorMatchKey(configs[i].targetColors, configs[i].colorSensitivity, gammaMode);
+
+        MT_ColorLut* found = nullptr;
+        for (MT_ColorLut& lut : cache.luts) {
+            if (lut.key == key) {
+                found = &lut;
+                break;
+            }
+        }
+
+        if (found) {
+            lutForConfig[i] = found->texture;
+        } else {
+            auto previous = cache.lastTextureForMirror.find(configs[i].name);
+            if (previous != cache.lastTextureForMirror.end()) { lutForConfig[i] = previous->second; }
+            missing.push_back(std::move(key));
+        }
+        if (lutForConfig[i]) { shownTextures[configs[i].name] = lutForConfig[i]; }
+    }
+    cache.lastTextureForMirror = std::move(shownTextures);
+    cache.builder.SetWanted(missing);
+
+    for (MT_ColorLut& lut : cache.luts) {
+        for (GLuint texture : lutForConfig) {
+            if (texture == lut.texture) {
+                lut.lastUsedRefresh = refresh;
+                break;
+            }
+        }
+    }
+
+    // Release the least recently used tables beyond the unused-table budget
+    std::sort(cache.luts.begin(), cache.luts.end(),
+              [](const MT_ColorLut& a, const MT_ColorLut& b) { return a.lastUsedRefresh > b.lastUsedRefresh; });
+    size_t keep = 0;
+    while (keep < cache.luts.size() && cache.luts[keep].lastUsedRefresh == refresh) keep++;
+    keep = (std::min)(cache.luts.size(), keep + kMaxUnusedColorLuts);
+    for (size_t j = keep; j < cache.luts.size(); j++) {
+        if (cache.luts[j].texture) { glDeleteTextures(1, &cache.luts[j].texture); }
+    }
+    cache.luts.resize(keep);
+
+    LogCategory(LogCat::TextureOps, "Mirror Capture Thread: " + std::to_string(cache.luts.size()) + " color match table(s) for " +
+                                        std::to_string(configs.size()) + " mirror(s), " + std::to_string(missing.size()) +
+                                        " being built");
+}
+
+// True when two mirrors' filter passes produce identical output: same input regions, capture size and
+// dynamic-border padding (the filter FBO layout), same color-match table (target colors + sensitivity +
+// gamma), same passthrough mode and, without passthrough, the same output color.
+// Raw output is decided per frame from the instance, so it is compared at render time.
+static bool MT_SameFilterInputs(const ThreadedMirrorConfig& a, GLuint lutA, const ThreadedMirrorConfig& b, GLuint lutB) {
+    const int padA = (a.borderType == MirrorBorderType::Dynamic) ? a.dynamicBorderThickness : 0;
+    const int padB = (b.borderType == MirrorBorderType::Dynamic) ? b.dynamicBorderThickness : 0;
+    if (lutA != lutB || padA != padB || a.captureWidth != b.captureWidth || a.captureHeight != b.captureHeight) return false;
+    if (a.colorPassthrough != b.colorPassthrough) return false;
+    if (!a.colorPassthrough && (a.outputColor.r != b.outputColor.r || a.outputColor.g != b.outputColor.g ||
+                                a.outputColor.b != b.outputColor.b || a.outputColor.a != b.outputColor.a)) {
+        return false;
+    }
+    if (a.input.size() != b.input.size()) return false;
+    for (size_t i = 0; i < a.input.size(); i++) {
+        if (a.input[i].x != b.input[i].x || a.input[i].y != b.input[i].y || a.input[i].relativeTo != b.input[i].relativeTo) return false;
+    }
+    return true;
+}
+
+// Assigns each config the index of the first config with identical filter inputs (itself if none).
+// Must run after MT_RefreshColorLuts, since the table assignment is part of the fingerprint.
+static void MT_BuildFilterGroups(const std::vector<ThreadedMirrorConfig>& configs, const std::vector<GLuint>& lutForConfig,
+                                 std::vector<size_t>& groupForConfig) {
+    groupForConfig.assign(configs.size(), 0);
+    for (size_t i = 0; i < configs.size(); i++) {
+        groupForConfig[i] = i;
+        for (size_t j = 0; j < i; j++) {
+            if (groupForConfig[j] == j && MT_SameFilterInputs(configs[i], lutForConfig[i], configs[j], lutForConfig[j])) {
+                groupForConfig[i] = j;
+                break;
+            }
+        }
+    }
+}
+
 static void MirrorCaptureThreadFunc(void* unused) {
     _set_se_translator(SEHTranslator);
 
     try {
         Log("Mirror Capture Thread: Starting thread loop...");
+        Profiler::GetInstance().SetThreadName("Mirror Capture");
 
         // Context should already be created and shared by StartMirrorCaptureThread on main thread
         if (!g_mirrorCaptureDC || !g_mirrorCaptureContext) {
@@ -1377,6 +1817,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
         // The render thread already blitted the game texture to g_copyTextures via GPU-to-GPU copy
         GLuint validTexture = 0;
         int validW = 0, validH = 0;
+        std::shared_ptr<const MirrorCapturePlan> validPlan; // Non-null when validTexture is a mirror atlas
         bool hasValidTexture = false;
 
 
@@ -1386,11 +1827,32 @@ static void MirrorCaptureThreadFunc(void* unused) {
         // Mirror config cache (refreshed only when configs change)
         uint64_t cachedConfigVersion = 0;
         std::vector<ThreadedMirrorConfig> configsCache;
-        std::vector<std::chrono::steady_clock::time_point> lastCaptureTimes; // indexed by configsCache
+
+        // Per-mirror FPS limits: deadlines on a shared grid so mirrors with related rates capture on the same frame
+        CaptureScheduler captureScheduler;
+        int64_t lastScheduleStatsPublishUs = 0;
+
+        // Color-match tables, refreshed when configs or the global gamma mode change
+        MT_ColorLutCache colorLutCache;
+        std::vector<GLuint> colorLutForConfig; // indexed by configsCache
+        MirrorGammaMode colorLutGammaMode = MirrorGammaMode::Auto;
+        bool colorLutsDirty = true;
+
+        // Mirrors with identical filter inputs share one filter pass per frame (see MT_SameFilterInputs)
+        std::vector<size_t> filterGroupForConfig; // indexed by configsCache, value = group leader config index
+        struct FilterGroupOutput {
+            MirrorInstance* inst = nullptr; // Mirror whose filter FBO holds this frame's output (null = not rendered yet)
+            GLuint texture = 0;
+            bool rawOutput = false;
+        };
+        std::vector<FilterGroupOutput> filterGroupOutputs; // indexed by group leader config index
+
+        // Scratch target for the horizontal dynamic-border pass (shared by all mirrors)
+        MT_BorderDilateTarget borderDilate;
 
         // Debug: sample pixels from the shared copy texture (only when Texture Ops logging is enabled)
         GLuint debugSampleFbo = 0;
-        auto debugSamplePixel = [&](const ThreadedMirrorConfig& conf, GLuint srcTex, int gameW, int gameH) {
+        auto debugSamplePixel = [&](const ThreadedMirrorConfig& conf, GLuint srcTex, const MirrorCapturePlan* capturePlan, int gameW, int gameH) {
             auto snap = GetConfigSnapshot();
             if (!snap || !snap->debug.logTextureOps) return;
             if (srcTex == 0 || gameW <= 0 || gameH <= 0) return;
@@ -1404,15 +1866,14 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
             // Sample center of the first input region.
             const auto& r = conf.input[0];
-            int capX = 0, capY = 0;
-            GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
-            int capY_gl = gameH - capY - conf.captureHeight;
-            int sampleX = capX + conf.captureWidth / 2;
-            int sampleY = capY_gl + conf.captureHeight / 2;
+            int srcX = 0, srcY_gl = 0, texW = 0, texH = 0;
+            if (!MT_ResolveCopySourceRect(capturePlan, conf, r, gameW, gameH, srcX, srcY_gl, texW, texH)) return;
+            int sampleX = srcX + conf.captureWidth / 2;
+            int sampleY = srcY_gl + conf.captureHeight / 2;
             if (sampleX < 0) sampleX = 0;
             if (sampleY < 0) sampleY = 0;
-            if (sampleX >= gameW) sampleX = gameW - 1;
-            if (sampleY >= gameH) sampleY = gameH - 1;
+            if (sampleX >= texW) sampleX = texW - 1;
+            if (sampleY >= texH) sampleY = texH - 1;
 
             GLint prevReadFbo = 0;
             glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
@@ -1420,7 +1881,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, srcTex, 0);
             GLenum st = glCheckFramebufferStatus(GL_READ_FRAMEBUFFER);
             if (st != GL_FRAMEBUFFER_COMPLETE) {
-                LogCategory("texture_ops",
+                LogCategory(LogCat::TextureOps,
                             "MirrorDebugSample: READ FBO incomplete for mirror '" + conf.name + "' (status " + std::to_string(st) +
                                 ") tex=" + std::to_string(srcTex));
                 glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo);
@@ -1440,7 +1901,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
             }
 
             MirrorGammaMode gm = GetGlobalMirrorGammaMode();
-            LogCategory("texture_ops",
+            LogCategory(LogCat::TextureOps,
                         "MirrorDebugSample: '" + conf.name + "' sample(" + std::to_string(sampleX) + "," + std::to_string(sampleY) +
                             ") rgba=" + std::to_string((int)px[0]) + "," + std::to_string((int)px[1]) + "," +
                             std::to_string((int)px[2]) + "," + std::to_string((int)px[3]) +
@@ -1451,25 +1912,27 @@ static void MirrorCaptureThreadFunc(void* unused) {
         while (!g_mirrorCaptureShouldStop.load()) {
             PROFILE_SCOPE_CAT("Mirror Capture Thread Frame", "Mirror Thread");
 
-            auto now = std::chrono::steady_clock::now();
-
             // === PHASE 1: Check for new frame captures from render thread ===
             FrameCaptureNotification notif = {};
             bool hasNotification = false;
             {
                 PROFILE_SCOPE_CAT("Check Queue", "Mirror Thread");
                 // Lock-free pop from ring buffer
-                hasNotification = CaptureQueuePop(notif);
+                hasNotification = g_captureQueue.TryPop(notif);
 
                 // If the producer is faster than this thread, keep only the newest frame.
                 // This reduces fence waits + mirror work when the game runs > mirror FPS.
+                int backlog = hasNotification ? 1 : 0;
                 if (hasNotification) {
                     FrameCaptureNotification newer = {};
-                    while (CaptureQueuePop(newer)) {
+                    while (g_captureQueue.TryPop(newer)) {
                         if (notif.fence && glIsSync(notif.fence)) { glDeleteSync(notif.fence); }
                         notif = newer;
+                        backlog++;
                     }
+                    if (backlog > 1) { MetricAdd(g_metricCaptureNotificationsCoalesced, backlog - 1); }
                 }
+                MetricSet(g_metricCaptureQueueBacklog, backlog);
             }
 
             if (!hasNotification) {
@@ -1477,11 +1940,12 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 // If we have no valid texture and/or no active configs, we can wait longer.
                 const bool hasConfigs = (g_activeMirrorCaptureCount.load(std::memory_order_acquire) > 0);
                 const auto waitTime = (!hasValidTexture && !hasConfigs) ? std::chrono::milliseconds(100) : std::chrono::milliseconds(16);
+                PROFILE_SCOPE_CAT("Wait for Capture Notification", "Wait");
                 std::unique_lock<std::mutex> lk(g_captureSignalMutex);
                 g_captureSignalCV.wait_for(lk, waitTime, [] {
                     if (g_mirrorCaptureShouldStop.load()) return true;
                     // Wake when there is at least one queued capture notification.
-                    return g_captureQueueTail.load(std::memory_order_relaxed) != g_captureQueueHead.load(std::memory_order_acquire);
+                    return !g_captureQueue.EmptyApprox();
                 });
                 continue;
             }
@@ -1492,7 +1956,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 // Wait for the async blit to complete (fence created by SubmitFrameCapture)
                 GLenum waitResult;
                 {
-                    PROFILE_SCOPE_CAT("Waiting for GPU Blit", "Mirror Thread");
+                    PROFILE_SCOPE_CAT("Waiting for GPU Blit", "Wait");
                     if (!notif.fence || !glIsSync(notif.fence)) {
                         // Invalid fence (can happen across context recreation). Skip this notification.
                         waitResult = GL_WAIT_FAILED;
@@ -1523,6 +1987,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
                         validTexture = g_copyTextures[readIndex];
                         validW = notif.width;
                         validH = notif.height;
+                        validPlan = std::atomic_load_explicit(&g_copyTexturePlans[readIndex], std::memory_order_acquire);
                         hasValidTexture = true;
 
                         // Low-frequency diagnostics: confirm the chosen texture is actually visible here.
@@ -1534,7 +1999,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
                             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &tw);
                             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &th);
                             glBindTexture(GL_TEXTURE_2D, 0);
-                            LogCategory("texture_ops",
+                            LogCategory(LogCat::TextureOps,
                                         "Mirror Capture Thread: Using copy texture idx=" + std::to_string(readIndex) +
                                             " id=" + std::to_string(validTexture) + " glIsTexture=" + std::to_string((int)isTex) +
                                             " size=" + std::to_string(tw) + "x" + std::to_string(th));
@@ -1543,9 +2008,12 @@ static void MirrorCaptureThreadFunc(void* unused) {
                         // === CRITICAL: Publish ready frame for OBS ===
                         // This must happen HERE, immediately after fence signals,
                         // NOT after mirror processing. This ensures OBS works even without mirrors.
-                        g_readyFrameIndex.store(readIndex, std::memory_order_release);
-                        g_readyFrameWidth.store(notif.width, std::memory_order_release);
-                        g_readyFrameHeight.store(notif.height, std::memory_order_release);
+                        // Mirror atlases are not game frames and are never published.
+                        if (!validPlan) {
+                            g_readyFrameIndex.store(readIndex, std::memory_order_release);
+                            g_readyFrameWidth.store(notif.width, std::memory_order_release);
+                            g_readyFrameHeight.store(notif.height, std::memory_order_release);
+                        }
                     }
                 }
             }
@@ -1570,7 +2038,11 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
                     configsCache = std::move(newCache);
                     cachedConfigVersion = v;
-                    lastCaptureTimes.assign(configsCache.size(), std::chrono::steady_clock::time_point{});
+                    std::vector<std::pair<std::string, int>> rates;
+                    rates.reserve(configsCache.size());
+                    for (const auto& c : configsCache) { rates.emplace_back(c.name, c.fps); }
+                    captureScheduler.SetRates(rates);
+                    colorLutsDirty = true;
 
                     // Keep mt_fbos from ballooning when mirrors are removed.
                     // (We don't erase aggressively each frame; just prune on config changes.)
@@ -1592,30 +2064,57 @@ static void MirrorCaptureThreadFunc(void* unused) {
                                 }
                                 if (it->second.contentDownsampleFbo) { glDeleteFramebuffers(1, &it->second.contentDownsampleFbo); }
                                 if (it->second.contentDownsampleTex) { glDeleteTextures(1, &it->second.contentDownsampleTex); }
+                                if (it->second.contentSourceFbo) { glDeleteFramebuffers(1, &it->second.contentSourceFbo); }
+                                if (it->second.contentSourceTex) { glDeleteTextures(1, &it->second.contentSourceTex); }
                                 it = mt_fbos.erase(it);
                                 continue;
                             }
                             ++it;
                         }
                     }
+
+                    // Drop published statistics of mirrors that left the mode or turned statistics off
+                    std::vector<std::string> statsMirrors;
+                    for (const auto& c : configsCache) {
+                        if (c.contentStats) statsMirrors.push_back(c.name);
+                    }
+                    PruneMirrorContentStats(statsMirrors);
                 }
             }
 
             if (configsCache.empty()) { continue; }
 
-            // Global colorspace mode for matching (applies to all mirrors)
+            // Global colorspace mode for matching (applies to all mirrors) - baked into the color-match tables
             MirrorGammaMode gammaMode = GetGlobalMirrorGammaMode();
+            if (MT_UploadFinishedColorLut(colorLutCache)) { colorLutsDirty = true; }
+            if (colorLutsDirty || gammaMode != colorLutGammaMode) {
+                MT_RefreshColorLuts(configsCache, gammaMode, colorLutCache, colorLutForConfig);
+                MT_BuildFilterGroups(configsCache, colorLutForConfig, filterGroupForConfig);
+                colorLutGammaMode = gammaMode;
+                colorLutsDirty = false;
+            }
 
             // Process each mirror using the copied texture
             std::vector<MirrorInstance*> readyToPublish;
             readyToPublish.reserve(configsCache.size());
-            for (size_t confIndex = 0; confIndex < configsCache.size(); confIndex++) {
+            captureScheduler.CollectDue(); // Once per game frame: everything due now is captured in this batch
+            filterGroupOutputs.assign(configsCache.size(), FilterGroupOutput{});
+            int filterPassesRun = 0;
+            int filterPassesShared = 0;
+            // Scheduler indices are configsCache indices (SetRates above). Mirrors stay due until actually captured.
+            for (size_t confIndex : captureScheduler.DueIndices()) {
                 auto& conf = configsCache[confIndex];
                 PROFILE_SCOPE_CAT("Process Mirror", "Mirror Thread");
-                // Check FPS throttling for this mirror
-                if (conf.fps > 0) {
-                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastCaptureTimes[confIndex]).count();
-                    if (elapsed < (1000 / conf.fps)) { continue; }
+
+                // Atlas compiled from older configs (or another game size) may not hold this mirror's
+                // regions yet; keep the previous output until the next plan covers it.
+                if (validPlan) {
+                    bool covered = (validPlan->gameW == gameW && validPlan->gameH == gameH);
+                    for (size_t i = 0; covered && i < conf.input.size(); i++) {
+                        int sx, sy, tw, th;
+                        covered = MT_ResolveCopySourceRect(validPlan.get(), conf, conf.input[i], gameW, gameH, sx, sy, tw, th);
+                    }
+                    if (!covered) { continue; }
                 }
 
                 // Get mirror instance (unique lock - capture thread writes to instance)
@@ -1743,22 +2242,26 @@ static void MirrorCaptureThreadFunc(void* unused) {
                                 glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
                                     fb.contentPBOWidth * fb.contentPBOHeight * 4, GL_MAP_READ_BIT));
                             if (mapped) {
-                                bool hasContent = false;
                                 const int w = fb.contentPBOWidth;
                                 const int h = fb.contentPBOHeight;
-                                // Sample rather than scanning every pixel (further reduces CPU cost).
-                                const int step = 4;
-                                for (int y = 0; y < h && !hasContent; y += step) {
-                                    const unsigned char* row = mapped + (static_cast<size_t>(y) * w * 4);
-                                    for (int x = 0; x < w; x += step) {
-                                        if (row[(static_cast<size_t>(x) * 4) + 3] > 0) {
-                                            hasContent = true;
-                                            break;
-                                        }
-                                    }
+                                bool hasContent = false;
+                                if (fb.contentReadbackIsFullRes) {
+                                    // Exact statistics over every pixel of the filter output
+                                    PROFILE_SCOPE_CAT("Mirror Content Stats", "Mirror Thread");
+                                    fb.contentAttribution.SetKey(
+                                        MakeMirrorColorMatchKey(conf.targetColors, conf.colorSensitivity, colorLutGammaMode));
+                                    ComputeMirrorContentStats(mapped, w, h, fb.contentReadbackPadding,
+                                                              fb.contentReadbackHasSourceColors ? &fb.contentAttribution : nullptr,
+                                                              fb.contentStats);
+                                    // The source-color pass writes alpha 1; the real filter output carries the output color's alpha
+                                    hasContent = fb.contentStats.hasContent && (conf.colorPassthrough || conf.outputColor.a * 255.0f >= 0.5f);
+                                } else {
+                                    // Content detection only: SIMD scan of every pixel, exits at the first hit
+                                    hasContent = MirrorScanHasContent(mapped, static_cast<size_t>(w) * h);
                                 }
                                 glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
                                 inst->hasFrameContentBack = hasContent;
+                                if (fb.contentReadbackIsFullRes && conf.contentStats) { PublishMirrorContentStats(conf.name, fb.contentStats); }
                             }
                             // If glMapBufferRange returned null, the buffer is not mapped -
                             // do NOT call glUnmapBuffer (it would generate GL_INVALID_OPERATION).
@@ -1771,25 +2274,45 @@ static void MirrorCaptureThreadFunc(void* unused) {
                     }
                 }
 
+                // Reuse the filter output of an earlier mirror this frame when the filter inputs are identical.
+                // Content statistics need this mirror's own full-resolution readback, so those always filter themselves.
+                const bool rawOutputNow = inst->desiredRawOutput.load(std::memory_order_acquire);
+                FilterGroupOutput& filterGroup = filterGroupOutputs[filterGroupForConfig[confIndex]];
+                GLuint sharedFilterTexture = 0;
+                if (filterGroup.inst && filterGroup.inst != inst && filterGroup.rawOutput == rawOutputNow && !conf.contentStats) {
+                    sharedFilterTexture = filterGroup.texture;
+                }
+
                 // Render the mirror
-                debugSamplePixel(conf, validTexture, gameW, gameH);
+                if (sharedFilterTexture == 0) { debugSamplePixel(conf, validTexture, validPlan.get(), gameW, gameH); }
+
+                RenderMirrorToBackBuffer(inst, conf, validTexture, captureVAO, captureVBO, localBackFbo, localFinalBackFbo,
+                                         colorLutForConfig[confIndex], borderDilate, validPlan.get(), gameW, gameH, sharedFilterTexture);
 
-                RenderMirrorToBackBuffer(inst, conf, validTexture, captureVAO, captureVBO, localBackFbo, localFinalBackFbo, gammaMode, gameW,
-                                         gameH);
+                if (sharedFilterTexture != 0) {
+                    // Same filter output, so the same content-detection result (no readback of our own)
+                    inst->hasFrameContentBack = filterGroup.inst->hasFrameContentBack;
+                    filterPassesShared++;
+                } else {
+                    filterPassesRun++;
+                    if (!filterGroup.inst) { filterGroup = { inst, inst->fboTextureBack, rawOutputNow }; }
+                }
 
                 // === Start async PBO readback for content detection ===
-                // Only for non-raw mirrors: initiate an async glReadPixels into a PBO.
+                // Only for non-raw mirrors that ran their own filter pass: initiate an async glReadPixels into a PBO.
                 // The result will be harvested on the NEXT frame (non-blocking).
-                if (!inst->desiredRawOutput.load(std::memory_order_acquire)) {
+                if (sharedFilterTexture == 0 && !inst->desiredRawOutput.load(std::memory_order_acquire)) {
                     MT_MirrorFbos& fb = mt_fbos[conf.name];
                     int fboW = inst->fbo_w;
                     int fboH = inst->fbo_h;
 
                     // Downsample to reduce readback bandwidth drastically.
                     // 64x64 is enough to detect "any alpha > 0" in most cases.
+                    // Content statistics need every pixel, so those mirrors read back at full resolution.
                     constexpr int kDetectMax = 64;
-                    const int detW = (std::min)(fboW, kDetectMax);
-                    const int detH = (std::min)(fboH, kDetectMax);
+                    const bool fullRes = conf.contentStats;
+                    const int detW = fullRes ? fboW : (std::min)(fboW, kDetectMax);
+                    const int detH = fullRes ? fboH : (std::min)(fboH, kDetectMax);
 
                     if (detW <= 0 || detH <= 0) {
                         // Mirror is in a transient/invalid size state.
@@ -1797,7 +2320,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
                     } else {
 
                     // Create/resize downsample target (texture + FBO) if needed.
-                    if ((fb.contentDownsampleFbo == 0) || (fb.contentDownsampleTex == 0) || (fb.contentDownW != detW) || (fb.contentDownH != detH)) {
+                    if (!fullRes && ((fb.contentDownsampleFbo == 0) || (fb.contentDownsampleTex == 0) || (fb.contentDownW != detW) || (fb.contentDownH != detH))) {
                         if (fb.contentDownsampleFbo == 0) { glGenFramebuffers(1, &fb.contentDownsampleFbo); }
                         if (fb.contentDownsampleTex == 0) { glGenTextures(1, &fb.contentDownsampleTex); }
                         glBindTexture(GL_TEXTURE_2D, fb.contentDownsampleTex);
@@ -1831,12 +2354,32 @@ static void MirrorCaptureThreadFunc(void* unused) {
                         fb.contentReadbackFence = nullptr;
                     }
 
-                        // Blit the full-size alpha mask into the downsample target, then async read that.
-                        glBindFramebuffer(GL_READ_FRAMEBUFFER, localBackFbo);
-                        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fb.contentDownsampleFbo);
-                        glBlitFramebuffer(0, 0, fboW, fboH, 0, 0, detW, detH, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+                        fb.contentReadbackHasSourceColors = false;
+                        if (fullRes && conf.colorPassthrough) {
+                            // Read the filter FBO directly (statistics need exact pixels).
+                            glBindFramebuffer(GL_READ_FRAMEBUFFER, localBackFbo);
+                            fb.contentReadbackHasSourceColors = true;
+                        } else if (fullRes) {
+                            // Per-target counts need the source colors the flat output color replaced
+                            if (MT_EnsureContentSourceTarget(fb, fboW, fboH)) {
+                                RenderMirrorFilterPass(inst, conf, false, validTexture, captureVAO, captureVBO, fb.contentSourceFbo,
+                                                       colorLutForConfig[confIndex], validPlan.get(), gameW, gameH, true);
+                                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                                glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.contentSourceFbo);
+                                fb.contentReadbackHasSourceColors = true;
+                            } else {
+                                glBindFramebuffer(GL_READ_FRAMEBUFFER, localBackFbo); // Totals and bounds only
+                            }
+                        } else {
+                            // Blit the full-size alpha mask into the downsample target, then async read that.
+                            glBindFramebuffer(GL_READ_FRAMEBUFFER, localBackFbo);
+                            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fb.contentDownsampleFbo);
+                            glBlitFramebuffer(0, 0, fboW, fboH, 0, 0, detW, detH, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+                            glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.contentDownsampleFbo);
+                        }
+                        fb.contentReadbackIsFullRes = fullRes;
+                        fb.contentReadbackPadding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
 
-                        glBindFramebuffer(GL_READ_FRAMEBUFFER, fb.contentDownsampleFbo);
                         glBindBuffer(GL_PIXEL_PACK_BUFFER, fb.contentDetectionPBO);
                         glReadPixels(0, 0, detW, detH, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // Async into PBO
                         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
@@ -1876,7 +2419,12 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 // This avoids redundant flushes and prevents the render thread from observing
                 // a fence that hasn't been flushed to the driver yet.
                 readyToPublish.push_back(inst);
-                lastCaptureTimes[confIndex] = now;
+                captureScheduler.MarkCaptured(confIndex);
+            }
+
+            if (filterPassesRun + filterPassesShared > 0) {
+                g_mirrorFilterPassesRun.store(filterPassesRun, std::memory_order_relaxed);
+                g_mirrorFilterPassesShared.store(filterPassesShared, std::memory_order_relaxed);
             }
 
             // Note: OBS capture is done synchronously in CaptureToObsFBO (dllmain.cpp)
@@ -1891,10 +2439,19 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 }
             }
 
+            // Jitter against each mirror's target rate, for the profiler overlay
+            const int64_t scheduleNowUs = captureScheduler.Now();
+            if (scheduleNowUs - lastScheduleStatsPublishUs >= 1000000) {
+                PublishCaptureScheduleStats("Mirror", captureScheduler.GetAllStats());
+                lastScheduleStatsPublishUs = scheduleNowUs;
+            }
+
             // No unconditional sleep here: the condition-variable wait above handles idle periods.
             // Sleeping every frame adds latency and can cause the capture queue to overflow.
         }
 
+        PublishCaptureScheduleStats("Mirror", {});
+
         // Cleanup local GPU resources
         // Note: validTexture is a shared texture (g_copyTextures), don't delete it here
         if (captureVAO) glDeleteVertexArrays(1, &captureVAO);
@@ -1905,6 +2462,13 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
         if (debugSampleFbo) { glDeleteFramebuffers(1, &debugSampleFbo); }
 
+        colorLutCache.builder.Stop();
+        for (auto& lut : colorLutCache.luts) {
+            if (lut.texture) { glDeleteTextures(1, &lut.texture); }
+        }
+        colorLutCache.luts.clear();
+        MT_CleanupBorderDilateTarget(borderDilate);
+
         // Cleanup mirror-thread local FBOs and PBOs
         for (auto& kv : mt_fbos) {
             if (kv.second.backFbo) { glDeleteFramebuffers(1, &kv.second.backFbo); }
@@ -1913,6 +2477,8 @@ static void MirrorCaptureThreadFunc(void* unused) {
             if (kv.second.contentReadbackFence && glIsSync(kv.second.contentReadbackFence)) { glDeleteSync(kv.second.contentReadbackFence); }
             if (kv.second.contentDownsampleFbo) { glDeleteFramebuffers(1, &kv.second.contentDownsampleFbo); }
             if (kv.second.contentDownsampleTex) { glDeleteTextures(1, &kv.second.contentDownsampleTex); }
+            if (kv.second.contentSourceFbo) { glDeleteFramebuffers(1, &kv.second.contentSourceFbo); }
+            if (kv.second.contentSourceTex) { glDeleteTextures(1, &kv.second.contentSourceTex); }
         }
         mt_fbos.clear();
 
@@ -2074,7 +2640,7 @@ void StartMirrorCaptureThread(void* gameGLContext) {
     g_mirrorCaptureShouldStop.store(false);
     g_mirrorCaptureRunning.store(true); // Mark as running BEFORE starting thread
     g_mirrorCaptureThread = std::thread(MirrorCaptureThreadFunc, gameGLContext);
-    LogCategory("init", "Mirror Capture Thread: Started");
+    LogCategory(LogCat::Init, "Mirror Capture Thread: Started");
 }
 
 // Stop the mirror capture thread
@@ -2147,46 +2713,48 @@ void SwapMirrorBuffers() {
     }
 }
 
+static ThreadedMirrorConfig MakeThreadedMirrorConfig(const MirrorConfig& m) {
+    ThreadedMirrorConfig conf;
+    conf.name = m.name;
+    conf.captureWidth = m.captureWidth;
+    conf.captureHeight = m.captureHeight;
+    // Border configuration
+    conf.borderType = m.border.type;
+    conf.dynamicBorderThickness = m.border.dynamicThickness;
+    conf.staticBorderShape = m.border.staticShape;
+    conf.staticBorderColor = m.border.staticColor;
+    conf.staticBorderThickness = m.border.staticThickness;
+    conf.staticBorderRadius = m.border.staticRadius;
+    conf.staticBorderOffsetX = m.border.staticOffsetX;
+    conf.staticBorderOffsetY = m.border.staticOffsetY;
+    conf.staticBorderWidth = m.border.staticWidth;
+    conf.staticBorderHeight = m.border.staticHeight;
+    conf.fps = m.fps;
+    conf.rawOutput = m.rawOutput;
+    conf.colorPassthrough = m.colorPassthrough;
+    conf.contentStats = m.contentStats;
+    conf.targetColors = m.colors.targetColors; // Copy vector of target colors
+    conf.outputColor = m.colors.output;
+    conf.borderColor = m.colors.border;
+    conf.colorSensitivity = m.colorSensitivity;
+    conf.input = m.input;
+    // Output positioning config for render cache computation
+    conf.outputScale = m.output.scale;
+    conf.outputSeparateScale = m.output.separateScale;
+    conf.outputScaleX = m.output.scaleX;
+    conf.outputScaleY = m.output.scaleY;
+    conf.outputX = m.output.x;
+    conf.outputY = m.output.y;
+    conf.outputRelativeTo = m.output.relativeTo;
+    return conf;
+}
+
 // Update capture configs from main thread (call when active mirrors change)
 void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors) {
     std::vector<ThreadedMirrorConfig> configs;
     configs.reserve(activeMirrors.size());
 
-    for (const auto& m : activeMirrors) {
-        ThreadedMirrorConfig conf;
-        conf.name = m.name;
-        conf.captureWidth = m.captureWidth;
-        conf.captureHeight = m.captureHeight;
-        // Border configuration
-        conf.borderType = m.border.type;
-        conf.dynamicBorderThickness = m.border.dynamicThickness;
-        conf.staticBorderShape = m.border.staticShape;
-        conf.staticBorderColor = m.border.staticColor;
-        conf.staticBorderThickness = m.border.staticThickness;
-        conf.staticBorderRadius = m.border.staticRadius;
-        conf.staticBorderOffsetX = m.border.staticOffsetX;
-        conf.staticBorderOffsetY = m.border.staticOffsetY;
-        conf.staticBorderWidth = m.border.staticWidth;
-        conf.staticBorderHeight = m.border.staticHeight;
-        conf.fps = m.fps;
-        conf.rawOutput = m.rawOutput;
-        conf.colorPassthrough = m.colorPassthrough;
-        conf.targetColors = m.colors.targetColors; // Copy vector of target colors
-        conf.outputColor = m.colors.output;
-        conf.borderColor = m.colors.border;
-        conf.colorSensitivity = m.colorSensitivity;
-        conf.input = m.input;
-        // Output positioning config for render cache computation
-        conf.outputScale = m.output.scale;
-        conf.outputSeparateScale = m.output.separateScale;
-        conf.outputScaleX = m.output.scaleX;
-        conf.outputScaleY = m.output.scaleY;
-        conf.outputX = m.output.x;
-        conf.outputY = m.output.y;
-        conf.outputRelativeTo = m.output.relativeTo;
-
-        configs.push_back(conf);
-    }
+    for (const auto& m : activeMirrors) { configs.push_back(MakeThreadedMirrorConfig(m)); }
 
     // Compute summaries from the local vector (avoid reading g_threadedMirrorConfigs without its mutex).
     const int mirrorCount = static_cast<int>(configs.size());
@@ -2231,6 +2799,45 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
     g_captureSignalCV.notify_one();
 }
 
+// Targeted update for one active mirror whose config changed (see ConfigChangeSet). Only that mirror's capture
+// state is reset; the other mirrors keep capturing undisturbed.
+void UpdateMirrorCaptureConfig(const MirrorConfig& mirror) {
+    ThreadedMirrorConfig conf = MakeThreadedMirrorConfig(mirror);
+
+    {
+        std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
+        auto it = std::find_if(g_threadedMirrorConfigs.begin(), g_threadedMirrorConfigs.end(),
+                               [&](const ThreadedMirrorConfig& c) { return c.name == mirror.name; });
+        if (it == g_threadedMirrorConfigs.end()) return; // Not active: picked up by the next full update
+        *it = std::move(conf);
+        g_threadedMirrorConfigsVersion.fetch_add(1, std::memory_order_release);
+
+        // Recompute max FPS summary.
+        int maxFps = 0;
+        bool unlimited = false;
+        for (const auto& c : g_threadedMirrorConfigs) {
+            if (c.fps <= 0) {
+                unlimited = true;
+                break;
+            }
+            maxFps = (std::max)(maxFps, c.fps);
+        }
+        g_activeMirrorCaptureMaxFps.store(unlimited ? 0 : maxFps, std::memory_order_release);
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+        auto it = g_mirrorInstances.find(mirror.name);
+        if (it != g_mirrorInstances.end()) {
+            it->second.captureReady.store(false, std::memory_order_release);
+            it->second.cachedRenderState.isValid = false;
+            it->second.cachedRenderStateBack.isValid = false;
+        }
+    }
+
+    g_captureSignalCV.notify_one();
+}
+
 void UpdateMirrorFPS(const std::string& mirrorName, int fps) {
     std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
     for (auto& conf : g_threadedMirrorConfigs) {
@@ -2257,6 +2864,19 @@ void UpdateMirrorFPS(const std::string& mirrorName, int fps) {
     g_captureSignalCV.notify_one();
 }
 
+void UpdateMirrorContentStats(const std::string& mirrorName, bool enabled) {
+    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
+    for (auto& conf : g_threadedMirrorConfigs) {
+        if (conf.name == mirrorName) {
+            conf.contentStats = enabled;
+            break;
+        }
+    }
+
+    g_threadedMirrorConfigsVersion.fetch_add(1, std::memory_order_release);
+    g_captureSignalCV.notify_one();
+}
+
 void UpdateMirrorOutputPosition(const std::string& mirrorName, int x, int y, float scale, bool separateScale, float scaleX, float scaleY,
                                 const std::string& relativeTo) {
     // Update the threaded config
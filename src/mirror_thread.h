@@ -11,8 +11,9 @@
 #include <string>
 #include <vector>
 
-// Need gui.h for Color and MirrorCaptureConfig used as value types in ThreadedMirrorConfig
 #include "gui.h"
+#include "ring_buffer.h"
+#include "threaded_mirror_config.h"
 
 // Forward declarations
 struct MirrorInstance;
@@ -37,44 +38,6 @@ extern std::atomic<int> g_activeMirrorCaptureCount;
 // Updated by UpdateMirrorCaptureConfigs() and UpdateMirrorFPS(); read by SwapBuffers hook.
 extern std::atomic<int> g_activeMirrorCaptureMaxFps;
 
-// Named ThreadedMirrorConfig to avoid conflict with MirrorCaptureConfig in gui.h
-struct ThreadedMirrorConfig {
-    std::string name;
-    int captureWidth = 0;
-    int captureHeight = 0;
-
-    // Border configuration
-    MirrorBorderType borderType = MirrorBorderType::Dynamic;
-    int dynamicBorderThickness = 0; // For dynamic border (shader-based)
-    // Static border settings (rendered if staticBorderThickness > 0)
-    MirrorBorderShape staticBorderShape = MirrorBorderShape::Rectangle;
-    Color staticBorderColor = { 1.0f, 1.0f, 1.0f };
-    int staticBorderThickness = 2;
-    int staticBorderRadius = 0;
-    int staticBorderOffsetX = 0;
-    int staticBorderOffsetY = 0;
-    int staticBorderWidth = 0;  // 0 = use mirror width
-    int staticBorderHeight = 0; // 0 = use mirror height
-
-    int fps = 0;
-    bool rawOutput = false;
-    bool colorPassthrough = false;   // If true, output original pixel color instead of Output Color when matching
-    std::vector<Color> targetColors; // Multiple target colors - any matching pixel is shown
-    Color outputColor;
-    Color borderColor; // Border color for dynamic render shader
-    float colorSensitivity = 0.0f;
-    std::vector<MirrorCaptureConfig> input; // Uses MirrorCaptureConfig from gui.h
-    std::chrono::steady_clock::time_point lastCaptureTime;
-
-    // Output positioning config (for pre-computing render cache)
-    float outputScale = 1.0f;
-    bool outputSeparateScale = false; // When true, use outputScaleX/Y instead of outputScale
-    float outputScaleX = 1.0f;        // X-axis scale
-    float outputScaleY = 1.0f;        // Y-axis scale
-    int outputX = 0, outputY = 0;
-    std::string outputRelativeTo;
-};
-
 // External access to threaded mirror configs (protected by mutex)
 extern std::vector<ThreadedMirrorConfig> g_threadedMirrorConfigs;
 extern std::mutex g_threadedMirrorConfigMutex;
@@ -102,40 +65,12 @@ struct FrameCaptureNotification {
     int textureIndex; // Which copy texture (0 or 1) this notification refers to - fixes race condition
 };
 
-// Lock-free SPSC (Single Producer Single Consumer) ring buffer for capture notifications
-// This allows the render thread to push without any locking
-constexpr int CAPTURE_QUEUE_SIZE = 2; // Only need 1 pending frame (size must be power of 2)
-extern FrameCaptureNotification g_captureQueue[CAPTURE_QUEUE_SIZE];
-extern std::atomic<int> g_captureQueueHead; // Write index (render thread only)
-extern std::atomic<int> g_captureQueueTail; // Read index (capture thread only)
-
-// Lock-free queue operations (inline for performance)
-inline bool CaptureQueuePush(const FrameCaptureNotification& notif) {
-    int head = g_captureQueueHead.load(std::memory_order_relaxed);
-    int nextHead = (head + 1) % CAPTURE_QUEUE_SIZE;
-
-    // Check if queue is full (would overwrite unread data)
-    if (nextHead == g_captureQueueTail.load(std::memory_order_acquire)) {
-        return false; // Queue full, drop notification
-    }
-
-    g_captureQueue[head] = notif;
-    g_captureQueueHead.store(nextHead, std::memory_order_release);
-    return true;
-}
-
-inline bool CaptureQueuePop(FrameCaptureNotification& notif) {
-    int tail = g_captureQueueTail.load(std::memory_order_relaxed);
-
-    // Check if queue is empty
-    if (tail == g_captureQueueHead.load(std::memory_order_acquire)) {
-        return false; // Queue empty
-    }
-
-    notif = g_captureQueue[tail];
-    g_captureQueueTail.store((tail + 1) % CAPTURE_QUEUE_SIZE, std::memory_order_release);
-    return true;
-}
+// Lock-free SPSC ring buffer for capture notifications (render thread -> mirror thread)
+// When the mirror thread falls behind, the oldest pending frame is evicted: the newest frame is the one it wants.
+// Evicted notifications are handed back to the producer so their fences can be deleted.
+constexpr int CAPTURE_QUEUE_SIZE = 2; // Size must be a power of 2
+using CaptureQueue = SpscRing<FrameCaptureNotification, CAPTURE_QUEUE_SIZE, RingFullPolicy::OverwriteOldest>;
+extern CaptureQueue g_captureQueue;
 
 // Start the mirror capture thread (call from main thread after GPU init)
 // MUST be called from main thread where game context is current
@@ -151,9 +86,15 @@ void SwapMirrorBuffers();
 // Update capture configs from main thread (call when active mirrors change)
 void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors);
 
+// Replace one active mirror's capture config (call when a config diff reports it modified)
+void UpdateMirrorCaptureConfig(const MirrorConfig& mirror);
+
 // Update FPS for a specific mirror (call from GUI when FPS spinner changes)
 void UpdateMirrorFPS(const std::string& mirrorName, int fps);
 
+// Enable/disable content statistics for a specific mirror (call from GUI when the checkbox changes)
+void UpdateMirrorContentStats(const std::string& mirrorName, bool enabled);
+
 // Update output position for a specific mirror (call from GUI when position changes)
 void UpdateMirrorOutputPosition(const std::string& mirrorName, int x, int y, float scale, bool separateScale, float scaleX, float scaleY,
                                 const std::string& relativeTo);
@@ -178,7 +119,9 @@ void CleanupCaptureTexture();
 
 // Start async GPU blit to copy game texture (called from SwapBuffers, non-blocking)
 // The GPU executes the blit in background. Consumers call GetGameCopyTexture/Fence to access.
-void SubmitFrameCapture(GLuint gameTexture, int width, int height);
+// mirrorsOnly: only mirrors consume this frame - copy just their input regions into a packed atlas
+// (see mirror_capture_plan.h). Full-frame accessors report no frame for atlas copies.
+void SubmitFrameCapture(GLuint gameTexture, int width, int height, bool mirrorsOnly);
 
 // These provide access to the copied game texture for render_thread/OBS to use
 // The copy is made by mirror thread (deferred from SwapBuffers)
@@ -199,6 +142,10 @@ int GetFallbackGameWidth();      // Width of fallback frame
 int GetFallbackGameHeight();     // Height of fallback frame
 GLsync GetFallbackCopyFence();   // Fence to wait on before using fallback texture
 
+// Filter passes the mirror thread ran vs. shared in its last processed frame.
+// Mirrors with identical inputs, capture size, colors, sensitivity, gamma and output mode share one filter pass.
+void GetMirrorFilterPassCounts(int& outRun, int& outShared);
+
 // Returns the texture NOT currently being written to - always safe to read (may be 1 frame old)
 // No fence wait needed - this is a simple and reliable fallback
 GLuint GetSafeReadTexture();
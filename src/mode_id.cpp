@@ -0,0 +1,130 @@
+// ============================================================================
+// MODE_ID.CPP - Interned mode identifiers
+// ============================================================================
+
+#include "mode_id.h"
+
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct ModeIdEntry {
+    std::string name;
+    ModeHandle folded = NO_MODE_HANDLE;
+};
+
+// Entries live in fixed-size chunks that are never moved or freed, so readers can index them
+// without a lock while the table grows.
+constexpr uint32_t MODE_ID_CHUNK_SHIFT = 8;
+constexpr uint32_t MODE_ID_CHUNK_SIZE = 1u << MODE_ID_CHUNK_SHIFT;
+constexpr uint32_t MODE_ID_MAX_CHUNKS = 256; // 65536 distinct spellings
+
+std::atomic<ModeIdEntry*> g_modeIdChunks[MODE_ID_MAX_CHUNKS];
+std::atomic<uint32_t> g_modeIdCount{ 0 }; // Published entries (release after the entry is written)
+
+std::mutex g_modeIdInternMutex;
+
+struct FoldedHash {
+    size_t operator()(const std::string& s) const {
+        size_t h = 1469598103934665603ull;
+        for (unsigned char c : s) {
+            h ^= static_cast<size_t>(std::tolower(c));
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+};
+struct FoldedEqual {
+    bool operator()(const std::string& a, const std::string& b) const {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+        }
+        return true;
+    }
+};
+
+// Guarded by g_modeIdInternMutex
+std::unordered_map<std::string, ModeHandle> g_modeIdByName;
+std::unordered_map<std::string, ModeHandle, FoldedHash, FoldedEqual> g_modeIdByFoldedName;
+
+const std::string& EmptyModeIdName() {
+    static const std::string empty;
+    return empty;
+}
+
+const ModeIdEntry* GetEntry(ModeHandle handle) {
+    if (handle >= g_modeIdCount.load(std::memory_order_acquire)) return nullptr;
+    ModeIdEntry* chunk = g_modeIdChunks[handle >> MODE_ID_CHUNK_SHIFT].load(std::memory_order_acquire);
+    return chunk ? &chunk[handle & (MODE_ID_CHUNK_SIZE - 1)] : nullptr;
+}
+
+// Requires g_modeIdInternMutex
+ModeHandle AppendEntry(const std::string& id) {
+    const uint32_t handle = g_modeIdCount.load(std::memory_order_relaxed);
+    const uint32_t chunkIndex = handle >> MODE_ID_CHUNK_SHIFT;
+    if (chunkIndex >= MODE_ID_MAX_CHUNKS) return NO_MODE_HANDLE; // Table exhausted: treat as no mode
+
+    ModeIdEntry* chunk = g_modeIdChunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new ModeIdEntry[MODE_ID_CHUNK_SIZE]; // Intentionally never freed (readers may hold references)
+        g_modeIdChunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    ModeIdEntry& entry = chunk[handle & (MODE_ID_CHUNK_SIZE - 1)];
+    entry.name = id;
+    auto folded = g_modeIdByFoldedName.find(id);
+    entry.folded = (folded != g_modeIdByFoldedName.end()) ? folded->second : handle;
+    if (folded == g_modeIdByFoldedName.end()) { g_modeIdByFoldedName.emplace(id, handle); }
+    g_modeIdByName.emplace(id, handle);
+
+    g_modeIdCount.store(handle + 1, std::memory_order_release);
+    return handle;
+}
+
+} // namespace
+
+ModeHandle InternModeId(const std::string& id) {
+    std::lock_guard<std::mutex> lock(g_modeIdInternMutex);
+    if (g_modeIdCount.load(std::memory_order_relaxed) == 0) { AppendEntry(std::string()); } // Handle 0 is the empty ID
+
+    auto it = g_modeIdByName.find(id);
+    if (it != g_modeIdByName.end()) return it->second;
+    return AppendEntry(id);
+}
+
+ModeHandle FindModeHandle(const std::string& id) {
+    std::lock_guard<std::mutex> lock(g_modeIdInternMutex);
+    auto it = g_modeIdByName.find(id);
+    if (it != g_modeIdByName.end()) return it->second;
+    auto folded = g_modeIdByFoldedName.find(id);
+    return (folded != g_modeIdByFoldedName.end()) ? folded->second : NO_MODE_HANDLE;
+}
+
+const std::string& ModeIdName(ModeHandle handle) {
+    const ModeIdEntry* entry = GetEntry(handle);
+    return entry ? entry->name : EmptyModeIdName();
+}
+
+ModeHandle ModeIdFoldedHandle(ModeHandle handle) {
+    const ModeIdEntry* entry = GetEntry(handle);
+    return entry ? entry->folded : NO_MODE_HANDLE;
+}
+
+ModeHandle FullscreenModeHandle() {
+    static const ModeHandle handle = InternModeId("Fullscreen");
+    return handle;
+}
+
+ModeHandle EyeZoomModeHandle() {
+    static const ModeHandle handle = InternModeId("EyeZoom");
+    return handle;
+}
+
+ModeHandle PreemptiveModeHandle() {
+    static const ModeHandle handle = InternModeId("Preemptive");
+    return handle;
+}
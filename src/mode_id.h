@@ -0,0 +1,48 @@
+#pragma once
+
+// ============================================================================
+// MODE_ID.H - Interned mode identifiers
+// ============================================================================
+// Mode IDs are user-facing strings ("Fullscreen", "EyeZoom", custom names).
+// Hot paths (game thread, render/OBS requests, raw input, viewport hook) carry
+// a ModeHandle instead: a process-wide integer assigned the first time a
+// string is interned. Handles are never recycled, so a handle stays valid
+// (and keeps naming the same string) across config reloads and renames.
+//
+// Mode lookups are case-insensitive, so every handle also has a folded handle
+// shared by all spellings of the same ID. Published config snapshots index
+// modes by folded handle (see Config::modeIndexByHandle), which makes
+// GetModeFromSnapshot(config, handle) a bounds-checked array read.
+//
+// Interning takes a mutex and may allocate; it happens at config publish and
+// at the GUI/TOML boundary. Name and folded-handle reads are lock-free.
+// ============================================================================
+
+#include <cstdint>
+#include <string>
+
+using ModeHandle = uint32_t;
+
+// Handle of the empty ID (no mode)
+constexpr ModeHandle NO_MODE_HANDLE = 0;
+
+// Returns the handle for an exact ID string, interning it on first use.
+ModeHandle InternModeId(const std::string& id);
+
+// Returns the handle for an ID if it has ever been interned (exact spelling first, then any
+// spelling that folds to it), NO_MODE_HANDLE otherwise. Never allocates.
+ModeHandle FindModeHandle(const std::string& id);
+
+// Exact spelling the handle was interned with. The reference stays valid for the process lifetime.
+const std::string& ModeIdName(ModeHandle handle);
+
+// Handle shared by every spelling that is equal ignoring case
+ModeHandle ModeIdFoldedHandle(ModeHandle handle);
+
+// Case-insensitive ID equality (same semantics as EqualsIgnoreCase on the names)
+inline bool ModeHandlesEqual(ModeHandle a, ModeHandle b) { return a == b || ModeIdFoldedHandle(a) == ModeIdFoldedHandle(b); }
+
+// Built-in mode IDs, interned once
+ModeHandle FullscreenModeHandle();
+ModeHandle EyeZoomModeHandle();
+ModeHandle PreemptiveModeHandle();
@@ -0,0 +1,53 @@
+#pragma once
+
+// ============================================================================
+// MOUSE_SENSITIVITY.H - Per-packet raw mouse scaling for the GetRawInputData hook
+// ============================================================================
+// High-polling-rate mice deliver up to 8000 raw input packets per second on
+// the game's input thread. The resolved X/Y sensitivity is published as one
+// packed 64-bit word (PublishedMouseSensitivity) so the hook reads it with a
+// single acquire load; RawMouseAccumulator applies it without losing the
+// fractional counts that sub-1.0 sensitivities would otherwise truncate away.
+// ============================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+class PublishedMouseSensitivity {
+public:
+    void Publish(float x, float y) {
+        uint32_t bitsX, bitsY;
+        std::memcpy(&bitsX, &x, sizeof(bitsX));
+        std::memcpy(&bitsY, &y, sizeof(bitsY));
+        m_bits.store((static_cast<uint64_t>(bitsY) << 32) | bitsX, std::memory_order_release);
+    }
+
+    // Lock-free, allocation-free; safe from any thread
+    void Load(float& outX, float& outY) const {
+        const uint64_t bits = m_bits.load(std::memory_order_acquire);
+        const uint32_t bitsX = static_cast<uint32_t>(bits);
+        const uint32_t bitsY = static_cast<uint32_t>(bits >> 32);
+        std::memcpy(&outX, &bitsX, sizeof(outX));
+        std::memcpy(&outY, &bitsY, sizeof(outY));
+    }
+
+private:
+    static constexpr uint64_t kUnitBits = 0x3F8000003F800000ull; // { 1.0f, 1.0f }
+    std::atomic<uint64_t> m_bits{ kUnitBits };
+};
+
+// Scales relative movement in place, carrying the fractional remainder into the next packet
+struct RawMouseAccumulator {
+    float x = 0.0f;
+    float y = 0.0f;
+
+    template <typename Count> void Scale(Count& dx, Count& dy, float sensitivityX, float sensitivityY) {
+        x += dx * sensitivityX;
+        y += dy * sensitivityY;
+        dx = static_cast<Count>(x);
+        dy = static_cast<Count>(y);
+        x -= dx;
+        y -= dy;
+    }
+};
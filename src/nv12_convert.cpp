@@ -0,0 +1,363 @@
+// ============================================================================
+// NV12_CONVERT.CPP - RGBA -> NV12 kernels (scalar / SSE2 / AVX2) and band workers
+// ============================================================================
+// The SIMD kernels reproduce the scalar 8.8 fixed-point math exactly in 16-bit
+// lanes:
+//  - Y: 66R + 129G + 25B + 128 is at most 56228, so it fits an unsigned 16-bit
+//    lane (mullo wraps, the logical >> 8 is exact). Result is 16..235, no clamp.
+//  - U/V: -38R - 74G + 112B + 128 and 112R - 94G - 18B + 128 stay within
+//    +-28688, so they fit a signed 16-bit lane (arithmetic >> 8 as in C++).
+//    Results are 16..240, no clamp.
+//  - 2x2 sums (at most 1020) are formed with madd against ones.
+// ============================================================================
+
+#include "nv12_convert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <immintrin.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Frames below this many pixels are converted on the calling thread
+constexpr uint64_t kMinPixelsForBands = 1280ull * 720ull;
+constexpr uint32_t kMaxBandWorkers = 3;
+
+inline uint8_t ClampToByte(int32_t val) {
+    if (val < 0) return 0;
+    if (val > 255) return 255;
+    return static_cast<uint8_t>(val);
+}
+
+// ---------------------------------------------------------------------------
+// Row-pair kernels: output rows y and y + 1 (srcRow0 / srcRow1) and their UV row, pixels [x, width)
+// ---------------------------------------------------------------------------
+
+struct RowPair {
+    const uint8_t* srcRow0; // Source row of output row y (source is bottom-up)
+    const uint8_t* srcRow1; // Source row of output row y + 1
+    uint8_t* yRow0;
+    uint8_t* yRow1;
+    uint8_t* uvRow;
+};
+
+void ConvertRowPairScalar(const RowPair& rows, uint32_t x, uint32_t width) {
+    for (; x < width; x += 2) {
+        const uint8_t* p00 = rows.srcRow0 + x * 4;
+        const uint8_t* p10 = rows.srcRow0 + (x + 1) * 4;
+        const uint8_t* p01 = rows.srcRow1 + x * 4;
+        const uint8_t* p11 = rows.srcRow1 + (x + 1) * 4;
+
+        // Y = ((66*R + 129*G + 25*B + 128) >> 8) + 16
+        const int32_t y00 = ((66 * p00[0] + 129 * p00[1] + 25 * p00[2] + 128) >> 8) + 16;
+        const int32_t y10 = ((66 * p10[0] + 129 * p10[1] + 25 * p10[2] + 128) >> 8) + 16;
+        const int32_t y01 = ((66 * p01[0] + 129 * p01[1] + 25 * p01[2] + 128) >> 8) + 16;
+        const int32_t y11 = ((66 * p11[0] + 129 * p11[1] + 25 * p11[2] + 128) >> 8) + 16;
+
+        rows.yRow0[x] = ClampToByte(y00);
+        rows.yRow0[x + 1] = ClampToByte(y10);
+        rows.yRow1[x] = ClampToByte(y01);
+        rows.yRow1[x + 1] = ClampToByte(y11);
+
+        // Rounded average of the 2x2 block for chroma
+        const int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
+        const int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
+        const int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
+
+        // U = ((-38*R - 74*G + 112*B + 128) >> 8) + 128
+        // V = ((112*R - 94*G - 18*B + 128) >> 8) + 128
+        const int32_t u = ((-38 * avgR - 74 * avgG + 112 * avgB + 128) >> 8) + 128;
+        const int32_t v = ((112 * avgR - 94 * avgG - 18 * avgB + 128) >> 8) + 128;
+
+        rows.uvRow[x] = ClampToByte(u);
+        rows.uvRow[x + 1] = ClampToByte(v);
+    }
+}
+
+struct Channels128 {
+    __m128i r, g, b; // 8 pixels, 16-bit lanes
+};
+
+// Splits 2x4 RGBA pixels into 16-bit R, G, B lanes (pixel order kept)
+inline Channels128 SplitChannelsSSE2(__m128i lo, __m128i hi) {
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    Channels128 c;
+    c.r = _mm_packs_epi32(_mm_and_si128(lo, byteMask), _mm_and_si128(hi, byteMask));
+    c.g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 8), byteMask), _mm_and_si128(_mm_srli_epi32(hi, 8), byteMask));
+    c.b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 16), byteMask), _mm_and_si128(_mm_srli_epi32(hi, 16), byteMask));
+    return c;
+}
+
+inline __m128i LumaSSE2(const Channels128& c) {
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(c.r, _mm_set1_epi16(66)), _mm_mullo_epi16(c.g, _mm_set1_epi16(129)));
+    sum = _mm_add_epi16(_mm_add_epi16(sum, _mm_mullo_epi16(c.b, _mm_set1_epi16(25))), _mm_set1_epi16(128));
+    return _mm_add_epi16(_mm_srli_epi16(sum, 8), _mm_set1_epi16(16));
+}
+
+// Rounded 2x2 averages of 16 pixels (two 8-pixel halves of each row) -> 8 samples
+inline __m128i Average2x2SSE2(__m128i row0Lo, __m128i row0Hi, __m128i row1Lo, __m128i row1Hi) {
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i pairsLo = _mm_madd_epi16(_mm_add_epi16(row0Lo, row1Lo), ones);
+    const __m128i pairsHi = _mm_madd_epi16(_mm_add_epi16(row0Hi, row1Hi), ones);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(pairsLo, pairsHi), _mm_set1_epi16(2)), 2);
+}
+
+// Interleaved U, V bytes for 8 chroma samples
+inline __m128i ChromaSSE2(__m128i r, __m128i g, __m128i b) {
+    const __m128i round = _mm_set1_epi16(128);
+    __m128i u = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(-38)), _mm_mullo_epi16(g, _mm_set1_epi16(-74)));
+    u = _mm_add_epi16(_mm_add_epi16(u, _mm_mullo_epi16(b, _mm_set1_epi16(112))), round);
+    u = _mm_add_epi16(_mm_srai_epi16(u, 8), round);
+    __m128i v = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(112)), _mm_mullo_epi16(g, _mm_set1_epi16(-94)));
+    v = _mm_add_epi16(_mm_add_epi16(v, _mm_mullo_epi16(b, _mm_set1_epi16(-18))), round);
+    v = _mm_add_epi16(_mm_srai_epi16(v, 8), round);
+    return _mm_or_si128(u, _mm_slli_epi16(v, 8));
+}
+
+void ConvertRowPairSSE2(const RowPair& rows, uint32_t x, uint32_t width) {
+    for (; x + 16 <= width; x += 16) {
+        const __m128i* s0 = reinterpret_cast<const __m128i*>(rows.srcRow0 + x * 4);
+        const __m128i* s1 = reinterpret_cast<const __m128i*>(rows.srcRow1 + x * 4);
+        const Channels128 a0 = SplitChannelsSSE2(_mm_loadu_si128(s0), _mm_loadu_si128(s0 + 1));
+        const Channels128 b0 = SplitChannelsSSE2(_mm_loadu_si128(s0 + 2), _mm_loadu_si128(s0 + 3));
+        const Channels128 a1 = SplitChannelsSSE2(_mm_loadu_si128(s1), _mm_loadu_si128(s1 + 1));
+        const Channels128 b1 = SplitChannelsSSE2(_mm_loadu_si128(s1 + 2), _mm_loadu_si128(s1 + 3));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.yRow0 + x), _mm_packus_epi16(LumaSSE2(a0), LumaSSE2(b0)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.yRow1 + x), _mm_packus_epi16(LumaSSE2(a1), LumaSSE2(b1)));
+
+        const __m128i r = Average2x2SSE2(a0.r, b0.r, a1.r, b1.r);
+        const __m128i g = Average2x2SSE2(a0.g, b0.g, a1.g, b1.g);
+        const __m128i b = Average2x2SSE2(a0.b, b0.b, a1.b, b1.b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.uvRow + x), ChromaSSE2(r, g, b));
+    }
+    ConvertRowPairScalar(rows, x, width);
+}
+
+// AVX2 versions of the helpers above. packs works per 128-bit lane, so 16-bit data is kept in the order
+// [A0-3 B0-3 | A4-7 B4-7] for loads A and B and put back in pixel order with one dword permute before each store.
+struct Channels256 {
+    __m256i r, g, b;
+};
+
+CPU_TARGET_AVX2 inline Channels256 SplitChannelsAVX2(__m256i lo, __m256i hi) {
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    Channels256 c;
+    c.r = _mm256_packs_epi32(_mm256_and_si256(lo, byteMask), _mm256_and_si256(hi, byteMask));
+    c.g = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(lo, 8), byteMask), _mm256_and_si256(_mm256_srli_epi32(hi, 8), byteMask));
+    c.b = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(lo, 16), byteMask),
+                             _mm256_and_si256(_mm256_srli_epi32(hi, 16), byteMask));
+    return c;
+}
+
+CPU_TARGET_AVX2 inline __m256i LumaAVX2(const Channels256& c) {
+    __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(c.r, _mm256_set1_epi16(66)), _mm256_mullo_epi16(c.g, _mm256_set1_epi16(129)));
+    sum = _mm256_add_epi16(_mm256_add_epi16(sum, _mm256_mullo_epi16(c.b, _mm256_set1_epi16(25))), _mm256_set1_epi16(128));
+    return _mm256_add_epi16(_mm256_srli_epi16(sum, 8), _mm256_set1_epi16(16));
+}
+
+CPU_TARGET_AVX2 inline __m256i Average2x2AVX2(__m256i row0Lo, __m256i row0Hi, __m256i row1Lo, __m256i row1Hi) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i pairsLo = _mm256_madd_epi16(_mm256_add_epi16(row0Lo, row1Lo), ones);
+    const __m256i pairsHi = _mm256_madd_epi16(_mm256_add_epi16(row0Hi, row1Hi), ones);
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_packs_epi32(pairsLo, pairsHi), _mm256_set1_epi16(2)), 2);
+}
+
+CPU_TARGET_AVX2 inline __m256i ChromaAVX2(__m256i r, __m256i g, __m256i b) {
+    const __m256i round = _mm256_set1_epi16(128);
+    __m256i u = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(-38)), _mm256_mullo_epi16(g, _mm256_set1_epi16(-74)));
+    u = _mm256_add_epi16(_mm256_add_epi16(u, _mm256_mullo_epi16(b, _mm256_set1_epi16(112))), round);
+    u = _mm256_add_epi16(_mm256_srai_epi16(u, 8), round);
+    __m256i v = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(112)), _mm256_mullo_epi16(g, _mm256_set1_epi16(-94)));
+    v = _mm256_add_epi16(_mm256_add_epi16(v, _mm256_mullo_epi16(b, _mm256_set1_epi16(-18))), round);
+    v = _mm256_add_epi16(_mm256_srai_epi16(v, 8), round);
+    return _mm256_or_si256(u, _mm256_slli_epi16(v, 8));
+}
+
+CPU_TARGET_AVX2 void ConvertRowPairAVX2(const RowPair& rows, uint32_t x, uint32_t width) {
+    // Dwords come out as [A0-3 B0-3 C0-3 D0-3 | A4-7 B4-7 C4-7 D4-7] (Y) or the same order of UV pairs
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; x + 32 <= width; x += 32) {
+        const __m256i* s0 = reinterpret_cast<const __m256i*>(rows.srcRow0 + x * 4);
+        const __m256i* s1 = reinterpret_cast<const __m256i*>(rows.srcRow1 + x * 4);
+        const Channels256 a0 = SplitChannelsAVX2(_mm256_loadu_si256(s0), _mm256_loadu_si256(s0 + 1));
+        const Channels256 b0 = SplitChannelsAVX2(_mm256_loadu_si256(s0 + 2), _mm256_loadu_si256(s0 + 3));
+        const Channels256 a1 = SplitChannelsAVX2(_mm256_loadu_si256(s1), _mm256_loadu_si256(s1 + 1));
+        const Channels256 b1 = SplitChannelsAVX2(_mm256_loadu_si256(s1 + 2), _mm256_loadu_si256(s1 + 3));
+
+        const __m256i y0 = _mm256_packus_epi16(LumaAVX2(a0), LumaAVX2(b0));
+        const __m256i y1 = _mm256_packus_epi16(LumaAVX2(a1), LumaAVX2(b1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows.yRow0 + x), _mm256_permutevar8x32_epi32(y0, order));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows.yRow1 + x), _mm256_permutevar8x32_epi32(y1, order));
+
+        const __m256i r = Average2x2AVX2(a0.r, b0.r, a1.r, b1.r);
+        const __m256i g = Average2x2AVX2(a0.g, b0.g, a1.g, b1.g);
+        const __m256i b = Average2x2AVX2(a0.b, b0.b, a1.b, b1.b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rows.uvRow + x), _mm256_permutevar8x32_epi32(ChromaAVX2(r, g, b), order));
+    }
+    ConvertRowPairSSE2(rows, x, width);
+}
+
+using ConvertRowPairFn = void (*)(const RowPair&, uint32_t, uint32_t);
+
+ConvertRowPairFn SelectConvertRowPair(CpuSimdLevel level) {
+    switch (ResolveCpuSimdLevel(level)) {
+    case CpuSimdLevel::AVX2:
+        return ConvertRowPairAVX2;
+    case CpuSimdLevel::SSE41:
+    case CpuSimdLevel::SSE2:
+        return ConvertRowPairSSE2;
+    default:
+        return ConvertRowPairScalar;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Band workers
+// ---------------------------------------------------------------------------
+
+struct BandJob {
+    const uint8_t* rgba = nullptr;
+    uint8_t* nv12 = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bandRows = 0; // Even
+    uint32_t bandCount = 0;
+    CpuSimdLevel level = CpuSimdLevel::Scalar;
+};
+
+// Persistent threads that take bands of the current job alongside the caller. One job at a time.
+class BandWorkerPool {
+  public:
+    void Run(const BandJob& job, uint32_t workerCount) {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_threads.size() < workerCount) m_threads.emplace_back(&BandWorkerPool::WorkerMain, this, m_generation);
+            // A worker may still be leaving the previous job; its band counter must not be reset under it
+            m_idle.wait(lock, [&] { return m_active == 0; });
+            m_job = job;
+            m_nextBand.store(0, std::memory_order_relaxed);
+            m_bandsDone.store(0, std::memory_order_relaxed);
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        RunBands(job);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [&] { return m_bandsDone.load(std::memory_order_acquire) == job.bandCount; });
+    }
+
+    void Shutdown() {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& t : m_threads) t.join();
+        m_threads.clear();
+        m_stop = false;
+    }
+
+  private:
+    void WorkerMain(uint64_t seenGeneration) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+            if (m_stop) return;
+            seenGeneration = m_generation;
+            const BandJob job = m_job;
+            m_active++;
+            lock.unlock();
+            RunBands(job);
+            lock.lock();
+            if (--m_active == 0) m_idle.notify_all();
+        }
+    }
+
+    void RunBands(const BandJob& job) {
+        for (;;) {
+            const uint32_t band = m_nextBand.fetch_add(1, std::memory_order_relaxed);
+            if (band >= job.bandCount) return;
+            const uint32_t rowBegin = band * job.bandRows;
+            const uint32_t rowEnd = (std::min)(job.height, rowBegin + job.bandRows);
+            ConvertRGBAtoNV12Rows(job.rgba, job.nv12, job.width, job.height, rowBegin, rowEnd, job.level);
+            if (m_bandsDone.fetch_add(1, std::memory_order_acq_rel) + 1 == job.bandCount) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake; // New job or stop
+    std::condition_variable m_idle; // Job finished or last worker left it
+    std::vector<std::thread> m_threads;
+    BandJob m_job;
+    uint64_t m_generation = 0;
+    uint32_t m_active = 0;
+    bool m_stop = false;
+    std::atomic<uint32_t> m_nextBand{ 0 };
+    std::atomic<uint32_t> m_bandsDone{ 0 };
+};
+
+// Never destroyed: at process exit idle workers still wait on its condition variables, and joining them from a static
+// destructor would run under the loader lock
+BandWorkerPool& BandWorkers() {
+    static BandWorkerPool* s_pool = new BandWorkerPool();
+    return *s_pool;
+}
+
+uint32_t BandWorkerCount() {
+    static const uint32_t s_count = (std::min)(kMaxBandWorkers, (std::max)(1u, std::thread::hardware_concurrency() / 4));
+    return s_count;
+}
+
+} // namespace
+
+void ConvertRGBAtoNV12Rows(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin, uint32_t rowEnd,
+                           CpuSimdLevel level) {
+    const ConvertRowPairFn convertRowPair = SelectConvertRowPair(level);
+    const size_t stride = static_cast<size_t>(width) * 4;
+    uint8_t* yPlane = nv12;
+    uint8_t* uvPlane = nv12 + static_cast<size_t>(width) * height;
+
+    for (uint32_t y = rowBegin; y < rowEnd; y += 2) {
+        RowPair rows;
+        rows.srcRow0 = rgba + (height - 1 - y) * stride; // Flip: OpenGL bottom-up -> NV12 top-down
+        rows.srcRow1 = rgba + (height - 2 - y) * stride;
+        rows.yRow0 = yPlane + static_cast<size_t>(y) * width;
+        rows.yRow1 = yPlane + static_cast<size_t>(y + 1) * width;
+        rows.uvRow = uvPlane + static_cast<size_t>(y / 2) * width;
+        convertRowPair(rows, 0, width);
+    }
+}
+
+void ConvertRGBAtoNV12(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, CpuSimdLevel level) {
+    const uint32_t workerCount = BandWorkerCount();
+    if (static_cast<uint64_t>(width) * height < kMinPixelsForBands) {
+        ConvertRGBAtoNV12Rows(rgba, nv12, width, height, 0, height, level);
+        return;
+    }
+
+    // One band per participant: the rows cost the same, so finer bands would only add hand-offs
+    const uint32_t participants = workerCount + 1;
+    BandJob job;
+    job.rgba = rgba;
+    job.nv12 = nv12;
+    job.width = width;
+    job.height = height;
+    job.bandRows = ((height / 2 + participants - 1) / participants) * 2;
+    job.bandCount = (height + job.bandRows - 1) / job.bandRows;
+    job.level = level;
+    BandWorkers().Run(job, workerCount);
+}
+
+void ShutdownNV12ConversionWorkers() { BandWorkers().Shutdown(); }
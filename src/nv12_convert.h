@@ -0,0 +1,28 @@
+#pragma once
+
+// ============================================================================
+// NV12_CONVERT.H - RGBA -> NV12 conversion for the virtual camera (CPU path)
+// ============================================================================
+// Input is a bottom-up RGBA8 readback (OpenGL row order), output is top-down
+// NV12: a full-resolution Y plane followed by interleaved UV at half
+// resolution. BT.601 limited range in 8.8 fixed point; chroma uses the
+// rounded average of each 2x2 block. Width and height must be even.
+//
+// Kernels are SSE2 and AVX2 and are selected at runtime via cpu_features.h.
+// All levels produce byte-identical output. Large frames are split into row
+// bands that a small worker pool converts alongside the calling thread.
+// ============================================================================
+
+#include <cstdint>
+
+#include "cpu_features.h"
+
+// Converts the whole frame, splitting it into row bands when it is large enough to be worth it.
+void ConvertRGBAtoNV12(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, CpuSimdLevel level = GetCpuSimdLevel());
+
+// Converts output rows [rowBegin, rowEnd) (both even) on the calling thread.
+void ConvertRGBAtoNV12Rows(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, uint32_t rowBegin, uint32_t rowEnd,
+                           CpuSimdLevel level = GetCpuSimdLevel());
+
+// Joins the band workers. They are started again on the next banded conversion.
+void ShutdownNV12ConversionWorkers();
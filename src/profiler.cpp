@@ -1,15 +1,74 @@
 #include "profiler.h"
-#include "utils.h" // For Log()
+#include "diagnostics_file.h"
+#include "log_record.h"
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <sstream>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
 Profiler& Profiler::GetInstance() {
     static Profiler instance;
     return instance;
 }
 
-Profiler::~Profiler() { StopProcessingThread(); }
+Profiler::Profiler() : m_useTsc(HasInvariantTsc()) {
+    m_calibrationStartTicks = ReadClock();
+    m_calibrationStartTime = std::chrono::steady_clock::now();
+    if (!m_useTsc) {
+        // The fallback clocks report their own (exact) frequency
+#ifdef _WIN32
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        m_msPerTick = 1000.0 / static_cast<double>(frequency.QuadPart);
+#else
+        m_msPerTick = 1e-6; // clock_gettime nanoseconds
+#endif
+        m_clockCalibrated = true;
+        m_msPerTickShared.store(m_msPerTick, std::memory_order_relaxed);
+        m_slowScopeTicks.store(static_cast<uint64_t>(100.0 / m_msPerTick), std::memory_order_relaxed);
+    }
+}
+
+Profiler::~Profiler() { Shutdown(); }
+
+uint64_t Profiler::ReadFallbackClock() {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+// The TSC rate is measured against steady_clock over the time since construction - no sleep, and the estimate only
+// gets better with age. It is frozen once the baseline is long enough for sub-0.1% error.
+void Profiler::UpdateClockCalibration() {
+    if (m_clockCalibrated) return;
+
+    const uint64_t ticks = ReadClock();
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(now - m_calibrationStartTime).count();
+    if (elapsedMs < 10.0 || ticks <= m_calibrationStartTicks) return;
+
+    m_msPerTick = elapsedMs / static_cast<double>(ticks - m_calibrationStartTicks);
+    m_clockCalibrated = elapsedMs >= 5000.0;
+    m_msPerTickShared.store(m_msPerTick, std::memory_order_relaxed);
+
+    constexpr double SLOW_THRESHOLD_MS = 100.0;
+    m_slowScopeTicks.store(static_cast<uint64_t>(SLOW_THRESHOLD_MS / m_msPerTick), std::memory_order_relaxed);
+}
 
 // RAII guard to invalidate buffer when thread exits
 struct ThreadBufferGuard {
@@ -42,78 +101,92 @@ void Profiler::RegisterThreadBuffer(ThreadRingBuffer* buffer) {
 
 void Profiler::MarkAsRenderThread() { GetThreadBuffer().isRenderThread = true; }
 
-// ScopedTimer - completely lock-free
-Profiler::ScopedTimer::ScopedTimer(Profiler& profiler, const char* sectionName) : m_sectionName(sectionName), m_depth(0), m_active(false) {
-    if (profiler.IsEnabled()) {
-        m_startTime = std::chrono::high_resolution_clock::now();
+void Profiler::SetThreadName(const char* name) { GetThreadBuffer().threadName.store(name, std::memory_order_relaxed); }
 
-        // Track stack depth for hierarchy (thread-local, no sync)
-        ThreadRingBuffer& buffer = GetThreadBuffer();
-        m_depth = static_cast<uint8_t>(buffer.scopeStack.size());
-        buffer.scopeStack.push_back(sectionName);
+Profiler::ScopeId Profiler::RegisterScope(const char* name, const char* category) {
+    Profiler& profiler = GetInstance();
+    std::lock_guard<std::mutex> lock(profiler.m_scopeRegistryMutex);
 
-        m_active = true;
+    const uint32_t count = profiler.m_scopeCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (std::strcmp(profiler.m_scopeNames[i], name) == 0) return static_cast<ScopeId>(i);
     }
-}
+    if (count >= MAX_SCOPES) return INVALID_SCOPE;
 
-Profiler::ScopedTimer::~ScopedTimer() {
-    if (m_active) {
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<double, std::milli>(endTime - m_startTime);
-        double durationMs = duration.count();
-
-        // Get parent name BEFORE popping (thread-local, no sync)
-        ThreadRingBuffer& buffer = GetThreadBuffer();
-        const char* parentName = nullptr;
-        if (buffer.scopeStack.size() > 1) {
-            // Parent is second-to-last in the stack (current scope is last)
-            parentName = buffer.scopeStack[buffer.scopeStack.size() - 2];
-        }
+    profiler.m_scopeNames[count] = name;
+    profiler.m_scopeCategories[count] = category;
+    profiler.m_scopeCount.store(count + 1, std::memory_order_release);
+    return static_cast<ScopeId>(count);
+}
 
-        // Pop scope stack
-        if (!buffer.scopeStack.empty()) { buffer.scopeStack.pop_back(); }
+uint32_t Profiler::FindOrCreateCallNode(uint32_t parent, ScopeId scope) {
+    // Fast path: the (parent, scope) node almost always exists already
+    for (uint32_t child = m_callNodes[parent].firstChild.load(std::memory_order_acquire); child != ROOT_CALL_NODE;
+         child = m_callNodes[child].nextSibling) {
+        if (m_callNodes[child].scope == scope) return child;
+    }
 
-        // Submit event with parent info - completely lock-free
-        Profiler::GetInstance().SubmitEvent(m_sectionName, parentName, durationMs, m_depth);
+    std::lock_guard<std::mutex> lock(m_callTreeMutex);
+    const uint32_t head = m_callNodes[parent].firstChild.load(std::memory_order_relaxed);
+    for (uint32_t child = head; child != ROOT_CALL_NODE; child = m_callNodes[child].nextSibling) {
+        if (m_callNodes[child].scope == scope) return child; // Created by another thread meanwhile
     }
+
+    const uint32_t id = m_callNodeCount.load(std::memory_order_relaxed);
+    if (id >= MAX_CALL_NODES) return ROOT_CALL_NODE;
+
+    CallNode& node = m_callNodes[id];
+    node.scope = scope;
+    node.parent = parent;
+    node.depth = m_callNodes[parent].depth + 1;
+    node.nextSibling = head;
+    m_callNodeCount.store(id + 1, std::memory_order_release);
+    m_callNodes[parent].firstChild.store(id, std::memory_order_release);
+    return id;
 }
 
-// Lock-free event submission - O(1), no locks, no allocations
-void Profiler::SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth) {
-    if (!m_enabled) return;
+// ScopedTimer - lock-free and allocation-free once the call node for this (parent, scope) pair exists
+Profiler::ScopedTimer::ScopedTimer(Profiler& profiler, ScopeId scope) {
+    if (!profiler.IsEnabled() || scope == INVALID_SCOPE) return;
 
+    // Resolve the call tree node from the thread's open scopes (thread-local, no sync)
     ThreadRingBuffer& buffer = GetThreadBuffer();
+    if (buffer.scopeDepth >= MAX_SCOPE_DEPTH) return;
+    const uint32_t parent = buffer.scopeDepth > 0 ? buffer.scopeStack[buffer.scopeDepth - 1] : ROOT_CALL_NODE;
+    const uint32_t node = profiler.FindOrCreateCallNode(parent, scope);
+    if (node == ROOT_CALL_NODE) return; // Tree full
+
+    const uint64_t now = profiler.ReadClock();
+    const uint32_t threadFlag = buffer.isRenderThread ? RECORD_RENDER_THREAD : 0;
+    // Buffer full - skip the whole scope (better than blocking), so begin and end records stay paired
+    if (!buffer.events.Push(TimingRecord{ now, node, threadFlag })) return;
+
+    buffer.scopeStack[buffer.scopeDepth++] = node;
+    m_profiler = &profiler;
+    m_buffer = &buffer;
+    m_node = node;
+    m_startTicks = now;
+}
 
-    // SLOW SCOPE DETECTION: Log any scope that takes more than 100ms
-    constexpr double SLOW_THRESHOLD_MS = 100.0;
-    if (durationMs > SLOW_THRESHOLD_MS) {
-        // Build path from current scope stack for better context
-        std::string pathStr = sectionName;
-        Log("[SLOW PROFILER] " + pathStr + " took " + std::to_string(durationMs) + "ms (>" +
-            std::to_string(static_cast<int>(SLOW_THRESHOLD_MS)) + "ms threshold)");
-    }
+Profiler::ScopedTimer::~ScopedTimer() {
+    if (!m_buffer) return;
 
-    // Get write position (only this thread writes to writeIndex)
-    size_t writePos = buffer.writeIndex.load(std::memory_order_relaxed);
-    size_t nextWritePos = (writePos + 1) % RING_BUFFER_SIZE;
+    const uint64_t now = m_profiler->ReadClock();
+    m_buffer->scopeDepth--;
 
-    // Check if buffer is full (would overwrite unread data)
-    if (nextWritePos == buffer.readIndex.load(std::memory_order_acquire)) {
-        // Buffer full - drop this event (better than blocking)
-        return;
-    }
+    // If the end record is dropped, the processing side discards the unmatched begin
+    const uint32_t threadFlag = m_buffer->isRenderThread ? RECORD_RENDER_THREAD : 0;
+    m_buffer->events.Push(TimingRecord{ now, m_node, RECORD_END | threadFlag });
 
-    // Write event data
-    TimingEvent& event = buffer.events[writePos];
-    event.sectionName = sectionName;
-    event.parentName = parentName;
-    event.durationMs = durationMs;
-    event.threadId = buffer.threadId;
-    event.depth = depth;
-    event.isRenderThread = buffer.isRenderThread;
+    // SLOW SCOPE DETECTION: Log any scope that takes more than 100ms
+    const uint64_t elapsed = now - m_startTicks;
+    if (elapsed > m_profiler->m_slowScopeTicks.load(std::memory_order_relaxed)) { m_profiler->ReportSlowScope(m_node, elapsed); }
+}
 
-    // Publish the write (release semantics ensure event data is visible)
-    buffer.writeIndex.store(nextWritePos, std::memory_order_release);
+void Profiler::ReportSlowScope(uint32_t node, uint64_t ticks) const {
+    const double durationMs = static_cast<double>(ticks) * m_msPerTickShared.load(std::memory_order_relaxed);
+    std::string pathStr = m_scopeNames[m_callNodes[node].scope];
+    Log("[SLOW PROFILER] " + pathStr + " took " + std::to_string(durationMs) + "ms (>100ms threshold)");
 }
 
 void Profiler::StartProcessingThread() {
@@ -130,6 +203,28 @@ void Profiler::StopProcessingThread() {
     if (m_processingThread.joinable()) { m_processingThread.join(); }
 }
 
+void Profiler::Shutdown() {
+    StopProcessingThread();
+    JoinDiagnosticsWriter();
+}
+
+bool Profiler::StartDiagnosticsWrite(std::function<void()> write) {
+    if (m_diagnosticsWriteInFlight.exchange(true, std::memory_order_acq_rel)) return false;
+
+    std::lock_guard<std::mutex> lock(m_diagnosticsWriterMutex);
+    if (m_diagnosticsWriter.joinable()) m_diagnosticsWriter.join(); // Finished: the in-flight flag was clear
+    m_diagnosticsWriter = std::thread([this, write = std::move(write)]() {
+        write();
+        m_diagnosticsWriteInFlight.store(false, std::memory_order_release);
+    });
+    return true;
+}
+
+void Profiler::JoinDiagnosticsWriter() {
+    std::lock_guard<std::mutex> lock(m_diagnosticsWriterMutex);
+    if (m_diagnosticsWriter.joinable()) m_diagnosticsWriter.join();
+}
+
 void Profiler::ProcessingThreadMain() {
     while (m_processingThreadRunning.load()) {
         ProcessEvents();
@@ -143,138 +238,177 @@ void Profiler::ProcessEvents() {
     std::vector<ThreadRingBuffer*> buffers = m_threadRegistry; // Copy to release lock quickly
     m_registryLock.clear(std::memory_order_release);
 
+    UpdateClockCalibration();
+
+    // One timestamp per drain: staleness is judged in seconds, per-event precision buys nothing
+    const auto now = std::chrono::steady_clock::now();
+
     for (ThreadRingBuffer* buffer : buffers) {
         // Skip invalidated buffers (thread has exited)
         if (!buffer->isValid.load(std::memory_order_acquire)) { continue; }
 
-        // Read all available events from this buffer
-        size_t readPos = buffer->readIndex.load(std::memory_order_relaxed);
-        size_t writePos = buffer->writeIndex.load(std::memory_order_acquire);
+        if (m_flightRecorderEnabled) { TraceThreadIndex(*buffer); }
 
-        while (readPos != writePos) {
-            const TimingEvent& event = buffer->events[readPos];
-
-            // Process this event into our aggregated data
-            auto& targetEntries = event.isRenderThread ? m_renderThreadEntries : m_otherThreadEntries;
+        // Read all available records from this buffer, pairing each end record with its begin record
+        buffer->events.ConsumeAll([this, now, buffer](const TimingRecord& record) {
+            if (!(record.flags & RECORD_END)) {
+                if (buffer->openScopeCount < MAX_SCOPE_DEPTH) { buffer->openScopes[buffer->openScopeCount++] = { record.node, record.ticks }; }
+                return;
+            }
 
-            // Use section name as key
-            std::string pathKey = event.sectionName;
+            // Begins above the matching one lost their end record to a full ring; no match at all means the begin
+            // was lost (or cleared) instead
+            uint32_t match = buffer->openScopeCount;
+            while (match > 0 && buffer->openScopes[match - 1].node != record.node) { --match; }
+            if (match == 0) return;
+            buffer->openScopeCount = match - 1;
+            const uint64_t beginTicks = buffer->openScopes[match - 1].ticks;
+            if (m_flightRecorderEnabled) { RecordTraceEvent({ beginTicks, record.ticks, record.node, buffer->traceThread }); }
+            const double durationMs = record.ticks > beginTicks ? static_cast<double>(record.ticks - beginTicks) * m_msPerTick : 0.0;
+
+            const bool renderThread = (record.flags & RECORD_RENDER_THREAD) != 0;
+            auto& targetEntries = renderThread ? m_renderThreadEntries : m_otherThreadEntries;
+            auto& targetHistograms = renderThread ? m_renderThreadHistograms : m_otherThreadHistograms;
+            // The node was published before the record was pushed, so the current count covers it
+            if (record.node >= targetEntries.size()) {
+                const uint32_t nodeCount = m_callNodeCount.load(std::memory_order_acquire);
+                targetEntries.resize(nodeCount);
+                targetHistograms.resize(nodeCount);
+            }
 
-            auto& entry = targetEntries[pathKey];
-            entry.displayName = event.sectionName;
-            entry.totalTime += event.durationMs;
+            ProfileEntry& entry = targetEntries[record.node];
+            entry.totalTime += durationMs;
             entry.callCount++;
-            entry.depth = event.depth;
-            entry.lastUpdateTime = std::chrono::steady_clock::now();
-
-            // Build parent-child relationships
-            if (event.parentName != nullptr) {
-                std::string parentKey = event.parentName;
-                entry.parentPath = parentKey;
-
-                // Add this as a child of the parent
-                auto& parentEntry = targetEntries[parentKey];
-                parentEntry.displayName = event.parentName;
-                // Add to child paths if not already present
-                bool found = false;
-                for (const auto& child : parentEntry.childPaths) {
-                    if (child == pathKey) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) { parentEntry.childPaths.push_back(pathKey); }
-            }
+            entry.lastUpdateTime = now;
 
             // Track max time
-            if (event.durationMs > entry.maxTimeInLastSecond) { entry.maxTimeInLastSecond = event.durationMs; }
+            if (durationMs > entry.maxTimeInLastSecond) { entry.maxTimeInLastSecond = durationMs; }
 
-            // Advance read position
-            readPos = (readPos + 1) % RING_BUFFER_SIZE;
-        }
-
-        // Publish read progress
-        buffer->readIndex.store(readPos, std::memory_order_release);
+            // Durations are meaningless until the clock rate has its first estimate
+            if (m_msPerTick > 0.0) {
+                std::unique_ptr<LatencyHistogram>& histogram = targetHistograms[record.node];
+                if (!histogram) histogram = std::make_unique<LatencyHistogram>();
+                histogram->Record(static_cast<uint64_t>(durationMs * 1e6));
+            }
+        });
     }
 }
 
-void Profiler::CalculateHierarchy(std::unordered_map<std::string, ProfileEntry>& entries, double totalTime) {
-    // Calculate self time (total time minus children's time)
-    for (auto& [path, entry] : entries) {
-        double childrenTime = 0.0;
-        for (const auto& childPath : entry.childPaths) {
-            auto it = entries.find(childPath);
-            if (it != entries.end()) { childrenTime += it->second.totalTime; }
-        }
-        entry.selfTime = entry.totalTime - childrenTime;
+void Profiler::CalculateHierarchy(std::vector<ProfileEntry>& entries, double& totalTime) {
+    // Children are always created after their parent, so one descending pass sees every child before its parent:
+    // it computes self time (total time minus children's time) and the frame total (sum of root scopes)
+    m_childTimeScratch.assign(entries.size(), 0.0);
+    totalTime = 0.0;
+    for (size_t id = entries.size(); id-- > 1;) {
+        ProfileEntry& entry = entries[id];
+        entry.selfTime = entry.totalTime - m_childTimeScratch[id];
         if (entry.selfTime < 0.0) entry.selfTime = 0.0; // Clamp to 0
+
+        const uint32_t parent = m_callNodes[id].parent;
+        if (parent == ROOT_CALL_NODE) {
+            totalTime += entry.totalTime;
+        } else {
+            m_childTimeScratch[parent] += entry.totalTime;
+        }
     }
 
     // Calculate percentages
-    for (auto& [path, entry] : entries) {
+    for (size_t id = 1; id < entries.size(); ++id) {
+        ProfileEntry& entry = entries[id];
         entry.totalPercentage = totalTime > 0.0 ? (entry.totalTime / totalTime) * 100.0 : 0.0;
 
         // Parent percentage
-        if (!entry.parentPath.empty()) {
-            auto it = entries.find(entry.parentPath);
-            if (it != entries.end() && it->second.totalTime > 0.0) {
-                entry.parentPercentage = (entry.totalTime / it->second.totalTime) * 100.0;
-            }
+        const uint32_t parent = m_callNodes[id].parent;
+        if (parent != ROOT_CALL_NODE) {
+            if (entries[parent].totalTime > 0.0) { entry.parentPercentage = (entry.totalTime / entries[parent].totalTime) * 100.0; }
         } else {
             entry.parentPercentage = entry.totalPercentage;
         }
     }
 }
 
-void Profiler::BuildDisplayTree(const std::unordered_map<std::string, ProfileEntry>& entries,
-                                std::vector<std::pair<std::string, ProfileEntry>>& output) {
+void Profiler::BuildDisplayTree(const std::vector<ProfileEntry>& entries, std::vector<std::pair<std::string, ProfileEntry>>& output) {
     output.clear();
+    if (entries.empty()) return;
+
+    // A node is shown if it has recent data or a shown descendant (a long-running parent scope that has not
+    // completed yet still needs its row). Children are created after parents, so one descending pass suffices.
+    const size_t count = entries.size();
+    std::vector<char> visible(count, 0);
+    const std::chrono::steady_clock::time_point never{};
+    for (size_t id = count; id-- > 1;) {
+        if (entries[id].lastUpdateTime != never) visible[id] = 1;
+        if (visible[id]) visible[m_callNodes[id].parent] = 1;
+    }
 
-    // Build a map of parent -> children for quick lookup
-    std::unordered_map<std::string, std::vector<std::string>> childrenMap;
-    std::vector<std::string> rootEntries;
-
-    for (const auto& [path, entry] : entries) {
-        if (entry.parentPath.empty()) {
-            rootEntries.push_back(path);
-        } else {
-            childrenMap[entry.parentPath].push_back(path);
-        }
+    // Children of each shown node
+    std::vector<std::vector<uint32_t>> children(count);
+    for (size_t id = 1; id < count; ++id) {
+        if (visible[id]) children[m_callNodes[id].parent].push_back(static_cast<uint32_t>(id));
     }
 
     // Sort children by rolling average time (descending) within each parent
-    auto sortByTime = [&entries](std::vector<std::string>& names) {
-        std::sort(names.begin(), names.end(), [&entries](const std::string& a, const std::string& b) {
-            auto itA = entries.find(a);
-            auto itB = entries.find(b);
-            double timeA = (itA != entries.end()) ? itA->second.rollingAverageTime : 0.0;
-            double timeB = (itB != entries.end()) ? itB->second.rollingAverageTime : 0.0;
-            return timeA > timeB;
-        });
+    for (auto& siblings : children) {
+        std::sort(siblings.begin(), siblings.end(),
+                  [&entries](uint32_t a, uint32_t b) { return entries[a].rollingAverageTime > entries[b].rollingAverageTime; });
+    }
+
+    // Recursive function to add entry and its children in order
+    std::function<void(uint32_t)> addEntryWithChildren = [&](uint32_t id) {
+        ProfileEntry entry = entries[id];
+        entry.depth = m_callNodes[id].depth;
+        output.emplace_back(m_scopeNames[m_callNodes[id].scope], entry);
+        for (uint32_t child : children[id]) { addEntryWithChildren(child); }
     };
 
-    // Sort root entries by time
-    sortByTime(rootEntries);
+    // Start with root entries and recursively add children
+    for (uint32_t rootId : children[ROOT_CALL_NODE]) { addEntryWithChildren(rootId); }
+}
+
+void Profiler::RegisterCounter(const char* name, const char* unit, std::function<double()> sampleCumulative) {
+    std::lock_guard<std::mutex> lock(m_counterMutex);
+    CounterSource source;
+    source.name = name;
+    source.unit = unit;
+    source.sample = std::move(sampleCumulative);
+    m_counters.push_back(std::move(source));
+}
 
-    // Sort all children groups by time
-    for (auto& [parent, children] : childrenMap) { sortByTime(children); }
+void Profiler::SampleCounters(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_counterMutex);
 
-    // Recursive function to add entry and its children in order
-    std::function<void(const std::string&)> addEntryWithChildren = [&](const std::string& path) {
-        auto it = entries.find(path);
-        if (it != entries.end()) {
-            output.emplace_back(path, it->second);
-
-            // Add all children recursively
-            auto childIt = childrenMap.find(path);
-            if (childIt != childrenMap.end()) {
-                for (const auto& childPath : childIt->second) { addEntryWithChildren(childPath); }
-            }
+    // After a gap (profiler was disabled), the next delta would span many frames - re-prime instead
+    constexpr auto MAX_SAMPLE_GAP = std::chrono::seconds(1);
+    const bool gap = (now - m_lastCounterSampleTime) > MAX_SAMPLE_GAP;
+    m_lastCounterSampleTime = now;
+
+    for (auto& counter : m_counters) {
+        const double value = counter.sample();
+        if (counter.primed && !gap) {
+            counter.accumulatedDelta += value - counter.lastValue;
+            counter.frames++;
         }
-    };
+        counter.lastValue = value;
+        counter.primed = true;
+    }
+}
 
-    // Start with root entries and recursively add children
-    for (const auto& rootPath : rootEntries) { addEntryWithChildren(rootPath); }
+void Profiler::BuildCounterDisplay(std::vector<CounterEntry>& output) {
+    std::lock_guard<std::mutex> lock(m_counterMutex);
+    output.clear();
+    output.reserve(m_counters.size());
+
+    for (auto& counter : m_counters) {
+        CounterEntry entry;
+        entry.name = counter.name;
+        entry.unit = counter.unit;
+        entry.perFrame = counter.frames > 0 ? counter.accumulatedDelta / counter.frames : 0.0;
+        output.push_back(std::move(entry));
+
+        // Each display interval reports only its own frames
+        counter.accumulatedDelta = 0.0;
+        counter.frames = 0;
+    }
 }
 
 void Profiler::EndFrame() {
@@ -284,15 +418,20 @@ void Profiler::EndFrame() {
 
     // Process any pending events
     ProcessEvents();
+    SampleCounters(currentTime);
+    if (m_flightRecorderEnabled) { RecordFrameMarker(); }
 
-    // Calculate totals
-    m_totalRenderTime = 0.0;
-    m_totalOtherTime = 0.0;
-
-    for (const auto& [path, entry] : m_renderThreadEntries) { m_totalRenderTime += entry.totalTime; }
-    for (const auto& [path, entry] : m_otherThreadEntries) { m_totalOtherTime += entry.totalTime; }
+    if (m_histogramResetRequested.exchange(false, std::memory_order_acq_rel)) {
+        for (auto& histogram : m_renderThreadHistograms) {
+            if (histogram) histogram->Reset();
+        }
+        for (auto& histogram : m_otherThreadHistograms) {
+            if (histogram) histogram->Reset();
+        }
+    }
+    if (m_histogramExportRequested.exchange(false, std::memory_order_acq_rel)) { ExportHistograms(); }
 
-    // Calculate hierarchy (self time, percentages)
+    // Calculate hierarchy (self time, percentages) and the frame totals
     CalculateHierarchy(m_renderThreadEntries, m_totalRenderTime);
     CalculateHierarchy(m_otherThreadEntries, m_totalOtherTime);
 
@@ -301,44 +440,30 @@ void Profiler::EndFrame() {
     m_accumulatedOtherTime += m_totalOtherTime;
     m_frameCountForAveraging++;
 
-    // Accumulate per-entry data
-    auto accumulateEntries = [this](std::unordered_map<std::string, ProfileEntry>& entries) {
-        for (auto& [path, entry] : entries) {
+    // Accumulate per-entry data, reset frame data for next frame and drop entries that haven't been updated in
+    // 5 seconds (the node stays in the call tree; its entry returns to the never-updated state)
+    constexpr auto STALE_THRESHOLD = std::chrono::seconds(5);
+    const std::chrono::steady_clock::time_point never{};
+    auto finishEntries = [&](std::vector<ProfileEntry>& entries) {
+        for (auto& entry : entries) {
+            if (entry.lastUpdateTime == never) continue;
+            if (currentTime - entry.lastUpdateTime > STALE_THRESHOLD) {
+                entry = ProfileEntry{};
+                continue;
+            }
+
             entry.accumulatedTime += entry.totalTime;
             entry.accumulatedSelfTime += entry.selfTime;
             entry.accumulatedCalls += entry.callCount;
             entry.frameCount++;
-        }
-    };
-    accumulateEntries(m_renderThreadEntries);
-    accumulateEntries(m_otherThreadEntries);
 
-    // Reset frame data for next frame
-    for (auto& [path, entry] : m_renderThreadEntries) {
-        entry.totalTime = 0.0;
-        entry.selfTime = 0.0;
-        entry.callCount = 0;
-    }
-    for (auto& [path, entry] : m_otherThreadEntries) {
-        entry.totalTime = 0.0;
-        entry.selfTime = 0.0;
-        entry.callCount = 0;
-    }
-
-    // Remove stale entries that haven't been updated in 5 seconds
-    constexpr auto STALE_THRESHOLD = std::chrono::seconds(5);
-    auto removeStaleEntries = [&currentTime](std::unordered_map<std::string, ProfileEntry>& entries) {
-        for (auto it = entries.begin(); it != entries.end();) {
-            auto timeSinceUpdate = currentTime - it->second.lastUpdateTime;
-            if (timeSinceUpdate > STALE_THRESHOLD) {
-                it = entries.erase(it);
-            } else {
-                ++it;
-            }
+            entry.totalTime = 0.0;
+            entry.selfTime = 0.0;
+            entry.callCount = 0;
         }
     };
-    removeStaleEntries(m_renderThreadEntries);
-    removeStaleEntries(m_otherThreadEntries);
+    finishEntries(m_renderThreadEntries);
+    finishEntries(m_otherThreadEntries);
 
     // Update display cache
     auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_lastUpdateTime);
@@ -346,8 +471,8 @@ void Profiler::EndFrame() {
         double avgRenderTime = m_frameCountForAveraging > 0 ? m_accumulatedRenderTime / m_frameCountForAveraging : 0.0;
         double avgOtherTime = m_frameCountForAveraging > 0 ? m_accumulatedOtherTime / m_frameCountForAveraging : 0.0;
 
-        auto updateRollingAverages = [this](std::unordered_map<std::string, ProfileEntry>& entries, double avgTotal) {
-            for (auto& [path, entry] : entries) {
+        auto updateRollingAverages = [](std::vector<ProfileEntry>& entries, double avgTotal) {
+            for (auto& entry : entries) {
                 if (entry.frameCount > 0) {
                     entry.rollingAverageTime = entry.accumulatedTime / entry.frameCount;
                     entry.rollingSelfTime = entry.accumulatedSelfTime / entry.frameCount;
@@ -357,12 +482,16 @@ void Profiler::EndFrame() {
         };
         updateRollingAverages(m_renderThreadEntries, avgRenderTime);
         updateRollingAverages(m_otherThreadEntries, avgOtherTime);
+        FillLatencyStats(m_renderThreadHistograms, m_renderThreadEntries);
+        FillLatencyStats(m_otherThreadHistograms, m_otherThreadEntries);
 
         // Lock mutex while updating display cache to prevent race with GetProfileData
         {
             std::lock_guard<std::mutex> lock(m_displayDataMutex);
             BuildDisplayTree(m_renderThreadEntries, m_cachedDisplayData.renderThread);
             BuildDisplayTree(m_otherThreadEntries, m_cachedDisplayData.otherThreads);
+            BuildCounterDisplay(m_cachedDisplayData.counters);
+            std::copy(std::begin(m_latencyThresholdsMs), std::end(m_latencyThresholdsMs), m_cachedDisplayData.latencyThresholdsMs);
         }
 
         m_lastUpdateTime = currentTime;
@@ -388,20 +517,321 @@ void Profiler::Clear() {
     while (m_registryLock.test_and_set(std::memory_order_acquire)) {}
 
     for (ThreadRingBuffer* buffer : m_threadRegistry) {
-        buffer->readIndex.store(0, std::memory_order_relaxed);
-        buffer->writeIndex.store(0, std::memory_order_relaxed);
-        buffer->scopeStack.clear();
+        buffer->events.Clear();
+        buffer->openScopeCount = 0; // Producer-side scope stacks stay balanced by their ScopedTimers
     }
 
     m_registryLock.clear(std::memory_order_release);
 
     m_renderThreadEntries.clear();
     m_otherThreadEntries.clear();
+    m_renderThreadHistograms.clear();
+    m_otherThreadHistograms.clear();
     m_cachedDisplayData.renderThread.clear();
     m_cachedDisplayData.otherThreads.clear();
+    m_cachedDisplayData.counters.clear();
     m_totalRenderTime = 0.0;
     m_totalOtherTime = 0.0;
     m_accumulatedRenderTime = 0.0;
     m_accumulatedOtherTime = 0.0;
     m_frameCountForAveraging = 0;
+
+    m_traceNext = 0;
+    m_traceWrapped = false;
+    m_lastFrameTicks = 0;
+
+    std::lock_guard<std::mutex> lock(m_counterMutex);
+    for (auto& counter : m_counters) {
+        counter.accumulatedDelta = 0.0;
+        counter.frames = 0;
+        counter.primed = false;
+    }
+}
+
+void Profiler::ConfigureFlightRecorder(bool enabled, int seconds, double hitchThresholdMs) {
+    seconds = (std::max)(1, (std::min)(seconds, 60));
+    m_hitchThresholdMs = hitchThresholdMs;
+    if (enabled == m_flightRecorderEnabled && (!enabled || seconds == m_flightRecorderSeconds)) return;
+
+    m_flightRecorderEnabled = enabled;
+    m_flightRecorderSeconds = seconds;
+    m_traceNext = 0;
+    m_traceWrapped = false;
+    m_lastFrameTicks = 0;
+    m_lastAutoDumpTicks = 0;
+    m_traceDumpRequested.store(false, std::memory_order_relaxed);
+    if (enabled) {
+        m_traceEvents.assign(static_cast<size_t>(seconds) * TRACE_EVENTS_PER_SECOND, TraceEvent{});
+        Log("[Profiler] Flight recorder enabled (" + std::to_string(seconds) + "s history)");
+    } else {
+        std::vector<TraceEvent>().swap(m_traceEvents);
+        Log("[Profiler] Flight recorder disabled");
+    }
+}
+
+uint32_t Profiler::TraceThreadIndex(ThreadRingBuffer& buffer) {
+    if (buffer.traceThread == UINT32_MAX) {
+        buffer.traceThread = static_cast<uint32_t>(m_traceThreads.size());
+        m_traceThreads.push_back({ buffer.threadId, nullptr, false });
+    }
+    TraceThread& thread = m_traceThreads[buffer.traceThread];
+    thread.name = buffer.threadName.load(std::memory_order_relaxed); // May be set after the first drain
+    thread.isRenderThread = buffer.isRenderThread;
+    return buffer.traceThread;
+}
+
+void Profiler::RecordTraceEvent(const TraceEvent& event) {
+    m_traceEvents[m_traceNext] = event;
+    if (++m_traceNext == m_traceEvents.size()) {
+        m_traceNext = 0;
+        m_traceWrapped = true;
+    }
+}
+
+void Profiler::RecordFrameMarker() {
+    const uint32_t thread = TraceThreadIndex(GetThreadBuffer());
+    const uint64_t now = ReadClock();
+    const uint64_t previous = m_lastFrameTicks;
+    m_lastFrameTicks = now;
+    if (previous == 0) return; // First frame since the recorder was (re)started
+    RecordTraceEvent({ previous, now, ROOT_CALL_NODE, thread });
+
+    if (m_traceDumpRequested.exchange(false, std::memory_order_acq_rel)) {
+        DumpTrace("requested");
+        return;
+    }
+
+    // Automatic dumps: at most one per history window, so consecutive hitches land in one file
+    const double frameMs = static_cast<double>(now - previous) * m_msPerTick;
+    if (m_hitchThresholdMs <= 0.0 || frameMs <= m_hitchThresholdMs) return;
+    if (m_lastAutoDumpTicks != 0 && static_cast<double>(now - m_lastAutoDumpTicks) * m_msPerTick < m_flightRecorderSeconds * 1000.0) return;
+    m_lastAutoDumpTicks = now;
+
+    char reason[64];
+    snprintf(reason, sizeof(reason), "hitch: %.1f ms frame", frameMs);
+    DumpTrace(reason);
+}
+
+void Profiler::DumpTrace(const std::string& reason) {
+    if (IsDiagnosticsWriteInFlight()) {
+        Log("[Profiler] Trace dump skipped (" + reason + ") - the previous dump or export is still being written");
+        return;
+    }
+
+    // Copy the last `seconds` out of the circular buffer here; formatting and file IO happen on a worker thread
+    const uint64_t windowTicks = m_msPerTick > 0.0 ? static_cast<uint64_t>(m_flightRecorderSeconds * 1000.0 / m_msPerTick) : UINT64_MAX;
+    const uint64_t cutoff = m_lastFrameTicks > windowTicks ? m_lastFrameTicks - windowTicks : 0;
+
+    TraceDump dump;
+    dump.threads = m_traceThreads;
+    dump.msPerTick = m_msPerTick;
+    dump.reason = reason;
+    dump.events.reserve(m_traceWrapped ? m_traceEvents.size() : m_traceNext);
+    auto copyRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (m_traceEvents[i].endTicks >= cutoff) dump.events.push_back(m_traceEvents[i]);
+        }
+    };
+    if (m_traceWrapped) copyRange(m_traceNext, m_traceEvents.size());
+    copyRange(0, m_traceNext);
+
+    if (m_traceWrapped && !dump.events.empty() && dump.events.front().endTicks > cutoff) {
+        const double coveredMs = static_cast<double>(m_lastFrameTicks - dump.events.front().endTicks) * m_msPerTick;
+        Log("[Profiler] Flight recorder buffer only covered the last " + std::to_string(coveredMs / 1000.0) + "s");
+    }
+
+    auto shared = std::make_shared<TraceDump>(std::move(dump)); // std::function needs a copyable callable
+    if (!StartDiagnosticsWrite([this, shared]() { WriteTraceFile(*shared); })) {
+        Log("[Profiler] Trace dump skipped (" + reason + ") - the previous dump or export is still being written");
+    }
+}
+
+namespace {
+
+void AppendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            out += ' ';
+        } else {
+            out += *c;
+        }
+    }
+    out += '"';
+}
+
+void AppendCsvField(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"') out += '"';
+        out += *c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+// Chrome trace event format: one complete ("X") event per scope, a process-wide instant event plus a frame time counter
+// per frame marker. Timestamps are microseconds from the oldest event in the dump.
+void Profiler::WriteTraceFile(const TraceDump& dump) const {
+    if (dump.events.empty()) {
+        Log("[Profiler] Trace dump (" + dump.reason + ") skipped - no events recorded");
+        return;
+    }
+
+    uint64_t baseTicks = UINT64_MAX;
+    for (const TraceEvent& event : dump.events) { baseTicks = (std::min)(baseTicks, event.beginTicks); }
+    const double usPerTick = dump.msPerTick * 1000.0;
+
+    std::string json;
+    json.reserve(dump.events.size() * 112 + 4096);
+    json += "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"reason\":";
+    AppendJsonString(json, dump.reason.c_str());
+    json += "},\"traceEvents\":[\n";
+    json += "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"Toolscreen\"}}";
+
+    char line[320];
+    for (const TraceThread& thread : dump.threads) {
+        std::string fallbackName = thread.isRenderThread ? "Game" : "Thread " + std::to_string(thread.threadId);
+        json += ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread.threadId) + ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        AppendJsonString(json, thread.name ? thread.name : fallbackName.c_str());
+        json += "}}";
+        snprintf(line, sizeof(line), ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}",
+                 thread.threadId, thread.isRenderThread ? 0 : 1);
+        json += line;
+    }
+
+    for (const TraceEvent& event : dump.events) {
+        const uint32_t tid = dump.threads[event.thread].threadId;
+        const double ts = static_cast<double>(event.beginTicks - baseTicks) * usPerTick;
+        const double end = static_cast<double>(event.endTicks - baseTicks) * usPerTick;
+        if (event.node == ROOT_CALL_NODE) {
+            const double frameMs = (end - ts) / 1000.0;
+            snprintf(line, sizeof(line),
+                     ",\n{\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"Frame\",\"args\":{\"ms\":%.3f}}"
+                     ",\n{\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"Frame Time (ms)\",\"args\":{\"ms\":%.3f}}",
+                     tid, end, frameMs, tid, end, frameMs);
+            json += line;
+            continue;
+        }
+
+        const ScopeId scope = m_callNodes[event.node].scope;
+        const char* category = m_scopeCategories[scope];
+        snprintf(line, sizeof(line), ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", tid, ts, end - ts);
+        json += line;
+        AppendJsonString(json, m_scopeNames[scope]);
+        json += ",\"cat\":";
+        AppendJsonString(json, category ? category : "scope");
+        json += '}';
+    }
+    json += "\n]}\n";
+
+    std::filesystem::path path;
+    if (!WriteDiagnosticsFile("trace", ".json", json, path)) {
+        Log("[Profiler] Failed to write trace dump to " + path.string());
+        return;
+    }
+    Log("[Profiler] Trace dump (" + dump.reason + ", " + std::to_string(dump.events.size()) + " events) written to " + path.string());
+}
+
+void Profiler::SetLatencyThresholds(double firstMs, double secondMs) {
+    m_latencyThresholdsMs[0] = firstMs;
+    m_latencyThresholdsMs[1] = secondMs;
+}
+
+void Profiler::FillLatencyStats(const HistogramList& histograms, std::vector<ProfileEntry>& entries) const {
+    const size_t count = (std::min)(histograms.size(), entries.size());
+    for (size_t id = 1; id < count; ++id) {
+        ProfileEntry& entry = entries[id];
+        const LatencyHistogram* histogram = histograms[id].get();
+        if (!histogram) continue;
+
+        constexpr double MS_PER_NS = 1e-6;
+        entry.sampleCount = histogram->TotalCount();
+        entry.p50Time = histogram->ValueAtPercentile(50.0) * MS_PER_NS;
+        entry.p90Time = histogram->ValueAtPercentile(90.0) * MS_PER_NS;
+        entry.p99Time = histogram->ValueAtPercentile(99.0) * MS_PER_NS;
+        entry.p999Time = histogram->ValueAtPercentile(99.9) * MS_PER_NS;
+        entry.maxTime = histogram->MaxValue() * MS_PER_NS;
+        for (int t = 0; t < LATENCY_THRESHOLD_COUNT; ++t) {
+            entry.callsAboveThreshold[t] = histogram->CountAbove(static_cast<uint64_t>(m_latencyThresholdsMs[t] * 1e6));
+        }
+    }
+}
+
+// One row per call path, then one per scope with the histograms of all its call paths merged. Built here (the
+// histograms belong to this thread), written to disk on a worker.
+void Profiler::ExportHistograms() {
+    std::string csv = "thread_group,kind,scope,path,samples,mean_ms,p50_ms,p90_ms,p99_ms,p99.9_ms,max_ms";
+    char field[160];
+    for (double threshold : m_latencyThresholdsMs) {
+        snprintf(field, sizeof(field), ",above_%gms", threshold);
+        csv += field;
+    }
+    csv += '\n';
+
+    auto appendRow = [&](const char* group, const char* kind, const char* scope, const std::string& path,
+                         const LatencyHistogram& histogram) {
+        csv += group;
+        csv += ',';
+        csv += kind;
+        csv += ',';
+        AppendCsvField(csv, scope);
+        csv += ',';
+        AppendCsvField(csv, path.c_str());
+        constexpr double MS_PER_NS = 1e-6;
+        snprintf(field, sizeof(field), ",%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f", static_cast<unsigned long long>(histogram.TotalCount()),
+                 histogram.Mean() * MS_PER_NS, histogram.ValueAtPercentile(50.0) * MS_PER_NS,
+                 histogram.ValueAtPercentile(90.0) * MS_PER_NS, histogram.ValueAtPercentile(99.0) * MS_PER_NS,
+                 histogram.ValueAtPercentile(99.9) * MS_PER_NS, histogram.MaxValue() * MS_PER_NS);
+        csv += field;
+        for (double threshold : m_latencyThresholdsMs) {
+            snprintf(field, sizeof(field), ",%llu", static_cast<unsigned long long>(histogram.CountAbove(static_cast<uint64_t>(threshold * 1e6))));
+            csv += field;
+        }
+        csv += '\n';
+    };
+
+    size_t rows = 0;
+    auto exportGroup = [&](const char* group, const HistogramList& histograms) {
+        std::vector<std::unique_ptr<LatencyHistogram>> perScope(m_scopeCount.load(std::memory_order_acquire));
+        for (size_t id = 1; id < histograms.size(); ++id) {
+            const LatencyHistogram* histogram = histograms[id].get();
+            if (!histogram || histogram->TotalCount() == 0) continue;
+
+            const ScopeId scope = m_callNodes[id].scope;
+            std::string path = m_scopeNames[scope];
+            for (uint32_t parent = m_callNodes[id].parent; parent != ROOT_CALL_NODE; parent = m_callNodes[parent].parent) {
+                path = std::string(m_scopeNames[m_callNodes[parent].scope]) + " > " + path;
+            }
+            appendRow(group, "path", m_scopeNames[scope], path, *histogram);
+            rows++;
+
+            if (!perScope[scope]) perScope[scope] = std::make_unique<LatencyHistogram>();
+            perScope[scope]->Merge(*histogram);
+        }
+        for (size_t scope = 0; scope < perScope.size(); ++scope) {
+            if (perScope[scope]) appendRow(group, "scope", m_scopeNames[scope], "*", *perScope[scope]);
+        }
+    };
+    exportGroup("render", m_renderThreadHistograms);
+    exportGroup("other", m_otherThreadHistograms);
+
+    if (rows == 0) {
+        Log("[Profiler] Histogram export skipped - no samples recorded");
+        return;
+    }
+    auto shared = std::make_shared<std::string>(std::move(csv));
+    const bool started = StartDiagnosticsWrite([shared, rows]() {
+        std::filesystem::path path;
+        if (!WriteDiagnosticsFile("histograms", ".csv", *shared, path)) {
+            Log("[Profiler] Failed to write histogram export to " + path.string());
+            return;
+        }
+        Log("[Profiler] Histogram export (" + std::to_string(rows) + " call paths) written to " + path.string());
+    });
+    if (!started) Log("[Profiler] Histogram export skipped - the previous dump or export is still being written");
 }
@@ -2,22 +2,45 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "cpu_features.h"
+#include "latency_histogram.h"
+#include "ring_buffer.h"
+
 // Lock-free hierarchical profiler using a single-producer queue per thread
-// Hot path (PROFILE_SCOPE) is completely lock-free - just writes to a ring buffer
+// Hot path (PROFILE_SCOPE) is completely lock-free - a scope writes one begin and one end record (raw clock ticks) to
+// its thread's ring buffer, with no clock conversion and no heap use
 // Background thread aggregates and processes timing data
 class Profiler {
   public:
+    // Scope descriptors: every PROFILE_SCOPE site registers its name once (function-local static) and gets a ScopeId.
+    // Sites with the same name share an ID, so they aggregate together under a common parent.
+    using ScopeId = uint16_t;
+    static constexpr uint32_t MAX_SCOPES = 1024;
+    static constexpr ScopeId INVALID_SCOPE = 0xFFFF; // Registry full: the site is not profiled
+    // The category of the first registration is kept; it only labels the scope in trace dumps.
+    static ScopeId RegisterScope(const char* name, const char* category = nullptr);
+
+    // Call tree shared by all threads: one node per distinct (parent node, scope) pair, so identically named scopes
+    // under different parents stay apart. Nodes are created on first entry and never removed; node IDs index the flat
+    // aggregation arrays. Child lookups are lock-free, creating a node takes m_callTreeMutex.
+    static constexpr uint32_t MAX_CALL_NODES = 4096;
+    static constexpr uint32_t ROOT_CALL_NODE = 0; // Virtual root; also terminates sibling lists (it is nobody's child)
+
+    static constexpr int LATENCY_THRESHOLD_COUNT = 2;
+
     struct ProfileEntry {
-        std::string displayName; // Just the scope name for display
-        double totalTime = 0.0;  // Total accumulated time in milliseconds for current frame
-        double selfTime = 0.0;   // Time excluding children
-        int callCount = 0;       // Number of times called in current frame
+        double totalTime = 0.0; // Total accumulated time in milliseconds for current frame
+        double selfTime = 0.0;  // Time excluding children
+        int callCount = 0;      // Number of times called in current frame
 
         // Rolling average data
         double accumulatedTime = 0.0;
@@ -30,58 +53,76 @@ class Profiler {
         // Max time tracking
         double maxTimeInLastSecond = 0.0;
 
-        // Stale entry removal - time when entry was last updated with actual data
+        // Stale entry removal - time when entry was last updated with actual data (default: never)
         std::chrono::steady_clock::time_point lastUpdateTime{};
 
-        // Hierarchy support - using string paths
-        std::string parentPath;              // Parent scope path (empty for root)
-        std::vector<std::string> childPaths; // Child scope paths
-        int depth = 0;                       // Nesting depth (0 = root)
+        int depth = 0; // Nesting depth (0 = root), filled in for display
 
         // Percentages
         double parentPercentage = 0.0; // Percentage of parent's time
         double totalPercentage = 0.0;  // Percentage of total frame time
+
+        // Single-call latency distribution since the last histogram reset (milliseconds), filled in for display
+        uint64_t sampleCount = 0;
+        double p50Time = 0.0;
+        double p90Time = 0.0;
+        double p99Time = 0.0;
+        double p999Time = 0.0;
+        double maxTime = 0.0;
+        uint64_t callsAboveThreshold[LATENCY_THRESHOLD_COUNT] = {}; // See SetLatencyThresholds()
     };
 
-    // Minimal timing event for lock-free submission
-    struct TimingEvent {
-        const char* sectionName; // Static string (from PROFILE_SCOPE macro)
-        const char* parentName;  // Parent scope name (for hierarchy)
-        double durationMs;       // Duration in milliseconds
-        uint32_t threadId;       // Thread that generated this event
-        uint8_t depth;           // Stack depth when event was created
-        bool isRenderThread;     // Whether from render thread
+    // Scope begin/end record for lock-free submission (16 bytes). Timestamps are raw ReadClock() ticks; the
+    // processing side pairs begin and end records per thread and converts the difference to milliseconds.
+    struct TimingRecord {
+        uint64_t ticks; // ReadClock() timestamp
+        uint32_t node;  // Call tree node (scope + its parents)
+        uint32_t flags; // RECORD_* bits
     };
+    static constexpr uint32_t RECORD_END = 1u << 0;           // Scope end (otherwise begin)
+    static constexpr uint32_t RECORD_RENDER_THREAD = 1u << 1; // Recorded on the render thread
 
-    // Lock-free ring buffer for timing events (per-thread)
-    static constexpr size_t RING_BUFFER_SIZE = 4096; // Power of 2 for fast modulo
+    // Lock-free ring buffer for timing records (per-thread). Each scope takes two records, so a thread can record
+    // 8192 scopes per frame before it drops any.
+    static constexpr size_t RING_BUFFER_SIZE = 16384; // Must be a power of 2
+    static constexpr uint32_t MAX_SCOPE_DEPTH = 64;    // Deeper scopes are not recorded
 
     struct ThreadRingBuffer {
-        TimingEvent events[RING_BUFFER_SIZE];
-        std::atomic<size_t> writeIndex{ 0 }; // Only written by owning thread
-        std::atomic<size_t> readIndex{ 0 };  // Only written by processing thread
-        std::atomic<bool> isValid{ true };   // Set to false when thread exits
+        // Written only by the owning thread; drained by the processing thread (and Clear())
+        LockFreeRing<TimingRecord, RING_BUFFER_SIZE, RingProducers::Single, RingConsumers::Multi> events;
+        std::atomic<bool> isValid{ true }; // Set to false when thread exits
         bool isRenderThread = false;
         uint32_t threadId = 0;
-
-        // Scope stack for hierarchy tracking (thread-local, no sync needed)
-        std::vector<const char*> scopeStack;
+        std::atomic<const char*> threadName{ nullptr }; // Trace dump label (static string), see SetThreadName()
+
+        // Producer side: call tree nodes of the open scopes (owning thread only, fixed size - no heap)
+        uint32_t scopeStack[MAX_SCOPE_DEPTH] = {};
+        uint32_t scopeDepth = 0;
+
+        // Consumer side: begin records still waiting for their end record (processing thread only)
+        struct OpenScope {
+            uint32_t node;
+            uint64_t ticks;
+        };
+        OpenScope openScopes[MAX_SCOPE_DEPTH] = {};
+        uint32_t openScopeCount = 0;
+        uint32_t traceThread = UINT32_MAX; // Index into m_traceThreads, assigned on first drain
     };
 
     // RAII timing helper class - completely lock-free
     class ScopedTimer {
       public:
-        ScopedTimer(Profiler& profiler, const char* sectionName);
+        ScopedTimer(Profiler& profiler, ScopeId scope);
         ~ScopedTimer();
 
         ScopedTimer(const ScopedTimer&) = delete;
         ScopedTimer& operator=(const ScopedTimer&) = delete;
 
       private:
-        const char* m_sectionName;
-        std::chrono::high_resolution_clock::time_point m_startTime;
-        uint8_t m_depth;
-        bool m_active;
+        Profiler* m_profiler = nullptr;
+        ThreadRingBuffer* m_buffer = nullptr; // nullptr: scope not recorded
+        uint32_t m_node = ROOT_CALL_NODE;
+        uint64_t m_startTicks = 0;
     };
 
     static Profiler& GetInstance();
@@ -89,9 +130,15 @@ class Profiler {
 
     // Mark the current thread as the render thread
     void MarkAsRenderThread();
+    // Label the current thread in trace dumps. name must be a string literal (or otherwise outlive the profiler).
+    void SetThreadName(const char* name);
+
+    // Timestamp for scope records: RDTSC when the CPU has an invariant TSC, otherwise QueryPerformanceCounter
+    // (clock_gettime(CLOCK_MONOTONIC) off Windows). The tick rate is calibrated by the processing side.
+    uint64_t ReadClock() const { return m_useTsc ? ReadTsc() : ReadFallbackClock(); }
 
-    // Lock-free event submission (called from ScopedTimer destructor)
-    void SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth);
+    // Child of parent for scope, created on first use. ROOT_CALL_NODE if the tree is full.
+    uint32_t FindOrCreateCallNode(uint32_t parent, ScopeId scope);
 
     // Frame management
     void EndFrame();
@@ -100,13 +147,42 @@ class Profiler {
     void StartProcessingThread();
     void StopProcessingThread();
 
+    // Stops the processing thread and waits for a trace dump / histogram export still being written (DLL detach)
+    void Shutdown();
+
+    // Per-frame counters. The source returns a cumulative (monotonic) value; the profiler samples it
+    // once per EndFrame and reports the average increase per frame over each display interval.
+    struct CounterEntry {
+        std::string name;
+        std::string unit;
+        double perFrame = 0.0;
+    };
+    void RegisterCounter(const char* name, const char* unit, std::function<double()> sampleCumulative);
+
+    // Flight recorder: keeps the completed scopes of every thread plus a marker per EndFrame for the last `seconds`,
+    // and writes them as Chrome trace JSON (chrome://tracing, ui.perfetto.dev) to <toolscreen>/traces/ when a frame
+    // takes longer than hitchThresholdMs (0 = never) or after RequestTraceDump(). Needs the profiler enabled.
+    // Called every frame from the EndFrame thread; cheap when nothing changed.
+    void ConfigureFlightRecorder(bool enabled, int seconds, double hitchThresholdMs);
+    void RequestTraceDump() { m_traceDumpRequested.store(true, std::memory_order_release); } // Any thread
+
     // Get profiling data for display - returns two separate lists
     struct DisplayData {
         std::vector<std::pair<std::string, ProfileEntry>> renderThread;
         std::vector<std::pair<std::string, ProfileEntry>> otherThreads;
+        std::vector<CounterEntry> counters;
+        double latencyThresholdsMs[LATENCY_THRESHOLD_COUNT] = {};
     };
     DisplayData GetProfileData() const;
 
+    // Latency histograms: every call node keeps a LatencyHistogram of single-call durations per thread group (render
+    // / other) since the last reset. The histograms are owned by the EndFrame thread, so other threads only raise
+    // request flags; memory is fixed per call node and the call tree is bounded.
+    void SetLatencyThresholds(double firstMs, double secondMs); // EndFrame thread
+    void RequestHistogramReset() { m_histogramResetRequested.store(true, std::memory_order_release); }
+    // Writes percentiles per call path and per scope (all call sites merged) to <toolscreen>/traces/ as CSV
+    void RequestHistogramExport() { m_histogramExportRequested.store(true, std::memory_order_release); }
+
     // Legacy API for compatibility
     std::vector<std::pair<std::string, ProfileEntry>> GetProfileDataFlat() const;
 
@@ -117,16 +193,59 @@ class Profiler {
     void RegisterThreadBuffer(ThreadRingBuffer* buffer);
 
   private:
-    Profiler() = default;
+    Profiler();
     ~Profiler();
 
+    static uint64_t ReadFallbackClock();
+    void UpdateClockCalibration();
+    void ReportSlowScope(uint32_t node, uint64_t ticks) const;
+
+    // Clock (m_useTsc is fixed at construction, before any scope can read the clock)
+    bool m_useTsc = false;
+    uint64_t m_calibrationStartTicks = 0;
+    std::chrono::steady_clock::time_point m_calibrationStartTime;
+    bool m_clockCalibrated = false;                       // Rate frozen (TSC: after a few seconds; fallback: exact)
+    double m_msPerTick = 0.0;                             // Processing side only
+    std::atomic<double> m_msPerTickShared{ 0.0 };         // For slow-scope reports from producer threads
+    std::atomic<uint64_t> m_slowScopeTicks{ UINT64_MAX }; // Scopes longer than this are logged; max until calibrated
+
     std::atomic<bool> m_enabled{ false };
     std::atomic<bool> m_processingThreadRunning{ false };
     std::thread m_processingThread;
 
-    // Processed data (only accessed by processing thread and display)
-    std::unordered_map<std::string, ProfileEntry> m_renderThreadEntries;
-    std::unordered_map<std::string, ProfileEntry> m_otherThreadEntries;
+    // Scope registry (append-only; an entry is written before m_scopeCount publishes it)
+    std::mutex m_scopeRegistryMutex;
+    const char* m_scopeNames[MAX_SCOPES] = {};
+    const char* m_scopeCategories[MAX_SCOPES] = {};
+    std::atomic<uint32_t> m_scopeCount{ 0 };
+
+    // Call tree (append-only; a node is written before m_callNodeCount and its parent's firstChild publish it)
+    struct CallNode {
+        ScopeId scope = INVALID_SCOPE;
+        uint32_t parent = ROOT_CALL_NODE;
+        int depth = -1;                                     // -1 for the virtual root
+        uint32_t nextSibling = ROOT_CALL_NODE;              // Immutable once published
+        std::atomic<uint32_t> firstChild{ ROOT_CALL_NODE }; // Head of the child list; new children are prepended
+    };
+    std::mutex m_callTreeMutex;
+    CallNode m_callNodes[MAX_CALL_NODES];
+    std::atomic<uint32_t> m_callNodeCount{ 1 }; // Node 0 is the virtual root
+
+    // Processed data, indexed by call node (only accessed by processing thread and display)
+    std::vector<ProfileEntry> m_renderThreadEntries;
+    std::vector<ProfileEntry> m_otherThreadEntries;
+    std::vector<double> m_childTimeScratch;
+
+    // Latency histograms, indexed by call node like the entries (allocated on a node's first sample)
+    using HistogramList = std::vector<std::unique_ptr<LatencyHistogram>>;
+    HistogramList m_renderThreadHistograms;
+    HistogramList m_otherThreadHistograms;
+    double m_latencyThresholdsMs[LATENCY_THRESHOLD_COUNT] = { 1.0, 16.0 };
+    std::atomic<bool> m_histogramResetRequested{ false };
+    std::atomic<bool> m_histogramExportRequested{ false };
+
+    void FillLatencyStats(const HistogramList& histograms, std::vector<ProfileEntry>& entries) const;
+    void ExportHistograms();
 
     double m_totalRenderTime = 0.0;
     double m_totalOtherTime = 0.0;
@@ -145,17 +264,85 @@ class Profiler {
     std::atomic_flag m_registryLock = ATOMIC_FLAG_INIT;
     std::vector<ThreadRingBuffer*> m_threadRegistry;
 
+    struct CounterSource {
+        const char* name;
+        const char* unit;
+        std::function<double()> sample;
+        double lastValue = 0.0;
+        double accumulatedDelta = 0.0;
+        int frames = 0;
+        bool primed = false; // lastValue holds a sample from the previous frame
+    };
+    std::mutex m_counterMutex; // Registration vs EndFrame sampling (uncontended after startup)
+    std::vector<CounterSource> m_counters;
+    std::chrono::steady_clock::time_point m_lastCounterSampleTime{};
+
+    // Flight recorder (EndFrame thread only, except m_traceDumpRequested)
+    struct TraceEvent {
+        uint64_t beginTicks;
+        uint64_t endTicks;
+        uint32_t node;   // Call tree node, or ROOT_CALL_NODE for a frame marker (begin = previous frame end)
+        uint32_t thread; // Index into m_traceThreads
+    };
+    struct TraceThread {
+        uint32_t threadId;
+        const char* name;
+        bool isRenderThread;
+    };
+    static constexpr size_t TRACE_EVENTS_PER_SECOND = 32768; // Buffer capacity per second of history
+    bool m_flightRecorderEnabled = false;
+    int m_flightRecorderSeconds = 0;
+    double m_hitchThresholdMs = 0.0;
+    std::vector<TraceEvent> m_traceEvents; // Circular; sized while the recorder is enabled
+    size_t m_traceNext = 0;
+    bool m_traceWrapped = false;
+    std::vector<TraceThread> m_traceThreads;
+    uint64_t m_lastFrameTicks = 0;
+    uint64_t m_lastAutoDumpTicks = 0;
+    std::atomic<bool> m_traceDumpRequested{ false };
+
+    // Copied out of the recorder for the worker thread that writes the file
+    struct TraceDump {
+        std::vector<TraceEvent> events; // Oldest first
+        std::vector<TraceThread> threads;
+        double msPerTick = 0.0;
+        std::string reason;
+    };
+
+    uint32_t TraceThreadIndex(ThreadRingBuffer& buffer);
+    void RecordTraceEvent(const TraceEvent& event);
+    void RecordFrameMarker();
+    void DumpTrace(const std::string& reason);
+    void WriteTraceFile(const TraceDump& dump) const;
+
+    // Trace dumps and histogram exports are written on one joinable worker, at most one at a time.
+    // StartDiagnosticsWrite returns false (and drops write) while the previous one is still running.
+    bool IsDiagnosticsWriteInFlight() const { return m_diagnosticsWriteInFlight.load(std::memory_order_acquire); }
+    bool StartDiagnosticsWrite(std::function<void()> write);
+    void JoinDiagnosticsWriter();
+    std::mutex m_diagnosticsWriterMutex; // Guards m_diagnosticsWriter (EndFrame thread vs Shutdown)
+    std::thread m_diagnosticsWriter;
+    std::atomic<bool> m_diagnosticsWriteInFlight{ false };
+
+    void SampleCounters(std::chrono::steady_clock::time_point now);
+    void BuildCounterDisplay(std::vector<CounterEntry>& output);
+
     void ProcessingThreadMain();
     void ProcessEvents();
-    void CalculateHierarchy(std::unordered_map<std::string, ProfileEntry>& entries, double totalTime);
-    void BuildDisplayTree(const std::unordered_map<std::string, ProfileEntry>& entries,
-                          std::vector<std::pair<std::string, ProfileEntry>>& output);
+    void CalculateHierarchy(std::vector<ProfileEntry>& entries, double& totalTime);
+    void BuildDisplayTree(const std::vector<ProfileEntry>& entries, std::vector<std::pair<std::string, ProfileEntry>>& output);
 };
 
-// Convenience macros - completely lock-free on hot path
-#define PROFILE_SCOPE(name) Profiler::ScopedTimer _profiler_timer_##__LINE__(Profiler::GetInstance(), name)
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+// Convenience macros - completely lock-free on hot path (the scope is registered once per site)
+#define PROFILE_SCOPE(name)                                                                                                    \
+    PROFILE_SCOPE_CAT(name, nullptr)
 
-// Category macro is now an alias (category becomes parent override if needed in future)
-#define PROFILE_SCOPE_CAT(name, category) PROFILE_SCOPE(name)
+// The category only labels the scope in trace dumps; aggregation is by call tree position
+#define PROFILE_SCOPE_CAT(name, category)                                                                                      \
+    static const Profiler::ScopeId PROFILER_CONCAT(_profiler_scope_, __LINE__) = Profiler::RegisterScope(name, category);    \
+    Profiler::ScopedTimer PROFILER_CONCAT(_profiler_timer_, __LINE__)(Profiler::GetInstance(), PROFILER_CONCAT(_profiler_scope_, __LINE__))
 
 #define PROFILE_START(name) /* deprecated - use PROFILE_SCOPE */
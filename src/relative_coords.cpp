@@ -0,0 +1,91 @@
+// ============================================================================
+// RELATIVE_COORDS.CPP - Anchor resolution
+// ============================================================================
+
+#include "relative_coords.h"
+
+void GetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX, int& outY) {
+    // Strip Viewport/Screen suffix if present to get base anchor name
+    std::string anchor = type;
+    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") {
+        anchor = anchor.substr(0, anchor.length() - 8);
+    } else if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
+        anchor = anchor.substr(0, anchor.length() - 6);
+    }
+
+    // Optimize by checking first character to reduce string comparisons
+    char firstChar = anchor.empty() ? '\0' : anchor[0];
+
+    if (firstChar == 't') { // "topLeft" or "topRight"
+        outY = relY;
+        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
+    } else if (firstChar == 'c') { // "center"
+        outX = (containerW - w) / 2 + relX;
+        outY = (containerH - h) / 2 + relY;
+    } else if (firstChar == 'p') { // "pieLeft" or "pieRight"
+        const int PIE_Y_TOP = 220, PIE_X_LEFT = 92, PIE_X_RIGHT = 36;
+        int base_x = (anchor == "pieLeft") ? containerW - PIE_X_LEFT : containerW - PIE_X_RIGHT;
+        outX = base_x + relX;
+        outY = containerH - PIE_Y_TOP + relY;
+    } else { // "bottomLeft" or "bottomRight"
+        outY = containerH - h - relY;
+        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
+    }
+}
+
+void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
+                               int& outY) {
+    int anchor_x = 0, anchor_y = 0;
+    // Optimize by checking first character to reduce string comparisons
+    char firstChar = type.empty() ? '\0' : type[0];
+
+    if (firstChar == 't') { // "topLeft" or "topRight"
+        anchor_x = (type == "topLeft") ? 0 : containerW - w;
+        anchor_y = 0;
+    } else if (firstChar == 'c') { // "center"
+        anchor_x = (containerW - w) / 2;
+        anchor_y = (containerH - h) / 2;
+    } else if (firstChar == 'b') { // "bottomLeft" or "bottomRight"
+        anchor_x = (type == "bottomLeft") ? 0 : containerW - w;
+        anchor_y = containerH - h;
+    }
+
+    outX = anchor_x + relX;
+    outY = anchor_y + relY;
+}
+
+// Get relative coordinates with viewport-aware positioning
+// For "Viewport" suffixed types: position relative to game viewport (animates with game)
+// For "Screen" suffixed types: position relative to screen (does not animate)
+void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
+                                           int gameH, int fullW, int fullH, int& outX, int& outY) {
+    // Check if this is a viewport-relative anchor (ends with "Viewport")
+    if (type.length() > 8 && type.substr(type.length() - 8) == "Viewport") {
+        // Strip the "Viewport" suffix to get the base anchor name
+        std::string baseAnchor = type.substr(0, type.length() - 8);
+
+        // Calculate position relative to game viewport
+        int anchor_x = 0, anchor_y = 0;
+        char firstChar = baseAnchor.empty() ? '\0' : baseAnchor[0];
+
+        if (firstChar == 't') { // "topLeft" or "topRight"
+            anchor_x = (baseAnchor == "topLeft") ? 0 : gameW - w;
+            anchor_y = 0;
+        } else if (firstChar == 'c') { // "center"
+            anchor_x = (gameW - w) / 2;
+            anchor_y = (gameH - h) / 2;
+        } else if (firstChar == 'b') { // "bottomLeft" or "bottomRight"
+            anchor_x = (baseAnchor == "bottomLeft") ? 0 : gameW - w;
+            anchor_y = gameH - h;
+        }
+
+        // Position is relative to game viewport origin
+        outX = gameX + anchor_x + relX;
+        outY = gameY + anchor_y + relY;
+    } else {
+        // Screen-relative: strip "Screen" suffix if present and use screen dimensions
+        std::string baseAnchor = type;
+        if (type.length() > 6 && type.substr(type.length() - 6) == "Screen") { baseAnchor = type.substr(0, type.length() - 6); }
+        GetRelativeCoordsForImage(baseAnchor, relX, relY, w, h, fullW, fullH, outX, outY);
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// ============================================================================
+// RELATIVE_COORDS.H - Anchor-relative positioning (mirrors, images, overlays)
+// ============================================================================
+// Anchors are names like "topLeft", "center" or "pieRight", optionally with a
+// "Viewport" or "Screen" suffix. Pure integer math, no Win32 or GL.
+// ============================================================================
+
+#include <string>
+
+void GetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX, int& outY);
+void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
+                               int& outY);
+// Overload that supports viewport-relative positioning (for anchors ending with "Viewport")
+// gameX/Y/W/H = current game viewport position on screen (may be animated)
+// fullW/H = screen dimensions
+void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
+                                           int gameH, int fullW, int fullH, int& outX, int& outY);
+
+// Check if an anchor type is viewport-relative (positions relative to game viewport, animates during transitions)
+inline bool IsViewportRelativeAnchor(const std::string& relativeTo) {
+    // Viewport-relative anchors end with "Viewport"
+    if (relativeTo.length() > 8 && relativeTo.substr(relativeTo.length() - 8) == "Viewport") { return true; }
+    return false;
+}
@@ -1,4 +1,5 @@
 #include "render.h"
+#include "config_diff.h"
 #include "fake_cursor.h"
 #include "gui.h"
 #include "logic_thread.h"
@@ -16,52 +17,6 @@
 #include <shared_mutex>
 #include <unordered_map>
 
-// These caches provide O(1) lookup instead of O(n) linear search for active element collection
-static std::unordered_map<std::string, size_t> s_mirrorLookupCache;
-static std::unordered_map<std::string, size_t> s_imageLookupCache;
-static std::unordered_map<std::string, size_t> s_windowOverlayLookupCache;
-static std::atomic<uint64_t> s_configCacheVersion{ 0 };
-static uint64_t s_lastCacheRebuildVersion = 0;
-static std::mutex s_lookupCacheMutex;
-
-// Rebuild lookup caches when config changes
-static void RebuildConfigLookupCaches() {
-    s_mirrorLookupCache.clear();
-    s_imageLookupCache.clear();
-    s_windowOverlayLookupCache.clear();
-
-    s_mirrorLookupCache.reserve(g_config.mirrors.size());
-    for (size_t i = 0; i < g_config.mirrors.size(); ++i) { s_mirrorLookupCache[g_config.mirrors[i].name] = i; }
-
-    s_imageLookupCache.reserve(g_config.images.size());
-    for (size_t i = 0; i < g_config.images.size(); ++i) { s_imageLookupCache[g_config.images[i].name] = i; }
-
-    s_windowOverlayLookupCache.reserve(g_config.windowOverlays.size());
-    for (size_t i = 0; i < g_config.windowOverlays.size(); ++i) { s_windowOverlayLookupCache[g_config.windowOverlays[i].name] = i; }
-}
-
-// Invalidate lookup caches (call when config changes)
-void InvalidateConfigLookupCaches() { s_configCacheVersion.fetch_add(1, std::memory_order_release); }
-
-// Ensure caches are up to date (call at start of render)
-static void EnsureConfigCachesValid() {
-    uint64_t currentVersion = s_configCacheVersion.load(std::memory_order_acquire);
-    // Also check g_configIsDirty - if config was modified via GUI, we need to rebuild caches
-    if (g_configIsDirty) {
-        InvalidateConfigLookupCaches();
-        currentVersion = s_configCacheVersion.load(std::memory_order_acquire);
-    }
-    if (currentVersion != s_lastCacheRebuildVersion) {
-        std::lock_guard<std::mutex> lock(s_lookupCacheMutex);
-        // Double-check after acquiring lock
-        currentVersion = s_configCacheVersion.load(std::memory_order_acquire);
-        if (currentVersion != s_lastCacheRebuildVersion) {
-            RebuildConfigLookupCaches();
-            s_lastCacheRebuildVersion = currentVersion;
-        }
-    }
-}
-
 // External OBS detection state from dllmain.cpp
 extern std::atomic<bool> g_graphicsHookDetected;
 
@@ -921,6 +876,85 @@ void DiscardAllGPUImages() {
     Log("All background and user image textures have been queued for deletion.");
 }
 
+// Queues one image instance's textures (all frames if animated) for deletion
+template <typename Instance> static void CollectInstanceTextures(const Instance& inst, std::vector<GLuint>& out) {
+    if (inst.isAnimated) {
+        for (GLuint tex : inst.frameTextures) {
+            if (tex != 0) out.push_back(tex);
+        }
+    } else if (inst.textureId != 0) {
+        out.push_back(inst.textureId);
+    }
+}
+
+template <typename Instance>
+static void DiscardImageInstance(std::unordered_map<std::string, Instance>& instances, std::mutex& mutex, const std::string& id,
+                                 std::vector<GLuint>& texturesToDelete) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = instances.find(id);
+    if (it == instances.end()) return;
+    CollectInstanceTextures(it->second, texturesToDelete);
+    instances.erase(it);
+}
+
+static ConfigChangeTracker s_gpuResourceTracker;
+
+void SyncConfigResources() {
+    std::shared_ptr<const Config> cfgSnap;
+    ConfigChangeSet changes;
+    if (!s_gpuResourceTracker.Poll(cfgSnap, changes)) return;
+    PROFILE_SCOPE_CAT("Config Resource Sync", "GPU Operations");
+    const Config& cfg = *cfgSnap;
+
+    std::vector<GLuint> texturesToDelete;
+
+    // Mirrors: FBOs for new mirrors. Capture size changes are handled by the mirror thread (it resizes on its own), and
+    // removed mirrors keep their instance: the capture thread may still be mid-frame on it, and a re-added mirror reuses it.
+    for (const auto& change : changes.mirrors) {
+        if (change.kind == ConfigChangeKind::Removed) continue;
+        const bool needsInstance = change.kind == ConfigChangeKind::Added || (change.fields & MIRROR_CHANGE_CAPTURE);
+        if (!needsInstance) continue;
+        const MirrorConfig* mirror = GetMirrorFromSnapshot(cfg, change.name);
+        if (mirror) CreateMirrorGPUResources(*mirror); // No-op if the instance exists
+    }
+
+    // User images: decode again only when the file changed
+    for (const auto& change : changes.images) {
+        if (change.kind == ConfigChangeKind::Removed) {
+            DiscardImageInstance(g_userImages, g_userImagesMutex, change.name, texturesToDelete);
+            continue;
+        }
+        if (!(change.fields & IMAGE_CHANGE_SOURCE)) continue;
+        const ImageConfig* image = GetImageFromSnapshot(cfg, change.name);
+        // Half-typed paths are skipped; the old texture stays until the path names a real file
+        if (image && ImageFileExists(image->path, g_toolscreenPath)) {
+            LoadImageAsync(DecodedImageData::Type::UserImage, image->name, image->path, g_toolscreenPath);
+        }
+    }
+
+    // Mode background images
+    for (const auto& change : changes.modes) {
+        if (change.kind == ConfigChangeKind::Removed) {
+            DiscardImageInstance(g_backgroundTextures, g_backgroundTexturesMutex, change.name, texturesToDelete);
+            continue;
+        }
+        if (!(change.fields & MODE_CHANGE_BACKGROUND_SOURCE)) continue;
+        const ModeConfig* mode = GetModeFromSnapshot(cfg, change.name);
+        if (!mode) continue;
+        if (mode->background.selectedMode != "image") {
+            DiscardImageInstance(g_backgroundTextures, g_backgroundTexturesMutex, mode->id, texturesToDelete);
+        } else if (ImageFileExists(mode->background.image, g_toolscreenPath)) {
+            LoadImageAsync(DecodedImageData::Type::Background, mode->id, mode->background.image, g_toolscreenPath);
+        }
+    }
+
+    if (!texturesToDelete.empty()) {
+        std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
+        g_texturesToDelete.insert(g_texturesToDelete.end(), texturesToDelete.begin(), texturesToDelete.end());
+        g_hasTexturesToDelete.store(true, std::memory_order_release);
+    }
+}
+
 void SaveGLState(GLState* s) {
     // Core bindings
     glGetIntegerv(GL_CURRENT_PROGRAM, &s->p);
@@ -1415,8 +1449,8 @@ void InitializeGPUResources() {
     std::vector<MirrorConfig> mirrorsToCreate;
     {
         auto initSnap = GetConfigSnapshot();
-        if (initSnap) { mirrorsToCreate = initSnap->mirrors; }
-        LogCategory("init", "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
+        if (initSnap) { mirrorsToCreate = initSnap->mirrors.ToVector(); }
+        LogCategory(LogCat::Init, "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
     }
     // Release the framebuffer binding before calling CreateMirrorGPUResources
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
@@ -1468,7 +1502,7 @@ void InitializeGPUResources() {
 
     glBindVertexArray(0);
 
-    LogCategory("init", "Restoring original OpenGL state...");
+    LogCategory(LogCat::Init, "Restoring original OpenGL state...");
     glUseProgram(last_program);
     glActiveTexture(last_active_texture);
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -1477,7 +1511,7 @@ void InitializeGPUResources() {
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
 
     g_glInitialized = true;
-    LogCategory("init", "--- GPU resources initialized successfully. ---");
+    LogCategory(LogCat::Init, "--- GPU resources initialized successfully. ---");
 }
 
 void CreateMirrorGPUResources(const MirrorConfig& conf) {
@@ -1551,9 +1585,9 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
         inst.capturedAsRawOutput = conf.rawOutput;
         inst.capturedAsRawOutputBack = conf.rawOutput;
         g_mirrorInstances[conf.name] = inst;
-        LogCategory("init", "Created double-buffered GPU resources for mirror '" + conf.name + "' (FBO: " + std::to_string(inst.fbo) +
-                                ", Back: " + std::to_string(inst.fboBack) + ", FinalFBO: " + std::to_string(inst.finalFbo) + " [" +
-                                std::to_string(inst.final_w) + "x" + std::to_string(inst.final_h) + "])");
+        LogCategory(LogCat::Init, "Created double-buffered GPU resources for mirror '" + conf.name + "' (FBO: " + std::to_string(inst.fbo) +
+                                      ", Back: " + std::to_string(inst.fboBack) + ", FinalFBO: " + std::to_string(inst.finalFbo) + " [" +
+                                      std::to_string(inst.final_w) + "x" + std::to_string(inst.final_h) + "])");
     } else {
         Log("ERROR: Failed to create complete framebuffers for mirror '" + conf.name + "'");
         // Clean up failed resources
@@ -2153,9 +2187,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
         // Determine Fullscreen transition cases
         // Use fromModeId from transitionState (atomically read from snapshot) to avoid race conditions
-        std::string fromModeId = transitionState.fromModeId;
+        const ModeHandle fromModeId = transitionState.fromModeId;
         bool transitioningToFullscreen = isAnimating && EqualsIgnoreCase(modeToRender->id, "Fullscreen");
-        bool transitioningFromFullscreen = isAnimating && !fromModeId.empty() && EqualsIgnoreCase(fromModeId, "Fullscreen");
+        bool transitioningFromFullscreen =
+            isAnimating && fromModeId != NO_MODE_HANDLE && ModeHandlesEqual(fromModeId, FullscreenModeHandle());
 
         // Get from mode's background config if transitioning TO Fullscreen
         // (Fullscreen has no background, so keep showing from-mode's background)
@@ -2166,8 +2201,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         GLuint fromBgTex = 0;
         bool useFromBackground = false; // True if we should use from-mode's background instead of to-mode's
 
-        if (isAnimating && !fromModeId.empty()) {
-            const ModeConfig* fromMode = GetMode_Internal(fromModeId);
+        if (isAnimating && fromModeId != NO_MODE_HANDLE) {
+            const ModeConfig* fromMode = configSnap ? GetModeFromSnapshot(*configSnap, fromModeId) : nullptr;
             if (fromMode) {
                 fromBackground = fromMode->background;
                 fromBorder = fromMode->border;
@@ -2181,7 +2216,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             if (useFromBackground) {
                 // Get the from mode's background texture (and update animation if needed)
                 std::lock_guard<std::mutex> bgLock(g_backgroundTexturesMutex);
-                auto fromBgTexIt = g_backgroundTextures.find(fromModeId);
+                auto fromBgTexIt = g_backgroundTextures.find(ModeIdName(fromModeId));
                 if (fromBgTexIt != g_backgroundTextures.end()) {
                     BackgroundTextureInstance& bgInst = fromBgTexIt->second;
                     // Advance animation frame if animated - using time-based approach for smooth playback
@@ -2544,33 +2579,20 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
             // Collect active mirrors for fallback rendering (use snapshot for thread safety)
             std::vector<MirrorConfig> fallbackMirrors;
-            const auto& fbMirrors = configSnap ? configSnap->mirrors : g_config.mirrors; // snapshot preferred
-            const auto& fbGroups = configSnap ? configSnap->mirrorGroups : g_config.mirrorGroups;
-            fallbackMirrors.reserve(modeToRender->mirrorIds.size() + modeToRender->mirrorGroupIds.size());
-
-            // Build O(1) lookup maps to avoid O(n²) nested loops
-            std::unordered_map<std::string, size_t> mirrorIndex;
-            mirrorIndex.reserve(fbMirrors.size());
-            for (size_t i = 0; i < fbMirrors.size(); ++i) { mirrorIndex[fbMirrors[i].name] = i; }
-            std::unordered_map<std::string, size_t> groupIndex;
-            groupIndex.reserve(fbGroups.size());
-            for (size_t i = 0; i < fbGroups.size(); ++i) { groupIndex[fbGroups[i].name] = i; }
-
-            for (const auto& name : modeToRender->mirrorIds) {
-                auto it = mirrorIndex.find(name);
-                if (it != mirrorIndex.end()) {
-                    fallbackMirrors.push_back(fbMirrors[it->second]);
-                }
+            const Config& fbCfg = configSnap ? *configSnap : g_config; // snapshot preferred
+            fallbackMirrors.reserve(modeToRender->mirrorHandles.size() + modeToRender->mirrorGroupHandles.size());
+
+            // Handle lookups through the snapshot's indexes (modeToRender comes from the frame's snapshot, so it carries handles)
+            for (ElementHandle mirrorHandle : modeToRender->mirrorHandles) {
+                if (const MirrorConfig* mirror = GetMirrorFromSnapshot(fbCfg, mirrorHandle)) { fallbackMirrors.push_back(*mirror); }
             }
-            for (const auto& groupName : modeToRender->mirrorGroupIds) {
-                auto git = groupIndex.find(groupName);
-                if (git != groupIndex.end()) {
-                    const auto& group = fbGroups[git->second];
+            for (ElementHandle groupHandle : modeToRender->mirrorGroupHandles) {
+                if (const MirrorGroupConfig* groupPtr = GetMirrorGroupFromSnapshot(fbCfg, groupHandle)) {
+                    const auto& group = *groupPtr;
                     for (const auto& item : group.mirrors) {
                         if (!item.enabled) continue; // Skip disabled items
-                        auto mit = mirrorIndex.find(item.mirrorId);
-                        if (mit != mirrorIndex.end()) {
-                            const auto& mirror = fbMirrors[mit->second];
+                        if (const MirrorConfig* mirrorPtr = GetMirrorFromSnapshot(fbCfg, item.mirrorHandle)) {
+                            const auto& mirror = *mirrorPtr;
                             MirrorConfig groupedMirror = mirror;
                             // Calculate group position - use relative percentages if enabled
                             int groupX = group.output.x;
@@ -2758,31 +2780,9 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
                     // Check which image is under the mouse cursor (use snapshot for safe iteration)
                     std::string hoveredImage = "";
-                    const auto& dragImages = configSnap ? configSnap->images : std::vector<ImageConfig>{};
-
-                    // PERF: Avoid O(n^2) lookups (mode imageIds * total images) during hover detection.
-                    // Drag mode is rare, but this is on the game thread, so keep it cheap.
-                    std::unordered_map<std::string, const ImageConfig*> imageByName;
-                    if (configSnap) {
-                        imageByName.reserve(dragImages.size());
-                        for (const auto& img : dragImages) {
-                            imageByName.emplace(img.name, &img);
-                        }
-                    }
-                    for (const auto& imageName : modeToRender->imageIds) {
-                        // Look up image config by name from snapshot
-                        const ImageConfig* confPtr = nullptr;
-                        if (!imageByName.empty()) {
-                            auto it = imageByName.find(imageName);
-                            if (it != imageByName.end()) { confPtr = it->second; }
-                        } else {
-                            for (const auto& img : dragImages) {
-                                if (img.name == imageName) {
-                                    confPtr = &img;
-                                    break;
-                                }
-                            }
-                        }
+                    for (ElementHandle imageHandle : modeToRender->imageHandles) {
+                        // Array read through the snapshot's handle index - this is the game thread, keep hover detection cheap
+                        const ImageConfig* confPtr = configSnap ? GetImageFromSnapshot(*configSnap, imageHandle) : nullptr;
                         if (!confPtr) continue;
                         const ImageConfig& conf = *confPtr;
 
@@ -2911,22 +2911,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                             hoveredOverlay = ""; // Build list of active window overlays with their configs
                             std::vector<const WindowOverlayConfig*> activeOverlays;
 
-                            // PERF: Avoid O(n^2) scans (mode overlay IDs * total overlays in config).
-                            std::unordered_map<std::string, const WindowOverlayConfig*> overlayByName;
-                            if (configSnap) {
-                                overlayByName.reserve(configSnap->windowOverlays.size());
-                                for (const auto& ov : configSnap->windowOverlays) {
-                                    overlayByName.emplace(ov.name, &ov);
-                                }
-                            }
-                            for (const auto& overlayId : modeToRender->windowOverlayIds) {
-                                const WindowOverlayConfig* config = nullptr;
-                                if (!overlayByName.empty()) {
-                                    auto it = overlayByName.find(overlayId);
-                                    if (it != overlayByName.end()) { config = it->second; }
-                                } else {
-                                    config = configSnap ? FindWindowOverlayConfigIn(overlayId, *configSnap) : nullptr;
-                                }
+                            for (ElementHandle overlayHandle : modeToRender->windowOverlayHandles) {
+                                // Array read through the snapshot's handle index
+                                const WindowOverlayConfig* config =
+                                    configSnap ? GetWindowOverlayFromSnapshot(*configSnap, overlayHandle) : nullptr;
                                 if (config) { activeOverlays.push_back(config); }
                             }
 
@@ -2962,14 +2950,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         s_lastMousePos = mousePos;
 
                         // Read initial position from snapshot for thread safety
-                        if (configSnap) {
-                            for (const auto& overlay : configSnap->windowOverlays) {
-                                if (overlay.name == s_draggedWindowOverlayName) {
-                                    s_initialX = overlay.x;
-                                    s_initialY = overlay.y;
-                                    break;
-                                }
-                            }
+                        if (const WindowOverlayConfig* overlay =
+                                configSnap ? GetWindowOverlayFromSnapshot(*configSnap, s_draggedWindowOverlayName) : nullptr) {
+                            s_initialX = overlay->x;
+                            s_initialY = overlay->y;
                         }
                     }
                     // Handle dragging
@@ -3077,7 +3061,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             request.finalW = currentGeo.finalW;
             request.finalH = currentGeo.finalH;
             request.gameTextureId = gameTextureToUse;
-            request.modeId = modeToRender->id;
+            request.modeId = modeToRender->handle;
             request.isAnimating = isAnimating;
             request.overlayOpacity = overlayOpacity;
             request.obsDetected = g_graphicsHookDetected.load();
@@ -3156,8 +3140,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             // Transition-related background/border (for transitioning TO Fullscreen)
             request.transitioningToFullscreen = isAnimating && EqualsIgnoreCase(modeToRender->id, "Fullscreen");
             request.fromModeId = transitionState.fromModeId;
-            if (!transitionState.fromModeId.empty()) {
-                const ModeConfig* fromMode = GetMode_Internal(transitionState.fromModeId);
+            if (transitionState.fromModeId != NO_MODE_HANDLE) {
+                const ModeConfig* fromMode = configSnap ? GetModeFromSnapshot(*configSnap, transitionState.fromModeId) : nullptr;
                 if (fromMode) {
                     request.fromSlideMirrorsIn = fromMode->slideMirrorsIn;
                     if (request.transitioningToFullscreen) {
@@ -3733,11 +3717,47 @@ static float CalculateBounceOffset(float bounceProgress, int bounceIndex, int to
     return bounce;
 }
 
+// Copies g_modeTransition into the lock-free snapshot. Requires g_modeTransitionMutex.
+static ViewportTransitionSnapshot PublishViewportTransitionSnapshot() {
+    ViewportTransitionSnapshot snapshot;
+    snapshot.active = g_modeTransition.active;
+    snapshot.isBounceTransition = (g_modeTransition.gameTransition == GameTransitionType::Bounce);
+    snapshot.fromModeId = g_modeTransition.fromModeId;
+    snapshot.toModeId = g_modeTransition.toModeId;
+    snapshot.fromWidth = g_modeTransition.fromWidth;
+    snapshot.fromHeight = g_modeTransition.fromHeight;
+    snapshot.fromX = g_modeTransition.fromX;
+    snapshot.fromY = g_modeTransition.fromY;
+    snapshot.currentX = g_modeTransition.currentX;
+    snapshot.currentY = g_modeTransition.currentY;
+    snapshot.currentWidth = g_modeTransition.currentWidth;
+    snapshot.currentHeight = g_modeTransition.currentHeight;
+    snapshot.toX = g_modeTransition.toX;
+    snapshot.toY = g_modeTransition.toY;
+    snapshot.toWidth = g_modeTransition.toWidth;
+    snapshot.toHeight = g_modeTransition.toHeight;
+    // Native dimensions for viewport matching
+    snapshot.fromNativeWidth = g_modeTransition.fromNativeWidth;
+    snapshot.fromNativeHeight = g_modeTransition.fromNativeHeight;
+    snapshot.toNativeWidth = g_modeTransition.toNativeWidth;
+    snapshot.toNativeHeight = g_modeTransition.toNativeHeight;
+    // New fields for GetModeTransitionState
+    snapshot.gameTransition = g_modeTransition.gameTransition;
+    snapshot.overlayTransition = g_modeTransition.overlayTransition;
+    snapshot.backgroundTransition = g_modeTransition.backgroundTransition;
+    snapshot.progress = g_modeTransition.progress;
+    snapshot.moveProgress = g_modeTransition.moveProgress;
+    // Fade duration fields removed - overlay/background transitions are always Cut
+    snapshot.startTime = g_modeTransition.startTime;
+    g_viewportTransitionSnapshot.Publish(snapshot);
+    return snapshot;
+}
+
 void StartModeTransition(const std::string& fromModeId, const std::string& toModeId, int fromWidth, int fromHeight, int fromX, int fromY,
                          int toWidth, int toHeight, int toX, int toY, const ModeConfig& toMode) {
-    LogCategory("animation", "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
+    LogCategory(LogCat::Animation, "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
     std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    LogCategory("animation", "[ANIMATION] g_modeTransitionMutex acquired");
+    LogCategory(LogCat::Animation, "[ANIMATION] g_modeTransitionMutex acquired");
 
     // Handle Cut/Cut/Cut transition - needs first-frame protection to prevent black flash
     // EXCEPTION: When transitioning TO Fullscreen, we ALWAYS need to animate to keep the from-mode's
@@ -3754,7 +3774,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
                               toMode.backgroundTransition == BackgroundTransitionType::Cut;
 
     if (isAllCutTransition && !transitioningToFullscreen) {
-        LogCategory("animation", "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
+        LogCategory(LogCat::Animation, "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
     }
 
     g_modeTransition.active = true;
@@ -3801,13 +3821,13 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         g_modeTransition.skipAnimateY = toMode.skipAnimateY;
     }
 
-    g_modeTransition.fromModeId = fromModeId;
+    g_modeTransition.fromModeId = InternModeId(fromModeId);
     g_modeTransition.fromWidth = fromWidth;
     g_modeTransition.fromHeight = fromHeight;
     g_modeTransition.fromX = fromX;
     g_modeTransition.fromY = fromY;
 
-    g_modeTransition.toModeId = toModeId;
+    g_modeTransition.toModeId = InternModeId(toModeId);
     g_modeTransition.toWidth = toWidth;
     g_modeTransition.toHeight = toHeight;
     g_modeTransition.toX = toX;
@@ -3854,7 +3874,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
     // This freezes the EyeZoom snapshot immediately so it's captured before the game texture resizes
     if (transitioningFromEyeZoom && !transitioningToEyeZoom) {
         g_isTransitioningFromEyeZoom.store(true, std::memory_order_release);
-        LogCategory("animation", "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
+        LogCategory(LogCat::Animation, "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
     } else {
         g_isTransitioningFromEyeZoom.store(false, std::memory_order_release);
     }
@@ -3870,52 +3890,20 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         g_modeTransition.wmSizeSent = true;
         g_modeTransition.lastSentWidth = wmWidth;
         g_modeTransition.lastSentHeight = wmHeight;
-        LogCategory("animation", "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
+        LOG_FMT_CAT(LogCat::Animation, "[ANIMATION] WM_SIZE sent immediately: {}x{}", wmWidth, wmHeight);
     }
 
-    LogCategory("animation", "[ANIMATION] Starting mode transition (Game:" + GameTransitionTypeToString(toMode.gameTransition) +
-                                 ", Overlay:" + OverlayTransitionTypeToString(toMode.overlayTransition) +
-                                 ", Bg:" + BackgroundTransitionTypeToString(toMode.backgroundTransition) + ", " +
-                                 std::to_string(toMode.transitionDurationMs) + "ms): " + fromModeId + " (" + std::to_string(fromWidth) +
-                                 "x" + std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY) + ")" +
-                                 " -> " + toModeId + " (" + std::to_string(toWidth) + "x" + std::to_string(toHeight) + " at " +
-                                 std::to_string(toX) + "," + std::to_string(toY) + ")");
+    LOG_FMT_CAT(LogCat::Animation,
+                "[ANIMATION] Starting mode transition (Game:{}, Overlay:{}, Bg:{}, {}ms): {} ({}x{} at {},{}) -> {} ({}x{} at {},{})",
+                GameTransitionTypeToString(toMode.gameTransition), OverlayTransitionTypeToString(toMode.overlayTransition),
+                BackgroundTransitionTypeToString(toMode.backgroundTransition), toMode.transitionDurationMs, fromModeId, fromWidth,
+                fromHeight, fromX, fromY, toModeId, toWidth, toHeight, toX, toY);
 
     // Update lock-free snapshot for viewport hook and GetModeTransitionState (done inside the lock)
-    int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
-    ViewportTransitionSnapshot& snapshot = g_viewportTransitionSnapshots[nextSnapshotIndex];
-    snapshot.active = g_modeTransition.active;
-    snapshot.isBounceTransition = (g_modeTransition.gameTransition == GameTransitionType::Bounce);
-    snapshot.fromModeId = g_modeTransition.fromModeId;
-    snapshot.toModeId = g_modeTransition.toModeId;
-    snapshot.fromWidth = g_modeTransition.fromWidth;
-    snapshot.fromHeight = g_modeTransition.fromHeight;
-    snapshot.fromX = g_modeTransition.fromX;
-    snapshot.fromY = g_modeTransition.fromY;
-    snapshot.currentX = g_modeTransition.currentX;
-    snapshot.currentY = g_modeTransition.currentY;
-    snapshot.currentWidth = g_modeTransition.currentWidth;
-    snapshot.currentHeight = g_modeTransition.currentHeight;
-    snapshot.toX = g_modeTransition.toX;
-    snapshot.toY = g_modeTransition.toY;
-    snapshot.toWidth = g_modeTransition.toWidth;
-    snapshot.toHeight = g_modeTransition.toHeight;
-    // Native dimensions for viewport matching
-    snapshot.fromNativeWidth = g_modeTransition.fromNativeWidth;
-    snapshot.fromNativeHeight = g_modeTransition.fromNativeHeight;
-    snapshot.toNativeWidth = g_modeTransition.toNativeWidth;
-    snapshot.toNativeHeight = g_modeTransition.toNativeHeight;
-    // New fields for GetModeTransitionState
-    snapshot.gameTransition = g_modeTransition.gameTransition;
-    snapshot.overlayTransition = g_modeTransition.overlayTransition;
-    snapshot.backgroundTransition = g_modeTransition.backgroundTransition;
-    snapshot.progress = g_modeTransition.progress;
-    snapshot.moveProgress = g_modeTransition.moveProgress;
-    // Fade duration fields removed - overlay/background transitions are always Cut
-    snapshot.startTime = g_modeTransition.startTime;
-    g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
+    PublishViewportTransitionSnapshot();
+    RefreshEffectiveMouseSensitivity(); // Sensitivity follows the transition target
 
-    LogCategory("animation", "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
+    LogCategory(LogCat::Animation, "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
 }
 
 void UpdateModeTransition() {
@@ -4064,9 +4052,9 @@ void UpdateModeTransition() {
     bool allComplete = (elapsed >= totalDuration);
 
     if (allComplete) {
-        LogCategory("animation", "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
-                                     std::to_string(g_modeTransition.toWidth) + "x" + std::to_string(g_modeTransition.toHeight) + " at " +
-                                     std::to_string(g_modeTransition.toX) + "," + std::to_string(g_modeTransition.toY) + ")");
+        LOG_FMT_CAT(LogCat::Animation, "[ANIMATION] Mode transition complete: {} (final stretch: {}x{} at {},{})",
+                    ModeIdName(g_modeTransition.toModeId), g_modeTransition.toWidth, g_modeTransition.toHeight, g_modeTransition.toX,
+                    g_modeTransition.toY);
 
         // Ensure current values are exactly at target before deactivating to prevent
         // any stale bounce values from being read in the brief window before deactivation
@@ -4080,38 +4068,10 @@ void UpdateModeTransition() {
     }
 
     // Update lock-free snapshot for viewport hook and GetModeTransitionState (done inside the lock)
-    int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
-    ViewportTransitionSnapshot& snapshot = g_viewportTransitionSnapshots[nextSnapshotIndex];
-    snapshot.active = g_modeTransition.active;
-    snapshot.isBounceTransition = (g_modeTransition.gameTransition == GameTransitionType::Bounce);
-    snapshot.fromModeId = g_modeTransition.fromModeId;
-    snapshot.toModeId = g_modeTransition.toModeId;
-    snapshot.fromWidth = g_modeTransition.fromWidth;
-    snapshot.fromHeight = g_modeTransition.fromHeight;
-    snapshot.fromX = g_modeTransition.fromX;
-    snapshot.fromY = g_modeTransition.fromY;
-    snapshot.currentX = g_modeTransition.currentX;
-    snapshot.currentY = g_modeTransition.currentY;
-    snapshot.currentWidth = g_modeTransition.currentWidth;
-    snapshot.currentHeight = g_modeTransition.currentHeight;
-    snapshot.toX = g_modeTransition.toX;
-    snapshot.toY = g_modeTransition.toY;
-    snapshot.toWidth = g_modeTransition.toWidth;
-    snapshot.toHeight = g_modeTransition.toHeight;
-    // Native dimensions for viewport matching
-    snapshot.fromNativeWidth = g_modeTransition.fromNativeWidth;
-    snapshot.fromNativeHeight = g_modeTransition.fromNativeHeight;
-    snapshot.toNativeWidth = g_modeTransition.toNativeWidth;
-    snapshot.toNativeHeight = g_modeTransition.toNativeHeight;
-    // New fields for GetModeTransitionState
-    snapshot.gameTransition = g_modeTransition.gameTransition;
-    snapshot.overlayTransition = g_modeTransition.overlayTransition;
-    snapshot.backgroundTransition = g_modeTransition.backgroundTransition;
-    snapshot.progress = g_modeTransition.progress;
-    snapshot.moveProgress = g_modeTransition.moveProgress;
-    // Fade duration fields removed - overlay/background transitions are always Cut
-    snapshot.startTime = g_modeTransition.startTime;
-    g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
+    const ViewportTransitionSnapshot snapshot = PublishViewportTransitionSnapshot();
+
+    // Completion hands sensitivity back to the current mode (runs once: inactive transitions return early above)
+    if (!snapshot.active) { RefreshEffectiveMouseSensitivity(); }
 }
 
 bool IsModeTransitionActive() {
@@ -4134,9 +4094,9 @@ BackgroundTransitionType GetBackgroundTransitionType() {
     return g_modeTransition.active ? g_modeTransition.backgroundTransition : BackgroundTransitionType::Cut;
 }
 
-std::string GetModeTransitionFromModeId() {
+ModeHandle GetModeTransitionFromModeId() {
     std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active ? g_modeTransition.fromModeId : "";
+    return g_modeTransition.active ? g_modeTransition.fromModeId : NO_MODE_HANDLE;
 }
 
 void GetAnimatedModeViewport(int& outWidth, int& outHeight) {
@@ -4182,6 +4142,7 @@ void GetAnimatedModePosition(int& outX, int& outY) {
 bool WaitForOverlayBlitFence() {
     GLsync fence = g_overlayBlitFence.exchange(nullptr, std::memory_order_acq_rel);
     if (fence) {
+        PROFILE_SCOPE_CAT("Wait for Overlay Blit Fence", "Wait");
         glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
         glDeleteSync(fence);
         return true;
@@ -4190,9 +4151,8 @@ bool WaitForOverlayBlitFence() {
 }
 
 ModeTransitionState GetModeTransitionState() {
-    // Lock-free read from double-buffered snapshot
-    const ViewportTransitionSnapshot& snapshot =
-        g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
+    // Lock-free read from the versioned snapshot
+    const ViewportTransitionSnapshot snapshot = g_viewportTransitionSnapshot.Load();
 
     ModeTransitionState state;
     state.active = snapshot.active;
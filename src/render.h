@@ -233,13 +233,12 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData);
 void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData);
 void InitializeGPUResources();
 void CreateMirrorGPUResources(const MirrorConfig& conf);
+// Applies config snapshot changes to GPU resources owned by the game thread (mirror FBOs, image textures).
+// Call once per frame from the SwapBuffers hook; no-op when nothing was published.
+void SyncConfigResources();
 
 // Mirror Capture Thread functions are declared in mirror_thread.h
 
-// Performance Optimization: Lookup Cache Invalidation
-// Call this whenever config.mirrors, config.images, or config.windowOverlays change
-void InvalidateConfigLookupCaches();
-
 // Rendering Functions
 void RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, const GameViewportGeometry& geo, int fullW, int fullH,
                    float modeOpacity = 1.0f, bool excludeOnlyOnMyScreen = false);
@@ -278,7 +277,7 @@ bool IsModeTransitionActive();
 GameTransitionType GetGameTransitionType();
 OverlayTransitionType GetOverlayTransitionType();
 BackgroundTransitionType GetBackgroundTransitionType();
-std::string GetModeTransitionFromModeId();
+ModeHandle GetModeTransitionFromModeId();
 
 // Struct to hold all transition state atomically
 struct ModeTransitionState {
@@ -302,8 +301,8 @@ struct ModeTransitionState {
     int fromHeight;
     int fromX;
     int fromY;
-    // From mode ID - needed for background rendering during transitions
-    std::string fromModeId;
+    // From mode - needed for background rendering during transitions
+    ModeHandle fromModeId = NO_MODE_HANDLE;
 };
 
 // Get all transition state in a single atomic operation to avoid race conditions
@@ -2,6 +2,7 @@
 #include "fake_cursor.h"
 #include "gui.h"
 #include "imgui_input_queue.h"
+#include "metrics.h"
 #include "mirror_thread.h"
 #include "obs_thread.h"
 #include "profiler.h"
@@ -238,8 +239,17 @@ static int rt_eyeZoomSnapshotWidth = 0;
 static int rt_eyeZoomSnapshotHeight = 0;
 static bool rt_eyeZoomSnapshotValid = false;
 
-static std::atomic<uint64_t> g_framesRendered{ 0 };
-static std::atomic<uint64_t> g_framesDropped{ 0 };
+static const MetricId g_metricFramesRendered = RegisterMetric("render.frames", MetricKind::Meter, "Frames composited by the render thread");
+static const MetricId g_metricRequestsDropped =
+    RegisterMetric("render.requests_dropped", MetricKind::Meter, "Frame requests replaced before the render thread read them");
+static const MetricId g_metricObsSubmissionsDropped =
+    RegisterMetric("obs.submissions_dropped", MetricKind::Meter, "OBS submissions replaced before the render thread read them");
+static const MetricId g_metricRenderWaitTimeouts =
+    RegisterMetric("render.wait_timeouts", MetricKind::Counter, "WaitForRenderComplete() gave up before the frame finished");
+static const MetricId g_metricGameTextureFallbacks =
+    RegisterMetric("render.game_texture_fallbacks", MetricKind::Meter, "Frames composited from the previous game capture");
+static const MetricId g_metricVirtualCameraGpuSkips =
+    RegisterMetric("vcam.gpu_busy_skips", MetricKind::Meter, "Virtual camera updates skipped, last conversion still on the GPU");
 static std::atomic<double> g_avgRenderTimeMs{ 0.0 };
 static std::atomic<double> g_lastRenderTimeMs{ 0.0 };
 
@@ -412,7 +422,7 @@ static bool RT_TryInitializeImGui(HWND hwnd, const Config& cfg) {
 
     g_fontsValid = true;
     g_renderThreadImGuiInitialized = true;
-    LogCategory("init", "Render Thread: ImGui initialized successfully");
+    LogCategory(LogCat::Init, "Render Thread: ImGui initialized successfully");
     return true;
 }
 
@@ -882,7 +892,7 @@ static GLuint RT_CreateComputeProgram(const char* src) {
 }
 
 static bool RT_InitializeShaders() {
-    LogCategory("init", "RenderThread: Initializing shaders...");
+    LogCategory(LogCat::Init, "RenderThread: Initializing shaders...");
 
     // NOTE: Border rendering shaders have been removed - all border rendering is done by mirror_thread
     // Render thread only needs: background (for mirror blitting), solid color (for game borders), image render, static border, and gradient
@@ -906,7 +916,7 @@ static bool RT_InitializeShaders() {
             g_vcLocRgbaTexture = glGetUniformLocation(g_vcComputeProgram, "u_rgbaTexture");
             g_vcLocWidth = glGetUniformLocation(g_vcComputeProgram, "u_width");
             g_vcLocHeight = glGetUniformLocation(g_vcComputeProgram, "u_height");
-            LogCategory("init", "RenderThread: NV12 compute shader compiled successfully (Rec. 709, image2D path)");
+            LogCategory(LogCat::Init, "RenderThread: NV12 compute shader compiled successfully (Rec. 709, image2D path)");
         } else {
             Log("RenderThread: NV12 compute shader failed, falling back to CPU conversion");
             g_vcUseCompute = false;
@@ -956,7 +966,7 @@ static bool RT_InitializeShaders() {
 
     glUseProgram(0);
 
-    LogCategory("init", "RenderThread: Shaders initialized successfully");
+    LogCategory(LogCat::Init, "RenderThread: Shaders initialized successfully");
     return true;
 }
 
@@ -1291,8 +1301,8 @@ static void InitRenderFBOs(int width, int height) {
             fbo.width = width;
             fbo.height = height;
             mainResized = true;
-            LogCategory("init", "RenderThread: Initialized FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
-                                    std::to_string(height));
+            LogCategory(LogCat::Init, "RenderThread: Initialized FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
+                                          std::to_string(height));
         }
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -1354,8 +1364,8 @@ static void InitRenderFBOs(int width, int height) {
 
             fbo.width = width;
             fbo.height = height;
-            LogCategory("init", "RenderThread: Initialized OBS FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
-                                    std::to_string(height));
+            LogCategory(LogCat::Init, "RenderThread: Initialized OBS FBO " + std::to_string(i) + " at " + std::to_string(width) + "x" +
+                                          std::to_string(height));
         }
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -1643,8 +1653,10 @@ static void StartVirtualCameraComputeReadback(GLuint srcTexture, int texW, int t
 
             // Mark readback pending — will be mapped + written to virtual camera next call
             g_vcReadbackPending = true;
+        } else {
+            // Not signaled yet: skip this update rather than stall
+            MetricAdd(g_metricVirtualCameraGpuSkips);
         }
-        // If not signaled yet, we just skip — no stall
     }
 
     // Step 2: Flush any pending PBO readback from the previous cycle
@@ -2061,7 +2073,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
                              float modeOpacity, bool excludeOnlyOnMyScreen, bool relativeStretching, float transitionProgress,
                              float mirrorSlideProgress, int fromX, int fromY, int fromW, int fromH, int toX, int toY, int toW, int toH,
                              bool isEyeZoomMode, bool isTransitioningFromEyeZoom, int eyeZoomAnimatedViewportX, bool skipAnimation,
-                             const std::string& fromModeId, bool fromSlideMirrorsIn, bool toSlideMirrorsIn, bool isSlideOutPass, GLuint vao,
+                             ModeHandle fromModeId, bool fromSlideMirrorsIn, bool toSlideMirrorsIn, bool isSlideOutPass, GLuint vao,
                              GLuint vbo) {
     if (activeMirrors.empty()) return;
 
@@ -2074,21 +2086,15 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     // Mirrors that exist in both the source mode and target mode should use normal bounce animation,
     // not the slide animation (which is for mode-specific mirrors only)
     std::set<std::string> sourceMirrorNames;
-    if (!fromModeId.empty() && (fromSlideMirrorsIn || toSlideMirrorsIn || slideCfg.eyezoom.slideMirrorsIn)) {
+    if (fromModeId != NO_MODE_HANDLE && (fromSlideMirrorsIn || toSlideMirrorsIn || slideCfg.eyezoom.slideMirrorsIn)) {
         // Look up the FROM mode to get its mirror list
-        for (const auto& mode : slideCfg.modes) {
-            if (EqualsIgnoreCase(mode.id, fromModeId)) {
-                for (const auto& mirrorName : mode.mirrorIds) { sourceMirrorNames.insert(mirrorName); }
-                // Also include mirrors from mirror groups
-                for (const auto& groupName : mode.mirrorGroupIds) {
-                    for (const auto& group : slideCfg.mirrorGroups) {
-                        if (group.name == groupName) {
-                            for (const auto& item : group.mirrors) { sourceMirrorNames.insert(item.mirrorId); }
-                            break;
-                        }
-                    }
+        if (const ModeConfig* mode = GetModeFromSnapshot(slideCfg, fromModeId)) {
+            for (const auto& mirrorName : mode->mirrorIds) { sourceMirrorNames.insert(mirrorName); }
+            // Also include mirrors from mirror groups
+            for (ElementHandle groupHandle : mode->mirrorGroupHandles) {
+                if (const MirrorGroupConfig* group = GetMirrorGroupFromSnapshot(slideCfg, groupHandle)) {
+                    for (const auto& item : group->mirrors) { sourceMirrorNames.insert(item.mirrorId); }
                 }
-                break;
             }
         }
     }
@@ -2959,85 +2965,41 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
 // Collect active mirrors/images/overlays for a mode from g_config
 // This runs on the render thread, moving the work off the main thread
 // When onlyOnMyScreenPass is true, only items with onlyOnMyScreen=true are collected
-static void RT_CollectActiveElements(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
+static void RT_CollectActiveElements(const Config& config, ModeHandle modeId, bool onlyOnMyScreenPass,
                                      std::vector<MirrorConfig>& outMirrors, std::vector<ImageConfig>& outImages,
                                      std::vector<const WindowOverlayConfig*>& outWindowOverlays) {
     outMirrors.clear();
     outImages.clear();
     outWindowOverlays.clear();
 
-    // Build lookup maps for this specific immutable snapshot to avoid O(n^2) scans.
-    // These caches are safe because `config` is immutable for the lifetime of the snapshot.
-    static const Config* s_cachedConfigPtr = nullptr;
-    static std::unordered_map<std::string, const ModeConfig*> s_modeById;
-    static std::unordered_map<std::string, const MirrorConfig*> s_mirrorByName;
-    static std::unordered_map<std::string, const MirrorGroupConfig*> s_groupByName;
-    static std::unordered_map<std::string, const ImageConfig*> s_imageByName;
-    static std::unordered_map<std::string, const WindowOverlayConfig*> s_windowOverlayByName;
-
-    if (s_cachedConfigPtr != &config) {
-        s_cachedConfigPtr = &config;
-        s_modeById.clear();
-        s_mirrorByName.clear();
-        s_groupByName.clear();
-        s_imageByName.clear();
-        s_windowOverlayByName.clear();
-
-        s_modeById.reserve(config.modes.size());
-        for (const auto& m : config.modes) { s_modeById[m.id] = &m; }
-
-        s_mirrorByName.reserve(config.mirrors.size());
-        for (const auto& m : config.mirrors) { s_mirrorByName[m.name] = &m; }
-
-        s_groupByName.reserve(config.mirrorGroups.size());
-        for (const auto& g : config.mirrorGroups) { s_groupByName[g.name] = &g; }
-
-        s_imageByName.reserve(config.images.size());
-        for (const auto& img : config.images) { s_imageByName[img.name] = &img; }
-
-        s_windowOverlayByName.reserve(config.windowOverlays.size());
-        for (const auto& o : config.windowOverlays) { s_windowOverlayByName[o.name] = &o; }
-    }
-
-    // Look up mode by ID (case-insensitive fallback if exact not found)
-    const ModeConfig* mode = nullptr;
-    if (auto it = s_modeById.find(modeId); it != s_modeById.end()) {
-        mode = it->second;
-    } else {
-        for (const auto& kv : s_modeById) {
-            if (EqualsIgnoreCase(kv.first, modeId)) {
-                mode = kv.second;
-                break;
-            }
-        }
-    }
+    // Every lookup below is an array read through the snapshot's mode and element handle indexes (no string hashing per frame)
+    const ModeConfig* mode = GetModeFromSnapshot(config, modeId);
     if (!mode) return;
 
     // Reserve space upfront
-    outMirrors.reserve(mode->mirrorIds.size() + mode->mirrorGroupIds.size());
-    outImages.reserve(mode->imageIds.size());
-    outWindowOverlays.reserve(mode->windowOverlayIds.size());
+    outMirrors.reserve(mode->mirrorHandles.size() + mode->mirrorGroupHandles.size());
+    outImages.reserve(mode->imageHandles.size());
+    outWindowOverlays.reserve(mode->windowOverlayHandles.size());
 
     // Collect mirrors
-    for (const auto& mirrorName : mode->mirrorIds) {
-        auto it = s_mirrorByName.find(mirrorName);
-        if (it == s_mirrorByName.end() || !it->second) continue;
-        const MirrorConfig& mirror = *it->second;
+    for (ElementHandle mirrorHandle : mode->mirrorHandles) {
+        const MirrorConfig* mirrorPtr = GetMirrorFromSnapshot(config, mirrorHandle);
+        if (!mirrorPtr) continue;
+        const MirrorConfig& mirror = *mirrorPtr;
         if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) { outMirrors.push_back(mirror); }
     }
 
     // Collect mirror groups (override output position for each mirror in the group)
     // Per-item sizing: each mirror in the group has its own widthPercent/heightPercent
-    for (const auto& groupName : mode->mirrorGroupIds) {
-        auto git = s_groupByName.find(groupName);
-        if (git == s_groupByName.end() || !git->second) continue;
-        const auto& group = *git->second;
+    for (ElementHandle groupHandle : mode->mirrorGroupHandles) {
+        const MirrorGroupConfig* groupPtr = GetMirrorGroupFromSnapshot(config, groupHandle);
+        if (!groupPtr) continue;
+        const auto& group = *groupPtr;
 
             for (const auto& item : group.mirrors) {
                 if (!item.enabled) continue; // Skip disabled items
-                auto mit = s_mirrorByName.find(item.mirrorId);
-                if (mit != s_mirrorByName.end() && mit->second) {
-                    const auto& mirror = *mit->second;
+                if (const MirrorConfig* mirrorPtr = GetMirrorFromSnapshot(config, item.mirrorHandle)) {
+                    const auto& mirror = *mirrorPtr;
                     if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) {
                         MirrorConfig groupedMirror = mirror;
                             // Calculate group position - use relative percentages if enabled
@@ -3074,21 +3036,20 @@ static void RT_CollectActiveElements(const Config& config, const std::string& mo
 
     // Collect images (honor runtime visibility toggle)
     if (g_imageOverlaysVisible.load(std::memory_order_acquire)) {
-        for (const auto& imageName : mode->imageIds) {
-            auto it = s_imageByName.find(imageName);
-            if (it == s_imageByName.end() || !it->second) continue;
-            const ImageConfig& image = *it->second;
+        for (ElementHandle imageHandle : mode->imageHandles) {
+            const ImageConfig* imagePtr = GetImageFromSnapshot(config, imageHandle);
+            if (!imagePtr) continue;
+            const ImageConfig& image = *imagePtr;
             if (!onlyOnMyScreenPass || image.onlyOnMyScreen) { outImages.push_back(image); }
         }
     }
 
     // Collect window overlays (honor runtime visibility toggle)
     if (g_windowOverlaysVisible.load(std::memory_order_acquire)) {
-        for (const auto& overlayId : mode->windowOverlayIds) {
-            auto it = s_windowOverlayByName.find(overlayId);
-            if (it == s_windowOverlayByName.end() || !it->second) continue;
-            const WindowOverlayConfig& overlay = *it->second;
-            if (!onlyOnMyScreenPass || overlay.onlyOnMyScreen) { outWindowOverlays.push_back(it->second); }
+        for (ElementHandle overlayHandle : mode->windowOverlayHandles) {
+            const WindowOverlayConfig* overlay = GetWindowOverlayFromSnapshot(config, overlayHandle);
+            if (!overlay) continue;
+            if (!onlyOnMyScreenPass || overlay->onlyOnMyScreen) { outWindowOverlays.push_back(overlay); }
         }
     }
 }
@@ -3098,6 +3059,7 @@ static void RenderThreadFunc(void* gameGLContext) {
 
     try {
         Log("Render Thread: Starting...");
+        Profiler::GetInstance().SetThreadName("Render");
 
         // Validate pre-created context
         if (!g_renderThreadDC || !g_renderThreadContext) {
@@ -3121,7 +3083,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             return;
         }
 
-        LogCategory("init", "Render Thread: Context initialized successfully");
+        LogCategory(LogCat::Init, "Render Thread: Context initialized successfully");
 
         // Initialize shaders on this context
         if (!RT_InitializeShaders()) {
@@ -3139,8 +3101,9 @@ static void RenderThreadFunc(void* gameGLContext) {
             int vcW, vcH;
             GetVirtualCamScaledSize(screenW, screenH, 1.0f, vcW, vcH);
             if (StartVirtualCamera(vcW, vcH, initCfg->debug.virtualCameraFps)) {
-                LogCategory("init", "Render Thread: Virtual Camera initialized at " + std::to_string(vcW) + "x" + std::to_string(vcH) +
-                                        " @ " + std::to_string(initCfg->debug.virtualCameraFps) + "fps");
+                LogCategory(LogCat::Init,
+                            "Render Thread: Virtual Camera initialized at " + std::to_string(vcW) + "x" + std::to_string(vcH) +
+                            " @ " + std::to_string(initCfg->debug.virtualCameraFps) + "fps");
             } else {
                 Log("Render Thread: Virtual Camera initialization failed");
             }
@@ -3210,13 +3173,13 @@ static void RenderThreadFunc(void* gameGLContext) {
 
                 g_fontsValid = true;
                 g_renderThreadImGuiInitialized = true;
-                LogCategory("init", "Render Thread: ImGui initialized successfully");
+                LogCategory(LogCat::Init, "Render Thread: ImGui initialized successfully");
             } else {
-                LogCategory("init", "Render Thread: HWND not available, ImGui not initialized");
+                LogCategory(LogCat::Init, "Render Thread: HWND not available, ImGui not initialized");
             }
         }
 
-        LogCategory("init", "Render Thread: Entering main loop");
+        LogCategory(LogCat::Init, "Render Thread: Entering main loop");
 
         while (!g_renderThreadShouldStop.load()) {
             // Wait for frame request (lock only held during wait, not during processing)
@@ -3224,6 +3187,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             bool isObsRequest = false;
 
             {
+                PROFILE_SCOPE_CAT("Wait for Frame Request", "Wait");
                 std::unique_lock<std::mutex> lock(g_requestSignalMutex);
                 g_requestCV.wait(lock, [] {
                     return g_requestReadySlot.load(std::memory_order_acquire) != -1 || g_obsReadySlot.load(std::memory_order_acquire) != -1 ||
@@ -3344,23 +3308,17 @@ static void RenderThreadFunc(void* gameGLContext) {
                 // When transitioning FROM EyeZoom, use EyeZoom's background (not the target mode's)
                 // When transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background)
                 if (!request.isRawWindowedMode) {
-                    std::string bgModeId = request.modeId;
+                    ModeHandle bgModeId = request.modeId;
                     // If transitioning FROM EyeZoom, use EyeZoom's background instead of target mode
                     if (request.isTransitioningFromEyeZoom) {
-                        bgModeId = "EyeZoom";
+                        bgModeId = EyeZoomModeHandle();
                     }
                     // If transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background of its own)
-                    else if (EqualsIgnoreCase(request.modeId, "Fullscreen") && !request.fromModeId.empty()) {
+                    else if (ModeHandlesEqual(request.modeId, FullscreenModeHandle()) && request.fromModeId != NO_MODE_HANDLE) {
                         bgModeId = request.fromModeId;
                     }
 
-                    const ModeConfig* mode = nullptr;
-                    for (const auto& m : cfg.modes) {
-                        if (EqualsIgnoreCase(m.id, bgModeId)) {
-                            mode = &m;
-                            break;
-                        }
-                    }
+                    const ModeConfig* mode = GetModeFromSnapshot(cfg, bgModeId);
 
                     if (mode && mode->background.selectedMode == "gradient" && mode->background.gradientStops.size() >= 2) {
                         // Render gradient background fullscreen
@@ -3403,7 +3361,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                         GLuint bgTex = 0;
                         {
                             std::lock_guard<std::mutex> bgLock(g_backgroundTexturesMutex);
-                            auto bgTexIt = g_backgroundTextures.find(bgModeId);
+                            auto bgTexIt = g_backgroundTextures.find(ModeIdName(bgModeId));
                             if (bgTexIt != g_backgroundTextures.end()) {
                                 BackgroundTextureInstance& bgInst = bgTexIt->second;
 
@@ -3462,6 +3420,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                 if (readyTex == 0 || srcW <= 0 || srcH <= 0) {
                     GLuint safeTex = GetSafeReadTexture();
                     if (safeTex != 0) {
+                        MetricAdd(g_metricGameTextureFallbacks);
                         readyTex = safeTex;
                         // Use fallback dimensions (these track the last completed frame)
                         srcW = GetFallbackGameWidth();
@@ -3551,7 +3510,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             // In steady-state gameplay, config and mode are usually stable, so rebuilding these vectors every frame
             // is wasted CPU (string lookups + vector growth/clear).
             static const Config* s_cachedActiveCfgPtr = nullptr;
-            static std::string s_cachedActiveModeId;
+            static ModeHandle s_cachedActiveModeId = NO_MODE_HANDLE;
             static bool s_cachedActiveImagesVisible = false;
             static bool s_cachedActiveWindowOverlaysVisible = false;
             static std::vector<MirrorConfig> s_cachedActiveMirrors;
@@ -3729,7 +3688,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                 SwapMirrorBuffers();
 
                 // Determine if we're in EyeZoom mode (for the collected mirrors)
-                bool isEyeZoomMode = (request.modeId == "EyeZoom");
+                bool isEyeZoomMode = (request.modeId == EyeZoomModeHandle());
 
                 RT_RenderMirrors(activeMirrors, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
                                  request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
@@ -3750,7 +3709,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                 std::vector<MirrorConfig> eyeZoomMirrors;
                 std::vector<ImageConfig> unusedImages;
                 std::vector<const WindowOverlayConfig*> unusedOverlays;
-                RT_CollectActiveElements(cfg, "EyeZoom", false, eyeZoomMirrors, unusedImages, unusedOverlays);
+                RT_CollectActiveElements(cfg, EyeZoomModeHandle(), false, eyeZoomMirrors, unusedImages, unusedOverlays);
 
                 // Filter out mirrors that already exist in the target mode (don't slide those out)
                 std::vector<MirrorConfig> mirrorsToSlideOut;
@@ -3781,7 +3740,7 @@ static void RenderThreadFunc(void* gameGLContext) {
             // When transitioning FROM a mode with slideMirrorsIn (non-EyeZoom), render slide-out animation
             // for mirrors unique to the FROM mode
             // Skip animation when hideAnimationsInGame is enabled (skipAnimation flag)
-            if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && !request.fromModeId.empty() &&
+            if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && request.fromModeId != NO_MODE_HANDLE &&
                 request.mirrorSlideProgress < 1.0f && !request.skipAnimation) {
                 PROFILE_SCOPE_CAT("RT Generic Mirror Slide Out", "Render Thread");
 
@@ -4200,7 +4159,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                 double avg = g_avgRenderTimeMs.load();
                 g_avgRenderTimeMs.store(avg * 0.95 + renderTime * 0.05);
 
-                g_framesRendered.fetch_add(1);
+                MetricAdd(g_metricFramesRendered);
             }
         }
 
@@ -4371,8 +4330,6 @@ void StartRenderThread(void* gameGLContext) {
     g_readFBOIndex.store(-1);
     g_lastGoodTexture.store(0);
     g_lastGoodObsTexture.store(0);
-    g_framesRendered.store(0);
-    g_framesDropped.store(0);
 
     // Clear consumer fences (should already be null, but be safe across hot reloads)
     for (int i = 0; i < RENDER_THREAD_FBO_COUNT; ++i) {
@@ -4382,7 +4339,7 @@ void StartRenderThread(void* gameGLContext) {
 
     // Start thread
     g_renderThread = std::thread(RenderThreadFunc, gameGLContext);
-    LogCategory("init", "Render Thread: Started");
+    LogCategory(LogCat::Init, "Render Thread: Started");
 }
 
 void StopRenderThread() {
@@ -4431,7 +4388,7 @@ void SubmitFrameForRendering(const FrameRenderRequest& request) {
     // Main thread ALWAYS succeeds - never blocks waiting for render thread
 
     // If there was an unread request in the mailbox, this submission overwrites it (drop).
-    if (g_requestReadySlot.load(std::memory_order_relaxed) != -1) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
+    if (g_requestReadySlot.load(std::memory_order_relaxed) != -1) { MetricAdd(g_metricRequestsDropped); }
 
     // Write to a slot that is NOT currently being copied by the render thread.
     // With only 2 slots, a fast producer can otherwise lap and overwrite the slot being read.
@@ -4440,7 +4397,7 @@ void SubmitFrameForRendering(const FrameRenderRequest& request) {
     if (writeSlot == readSlotInUse) { writeSlot = 1 - writeSlot; }
     if (writeSlot == readSlotInUse) {
         // Extremely unlikely (would require invalid state), but never risk a data race.
-        g_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        MetricAdd(g_metricRequestsDropped);
         return;
     }
     g_requestSlots[writeSlot] = request;
@@ -4459,13 +4416,17 @@ void SubmitFrameForRendering(const FrameRenderRequest& request) {
 }
 
 int WaitForRenderComplete(int timeoutMs) {
+    PROFILE_SCOPE_CAT("Wait for Render Thread", "Wait");
     std::unique_lock<std::mutex> lock(g_completionMutex);
 
     bool completed = g_completionCV.wait_for(lock, std::chrono::milliseconds(timeoutMs),
                                              [] { return g_frameComplete.load() || g_renderThreadShouldStop.load(); });
 
     if (g_renderThreadShouldStop.load()) return -1;
-    if (!completed) return -1;
+    if (!completed) {
+        MetricAdd(g_metricRenderWaitTimeouts);
+        return -1;
+    }
 
     g_frameComplete.store(false);
     return g_readFBOIndex.load();
@@ -4516,7 +4477,7 @@ void SubmitObsFrameContext(const ObsFrameSubmission& submission) {
     // Occasional fence leaks from dropped frames are acceptable and rare.
 
     // If there was an unread OBS submission in the mailbox, this submission overwrites it (drop).
-    if (g_obsReadySlot.load(std::memory_order_relaxed) != -1) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
+    if (g_obsReadySlot.load(std::memory_order_relaxed) != -1) { MetricAdd(g_metricObsSubmissionsDropped); }
 
     // Write to a slot that is NOT currently being copied by the render thread.
     int writeSlot = g_obsWriteSlot.load(std::memory_order_relaxed);
@@ -4525,7 +4486,7 @@ void SubmitObsFrameContext(const ObsFrameSubmission& submission) {
     if (writeSlot == readSlotInUse) {
         // Avoid data race on ObsFrameSubmission (contains std::string in context).
         // If this happens, drop the submission.
-        g_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        MetricAdd(g_metricObsSubmissionsDropped);
         return;
     }
     g_obsSubmissionSlots[writeSlot] = submission;
@@ -4583,7 +4544,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     req.fromModeId = transitionState.fromModeId; // For source mirror check in sliding animation
 
     // Slide mirrors animation settings
-    if (!transitionState.fromModeId.empty()) {
+    if (transitionState.fromModeId != NO_MODE_HANDLE) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) { req.fromSlideMirrorsIn = fromMode->slideMirrorsIn; }
     }
@@ -4786,7 +4747,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     }
 
     // Background color - check for fullscreen transition
-    bool transitioningToFullscreen = EqualsIgnoreCase(ctx.modeId, "Fullscreen") && !transitionState.fromModeId.empty();
+    bool transitioningToFullscreen = ModeHandlesEqual(ctx.modeId, FullscreenModeHandle()) && transitionState.fromModeId != NO_MODE_HANDLE;
     if (transitioningToFullscreen && !transitionEffectivelyComplete) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) {
@@ -4817,7 +4778,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
 
     // Transition-related border (for transitioning TO Fullscreen)
     req.transitioningToFullscreen = transitioningToFullscreen && !transitionEffectivelyComplete;
-    if (req.transitioningToFullscreen && !transitionState.fromModeId.empty()) {
+    if (req.transitioningToFullscreen && transitionState.fromModeId != NO_MODE_HANDLE) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) {
             req.fromBorderEnabled = fromMode->border.enabled;
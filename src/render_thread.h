@@ -11,6 +11,8 @@
 #include <string>
 #include <vector>
 
+#include "mode_id.h"
+
 // Forward declarations - render thread looks up configs directly from g_config
 struct ModeConfig;
 struct MirrorConfig;
@@ -42,8 +44,8 @@ struct FrameRenderRequest {
     // If UINT_MAX, mirrors should sample from backbuffer instead
     GLuint gameTextureId = 0;
 
-    // Mode ID - render thread looks up ModeConfig and collects active elements
-    std::string modeId;
+    // Mode - render thread looks up ModeConfig and collects active elements
+    ModeHandle modeId = NO_MODE_HANDLE;
 
     // Transition state
     bool isAnimating = false;
@@ -106,7 +108,7 @@ struct FrameRenderRequest {
     float fromBorderB = 1.0f;
     int fromBorderWidth = 0;
     int fromBorderRadius = 0;
-    std::string fromModeId; // For looking up from-mode's background texture
+    ModeHandle fromModeId = NO_MODE_HANDLE; // For looking up from-mode's background texture
 
     // Slide mirrors animation - per-mode setting for mirror slide in/out
     bool fromSlideMirrorsIn = false;  // FROM mode's slideMirrorsIn setting
@@ -221,7 +223,7 @@ struct ObsFrameContext {
     int fullW = 0, fullH = 0;
     int gameW = 0, gameH = 0;
     GLuint gameTextureId = 0;
-    std::string modeId;
+    ModeHandle modeId = NO_MODE_HANDLE;
     bool relativeStretching = false;
     float bgR = 0.0f, bgG = 0.0f, bgB = 0.0f;
 
@@ -0,0 +1,192 @@
+#pragma once
+
+// ============================================================================
+// RING_BUFFER.H - Bounded lock-free ring buffers (SPSC / MPSC / SPMC / MPMC)
+// ============================================================================
+// One slot protocol for every producer/consumer combination (bounded queue
+// with a per-slot sequence number): a slot is writable when its sequence
+// equals the enqueue position and readable when it equals position + 1.
+// Producers and consumers only synchronize through the slot sequence
+// (release on publish, acquire on observe), so a slow writer never exposes a
+// half-written element - readers simply stop at it, preserving order.
+//
+// Single-sided roles advance their index with a plain store; multi-sided
+// roles claim positions with a CAS. Indices are separated by a full cache
+// line of padding so producers and consumers don't false-share.
+//
+// Full-queue policy:
+//   DropNewest      - Push() fails and the new element is discarded.
+//   OverwriteOldest - Push() evicts the oldest element (handed to an optional
+//                     callback, e.g. to release resources) and always succeeds.
+//                     The producer acts as a consumer when evicting, so the
+//                     consumer side always claims with CAS under this policy.
+//
+// The storage is zero-initialized (slot sequences are stored relative to
+// their index), so static instances are usable before dynamic initialization.
+// ============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+enum class RingProducers { Single, Multi };
+enum class RingConsumers { Single, Multi };
+enum class RingFullPolicy { DropNewest, OverwriteOldest };
+
+constexpr size_t RING_CACHE_LINE_SIZE = 64;
+
+template <typename T, size_t Capacity, RingProducers Producers, RingConsumers Consumers,
+          RingFullPolicy FullPolicy = RingFullPolicy::DropNewest>
+class LockFreeRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "LockFreeRing capacity must be a power of two >= 2");
+
+    static constexpr size_t kMask = Capacity - 1;
+    static constexpr bool kMultiProducer = (Producers == RingProducers::Multi);
+    static constexpr bool kMultiConsumer = (Consumers == RingConsumers::Multi) || (FullPolicy == RingFullPolicy::OverwriteOldest);
+
+public:
+    LockFreeRing() = default;
+    LockFreeRing(const LockFreeRing&) = delete;
+    LockFreeRing& operator=(const LockFreeRing&) = delete;
+
+    static constexpr size_t CapacityValue() { return Capacity; }
+
+    // Enqueues according to the full-queue policy. Returns false only if the element was dropped.
+    bool Push(T value) {
+        return Push(std::move(value), [](T&) {});
+    }
+
+    // onEvict(T&) receives elements displaced by OverwriteOldest.
+    template <typename OnEvict> bool Push(T value, OnEvict&& onEvict) {
+        for (;;) {
+            if (TryEnqueue(value)) return true;
+            if constexpr (FullPolicy == RingFullPolicy::DropNewest) {
+                return false;
+            } else {
+                T oldest{};
+                if (TryPop(oldest)) { onEvict(oldest); }
+                // else: the oldest slot is still being written or was just consumed - retry
+            }
+        }
+    }
+
+    // Dequeues the oldest element. Returns false if the ring is empty (or the oldest element is still being written).
+    bool TryPop(T& out) {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos & kMask];
+            const size_t seq = slot->turn.load(std::memory_order_acquire) + (pos & kMask);
+            const intptr_t diff = static_cast<intptr_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if constexpr (kMultiConsumer) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else {
+                    m_tail.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(slot->value);
+        Release(*slot, pos);
+        return true;
+    }
+
+    // Batch pop: calls fn(T&) for up to maxItems elements in order. Returns the number consumed.
+    template <typename Fn> size_t ConsumeAll(Fn&& fn, size_t maxItems = (std::numeric_limits<size_t>::max)()) {
+        size_t consumed = 0;
+        if constexpr (kMultiConsumer) {
+            T item{};
+            while (consumed < maxItems && TryPop(item)) {
+                fn(item);
+                consumed++;
+            }
+        } else {
+            // Single consumer: no claim needed, process in place and release each slot after use
+            size_t pos = m_tail.load(std::memory_order_relaxed);
+            while (consumed < maxItems) {
+                Slot& slot = m_slots[pos & kMask];
+                const size_t seq = slot.turn.load(std::memory_order_acquire) + (pos & kMask);
+                if (seq != pos + 1) break;
+                fn(slot.value);
+                Release(slot, pos);
+                pos++;
+                m_tail.store(pos, std::memory_order_relaxed);
+                consumed++;
+            }
+        }
+        return consumed;
+    }
+
+    // Discards everything currently readable. Consumer-side operation.
+    void Clear() {
+        T discard{};
+        while (TryPop(discard)) {}
+    }
+
+    // Approximate (exact when producers and consumers are quiescent)
+    size_t SizeApprox() const {
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const intptr_t size = static_cast<intptr_t>(head - tail);
+        if (size <= 0) return 0;
+        return (static_cast<size_t>(size) > Capacity) ? Capacity : static_cast<size_t>(size);
+    }
+    bool EmptyApprox() const { return SizeApprox() == 0; }
+
+private:
+    struct Slot {
+        // Slot sequence minus the slot index, so an all-zero slot array is the valid initial state
+        std::atomic<size_t> turn{ 0 };
+        T value{};
+    };
+
+    bool TryEnqueue(T& value) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos & kMask];
+            const size_t seq = slot->turn.load(std::memory_order_acquire) + (pos & kMask);
+            const intptr_t diff = static_cast<intptr_t>(seq - pos);
+            if (diff == 0) {
+                if constexpr (kMultiProducer) {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else {
+                    m_head.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Full (or the slot is still being read)
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::move(value);
+        slot->turn.store(pos + 1 - (pos & kMask), std::memory_order_release);
+        return true;
+    }
+
+    // Hands a consumed slot back to producers for the next lap
+    void Release(Slot& slot, size_t pos) { slot.turn.store(pos + Capacity - (pos & kMask), std::memory_order_release); }
+
+    std::atomic<size_t> m_head{ 0 }; // Next enqueue position
+    char m_padHead[RING_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)] = {};
+    std::atomic<size_t> m_tail{ 0 }; // Next dequeue position
+    char m_padTail[RING_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)] = {};
+    Slot m_slots[Capacity];
+};
+
+template <typename T, size_t Capacity, RingFullPolicy FullPolicy = RingFullPolicy::DropNewest>
+using SpscRing = LockFreeRing<T, Capacity, RingProducers::Single, RingConsumers::Single, FullPolicy>;
+
+template <typename T, size_t Capacity, RingFullPolicy FullPolicy = RingFullPolicy::DropNewest>
+using MpscRing = LockFreeRing<T, Capacity, RingProducers::Multi, RingConsumers::Single, FullPolicy>;
+
+template <typename T, size_t Capacity, RingFullPolicy FullPolicy = RingFullPolicy::DropNewest>
+using MpmcRing = LockFreeRing<T, Capacity, RingProducers::Multi, RingConsumers::Multi, FullPolicy>;
@@ -0,0 +1,262 @@
+#pragma once
+
+// ============================================================================
+// SHARED_VECTOR.H - Copy-on-write element vector for config sections
+// ============================================================================
+// Each element lives in its own heap node; the vector itself is a shared,
+// reference-counted array of node pointers (the "spine"). Copying a
+// SharedVector copies one pointer, so copying a Config no longer deep-copies
+// every mirror/mode/hotkey string and vector.
+//
+// Mutation is copy-on-write at both levels: non-const access first detaches
+// a shared spine, then clones the touched node if another spine still holds
+// it. A published snapshot therefore never observes writes to the draft.
+//
+// PublishFrom() builds a snapshot section from the mutable draft, reusing the
+// previous snapshot's node wherever the element still compares equal - only
+// edited elements are copied, and a section with no edits shares the previous
+// snapshot's whole spine. Readers detect changes by identity:
+// SharesStorageWith() for a section, NodeIdentity() for an element.
+//
+// Reader-facing API mirrors std::vector (size/empty/[]/begin/end/front/back);
+// writer-facing API covers what the GUI and the config loader use
+// (push_back/emplace_back/insert/erase/clear/reserve/resize).
+// ============================================================================
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+template <typename T> class SharedVector {
+    using NodePtr = std::shared_ptr<T>;
+    using Spine = std::vector<NodePtr>;
+
+    template <bool IsConst> class IteratorBase {
+        using SpineIterator = std::conditional_t<IsConst, typename Spine::const_iterator, typename Spine::iterator>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        IteratorBase() = default;
+        explicit IteratorBase(SpineIterator it) : m_it(it) {}
+        // iterator -> const_iterator
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        IteratorBase(const IteratorBase<OtherConst>& other) : m_it(other.m_it) {}
+
+        reference operator*() const { return **m_it; }
+        pointer operator->() const { return m_it->get(); }
+        reference operator[](difference_type n) const { return *m_it[n]; }
+
+        IteratorBase& operator++() {
+            ++m_it;
+            return *this;
+        }
+        IteratorBase operator++(int) { return IteratorBase(m_it++); }
+        IteratorBase& operator--() {
+            --m_it;
+            return *this;
+        }
+        IteratorBase operator--(int) { return IteratorBase(m_it--); }
+        IteratorBase& operator+=(difference_type n) {
+            m_it += n;
+            return *this;
+        }
+        IteratorBase& operator-=(difference_type n) {
+            m_it -= n;
+            return *this;
+        }
+        friend IteratorBase operator+(IteratorBase it, difference_type n) { return it += n; }
+        friend IteratorBase operator+(difference_type n, IteratorBase it) { return it += n; }
+        friend IteratorBase operator-(IteratorBase it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const IteratorBase& a, const IteratorBase& b) { return a.m_it - b.m_it; }
+
+        friend bool operator==(const IteratorBase& a, const IteratorBase& b) { return a.m_it == b.m_it; }
+        friend bool operator!=(const IteratorBase& a, const IteratorBase& b) { return a.m_it != b.m_it; }
+        friend bool operator<(const IteratorBase& a, const IteratorBase& b) { return a.m_it < b.m_it; }
+        friend bool operator>(const IteratorBase& a, const IteratorBase& b) { return a.m_it > b.m_it; }
+        friend bool operator<=(const IteratorBase& a, const IteratorBase& b) { return a.m_it <= b.m_it; }
+        friend bool operator>=(const IteratorBase& a, const IteratorBase& b) { return a.m_it >= b.m_it; }
+
+    private:
+        template <bool> friend class IteratorBase;
+        friend class SharedVector;
+        SpineIterator m_it{};
+    };
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    SharedVector() = default;
+    SharedVector(const std::vector<T>& values) { Assign(values.begin(), values.end()); }
+    SharedVector(std::vector<T>&& values) { AssignMoved(values); }
+    SharedVector(std::initializer_list<T> values) { Assign(values.begin(), values.end()); }
+
+    SharedVector& operator=(const std::vector<T>& values) {
+        Assign(values.begin(), values.end());
+        return *this;
+    }
+    SharedVector& operator=(std::vector<T>&& values) {
+        AssignMoved(values);
+        return *this;
+    }
+
+    // --- Read access (never copies) ---
+    size_t size() const { return m_spine ? m_spine->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    const T& operator[](size_t i) const { return *(*m_spine)[i]; }
+    const T& front() const { return *m_spine->front(); }
+    const T& back() const { return *m_spine->back(); }
+
+    const_iterator begin() const { return m_spine ? const_iterator(ConstSpine().begin()) : const_iterator(); }
+    const_iterator end() const { return m_spine ? const_iterator(ConstSpine().end()) : const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    std::vector<T> ToVector() const { return std::vector<T>(begin(), end()); }
+
+    // --- Identity (for change detection between snapshots) ---
+    bool SharesStorageWith(const SharedVector& other) const { return m_spine == other.m_spine; }
+    const void* NodeIdentity(size_t i) const { return (*m_spine)[i].get(); }
+
+    // --- Write access (copy-on-write) ---
+    T& operator[](size_t i) { return MutableNode(i); }
+    T& front() { return MutableNode(0); }
+    T& back() { return MutableNode(size() - 1); }
+
+    // Non-const iteration hands out T&, so every node is made exclusive up front
+    iterator begin() {
+        if (!m_spine) return iterator();
+        MakeAllExclusive();
+        return iterator(m_spine->begin());
+    }
+    iterator end() {
+        if (!m_spine) return iterator();
+        MakeAllExclusive();
+        return iterator(m_spine->end());
+    }
+
+    void push_back(const T& value) { MutableSpine().push_back(std::make_shared<T>(value)); }
+    void push_back(T&& value) { MutableSpine().push_back(std::make_shared<T>(std::move(value))); }
+    template <typename... Args> T& emplace_back(Args&&... args) {
+        Spine& spine = MutableSpine();
+        spine.push_back(std::make_shared<T>(std::forward<Args>(args)...));
+        return *spine.back();
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        const size_t index = IndexOf(pos);
+        Spine& spine = MutableSpine();
+        auto it = spine.insert(spine.begin() + index, std::make_shared<T>(value));
+        return iterator(it);
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_t from = IndexOf(first);
+        const size_t to = IndexOf(last);
+        Spine& spine = MutableSpine();
+        auto it = spine.erase(spine.begin() + from, spine.begin() + to);
+        return iterator(it);
+    }
+
+    void clear() { m_spine.reset(); }
+    void reserve(size_t n) { MutableSpine().reserve(n); }
+    void resize(size_t n) {
+        Spine& spine = MutableSpine();
+        const size_t old = spine.size();
+        spine.resize(n);
+        for (size_t i = old; i < n; ++i) { spine[i] = std::make_shared<T>(); }
+    }
+
+    // Snapshot section for draft: element i reuses previous's node i when they compare equal, otherwise a fresh
+    // copy is made and passed to finalize(T&) (runtime-only fields) before it is frozen. Returns previous itself
+    // (shared spine) when nothing changed.
+    template <typename Finalize> static SharedVector PublishFrom(const SharedVector& draft, const SharedVector* previous, Finalize&& finalize) {
+        const size_t count = draft.size();
+        const size_t prevCount = previous ? previous->size() : 0;
+
+        SharedVector result;
+        if (count == 0) return result;
+
+        auto spine = std::make_shared<Spine>();
+        spine->reserve(count);
+        bool allReused = (count == prevCount);
+        for (size_t i = 0; i < count; ++i) {
+            const T& value = draft[i];
+            if (i < prevCount && (*previous->m_spine)[i].get() != nullptr && *(*previous->m_spine)[i] == value) {
+                spine->push_back((*previous->m_spine)[i]);
+                continue;
+            }
+            auto node = std::make_shared<T>(value);
+            finalize(*node);
+            spine->push_back(std::move(node));
+            allReused = false;
+        }
+
+        if (allReused) return *previous;
+        result.m_spine = std::move(spine);
+        return result;
+    }
+
+    static SharedVector PublishFrom(const SharedVector& draft, const SharedVector* previous) {
+        return PublishFrom(draft, previous, [](T&) {});
+    }
+
+private:
+    const Spine& ConstSpine() const { return *m_spine; }
+
+    template <typename It> void Assign(It first, It last) {
+        auto spine = std::make_shared<Spine>();
+        for (; first != last; ++first) { spine->push_back(std::make_shared<T>(*first)); }
+        m_spine = spine->empty() ? nullptr : std::move(spine);
+    }
+
+    void AssignMoved(std::vector<T>& values) {
+        auto spine = std::make_shared<Spine>();
+        spine->reserve(values.size());
+        for (auto& value : values) { spine->push_back(std::make_shared<T>(std::move(value))); }
+        m_spine = spine->empty() ? nullptr : std::move(spine);
+    }
+
+    size_t IndexOf(const_iterator it) const { return m_spine ? static_cast<size_t>(it.m_it - ConstSpine().begin()) : 0; }
+
+    // The draft is only mutated by the thread that owns it, so a use_count of 1 means no other spine/Config
+    // copy can observe the write (a concurrent release can only make a clone unnecessary, never unsafe).
+    Spine& MutableSpine() {
+        if (!m_spine) {
+            m_spine = std::make_shared<Spine>();
+        } else if (m_spine.use_count() > 1) {
+            m_spine = std::make_shared<Spine>(*m_spine);
+        }
+        return *m_spine;
+    }
+
+    T& MutableNode(size_t i) {
+        NodePtr& node = MutableSpine()[i];
+        if (node.use_count() > 1) { node = std::make_shared<T>(*node); }
+        return *node;
+    }
+
+    void MakeAllExclusive() {
+        Spine& spine = MutableSpine();
+        for (NodePtr& node : spine) {
+            if (node.use_count() > 1) { node = std::make_shared<T>(*node); }
+        }
+    }
+
+    std::shared_ptr<Spine> m_spine; // Null when empty
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+// ============================================================================
+// THREADED_MIRROR_CONFIG.H - Mirror config snapshot used by the capture thread
+// ============================================================================
+// Plain value type (no GL), so code that only needs a mirror's settings does
+// not have to pull in mirror_thread.h.
+// ============================================================================
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Color, MirrorBorderType/Shape and MirrorCaptureConfig
+#include "config_types.h"
+
+// Named ThreadedMirrorConfig to avoid conflict with MirrorCaptureConfig in config_types.h
+struct ThreadedMirrorConfig {
+    std::string name;
+    int captureWidth = 0;
+    int captureHeight = 0;
+
+    // Border configuration
+    MirrorBorderType borderType = MirrorBorderType::Dynamic;
+    int dynamicBorderThickness = 0; // For dynamic border (shader-based)
+    // Static border settings (rendered if staticBorderThickness > 0)
+    MirrorBorderShape staticBorderShape = MirrorBorderShape::Rectangle;
+    Color staticBorderColor = { 1.0f, 1.0f, 1.0f };
+    int staticBorderThickness = 2;
+    int staticBorderRadius = 0;
+    int staticBorderOffsetX = 0;
+    int staticBorderOffsetY = 0;
+    int staticBorderWidth = 0;  // 0 = use mirror width
+    int staticBorderHeight = 0; // 0 = use mirror height
+
+    int fps = 0;
+    bool rawOutput = false;
+    bool colorPassthrough = false;   // If true, output original pixel color instead of Output Color when matching
+    bool contentStats = false;       // If true, read back at full resolution and publish MirrorContentStats
+    std::vector<Color> targetColors; // Multiple target colors - any matching pixel is shown
+    Color outputColor;
+    Color borderColor; // Border color for dynamic render shader
+    float colorSensitivity = 0.0f;
+    std::vector<MirrorCaptureConfig> input; // Uses MirrorCaptureConfig from config_types.h
+    std::chrono::steady_clock::time_point lastCaptureTime;
+
+    // Output positioning config (for pre-computing render cache)
+    float outputScale = 1.0f;
+    bool outputSeparateScale = false; // When true, use outputScaleX/Y instead of outputScale
+    float outputScaleX = 1.0f;        // X-axis scale
+    float outputScaleY = 1.0f;        // Y-axis scale
+    int outputX = 0, outputY = 0;
+    std::string outputRelativeTo;
+};
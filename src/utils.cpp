@@ -1,7 +1,10 @@
 #include "utils.h"
 #include "gui.h"
+#include "gzip_stream.h"
 #include "logic_thread.h"
+#include "metrics.h"
 #include "profiler.h"
+#include "ring_buffer.h"
 
 // From dllmain.cpp (declared in render.h)
 extern std::atomic<GLuint> g_cachedGameTextureId;
@@ -11,11 +14,11 @@ extern std::atomic<GLuint> g_cachedGameTextureId;
 #include <ShlObj.h>
 #include <Shlwapi.h>
 #include <algorithm>
-#include <array>
 #include <cctype>
 #include <csignal>
 #include <cstdint>
 #include <cstdlib>
+#include <ctime>
 #include <eh.h>
 #include <filesystem>
 #include <fstream>
@@ -181,331 +184,56 @@ extern "C" void abort() {
     TerminateProcess(GetCurrentProcess(), 3);
 }
 
-std::string GetTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-
-    struct tm timeinfo;
-    localtime_s(&timeinfo, &time_t);
-
-    std::stringstream ss;
-    ss << std::put_time(&timeinfo, "%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
-}
-
 // ============================================================================
 // GZIP LOG COMPRESSION
-// In-process gzip writer with real DEFLATE compression.
-// Uses a compact fixed-Huffman encoder + LZ77 matcher, no external tools.
+// Streams the file through GzipEncoder (gzip_stream.h) in fixed-size chunks,
+// so memory stays bounded however large the log grew.
 // ============================================================================
 
-static uint32_t g_crc32Table[256];
-static std::once_flag g_crc32InitFlag;
-
-static void InitCrc32Table() {
-    std::call_once(g_crc32InitFlag, []() {
-        for (uint32_t i = 0; i < 256; i++) {
-            uint32_t c = i;
-            for (int j = 0; j < 8; j++) { c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1); }
-            g_crc32Table[i] = c;
-        }
-    });
-}
-
-static uint32_t Crc32(const uint8_t* data, size_t size) {
-    InitCrc32Table();
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < size; i++) { crc = g_crc32Table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8); }
-    return crc ^ 0xFFFFFFFFu;
-}
-
 static bool FileExistsW(const std::wstring& path) {
     DWORD attrs = GetFileAttributesW(path.c_str());
     return (attrs != INVALID_FILE_ATTRIBUTES) && ((attrs & FILE_ATTRIBUTE_DIRECTORY) == 0);
 }
 
-static bool ReadFileBytes(const std::wstring& path, std::vector<uint8_t>& out) {
-    // IMPORTANT (Windows/Unicode): open via std::filesystem::path so wide Win32 APIs are used.
-    std::ifstream in(std::filesystem::path(path), std::ios::binary | std::ios::ate);
-    if (!in.is_open()) return false;
-
-    std::streamoff size = in.tellg();
-    if (size < 0) return false;
-    in.seekg(0, std::ios::beg);
-
-    out.resize(static_cast<size_t>(size));
-    if (!out.empty()) {
-        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
-        if (in.bad() || static_cast<size_t>(in.gcount()) != out.size()) return false;
-    }
-    return true;
-}
-
-static void WriteLE32(std::ofstream& out, uint32_t v) {
-    uint8_t b[4] = { (uint8_t)(v & 0xFFu), (uint8_t)((v >> 8) & 0xFFu), (uint8_t)((v >> 16) & 0xFFu), (uint8_t)((v >> 24) & 0xFFu) };
-    out.write(reinterpret_cast<const char*>(b), 4);
-}
-
-static uint16_t ReverseBits(uint16_t v, uint8_t bitCount) {
-    uint16_t r = 0;
-    for (uint8_t i = 0; i < bitCount; i++) {
-        r = static_cast<uint16_t>((r << 1) | (v & 1u));
-        v >>= 1;
-    }
-    return r;
-}
-
-struct HuffCode {
-    uint16_t code = 0; // bit-reversed for LSB-first bitstream writer
-    uint8_t bits = 0;
-};
-
-struct BitWriter {
-    std::vector<uint8_t> bytes;
-    uint32_t bitBuffer = 0;
-    int bitCount = 0;
-
-    void WriteBits(uint32_t value, int count) {
-        bitBuffer |= ((value & ((1u << count) - 1u)) << bitCount);
-        bitCount += count;
-        while (bitCount >= 8) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer >>= 8;
-            bitCount -= 8;
-        }
-    }
-
-    void FlushToByteBoundary() {
-        if (bitCount > 0) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer = 0;
-            bitCount = 0;
-        }
-    }
-};
-
-static void BuildCanonicalCodes(const uint8_t* lengths, size_t count, std::vector<HuffCode>& out) {
-    out.assign(count, {});
-
-    int blCount[16] = { 0 };
-    for (size_t i = 0; i < count; i++) {
-        if (lengths[i] > 0 && lengths[i] <= 15) blCount[lengths[i]]++;
-    }
-
-    int nextCode[16] = { 0 };
-    int code = 0;
-    for (int bits = 1; bits <= 15; bits++) {
-        code = (code + blCount[bits - 1]) << 1;
-        nextCode[bits] = code;
-    }
-
-    for (size_t symbol = 0; symbol < count; symbol++) {
-        uint8_t len = lengths[symbol];
-        if (len == 0) continue;
-        uint16_t c = static_cast<uint16_t>(nextCode[len]++);
-        out[symbol].bits = len;
-        out[symbol].code = ReverseBits(c, len);
-    }
-}
-
-static std::once_flag g_fixedCodesInitFlag;
-static std::vector<HuffCode> g_fixedLitLenCodes;
-static std::vector<HuffCode> g_fixedDistCodes;
-
-static void InitFixedCodes() {
-    std::call_once(g_fixedCodesInitFlag, []() {
-        std::array<uint8_t, 288> ll{};
-        for (int i = 0; i <= 143; i++) ll[i] = 8;
-        for (int i = 144; i <= 255; i++) ll[i] = 9;
-        for (int i = 256; i <= 279; i++) ll[i] = 7;
-        for (int i = 280; i <= 287; i++) ll[i] = 8;
-        BuildCanonicalCodes(ll.data(), ll.size(), g_fixedLitLenCodes);
-
-        std::array<uint8_t, 32> dd{};
-        dd.fill(5);
-        BuildCanonicalCodes(dd.data(), dd.size(), g_fixedDistCodes);
-    });
-}
-
-struct DeflateToken {
-    bool isMatch = false;
-    uint16_t literal = 0;
-    uint16_t length = 0;
-    uint16_t distance = 0;
-};
-
-static std::vector<DeflateToken> BuildLz77Tokens(const std::vector<uint8_t>& data) {
-    std::vector<DeflateToken> tokens;
-    tokens.reserve(data.size());
-
-    const size_t n = data.size();
-    size_t i = 0;
-    while (i < n) {
-        size_t bestLen = 0;
-        size_t bestDist = 0;
-
-        if (i + 3 <= n) {
-            const size_t windowStart = (i > 32768) ? (i - 32768) : 0;
-            size_t attempts = 0;
-
-            for (size_t j = i; j > windowStart && attempts < 2048;) {
-                --j;
-                if (data[j] != data[i]) continue;
-
-                const size_t maxLen = std::min<size_t>(258, n - i);
-                size_t len = 1;
-                while (len < maxLen && data[j + len] == data[i + len]) len++;
-
-                if (len >= 3 && len > bestLen) {
-                    bestLen = len;
-                    bestDist = i - j;
-                    if (len == 258) break;
-                }
-                attempts++;
-            }
-        }
-
-        if (bestLen >= 3) {
-            DeflateToken t;
-            t.isMatch = true;
-            t.length = static_cast<uint16_t>(bestLen);
-            t.distance = static_cast<uint16_t>(bestDist);
-            tokens.push_back(t);
-            i += bestLen;
-        } else {
-            DeflateToken t;
-            t.isMatch = false;
-            t.literal = data[i];
-            tokens.push_back(t);
-            i++;
-        }
-    }
-
-    return tokens;
-}
-
-static bool EncodeLength(uint16_t length, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
-                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
-    static const int kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
-
-    if (length < 3 || length > 258) return false;
-
-    for (int i = 0; i < 29; i++) {
-        int base = kLenBase[i];
-        int extra = kLenExtra[i];
-        int maxLen = base + ((1 << extra) - 1);
-        if (length >= base && length <= maxLen) {
-            outCode = 257 + i;
-            outExtraBits = extra;
-            outExtraValue = length - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool EncodeDistance(uint16_t distance, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
-                                       193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
-    static const int kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
-
-    if (distance < 1 || distance > 32768) return false;
-
-    for (int i = 0; i < 30; i++) {
-        int base = kDistBase[i];
-        int extra = kDistExtra[i];
-        int maxDist = base + ((1 << extra) - 1);
-        if (distance >= base && distance <= maxDist) {
-            outCode = i;
-            outExtraBits = extra;
-            outExtraValue = distance - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool WriteFixedDeflateStream(const std::vector<uint8_t>& input, std::vector<uint8_t>& outDeflate) {
-    InitFixedCodes();
-    if (g_fixedLitLenCodes.size() < 288 || g_fixedDistCodes.size() < 30) return false;
-
-    std::vector<DeflateToken> tokens = BuildLz77Tokens(input);
-
-    BitWriter w;
-    // Final block + fixed Huffman block type
-    w.WriteBits(1, 1);    // BFINAL
-    w.WriteBits(0b01, 2); // BTYPE=01 (fixed)
-
-    for (const DeflateToken& t : tokens) {
-        if (!t.isMatch) {
-            const HuffCode& hc = g_fixedLitLenCodes[t.literal];
-            w.WriteBits(hc.code, hc.bits);
-            continue;
-        }
-
-        int lenCode = 0, lenExtraBits = 0, lenExtraValue = 0;
-        int distCode = 0, distExtraBits = 0, distExtraValue = 0;
-
-        if (!EncodeLength(t.length, lenCode, lenExtraBits, lenExtraValue)) return false;
-        if (!EncodeDistance(t.distance, distCode, distExtraBits, distExtraValue)) return false;
-
-        const HuffCode& lenH = g_fixedLitLenCodes[lenCode];
-        w.WriteBits(lenH.code, lenH.bits);
-        if (lenExtraBits > 0) w.WriteBits(static_cast<uint32_t>(lenExtraValue), lenExtraBits);
-
-        const HuffCode& distH = g_fixedDistCodes[distCode];
-        w.WriteBits(distH.code, distH.bits);
-        if (distExtraBits > 0) w.WriteBits(static_cast<uint32_t>(distExtraValue), distExtraBits);
-    }
-
-    // End of block symbol
-    const HuffCode& eob = g_fixedLitLenCodes[256];
-    w.WriteBits(eob.code, eob.bits);
-    w.FlushToByteBoundary();
-
-    outDeflate = std::move(w.bytes);
-    return true;
-}
-
 bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath) {
     if (!FileExistsW(srcPath)) return false;
 
-    std::vector<uint8_t> input;
-    if (!ReadFileBytes(srcPath, input)) return false;
-
-    std::vector<uint8_t> deflate;
-    if (!WriteFixedDeflateStream(input, deflate)) return false;
+    // IMPORTANT (Windows/Unicode): open via std::filesystem::path so wide Win32 APIs are used.
+    std::ifstream in(std::filesystem::path(srcPath), std::ios::binary);
+    if (!in.is_open()) return false;
 
     std::wstring tempPath = dstPath + L".tmp";
     DeleteFileW(tempPath.c_str());
 
-    // IMPORTANT (Windows/Unicode): open via std::filesystem::path so wide Win32 APIs are used.
     std::ofstream out(std::filesystem::path(tempPath), std::ios::binary | std::ios::trunc);
     if (!out.is_open()) return false;
 
-    // Gzip header (RFC 1952)
-    const uint8_t hdr[10] = {
-        0x1F, 0x8B,             // ID1, ID2
-        0x08,                   // CM=deflate
-        0x00,                   // FLG
-        0x00, 0x00, 0x00, 0x00, // MTIME
-        0x00,                   // XFL
-        0x0B                    // OS=NTFS/Windows
-    };
-    out.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
-    if (!deflate.empty()) out.write(reinterpret_cast<const char*>(deflate.data()), static_cast<std::streamsize>(deflate.size()));
-
-    const uint32_t crc = Crc32(input.data(), input.size());
-    WriteLE32(out, crc);
-    WriteLE32(out, static_cast<uint32_t>(input.size() & 0xFFFFFFFFu));
+    constexpr size_t kChunkSize = 64 * 1024;
+    std::vector<uint8_t> chunk(kChunkSize);
+    std::vector<uint8_t> compressed;
+    compressed.reserve(2 * kChunkSize);
+    GzipEncoder encoder;
+    bool good = true;
+    while (good) {
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        const size_t n = static_cast<size_t>(in.gcount());
+        good = !in.bad();
+        if (!good || n == 0) break;
+        encoder.Write(chunk.data(), n, compressed);
+        if (compressed.size() >= kChunkSize) {
+            out.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+            compressed.clear();
+            good = out.good();
+        }
+    }
+    in.close();
 
-    out.flush();
-    bool good = out.good();
+    if (good) {
+        encoder.Finish(compressed);
+        out.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+        out.flush();
+        good = out.good();
+    }
     out.close();
     if (!good) {
         DeleteFileW(tempPath.c_str());
@@ -520,23 +248,54 @@ bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath
     return true;
 }
 
+// <toolscreen>/traces/<prefix>-YYYYMMDD-HHMMSS<extension>
+bool WriteDiagnosticsFile(const char* prefix, const char* extension, const std::string& contents, std::filesystem::path& pathOut) {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "-%Y%m%d-%H%M%S", &local);
+    const std::string baseName = prefix + std::string(stamp);
+
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::path(g_toolscreenPath) / "traces";
+    std::filesystem::create_directories(dir, ec);
+    pathOut = dir / (baseName + extension);
+    for (int suffix = 2; std::filesystem::exists(pathOut, ec); ++suffix) { // Several dumps within one second
+        pathOut = dir / (baseName + "-" + std::to_string(suffix) + extension);
+    }
+    std::ofstream file(pathOut, std::ios::binary | std::ios::trunc);
+    return file && file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+bool WriteToolscreenFile(const wchar_t* fileName, const std::string& contents) {
+    if (g_toolscreenPath.empty()) return false;
+    const std::filesystem::path finalPath = std::filesystem::path(g_toolscreenPath) / fileName;
+    std::filesystem::path tempPath = finalPath;
+    tempPath += L".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(contents.data(), static_cast<std::streamsize>(contents.size()))) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, finalPath, ec);
+    return !ec;
+}
+
 // ASYNC LOGGING SYSTEM
-// Uses a lock-free ring buffer for zero-contention log submission.
-// A background thread writes to disk every 500ms.
+// Uses a lock-free ring buffer of fixed-size records (log_record.h) for zero-contention log submission.
+// A background thread formats pending records and writes them to disk in one batch every 50ms.
 // FlushLogs() force-writes all pending messages (for crash/shutdown).
 
-// Pre-formatted log entry with timestamp already applied
-struct LogEntry {
-    std::atomic<bool> ready{ false }; // True when data is fully written and can be read
-    std::string formattedMessage;     // "[HH:MM:SS.mmm] message"
-};
-
-// Lock-free ring buffer for log entries
-// Uses two-phase commit: claim slot with CAS, mark ready after write
-static constexpr size_t LOG_BUFFER_SIZE = 8192; // Power of 2 for fast modulo
-static LogEntry g_logBuffer[LOG_BUFFER_SIZE];
-static std::atomic<size_t> g_logClaimIndex{ 0 }; // Next position to claim (writers)
-static std::atomic<size_t> g_logReadIndex{ 0 };  // Next position to read (reader)
+// Lock-free MPSC ring of unformatted records (timestamp + site + arguments, or short preformatted text)
+// Any thread may log; the single consumer is whoever holds g_logFileMutex (log thread or FlushLogs).
+static constexpr size_t LOG_BUFFER_SIZE = 8192; // Must be a power of 2
+static MpscRing<LogRecord, LOG_BUFFER_SIZE> g_logBuffer;
+static const MetricId g_metricLogDropped = RegisterMetric("log.lines_dropped", MetricKind::Counter, "Log lines lost to a full log ring");
 
 // Background writer thread
 static std::thread g_logThread;
@@ -569,104 +328,66 @@ static void LogThreadMain() {
 
 // Internal: Write all pending log entries to file (called by background thread or FlushLogs)
 static void WriteLogsToFile() {
-    size_t readPos = g_logReadIndex.load(std::memory_order_relaxed);
-    size_t claimPos = g_logClaimIndex.load(std::memory_order_acquire);
-
-    if (readPos == claimPos) return; // Nothing claimed yet
+    if (g_logBuffer.EmptyApprox()) return;
 
     // Lock only during actual file I/O (not during Log() calls)
     std::lock_guard<std::mutex> lock(g_logFileMutex);
-    if (!logFile.is_open()) return;
-
-    // Process all ready entries in order
-    // Note: entries might be claimed but not yet ready if writer is mid-write
-    while (readPos != claimPos) {
-        LogEntry& entry = g_logBuffer[readPos % LOG_BUFFER_SIZE];
-
-        // Wait for this slot to be ready (writer finished)
-        // Use relaxed load in tight loop, acquire synchronizes with writer's release
-        if (!entry.ready.load(std::memory_order_acquire)) {
-            // Entry not ready yet - stop here, will continue next flush
-            // This handles out-of-order completion
-            break;
-        }
-
-        logFile << entry.formattedMessage << std::endl;
-
-        // Clear ready flag for next use of this slot
-        entry.ready.store(false, std::memory_order_relaxed);
-
-        readPos = (readPos + 1) % LOG_BUFFER_SIZE;
-    }
+    if (!logFile.is_open()) return; // Keep entries queued until the file is available
+
+    // Format the whole batch, then write and flush once. The batch buffer keeps its capacity (guarded by the mutex).
+    // Entries still being written by a producer stop the batch; they're picked up next flush
+    static std::string batch;
+    batch.clear();
+    g_logBuffer.ConsumeAll([](LogRecord& record) {
+        AppendLogRecordLine(record, batch);
+        delete record.overflowText;
+        record.overflowText = nullptr;
+    });
 
+    logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
     logFile.flush();
-    g_logReadIndex.store(readPos, std::memory_order_release);
 }
 
 // Force flush all pending logs - call during crash/shutdown
 void FlushLogs() { WriteLogsToFile(); }
 
+void UpdateLogCategoryMask(const DebugGlobalConfig& debug) {
+    auto bit = [](LogCat category, bool enabled) { return enabled ? 1u << static_cast<uint32_t>(category) : 0u; };
+    const uint32_t mask = bit(LogCat::ModeSwitch, debug.logModeSwitch) | bit(LogCat::Animation, debug.logAnimation) |
+                          bit(LogCat::Hotkey, debug.logHotkey) | bit(LogCat::Obs, debug.logObs) |
+                          bit(LogCat::WindowOverlay, debug.logWindowOverlay) | bit(LogCat::FileMonitor, debug.logFileMonitor) |
+                          bit(LogCat::ImageMonitor, debug.logImageMonitor) | bit(LogCat::Performance, debug.logPerformance) |
+                          bit(LogCat::TextureOps, debug.logTextureOps) | bit(LogCat::Gui, debug.logGui) | bit(LogCat::Init, debug.logInit) |
+                          bit(LogCat::CursorTextures, debug.logCursorTextures);
+    g_logCategoryMask.store(mask, std::memory_order_relaxed);
+}
+
 // Category-based logging - only logs if category is enabled in debug config
-void LogCategory(const char* category, const std::string& message) {
-    // Check if category is enabled
-    bool enabled = false;
-    if (strcmp(category, "mode_switch") == 0)
-        enabled = g_config.debug.logModeSwitch;
-    else if (strcmp(category, "animation") == 0)
-        enabled = g_config.debug.logAnimation;
-    else if (strcmp(category, "hotkey") == 0)
-        enabled = g_config.debug.logHotkey;
-    else if (strcmp(category, "obs") == 0)
-        enabled = g_config.debug.logObs;
-    else if (strcmp(category, "window_overlay") == 0)
-        enabled = g_config.debug.logWindowOverlay;
-    else if (strcmp(category, "file_monitor") == 0)
-        enabled = g_config.debug.logFileMonitor;
-    else if (strcmp(category, "image_monitor") == 0)
-        enabled = g_config.debug.logImageMonitor;
-    else if (strcmp(category, "performance") == 0)
-        enabled = g_config.debug.logPerformance;
-    else if (strcmp(category, "texture_ops") == 0)
-        enabled = g_config.debug.logTextureOps;
-    else if (strcmp(category, "gui") == 0)
-        enabled = g_config.debug.logGui;
-    else if (strcmp(category, "init") == 0)
-        enabled = g_config.debug.logInit;
-    else if (strcmp(category, "cursor_textures") == 0)
-        enabled = g_config.debug.logCursorTextures;
-
-    if (!enabled) return;
+void LogCategory(LogCat category, const std::string& message) {
+    if (!IsLogCategoryEnabled(category)) return;
     Log(message); // Use standard Log for actual output
 }
 
-// True lock-free log submission using two-phase commit:
-// 1. Atomically claim a slot with CAS on g_logClaimIndex
-// 2. Write data to the claimed slot
-// 3. Mark slot as ready (signals reader that data is complete)
-void Log(const std::string& message) {
-    // Format with timestamp before entering critical path
-    std::string formatted = "[" + GetTimestamp() + "] " + message;
-
-    // Atomically claim a slot using CAS loop
-    size_t claimPos, nextClaimPos;
-    do {
-        claimPos = g_logClaimIndex.load(std::memory_order_relaxed);
-        nextClaimPos = (claimPos + 1) % LOG_BUFFER_SIZE;
-
-        // Check if buffer is full (would overwrite unread data)
-        if (nextClaimPos == g_logReadIndex.load(std::memory_order_acquire)) {
-            // Buffer full - drop this message (better than blocking)
-            return;
-        }
-        // Try to atomically claim this slot by advancing claimIndex
-    } while (!g_logClaimIndex.compare_exchange_weak(claimPos, nextClaimPos, std::memory_order_acq_rel, std::memory_order_relaxed));
-
-    // We successfully claimed slot 'claimPos' - write data
-    LogEntry& entry = g_logBuffer[claimPos % LOG_BUFFER_SIZE];
-    entry.formattedMessage = std::move(formatted);
+// Lock-free log submission: producers claim a ring slot with CAS and publish it when the record is in place
+void SubmitLogRecord(const LogRecord& record) {
+    // Buffer full - drop this message (better than blocking)
+    if (!g_logBuffer.Push(record)) {
+        delete record.overflowText;
+        MetricAdd(g_metricLogDropped);
+    }
+}
 
-    // Mark slot as ready (release ensures data write is visible before ready flag)
-    entry.ready.store(true, std::memory_order_release);
+// Preformatted text: copied into the record payload (heap only when longer than the payload), timestamp formatted later
+void Log(const std::string& message) {
+    LogRecord record;
+    record.timestamp = LogTimestampNow();
+    if (message.size() <= LOG_RECORD_PAYLOAD_BYTES) {
+        std::memcpy(record.payload, message.data(), message.size());
+        record.payloadSize = static_cast<uint16_t>(message.size());
+    } else {
+        record.overflowText = new std::string(message);
+    }
+    SubmitLogRecord(record);
 }
 
 void Log(const std::wstring& message) { Log(WideToUtf8(message)); }
@@ -985,7 +706,7 @@ void WriteCurrentModeToFile(const std::string& modeId) {
 bool SwitchToMode(const std::string& newModeId, const std::string& source, bool forceCut) {
     PROFILE_SCOPE_CAT("Mode Switch", "Mode Management");
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
+    LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
 
     if (newModeId.empty()) {
         Log("ERROR: Attempted to switch to empty mode ID");
@@ -1011,11 +732,11 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
 
     std::string currentMode;
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Acquiring g_modeIdMutex...");
+    LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] Acquiring g_modeIdMutex...");
     // Get current mode - keep lock minimal, no I/O inside
     {
         std::lock_guard<std::mutex> lock(g_modeIdMutex);
-        LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex acquired");
+        LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] g_modeIdMutex acquired");
         currentMode = g_currentModeId;
 
         // Don't switch if we're already in the target mode
@@ -1025,20 +746,19 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
         }
 
         g_currentModeId = newModeId;
-        // Update lock-free double-buffer for input handlers
-        int nextIndex = 1 - g_currentModeIdIndex.load(std::memory_order_relaxed);
-        g_modeIdBuffers[nextIndex] = newModeId;
-        g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
-        LogCategory("mode_switch", "[MODE_SWITCH] g_currentModeId updated to: " + newModeId);
+        // Publish the interned handle for lock-free readers (input handlers, game thread)
+        g_currentModeHandle.store(InternModeId(newModeId), std::memory_order_release);
+        LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] g_currentModeId updated to: " + newModeId);
     }
-    LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex released");
+    LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] g_modeIdMutex released");
+    RefreshEffectiveMouseSensitivity();
 
     // Async file write OUTSIDE the mutex - never blocks
     WriteCurrentModeToFile(newModeId);
 
     std::string logMessage = "[MODE] Switching from '" + currentMode + "' to '" + newModeId + "'";
     if (!source.empty()) { logMessage += " (source: " + source + ")"; }
-    LogCategory("mode_switch", logMessage);
+    LogCategory(LogCat::ModeSwitch, logMessage);
 
     // Read mode configurations to get dimensions/positions
     int fromWidth = 0, fromHeight = 0, fromX = 0, fromY = 0;
@@ -1079,7 +799,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
                 // We need to defer this calculation, so we'll just mark that we need to scale
             }
 
-            LogCategory("mode_switch",
+            LogCategory(LogCat::ModeSwitch,
                         "[MODE_SWITCH] Active transition detected - using current animated position: " + std::to_string(fromWidth) + "x" +
                             std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY));
         }
@@ -1143,8 +863,9 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
             toModeCopy.overlayTransition = OverlayTransitionType::Cut;
             toModeCopy.backgroundTransition = BackgroundTransitionType::Cut;
         }
-        LogCategory("mode_switch", "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
-                                       std::to_string(fromHeight) + ", to: " + std::to_string(toWidth) + "x" + std::to_string(toHeight));
+        LogCategory(LogCat::ModeSwitch,
+                    "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
+                    std::to_string(fromHeight) + ", to: " + std::to_string(toWidth) + "x" + std::to_string(toHeight));
     }
 
     // If we're reversing mid-animation, scale the duration based on distance ratio
@@ -1182,7 +903,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
                 int originalDuration = toModeCopy.transitionDurationMs;
                 toModeCopy.transitionDurationMs = static_cast<int>(originalDuration * distanceRatio);
 
-                LogCategory("mode_switch",
+                LogCategory(LogCat::ModeSwitch,
                             "[MODE_SWITCH] Mid-animation reversal: scaling duration from " + std::to_string(originalDuration) + "ms to " +
                                 std::to_string(toModeCopy.transitionDurationMs) + "ms (ratio: " + std::to_string(distanceRatio) + ")");
             }
@@ -1197,12 +918,12 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
     }
 
     // Start animated transition (handles size interpolation and WM_SIZE messages)
-    LogCategory("mode_switch",
+    LogCategory(LogCat::ModeSwitch,
                 "[MODE_SWITCH] Calling StartModeTransition with Game:" + GameTransitionTypeToString(toModeCopy.gameTransition) +
                     ", Overlay:" + OverlayTransitionTypeToString(toModeCopy.overlayTransition) +
                     ", Bg:" + BackgroundTransitionTypeToString(toModeCopy.backgroundTransition));
     StartModeTransition(currentMode, newModeId, fromWidth, fromHeight, fromX, fromY, toWidth, toHeight, toX, toY, toModeCopy);
-    LogCategory("mode_switch", "[MODE_SWITCH] StartModeTransition completed");
+    LogCategory(LogCat::ModeSwitch, "[MODE_SWITCH] StartModeTransition completed");
 
     return true; // Mode was changed
 }
@@ -1220,12 +941,16 @@ bool IsFullscreen() {
         return r.left == 0 && r.top == 0 && r.right == GetCachedScreenWidth() && r.bottom == GetCachedScreenHeight();
     }
 
+    return IsWindowRectFullscreen(r, monRect);
+}
+
+bool IsWindowRectFullscreen(const RECT& windowRect, const RECT& monitorRect) {
     // Borderless windows can be off by a pixel due to DPI rounding or driver quirks.
     const int tol = 1;
-    const bool leftOk = std::abs(r.left - monRect.left) <= tol;
-    const bool topOk = std::abs(r.top - monRect.top) <= tol;
-    const bool rightOk = std::abs(r.right - monRect.right) <= tol;
-    const bool bottomOk = std::abs(r.bottom - monRect.bottom) <= tol;
+    const bool leftOk = std::abs(windowRect.left - monitorRect.left) <= tol;
+    const bool topOk = std::abs(windowRect.top - monitorRect.top) <= tol;
+    const bool rightOk = std::abs(windowRect.right - monitorRect.right) <= tol;
+    const bool bottomOk = std::abs(windowRect.bottom - monitorRect.bottom) <= tol;
     return leftOk && topOk && rightOk && bottomOk;
 }
 
@@ -1271,12 +996,6 @@ bool IsHardcodedMode(const std::string& id) {
            EqualsIgnoreCase(id, "Thin") || EqualsIgnoreCase(id, "Wide");
 }
 
-bool EqualsIgnoreCase(const std::string& a, const std::string& b) {
-    if (a.size() != b.size()) { return false; }
-
-    return std::equal(a.begin(), a.end(), b.begin(), [](char a, char b) { return std::tolower(a) == std::tolower(b); });
-}
-
 // Internal version - requires g_configMutex to already be held
 const ModeConfig* GetMode_Internal(const std::string& id) {
     for (const auto& mode : g_config.modes) {
@@ -1301,21 +1020,6 @@ MirrorConfig* GetMutableMirror(const std::string& name) {
     return nullptr;
 }
 
-// Snapshot-safe overloads: look up in a specific config snapshot instead of g_config
-const ModeConfig* GetModeFromSnapshot(const Config& config, const std::string& id) {
-    for (const auto& mode : config.modes) {
-        if (EqualsIgnoreCase(mode.id, id)) return &mode;
-    }
-    return nullptr;
-}
-
-const MirrorConfig* GetMirrorFromSnapshot(const Config& config, const std::string& name) {
-    for (const auto& mirror : config.mirrors) {
-        if (mirror.name == name) return &mirror;
-    }
-    return nullptr;
-}
-
 bool isWallTitleOrWaiting(const std::string& state) {
     return state == "wall" || state == "title" || state == "waiting" || state.rfind("generating", 0) == 0;
 }
@@ -1323,12 +1027,12 @@ bool isWallTitleOrWaiting(const std::string& state) {
 // Uses config snapshot for thread-safe mode lookup + lock-free mode ID
 ModeViewportInfo GetCurrentModeViewport_Internal() {
     ModeViewportInfo info;
-    // Lock-free read of current mode ID from double-buffer
-    std::string modeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+    // Lock-free read of current mode
+    const ModeHandle modeHandle = g_currentModeHandle.load(std::memory_order_acquire);
 
     // Use snapshot for thread-safe mode config lookup (called from multiple threads)
     auto vpSnap = GetConfigSnapshot();
-    const ModeConfig* mode = vpSnap ? GetModeFromSnapshot(*vpSnap, modeId) : nullptr;
+    const ModeConfig* mode = vpSnap ? GetModeFromSnapshot(*vpSnap, modeHandle) : nullptr;
     if (!mode) {
         return info; // valid = false
     }
@@ -1533,6 +1237,14 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
     }).detach();
 }
 
+bool ImageFileExists(const std::string& path, const std::wstring& toolscreenPath) {
+    if (path.empty()) return false;
+    std::wstring image_wpath = Utf8ToWide(path);
+    if (PathIsRelativeW(image_wpath.c_str()) && !toolscreenPath.empty()) { image_wpath = toolscreenPath + L"\\" + image_wpath; }
+    const DWORD attributes = GetFileAttributesW(image_wpath.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
 void LoadAllImages() {
     PROFILE_SCOPE_CAT("Load All Images", "IO Operations");
     if (g_allImagesLoaded) {
@@ -1546,8 +1258,8 @@ void LoadAllImages() {
     std::vector<ImageConfig> imagesToLoad;
 
     {
-        modesToLoad = g_config.modes;
-        imagesToLoad = g_config.images;
+        modesToLoad = g_config.modes.ToVector();
+        imagesToLoad = g_config.images.ToVector();
     }
 
     for (const auto& mode : modesToLoad) {
@@ -1562,6 +1274,8 @@ void LoadAllImages() {
     }
 }
 
+std::string GetCurrentGameState() { return std::string(g_gameState.Load().text); }
+
 DWORD WINAPI FileMonitorThread(LPVOID lpParam) {
     _set_se_translator(SEHTranslator);
 
@@ -1642,12 +1356,11 @@ DWORD WINAPI FileMonitorThread(LPVOID lpParam) {
                             content = IsCursorVisible() ? "inworld,cursor_free" : "inworld,cursor_grabbed";
                         }
 
-                        int currentIdx = g_currentGameStateIndex.load(std::memory_order_acquire);
-                        if (g_gameStateBuffers[currentIdx] != content) {
-                            int nextIdx = 1 - currentIdx;
-                            g_gameStateBuffers[nextIdx] = content;
-                            g_currentGameStateIndex.store(nextIdx, std::memory_order_release);
-                        }
+                        g_gameState.Update([&content](GameStateText& state) {
+                            if (content == state.text) return false;
+                            state = GameStateText::From(content);
+                            return true;
+                        });
                     }
                 }
             }
@@ -1680,6 +1393,9 @@ DWORD WINAPI ImageMonitorThread(LPVOID lpParam) {
             // Slow this down; hot-reload is still "fast enough" for typical use.
             Sleep(250);
 
+            // Hand edits to config.toml are picked up on the same cadence
+            PollConfigFileForEdits();
+
             // Use snapshot to avoid racing GUI edits and to allow future lock-free snapshot impls.
             auto cfgSnap = GetConfigSnapshot();
             if (!cfgSnap) { continue; }
@@ -1959,92 +1675,6 @@ bool CheckHotkeyMatch(const std::vector<DWORD>& keys, WPARAM wParam, const std::
     return true;
 }
 
-void GetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX, int& outY) {
-    // Strip Viewport/Screen suffix if present to get base anchor name
-    std::string anchor = type;
-    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") {
-        anchor = anchor.substr(0, anchor.length() - 8);
-    } else if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
-        anchor = anchor.substr(0, anchor.length() - 6);
-    }
-
-    // Optimize by checking first character to reduce string comparisons
-    char firstChar = anchor.empty() ? '\0' : anchor[0];
-
-    if (firstChar == 't') { // "topLeft" or "topRight"
-        outY = relY;
-        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
-    } else if (firstChar == 'c') { // "center"
-        outX = (containerW - w) / 2 + relX;
-        outY = (containerH - h) / 2 + relY;
-    } else if (firstChar == 'p') { // "pieLeft" or "pieRight"
-        const int PIE_Y_TOP = 220, PIE_X_LEFT = 92, PIE_X_RIGHT = 36;
-        int base_x = (anchor == "pieLeft") ? containerW - PIE_X_LEFT : containerW - PIE_X_RIGHT;
-        outX = base_x + relX;
-        outY = containerH - PIE_Y_TOP + relY;
-    } else { // "bottomLeft" or "bottomRight"
-        outY = containerH - h - relY;
-        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
-    }
-}
-
-void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
-                               int& outY) {
-    int anchor_x = 0, anchor_y = 0;
-    // Optimize by checking first character to reduce string comparisons
-    char firstChar = type.empty() ? '\0' : type[0];
-
-    if (firstChar == 't') { // "topLeft" or "topRight"
-        anchor_x = (type == "topLeft") ? 0 : containerW - w;
-        anchor_y = 0;
-    } else if (firstChar == 'c') { // "center"
-        anchor_x = (containerW - w) / 2;
-        anchor_y = (containerH - h) / 2;
-    } else if (firstChar == 'b') { // "bottomLeft" or "bottomRight"
-        anchor_x = (type == "bottomLeft") ? 0 : containerW - w;
-        anchor_y = containerH - h;
-    }
-
-    outX = anchor_x + relX;
-    outY = anchor_y + relY;
-}
-
-// Get relative coordinates with viewport-aware positioning
-// For "Viewport" suffixed types: position relative to game viewport (animates with game)
-// For "Screen" suffixed types: position relative to screen (does not animate)
-void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
-                                           int gameH, int fullW, int fullH, int& outX, int& outY) {
-    // Check if this is a viewport-relative anchor (ends with "Viewport")
-    if (type.length() > 8 && type.substr(type.length() - 8) == "Viewport") {
-        // Strip the "Viewport" suffix to get the base anchor name
-        std::string baseAnchor = type.substr(0, type.length() - 8);
-
-        // Calculate position relative to game viewport
-        int anchor_x = 0, anchor_y = 0;
-        char firstChar = baseAnchor.empty() ? '\0' : baseAnchor[0];
-
-        if (firstChar == 't') { // "topLeft" or "topRight"
-            anchor_x = (baseAnchor == "topLeft") ? 0 : gameW - w;
-            anchor_y = 0;
-        } else if (firstChar == 'c') { // "center"
-            anchor_x = (gameW - w) / 2;
-            anchor_y = (gameH - h) / 2;
-        } else if (firstChar == 'b') { // "bottomLeft" or "bottomRight"
-            anchor_x = (baseAnchor == "bottomLeft") ? 0 : gameW - w;
-            anchor_y = gameH - h;
-        }
-
-        // Position is relative to game viewport origin
-        outX = gameX + anchor_x + relX;
-        outY = gameY + anchor_y + relY;
-    } else {
-        // Screen-relative: strip "Screen" suffix if present and use screen dimensions
-        std::string baseAnchor = type;
-        if (type.length() > 6 && type.substr(type.length() - 6) == "Screen") { baseAnchor = type.substr(0, type.length() - 6); }
-        GetRelativeCoordsForImage(baseAnchor, relX, relY, w, h, fullW, fullH, outX, outY);
-    }
-}
-
 void CalculateFinalScreenPos(const MirrorConfig* conf, const MirrorInstance& inst, int gameW, int gameH, int finalX, int finalY, int finalW,
                              int finalH, int fullW, int fullH, int& outScreenX, int& outScreenY) {
     float scaleX = conf->output.separateScale ? conf->output.scaleX : conf->output.scale;
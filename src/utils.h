@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <mutex>
 #include <shared_mutex>
@@ -16,7 +17,11 @@
 #include <vector>
 #include <windows.h>
 
+#include "config_lookup.h"
+#include "diagnostics_file.h"
 #include "gui.h"
+#include "log_record.h"
+#include "relative_coords.h"
 
 // Config access: Reader threads use GetConfigSnapshot() for safe, lock-free access.
 // g_config is the mutable draft, only touched by the GUI/main thread.
@@ -303,40 +308,27 @@ extern std::atomic<bool> g_allImagesLoaded;
 extern std::mutex g_decodedImagesMutex;
 extern std::vector<DecodedImageData> g_decodedImagesQueue;
 extern std::atomic<HWND> g_minecraftHwnd;
-extern std::string g_gameStateBuffers[2];
-extern std::atomic<int> g_currentGameStateIndex;
-extern std::mutex g_hotkeyMainKeysMutex;
 extern std::atomic<HCURSOR> g_specialCursorHandle;
 
-void Log(const std::string& message);
-void Log(const std::wstring& message);
-
-// Async logging system
+// Async logging system (Log() itself is declared in log_record.h)
 void StartLogThread(); // Start background log writer thread
 void StopLogThread();  // Stop background log writer thread (flushes first)
 void FlushLogs();      // Force flush all pending logs (for crash/shutdown)
 
-// Category-based logging - only logs if category is enabled in debug config
-// Categories: "mode_switch", "animation", "hotkey", "obs", "window_overlay",
-//             "file_monitor", "image_monitor", "performance"
-void LogCategory(const char* category, const std::string& message);
+// Category-based logging - only logs if category is enabled in debug config (atomic mask, see log_record.h).
+// The message is built by the caller either way; prefer LOG_FMT_CAT on hot paths.
+void LogCategory(LogCat category, const std::string& message);
+// Mirrors the debug.log* switches into the category mask. Called whenever a config snapshot is published.
+void UpdateLogCategoryMask(const DebugGlobalConfig& debug);
 
 std::wstring Utf8ToWide(const std::string& utf8_string);
 std::string WideToUtf8(const std::wstring& wstr);
 std::wstring GetToolscreenPath();
 
-// Compress a file to gzip format (.gz) using in-process DEFLATE compression.
+// Compress a file to gzip format (.gz) with the streaming encoder in gzip_stream.h (bounded memory, read in chunks).
 // Returns true on success.
 bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath);
 
-inline std::string GetKeyComboString(const std::vector<DWORD>& keys) {
-    std::string keyStr;
-    for (size_t k = 0; k < keys.size(); ++k) {
-        keyStr += VkToString(keys[k]);
-        if (k < keys.size() - 1) keyStr += "+";
-    }
-    return keyStr;
-}
 
 struct ModeViewportInfo {
     bool valid = false;
@@ -359,6 +351,8 @@ bool GetMonitorRectForWindow(HWND hwnd, RECT& outRect);
 bool GetMonitorSizeForWindow(HWND hwnd, int& outW, int& outH);
 
 bool IsFullscreen();
+// True when the window rect covers the monitor rect (1px tolerance). Shared by IsFullscreen() and the geometry cache.
+bool IsWindowRectFullscreen(const RECT& windowRect, const RECT& monitorRect);
 // Toggle borderless-windowed fullscreen for the given window.
 // When toggling on, the window is resized to the current monitor's full rect and decorations are removed.
 // When toggling off, the window returns to windowed mode centered on the current monitor at half its width/height.
@@ -367,15 +361,11 @@ bool IsCursorVisible();
 void WriteCurrentModeToFile(const std::string& modeId);
 bool SwitchToMode(const std::string& newModeId, const std::string& source = "", bool forceCut = false);
 bool IsHardcodedMode(const std::string& modeId);
-bool EqualsIgnoreCase(const std::string& a, const std::string& b);
 const ModeConfig* GetMode(const std::string& id);
 const ModeConfig* GetMode_Internal(const std::string& id); // Direct access version
 ModeConfig* GetModeMutable(const std::string& id);         // Mutable version for modifications
 MirrorConfig* GetMutableMirror(const std::string& name);
 
-// Snapshot-safe overloads: look up in a specific config snapshot instead of g_config
-const ModeConfig* GetModeFromSnapshot(const Config& config, const std::string& id);
-const MirrorConfig* GetMirrorFromSnapshot(const Config& config, const std::string& name);
 bool isWallTitleOrWaiting(const std::string& state);
 ModeViewportInfo GetCurrentModeViewport();
 ModeViewportInfo GetCurrentModeViewport_Internal(); // Lock-free implementation using double-buffered mode ID
@@ -385,27 +375,14 @@ GLuint CreateShaderProgram(const char* vert, const char* frag);
 
 void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string path, const std::wstring& toolscreenPath);
 void LoadAllImages();
+// True if path (relative paths resolve against toolscreenPath, as in LoadImageAsync) names an existing file
+bool ImageFileExists(const std::string& path, const std::wstring& toolscreenPath);
 
 bool CheckHotkeyMatch(const std::vector<DWORD>& keys, WPARAM wParam, const std::vector<DWORD>& exclusionKeys = {},
                       bool triggerOnRelease = false);
 
 void BackupConfigFile();
 
-void GetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX, int& outY);
-void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
-                               int& outY);
-// Overload that supports viewport-relative positioning (for anchors ending with "Viewport")
-// gameX/Y/W/H = current game viewport position on screen (may be animated)
-// fullW/H = screen dimensions
-void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
-                                           int gameH, int fullW, int fullH, int& outX, int& outY);
-
-// Check if an anchor type is viewport-relative (positions relative to game viewport, animates during transitions)
-inline bool IsViewportRelativeAnchor(const std::string& relativeTo) {
-    // Viewport-relative anchors end with "Viewport"
-    if (relativeTo.length() > 8 && relativeTo.substr(relativeTo.length() - 8) == "Viewport") { return true; }
-    return false;
-}
 void CalculateFinalScreenPos(const MirrorConfig* conf, const MirrorInstance& inst, int gameW, int gameH, int finalX, int finalY, int finalW,
                              int finalH, int fullW, int fullH, int& outScreenX, int& outScreenY);
 
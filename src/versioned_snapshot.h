@@ -0,0 +1,136 @@
+#pragma once
+
+// ============================================================================
+// VERSIONED_SNAPSHOT.H - Seqlock-published value for lock-free readers
+// ============================================================================
+// Replaces the "write the inactive slot, flip an index" double buffers. Those
+// let two back-to-back writes land in the slot a slow reader is still copying,
+// tearing its view. Here the payload lives in one slot guarded by a sequence
+// counter: writers make it odd while storing and even when done; readers copy
+// the payload and retry if the sequence was odd or moved during the copy.
+//
+// - Readers never block and never write shared memory.
+// - Writers are serialized by claiming the odd sequence with a CAS, so
+//   multiple writer threads are safe (a writer waits only for another writer).
+// - The payload must be trivially copyable. It is stored as relaxed atomic
+//   words so a torn copy is a retry, never a data race.
+// - Version() / Load(&version) expose the publish count (sequence / 2), which
+//   lets readers skip work when nothing changed.
+// ============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline void SnapshotCpuRelax() {
+#if defined(_MSC_VER)
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+template <typename T> class VersionedSnapshot {
+    static_assert(std::is_trivially_copyable<T>::value, "VersionedSnapshot payload must be trivially copyable");
+    static_assert(std::is_default_constructible<T>::value, "VersionedSnapshot payload must be default constructible");
+
+    static constexpr size_t kWordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    VersionedSnapshot() : VersionedSnapshot(T{}) {}
+    explicit VersionedSnapshot(const T& initial) { StoreWords(initial); }
+
+    VersionedSnapshot(const VersionedSnapshot&) = delete;
+    VersionedSnapshot& operator=(const VersionedSnapshot&) = delete;
+
+    // Consistent copy of the latest published value
+    T Load() const {
+        uint64_t version;
+        return Load(version);
+    }
+
+    T Load(uint64_t& outVersion) const {
+        uint64_t words[kWordCount];
+        for (;;) {
+            const uint64_t seq = m_sequence.load(std::memory_order_acquire);
+            if (seq & 1) {
+                SnapshotCpuRelax();
+                continue;
+            }
+
+            for (size_t i = 0; i < kWordCount; ++i) { words[i] = m_words[i].load(std::memory_order_relaxed); }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == seq) {
+                outVersion = seq >> 1;
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    uint64_t Version() const { return m_sequence.load(std::memory_order_acquire) >> 1; }
+
+    void Publish(const T& value) {
+        const uint64_t seq = BeginWrite();
+        StoreWords(value);
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Read-modify-write under the writer claim: fn(T&) edits the current value and returns false to
+    // abandon the write (the version is left unchanged and readers never retry).
+    template <typename Fn> bool Update(Fn&& fn) {
+        const uint64_t seq = BeginWrite();
+        T value = LoadWordsUnsynchronized();
+        if (!fn(value)) {
+            m_sequence.store(seq, std::memory_order_release); // Nothing was stored: restore the old (even) sequence
+            return false;
+        }
+        StoreWords(value);
+        m_sequence.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Claims the writer slot; returns the even sequence it replaced
+    uint64_t BeginWrite() {
+        uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((seq & 1) == 0 && m_sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break; // acquire: see the previous writer's payload (Update reads it back)
+            }
+            SnapshotCpuRelax();
+            seq = m_sequence.load(std::memory_order_relaxed);
+        }
+        // Payload stores below must not become visible before the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq;
+    }
+
+    void StoreWords(const T& value) {
+        uint64_t words[kWordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < kWordCount; ++i) { m_words[i].store(words[i], std::memory_order_relaxed); }
+    }
+
+    // Only valid while holding the writer claim
+    T LoadWordsUnsynchronized() const {
+        uint64_t words[kWordCount];
+        for (size_t i = 0; i < kWordCount; ++i) { words[i] = m_words[i].load(std::memory_order_relaxed); }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    std::atomic<uint64_t> m_sequence{ 0 }; // Odd while a write is in progress
+    std::atomic<uint64_t> m_words[kWordCount] = {};
+};
@@ -1,4 +1,6 @@
 #include "virtual_camera.h"
+#include "metrics.h"
+#include "nv12_convert.h"
 #include "utils.h"
 
 // Prevent Windows min/max macros from conflicting with std::min/std::max
@@ -64,66 +66,14 @@ struct VirtualCameraState {
 
 static VirtualCameraState g_vcState;
 
-// NV12 conversion buffer is no longer needed - we write directly to shared memory frame slots
+static const MetricId g_metricFramesWritten =
+    RegisterMetric("vcam.frames_written", MetricKind::Meter, "Frames published to the virtual camera");
+static const MetricId g_metricFpsLimitSkips =
+    RegisterMetric("vcam.fps_limit_skips", MetricKind::Meter, "Frames skipped to hold the virtual camera frame rate");
+static const MetricId g_metricSizeMismatches =
+    RegisterMetric("vcam.size_mismatch_drops", MetricKind::Counter, "Frames rejected because they don't match the camera size");
 
-// Helper to clamp int to byte range (avoids Windows min/max macro conflict)
-static inline uint8_t clampToByte(int32_t val) {
-    if (val < 0) return 0;
-    if (val > 255) return 255;
-    return static_cast<uint8_t>(val);
-}
-
-// Optimized RGBA to NV12 conversion with vertical flip (OpenGL bottom-up -> NV12 top-down)
-// Single pass: computes Y for every pixel and UV for every 2x2 block simultaneously
-// Uses fixed-point arithmetic throughout with no division in the inner loop
-static void ConvertRGBAtoNV12(const uint8_t* __restrict rgba, uint8_t* __restrict nv12, uint32_t width, uint32_t height) {
-    const uint32_t yPlaneSize = width * height;
-    uint8_t* __restrict yPlane = nv12;
-    uint8_t* __restrict uvPlane = nv12 + yPlaneSize;
-    const uint32_t stride = width * 4; // RGBA stride in bytes
-
-    // Process two rows at a time (required for UV 2x2 subsampling)
-    for (uint32_t y = 0; y < height; y += 2) {
-        // Source rows are flipped (bottom-up -> top-down)
-        const uint8_t* __restrict srcRow0 = rgba + (height - 1 - y) * stride; // Top output row
-        const uint8_t* __restrict srcRow1 = rgba + (height - 2 - y) * stride; // Bottom output row
-        uint8_t* __restrict yRow0 = yPlane + y * width;
-        uint8_t* __restrict yRow1 = yPlane + (y + 1) * width;
-        uint8_t* __restrict uvRow = uvPlane + (y / 2) * width;
-
-        for (uint32_t x = 0; x < width; x += 2) {
-            // Load 2x2 block of RGBA pixels
-            const uint8_t* p00 = srcRow0 + x * 4;
-            const uint8_t* p10 = srcRow0 + (x + 1) * 4;
-            const uint8_t* p01 = srcRow1 + x * 4;
-            const uint8_t* p11 = srcRow1 + (x + 1) * 4;
-
-            // Compute Y for all 4 pixels: Y = ((66*R + 129*G + 25*B + 128) >> 8) + 16
-            int32_t y00 = ((66 * p00[0] + 129 * p00[1] + 25 * p00[2] + 128) >> 8) + 16;
-            int32_t y10 = ((66 * p10[0] + 129 * p10[1] + 25 * p10[2] + 128) >> 8) + 16;
-            int32_t y01 = ((66 * p01[0] + 129 * p01[1] + 25 * p01[2] + 128) >> 8) + 16;
-            int32_t y11 = ((66 * p11[0] + 129 * p11[1] + 25 * p11[2] + 128) >> 8) + 16;
-
-            yRow0[x] = clampToByte(y00);
-            yRow0[x + 1] = clampToByte(y10);
-            yRow1[x] = clampToByte(y01);
-            yRow1[x + 1] = clampToByte(y11);
-
-            // Average RGB of 2x2 block for chroma (shift right by 2 = divide by 4)
-            int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
-            int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
-            int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
-
-            // U = ((-38*R - 74*G + 112*B + 128) >> 8) + 128
-            // V = ((112*R - 94*G - 18*B + 128) >> 8) + 128
-            int32_t u = ((-38 * avgR - 74 * avgG + 112 * avgB + 128) >> 8) + 128;
-            int32_t v = ((112 * avgR - 94 * avgG - 18 * avgB + 128) >> 8) + 128;
-
-            uvRow[x] = clampToByte(u);
-            uvRow[x + 1] = clampToByte(v);
-        }
-    }
-}
+// RGBA -> NV12 conversion (SIMD kernels, row bands on worker threads) lives in nv12_convert.cpp
 
 bool IsVirtualCameraDriverInstalled() {
     // Check if the OBS Virtual Camera COM object is registered
@@ -295,6 +245,9 @@ void StopVirtualCamera() {
     g_vcState.active = false;
     g_virtualCameraActive.store(false, std::memory_order_release);
 
+    // Conversion workers are only needed while frames flow; they restart with the next banded frame
+    ShutdownNV12ConversionWorkers();
+
     Log("Virtual Camera: Stopped");
 }
 
@@ -309,6 +262,7 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
         LONGLONG elapsed = now.QuadPart - g_vcState.lastFrameTime.QuadPart;
         LONGLONG minTicks = g_vcState.perfFreq.QuadPart / g_vcState.targetFps;
         if (elapsed < minTicks) {
+            MetricAdd(g_metricFpsLimitSkips);
             return true; // Skip this frame
         }
     }
@@ -317,7 +271,10 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
     if (!g_vcState.active || !g_vcState.header) { return false; }
 
     // Check dimensions match
-    if (width != g_vcState.width || height != g_vcState.height) { return false; }
+    if (width != g_vcState.width || height != g_vcState.height) {
+        MetricAdd(g_metricSizeMismatches);
+        return false;
+    }
 
     // Convert RGBA to NV12 directly into the shared memory frame slot (avoid intermediate copy)
     uint32_t writeIdx = g_vcState.header->write_idx + 1;
@@ -350,6 +307,7 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
     }
 
     g_vcState.lastFrameTime = now;
+    MetricAdd(g_metricFramesWritten);
     return true;
 }
 
@@ -363,6 +321,7 @@ bool WriteVirtualCameraFrameNV12(const uint8_t* nv12_data, uint32_t width, uint3
         LONGLONG elapsed = now.QuadPart - g_vcState.lastFrameTime.QuadPart;
         LONGLONG minTicks = g_vcState.perfFreq.QuadPart / g_vcState.targetFps;
         if (elapsed < minTicks) {
+            MetricAdd(g_metricFpsLimitSkips);
             return true; // Skip this frame
         }
     }
@@ -370,7 +329,10 @@ bool WriteVirtualCameraFrameNV12(const uint8_t* nv12_data, uint32_t width, uint3
     // Quick state check without lock
     if (!g_vcState.active || !g_vcState.header) { return false; }
 
-    if (width != g_vcState.width || height != g_vcState.height) { return false; }
+    if (width != g_vcState.width || height != g_vcState.height) {
+        MetricAdd(g_metricSizeMismatches);
+        return false;
+    }
 
     // Write directly to next frame slot
     uint32_t writeIdx = g_vcState.header->write_idx + 1;
@@ -391,6 +353,7 @@ bool WriteVirtualCameraFrameNV12(const uint8_t* nv12_data, uint32_t width, uint3
     MemoryBarrier();
 
     g_vcState.lastFrameTime = now;
+    MetricAdd(g_metricFramesWritten);
     return true;
 }
 
@@ -1,4 +1,6 @@
 #include "window_overlay.h"
+#include "capture_scheduler.h"
+#include "config_diff.h"
 #include "gui.h"
 #include "profiler.h"
 #include "render.h"
@@ -32,14 +34,6 @@ std::atomic<std::vector<WindowInfo>*> g_windowListCache{ nullptr };
 std::mutex g_windowListCacheMutex;
 std::chrono::steady_clock::time_point g_lastWindowListUpdate;
 
-// Deferred overlay reload queue (for GUI thread to request reloads without blocking)
-struct DeferredOverlayReload {
-    std::string overlayId;
-    WindowOverlayConfig config;
-};
-std::vector<DeferredOverlayReload> g_deferredOverlayReloads;
-std::mutex g_deferredOverlayReloadsMutex;
-
 // Implementation of WindowOverlayCacheEntry destructor
 WindowOverlayCacheEntry::~WindowOverlayCacheEntry() {
     if (hBitmap) {
@@ -252,21 +246,6 @@ void LoadWindowOverlay(const std::string& overlayId, const WindowOverlayConfig&
     LoadWindowOverlay_Internal(overlayId, config);
 }
 
-// Queue a deferred overlay reload (non-blocking, safe to call from GUI thread)
-void QueueOverlayReload(const std::string& overlayId, const WindowOverlayConfig& config) {
-    std::lock_guard<std::mutex> lock(g_deferredOverlayReloadsMutex);
-    // Check if already queued to avoid duplicates
-    for (auto& pending : g_deferredOverlayReloads) {
-        if (pending.overlayId == overlayId) {
-            // Update existing entry
-            pending.config = config;
-            return;
-        }
-    }
-    // Add new entry
-    g_deferredOverlayReloads.push_back({ overlayId, config });
-}
-
 // Update all window overlays (refresh window handles)
 void UpdateAllWindowOverlays() {
     std::lock_guard<std::mutex> lock(g_windowOverlayCacheMutex);
@@ -400,16 +379,8 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
         }
     }
 
-    // Check FPS throttling
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.lastCaptureTime);
-    int targetInterval = 1000 / std::max(1, entry.fps.load(std::memory_order_relaxed));
-
-    if (elapsed.count() < targetInterval && !entry.needsUpdate.load(std::memory_order_relaxed)) {
-        return true; // Skip capture, too soon
-    }
-
-    entry.lastCaptureTime = now;
+    // FPS throttling is done by the capture thread's scheduler (needsUpdate requests an immediate capture there)
+    entry.lastCaptureTime = std::chrono::steady_clock::now();
     entry.needsUpdate.store(false, std::memory_order_relaxed);
 
     targetHwnd = entry.targetWindow.load(std::memory_order_relaxed);
@@ -721,32 +692,24 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
 // Helper function to find window overlay config by name
 const WindowOverlayConfig* FindWindowOverlayConfig(const std::string& overlayId) {
     // Note: Caller should hold g_configMutex
-    const auto& overlays = g_config.windowOverlays;
-    const size_t size = overlays.size();
-    for (size_t i = 0; i < size; ++i) {
-        if (overlays[i].name == overlayId) { return &overlays[i]; }
-    }
-    return nullptr;
+    return GetWindowOverlayFromSnapshot(g_config, overlayId);
 }
 
-// Overload that takes a specific Config reference (for use with config snapshots)
+// Overload that takes a specific Config reference (for use with config snapshots); O(1) through the snapshot's name index
 const WindowOverlayConfig* FindWindowOverlayConfigIn(const std::string& overlayId, const Config& config) {
-    const auto& overlays = config.windowOverlays;
-    const size_t size = overlays.size();
-    for (size_t i = 0; i < size; ++i) {
-        if (overlays[i].name == overlayId) { return &overlays[i]; }
-    }
-    return nullptr;
+    return GetWindowOverlayFromSnapshot(config, overlayId);
 }
 
-// Remove window overlay from cache without accessing config (call when you already have config access)
+// Remove window overlay from cache without accessing config. Safe from any thread: the OpenGL texture is queued
+// for deletion on the game thread instead of being deleted here.
 void RemoveWindowOverlayFromCache(const std::string& overlayId) {
     std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
     auto it = g_windowOverlayCache.find(overlayId);
     if (it != g_windowOverlayCache.end()) {
-        // Clean up OpenGL texture if it exists
         if (it->second->glTextureId != 0) {
-            glDeleteTextures(1, &it->second->glTextureId);
+            std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
+            g_texturesToDelete.push_back(it->second->glTextureId);
+            g_hasTexturesToDelete.store(true, std::memory_order_release);
             it->second->glTextureId = 0;
         }
         g_windowOverlayCache.erase(it);
@@ -846,13 +809,7 @@ static void CalculateWindowOverlayDimensions(const WindowOverlayConfig& config,
 std::string GetWindowOverlayAtPoint(int x, int y, int screenWidth, int screenHeight) {
     if (!g_windowOverlaysVisible.load(std::memory_order_acquire)) { return ""; }
 
-    std::string currentModeId;
-    {
-        extern std::mutex g_modeIdMutex;
-        extern std::string g_currentModeId;
-        std::lock_guard<std::mutex> lock(g_modeIdMutex);
-        currentModeId = g_currentModeId;
-    }
+    const ModeHandle currentModeId = g_currentModeHandle.load(std::memory_order_acquire);
 
     // Get the list of active window overlays for the current mode (use snapshot for thread safety)
     std::vector<std::pair<std::string, WindowOverlayConfig>> activeOverlays;
@@ -1255,6 +1212,16 @@ void WindowCaptureThreadFunc() {
 
     try {
         Log("Window capture thread started");
+        Profiler::GetInstance().SetThreadName("Window Capture");
+
+        // Config edits reach the capture entries through this tracker. Baseline first, so nothing published
+        // while the overlays below are being initialized is missed.
+        ConfigChangeTracker configTracker;
+        {
+            std::shared_ptr<const Config> baseline;
+            ConfigChangeSet unused;
+            configTracker.Poll(baseline, unused);
+        }
 
         // Initialize window overlays on the background thread (avoids blocking render thread)
         // This is safe here because the window capture thread runs independently
@@ -1271,6 +1238,10 @@ void WindowCaptureThreadFunc() {
         const auto windowListUpdateIntervalGuiOpen = std::chrono::milliseconds(500); // GUI open: keep list fresh
         const auto windowListUpdateIntervalGuiClosed = std::chrono::seconds(5);      // GUI closed: reduce CPU
 
+        // Per-overlay FPS limits on the same deadline grid as mirrors (see capture_scheduler.h)
+        CaptureScheduler captureScheduler;
+        auto lastScheduleStatsPublish = std::chrono::steady_clock::now();
+
         while (!g_stopWindowCaptureThread) {
             try {
                 auto now = std::chrono::steady_clock::now();
@@ -1307,28 +1278,33 @@ void WindowCaptureThreadFunc() {
                     continue;
                 }
 
-                // Process deferred overlay reloads (from GUI thread)
+                // Apply config edits: removed overlays drop their entry, new overlays get one and retargeted ones
+                // search for their window again. Entries are only erased here, never while this thread is capturing.
                 {
-                    std::vector<DeferredOverlayReload> reloadsToProcess;
-                    {
-                        std::lock_guard<std::mutex> lock(g_deferredOverlayReloadsMutex);
-                        reloadsToProcess = std::move(g_deferredOverlayReloads);
-                        g_deferredOverlayReloads.clear();
-                    }
-
-                    // Process reloads without holding the deferred queue lock
-                    for (const auto& reload : reloadsToProcess) {
-                        try {
-                            LoadWindowOverlay(reload.overlayId, reload.config);
-                            Log("Processed deferred reload for overlay: " + reload.overlayId);
-                        } catch (const std::exception& e) {
-                            Log("Error processing deferred reload for overlay '" + reload.overlayId + "': " + e.what());
+                    std::shared_ptr<const Config> changedSnap;
+                    ConfigChangeSet changes;
+                    if (configTracker.Poll(changedSnap, changes)) {
+                        for (const auto& change : changes.windowOverlays) {
+                            if (change.kind == ConfigChangeKind::Removed) {
+                                RemoveWindowOverlayFromCache(change.name);
+                                continue;
+                            }
+                            if (!(change.fields & (WINDOW_OVERLAY_CHANGE_TARGET | WINDOW_OVERLAY_CHANGE_CAPTURE))) continue;
+                            const WindowOverlayConfig* config = FindWindowOverlayConfigIn(change.name, *changedSnap);
+                            if (!config) continue;
+                            try {
+                                LoadWindowOverlay(change.name, *config);
+                            } catch (const std::exception& e) {
+                                Log("Error applying config change for overlay '" + change.name + "': " + e.what());
+                            }
                         }
                     }
                 }
 
                 // Build a list of overlay IDs and configs to capture (safer than holding pointers)
                 std::vector<std::pair<std::string, WindowOverlayConfig>> overlaysToCapture;
+                std::vector<std::pair<std::string, int>> captureRates; // Scheduler index == overlaysToCapture index
+                std::vector<size_t> immediateCaptures;
                 {
                     // Use snapshot for thread-safe config access + cache lock for cache access
                     auto captureSnap = GetConfigSnapshot();
@@ -1340,10 +1316,17 @@ void WindowCaptureThreadFunc() {
                     for (const auto& [overlayId, entry] : g_windowOverlayCache) {
                         // Find config for this overlay from snapshot
                         const WindowOverlayConfig* config = captureSnap ? FindWindowOverlayConfigIn(overlayId, *captureSnap) : nullptr;
-                        if (config) { overlaysToCapture.emplace_back(overlayId, *config); }
+                        if (config) {
+                            overlaysToCapture.emplace_back(overlayId, *config);
+                            captureRates.emplace_back(overlayId, std::max(1, entry->fps.load(std::memory_order_relaxed)));
+                            if (entry->needsUpdate.load(std::memory_order_relaxed)) { immediateCaptures.push_back(captureRates.size() - 1); }
+                        }
                     }
                 }
 
+                captureScheduler.SetRates(captureRates);
+                for (size_t index : immediateCaptures) { captureScheduler.RequestImmediate(index); }
+
                 if (overlaysToCapture.empty()) {
                     // Nothing to capture (no configured overlays) - don't spin at 60Hz.
                     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -1351,9 +1334,13 @@ void WindowCaptureThreadFunc() {
                 }
                 // Locks released - now we can capture without blocking config/cache changes
 
-                // Process each overlay
-                for (auto& [overlayId, config] : overlaysToCapture) {
+                // Everything due now is captured in this pass
+                captureScheduler.CollectDue();
+
+                // Process each due overlay
+                for (size_t index : captureScheduler.DueIndices()) {
                     if (g_stopWindowCaptureThread) { break; }
+                    auto& [overlayId, config] = overlaysToCapture[index];
 
                     try {
                         // Get entry pointer with minimal lock duration
@@ -1368,18 +1355,28 @@ void WindowCaptureThreadFunc() {
                         if (entry) {
                             // Capture without holding the cache mutex
                             // The entry's own captureMutex protects against concurrent modifications
-                            // Note: Entry deletion is only done from GUI thread via RemoveWindowOverlayFromCache,
-                            // and the capture thread checks for null before each capture
+                            // Note: Entries are only erased by this thread (config diff above), so the pointer
+                            // stays valid for the capture
                             CaptureWindowContent(*entry, config);
                         }
                         // If entry was removed, skip this overlay (it was deleted from config)
                     } catch (const std::exception& e) {
                         Log("Error capturing window content for overlay '" + overlayId + "': " + e.what());
                     } catch (...) { Log("Unknown error capturing window content for overlay '" + overlayId + "'"); }
+                    // Failed attempts also wait for the next deadline instead of retrying every pass
+                    captureScheduler.MarkCaptured(index);
+                }
+
+                if (now - lastScheduleStatsPublish >= std::chrono::seconds(1)) {
+                    PublishCaptureScheduleStats("Window Overlay", captureScheduler.GetAllStats());
+                    lastScheduleStatsPublish = now;
                 }
 
-                // Sleep for a short time to prevent excessive CPU usage
-                std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS max
+                // Sleep until the next capture deadline; bounded so visibility/config changes are still picked up promptly
+                int64_t waitUs = captureScheduler.MicrosUntilNextDeadline();
+                if (waitUs < 0) { waitUs = 100000; }
+                waitUs = std::clamp<int64_t>(waitUs, 1000, 100000);
+                std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
             } catch (const std::exception& e) { Log("Error in window capture thread: " + std::string(e.what())); } catch (...) {
                 Log("Unknown error in window capture thread");
             }
@@ -1390,6 +1387,7 @@ void WindowCaptureThreadFunc() {
         Log("EXCEPTION in WindowCaptureThreadFunc: Unknown exception");
     }
 
+    PublishCaptureScheduleStats("Window Overlay", {});
     Log("Window capture thread stopped");
 }
 
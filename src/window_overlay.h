@@ -153,7 +153,6 @@ struct WindowOverlayCacheEntry {
 // to avoid blocking the render thread during expensive window searching
 void InitializeWindowOverlays();
 void LoadWindowOverlay(const std::string& overlayId, const WindowOverlayConfig& config);
-void QueueOverlayReload(const std::string& overlayId, const WindowOverlayConfig& config); // Non-blocking deferred reload
 void CleanupWindowOverlayCache();
 void CleanupWindowOverlayCacheEntry(const std::string& overlayId);
 void RemoveWindowOverlayFromCache(const std::string& overlayId); // Remove from cache without accessing config
@@ -0,0 +1,96 @@
+// ============================================================================
+// BENCH_CONFIG_PUBLISH.CPP - Config snapshot publish latency and allocation churn
+// ============================================================================
+// A 500-element config published the way PublishConfigSnapshot() does
+// (PublishConfigSections), in three situations:
+//   deep copy     - no previous snapshot: every element is copied, as the
+//                   old make_shared<const Config>(g_config) did on every publish
+//   unchanged     - republish with nothing edited
+//   spinner drag  - one mirror's position edited between publishes
+// Allocations are counted with a replaced global operator new. Even with no
+// edits, a publish compares every element with the previous snapshot's, so
+// the remaining cost is proportional to the config's size.
+// ============================================================================
+
+#include "bench_util.h"
+#include "config_publish.h"
+#include "config_test_data.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> g_allocCount{ 0 };
+std::atomic<uint64_t> g_allocBytes{ 0 };
+
+struct AllocStats {
+    double ns = 0.0;
+    double allocs = 0.0;
+    double bytes = 0.0;
+};
+
+// Runs publish() `iterations` times; per-publish time (best of repeats) and allocation counts
+template <typename Fn> AllocStats Measure(uint64_t iterations, int repeats, Fn&& publish) {
+    AllocStats stats;
+    const uint64_t count0 = g_allocCount.load(), bytes0 = g_allocBytes.load();
+    stats.ns = MeasureNsPerOp(iterations, repeats, publish);
+    const double runs = static_cast<double>(iterations) * repeats;
+    stats.allocs = (g_allocCount.load() - count0) / runs;
+    stats.bytes = (g_allocBytes.load() - bytes0) / runs;
+    return stats;
+}
+
+void Print(const char* name, const AllocStats& stats) {
+    std::printf("  %-14s %12.1f %12.1f %12.0f\n", name, stats.ns / 1000.0, stats.allocs, stats.bytes);
+}
+
+} // namespace
+
+// GCC can't see that every pointer freed here came from the malloc in operator new below
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const uint64_t iterations = quick ? 5 : 500;
+    const int repeats = quick ? 1 : 5;
+
+    Config draft = MakeLargeTestConfig(500);
+    Config previous;
+    PublishConfigSections(draft, nullptr, previous);
+
+    std::printf("Config publish, 500 elements\n");
+    std::printf("  %-14s %12s %12s %12s\n", "", "us/publish", "allocs", "bytes");
+    Print("deep copy", Measure(iterations, repeats, [&] {
+              Config snapshot;
+              PublishConfigSections(draft, nullptr, snapshot);
+              DoNotOptimize(snapshot);
+          }));
+    Print("unchanged", Measure(iterations, repeats, [&] {
+              Config snapshot;
+              PublishConfigSections(draft, &previous, snapshot);
+              DoNotOptimize(snapshot);
+          }));
+    int step = 0;
+    Print("spinner drag", Measure(iterations, repeats, [&] {
+              draft.mirrors[17].output.x = step++;
+              Config snapshot;
+              PublishConfigSections(draft, &previous, snapshot);
+              previous = std::move(snapshot);
+              DoNotOptimize(previous);
+          }));
+    return 0;
+}
@@ -0,0 +1,81 @@
+// ============================================================================
+// BENCH_EXPRESSION.CPP - Expression compile and evaluation cost
+// ============================================================================
+// The dimension expressions of a typical config, each measured three ways:
+//   reparse   - tokenize, parse and evaluate every time, as EvaluateExpression
+//               did on every RecalculateExpressionDimensions() call before
+//               expressions were compiled
+//   cached    - CompileExpression cache hit + evaluate, the cost of an
+//               EvaluateExpression/ValidateExpression call (GUI redraws)
+//   evaluate  - bytecode evaluation only, what the dimension graph runs when
+//               an input changes
+// ============================================================================
+
+#include "bench_util.h"
+#include "expression_compiler.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kExpressions[] = {
+    "screenWidth",
+    "screenHeight - 300",
+    "min(screenWidth, 300)",
+    "(screenWidth - 300) / 2",
+    "roundEven(screenHeight * 0.9)",
+    "floor(EyeZoom.width / 3) + max(screenHeight - 16384, 0)",
+};
+
+std::vector<double> BindVariables(const CompiledExpression& program) {
+    std::vector<double> values;
+    for (const std::string& variable : program.Variables()) {
+        values.push_back(variable == "screenHeight" ? 1440.0 : variable == "screenWidth" ? 2560.0 : 384.0);
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const uint64_t iterations = quick ? 2000 : 500000;
+    const int repeats = quick ? 1 : 5;
+
+    std::printf("Expression cost, ns per expression\n");
+    std::printf("  %-56s %10s %10s %10s\n", "expression", "reparse", "cached", "evaluate");
+    for (const char* text : kExpressions) {
+        const std::string expr = text;
+        std::string error;
+        const auto program = CompileExpression(expr, error);
+        if (!program) {
+            std::printf("  %-56s failed to compile: %s\n", text, error.c_str());
+            return 1;
+        }
+        const std::vector<double> values = BindVariables(*program);
+
+        const double reparse = MeasureNsPerOp(iterations, repeats, [&] {
+            CompiledExpression fresh;
+            std::string freshError;
+            double out = 0.0;
+            if (CompileExpressionText(expr, fresh, freshError)) fresh.Evaluate(values.data(), out);
+            DoNotOptimize(out);
+        });
+        const double cached = MeasureNsPerOp(iterations, repeats, [&] {
+            std::string cachedError;
+            const auto hit = CompileExpression(expr, cachedError);
+            double out = 0.0;
+            hit->Evaluate(values.data(), out);
+            DoNotOptimize(out);
+        });
+        const double evaluate = MeasureNsPerOp(iterations, repeats, [&] {
+            double out = 0.0;
+            program->Evaluate(values.data(), out);
+            DoNotOptimize(out);
+        });
+        std::printf("  %-56s %10.1f %10.1f %10.1f\n", text, reparse, cached, evaluate);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// ============================================================================
+// BENCH_GZIP_STREAM.CPP - Log archive compression speed and ratio
+// ============================================================================
+// Inputs: latest.log-shaped text (gzip_test_data.h), incompressible bytes and
+// a run of zeros, fed in 64 KB chunks as CompressFileToGzip() does.
+//   GzipEncoder  - the streaming encoder (hash chains, lazy matching,
+//                  dynamic/fixed/stored blocks)
+//   zlib -6      - zlib's gzip at its default level, when CMake found zlib
+//   old fixed    - the encoder it replaced, modeled: BuildLz77Tokens'
+//                  backward linear search (up to 2048 candidates per byte)
+//                  and one fixed-Huffman block, sized exactly but not written.
+//                  Run on the first 256 KB of text only; it is quadratic-ish.
+// Speed is input MB per second; ratio is compressed / input size.
+// ============================================================================
+
+#include "bench_util.h"
+#include "gzip_test_data.h"
+
+#include <cstdio>
+#include <vector>
+
+#ifdef TOOLSCREEN_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const size_t kChunkSize = 64 * 1024;
+
+struct Result {
+    double mbPerSecond = 0.0;
+    double ratio = 0.0;
+};
+
+template <typename Fn> Result Measure(const std::vector<uint8_t>& input, int repeats, Fn&& compress) {
+    size_t compressedSize = 0;
+    const double ns = MeasureNsPerOp(1, repeats, [&] { compressedSize = compress(input); });
+    return { static_cast<double>(input.size()) / ns * 1000.0, static_cast<double>(compressedSize) / input.size() };
+}
+
+size_t CompressGzipEncoder(const std::vector<uint8_t>& input) {
+    const std::vector<uint8_t> out = GzipInChunks(input, kChunkSize);
+    DoNotOptimize(out);
+    return out.size();
+}
+
+#ifdef TOOLSCREEN_HAVE_ZLIB
+size_t CompressZlib(const std::vector<uint8_t>& input) {
+    z_stream stream{};
+    deflateInit2(&stream, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::vector<uint8_t> buffer(kChunkSize);
+    size_t total = 0;
+    for (size_t pos = 0;; pos += kChunkSize) {
+        const bool last = pos + kChunkSize >= input.size();
+        stream.next_in = const_cast<Bytef*>(input.data() + (std::min)(pos, input.size()));
+        stream.avail_in = static_cast<uInt>(last ? input.size() - (std::min)(pos, input.size()) : kChunkSize);
+        int result = Z_OK;
+        do {
+            stream.next_out = buffer.data();
+            stream.avail_out = static_cast<uInt>(buffer.size());
+            result = deflate(&stream, last ? Z_FINISH : Z_NO_FLUSH);
+            total += buffer.size() - stream.avail_out;
+        } while (stream.avail_out == 0 && result != Z_STREAM_END);
+        if (last) break;
+    }
+    deflateEnd(&stream);
+    return total;
+}
+#endif
+
+// The old in-memory encoder's output size: its LZ77 tokens priced with the fixed Huffman code lengths
+int LengthExtraBits(size_t length) {
+    if (length < 11 || length == 258) return 0;
+    int extra = 1;
+    for (size_t base = 19; length >= base && extra < 5; base = base * 2 - 3) extra++;
+    return extra;
+}
+
+int DistanceExtraBits(size_t distance) {
+    int extra = 0;
+    while (distance > (4u << extra)) extra++;
+    return extra;
+}
+
+size_t CompressOldFixed(const std::vector<uint8_t>& data) {
+    const size_t n = data.size();
+    uint64_t bits = 3 + 7; // Block header and end-of-block
+    size_t i = 0;
+    while (i < n) {
+        size_t bestLen = 0, bestDist = 0;
+        if (i + 3 <= n) {
+            const size_t windowStart = (i > 32768) ? (i - 32768) : 0;
+            size_t attempts = 0;
+            for (size_t j = i; j > windowStart && attempts < 2048;) {
+                --j;
+                if (data[j] != data[i]) continue;
+                const size_t maxLen = (std::min)(static_cast<size_t>(258), n - i);
+                size_t len = 1;
+                while (len < maxLen && data[j + len] == data[i + len]) len++;
+                if (len >= 3 && len > bestLen) {
+                    bestLen = len;
+                    bestDist = i - j;
+                    if (len == 258) break;
+                }
+                attempts++;
+            }
+        }
+        if (bestLen >= 3) {
+            bits += (bestLen >= 115 ? 8 : 7) + LengthExtraBits(bestLen) + 5 + DistanceExtraBits(bestDist);
+            i += bestLen;
+        } else {
+            bits += data[i] < 144 ? 8 : 9;
+            i++;
+        }
+    }
+    return 18 + static_cast<size_t>((bits + 7) / 8);
+}
+
+void Print(const char* corpus, const char* encoder, const Result& result) {
+    std::printf("  %-8s %-12s %10.1f %10.3f\n", corpus, encoder, result.mbPerSecond, result.ratio);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int repeats = quick ? 1 : 5;
+    const size_t size = quick ? 256 * 1024 : 8 * 1024 * 1024;
+
+    struct Corpus {
+        const char* name;
+        std::vector<uint8_t> data;
+    };
+    const Corpus corpora[] = {
+        { "log", MakeTestLog(size) },
+        { "random", MakeRandomBytes(size) },
+        { "zeros", std::vector<uint8_t>(size, 0) },
+    };
+
+    std::printf("Gzip compression, %zu KB inputs in %zu KB chunks\n", size / 1024, kChunkSize / 1024);
+    std::printf("  %-8s %-12s %10s %10s\n", "", "", "MB/s", "ratio");
+    for (const Corpus& corpus : corpora) {
+        Print(corpus.name, "GzipEncoder", Measure(corpus.data, repeats, CompressGzipEncoder));
+#ifdef TOOLSCREEN_HAVE_ZLIB
+        Print(corpus.name, "zlib -6", Measure(corpus.data, repeats, CompressZlib));
+#endif
+    }
+
+    const std::vector<uint8_t> oldInput(corpora[0].data.begin(), corpora[0].data.begin() + (std::min)(size, static_cast<size_t>(quick ? 32 * 1024 : 256 * 1024)));
+    Print("log", "GzipEncoder", Measure(oldInput, repeats, CompressGzipEncoder));
+    Print("log", "old fixed", Measure(oldInput, repeats, CompressOldFixed));
+    std::printf("  (last two rows: first %zu KB of the log)\n", oldInput.size() / 1024);
+    return 0;
+}
@@ -0,0 +1,154 @@
+// ============================================================================
+// BENCH_LOG_RECORD.CPP - Cost of a log call on the logging thread
+// ============================================================================
+// What a log line costs the game/render thread that writes it, into an
+// MpscRing of the same size as the DLL's log ring (drained untimed between
+// batches):
+//   LOG_FMT        - "Resized copy textures to {}x{} ({:.1f} ms, {})" with
+//                    two ints, a double and a short string
+//   LOG_FMT long   - the same with a 1000-character string, cut to the payload
+//   category off   - LOG_FMT_CAT with the category disabled
+//   old Log        - the path it replaced, modeled: the message built with
+//                    std::to_string, "[" + GetTimestamp() + "] " + message
+//                    with a stringstream timestamp, pushed as a std::string
+// plus the writer-side cost of AppendLogRecordLine() per LOG_FMT record.
+// Allocations are counted with a replaced global operator new; log calls
+// must not allocate.
+// ============================================================================
+
+#include "bench_util.h"
+#include "log_record.h"
+#include "ring_buffer.h"
+#include "stubs.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::atomic<uint64_t> g_allocCount{ 0 };
+
+const int kCallsPerBatch = 4000; // Under the 8192-slot ring
+
+MpscRing<LogRecord, 8192> g_records;
+MpscRing<std::string, 8192> g_strings;
+
+void PushRecord(const LogRecord& record) {
+    if (!g_records.Push(record)) delete record.overflowText;
+}
+
+void DrainRecords() {
+    g_records.ConsumeAll([](LogRecord& record) {
+        delete record.overflowText;
+        record.overflowText = nullptr;
+    });
+}
+
+struct CallStats {
+    double ns = 0.0;
+    double allocs = 0.0;
+};
+
+// Best-of-`batches` ns per call and allocations per call; drain() runs untimed after each batch
+template <typename Fn, typename Drain> CallStats MeasureCalls(int batches, Fn&& call, Drain&& drain) {
+    CallStats stats;
+    uint64_t allocs = 0;
+    for (int b = 0; b < batches; b++) {
+        const uint64_t count0 = g_allocCount.load();
+        const double start = BenchNowNs();
+        for (int i = 0; i < kCallsPerBatch; i++) call(i);
+        const double perCall = (BenchNowNs() - start) / kCallsPerBatch;
+        allocs += g_allocCount.load() - count0;
+        drain();
+        if (b == 0 || perCall < stats.ns) stats.ns = perCall;
+    }
+    stats.allocs = static_cast<double>(allocs) / (static_cast<double>(batches) * kCallsPerBatch);
+    return stats;
+}
+
+// The GetTimestamp() every Log() call used to run
+std::string OldTimestamp() {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t t = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    std::tm timeinfo{};
+    localtime_r(&t, &timeinfo);
+    std::stringstream ss;
+    ss << std::put_time(&timeinfo, "%H:%M:%S");
+    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
+    return ss.str();
+}
+
+void Print(const char* name, const CallStats& stats) { std::printf("  %-14s %10.1f %10.2f\n", name, stats.ns, stats.allocs); }
+
+} // namespace
+
+// GCC can't see that every pointer freed here came from the malloc in operator new below
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int batches = quick ? 3 : 200;
+
+    const std::string stage = "mirrors";
+    const std::string longText(1000, 'x');
+    g_logRecordSink = PushRecord;
+
+    const CallStats fmt = MeasureCalls(batches, [&](int i) { LOG_FMT("Resized copy textures to {}x{} ({:.1f} ms, {})", 1920 + i, 1080, 0.25 * i, stage); },
+                                       DrainRecords);
+    const CallStats fmtLong = MeasureCalls(batches, [&](int i) { LOG_FMT("Resized copy textures to {}x{} ({})", i, 1080, longText); },
+                                           DrainRecords);
+    g_logCategoryMask.store(0);
+    const CallStats off = MeasureCalls(batches, [&](int i) { LOG_FMT_CAT(LogCat::TextureOps, "Capture plan {} region(s)", i); },
+                                       DrainRecords);
+
+    const CallStats old = MeasureCalls(
+        batches,
+        [&](int i) {
+            const std::string message = "Resized copy textures to " + std::to_string(1920 + i) + "x" + std::to_string(1080) + " (" +
+                                        std::to_string(0.25 * i) + " ms, " + stage + ")";
+            std::string formatted = "[" + OldTimestamp() + "] " + message;
+            g_strings.Push(std::move(formatted));
+        },
+        [] { g_strings.ConsumeAll([](std::string& line) { std::string().swap(line); }); });
+
+    // Writer side: format one batch of LOG_FMT records into a reused buffer
+    std::string batch;
+    double writerBest = 0.0;
+    for (int b = 0; b < batches; b++) {
+        for (int i = 0; i < kCallsPerBatch; i++) LOG_FMT("Resized copy textures to {}x{} ({:.1f} ms, {})", 1920 + i, 1080, 0.25 * i, stage);
+        batch.clear();
+        const double start = BenchNowNs();
+        g_records.ConsumeAll([&](LogRecord& record) { AppendLogRecordLine(record, batch); });
+        const double perRecord = (BenchNowNs() - start) / kCallsPerBatch;
+        if (b == 0 || perRecord < writerBest) writerBest = perRecord;
+    }
+    DoNotOptimize(batch);
+    g_logRecordSink = nullptr;
+
+    std::printf("Log call cost on the logging thread\n");
+    std::printf("  %-14s %10s %10s\n", "", "ns/call", "allocs");
+    Print("LOG_FMT", fmt);
+    Print("LOG_FMT long", fmtLong);
+    Print("category off", off);
+    Print("old Log", old);
+    std::printf("  %-14s %10.1f  (writer, ns/record)\n", "format line", writerBest);
+    return (fmt.allocs == 0.0 && fmtLong.allocs == 0.0 && off.allocs == 0.0) ? 0 : 1;
+}
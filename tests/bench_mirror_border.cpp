@@ -0,0 +1,46 @@
+// ============================================================================
+// BENCH_MIRROR_BORDER.CPP - Separable vs brute-force dynamic border cost
+// ============================================================================
+// Final pass of a 300x170 pie-chart mirror at 2x output for growing border
+// widths. The separable passes grow linearly with the width, the brute-force
+// shader port quadratically.
+// ============================================================================
+
+#include "bench_util.h"
+#include "mirror_cpu_filter.h"
+#include "mirror_test_frames.h"
+
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+
+    std::printf("Dynamic border final pass, 300x170 mirror at 2x (%s)\n", CpuSimdLevelToString(GetCpuSimdLevel()));
+    std::printf("  %-6s %14s %14s\n", "width", "separable us", "brute us");
+    for (int borderWidth : { 1, 2, 4, 8, 16 }) {
+        ThreadedMirrorConfig conf = MakeTestMirrorConfig(300, 170, borderWidth);
+        conf.outputScale = 2.0f;
+
+        // Sparse coverage (pie slices are small blobs): most output pixels run the full window test
+        MirrorCpuImage filter;
+        filter.Reset(300 + 2 * borderWidth, 170 + 2 * borderWidth);
+        uint32_t state = 99;
+        for (size_t i = 3; i < filter.rgba.size(); i += 4) {
+            if (TestRandom(state) % 400 == 0) filter.rgba[i] = 255;
+        }
+
+        MirrorCpuImage out;
+        const int repeats = quick ? 1 : 5;
+        const double separable = MeasureNsPerOp(quick ? 1 : 20, repeats, [&] {
+            MirrorCpuFinalPass(filter, conf, false, out);
+            DoNotOptimize(out.rgba.data());
+        });
+        const double brute = MeasureNsPerOp(quick ? 1 : 3, repeats, [&] {
+            MirrorCpuFinalPassReference(filter, conf, out);
+            DoNotOptimize(out.rgba.data());
+        });
+        std::printf("  %-6d %14.1f %14.1f\n", borderWidth, separable / 1000.0, brute / 1000.0);
+        if (quick && borderWidth >= 4) break;
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+// ============================================================================
+// BENCH_MIRROR_CPU_FILTER.CPP - Per-mirror cost of the CPU filter pipeline
+// ============================================================================
+// Runs filter + final pass for a few typical mirror shapes at every SIMD level
+// the CPU supports, against a 1920x1080 synthetic frame.
+// ============================================================================
+
+#include "bench_util.h"
+#include "mirror_color_lut.h"
+#include "mirror_cpu_filter.h"
+#include "mirror_test_frames.h"
+
+#include <cstdio>
+
+namespace {
+
+struct BenchMirror {
+    const char* name;
+    int captureW, captureH, border;
+    float scale;
+    bool passthrough;
+};
+
+const BenchMirror kMirrors[] = {
+    { "pie chart 300x170, border 4, x2", 300, 170, 4, 2.0f, false },
+    { "entity counter 60x20, border 2, x4", 60, 20, 2, 4.0f, false },
+    { "passthrough 200x200, border 1, x1", 200, 200, 1, 1.0f, true },
+    { "wide border 120x80, border 12, x2", 120, 80, 12, 2.0f, false },
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int frameW = 1920, frameH = 1080;
+    const std::vector<uint8_t> frame = MakeTestFrame(frameW, frameH, 42);
+    const MirrorCpuSource src{ frame.data(), frameW, frameH, frameW * 4 };
+
+    std::printf("CPU mirror pipeline (filter + final), best of %d, detected %s\n", quick ? 1 : 5,
+                CpuSimdLevelToString(GetCpuSimdLevel()));
+    for (const BenchMirror& m : kMirrors) {
+        ThreadedMirrorConfig conf = MakeTestMirrorConfig(m.captureW, m.captureH, m.border);
+        conf.outputScale = m.scale;
+        conf.colorPassthrough = m.passthrough;
+        std::vector<uint32_t> table;
+        BuildMirrorColorMatchTable(MakeMirrorColorMatchKey(conf.targetColors, conf.colorSensitivity, MirrorGammaMode::Auto), table);
+
+        MirrorCpuImage filter, final;
+        for (CpuSimdLevel level : { CpuSimdLevel::Scalar, CpuSimdLevel::SSE2, CpuSimdLevel::AVX2 }) {
+            if (ResolveCpuSimdLevel(level) != level) continue;
+            const double ns = MeasureNsPerOp(quick ? 2 : 200, quick ? 1 : 5, [&] {
+                RunMirrorCpuPipeline(src, conf, table, false, filter, final, level);
+                DoNotOptimize(final.rgba.data());
+            });
+            std::printf("  %-36s %-7s %9.1f us/mirror\n", m.name, CpuSimdLevelToString(level), ns / 1000.0);
+        }
+    }
+    return 0;
+}
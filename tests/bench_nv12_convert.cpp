@@ -0,0 +1,77 @@
+// ============================================================================
+// BENCH_NV12_CONVERT.CPP - Virtual camera RGBA -> NV12 conversion throughput
+// ============================================================================
+// Per frame size (1080p, 1440p, 4K), ms per frame for:
+//   scalar    - the original per-pixel loop on one thread (the scalar kernel)
+//   SSE2      - SSE2 kernel on one thread
+//   AVX2      - AVX2 kernel on one thread (when the CPU has it)
+//   banded    - ConvertRGBAtoNV12 as the virtual camera calls it: best
+//               kernel, row bands shared with the worker pool
+// "% of 60" is the share of a 16.7 ms frame the conversion takes. Banding
+// only pays off with spare cores; on one core it adds hand-off cost.
+// ============================================================================
+
+#include "bench_util.h"
+#include "nv12_convert.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FrameSize {
+    const char* name;
+    uint32_t width;
+    uint32_t height;
+};
+
+const FrameSize kFrameSizes[] = { { "1080p", 1920, 1080 }, { "1440p", 2560, 1440 }, { "4K", 3840, 2160 } };
+
+std::vector<uint8_t> MakeFrame(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t state = 1;
+    for (uint8_t& c : rgba) {
+        state = state * 1664525u + 1013904223u;
+        c = static_cast<uint8_t>(state >> 24);
+    }
+    return rgba;
+}
+
+void Print(const char* name, double ns, const FrameSize& size) {
+    const double ms = ns / 1e6;
+    const double megapixels = static_cast<double>(size.width) * size.height / 1e6;
+    std::printf("  %-6s %-8s %10.2f %10.0f %9.0f%%\n", size.name, name, ms, megapixels / (ms / 1000.0), ms / (1000.0 / 60.0) * 100.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int repeats = quick ? 1 : 5;
+    const uint64_t iterations = quick ? 1 : 20;
+    const CpuSimdLevel best = GetCpuSimdLevel();
+
+    std::printf("RGBA -> NV12, best kernel %s, %u hardware threads\n", CpuSimdLevelToString(best), std::thread::hardware_concurrency());
+    std::printf("  %-6s %-8s %10s %10s %10s\n", "", "", "ms/frame", "Mpx/s", "% of 60");
+    for (const FrameSize& size : kFrameSizes) {
+        const std::vector<uint8_t> rgba = MakeFrame(size.width, size.height);
+        std::vector<uint8_t> nv12(static_cast<size_t>(size.width) * size.height * 3 / 2);
+        auto singleThread = [&](CpuSimdLevel level) {
+            return MeasureNsPerOp(iterations, repeats, [&] {
+                ConvertRGBAtoNV12Rows(rgba.data(), nv12.data(), size.width, size.height, 0, size.height, level);
+                DoNotOptimize(nv12);
+            });
+        };
+        Print("scalar", singleThread(CpuSimdLevel::Scalar), size);
+        Print("SSE2", singleThread(CpuSimdLevel::SSE2), size);
+        if (best >= CpuSimdLevel::AVX2) Print("AVX2", singleThread(CpuSimdLevel::AVX2), size);
+        Print("banded", MeasureNsPerOp(iterations, repeats, [&] {
+                  ConvertRGBAtoNV12(rgba.data(), nv12.data(), size.width, size.height);
+                  DoNotOptimize(nv12);
+              }),
+              size);
+    }
+    ShutdownNV12ConversionWorkers();
+    return 0;
+}
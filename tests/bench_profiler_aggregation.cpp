@@ -0,0 +1,165 @@
+// ============================================================================
+// BENCH_PROFILER_AGGREGATION.CPP - Processing-side cost per profiled scope
+// ============================================================================
+// A frame-shaped call tree (49 scopes per frame, up to four deep, with the
+// same names under different parents) is recorded through the real
+// ScopedTimer until the thread's ring is nearly full, then drained:
+//   call tree    - Profiler::EndFrame(): pairs begin/end records and adds
+//                  them to the flat per-node arrays (plus the once-per-frame
+//                  hierarchy pass over the nodes)
+//   string keys  - the aggregation it replaced, modeled on the same scopes:
+//                  one std::string key and unordered_map lookup per event,
+//                  steady_clock::now() per event and a linear childPaths scan
+// Only the drain is timed. The processing thread needs well under 1 us per
+// scope to absorb 1M scopes/second.
+// ============================================================================
+
+#include "bench_util.h"
+#include "profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const char* const kSystems[] = { "RenderMirrors", "RenderImages", "RenderOverlays", "ProcessInput", "UpdateState", "Present" };
+const char* const kStages[] = { "Prepare", "Draw", "Upload", "Wait" };
+const char* const kDrawSteps[] = { "Bind", "Blend", "Submit" };
+const int kScopesPerFrame = 1 + 6 + 6 * 4 + 6 * 3;
+const int kFramesPerDrain = 160; // 7840 scopes: two records each, under the 16384-record ring
+
+struct BenchScopes {
+    Profiler::ScopeId frame;
+    Profiler::ScopeId systems[6];
+    Profiler::ScopeId stages[4];
+    Profiler::ScopeId drawSteps[3];
+};
+
+BenchScopes RegisterBenchScopes() {
+    BenchScopes scopes;
+    scopes.frame = Profiler::RegisterScope("Frame");
+    for (int i = 0; i < 6; i++) scopes.systems[i] = Profiler::RegisterScope(kSystems[i]);
+    for (int i = 0; i < 4; i++) scopes.stages[i] = Profiler::RegisterScope(kStages[i]);
+    for (int i = 0; i < 3; i++) scopes.drawSteps[i] = Profiler::RegisterScope(kDrawSteps[i]);
+    return scopes;
+}
+
+void RecordFrame(Profiler& profiler, const BenchScopes& scopes) {
+    Profiler::ScopedTimer frame(profiler, scopes.frame);
+    for (Profiler::ScopeId system : scopes.systems) {
+        Profiler::ScopedTimer systemTimer(profiler, system);
+        for (int stage = 0; stage < 4; stage++) {
+            Profiler::ScopedTimer stageTimer(profiler, scopes.stages[stage]);
+            if (stage != 1) continue;
+            for (Profiler::ScopeId step : scopes.drawSteps) { Profiler::ScopedTimer stepTimer(profiler, step); }
+        }
+    }
+}
+
+// The pre-call-tree event and entry, keyed by section name
+struct LegacyEvent {
+    const char* sectionName;
+    const char* parentName;
+    double durationMs;
+    uint8_t depth;
+    bool isRenderThread;
+};
+
+struct LegacyEntry {
+    std::string displayName;
+    double totalTime = 0.0;
+    int callCount = 0;
+    double maxTimeInLastSecond = 0.0;
+    std::chrono::steady_clock::time_point lastUpdateTime{};
+    std::string parentPath;
+    std::vector<std::string> childPaths;
+    int depth = 0;
+};
+
+// Events in completion order (children before parents), as the old ScopedTimer destructors pushed them
+std::vector<LegacyEvent> MakeLegacyEvents() {
+    std::vector<LegacyEvent> events;
+    for (int f = 0; f < kFramesPerDrain; f++) {
+        for (const char* system : kSystems) {
+            for (int stage = 0; stage < 4; stage++) {
+                if (stage == 1) {
+                    for (const char* step : kDrawSteps) events.push_back({ step, kStages[stage], 0.01, 3, true });
+                }
+                events.push_back({ kStages[stage], system, 0.05, 2, true });
+            }
+            events.push_back({ system, "Frame", 0.3, 1, true });
+        }
+        events.push_back({ "Frame", nullptr, 2.0, 0, true });
+    }
+    return events;
+}
+
+void AggregateLegacy(const std::vector<LegacyEvent>& events, std::unordered_map<std::string, LegacyEntry>& entries) {
+    for (const LegacyEvent& event : events) {
+        std::string pathKey = event.sectionName;
+        auto& entry = entries[pathKey];
+        entry.displayName = event.sectionName;
+        entry.totalTime += event.durationMs;
+        entry.callCount++;
+        entry.depth = event.depth;
+        entry.lastUpdateTime = std::chrono::steady_clock::now();
+        if (event.parentName != nullptr) {
+            std::string parentKey = event.parentName;
+            entry.parentPath = parentKey;
+            auto& parentEntry = entries[parentKey];
+            parentEntry.displayName = event.parentName;
+            bool found = false;
+            for (const auto& child : parentEntry.childPaths) {
+                if (child == pathKey) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) parentEntry.childPaths.push_back(pathKey);
+        }
+        if (event.durationMs > entry.maxTimeInLastSecond) entry.maxTimeInLastSecond = event.durationMs;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int drains = quick ? 3 : 200;
+    const double scopesPerDrain = static_cast<double>(kScopesPerFrame) * kFramesPerDrain;
+
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.MarkAsRenderThread();
+    profiler.SetEnabled(true);
+    const BenchScopes scopes = RegisterBenchScopes();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // First clock-rate estimate, so durations are recorded
+
+    // Warm-up drain creates the call tree nodes and their histograms
+    for (int f = 0; f < kFramesPerDrain; f++) RecordFrame(profiler, scopes);
+    profiler.EndFrame();
+
+    double treeBest = 0.0;
+    for (int d = 0; d < drains; d++) {
+        for (int f = 0; f < kFramesPerDrain; f++) RecordFrame(profiler, scopes);
+        const double start = BenchNowNs();
+        profiler.EndFrame();
+        const double ns = BenchNowNs() - start;
+        if (d == 0 || ns < treeBest) treeBest = ns;
+    }
+
+    const std::vector<LegacyEvent> legacyEvents = MakeLegacyEvents();
+    std::unordered_map<std::string, LegacyEntry> legacyEntries;
+    AggregateLegacy(legacyEvents, legacyEntries);
+    const double legacyBest = MeasureNsPerOp(1, drains, [&] { AggregateLegacy(legacyEvents, legacyEntries); });
+    DoNotOptimize(legacyEntries);
+
+    std::printf("Profiler aggregation, %.0f scopes per drain\n", scopesPerDrain);
+    std::printf("  %-12s %12s %14s\n", "", "ns/scope", "M scopes/s");
+    std::printf("  %-12s %12.1f %14.1f\n", "call tree", treeBest / scopesPerDrain, scopesPerDrain / treeBest * 1000.0);
+    std::printf("  %-12s %12.1f %14.1f\n", "string keys", legacyBest / scopesPerDrain, scopesPerDrain / legacyBest * 1000.0);
+    return 0;
+}
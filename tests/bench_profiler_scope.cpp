@@ -0,0 +1,137 @@
+// ============================================================================
+// BENCH_PROFILER_SCOPE.CPP - Capture-side overhead of one profiled scope
+// ============================================================================
+// Cost a PROFILE_SCOPE adds to the thread it runs on (begin + end):
+//   disabled     - profiler off: the enabled check only
+//   flat         - enabled, one scope at the root
+//   nested       - enabled, a scope four levels down a call tree
+//   old capture  - the ScopedTimer it replaced, modeled: high_resolution_clock
+//                  read twice, a double-millisecond duration, a std::vector
+//                  scope stack and a 32-byte event into a per-thread ring
+// Rings are drained between batches (untimed), so no scope is dropped for a
+// full ring. The clock line is one ReadClock() (TSC when invariant); most of
+// a scope's cost is its two clock reads, and RDTSC is far slower under some
+// hypervisors than on bare metal, so compare the bookkeeping line across
+// machines.
+// ============================================================================
+
+#include "bench_util.h"
+#include "profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kScopesPerBatch = 4000; // Two records each, well under the 16384-record ring
+
+// The pre-TSC capture path, kept to the parts that cost time on the producing thread
+struct OldTimingEvent {
+    const char* sectionName;
+    const char* parentName;
+    double durationMs;
+    uint32_t threadId;
+    uint8_t depth;
+    bool isRenderThread;
+};
+
+struct OldThreadBuffer {
+    static constexpr size_t RING_BUFFER_SIZE = 4096;
+    OldTimingEvent events[RING_BUFFER_SIZE];
+    std::atomic<size_t> writeIndex{ 0 };
+    std::atomic<size_t> readIndex{ 0 };
+    std::vector<const char*> scopeStack;
+};
+
+class OldScopedTimer {
+  public:
+    OldScopedTimer(OldThreadBuffer& buffer, const char* name) : m_buffer(buffer), m_name(name) {
+        m_parent = buffer.scopeStack.empty() ? nullptr : buffer.scopeStack.back();
+        buffer.scopeStack.push_back(name);
+        m_start = std::chrono::high_resolution_clock::now();
+    }
+    ~OldScopedTimer() {
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double durationMs = std::chrono::duration<double, std::milli>(end - m_start).count();
+        m_buffer.scopeStack.pop_back();
+        const size_t write = m_buffer.writeIndex.load(std::memory_order_relaxed);
+        const size_t next = (write + 1) % OldThreadBuffer::RING_BUFFER_SIZE;
+        if (next == m_buffer.readIndex.load(std::memory_order_acquire)) return; // Full
+        m_buffer.events[write] = { m_name, m_parent, durationMs, 0, static_cast<uint8_t>(m_buffer.scopeStack.size()), true };
+        m_buffer.writeIndex.store(next, std::memory_order_release);
+    }
+
+  private:
+    OldThreadBuffer& m_buffer;
+    const char* m_name;
+    const char* m_parent = nullptr;
+    std::chrono::high_resolution_clock::time_point m_start;
+};
+
+// Best-of-`batches` ns per scope; drain() runs untimed after each batch
+template <typename Fn, typename Drain> double MeasureScopes(int batches, Fn&& scope, Drain&& drain) {
+    double best = 0.0;
+    for (int b = 0; b < batches; b++) {
+        const double start = BenchNowNs();
+        for (int i = 0; i < kScopesPerBatch; i++) scope();
+        const double perScope = (BenchNowNs() - start) / kScopesPerBatch;
+        drain();
+        if (b == 0 || perScope < best) best = perScope;
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int batches = quick ? 3 : 500;
+
+    Profiler& profiler = Profiler::GetInstance();
+    const Profiler::ScopeId leaf = Profiler::RegisterScope("Leaf");
+    const Profiler::ScopeId outer[3] = { Profiler::RegisterScope("Outer0"), Profiler::RegisterScope("Outer1"),
+                                         Profiler::RegisterScope("Outer2") };
+    auto drainProfiler = [&] { profiler.EndFrame(); };
+
+    const double disabled = MeasureScopes(batches, [&] { Profiler::ScopedTimer timer(profiler, leaf); }, [] {});
+
+    profiler.SetEnabled(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // First clock-rate estimate
+    { Profiler::ScopedTimer warm(profiler, leaf); }
+    drainProfiler();
+    const double flat = MeasureScopes(batches, [&] { Profiler::ScopedTimer timer(profiler, leaf); }, drainProfiler);
+
+    double nested = 0.0;
+    {
+        // The three outer scopes stay open; their end records come after the last batch
+        Profiler::ScopedTimer t0(profiler, outer[0]);
+        Profiler::ScopedTimer t1(profiler, outer[1]);
+        Profiler::ScopedTimer t2(profiler, outer[2]);
+        nested = MeasureScopes(batches, [&] { Profiler::ScopedTimer timer(profiler, leaf); }, drainProfiler);
+    }
+    drainProfiler();
+
+    uint64_t clockSink = 0;
+    const double clock = MeasureNsPerOp(kScopesPerBatch, batches, [&] { clockSink += profiler.ReadClock(); });
+    DoNotOptimize(clockSink);
+
+    static OldThreadBuffer s_oldBuffer;
+    auto drainOld = [&] { s_oldBuffer.readIndex.store(s_oldBuffer.writeIndex.load()); };
+    OldScopedTimer oldOuter0(s_oldBuffer, "Outer0");
+    OldScopedTimer oldOuter1(s_oldBuffer, "Outer1");
+    OldScopedTimer oldOuter2(s_oldBuffer, "Outer2");
+    const double old = MeasureScopes(batches, [&] { OldScopedTimer timer(s_oldBuffer, "Leaf"); }, drainOld);
+
+    std::printf("Profiled scope overhead (begin + end), clock: %s\n", HasInvariantTsc() ? "TSC" : "fallback");
+    std::printf("  %-12s %10s\n", "", "ns/scope");
+    std::printf("  %-12s %10.1f\n", "disabled", disabled);
+    std::printf("  %-12s %10.1f\n", "flat", flat);
+    std::printf("  %-12s %10.1f\n", "nested", nested);
+    std::printf("  %-12s %10.1f\n", "old capture", old);
+    std::printf("  %-12s %10.1f  (one read)\n", "clock", clock);
+    std::printf("  %-12s %10.1f  (flat minus two clock reads)\n", "bookkeeping", flat - 2.0 * clock);
+    return 0;
+}
@@ -0,0 +1,186 @@
+// ============================================================================
+// BENCH_RAW_INPUT_SENSITIVITY.CPP - Per-packet cost of the raw input hook's scaling
+// ============================================================================
+// Replays a one-second stream of 8 kHz mouse packets (tracking, flicks, idle
+// jitter) repeatedly through:
+//   published - PublishedMouseSensitivity::Load + RawMouseAccumulator, as
+//               the GetRawInputData hook does now
+//   resolved  - the previous per-packet resolve: temp-override mutex,
+//               config snapshot shared_ptr load, mode lookup by handle
+// Each is measured alone and with a second thread republishing the
+// sensitivity at 1 kHz (hotkey spam, config edits), which contends the
+// mutex and snapshot refcount on the old path.
+// ============================================================================
+
+#include "bench_util.h"
+#include "mouse_sensitivity.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kPacketsPerSecond = 8000;
+
+struct Packet {
+    long dx = 0;
+    long dy = 0;
+};
+
+std::vector<Packet> MakePacketStream(int count) {
+    std::vector<Packet> packets(count);
+    uint32_t state = 8000;
+    for (int i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        const int phase = (i / 800) % 3; // 100 ms segments
+        const long noise = static_cast<long>((state >> 16) % 3) - 1;
+        if (phase == 0) {
+            packets[i] = { 2 + noise, noise }; // Slow tracking
+        } else if (phase == 1) {
+            packets[i] = { 40 + noise * 5, -6 + noise }; // Flick
+        } else {
+            packets[i] = { noise, (state >> 20) % 7 == 0 ? noise : 0 }; // Idle hand jitter
+        }
+    }
+    return packets;
+}
+
+// Reduced stand-ins for the config snapshot and mode table the hook used to read
+struct BenchModeConfig {
+    bool sensitivityOverrideEnabled = false;
+    bool separateXYSensitivity = false;
+    float modeSensitivity = 1.0f;
+    float modeSensitivityX = 1.0f;
+    float modeSensitivityY = 1.0f;
+};
+struct BenchConfig {
+    float mouseSensitivity = 1.0f;
+    std::vector<BenchModeConfig> modes;
+    std::vector<uint32_t> modeIndexByHandle;
+};
+struct BenchTempOverride {
+    bool active = false;
+    float sensitivityX = 1.0f;
+    float sensitivityY = 1.0f;
+};
+
+struct ResolvedState {
+    std::shared_ptr<const BenchConfig> config;
+    std::mutex tempMutex;
+    BenchTempOverride temp;
+    std::atomic<uint32_t> currentMode{ 3 };
+};
+
+void ResolveFromSnapshot(ResolvedState& state, float& outX, float& outY) {
+    {
+        std::lock_guard<std::mutex> lock(state.tempMutex);
+        if (state.temp.active) {
+            outX = state.temp.sensitivityX;
+            outY = state.temp.sensitivityY;
+            return;
+        }
+    }
+    const uint32_t handle = state.currentMode.load(std::memory_order_acquire);
+    auto cfg = std::atomic_load_explicit(&state.config, std::memory_order_acquire);
+    const BenchModeConfig* mode = nullptr;
+    if (cfg && handle < cfg->modeIndexByHandle.size()) mode = &cfg->modes[cfg->modeIndexByHandle[handle]];
+    if (mode && mode->sensitivityOverrideEnabled) {
+        outX = mode->separateXYSensitivity ? mode->modeSensitivityX : mode->modeSensitivity;
+        outY = mode->separateXYSensitivity ? mode->modeSensitivityY : mode->modeSensitivity;
+    } else if (cfg) {
+        outX = outY = cfg->mouseSensitivity;
+    }
+}
+
+std::shared_ptr<const BenchConfig> MakeConfig(float sensitivity) {
+    auto cfg = std::make_shared<BenchConfig>();
+    cfg->mouseSensitivity = 0.8f;
+    cfg->modes.resize(12);
+    for (size_t i = 0; i < cfg->modes.size(); i++) cfg->modeIndexByHandle.push_back(static_cast<uint32_t>(i));
+    cfg->modes[3].sensitivityOverrideEnabled = true;
+    cfg->modes[3].modeSensitivity = sensitivity;
+    return cfg;
+}
+
+// Runs `seconds` of the stream through scale(); returns ns per packet and sums the output so it stays live
+template <typename Fn> double ReplayNsPerPacket(const std::vector<Packet>& stream, int seconds, Fn&& scale) {
+    long sum = 0;
+    const double start = BenchNowNs();
+    for (int s = 0; s < seconds; s++) {
+        for (const Packet& packet : stream) {
+            long dx = packet.dx, dy = packet.dy;
+            scale(dx, dy);
+            sum += dx + dy;
+        }
+    }
+    const double elapsed = BenchNowNs() - start;
+    DoNotOptimize(sum);
+    return elapsed / (static_cast<double>(stream.size()) * seconds);
+}
+
+// Starts a thread republishing every 1 ms through publish(i) until stop is set
+template <typename Fn> std::thread StartRepublisher(std::atomic<bool>& stop, Fn publish) {
+    return std::thread([&stop, publish]() mutable {
+        for (int i = 0; !stop.load(std::memory_order_relaxed); i++) {
+            publish(i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const int seconds = quick ? 1 : 200;
+    const std::vector<Packet> stream = MakePacketStream(kPacketsPerSecond);
+
+    PublishedMouseSensitivity published;
+    published.Publish(0.45f, 0.45f);
+    RawMouseAccumulator publishedAccumulator;
+    auto publishedScale = [&](long& dx, long& dy) {
+        float sx = 1.0f, sy = 1.0f;
+        published.Load(sx, sy);
+        if (sx != 1.0f || sy != 1.0f) publishedAccumulator.Scale(dx, dy, sx, sy);
+    };
+
+    ResolvedState resolved;
+    resolved.config = MakeConfig(0.45f);
+    RawMouseAccumulator resolvedAccumulator;
+    auto resolvedScale = [&](long& dx, long& dy) {
+        float sx = 1.0f, sy = 1.0f;
+        ResolveFromSnapshot(resolved, sx, sy);
+        if (sx != 1.0f || sy != 1.0f) resolvedAccumulator.Scale(dx, dy, sx, sy);
+    };
+
+    std::printf("8 kHz raw mouse replay, %d s of packets (%u hardware threads)\n", seconds, std::thread::hardware_concurrency());
+    std::printf("  %-28s %12s %12s\n", "", "published ns", "resolved ns");
+    std::printf("  %-28s %12.2f %12.2f\n", "idle config", ReplayNsPerPacket(stream, seconds, publishedScale),
+                ReplayNsPerPacket(stream, seconds, resolvedScale));
+
+    std::atomic<bool> stop{ false };
+    std::thread publishedWriter = StartRepublisher(stop, [&](int i) { published.Publish(i % 2 ? 0.45f : 0.5f, 0.45f); });
+    std::thread resolvedWriter = StartRepublisher(stop, [&](int i) {
+        if (i % 2) {
+            std::lock_guard<std::mutex> lock(resolved.tempMutex);
+            resolved.temp.active = !resolved.temp.active;
+            resolved.temp.sensitivityX = resolved.temp.sensitivityY = 0.5f;
+        } else {
+            std::atomic_store_explicit(&resolved.config, MakeConfig(0.45f), std::memory_order_release);
+        }
+    });
+    const double publishedBusy = ReplayNsPerPacket(stream, seconds, publishedScale);
+    const double resolvedBusy = ReplayNsPerPacket(stream, seconds, resolvedScale);
+    stop.store(true);
+    publishedWriter.join();
+    resolvedWriter.join();
+    std::printf("  %-28s %12.2f %12.2f\n", "republished at 1 kHz", publishedBusy, resolvedBusy);
+    std::printf("  (an 8 kHz mouse spends 125000 ns between packets)\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+// ============================================================================
+// BENCH_RING_BUFFER.CPP - LockFreeRing throughput per producer/consumer shape
+// ============================================================================
+// Threads hammer one ring with 16-byte elements, like the queues the DLL
+// uses. Reported as million elements per second through the ring, plus the
+// uncontended single-thread push+pop cost. Cross-thread numbers depend
+// heavily on core count; on a single core they mostly measure yielding.
+// ============================================================================
+
+#include "bench_util.h"
+#include "ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Element {
+    uint64_t a = 0;
+    uint64_t b = 0;
+};
+
+template <typename Ring> double MeasureThroughput(Ring& ring, int producers, int consumers, uint64_t perProducer) {
+    const uint64_t total = perProducer * static_cast<uint64_t>(producers);
+    std::atomic<uint64_t> consumed{ 0 };
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            uint64_t sum = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                const size_t n = ring.ConsumeAll([&](Element& e) { sum += e.a; }, 64);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(n, std::memory_order_relaxed);
+            }
+            DoNotOptimize(sum);
+        });
+    }
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i = 0; i < perProducer; i++) {
+                while (!ring.Push(Element{ i, i })) std::this_thread::yield();
+            }
+        });
+    }
+
+    const double startNs = BenchNowNs();
+    start.store(true, std::memory_order_release);
+    for (std::thread& t : threads) t.join();
+    return static_cast<double>(total) / ((BenchNowNs() - startNs) / 1e9) / 1e6;
+}
+
+template <typename Ring> void Report(const char* name, int producers, int consumers, uint64_t perProducer) {
+    static Ring s_ring;
+    std::printf("  %-22s %dP/%dC %10.2f M/s\n", name, producers, consumers, MeasureThroughput(s_ring, producers, consumers, perProducer));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = IsQuickBenchRun(argc, argv);
+    const uint64_t perProducer = quick ? 20000 : 2000000;
+
+    std::printf("Uncontended push+pop, one thread\n");
+    {
+        static SpscRing<Element, 1024> s_spsc;
+        static MpmcRing<Element, 1024> s_mpmc;
+        Element out;
+        const uint64_t iterations = quick ? 10000 : 20000000;
+        const double spsc = MeasureNsPerOp(iterations, quick ? 1 : 3, [&] {
+            s_spsc.Push(Element{ 1, 2 });
+            s_spsc.TryPop(out);
+            DoNotOptimize(out);
+        });
+        const double mpmc = MeasureNsPerOp(iterations, quick ? 1 : 3, [&] {
+            s_mpmc.Push(Element{ 1, 2 });
+            s_mpmc.TryPop(out);
+            DoNotOptimize(out);
+        });
+        std::printf("  %-22s %10.2f ns\n  %-22s %10.2f ns\n", "SpscRing", spsc, "MpmcRing", mpmc);
+    }
+
+    std::printf("Cross-thread throughput, capacity 1024, batch pop of 64 (%u hardware threads)\n", std::thread::hardware_concurrency());
+    Report<SpscRing<Element, 1024>>("SpscRing", 1, 1, perProducer);
+    Report<MpscRing<Element, 1024>>("MpscRing", 4, 1, perProducer / 4);
+    Report<LockFreeRing<Element, 1024, RingProducers::Single, RingConsumers::Multi>>("LockFreeRing (SPMC)", 1, 2, perProducer);
+    Report<MpmcRing<Element, 1024>>("MpmcRing", 2, 2, perProducer / 2);
+    return 0;
+}
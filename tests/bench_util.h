@@ -0,0 +1,48 @@
+#pragma once
+
+// ============================================================================
+// BENCH_UTIL.H - Timing helpers for the tests/ benchmarks
+// ============================================================================
+// Benchmarks are plain executables that print one line per measurement.
+// --quick scales every workload down so ctest can run them as smoke tests
+// (label "bench"); run them without it for numbers worth comparing.
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+inline bool IsQuickBenchRun(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--quick") == 0) return true;
+    }
+    return false;
+}
+
+inline double BenchNowNs() {
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Keeps value (and the work producing it) from being optimized away
+template <typename T> inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* s_sink;
+    s_sink = &value;
+#endif
+}
+
+// Best-of-`repeats` time per call of fn, in nanoseconds. fn runs `iterations` times per repeat.
+template <typename Fn> double MeasureNsPerOp(uint64_t iterations, int repeats, Fn&& fn) {
+    double best = 0.0;
+    for (int r = 0; r < repeats; r++) {
+        const double start = BenchNowNs();
+        for (uint64_t i = 0; i < iterations; i++) fn();
+        const double perOp = (BenchNowNs() - start) / static_cast<double>(iterations);
+        if (r == 0 || perOp < best) best = perOp;
+    }
+    return best;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// ============================================================================
+// CONFIG_TEST_DATA.H - Synthetic configs for the config publish tests/benchmarks
+// ============================================================================
+
+#include "config_types.h"
+
+#include <string>
+
+// A config with `elements` elements spread over the sections roughly like a heavy real setup
+// (40% mirrors, 8% groups, 20% images, 8% overlays, 16% modes, 8% hotkeys)
+inline Config MakeLargeTestConfig(int elements) {
+    Config config;
+    const int mirrors = elements * 40 / 100, groups = elements * 8 / 100, images = elements * 20 / 100;
+    const int overlays = elements * 8 / 100, modes = elements * 16 / 100;
+    const int hotkeys = elements - mirrors - groups - images - overlays - modes;
+
+    for (int i = 0; i < mirrors; i++) {
+        MirrorConfig mirror;
+        mirror.name = "mirror_" + std::to_string(i);
+        MirrorCaptureConfig input;
+        input.x = i;
+        input.relativeTo = "topLeftScreen";
+        mirror.input.push_back(input);
+        mirror.input.push_back(input);
+        mirror.output.x = i * 3;
+        config.mirrors.push_back(mirror);
+    }
+    for (int i = 0; i < groups; i++) {
+        MirrorGroupConfig group;
+        group.name = "group_" + std::to_string(i);
+        for (int item = 0; item < 2; item++) {
+            MirrorGroupItem groupItem;
+            groupItem.mirrorId = "mirror_" + std::to_string((2 * i + item) % (mirrors > 0 ? mirrors : 1));
+            group.mirrors.push_back(groupItem);
+        }
+        config.mirrorGroups.push_back(group);
+    }
+    for (int i = 0; i < images; i++) {
+        ImageConfig image;
+        image.name = "image_" + std::to_string(i);
+        image.path = "C:/Users/player/toolscreen/images/overlay_" + std::to_string(i) + ".png";
+        config.images.push_back(image);
+    }
+    for (int i = 0; i < overlays; i++) {
+        WindowOverlayConfig overlay;
+        overlay.name = "overlay_" + std::to_string(i);
+        overlay.windowTitle = "Ninjabrain Bot " + std::to_string(i);
+        config.windowOverlays.push_back(overlay);
+    }
+    for (int i = 0; i < modes; i++) {
+        ModeConfig mode;
+        mode.id = "mode_" + std::to_string(i);
+        mode.width = 384;
+        mode.height = 16384;
+        mode.widthExpr = "min(screenWidth, 300)";
+        if (mirrors > 0) mode.mirrorIds = { "mirror_" + std::to_string(i % mirrors), "mirror_" + std::to_string((i + 1) % mirrors) };
+        if (groups > 0) mode.mirrorGroupIds = { "group_" + std::to_string(i % groups) };
+        if (images > 0) mode.imageIds = { "image_" + std::to_string(i % images) };
+        if (overlays > 0) mode.windowOverlayIds = { "overlay_" + std::to_string(i % overlays) };
+        config.modes.push_back(mode);
+    }
+    for (int i = 0; i < hotkeys; i++) {
+        HotkeyConfig hotkey;
+        hotkey.keys = { VK_CONTROL, static_cast<DWORD>('A' + i % 26) };
+        hotkey.mainMode = "mode_0";
+        hotkey.secondaryMode = "mode_" + std::to_string(i % (modes > 0 ? modes : 1));
+        config.hotkeys.push_back(hotkey);
+    }
+    return config;
+}
@@ -0,0 +1,220 @@
+// ============================================================================
+// FUZZ_EXPRESSION.CPP - Fuzz target for the expression compiler and evaluator
+// ============================================================================
+// Expressions come from the GUI and from hand-edited TOML, so the compiler
+// must survive anything. Each input is compiled and evaluated, checking:
+//   - compiling either succeeds or reports an error, never both or neither
+//   - compiled variables are only the whitelisted forms
+//   - evaluation is deterministic and any result it accepts is finite
+//   - the cached CompileExpression agrees with an uncached compile
+//
+// Built two ways from this file:
+//   fuzz_expression            standalone driver (any compiler): mutates a
+//                              seed corpus with a fixed-seed PRNG; ctest runs
+//                              it with --quick. File arguments are replayed
+//                              as inputs instead (e.g. a saved crash).
+//   fuzz_expression_libfuzzer  with -DTOOLSCREEN_LIBFUZZER=ON (Clang only):
+//                              LLVMFuzzerTestOneInput under libFuzzer
+// ============================================================================
+
+#include "expression_compiler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t kMaxInputSize = 4096;
+
+[[noreturn]] void Fail(const std::string& input, const char* what) {
+    std::fprintf(stderr, "fuzz_expression: %s\ninput (%zu bytes): \"%s\"\n", what, input.size(), input.c_str());
+    std::abort();
+}
+
+bool IsWhitelistedVariable(const std::string& name) {
+    if (name == "screenWidth" || name == "screenHeight") return true;
+    const size_t dot = name.find('.');
+    if (dot == std::string::npos || dot == 0) return false;
+    const std::string field = name.substr(dot + 1);
+    return field == "width" || field == "height";
+}
+
+// Evaluates with every variable bound to `value`; result stays NAN when Evaluate rejects
+double EvaluateWith(const std::string& input, const CompiledExpression& program, double value) {
+    std::vector<double> values(program.Variables().size());
+    for (size_t i = 0; i < values.size(); i++) values[i] = value + static_cast<double>(i);
+
+    double out = NAN;
+    if (!program.Evaluate(values.data(), out)) return NAN;
+    if (!std::isfinite(out)) Fail(input, "Evaluate accepted a non-finite result");
+    return out;
+}
+
+bool SameResult(double a, double b) { return (std::isnan(a) && std::isnan(b)) || a == b; }
+
+void CheckExpression(const std::string& input) {
+    CompiledExpression program;
+    std::string error;
+    const bool compiled = CompileExpressionText(input, program, error);
+    if (compiled != error.empty()) Fail(input, "compile result and error message disagree");
+
+    if (compiled) {
+        for (const std::string& variable : program.Variables()) {
+            if (!IsWhitelistedVariable(variable)) Fail(input, "compiled a non-whitelisted variable");
+        }
+        CompiledExpression again;
+        std::string againError;
+        if (!CompileExpressionText(input, again, againError) || again.Variables() != program.Variables()) {
+            Fail(input, "compiling twice gave different programs");
+        }
+        for (double value : { 0.0, 1.0, 1920.0, -7.5 }) {
+            if (!SameResult(EvaluateWith(input, program, value), EvaluateWith(input, again, value))) {
+                Fail(input, "evaluation is not deterministic");
+            }
+        }
+        if (program.IsConstant() && std::isnan(EvaluateWith(input, program, 0.0))) {
+            Fail(input, "a folded constant failed to evaluate");
+        }
+    }
+
+    // The cached entry point compiles the trimmed text; an all-whitespace input is an error there
+    std::string cachedError;
+    const auto cached = CompileExpression(input, cachedError);
+    const bool trimmed = !input.empty() && !std::strchr(" \t\r\n", input.front()) && !std::strchr(" \t\r\n", input.back());
+    if (trimmed) {
+        if ((cached != nullptr) != compiled || cachedError != error) Fail(input, "CompileExpression disagrees with CompileExpressionText");
+    }
+    if (cached) EvaluateWith(input, *cached, 3.0);
+
+    (void)IsExpression(input);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size > kMaxInputSize) return 0;
+    CheckExpression(std::string(reinterpret_cast<const char*>(data), size));
+    return 0;
+}
+
+#ifndef TOOLSCREEN_LIBFUZZER
+
+namespace {
+
+const char* const kSeeds[] = {
+    "screenWidth",
+    "screenHeight - 300",
+    "min(screenWidth, 300)",
+    "max(screenHeight * 0.9, 16384)",
+    "(screenWidth - 300) / 2",
+    "roundEven(screenHeight / 2.5)",
+    "floor(EyeZoom.width / 3) + ceil(Thin.height)",
+    "abs(-screenWidth) + round(1.5)",
+    "-(-(-screenWidth))",
+    "1920 / (2 - 2)",
+    "min(1, 2, 3)",
+    "((((((((((1))))))))))",
+    "1..2 + .5",
+    "Preemptive.height*2",
+    "unknown(1)",
+    "screenWidth.depth",
+};
+
+// Fragments spliced in by the mutator, biased towards the grammar so mutants get past the tokenizer
+const char* const kFragments[] = { "(", ")", ",", "+", "-", "*", "/", ".", " ", "0", "9", "1e9", "0.5",
+                                   "min(", "max(", "floor(", "roundEven(", "screenWidth", "screenHeight",
+                                   "EyeZoom.width", ".height", "_", "\t", "((((((((", "--------" };
+
+uint32_t NextRandom(uint64_t& state) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<uint32_t>(state >> 33);
+}
+
+std::string Mutate(std::string input, uint64_t& rng) {
+    const int steps = 1 + static_cast<int>(NextRandom(rng) % 4);
+    for (int step = 0; step < steps; step++) {
+        const size_t pos = input.empty() ? 0 : NextRandom(rng) % (input.size() + 1);
+        switch (NextRandom(rng) % 6) {
+        case 0: // Insert a fragment
+            input.insert(pos, kFragments[NextRandom(rng) % (sizeof(kFragments) / sizeof(kFragments[0]))]);
+            break;
+        case 1: // Insert a random byte
+            input.insert(input.begin() + pos, static_cast<char>(NextRandom(rng) & 0xFF));
+            break;
+        case 2: // Delete a range
+            if (!input.empty()) input.erase(pos == input.size() ? pos - 1 : pos, 1 + NextRandom(rng) % 4);
+            break;
+        case 3: // Overwrite a byte with a grammar character
+            if (pos < input.size()) input[pos] = "0123456789.+-*/(), abcxyz"[NextRandom(rng) % 25];
+            break;
+        case 4: // Duplicate a slice (grows nesting and operator chains)
+            if (!input.empty()) {
+                const size_t from = NextRandom(rng) % input.size();
+                input.insert(pos, input.substr(from, 1 + NextRandom(rng) % 16));
+            }
+            break;
+        default: // Splice with another seed
+            input += kSeeds[NextRandom(rng) % (sizeof(kSeeds) / sizeof(kSeeds[0]))];
+            break;
+        }
+    }
+    if (input.size() > kMaxInputSize) input.resize(kMaxInputSize);
+    return input;
+}
+
+int ReplayFiles(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') continue;
+        FILE* file = std::fopen(argv[i], "rb");
+        if (!file) {
+            std::fprintf(stderr, "fuzz_expression: can't open %s\n", argv[i]);
+            return 1;
+        }
+        std::string input;
+        char buffer[4096];
+        size_t read = 0;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) input.append(buffer, read);
+        std::fclose(file);
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false, files = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--quick") == 0) quick = true;
+        else if (argv[i][0] != '-') files = true;
+    }
+    if (files) return ReplayFiles(argc, argv);
+
+    // Hostile shapes the mutator is unlikely to reach on its own
+    CheckExpression(std::string(2000, '(') + "1" + std::string(2000, ')'));
+    CheckExpression(std::string(3000, '-') + "1");
+    CheckExpression("min(" + std::string(1000, '1') + ", 2)");
+    std::string chain = "1";
+    for (int i = 0; i < 200; i++) chain = "(" + chain + "+screenWidth)";
+    CheckExpression(chain);
+
+    const uint64_t iterations = quick ? 20000 : 2000000;
+    uint64_t rng = 0x7A11C0DEull;
+    const size_t seedCount = sizeof(kSeeds) / sizeof(kSeeds[0]);
+    for (size_t i = 0; i < seedCount; i++) CheckExpression(kSeeds[i]);
+    for (uint64_t i = 0; i < iterations; i++) {
+        std::string input = kSeeds[NextRandom(rng) % seedCount];
+        const int generations = 1 + static_cast<int>(NextRandom(rng) % 8);
+        for (int g = 0; g < generations; g++) input = Mutate(std::move(input), rng);
+        CheckExpression(input);
+    }
+    std::printf("fuzz_expression: %llu mutated inputs, no failures\n", static_cast<unsigned long long>(iterations));
+    return 0;
+}
+
+#endif // TOOLSCREEN_LIBFUZZER
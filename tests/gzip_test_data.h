@@ -0,0 +1,79 @@
+#pragma once
+
+// ============================================================================
+// GZIP_TEST_DATA.H - Inputs for the gzip encoder tests and benchmark
+// ============================================================================
+// MakeTestLog() writes latest.log-shaped text: timestamped lines from a small
+// set of messages with varying numbers and names, so matches are short and
+// frequent the way they are in real logs. Everything is deterministic per seed.
+// ============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "gzip_stream.h"
+
+inline uint32_t GzipTestRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+inline std::vector<uint8_t> MakeTestLog(size_t size, uint32_t seed = 1) {
+    static const char* const kModes[] = { "Fullscreen", "Thin", "Wide", "EyeZoom", "Preemptive" };
+    static const char* const kElements[] = { "Pie Chart", "Entity Counter", "F3 Coords", "Mapless", "Ninjabrain" };
+    std::vector<uint8_t> out;
+    out.reserve(size + 256);
+    uint32_t state = seed;
+    uint32_t ms = 12 * 3600000u;
+    char line[256];
+    while (out.size() < size) {
+        ms += GzipTestRandom(state) % 400;
+        const int n = std::snprintf(line, sizeof(line), "[%02u:%02u:%02u.%03u] ", ms / 3600000u % 24, ms / 60000u % 60, ms / 1000u % 60, ms % 1000u);
+        int m = 0;
+        const uint32_t r = GzipTestRandom(state);
+        switch (r % 5) {
+        case 0:
+            m = std::snprintf(line + n, sizeof(line) - n, "Mode switch: %s -> %s (%u ms transition)\n", kModes[r / 5 % 5],
+                              kModes[r / 25 % 5], r / 125 % 400);
+            break;
+        case 1:
+            m = std::snprintf(line + n, sizeof(line) - n, "Resized copy textures to %ux%u\n", 320 + r / 5 % 3520, 240 + r / 17 % 1920);
+            break;
+        case 2:
+            m = std::snprintf(line + n, sizeof(line) - n, "[Mirror] '%s' capture plan: %u region(s), %u px\n", kElements[r / 5 % 5],
+                              1 + r / 25 % 4, r / 100 % 90000);
+            break;
+        case 3:
+            m = std::snprintf(line + n, sizeof(line) - n, "Hotkey 0x%X pressed (debounce %u ms)\n", 0x41 + r / 5 % 26, r / 130 % 250);
+            break;
+        default:
+            m = std::snprintf(line + n, sizeof(line) - n, "Frame time %u.%03u ms, GPU %u.%03u ms\n", r / 5 % 40, r / 200 % 1000,
+                              r / 7 % 30, r / 210 % 1000);
+            break;
+        }
+        out.insert(out.end(), line, line + n + m);
+    }
+    out.resize(size);
+    return out;
+}
+
+inline std::vector<uint8_t> MakeRandomBytes(size_t size, uint32_t seed = 1) {
+    std::vector<uint8_t> out(size);
+    uint32_t state = seed;
+    for (uint8_t& b : out) b = static_cast<uint8_t>(GzipTestRandom(state));
+    return out;
+}
+
+// Compresses input with GzipEncoder, fed chunkSize bytes per Write() as CompressFileToGzip does
+inline std::vector<uint8_t> GzipInChunks(const std::vector<uint8_t>& input, size_t chunkSize) {
+    std::vector<uint8_t> out;
+    GzipEncoder encoder;
+    for (size_t pos = 0; pos < input.size(); pos += chunkSize) {
+        const size_t n = (std::min)(chunkSize, input.size() - pos);
+        encoder.Write(input.data() + pos, n, out);
+    }
+    encoder.Finish(out);
+    return out;
+}
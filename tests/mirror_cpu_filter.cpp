@@ -0,0 +1,390 @@
+// ============================================================================
+// MIRROR_CPU_FILTER.CPP - CPU mirror filter pipeline (scalar / SSE2 / AVX2)
+// ============================================================================
+// Sampling rules reproduced from the GPU path:
+//  - Pass 1 draws each input region 1:1 into the filter FBO at (padding, padding),
+//    sampling the game texture with GL_NEAREST + CLAMP_TO_EDGE. Non-raw output
+//    uses additive blending (GL_ONE, GL_ONE) into RGBA8, i.e. saturating adds.
+//  - Pass 2 draws a fullscreen quad into the final FBO; every sample of the
+//    filter texture is GL_NEAREST at ((x + 0.5) / finalW) * fboW (in GL's
+//    bottom-up row order), clamped to the edge.
+//  - The dynamic border is "alpha > 0.5 anywhere in the (2w+1)^2 window around
+//    this output pixel". That window max is separable, so it is computed as a
+//    horizontal then vertical max over a 0/255 coverage mask, exactly like the
+//    two GPU border passes. MirrorCpuFinalPassReference keeps the brute-force
+//    form of the original shaders for comparison.
+// ============================================================================
+
+#include "mirror_cpu_filter.h"
+#include "mirror_color_lut.h"
+#include "relative_coords.h"
+
+#include <algorithm>
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+enum class FilterMode { Raw, Color, Passthrough };
+
+constexpr uint32_t kAlphaOne = 0xFF000000u;
+
+inline uint32_t LoadPixel(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline void StorePixel(uint8_t* p, uint32_t v) { std::memcpy(p, &v, 4); }
+
+inline uint8_t ToByte(float c) {
+    if (!(c > 0.0f)) return 0;
+    if (c >= 1.0f) return 255;
+    return static_cast<uint8_t>(c * 255.0f + 0.5f);
+}
+
+inline uint32_t PackColor(const Color& c) {
+    return static_cast<uint32_t>(ToByte(c.r)) | (static_cast<uint32_t>(ToByte(c.g)) << 8) | (static_cast<uint32_t>(ToByte(c.b)) << 16) |
+           (static_cast<uint32_t>(ToByte(c.a)) << 24);
+}
+
+inline uint32_t AddSaturateBytes(uint32_t a, uint32_t b) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t s = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF);
+        out |= ((s > 255) ? 255u : s) << shift;
+    }
+    return out;
+}
+
+inline bool LookupMatch(const uint32_t* lut, uint32_t px) {
+    const uint32_t index = ((px & 0xFF) << 16) | (((px >> 8) & 0xFF) << 8) | ((px >> 16) & 0xFF);
+    return (lut[index >> 5] >> (index & 31)) & 1u;
+}
+
+// ---------------------------------------------------------------------------
+// Pass 1 row kernels: dst[i] (+)= f(line[i]) for n pixels
+// ---------------------------------------------------------------------------
+
+inline void FilterPixelScalar(const uint8_t* in, uint8_t* out, const uint32_t* lut, FilterMode mode, uint32_t color) {
+    const uint32_t px = LoadPixel(in);
+    if (mode == FilterMode::Raw) {
+        StorePixel(out, px | kAlphaOne);
+        return;
+    }
+    if (!LookupMatch(lut, px)) return;
+    const uint32_t contrib = (mode == FilterMode::Passthrough) ? (px | kAlphaOne) : color;
+    StorePixel(out, AddSaturateBytes(LoadPixel(out), contrib));
+}
+
+void FilterRowScalar(const uint8_t* line, uint8_t* dst, int n, const uint32_t* lut, FilterMode mode, uint32_t color) {
+    for (int i = 0; i < n; i++) { FilterPixelScalar(line + i * 4, dst + i * 4, lut, mode, color); }
+}
+
+void FilterRowSSE2(const uint8_t* line, uint8_t* dst, int n, const uint32_t* lut, FilterMode mode, uint32_t color) {
+    const __m128i alphaOne = _mm_set1_epi32(static_cast<int>(kAlphaOne));
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128i colorV = _mm_set1_epi32(static_cast<int>(color));
+    alignas(16) uint32_t idx[4];
+    alignas(16) uint32_t match[4];
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + i * 4));
+        if (mode == FilterMode::Raw) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(px, alphaOne));
+            continue;
+        }
+
+        // SSE2 has no gather: build the table indices in SIMD, look up the four words in scalar.
+        const __m128i r = _mm_and_si128(px, byteMask);
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), byteMask);
+        const __m128i b = _mm_and_si128(_mm_srli_epi32(px, 16), byteMask);
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8)), b));
+        for (int k = 0; k < 4; k++) { match[k] = ((lut[idx[k] >> 5] >> (idx[k] & 31)) & 1u) ? 0xFFFFFFFFu : 0u; }
+        const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(match));
+        if (_mm_movemask_epi8(mask) == 0) continue;
+
+        const __m128i src = (mode == FilterMode::Passthrough) ? _mm_or_si128(px, alphaOne) : colorV;
+        __m128i* out = reinterpret_cast<__m128i*>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_adds_epu8(_mm_loadu_si128(out), _mm_and_si128(mask, src)));
+    }
+    FilterRowScalar(line + i * 4, dst + i * 4, n - i, lut, mode, color);
+}
+
+CPU_TARGET_AVX2 void FilterRowAVX2(const uint8_t* line, uint8_t* dst, int n, const uint32_t* lut, FilterMode mode, uint32_t color) {
+    const __m256i alphaOne = _mm256_set1_epi32(static_cast<int>(kAlphaOne));
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i bitMask = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i colorV = _mm256_set1_epi32(static_cast<int>(color));
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line + i * 4));
+        if (mode == FilterMode::Raw) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_or_si256(px, alphaOne));
+            continue;
+        }
+
+        const __m256i r = _mm256_and_si256(px, byteMask);
+        const __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 8), byteMask);
+        const __m256i b = _mm256_and_si256(_mm256_srli_epi32(px, 16), byteMask);
+        const __m256i index = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_slli_epi32(g, 8)), b);
+        const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(lut), _mm256_srli_epi32(index, 5), 4);
+        const __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_and_si256(index, bitMask)), one);
+        const __m256i mask = _mm256_cmpeq_epi32(bit, one);
+        if (_mm256_movemask_epi8(mask) == 0) continue;
+
+        const __m256i src = (mode == FilterMode::Passthrough) ? _mm256_or_si256(px, alphaOne) : colorV;
+        __m256i* out = reinterpret_cast<__m256i*>(dst + i * 4);
+        _mm256_storeu_si256(out, _mm256_adds_epu8(_mm256_loadu_si256(out), _mm256_and_si256(mask, src)));
+    }
+    FilterRowScalar(line + i * 4, dst + i * 4, n - i, lut, mode, color);
+}
+
+using FilterRowFn = void (*)(const uint8_t*, uint8_t*, int, const uint32_t*, FilterMode, uint32_t);
+
+FilterRowFn SelectFilterRow(CpuSimdLevel level) {
+    switch (ResolveCpuSimdLevel(level)) {
+    case CpuSimdLevel::AVX2:
+        return FilterRowAVX2;
+    case CpuSimdLevel::SSE41:
+    case CpuSimdLevel::SSE2:
+        return FilterRowSSE2;
+    default:
+        return FilterRowScalar;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Byte-wise max kernels for the separable border dilation: dst[i] = max(dst[i], src[i])
+// ---------------------------------------------------------------------------
+
+void MaxBytesScalar(uint8_t* dst, const uint8_t* src, int n) {
+    for (int i = 0; i < n; i++) { dst[i] = (std::max)(dst[i], src[i]); }
+}
+
+void MaxBytesSSE2(uint8_t* dst, const uint8_t* src, int n) {
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(d, _mm_max_epu8(_mm_loadu_si128(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+    MaxBytesScalar(dst + i, src + i, n - i);
+}
+
+CPU_TARGET_AVX2 void MaxBytesAVX2(uint8_t* dst, const uint8_t* src, int n) {
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(d, _mm256_max_epu8(_mm256_loadu_si256(d), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+    }
+    MaxBytesScalar(dst + i, src + i, n - i);
+}
+
+using MaxBytesFn = void (*)(uint8_t*, const uint8_t*, int);
+
+MaxBytesFn SelectMaxBytes(CpuSimdLevel level) {
+    switch (ResolveCpuSimdLevel(level)) {
+    case CpuSimdLevel::AVX2:
+        return MaxBytesAVX2;
+    case CpuSimdLevel::SSE41:
+    case CpuSimdLevel::SSE2:
+        return MaxBytesSSE2;
+    default:
+        return MaxBytesScalar;
+    }
+}
+
+// GL_NEAREST + CLAMP_TO_EDGE texel hit by output pixel i when stretching srcSize texels over dstSize pixels.
+// Pixels outside [0, dstSize) are valid too: the border shaders sample at out-of-range offsets.
+int NearestTexel(int i, int srcSize, int dstSize) {
+    const long long num = (2LL * i + 1) * srcSize;
+    const long long den = 2LL * dstSize;
+    long long t = num / den;
+    if (num < 0 && t * den != num) t--; // floor for negative offsets
+    return static_cast<int>((std::max)(0LL, (std::min)(t, static_cast<long long>(srcSize - 1))));
+}
+
+// Rows are top-down here but bottom-up in GL, and nearest rounding is not symmetric, so map in GL space
+int NearestRow(int y, int srcSize, int dstSize) { return srcSize - 1 - NearestTexel(dstSize - 1 - y, srcSize, dstSize); }
+
+// Texels for output pixels [-extend, dstSize + extend)
+void BuildNearestMap(int srcSize, int dstSize, int extend, bool rows, std::vector<int>& out) {
+    out.resize(static_cast<size_t>(dstSize) + 2 * static_cast<size_t>(extend));
+    for (int i = -extend; i < dstSize + extend; i++) {
+        out[i + extend] = rows ? NearestRow(i, srcSize, dstSize) : NearestTexel(i, srcSize, dstSize);
+    }
+}
+
+inline bool TexelCovered(const MirrorCpuImage& filter, int tx, int ty) { return filter.Row(ty)[static_cast<size_t>(tx) * 4 + 3] >= 128; }
+
+bool ResolveFinalSize(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, int& outW, int& outH) {
+    const float scaleX = conf.outputSeparateScale ? conf.outputScaleX : conf.outputScale;
+    const float scaleY = conf.outputSeparateScale ? conf.outputScaleY : conf.outputScale;
+    outW = static_cast<int>(filter.width * scaleX);
+    outH = static_cast<int>(filter.height * scaleY);
+    return outW > 0 && outH > 0 && filter.width > 0 && filter.height > 0;
+}
+
+// Dynamic border composite for one output pixel (both render shaders)
+inline void ComposeBorderPixel(uint8_t* dst, const uint8_t* texel, bool covered, bool border, const ThreadedMirrorConfig& conf,
+                               uint32_t outputColor, uint32_t borderColor) {
+    if (covered) {
+        StorePixel(dst, conf.colorPassthrough ? (LoadPixel(texel) | kAlphaOne) : outputColor);
+    } else if (border) {
+        StorePixel(dst, borderColor);
+    }
+    // else: discard (stays cleared to transparent)
+}
+
+} // namespace
+
+void MirrorCpuImage::Reset(int w, int h) {
+    width = (std::max)(w, 0);
+    height = (std::max)(h, 0);
+    rgba.assign(static_cast<size_t>(width) * height * 4, 0);
+}
+
+void MirrorCpuFilterPass(const MirrorCpuSource& src, const ThreadedMirrorConfig& conf, const std::vector<uint32_t>& matchTable,
+                         bool rawOutput, MirrorCpuImage& outFilter, CpuSimdLevel level) {
+    const int padding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
+    const int capW = conf.captureWidth;
+    const int capH = conf.captureHeight;
+    outFilter.Reset(capW + 2 * padding, capH + 2 * padding);
+
+    if (capW <= 0 || capH <= 0 || !src.rgba || src.width <= 0 || src.height <= 0) return;
+    if (!rawOutput && matchTable.size() != static_cast<size_t>(MIRROR_COLOR_LUT_WORDS)) return;
+
+    const FilterMode mode = rawOutput ? FilterMode::Raw : (conf.colorPassthrough ? FilterMode::Passthrough : FilterMode::Color);
+    const uint32_t color = PackColor(conf.outputColor);
+    const uint32_t* lut = rawOutput ? nullptr : matchTable.data();
+    const FilterRowFn filterRow = SelectFilterRow(level);
+
+    std::vector<uint8_t> clampedLine;
+    for (const auto& r : conf.input) {
+        int capX = 0, capY = 0;
+        GetRelativeCoords(r.relativeTo, r.x, r.y, capW, capH, src.width, src.height, capX, capY);
+        const bool rowInside = (capX >= 0 && capX + capW <= src.width);
+
+        for (int j = 0; j < capH; j++) {
+            const int sy = (std::min)((std::max)(capY + j, 0), src.height - 1);
+            const uint8_t* srcRow = src.rgba + static_cast<size_t>(sy) * src.stride;
+
+            const uint8_t* line;
+            if (rowInside) {
+                line = srcRow + static_cast<size_t>(capX) * 4;
+            } else {
+                // Region crosses the frame edge: emulate CLAMP_TO_EDGE into a scratch line
+                clampedLine.resize(static_cast<size_t>(capW) * 4);
+                for (int i = 0; i < capW; i++) {
+                    const int sx = (std::min)((std::max)(capX + i, 0), src.width - 1);
+                    std::memcpy(clampedLine.data() + i * 4, srcRow + static_cast<size_t>(sx) * 4, 4);
+                }
+                line = clampedLine.data();
+            }
+
+            filterRow(line, outFilter.Row(padding + j) + static_cast<size_t>(padding) * 4, capW, lut, mode, color);
+        }
+    }
+}
+
+void MirrorCpuFinalPass(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, bool rawOutput, MirrorCpuImage& outFinal,
+                        CpuSimdLevel level) {
+    int finalW = 0, finalH = 0;
+    const bool valid = ResolveFinalSize(filter, conf, finalW, finalH);
+    outFinal.Reset(finalW, finalH);
+    if (!valid) return;
+
+    // Raw output and static borders: plain nearest blit of the filter texture (background shader, opacity 1)
+    if (rawOutput || conf.borderType == MirrorBorderType::Static) {
+        std::vector<int> xmap, ymap;
+        BuildNearestMap(filter.width, finalW, 0, false, xmap);
+        BuildNearestMap(filter.height, finalH, 0, true, ymap);
+        for (int y = 0; y < finalH; y++) {
+            const uint8_t* srcRow = filter.Row(ymap[y]);
+            uint8_t* dstRow = outFinal.Row(y);
+            for (int x = 0; x < finalW; x++) { std::memcpy(dstRow + x * 4, srcRow + static_cast<size_t>(xmap[x]) * 4, 4); }
+        }
+        return;
+    }
+
+    // Same two passes as the GPU border engine (mt_border_dilate_frag_shader + render shaders):
+    //  1. Horizontal max of the coverage mask over [x - w, x + w] for rows [-w, finalH + w)
+    //  2. Vertical max of those rows over [y - w, y + w]
+    // Sampling outside the image goes through NearestTexel, i.e. clamps to the edge texel like the shaders.
+    const int borderWidth = (std::max)(conf.dynamicBorderThickness, 0);
+    const int extW = finalW + 2 * borderWidth;
+    const int extH = finalH + 2 * borderWidth;
+    std::vector<int> xmap, ymap;
+    BuildNearestMap(filter.width, finalW, borderWidth, false, xmap);
+    BuildNearestMap(filter.height, finalH, borderWidth, true, ymap);
+
+    std::vector<uint8_t> horizontal(static_cast<size_t>(finalW) * extH, 0);
+    std::vector<uint8_t> line(static_cast<size_t>(extW));
+    const MaxBytesFn maxBytes = SelectMaxBytes(level);
+    for (int ey = 0; ey < extH; ey++) {
+        const int ty = ymap[ey];
+        for (int ex = 0; ex < extW; ex++) { line[ex] = TexelCovered(filter, xmap[ex], ty) ? 255 : 0; }
+        uint8_t* hRow = horizontal.data() + static_cast<size_t>(ey) * finalW;
+        for (int dx = 0; dx <= 2 * borderWidth; dx++) { maxBytes(hRow, line.data() + dx, finalW); }
+    }
+
+    std::vector<uint8_t> border(static_cast<size_t>(finalW));
+    const uint32_t outputColor = PackColor(conf.outputColor);
+    const uint32_t borderColor = PackColor(conf.borderColor);
+    for (int y = 0; y < finalH; y++) {
+        // Output row y is extended row y + w; its window is extended rows [y, y + 2w]
+        std::fill(border.begin(), border.end(), static_cast<uint8_t>(0));
+        if (borderWidth > 0) {
+            for (int k = 0; k <= 2 * borderWidth; k++) { maxBytes(border.data(), horizontal.data() + static_cast<size_t>(y + k) * finalW, finalW); }
+        }
+
+        const int ty = ymap[y + borderWidth];
+        const uint8_t* srcRow = filter.Row(ty);
+        uint8_t* dstRow = outFinal.Row(y);
+        for (int x = 0; x < finalW; x++) {
+            const int tx = xmap[x + borderWidth];
+            ComposeBorderPixel(dstRow + x * 4, srcRow + static_cast<size_t>(tx) * 4, TexelCovered(filter, tx, ty), border[x] != 0, conf,
+                               outputColor, borderColor);
+        }
+    }
+}
+
+void MirrorCpuFinalPassReference(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, MirrorCpuImage& outFinal) {
+    int finalW = 0, finalH = 0;
+    const bool valid = ResolveFinalSize(filter, conf, finalW, finalH);
+    outFinal.Reset(finalW, finalH);
+    if (!valid) return;
+
+    // Direct port of the original brute-force shaders: (2w+1)^2 taps per uncovered output pixel
+    const int borderWidth = conf.dynamicBorderThickness;
+    const uint32_t outputColor = PackColor(conf.outputColor);
+    const uint32_t borderColor = PackColor(conf.borderColor);
+    for (int y = 0; y < finalH; y++) {
+        const int ty = NearestRow(y, filter.height, finalH);
+        for (int x = 0; x < finalW; x++) {
+            const int tx = NearestTexel(x, filter.width, finalW);
+            const bool covered = TexelCovered(filter, tx, ty);
+            bool border = false;
+            for (int dx = -borderWidth; dx <= borderWidth && !covered && !border; dx++) {
+                for (int dy = -borderWidth; dy <= borderWidth; dy++) {
+                    if (dx == 0 && dy == 0) continue;
+                    if (TexelCovered(filter, NearestTexel(x + dx, filter.width, finalW), NearestRow(y + dy, filter.height, finalH))) {
+                        border = true;
+                        break;
+                    }
+                }
+            }
+            ComposeBorderPixel(outFinal.Row(y) + static_cast<size_t>(x) * 4, filter.Row(ty) + static_cast<size_t>(tx) * 4, covered, border,
+                               conf, outputColor, borderColor);
+        }
+    }
+}
+
+void RunMirrorCpuPipeline(const MirrorCpuSource& src, const ThreadedMirrorConfig& conf, const std::vector<uint32_t>& matchTable,
+                          bool rawOutput, MirrorCpuImage& outFilter, MirrorCpuImage& outFinal, CpuSimdLevel level) {
+    MirrorCpuFilterPass(src, conf, matchTable, rawOutput, outFilter, level);
+    MirrorCpuFinalPass(outFilter, conf, rawOutput, outFinal, level);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_CPU_FILTER.H - CPU model of the mirror filter pipeline (tests only)
+// ============================================================================
+// Mirrors the GPU passes in src/mirror_thread.cpp so the filter and border math
+// can be validated and its per-mirror cost measured without a GL context:
+//   Pass 1: mt_filter_frag_shader / mt_filter_passthrough_frag_shader /
+//           mt_passthrough_frag_shader (raw output), additive over input regions
+//   Pass 2: mt_render_frag_shader / mt_render_passthrough_frag_shader (dynamic
+//           border), or the plain background blit for raw/static-border mirrors
+//
+// All images are top-down, tightly packed RGBA8. Kernels are vectorized (SSE2 and
+// AVX2) and selected at runtime via cpu_features.h; every level produces
+// byte-identical output.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cpu_features.h"
+#include "threaded_mirror_config.h"
+
+struct MirrorCpuImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba; // width * height * 4 bytes, top-down
+
+    // Resize and clear to transparent black (matches glClear(0,0,0,0))
+    void Reset(int w, int h);
+    uint8_t* Row(int y) { return rgba.data() + static_cast<size_t>(y) * width * 4; }
+    const uint8_t* Row(int y) const { return rgba.data() + static_cast<size_t>(y) * width * 4; }
+};
+
+// Read-only view of a game frame (top-down RGBA8). stride is in bytes.
+struct MirrorCpuSource {
+    const uint8_t* rgba = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+};
+
+// Pass 1: capture every input region of conf into the padded filter image (fbo_w x fbo_h).
+// matchTable is the color-match bitset from BuildMirrorColorMatchTable (ignored for raw output).
+void MirrorCpuFilterPass(const MirrorCpuSource& src, const ThreadedMirrorConfig& conf, const std::vector<uint32_t>& matchTable,
+                         bool rawOutput, MirrorCpuImage& outFilter, CpuSimdLevel level = GetCpuSimdLevel());
+
+// Pass 2: produce the screen-ready final image (fbo size * output scale) from the filter image.
+void MirrorCpuFinalPass(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, bool rawOutput, MirrorCpuImage& outFinal,
+                        CpuSimdLevel level = GetCpuSimdLevel());
+
+// Pass 2 for dynamic borders using the original brute-force (2w+1)^2 window test per pixel.
+// Slow; kept as the reference the separable border passes are validated against.
+void MirrorCpuFinalPassReference(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, MirrorCpuImage& outFinal);
+
+// Both passes back to back (what the mirror thread does for one mirror per captured frame).
+void RunMirrorCpuPipeline(const MirrorCpuSource& src, const ThreadedMirrorConfig& conf, const std::vector<uint32_t>& matchTable,
+                          bool rawOutput, MirrorCpuImage& outFilter, MirrorCpuImage& outFinal, CpuSimdLevel level = GetCpuSimdLevel());
@@ -0,0 +1,75 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_TEST_FRAMES.H - Synthetic game frames and mirror configs for tests
+// ============================================================================
+// Frames are noise with solid blocks of a few "interesting" colors (pie chart
+// slices, entity counter digits), so color matching hits clusters of pixels
+// the way it does on real frames. Everything is deterministic per seed.
+// ============================================================================
+
+#include <cstdint>
+#include <vector>
+
+#include "threaded_mirror_config.h"
+
+// Colors painted into synthetic frames; the configs below match against them
+const Color kTestTargetColors[] = { { 0.894f, 0.275f, 0.769f }, { 0.275f, 0.8f, 0.424f }, { 1.0f, 1.0f, 1.0f } };
+
+inline uint32_t TestRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+inline uint8_t TestColorByte(float c) { return static_cast<uint8_t>(c * 255.0f + 0.5f); }
+
+// Top-down RGBA8 frame with noise plus blocks of the target colors. Alpha is random (the filter ignores it).
+inline std::vector<uint8_t> MakeTestFrame(int width, int height, uint32_t seed) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t state = seed;
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        const uint32_t v = TestRandom(state);
+        rgba[i + 0] = static_cast<uint8_t>(v);
+        rgba[i + 1] = static_cast<uint8_t>(v >> 8);
+        rgba[i + 2] = static_cast<uint8_t>(v >> 16);
+        rgba[i + 3] = static_cast<uint8_t>(TestRandom(state));
+    }
+
+    const int blocks = (width * height) / 512 + 1;
+    for (int b = 0; b < blocks; b++) {
+        const Color& c = kTestTargetColors[TestRandom(state) % 3];
+        const int bw = 1 + static_cast<int>(TestRandom(state) % 12);
+        const int bh = 1 + static_cast<int>(TestRandom(state) % 12);
+        const int bx = static_cast<int>(TestRandom(state) % static_cast<uint32_t>(width));
+        const int by = static_cast<int>(TestRandom(state) % static_cast<uint32_t>(height));
+        for (int y = by; y < by + bh && y < height; y++) {
+            for (int x = bx; x < bx + bw && x < width; x++) {
+                uint8_t* p = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+                p[0] = TestColorByte(c.r);
+                p[1] = TestColorByte(c.g);
+                p[2] = TestColorByte(c.b);
+            }
+        }
+    }
+    return rgba;
+}
+
+// Pie-chart style mirror: two target colors, dynamic border, one input region anchored bottom-right
+inline ThreadedMirrorConfig MakeTestMirrorConfig(int captureW, int captureH, int borderWidth) {
+    ThreadedMirrorConfig conf;
+    conf.name = "test";
+    conf.captureWidth = captureW;
+    conf.captureHeight = captureH;
+    conf.borderType = MirrorBorderType::Dynamic;
+    conf.dynamicBorderThickness = borderWidth;
+    conf.targetColors = { kTestTargetColors[0], kTestTargetColors[1] };
+    conf.outputColor = { 1.0f, 0.5f, 0.0f, 1.0f };
+    conf.borderColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    conf.colorSensitivity = 0.01f;
+    MirrorCaptureConfig input;
+    input.x = 40;
+    input.y = 30;
+    input.relativeTo = "bottomRightScreen";
+    conf.input = { input };
+    return conf;
+}
@@ -0,0 +1,49 @@
+// ============================================================================
+// STUBS.CPP - Stand-ins for DLL functions the portable modules call
+// ============================================================================
+// Linked into toolscreen_portable. The real definitions live in translation
+// units that need the GUI, OpenGL or the Win32 window (gui.cpp, ...).
+// ============================================================================
+
+#include "diagnostics_file.h"
+#include "key_names.h"
+#include "log_record.h"
+#include "stubs.h"
+
+#include <cstdio>
+
+// Stable names are all the hotkey table needs (binding ids, debounce carry-over)
+std::string VkToString(DWORD vk) {
+    if (vk == 0) return "[None]";
+    if ((vk >= 'A' && vk <= 'Z') || (vk >= '0' && vk <= '9')) return std::string(1, static_cast<char>(vk));
+    char name[16];
+    std::snprintf(name, sizeof(name), "0x%X", static_cast<unsigned>(vk));
+    return name;
+}
+
+// Tests and benchmarks check results directly; log lines are dropped
+void Log(const std::string&) {}
+void Log(const std::wstring&) {}
+
+void (*g_logRecordSink)(const LogRecord& record) = nullptr;
+
+void SubmitLogRecord(const LogRecord& record) {
+    if (g_logRecordSink) {
+        g_logRecordSink(record);
+    } else {
+        delete record.overflowText;
+    }
+}
+
+// No toolscreen directory here: diagnostics dumps report failure
+bool WriteDiagnosticsFile(const char* prefix, const char* extension, const std::string&, std::filesystem::path& pathOut) {
+    pathOut = std::filesystem::path("traces") / (std::string(prefix) + extension);
+    return false;
+}
+
+bool WriteToolscreenFile(const wchar_t*, const std::string&) { return false; }
+
+std::shared_ptr<const Config> g_stubConfigSnapshot;
+std::atomic<uint64_t> g_configSnapshotVersion{ 0 };
+
+std::shared_ptr<const Config> GetConfigSnapshot() { return g_stubConfigSnapshot; }
@@ -0,0 +1,21 @@
+#pragma once
+
+// ============================================================================
+// STUBS.H - Hooks into the stand-ins in stubs.cpp
+// ============================================================================
+
+#include "log_record.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+struct Config;
+
+// Receives every record SubmitLogRecord() is handed while set, and then owns its overflowText.
+// Unset, records are dropped (and their overflowText freed), as a full log ring would.
+extern void (*g_logRecordSink)(const LogRecord& record);
+
+// What GetConfigSnapshot() returns. Tests publish by setting it and bumping g_configSnapshotVersion.
+extern std::shared_ptr<const Config> g_stubConfigSnapshot;
+extern std::atomic<uint64_t> g_configSnapshotVersion;
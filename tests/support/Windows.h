@@ -0,0 +1,37 @@
+#pragma once
+
+// ============================================================================
+// WINDOWS.H (tests/support) - Win32 subset for building tests off Windows
+// ============================================================================
+// Only on the include path of non-Windows test builds. Declares just what the
+// portable modules under test use: the DWORD key type, virtual-key codes and
+// key-state queries. Key-state queries report every key as up.
+// ============================================================================
+
+#include <cstdint>
+
+using DWORD = uint32_t;
+using BOOL = int;
+
+constexpr DWORD VK_LBUTTON = 0x01;
+constexpr DWORD VK_RBUTTON = 0x02;
+constexpr DWORD VK_MBUTTON = 0x04;
+constexpr DWORD VK_XBUTTON1 = 0x05;
+constexpr DWORD VK_XBUTTON2 = 0x06;
+constexpr DWORD VK_SHIFT = 0x10;
+constexpr DWORD VK_CONTROL = 0x11;
+constexpr DWORD VK_MENU = 0x12;
+constexpr DWORD VK_ESCAPE = 0x1B;
+constexpr DWORD VK_SPACE = 0x20;
+constexpr DWORD VK_F1 = 0x70;
+constexpr DWORD VK_LSHIFT = 0xA0;
+constexpr DWORD VK_RSHIFT = 0xA1;
+constexpr DWORD VK_LCONTROL = 0xA2;
+constexpr DWORD VK_RCONTROL = 0xA3;
+constexpr DWORD VK_LMENU = 0xA4;
+constexpr DWORD VK_RMENU = 0xA5;
+
+constexpr int SM_SWAPBUTTON = 23;
+
+inline short GetAsyncKeyState(int) { return 0; }
+inline int GetSystemMetrics(int) { return 0; }
@@ -0,0 +1,228 @@
+// ============================================================================
+// TEST_CAPTURE_SCHEDULER.CPP - Deterministic simulations of the capture scheduler
+// ============================================================================
+// A simulated microsecond clock drives the scheduler tick by tick, the way the
+// mirror thread does once per game frame. No real time passes.
+// ============================================================================
+
+#include "capture_scheduler.h"
+
+#include "test_util.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+struct SimClock {
+    int64_t now = 10000000; // Arbitrary non-zero epoch offset
+    CaptureScheduler::ClockFn Fn() {
+        return [this] { return now; };
+    }
+};
+
+// Runs `ticks` ticks of tickUs each, capturing everything due. Returns per-element capture counts.
+std::vector<uint64_t> RunTicks(CaptureScheduler& scheduler, SimClock& clock, int ticks, int64_t tickUs) {
+    std::vector<uint64_t> captures(scheduler.Size(), 0);
+    for (int t = 0; t < ticks; t++) {
+        scheduler.CollectDue();
+        for (size_t index : scheduler.DueIndices()) {
+            scheduler.MarkCaptured(index);
+            captures[index]++;
+        }
+        clock.now += tickUs;
+    }
+    return captures;
+}
+
+} // namespace
+
+TEST_CASE(NewElementsCaptureOnFirstTick) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "a", 30 }, { "b", 7 } });
+    CHECK_EQ(scheduler.CollectDue(), static_cast<size_t>(2));
+    CHECK(scheduler.IsDue(0) && scheduler.IsDue(1));
+}
+
+TEST_CASE(UncappedElementsAreDueEveryTick) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "uncapped", 0 } });
+    const std::vector<uint64_t> captures = RunTicks(scheduler, clock, 100, 16667);
+    CHECK_EQ(captures[0], static_cast<uint64_t>(100));
+}
+
+// 30 and 20 fps on a 60 fps game share every 100 ms grid point: the pair captures on 4 of every 6 ticks
+// (30 fps on 3, 20 fps on 2, one of them together) instead of up to 5 with unrelated phases
+TEST_CASE(RelatedRatesAreBatched) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "thirty", 30 }, { "twenty", 20 } });
+    RunTicks(scheduler, clock, 10, 16667);
+
+    int captureTicks = 0, sharedTicks = 0;
+    for (int t = 0; t < 600; t++) {
+        scheduler.CollectDue();
+        if (!scheduler.DueIndices().empty()) captureTicks++;
+        if (scheduler.IsDue(0) && scheduler.IsDue(1)) sharedTicks++;
+        for (size_t index : scheduler.DueIndices()) scheduler.MarkCaptured(index);
+        clock.now += 16667;
+    }
+    CHECK(captureTicks >= 399 && captureTicks <= 401);
+    CHECK(sharedTicks >= 99 && sharedTicks <= 101);
+}
+
+// Grid points are exact, so the shared points survive a clock far from its epoch (days of uptime)
+TEST_CASE(RelatedRatesShareGridFarFromEpoch) {
+    SimClock clock;
+    clock.now = 400000LL * 1000000 + 123; // ~4.6 days
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "thirty", 30 }, { "twenty", 20 } });
+    RunTicks(scheduler, clock, 10, 16667);
+    int sharedTicks = 0;
+    for (int t = 0; t < 600; t++) {
+        scheduler.CollectDue();
+        if (scheduler.IsDue(0) && scheduler.IsDue(1)) sharedTicks++;
+        for (size_t index : scheduler.DueIndices()) scheduler.MarkCaptured(index);
+        clock.now += 16667;
+    }
+    CHECK(sharedTicks >= 99 && sharedTicks <= 101);
+}
+
+// Long-run rate is exact, and jitter stays within one tick for any combination of tick rate and target rate
+TEST_CASE(RateIsExactAndJitterWithinOneTick) {
+    for (int64_t tickUs : { 16667LL, 6944LL, 4167LL, 33333LL }) {
+        for (int fps : { 7, 15, 20, 24, 30, 45, 60 }) {
+            if (1000000 / fps < tickUs) continue; // Faster than the game: capped at the tick rate
+            SimClock clock;
+            CaptureScheduler scheduler(clock.Fn());
+            scheduler.SetRates({ { "m", fps } });
+            RunTicks(scheduler, clock, 20000, tickUs);
+
+            CaptureScheduleStats stats;
+            CHECK(scheduler.GetStats(0, stats));
+            const double periodMs = 1000.0 / fps;
+            if (std::fabs(stats.meanIntervalMs - periodMs) > periodMs * 0.002 || stats.maxJitterMs > tickUs / 1000.0 + 0.01) {
+                std::printf("         tick %lld us, %d fps: mean %.3f ms, max jitter %.3f ms\n", static_cast<long long>(tickUs), fps,
+                            stats.meanIntervalMs, stats.maxJitterMs);
+            }
+            CHECK(std::fabs(stats.meanIntervalMs - periodMs) <= periodMs * 0.002);
+            CHECK(stats.maxJitterMs <= tickUs / 1000.0 + 0.01);
+        }
+    }
+}
+
+// Irregular frame times (every other game frame dropped at random) still converge on the target rate
+TEST_CASE(IrregularTicksKeepTargetRate) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "seven", 7 }, { "twenty", 20 } });
+    uint32_t state = 7;
+    for (int t = 0; t < 50000; t++) {
+        scheduler.CollectDue();
+        for (size_t index : scheduler.DueIndices()) scheduler.MarkCaptured(index);
+        state = state * 1664525u + 1013904223u;
+        clock.now += 16667 * (1 + (state >> 8) % 2);
+    }
+    CaptureScheduleStats seven, twenty;
+    scheduler.GetStats(0, seven);
+    scheduler.GetStats(1, twenty);
+    CHECK(std::fabs(seven.meanIntervalMs - 1000.0 / 7) < 0.5);
+    CHECK(std::fabs(twenty.meanIntervalMs - 50.0) < 0.5);
+    CHECK(seven.maxJitterMs <= 33.34); // The longest gap between ticks
+}
+
+// After a stall the element captures once and resumes on the grid instead of catching up in a burst
+TEST_CASE(StallDoesNotBurst) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "m", 30 } });
+    RunTicks(scheduler, clock, 30, 16667);
+    clock.now += 1000000;
+    const std::vector<uint64_t> captures = RunTicks(scheduler, clock, 6, 16667);
+    CHECK_EQ(captures[0], static_cast<uint64_t>(3)); // 100 ms at 30 fps, not 1 s worth
+}
+
+// An immediate capture doesn't move the element off its grid
+TEST_CASE(ImmediateKeepsPendingDeadline) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "m", 10 } });
+    RunTicks(scheduler, clock, 1, 1000);
+    const int64_t untilDeadline = scheduler.MicrosUntilNextDeadline();
+    CHECK(untilDeadline > 0 && untilDeadline <= 100000);
+
+    clock.now += 20000;
+    scheduler.RequestImmediate(0);
+    CHECK_EQ(scheduler.CollectDue(), static_cast<size_t>(1));
+    scheduler.MarkCaptured(0);
+    CHECK_EQ(scheduler.MicrosUntilNextDeadline(), untilDeadline - 20000);
+}
+
+TEST_CASE(MicrosUntilNextDeadline) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    CHECK_EQ(scheduler.MicrosUntilNextDeadline(), static_cast<int64_t>(-1));
+    scheduler.SetRates({ { "m", 20 } });
+    CHECK_EQ(scheduler.MicrosUntilNextDeadline(), static_cast<int64_t>(0));
+    scheduler.CollectDue();
+    scheduler.MarkCaptured(0);
+    const int64_t wait = scheduler.MicrosUntilNextDeadline();
+    CHECK(wait > 0 && wait <= 50000);
+}
+
+// Reordering keeps each element's deadline and statistics; a changed rate restarts them
+TEST_CASE(SetRatesFollowsKeysAcrossIndices) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    scheduler.SetRates({ { "a", 30 }, { "b", 20 } });
+    RunTicks(scheduler, clock, 60, 16667);
+    CaptureScheduleStats before;
+    scheduler.GetStats(0, before);
+
+    scheduler.SetRates({ { "c", 10 }, { "b", 20 }, { "a", 30 } });
+    CHECK_EQ(scheduler.Size(), static_cast<size_t>(3));
+    CaptureScheduleStats moved;
+    scheduler.GetStats(2, moved);
+    CHECK_EQ(moved.captures, before.captures);
+    CHECK_EQ(moved.targetFps, 30);
+
+    scheduler.SetRates({ { "b", 15 } });
+    CaptureScheduleStats retuned;
+    scheduler.GetStats(0, retuned);
+    CHECK_EQ(retuned.captures, static_cast<uint64_t>(0));
+    CHECK_EQ(retuned.targetFps, 15);
+    const auto all = scheduler.GetAllStats();
+    CHECK_EQ(all.size(), static_cast<size_t>(1));
+    CHECK_EQ(all[0].first, std::string("b"));
+}
+
+// Re-applying the same rates every pass (the window overlay thread does) is a no-op that keeps due state
+TEST_CASE(SameRatesKeepDueState) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    const std::vector<std::pair<std::string, int>> rates = { { "a", 30 }, { "b", 5 } };
+    scheduler.SetRates(rates);
+    scheduler.CollectDue();
+    scheduler.SetRates(rates);
+    CHECK(scheduler.IsDue(0) && scheduler.IsDue(1));
+    CHECK_EQ(scheduler.DueIndices().size(), static_cast<size_t>(2));
+}
+
+// Once warmed up, ticks reuse the due list's storage
+TEST_CASE(TicksDoNotReallocate) {
+    SimClock clock;
+    CaptureScheduler scheduler(clock.Fn());
+    std::vector<std::pair<std::string, int>> rates;
+    for (int i = 0; i < 32; i++) rates.emplace_back("mirror" + std::to_string(i), (i % 6) * 10);
+    scheduler.SetRates(rates);
+    RunTicks(scheduler, clock, 200, 16667);
+
+    const size_t* data = scheduler.DueIndices().data();
+    const size_t capacity = scheduler.DueIndices().capacity();
+    RunTicks(scheduler, clock, 2000, 16667);
+    CHECK(scheduler.DueIndices().data() == data);
+    CHECK_EQ(scheduler.DueIndices().capacity(), capacity);
+}
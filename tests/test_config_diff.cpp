@@ -0,0 +1,251 @@
+// ============================================================================
+// TEST_CONFIG_DIFF.CPP - Change sets between published config snapshots
+// ============================================================================
+// Snapshots are built like PublishConfigSnapshot() builds them (sections,
+// mode and element indexes), so lookups and node sharing match the DLL.
+// ============================================================================
+
+#include "config_diff.h"
+#include "config_lookup.h"
+#include "config_publish.h"
+#include "config_test_data.h"
+#include "config_types.h"
+#include "stubs.h"
+
+#include "test_util.h"
+
+#include <memory>
+
+namespace {
+
+std::shared_ptr<const Config> Publish(const Config& draft, const Config* previous) {
+    auto snapshot = std::make_shared<Config>();
+    PublishConfigSections(draft, previous, *snapshot);
+    BuildModeHandleIndex(*snapshot);
+    BuildElementIndexes(*snapshot, previous);
+    return snapshot;
+}
+
+// Diff of one draft edit against the snapshot before it
+template <typename Edit> ConfigChangeSet DiffEdit(Config& draft, Edit&& edit) {
+    const auto before = Publish(draft, nullptr);
+    edit(draft);
+    const auto after = Publish(draft, before.get());
+    return DiffConfigs(*before, *after);
+}
+
+bool IsOnly(const std::vector<ConfigElementChange>& changes, ConfigChangeKind kind, const std::string& name, uint32_t fields) {
+    return changes.size() == 1 && changes[0].kind == kind && changes[0].name == name && changes[0].fields == fields;
+}
+
+size_t TotalChanges(const ConfigChangeSet& changes) {
+    return changes.mirrors.size() + changes.mirrorGroups.size() + changes.images.size() + changes.windowOverlays.size() +
+           changes.modes.size();
+}
+
+} // namespace
+
+TEST_CASE(UnchangedRepublishIsEmpty) {
+    Config draft = MakeLargeTestConfig(100);
+    const auto first = Publish(draft, nullptr);
+    const auto second = Publish(draft, first.get());
+    CHECK(DiffConfigs(*first, *second).Empty());
+    CHECK(DiffConfigs(*first, *first).Empty());
+}
+
+TEST_CASE(AddedAndRemovedElements) {
+    Config draft = MakeLargeTestConfig(100);
+    ConfigChangeSet changes = DiffEdit(draft, [](Config& c) {
+        MirrorConfig mirror;
+        mirror.name = "new_mirror";
+        c.mirrors.push_back(mirror);
+    });
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Added, "new_mirror", CONFIG_CHANGE_ALL));
+    CHECK_EQ(TotalChanges(changes), static_cast<size_t>(1));
+    CHECK(!changes.hotkeysChanged);
+
+    changes = DiffEdit(draft, [](Config& c) { c.images.erase(c.images.begin() + 2); });
+    CHECK(IsOnly(changes.images, ConfigChangeKind::Removed, "image_2", CONFIG_CHANGE_ALL));
+    CHECK_EQ(TotalChanges(changes), static_cast<size_t>(1));
+}
+
+// Removing an element shifts the rest: moved but equal elements are not changes
+TEST_CASE(MovedElementsAreUnchanged) {
+    Config draft = MakeLargeTestConfig(100);
+    const ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.mirrors.erase(c.mirrors.begin()); });
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Removed, "mirror_0", CONFIG_CHANGE_ALL));
+}
+
+TEST_CASE(RenameIsRemovalPlusAddition) {
+    Config draft = MakeLargeTestConfig(100);
+    const ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.windowOverlays[1].name = "renamed"; });
+    CHECK_EQ(changes.windowOverlays.size(), static_cast<size_t>(2));
+    const ConfigElementChange* added = ConfigChangeSet::Find(changes.windowOverlays, "renamed");
+    const ConfigElementChange* removed = ConfigChangeSet::Find(changes.windowOverlays, "overlay_1");
+    CHECK(added && added->kind == ConfigChangeKind::Added && added->fields == CONFIG_CHANGE_ALL);
+    CHECK(removed && removed->kind == ConfigChangeKind::Removed && removed->fields == CONFIG_CHANGE_ALL);
+    CHECK(ConfigChangeSet::Find(changes.mirrors, "renamed") == nullptr);
+}
+
+// Only the first element with a name is reachable; edits to shadowed duplicates change nothing
+TEST_CASE(DuplicateNamesFollowTheFirstElement) {
+    Config draft = MakeLargeTestConfig(100);
+    MirrorConfig duplicate = draft.mirrors[0];
+    duplicate.fps = 5;
+    draft.mirrors.push_back(duplicate);
+
+    ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.mirrors.back().fps = 7; });
+    CHECK(changes.mirrors.empty());
+
+    changes = DiffEdit(draft, [](Config& c) { c.mirrors[0].fps = 10; });
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Modified, "mirror_0", MIRROR_CHANGE_RATE));
+
+    // Removing the duplicate removes nothing reachable
+    Config withoutDuplicate = draft;
+    changes = DiffEdit(withoutDuplicate, [](Config& c) { c.mirrors.erase(c.mirrors.end() - 1); });
+    CHECK(changes.mirrors.empty());
+
+    // Removing the first exposes the duplicate: the name now resolves to an element with other settings
+    changes = DiffEdit(draft, [](Config& c) { c.mirrors.erase(c.mirrors.begin()); });
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Modified, "mirror_0", MIRROR_CHANGE_RATE));
+}
+
+// Untouched sections are skipped by storage identity, untouched elements by node identity
+TEST_CASE(SharedNodesAreSkipped) {
+    Config draft = MakeLargeTestConfig(500);
+    const auto before = Publish(draft, nullptr);
+    draft.mirrors[17].opacity = 0.5f;
+    const auto after = Publish(draft, before.get());
+    CHECK(before->images.SharesStorageWith(after->images));
+    CHECK(!before->mirrors.SharesStorageWith(after->mirrors));
+    CHECK_EQ(before->mirrors.NodeIdentity(16), after->mirrors.NodeIdentity(16));
+
+    const ConfigChangeSet changes = DiffConfigs(*before, *after);
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Modified, "mirror_17", MIRROR_CHANGE_APPEARANCE));
+    CHECK_EQ(TotalChanges(changes), static_cast<size_t>(1));
+    CHECK(!changes.hotkeysChanged);
+}
+
+TEST_CASE(MirrorFieldBits) {
+    Config draft = MakeLargeTestConfig(100);
+    auto bits = [&](auto&& edit) {
+        const ConfigChangeSet changes = DiffEdit(draft, [&](Config& c) { edit(c.mirrors[3]); });
+        return changes.mirrors.size() == 1 && changes.mirrors[0].kind == ConfigChangeKind::Modified ? changes.mirrors[0].fields : 0u;
+    };
+    CHECK_EQ(bits([](MirrorConfig& m) { m.captureWidth += 1; }), static_cast<uint32_t>(MIRROR_CHANGE_CAPTURE));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.input[0].y += 1; }), static_cast<uint32_t>(MIRROR_CHANGE_CAPTURE));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.colorSensitivity *= 2.0f; }), static_cast<uint32_t>(MIRROR_CHANGE_FILTER));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.colorPassthrough = !m.colorPassthrough; }), static_cast<uint32_t>(MIRROR_CHANGE_FILTER));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.output.x += 1; }), static_cast<uint32_t>(MIRROR_CHANGE_OUTPUT));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.contentStats = !m.contentStats; }), static_cast<uint32_t>(MIRROR_CHANGE_RATE));
+    CHECK_EQ(bits([](MirrorConfig& m) { m.onlyOnMyScreen = !m.onlyOnMyScreen; }), static_cast<uint32_t>(MIRROR_CHANGE_APPEARANCE));
+    CHECK_EQ(bits([](MirrorConfig& m) {
+                 m.fps += 1;
+                 m.output.x += 1;
+             }),
+             static_cast<uint32_t>(MIRROR_CHANGE_RATE | MIRROR_CHANGE_OUTPUT));
+}
+
+TEST_CASE(ImageAndOverlayFieldBits) {
+    Config draft = MakeLargeTestConfig(100);
+    ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.images[0].path += ".bak"; });
+    CHECK(IsOnly(changes.images, ConfigChangeKind::Modified, "image_0", IMAGE_CHANGE_SOURCE));
+    changes = DiffEdit(draft, [](Config& c) {
+        c.images[1].crop_left = 4;
+        c.images[1].opacity = 0.25f;
+    });
+    CHECK(IsOnly(changes.images, ConfigChangeKind::Modified, "image_1", IMAGE_CHANGE_LAYOUT | IMAGE_CHANGE_APPEARANCE));
+
+    changes = DiffEdit(draft, [](Config& c) { c.windowOverlays[0].windowTitle = "Other"; });
+    CHECK(IsOnly(changes.windowOverlays, ConfigChangeKind::Modified, "overlay_0", WINDOW_OVERLAY_CHANGE_TARGET));
+    changes = DiffEdit(draft, [](Config& c) { c.windowOverlays[0].fps += 1; });
+    CHECK(IsOnly(changes.windowOverlays, ConfigChangeKind::Modified, "overlay_0", WINDOW_OVERLAY_CHANGE_CAPTURE));
+
+    changes = DiffEdit(draft, [](Config& c) { c.mirrorGroups[0].mirrors.pop_back(); });
+    CHECK(IsOnly(changes.mirrorGroups, ConfigChangeKind::Modified, "group_0", MIRROR_GROUP_CHANGE_ITEMS));
+}
+
+TEST_CASE(ModeFieldBits) {
+    Config draft = MakeLargeTestConfig(100);
+    auto bits = [&](auto&& edit) {
+        const ConfigChangeSet changes = DiffEdit(draft, [&](Config& c) { edit(c.modes[2]); });
+        return changes.modes.size() == 1 && changes.modes[0].kind == ConfigChangeKind::Modified ? changes.modes[0].fields : 0u;
+    };
+    CHECK_EQ(bits([](ModeConfig& m) { m.width += 1; }), static_cast<uint32_t>(MODE_CHANGE_SIZE));
+    CHECK_EQ(bits([](ModeConfig& m) { m.background.image = "bg.png"; }),
+             static_cast<uint32_t>(MODE_CHANGE_BACKGROUND_SOURCE | MODE_CHANGE_BACKGROUND));
+    CHECK_EQ(bits([](ModeConfig& m) { m.background.gradientAngle = 45.0f; }), static_cast<uint32_t>(MODE_CHANGE_BACKGROUND));
+    CHECK_EQ(bits([](ModeConfig& m) { m.imageIds.clear(); }), static_cast<uint32_t>(MODE_CHANGE_ELEMENTS));
+    CHECK_EQ(bits([](ModeConfig& m) { m.transitionDurationMs += 100; }), static_cast<uint32_t>(MODE_CHANGE_OTHER));
+    CHECK_EQ(bits([](ModeConfig& m) { m.modeSensitivity = 0.5f; }), static_cast<uint32_t>(MODE_CHANGE_OTHER));
+    CHECK_EQ(bits([](ModeConfig& m) { m.slideMirrorsIn = !m.slideMirrorsIn; }), static_cast<uint32_t>(MODE_CHANGE_OTHER));
+    // OTHER is reported alongside the other bits, not only when nothing else changed
+    CHECK_EQ(bits([](ModeConfig& m) {
+                 m.height += 1;
+                 m.bounceCount = 2;
+             }),
+             static_cast<uint32_t>(MODE_CHANGE_SIZE | MODE_CHANGE_OTHER));
+    CHECK_EQ(bits([](ModeConfig& m) {
+                 m.mirrorIds.pop_back();
+                 m.border.width += 1;
+             }),
+             static_cast<uint32_t>(MODE_CHANGE_ELEMENTS | MODE_CHANGE_OTHER));
+}
+
+// Modes match case-insensitively: a respelled id is the same mode, modified in no named field group
+TEST_CASE(ModesMatchIgnoringCase) {
+    Config draft = MakeLargeTestConfig(100);
+    const ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.modes[1].id = "MODE_1"; });
+    CHECK(IsOnly(changes.modes, ConfigChangeKind::Modified, "MODE_1", CONFIG_CHANGE_ALL));
+}
+
+TEST_CASE(HotkeyEditsFlagTheTable) {
+    Config draft = MakeLargeTestConfig(100);
+    ConfigChangeSet changes = DiffEdit(draft, [](Config& c) { c.hotkeys[0].keys.push_back('Z'); });
+    CHECK(changes.hotkeysChanged);
+    CHECK_EQ(TotalChanges(changes), static_cast<size_t>(0));
+    CHECK(!changes.Empty());
+
+    changes = DiffEdit(draft, [](Config& c) { c.sensitivityHotkeys.push_back(SensitivityHotkeyConfig{}); });
+    CHECK(changes.hotkeysChanged);
+}
+
+// Each tracker diffs against the snapshot it last consumed, across skipped publishes
+TEST_CASE(TrackerSeesEveryChangeSinceItsLastPoll) {
+    Config draft = MakeLargeTestConfig(100);
+    auto publish = [&] {
+        g_stubConfigSnapshot = Publish(draft, g_stubConfigSnapshot.get());
+        g_configSnapshotVersion.fetch_add(1);
+    };
+    publish();
+
+    ConfigChangeTracker fast, slow;
+    std::shared_ptr<const Config> current;
+    ConfigChangeSet changes;
+    CHECK(!fast.Poll(current, changes)); // Baseline only
+    CHECK(!slow.Poll(current, changes));
+    CHECK(!fast.Poll(current, changes)); // Nothing new
+
+    draft.mirrors[0].fps = 1;
+    publish();
+    CHECK(fast.Poll(current, changes));
+    CHECK(current == g_stubConfigSnapshot);
+    CHECK(IsOnly(changes.mirrors, ConfigChangeKind::Modified, "mirror_0", MIRROR_CHANGE_RATE));
+
+    draft.images[0].opacity = 0.5f;
+    publish();
+    CHECK(fast.Poll(current, changes));
+    CHECK(changes.mirrors.empty());
+    CHECK(IsOnly(changes.images, ConfigChangeKind::Modified, "image_0", IMAGE_CHANGE_APPEARANCE));
+
+    // The slow tracker skipped a publish and gets both edits at once
+    CHECK(slow.Poll(current, changes));
+    CHECK_EQ(changes.mirrors.size(), static_cast<size_t>(1));
+    CHECK_EQ(changes.images.size(), static_cast<size_t>(1));
+
+    // A version bump without a new snapshot is consumed silently
+    g_configSnapshotVersion.fetch_add(1);
+    CHECK(!fast.Poll(current, changes));
+
+    g_stubConfigSnapshot.reset();
+}
@@ -0,0 +1,109 @@
+// ============================================================================
+// TEST_CONFIG_PUBLISH.CPP - Structural sharing between published snapshots
+// ============================================================================
+
+#include "config_publish.h"
+#include "config_test_data.h"
+#include "element_id.h"
+#include "mode_id.h"
+
+#include "test_util.h"
+
+namespace {
+
+bool AllSectionsShared(const Config& a, const Config& b) {
+    return a.mirrors.SharesStorageWith(b.mirrors) && a.mirrorGroups.SharesStorageWith(b.mirrorGroups) &&
+           a.images.SharesStorageWith(b.images) && a.windowOverlays.SharesStorageWith(b.windowOverlays) &&
+           a.modes.SharesStorageWith(b.modes) && a.hotkeys.SharesStorageWith(b.hotkeys) &&
+           a.sensitivityHotkeys.SharesStorageWith(b.sensitivityHotkeys);
+}
+
+} // namespace
+
+TEST_CASE(FirstPublishCopiesAndInternsModes) {
+    const Config draft = MakeLargeTestConfig(100);
+    Config snapshot;
+    PublishConfigSections(draft, nullptr, snapshot);
+
+    CHECK_EQ(snapshot.mirrors.size(), draft.mirrors.size());
+    CHECK(!snapshot.mirrors.SharesStorageWith(draft.mirrors));
+    CHECK(snapshot.mirrors[3] == draft.mirrors[3]);
+    CHECK_EQ(snapshot.guiHotkey.size(), draft.guiHotkey.size());
+    for (const ModeConfig& mode : snapshot.modes) {
+        CHECK(mode.handle != NO_MODE_HANDLE);
+        CHECK_EQ(ModeIdName(mode.handle), mode.id);
+    }
+}
+
+// Every element and every reference to one carries the handle of its name
+TEST_CASE(FirstPublishInternsElementReferences) {
+    const Config draft = MakeLargeTestConfig(100);
+    Config snapshot;
+    PublishConfigSections(draft, nullptr, snapshot);
+
+    for (const MirrorConfig& mirror : snapshot.mirrors) CHECK_EQ(ElementName(mirror.handle), mirror.name);
+    for (const ImageConfig& image : snapshot.images) CHECK_EQ(ElementName(image.handle), image.name);
+    for (const WindowOverlayConfig& overlay : snapshot.windowOverlays) CHECK_EQ(ElementName(overlay.handle), overlay.name);
+    for (const MirrorGroupConfig& group : snapshot.mirrorGroups) {
+        CHECK_EQ(ElementName(group.handle), group.name);
+        CHECK(!group.mirrors.empty());
+        for (const MirrorGroupItem& item : group.mirrors) CHECK_EQ(item.mirrorHandle, InternElementName(item.mirrorId));
+    }
+    for (size_t i = 0; i < snapshot.modes.size(); i++) {
+        const ModeConfig& mode = snapshot.modes[i];
+        CHECK_EQ(mode.mirrorHandles.size(), mode.mirrorIds.size());
+        CHECK_EQ(mode.windowOverlayHandles.size(), mode.windowOverlayIds.size());
+        CHECK_EQ(mode.mirrorHandles[1], snapshot.mirrors[(i + 1) % snapshot.mirrors.size()].handle);
+        CHECK_EQ(mode.mirrorGroupHandles[0], InternElementName(mode.mirrorGroupIds[0]));
+        CHECK_EQ(mode.imageHandles[0], InternElementName(mode.imageIds[0]));
+    }
+}
+
+// Handles are process-wide and case-sensitive, and never change for a name
+TEST_CASE(ElementHandlesAreStable) {
+    const ElementHandle handle = InternElementName("Pie Chart");
+    CHECK(handle != NO_ELEMENT_HANDLE);
+    CHECK_EQ(InternElementName("Pie Chart"), handle);
+    CHECK(InternElementName("pie chart") != handle);
+    CHECK_EQ(InternElementName(""), NO_ELEMENT_HANDLE);
+    CHECK_EQ(ElementName(NO_ELEMENT_HANDLE), std::string());
+    CHECK_EQ(ElementName(0xFFFFFFFFu), std::string());
+}
+
+TEST_CASE(UnchangedPublishSharesEverySection) {
+    const Config draft = MakeLargeTestConfig(100);
+    Config first, second;
+    PublishConfigSections(draft, nullptr, first);
+    PublishConfigSections(draft, &first, second);
+    CHECK(AllSectionsShared(first, second));
+}
+
+// A spinner drag on one mirror: only that element gets a new node
+TEST_CASE(EditCopiesOnlyTheEditedElement) {
+    Config draft = MakeLargeTestConfig(100);
+    Config first, second;
+    PublishConfigSections(draft, nullptr, first);
+    draft.mirrors[5].output.x += 1;
+    PublishConfigSections(draft, &first, second);
+
+    CHECK(!second.mirrors.SharesStorageWith(first.mirrors));
+    for (size_t i = 0; i < second.mirrors.size(); i++) {
+        CHECK_EQ(second.mirrors.NodeIdentity(i) == first.mirrors.NodeIdentity(i), i != 5);
+    }
+    CHECK_EQ(second.mirrors[5].output.x, draft.mirrors[5].output.x);
+    CHECK(second.images.SharesStorageWith(first.images));
+    CHECK(second.modes.SharesStorageWith(first.modes));
+    CHECK(second.hotkeys.SharesStorageWith(first.hotkeys));
+}
+
+// Writes to the draft after publishing never show through the snapshot
+TEST_CASE(SnapshotIsIsolatedFromDraftWrites) {
+    Config draft = MakeLargeTestConfig(50);
+    Config snapshot;
+    PublishConfigSections(draft, nullptr, snapshot);
+    const std::string name = snapshot.images[0].name;
+    draft.images[0].name = "renamed";
+    draft.images.push_back(ImageConfig{});
+    CHECK_EQ(snapshot.images[0].name, name);
+    CHECK_EQ(snapshot.images.size(), draft.images.size() - 1);
+}
@@ -0,0 +1,133 @@
+// ============================================================================
+// TEST_GZIP_STREAM.CPP - GzipEncoder output round-tripped through zlib's inflate
+// ============================================================================
+// Built only when CMake finds zlib. Every stream must decode with zlib's gzip
+// decoder (which checks the CRC-32 and size trailer) to exactly the input.
+// ============================================================================
+
+#include "gzip_stream.h"
+
+#include "gzip_test_data.h"
+#include "test_util.h"
+
+#include <zlib.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Decodes one gzip member; false if zlib rejects the stream or it has trailing bytes
+bool Gunzip(const std::vector<uint8_t>& compressed, std::vector<uint8_t>& out) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) return false;
+    out.clear();
+    stream.next_in = const_cast<Bytef*>(compressed.data());
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    uint8_t buffer[65536];
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = buffer;
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.insert(out.end(), buffer, buffer + (sizeof(buffer) - stream.avail_out));
+        if (result == Z_BUF_ERROR && stream.avail_in == 0) break; // Truncated stream
+    }
+    const bool ok = result == Z_STREAM_END && stream.avail_in == 0;
+    inflateEnd(&stream);
+    return ok;
+}
+
+void CheckRoundTrip(const std::vector<uint8_t>& input, size_t chunkSize) {
+    const std::vector<uint8_t> compressed = GzipInChunks(input, chunkSize);
+    std::vector<uint8_t> decoded;
+    CHECK(Gunzip(compressed, decoded));
+    CHECK_EQ(decoded.size(), input.size());
+    CHECK(decoded == input);
+}
+
+std::vector<uint8_t> Bytes(const std::string& text) { return std::vector<uint8_t>(text.begin(), text.end()); }
+
+} // namespace
+
+TEST_CASE(EmptyAndTinyInputsRoundTrip) {
+    CheckRoundTrip({}, 1);
+    CheckRoundTrip(Bytes("a"), 1);
+    CheckRoundTrip(Bytes("abcabcabcabc"), 5);
+    CheckRoundTrip(Bytes("[12:00:00.000] Toolscreen loaded\n"), 4096);
+}
+
+TEST_CASE(GzipFraming) {
+    const std::vector<uint8_t> input = MakeTestLog(5000);
+    const std::vector<uint8_t> compressed = GzipInChunks(input, 65536);
+    CHECK(compressed.size() > 18);
+    CHECK_EQ(compressed[0], 0x1F);
+    CHECK_EQ(compressed[1], 0x8B);
+    CHECK_EQ(compressed[2], 0x08);
+
+    auto readLE32 = [&](size_t pos) {
+        return static_cast<uint32_t>(compressed[pos]) | static_cast<uint32_t>(compressed[pos + 1]) << 8 |
+               static_cast<uint32_t>(compressed[pos + 2]) << 16 | static_cast<uint32_t>(compressed[pos + 3]) << 24;
+    };
+    const uint32_t zlibCrc = static_cast<uint32_t>(crc32(0, input.data(), static_cast<uInt>(input.size())));
+    CHECK_EQ(readLE32(compressed.size() - 8), zlibCrc);
+    CHECK_EQ(readLE32(compressed.size() - 4), static_cast<uint32_t>(input.size()));
+}
+
+TEST_CASE(Crc32MatchesZlibIncrementally) {
+    const std::vector<uint8_t> input = MakeRandomBytes(10000, 7);
+    uint32_t crc = 0;
+    size_t pos = 0;
+    for (size_t step : { 0, 1, 3, 64, 999, 4096 }) {
+        crc = Crc32Update(crc, input.data() + pos, step);
+        pos += step;
+    }
+    crc = Crc32Update(crc, input.data() + pos, input.size() - pos);
+    CHECK_EQ(crc, static_cast<uint32_t>(crc32(0, input.data(), static_cast<uInt>(input.size()))));
+}
+
+TEST_CASE(LogTextRoundTripsAcrossChunkSizes) {
+    const std::vector<uint8_t> input = MakeTestLog(3 * 1024 * 1024 + 17);
+    for (size_t chunk : { static_cast<size_t>(65536), static_cast<size_t>(4093), static_cast<size_t>(100003) }) {
+        CheckRoundTrip(input, chunk);
+    }
+    // Byte-at-a-time input on a smaller log (window slides and block flushes at every offset)
+    CheckRoundTrip(MakeTestLog(200000, 3), 1);
+
+    const std::vector<uint8_t> compressed = GzipInChunks(input, 65536);
+    CHECK(compressed.size() * 4 < input.size()); // Dynamic Huffman + LZ77 on log text: well under 25%
+}
+
+TEST_CASE(IncompressibleInputUsesStoredBlocks) {
+    const std::vector<uint8_t> input = MakeRandomBytes(300000, 11);
+    CheckRoundTrip(input, 65536);
+    // Stored blocks cost 5 bytes per 64 KB, plus the 18-byte gzip header and trailer
+    const std::vector<uint8_t> compressed = GzipInChunks(input, 65536);
+    CHECK(compressed.size() <= input.size() + 18 + 5 * (input.size() / 16384 + 1));
+}
+
+TEST_CASE(LongRunsAndDistantRepeats) {
+    CheckRoundTrip(std::vector<uint8_t>(2 * 1024 * 1024, 0), 65536);
+    CHECK(GzipInChunks(std::vector<uint8_t>(2 * 1024 * 1024, 0), 65536).size() < 4096);
+
+    // Repeats at the edge of and beyond the 32 KB window
+    for (size_t period : { static_cast<size_t>(32506), static_cast<size_t>(32768), static_cast<size_t>(40000) }) {
+        const std::vector<uint8_t> block = MakeRandomBytes(period, static_cast<uint32_t>(period));
+        std::vector<uint8_t> input;
+        for (int i = 0; i < 4; i++) input.insert(input.end(), block.begin(), block.end());
+        CheckRoundTrip(input, 65536);
+    }
+}
+
+TEST_CASE(MixedContentRoundTrips) {
+    std::vector<uint8_t> input;
+    for (uint32_t seed = 1; seed <= 6; seed++) {
+        const std::vector<uint8_t> text = MakeTestLog(70000 + seed * 1111, seed);
+        const std::vector<uint8_t> noise = MakeRandomBytes(20000 + seed * 333, seed);
+        input.insert(input.end(), text.begin(), text.end());
+        input.insert(input.end(), noise.begin(), noise.end());
+        input.insert(input.end(), 3000 * seed, static_cast<uint8_t>('='));
+    }
+    CheckRoundTrip(input, 65536);
+    CheckRoundTrip(input, 777);
+}
@@ -0,0 +1,172 @@
+// ============================================================================
+// TEST_HOTKEY_TABLE.CPP - Dispatch table buckets, matching and key state
+// ============================================================================
+
+#include "config_types.h"
+#include "hotkey_table.h"
+
+#include "test_util.h"
+
+namespace {
+
+HotkeyConfig MakeHotkey(std::vector<DWORD> keys, std::vector<DWORD> exclusions = {}) {
+    HotkeyConfig hotkey;
+    hotkey.keys = std::move(keys);
+    hotkey.conditions.exclusions = std::move(exclusions);
+    return hotkey;
+}
+
+// Indices of the bindings on vk whose modifiers/exclusions hold in keys, in bucket order
+std::vector<uint32_t> MatchingBindings(const HotkeyDispatchTable& table, DWORD vk, const HotkeyKeyState& keys) {
+    std::vector<uint32_t> matched;
+    const HotkeyDispatchTable::Bucket bucket = table.Probe(vk);
+    for (uint32_t i = 0; i < bucket.count; i++) {
+        if (HotkeyDispatchTable::Matches(table.Binding(bucket.indices[i]), vk, keys)) matched.push_back(bucket.indices[i]);
+    }
+    return matched;
+}
+
+} // namespace
+
+TEST_CASE(ProbeReturnsOnlyBindingsOnTheKey) {
+    Config config;
+    config.hotkeys.push_back(MakeHotkey({ 'F' }));
+    config.hotkeys.push_back(MakeHotkey({ 'G' }));
+    config.hotkeys.push_back(MakeHotkey({ VK_SHIFT, 'F' }));
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+
+    CHECK_EQ(table->BindingCount(), static_cast<size_t>(4)); // Plus the default GUI toggle on Ctrl+E
+    CHECK_EQ(table->Probe('F').count, 2u);
+    CHECK_EQ(table->Probe('G').count, 1u);
+    CHECK_EQ(table->Probe('H').count, 0u);
+    CHECK_EQ(table->Probe('E').count, 1u);
+    CHECK_EQ(table->Probe(300).count, 0u);
+}
+
+// Buckets keep config order, and a hotkey's alt secondary modes come before its main combo
+TEST_CASE(BucketsKeepConfigOrder) {
+    Config config;
+    config.guiHotkey = {};
+    HotkeyConfig hotkey = MakeHotkey({ 'Q' });
+    hotkey.altSecondaryModes.push_back({ { VK_SHIFT, 'Q' }, "alt" });
+    config.hotkeys.push_back(hotkey);
+    config.hotkeys.push_back(MakeHotkey({ 'Q' }));
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+
+    const HotkeyDispatchTable::Bucket bucket = table->Probe('Q');
+    CHECK_EQ(bucket.count, 3u);
+    CHECK(table->Binding(bucket.indices[0]).action == HotkeyAction::ModeAlt);
+    CHECK(table->Binding(bucket.indices[1]).action == HotkeyAction::ModeMain);
+    CHECK_EQ(table->Binding(bucket.indices[2]).ownerIndex, 1u);
+}
+
+TEST_CASE(SideSpecificModifiers) {
+    Config config;
+    config.guiHotkey = {};
+    config.hotkeys.push_back(MakeHotkey({ VK_LCONTROL, 'K' }));
+    config.hotkeys.push_back(MakeHotkey({ VK_CONTROL, 'J' }));
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+
+    HotkeyKeyState keys;
+    keys.SetDown(VK_RCONTROL, true);
+    CHECK(MatchingBindings(*table, 'K', keys).empty());
+    CHECK_EQ(MatchingBindings(*table, 'J', keys).size(), static_cast<size_t>(1));
+
+    keys.SetDown(VK_RCONTROL, false);
+    keys.SetDown(VK_LCONTROL, true);
+    CHECK_EQ(MatchingBindings(*table, 'K', keys).size(), static_cast<size_t>(1));
+    CHECK_EQ(MatchingBindings(*table, 'J', keys).size(), static_cast<size_t>(1));
+}
+
+// A main key that is itself a modifier answers to both sides (generic) or to its own side only
+TEST_CASE(ModifierMainKeys) {
+    Config config;
+    config.guiHotkey = {};
+    config.hotkeys.push_back(MakeHotkey({ VK_SHIFT }));
+    config.hotkeys.push_back(MakeHotkey({ VK_RMENU }));
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+
+    CHECK_EQ(table->Probe(VK_LSHIFT).count, 1u);
+    CHECK_EQ(table->Probe(VK_RSHIFT).count, 1u);
+    CHECK_EQ(table->Probe(VK_LMENU).count, 0u);
+
+    // Side unresolved: a generic Alt message only matches RAlt while RAlt is actually down
+    HotkeyKeyState keys;
+    keys.SetDown(VK_LMENU, true);
+    CHECK(MatchingBindings(*table, VK_MENU, keys).empty());
+    keys.SetDown(VK_RMENU, true);
+    CHECK_EQ(MatchingBindings(*table, VK_MENU, keys).size(), static_cast<size_t>(1));
+}
+
+TEST_CASE(ExclusionsAndHeldKeys) {
+    Config config;
+    config.guiHotkey = {};
+    config.hotkeys.push_back(MakeHotkey({ 'W', 'R' }, { VK_SPACE }));
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+
+    HotkeyKeyState keys;
+    CHECK(MatchingBindings(*table, 'R', keys).empty()); // W not held
+    keys.SetDown('W', true);
+    CHECK_EQ(MatchingBindings(*table, 'R', keys).size(), static_cast<size_t>(1));
+    keys.SetDown(VK_SPACE, true);
+    CHECK(MatchingBindings(*table, 'R', keys).empty());
+}
+
+TEST_CASE(RebindsFollowMasterSwitch) {
+    Config config;
+    config.guiHotkey = {};
+    KeyRebind rebind;
+    rebind.fromKey = 'Z';
+    rebind.toKey = 'X';
+    config.keyRebinds.rebinds.push_back(rebind);
+    CHECK(CompileHotkeyDispatchTable(config, nullptr)->Probe('Z').count == 0u);
+
+    config.keyRebinds.enabled = true;
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+    const CompiledHotkeyBinding* found = table->FindRebind(table->Probe('Z'));
+    CHECK(found != nullptr && found->action == HotkeyAction::KeyRebind);
+    CHECK(table->FindRebind(table->Probe('X')) == nullptr);
+}
+
+TEST_CASE(DebounceCarriesOverRecompile) {
+    Config config;
+    config.guiHotkey = {};
+    HotkeyConfig hotkey = MakeHotkey({ 'D' });
+    hotkey.debounce = 100;
+    config.hotkeys.push_back(hotkey);
+    const auto table = CompileHotkeyDispatchTable(config, nullptr);
+    const uint32_t index = table->Probe('D').indices[0];
+
+    CHECK(table->TryConsumeDebounce(index, 1000));
+    CHECK(!table->TryConsumeDebounce(index, 1050));
+
+    config.hotkeys.push_back(MakeHotkey({ 'A' })); // Unrelated edit: the table is rebuilt
+    const auto rebuilt = CompileHotkeyDispatchTable(config, table.get());
+    const uint32_t rebuiltIndex = rebuilt->Probe('D').indices[0];
+    CHECK(!rebuilt->TryConsumeDebounce(rebuiltIndex, 1050));
+    CHECK(rebuilt->TryConsumeDebounce(rebuiltIndex, 1100));
+}
+
+TEST_CASE(KeyStateTracksGenericModifiers) {
+    HotkeyKeyState keys;
+    keys.SetDown(VK_LSHIFT, true);
+    keys.SetDown(VK_RSHIFT, true);
+    CHECK(keys.IsDown(VK_SHIFT));
+    CHECK_EQ(keys.Modifiers(), static_cast<uint8_t>(HOTKEY_MOD_SHIFT_ANY));
+    keys.SetDown(VK_LSHIFT, false);
+    CHECK(keys.IsDown(VK_SHIFT));
+    // A generic release (side unresolved) releases both sides
+    keys.SetDown(VK_SHIFT, false);
+    CHECK(!keys.IsDown(VK_RSHIFT) && !keys.IsDown(VK_SHIFT));
+    CHECK_EQ(keys.Modifiers(), static_cast<uint8_t>(0));
+}
+
+// Held mouse buttons the OS reports up (released outside the window) are dropped before the next lookup
+TEST_CASE(ResyncReleasesMouseButtons) {
+    HotkeyKeyState keys;
+    keys.SetDown(VK_XBUTTON1, true);
+    keys.SetDown('A', true);
+    keys.ResyncMouseButtons(); // The test shim reports every key as up
+    CHECK(!keys.IsDown(VK_XBUTTON1));
+    CHECK(keys.IsDown('A'));
+}
@@ -0,0 +1,152 @@
+// ============================================================================
+// TEST_LATENCY_HISTOGRAM.CPP - Histogram percentiles against an exact sort
+// ============================================================================
+// A reported percentile is the middle of the bucket holding the exact value,
+// so it may differ from the sorted value by less than one bucket width:
+// exact below 32 ns, at most 1/16 of the value above.
+// ============================================================================
+
+#include "latency_histogram.h"
+
+#include "test_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+uint64_t NextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Log-uniform from 1 ns to ~4 s, like frame and scope timings spanning many magnitudes
+std::vector<uint64_t> MakeLatencies(size_t count, uint64_t seed) {
+    std::vector<uint64_t> values(count);
+    uint64_t state = seed;
+    for (uint64_t& v : values) {
+        const uint32_t bits = static_cast<uint32_t>(NextRandom(state) % 32);
+        v = (NextRandom(state) & ((1ull << bits) - 1)) | (1ull << bits);
+    }
+    return values;
+}
+
+uint64_t ExactPercentile(const std::vector<uint64_t>& sorted, double percentile) {
+    const uint64_t rank = (std::max)(uint64_t{ 1 }, static_cast<uint64_t>(std::ceil(percentile / 100.0 * sorted.size())));
+    return sorted[(std::min)(rank, static_cast<uint64_t>(sorted.size())) - 1];
+}
+
+bool WithinBucket(uint64_t reported, uint64_t exact) {
+    const uint64_t diff = reported > exact ? reported - exact : exact - reported;
+    return diff <= exact / LatencyHistogram::SUB_BUCKETS;
+}
+
+uint64_t ExactCountAbove(const std::vector<uint64_t>& values, uint64_t threshold) {
+    return static_cast<uint64_t>(std::count_if(values.begin(), values.end(), [&](uint64_t v) { return v > threshold; }));
+}
+
+const double kPercentiles[] = { 0.0, 1.0, 10.0, 25.0, 50.0, 75.0, 90.0, 99.0, 99.9, 100.0 };
+
+} // namespace
+
+TEST_CASE(PercentilesMatchExactSort) {
+    for (uint64_t seed : { 1ull, 7ull, 12345ull }) {
+        std::vector<uint64_t> values = MakeLatencies(20000, seed);
+        LatencyHistogram histogram;
+        for (uint64_t v : values) histogram.Record(v);
+        std::sort(values.begin(), values.end());
+
+        CHECK_EQ(histogram.TotalCount(), static_cast<uint64_t>(values.size()));
+        CHECK_EQ(histogram.MaxValue(), values.back());
+        for (double p : kPercentiles) CHECK(WithinBucket(histogram.ValueAtPercentile(p), ExactPercentile(values, p)));
+        CHECK_EQ(histogram.ValueAtPercentile(100.0), values.back());
+
+        double sum = 0.0;
+        for (uint64_t v : values) sum += static_cast<double>(v);
+        CHECK(std::fabs(histogram.Mean() - sum / values.size()) < 1e-6 * histogram.Mean());
+    }
+}
+
+TEST_CASE(SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 0; v < 2 * LatencyHistogram::SUB_BUCKETS; v++) histogram.Record(v);
+    for (uint64_t v = 0; v < 2 * LatencyHistogram::SUB_BUCKETS; v++) {
+        CHECK_EQ(histogram.ValueAtPercentile(100.0 * (v + 1) / (2 * LatencyHistogram::SUB_BUCKETS)), v);
+    }
+}
+
+TEST_CASE(EmptyAndClampedValues) {
+    LatencyHistogram histogram;
+    CHECK_EQ(histogram.ValueAtPercentile(50.0), static_cast<uint64_t>(0));
+    CHECK_EQ(histogram.Mean(), 0.0);
+    CHECK_EQ(histogram.CountAbove(0), static_cast<uint64_t>(0));
+
+    histogram.Record(~0ull); // Past the last bucket: clamped to MAX_VALUE
+    CHECK_EQ(histogram.MaxValue(), LatencyHistogram::MAX_VALUE);
+    CHECK_EQ(histogram.ValueAtPercentile(50.0), LatencyHistogram::MAX_VALUE);
+    CHECK_EQ(histogram.CountAbove(1000), static_cast<uint64_t>(1));
+    CHECK_EQ(histogram.CountAbove(LatencyHistogram::MAX_VALUE), static_cast<uint64_t>(0));
+}
+
+// CountAbove skips the threshold's own bucket: between the exact count above one bucket width
+// past the threshold and the exact count above the threshold
+TEST_CASE(CountAboveMatchesExactWithinOneBucket) {
+    const std::vector<uint64_t> values = MakeLatencies(20000, 99);
+    LatencyHistogram histogram;
+    for (uint64_t v : values) histogram.Record(v);
+
+    for (uint64_t threshold : { 0ull, 15ull, 31ull, 32ull, 1000ull, 16666667ull, 33333333ull, 1ull << 30 }) {
+        const uint64_t counted = histogram.CountAbove(threshold);
+        CHECK(counted <= ExactCountAbove(values, threshold));
+        CHECK(counted >= ExactCountAbove(values, threshold + threshold / LatencyHistogram::SUB_BUCKETS + 1));
+    }
+    // Below 32 ns every value has its own bucket, so the count is exact
+    CHECK_EQ(histogram.CountAbove(0), ExactCountAbove(values, 0));
+    CHECK_EQ(histogram.CountAbove(20), ExactCountAbove(values, 20));
+}
+
+TEST_CASE(MergeEqualsRecordingEverything) {
+    const std::vector<uint64_t> a = MakeLatencies(5000, 3), b = MakeLatencies(7000, 4);
+    LatencyHistogram ha, hb, all;
+    for (uint64_t v : a) {
+        ha.Record(v);
+        all.Record(v);
+    }
+    for (uint64_t v : b) {
+        hb.Record(v);
+        all.Record(v);
+    }
+    ha.Merge(hb);
+    CHECK_EQ(ha.TotalCount(), all.TotalCount());
+    CHECK_EQ(ha.MaxValue(), all.MaxValue());
+    CHECK_EQ(ha.Mean(), all.Mean());
+    for (double p : kPercentiles) CHECK_EQ(ha.ValueAtPercentile(p), all.ValueAtPercentile(p));
+    CHECK_EQ(ha.CountAbove(16666667), all.CountAbove(16666667));
+
+    ha.Reset();
+    CHECK_EQ(ha.TotalCount(), static_cast<uint64_t>(0));
+    CHECK_EQ(ha.MaxValue(), static_cast<uint64_t>(0));
+    CHECK_EQ(ha.ValueAtPercentile(99.0), static_cast<uint64_t>(0));
+    CHECK_EQ(ha.CountAbove(0), static_cast<uint64_t>(0));
+    ha.Record(500);
+    CHECK_EQ(ha.TotalCount(), static_cast<uint64_t>(1));
+    CHECK_EQ(ha.ValueAtPercentile(50.0), static_cast<uint64_t>(500)); // Clamped to the only value
+}
+
+// Past 2^32 samples per bucket (merged sessions) percentiles must not collapse to the maximum
+TEST_CASE(CountsDoNotWrapPast32Bits) {
+    LatencyHistogram histogram;
+    histogram.Record(100);
+    histogram.Record(1000);
+    histogram.Record(1000000);
+    for (int i = 0; i < 33; i++) histogram.Merge(histogram); // 2^33 samples per value
+
+    CHECK_EQ(histogram.TotalCount(), 3ull << 33);
+    CHECK(WithinBucket(histogram.ValueAtPercentile(10.0), 100));
+    CHECK(WithinBucket(histogram.ValueAtPercentile(50.0), 1000));
+    CHECK_EQ(histogram.ValueAtPercentile(100.0), static_cast<uint64_t>(1000000));
+    CHECK_EQ(histogram.CountAbove(5000), 1ull << 33);
+}
@@ -0,0 +1,212 @@
+// ============================================================================
+// TEST_LOG_RECORD.CPP - LOG_FMT argument encoding and writer-side formatting
+// ============================================================================
+
+#include "log_record.h"
+
+#include "stubs.h"
+#include "test_util.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<LogRecord> g_captured;
+
+void CaptureRecord(const LogRecord& record) { g_captured.push_back(record); }
+
+// Routes LOG_FMT records into g_captured for the lifetime of the scope
+struct LogCapture {
+    LogCapture() {
+        g_captured.clear();
+        g_logRecordSink = CaptureRecord;
+    }
+    ~LogCapture() {
+        g_logRecordSink = nullptr;
+        for (const LogRecord& record : g_captured) delete record.overflowText;
+        g_captured.clear();
+    }
+};
+
+// The formatted line without its "[HH:MM:SS.mmm] " prefix and newline
+std::string RecordText(const LogRecord& record) {
+    std::string line;
+    AppendLogRecordLine(record, line);
+    CHECK(line.size() >= 16 && line.back() == '\n');
+    return line.substr(15, line.size() - 16);
+}
+
+std::string LastText() {
+    CHECK(!g_captured.empty());
+    return RecordText(g_captured.back());
+}
+
+LogRecord PreformattedRecord(const std::string& text) {
+    LogRecord record;
+    record.timestamp = LogTimestampNow();
+    if (text.size() <= LOG_RECORD_PAYLOAD_BYTES) {
+        std::memcpy(record.payload, text.data(), text.size());
+        record.payloadSize = static_cast<uint16_t>(text.size());
+    } else {
+        record.overflowText = new std::string(text);
+    }
+    return record;
+}
+
+int g_evaluations = 0;
+int CountedArgument() { return ++g_evaluations; }
+
+enum class TestEnum : uint8_t { Zero, One, Two };
+
+} // namespace
+
+TEST_CASE(FormatsScalarArguments) {
+    LogCapture capture;
+    LOG_FMT("int={} uint={} neg={} enum={}", 42, 7u, static_cast<int64_t>(-9000000000LL), TestEnum::Two);
+    CHECK_EQ(LastText(), std::string("int=42 uint=7 neg=-9000000000 enum=2"));
+    LOG_FMT("{:.2f} {:.0f} {} {}", 3.14159, 2.5f, 0.25, 1e20);
+    CHECK_EQ(LastText(), std::string("3.14 2 0.25 1e+20"));
+    LOG_FMT("0x{:x} 0x{:x}", 255, 0xDEADBEEFu);
+    CHECK_EQ(LastText(), std::string("0xff 0xdeadbeef"));
+    LOG_FMT("{} {}", true, false);
+    CHECK_EQ(LastText(), std::string("true false"));
+    CHECK_EQ(g_captured.back().argCount, 2);
+    CHECK(!g_captured.back().truncated);
+}
+
+TEST_CASE(FormatsCharactersAsUtf8) {
+    LogCapture capture;
+    LOG_FMT("[{}{}{}{}]", 'a', L'é', u'€', L'\U0001F600');
+    CHECK_EQ(LastText(), std::string("[a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80]"));
+}
+
+TEST_CASE(FormatsStringArguments) {
+    LogCapture capture;
+    const std::string owned = "owned";
+    const std::string_view view = std::string_view("viewed-and-cut").substr(0, 6);
+    const char* missing = nullptr;
+    char buffer[] = "mutable";
+    LOG_FMT("{}|{}|{}|{}|{}|{}", "literal", owned, view, missing, buffer, std::string());
+    CHECK_EQ(LastText(), std::string("literal|owned|viewed|(null)|mutable|"));
+
+    const char unterminated[3] = { 'a', 'b', 'c' }; // Char arrays stop at their size
+    LOG_FMT("[{}]", unterminated);
+    CHECK_EQ(LastText(), std::string("[abc]"));
+}
+
+TEST_CASE(DoubledBracesAreLiteral) {
+    LogCapture capture;
+    LOG_FMT("{{}} {{{}}} }}{{", 5);
+    CHECK_EQ(LastText(), std::string("{} {5} }{"));
+    LOG_FMT("no arguments {{here}}");
+    CHECK_EQ(LastText(), std::string("no arguments {here}"));
+}
+
+TEST_CASE(MissingArgumentsAndUnclosedBraces) {
+    LogCapture capture;
+    LOG_FMT("{} and {} and {:x}", 1);
+    CHECK_EQ(LastText(), std::string("1 and {?} and {?}"));
+    LOG_FMT("value {} then {unclosed", 3);
+    CHECK_EQ(LastText(), std::string("value 3 then {unclosed"));
+}
+
+TEST_CASE(LongStringsAreCutWithoutAllocating) {
+    LogCapture capture;
+    const std::string longText(1000, 'x');
+    LOG_FMT("head={} tail={} n={}", longText, "never stored", 12);
+    const LogRecord& record = g_captured.back();
+    CHECK(record.truncated);
+    CHECK(record.overflowText == nullptr);
+    CHECK(record.payloadSize <= LOG_RECORD_PAYLOAD_BYTES);
+    CHECK_EQ(record.argCount, 1);
+
+    // The cut string fills the payload; arguments that didn't fit print as "..."
+    const std::string text = RecordText(record);
+    const std::string expected = "head=" + std::string(LOG_RECORD_PAYLOAD_BYTES - 3, 'x') + " tail=... n=... [truncated]";
+    CHECK_EQ(text, expected);
+}
+
+TEST_CASE(ScalarsAfterAFullPayloadAreDropped) {
+    LogCapture capture;
+    const std::string fill(LOG_RECORD_PAYLOAD_BYTES - 3 - 4, 'y'); // Leaves 4 bytes: too few for a 9-byte int
+    LOG_FMT("{} {}", fill, 77);
+    const LogRecord& record = g_captured.back();
+    CHECK(record.truncated);
+    CHECK_EQ(record.payloadSize, static_cast<uint16_t>(LOG_RECORD_PAYLOAD_BYTES - 4));
+    CHECK_EQ(RecordText(record), fill + " ... [truncated]");
+}
+
+TEST_CASE(PreformattedTextInPayloadOrOverflow) {
+    const std::string shortText = "Loaded config from disk";
+    LogRecord inPayload = PreformattedRecord(shortText);
+    CHECK(inPayload.overflowText == nullptr);
+    CHECK_EQ(RecordText(inPayload), shortText);
+
+    const std::string exact(LOG_RECORD_PAYLOAD_BYTES, 'p');
+    LogRecord full = PreformattedRecord(exact);
+    CHECK(full.overflowText == nullptr);
+    CHECK_EQ(RecordText(full), exact);
+
+    const std::string longText(LOG_RECORD_PAYLOAD_BYTES + 1, 'q');
+    LogRecord overflow = PreformattedRecord(longText);
+    CHECK(overflow.overflowText != nullptr);
+    const std::string text = RecordText(overflow);
+    delete overflow.overflowText;
+    CHECK_EQ(text, longText);
+}
+
+TEST_CASE(LinePrefixIsWallClockWithMilliseconds) {
+    LogRecord record = PreformattedRecord("x");
+    std::string line;
+    AppendLogRecordLine(record, line);
+    AppendLogRecordLine(record, line); // Same second: served from the cached clock text
+
+    CHECK_EQ(line.size(), static_cast<size_t>(2 * 17));
+    for (size_t start : { static_cast<size_t>(0), static_cast<size_t>(17) }) {
+        const std::string one = line.substr(start, 17);
+        CHECK(one[0] == '[' && one[3] == ':' && one[6] == ':' && one[9] == '.' && one[13] == ']' && one[14] == ' ');
+        for (size_t i : { 1, 2, 4, 5, 7, 8, 10, 11, 12 }) CHECK(one[i] >= '0' && one[i] <= '9');
+        CHECK_EQ(one.substr(15), std::string("x\n"));
+    }
+    CHECK_EQ(line.substr(0, 17), line.substr(17));
+
+    // Milliseconds come from the record's own timestamp
+    record.timestamp += std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(1)).count();
+    std::string later;
+    AppendLogRecordLine(record, later);
+    CHECK(later != line.substr(0, 17));
+}
+
+TEST_CASE(CategoryMaskGatesRecordsAndArguments) {
+    LogCapture capture;
+    const uint32_t savedMask = g_logCategoryMask.load();
+    g_evaluations = 0;
+
+    g_logCategoryMask.store(0);
+    LOG_FMT_CAT(LogCat::Hotkey, "hotkey {}", CountedArgument());
+    CHECK(g_captured.empty());
+    CHECK_EQ(g_evaluations, 0);
+
+    g_logCategoryMask.store(1u << static_cast<uint32_t>(LogCat::Hotkey));
+    CHECK(IsLogCategoryEnabled(LogCat::Hotkey));
+    CHECK(!IsLogCategoryEnabled(LogCat::Gui));
+    LOG_FMT_CAT(LogCat::Gui, "gui {}", CountedArgument());
+    LOG_FMT_CAT(LogCat::Hotkey, "hotkey {}", CountedArgument());
+    CHECK_EQ(g_captured.size(), static_cast<size_t>(1));
+    CHECK_EQ(g_evaluations, 1);
+    CHECK_EQ(LastText(), std::string("hotkey 1"));
+
+    g_logCategoryMask.store(savedMask);
+}
+
+TEST_CASE(EachCallSiteHasItsOwnSite) {
+    LogCapture capture;
+    for (int i = 0; i < 2; i++) LOG_FMT("first {}", i);
+    LOG_FMT("second {}", 0);
+    CHECK_EQ(g_captured.size(), static_cast<size_t>(3));
+    CHECK(g_captured[0].site == g_captured[1].site);
+    CHECK(g_captured[0].site != g_captured[2].site);
+    CHECK_EQ(RecordText(g_captured[1]), std::string("first 1"));
+}
@@ -0,0 +1,34 @@
+// ============================================================================
+// TEST_MAIN.CPP - Runs the TEST_CASEs registered in a test executable
+// ============================================================================
+
+#include "test_util.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+int main(int argc, char** argv) {
+    int failed = 0;
+    int run = 0;
+    for (const TestCase& test : TestRegistry()) {
+        bool selected = argc <= 1;
+        for (int i = 1; i < argc; i++) { selected = selected || std::strcmp(argv[i], test.name) == 0; }
+        if (!selected) continue;
+
+        run++;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            test.fn();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::printf("[  OK  ] %s (%.0f ms)\n", test.name, ms);
+        } catch (const std::exception& e) {
+            failed++;
+            std::printf("[ FAIL ] %s\n         %s\n", test.name, e.what());
+        }
+        std::fflush(stdout);
+    }
+    std::printf("%d/%d passed\n", run - failed, run);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
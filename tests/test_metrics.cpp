@@ -0,0 +1,138 @@
+// ============================================================================
+// TEST_METRICS.CPP - Metric registry, sharded counters, gauges and meter rates
+// ============================================================================
+// The registry is process-wide and metrics are never removed, so the cases
+// share it: each registers its own names, and the registry is filled last.
+// The meter case sleeps through one rate window (~1 s).
+// ============================================================================
+
+#include "metrics.h"
+
+#include "test_util.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const MetricSnapshot* FindMetric(const std::vector<MetricSnapshot>& snapshot, const char* name) {
+    for (const MetricSnapshot& metric : snapshot) {
+        if (std::strcmp(metric.name, name) == 0) return &metric;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// Runs first: the first snapshot starts the rate window, and every meter reads 0 until it completes
+TEST_CASE(MeterRateCoversTheLastWindow) {
+    const MetricId meter = RegisterMetric("test.meter", MetricKind::Meter, "Meter under test");
+    const MetricId counter = RegisterMetric("test.meter_counter", MetricKind::Counter);
+    MetricAdd(meter, 40);
+    MetricAdd(counter, 40);
+
+    std::vector<MetricSnapshot> snapshot = GetMetricsSnapshot();
+    CHECK_EQ(FindMetric(snapshot, "test.meter")->value, static_cast<int64_t>(40));
+    CHECK_EQ(FindMetric(snapshot, "test.meter")->ratePerSecond, 0.0);
+
+    // Mid-window snapshots keep the previous rate instead of measuring a partial window
+    const auto windowStart = std::chrono::steady_clock::now();
+    MetricAdd(meter, 500);
+    MetricAdd(counter, 500);
+    CHECK_EQ(FindMetric(GetMetricsSnapshot(), "test.meter")->ratePerSecond, 0.0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(METRICS_RATE_WINDOW_MS + 50));
+    snapshot = GetMetricsSnapshot();
+    const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - windowStart).count();
+    const MetricSnapshot* rated = FindMetric(snapshot, "test.meter");
+    CHECK_EQ(rated->value, static_cast<int64_t>(540));
+    // 500 events over a window of at least METRICS_RATE_WINDOW_MS (sleep may overshoot on a loaded machine)
+    CHECK(rated->ratePerSecond <= 500.0 * 1000.0 / METRICS_RATE_WINDOW_MS);
+    CHECK(rated->ratePerSecond >= 500.0 / elapsedSeconds * 0.99);
+    CHECK_EQ(FindMetric(snapshot, "test.meter_counter")->ratePerSecond, 0.0); // Counters have no rate
+
+    // The completed window's rate stays until the next one completes
+    MetricAdd(meter, 10000);
+    CHECK_EQ(FindMetric(GetMetricsSnapshot(), "test.meter")->ratePerSecond, rated->ratePerSecond);
+}
+
+TEST_CASE(RegisteringANameTwiceReturnsTheSameId) {
+    const MetricId first = RegisterMetric("test.duplicate", MetricKind::Counter, "First registration");
+    const MetricId second = RegisterMetric("test.duplicate", MetricKind::Gauge, "Ignored");
+    CHECK(first != INVALID_METRIC);
+    CHECK_EQ(second, first);
+    // Names are compared by content, not pointer
+    const std::string copy = "test.duplicate";
+    CHECK_EQ(RegisterMetric(copy.c_str(), MetricKind::Counter), first);
+
+    const MetricSnapshot* metric = FindMetric(GetMetricsSnapshot(), "test.duplicate");
+    CHECK(metric != nullptr);
+    CHECK(metric->kind == MetricKind::Counter);
+    CHECK_EQ(std::string(metric->description), std::string("First registration"));
+}
+
+// More threads than shards, so shards are shared as well as spread
+TEST_CASE(ConcurrentAddsSumAcrossShards) {
+    const MetricId id = RegisterMetric("test.concurrent", MetricKind::Counter);
+    const int threadCount = static_cast<int>(MetricsDetail::SHARD_COUNT) * 2 + 3;
+    const int addsPerThread = 50000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([id, t] {
+            for (int i = 0; i < addsPerThread; i++) MetricAdd(id, 1 + (t & 1));
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    int64_t expected = 0;
+    for (int t = 0; t < threadCount; t++) expected += static_cast<int64_t>(addsPerThread) * (1 + (t & 1));
+    CHECK_EQ(FindMetric(GetMetricsSnapshot(), "test.concurrent")->value, expected);
+}
+
+TEST_CASE(GaugeKeepsTheLastValue) {
+    const MetricId gauge = RegisterMetric("test.gauge", MetricKind::Gauge);
+    MetricSet(gauge, 7);
+    MetricSet(gauge, -3);
+    MetricAdd(gauge, 100); // Gauges ignore increments
+    CHECK_EQ(FindMetric(GetMetricsSnapshot(), "test.gauge")->value, static_cast<int64_t>(-3));
+
+    // Racing writers: the result is one of the written values, never a mix
+    std::vector<std::thread> threads;
+    for (int t = 1; t <= 8; t++) {
+        threads.emplace_back([gauge, t] {
+            for (int i = 0; i < 10000; i++) MetricSet(gauge, t * 1000000 + i);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    const int64_t value = FindMetric(GetMetricsSnapshot(), "test.gauge")->value;
+    CHECK(value % 1000000 == 9999 && value / 1000000 >= 1 && value / 1000000 <= 8);
+
+    // Counters ignore sets
+    const MetricId counter = RegisterMetric("test.gauge_counter", MetricKind::Counter);
+    MetricSet(counter, 50);
+    CHECK_EQ(FindMetric(GetMetricsSnapshot(), "test.gauge_counter")->value, static_cast<int64_t>(0));
+}
+
+// Runs last: fills the process-wide registry
+TEST_CASE(FullRegistryReturnsInvalidMetric) {
+    static std::vector<std::string> s_names; // Registered names are stored, not copied
+    s_names.reserve(MAX_METRICS + 1);
+    MetricId last = 0;
+    for (uint32_t i = 0; i <= MAX_METRICS; i++) {
+        s_names.push_back("test.fill_" + std::to_string(i));
+        last = RegisterMetric(s_names.back().c_str(), MetricKind::Counter);
+        if (last == INVALID_METRIC) break;
+    }
+    CHECK_EQ(last, INVALID_METRIC);
+    CHECK_EQ(GetMetricsSnapshot().size(), static_cast<size_t>(MAX_METRICS));
+
+    // Existing names still resolve; updates through INVALID_METRIC are ignored
+    CHECK(RegisterMetric("test.duplicate", MetricKind::Counter) != INVALID_METRIC);
+    MetricAdd(INVALID_METRIC, 5);
+    MetricSet(INVALID_METRIC, 5);
+    CHECK_EQ(RegisterMetric("test.one_too_many", MetricKind::Gauge), INVALID_METRIC);
+}
@@ -0,0 +1,103 @@
+// ============================================================================
+// TEST_MIRROR_BORDER.CPP - Separable dynamic border vs the brute-force shader
+// ============================================================================
+// MirrorCpuFinalPass computes the dynamic border with the same two separable
+// max passes as the GPU engine; MirrorCpuFinalPassReference is a direct port
+// of the original (2w+1)^2 render shaders. Outputs must be pixel-exact.
+// ============================================================================
+
+#include "mirror_cpu_filter.h"
+#include "mirror_test_frames.h"
+
+#include "test_util.h"
+
+#include <cstdio>
+
+namespace {
+
+// Filter image with random coverage: isolated texels, small blobs and texels on every edge
+MirrorCpuImage MakeCoverage(int w, int h, uint32_t seed, int density) {
+    MirrorCpuImage filter;
+    filter.Reset(w, h);
+    uint32_t state = seed;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (static_cast<int>(TestRandom(state) % 1000) >= density) continue;
+            uint8_t* p = filter.Row(y) + static_cast<size_t>(x) * 4;
+            p[0] = static_cast<uint8_t>(TestRandom(state));
+            p[1] = static_cast<uint8_t>(TestRandom(state));
+            p[2] = static_cast<uint8_t>(TestRandom(state));
+            p[3] = 255;
+        }
+    }
+    // Alpha right at the 0.5 threshold on either side
+    filter.Row(h / 2)[3] = 127;
+    filter.Row(h / 3)[7] = 128;
+    return filter;
+}
+
+size_t CountBorderMismatches(const MirrorCpuImage& filter, const ThreadedMirrorConfig& conf, CpuSimdLevel level) {
+    MirrorCpuImage fast, reference;
+    MirrorCpuFinalPass(filter, conf, false, fast, level);
+    MirrorCpuFinalPassReference(filter, conf, reference);
+    if (fast.width != reference.width || fast.height != reference.height) return static_cast<size_t>(reference.width) * reference.height + 1;
+
+    size_t mismatches = 0;
+    for (int y = 0; y < fast.height; y++) {
+        for (int x = 0; x < fast.width; x++) {
+            const uint8_t* a = fast.Row(y) + static_cast<size_t>(x) * 4;
+            const uint8_t* b = reference.Row(y) + static_cast<size_t>(x) * 4;
+            if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2] || a[3] != b[3]) {
+                if (mismatches < 5) std::printf("         mismatch at (%d, %d)\n", x, y);
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+void CheckBorderExact(int w, int h, int borderWidth, float scaleX, float scaleY, bool passthrough, int density) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(w, h, borderWidth);
+    conf.colorPassthrough = passthrough;
+    conf.outputSeparateScale = true;
+    conf.outputScaleX = scaleX;
+    conf.outputScaleY = scaleY;
+    const MirrorCpuImage filter = MakeCoverage(w + 2 * borderWidth, h + 2 * borderWidth, static_cast<uint32_t>(w * 31 + borderWidth), density);
+
+    for (CpuSimdLevel level : { CpuSimdLevel::Scalar, CpuSimdLevel::SSE2, CpuSimdLevel::AVX2 }) {
+        if (ResolveCpuSimdLevel(level) != level) continue;
+        CHECK_EQ(CountBorderMismatches(filter, conf, level), static_cast<size_t>(0));
+    }
+}
+
+} // namespace
+
+// Border widths people use on pie-chart and entity-counter mirrors
+TEST_CASE(BorderWidthsMatchBruteForce) {
+    for (int borderWidth : { 0, 1, 2, 3, 5, 8, 13 }) { CheckBorderExact(48, 36, borderWidth, 1.0f, 1.0f, false, 20); }
+}
+
+TEST_CASE(PassthroughBorderMatchesBruteForce) {
+    for (int borderWidth : { 1, 4 }) { CheckBorderExact(40, 40, borderWidth, 1.0f, 1.0f, true, 20); }
+}
+
+// Up- and downscaled output: the window is taken in output pixels over nearest-sampled texels
+TEST_CASE(ScaledBorderMatchesBruteForce) {
+    CheckBorderExact(30, 20, 3, 2.0f, 2.0f, false, 15);
+    CheckBorderExact(33, 21, 2, 2.5f, 1.5f, false, 15);
+    CheckBorderExact(64, 48, 4, 0.5f, 0.75f, false, 15);
+    CheckBorderExact(17, 9, 6, 3.3f, 4.1f, true, 30);
+}
+
+// Empty and fully covered images, and coverage dense enough that borders merge
+TEST_CASE(CoverageExtremesMatchBruteForce) {
+    CheckBorderExact(32, 24, 3, 1.0f, 1.0f, false, 0);
+    CheckBorderExact(32, 24, 3, 1.0f, 1.0f, false, 1000);
+    CheckBorderExact(32, 24, 3, 1.0f, 1.0f, false, 300);
+}
+
+// Borders wider than the image: every window reaches past the edges, which clamp
+TEST_CASE(BorderWiderThanImageMatchesBruteForce) {
+    CheckBorderExact(6, 4, 9, 1.0f, 1.0f, false, 100);
+    CheckBorderExact(5, 3, 7, 2.0f, 3.0f, false, 100);
+}
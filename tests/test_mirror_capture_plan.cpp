@@ -0,0 +1,185 @@
+// ============================================================================
+// TEST_MIRROR_CAPTURE_PLAN.CPP - Rectangle merging, packing and atlas remapping
+// ============================================================================
+// The end-to-end cases copy a synthetic game frame into an atlas exactly as
+// SubmitFrameCapture's per-entry blits do, then read every mirror input back
+// through MapCaptureRectToAtlas and compare it with the game frame.
+// ============================================================================
+
+#include "mirror_capture_plan.h"
+#include "relative_coords.h"
+
+#include "test_util.h"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// Entries inside the game and atlas, with no two placements overlapping (gutter included)
+bool PlanIsWellFormed(const MirrorCapturePlan& plan) {
+    const CaptureRect game = { 0, 0, plan.gameW, plan.gameH };
+    const CaptureRect atlas = { 0, 0, plan.atlasW, plan.atlasH };
+    if (plan.atlasW % CAPTURE_PLAN_ATLAS_ALIGN != 0 || plan.atlasH % CAPTURE_PLAN_ATLAS_ALIGN != 0) return false;
+    for (size_t i = 0; i < plan.entries.size(); i++) {
+        const CapturePlanEntry& e = plan.entries[i];
+        const CaptureRect placed = { e.atlasX, e.atlasY, e.src.w, e.src.h };
+        if (e.src.w <= 0 || e.src.h <= 0 || !game.Contains(e.src) || !atlas.Contains(placed)) return false;
+        const CaptureRect padded = { placed.x, placed.y, placed.w + CAPTURE_PLAN_GUTTER, placed.h + CAPTURE_PLAN_GUTTER };
+        for (size_t j = i + 1; j < plan.entries.size(); j++) {
+            const CapturePlanEntry& o = plan.entries[j];
+            if (padded.Intersects({ o.atlasX, o.atlasY, o.src.w, o.src.h })) return false;
+            if (e.src.Intersects(o.src)) return false; // Merging leaves no overlapping sources
+        }
+    }
+    return true;
+}
+
+uint32_t GamePixel(int x, int y) { return (static_cast<uint32_t>(y) << 16) | static_cast<uint32_t>(x); }
+
+// Copies every entry into an atlas image and checks each input rectangle reads back the game pixels
+void CheckRemapReproducesGame(const MirrorCapturePlan& plan, const std::vector<CaptureRect>& inputs) {
+    std::vector<uint32_t> atlas(static_cast<size_t>(plan.atlasW) * plan.atlasH, 0xFFFFFFFFu);
+    for (const CapturePlanEntry& e : plan.entries) {
+        for (int y = 0; y < e.src.h; y++) {
+            for (int x = 0; x < e.src.w; x++) {
+                atlas[static_cast<size_t>(e.atlasY + y) * plan.atlasW + e.atlasX + x] = GamePixel(e.src.x + x, e.src.y + y);
+            }
+        }
+    }
+
+    for (const CaptureRect& r : inputs) {
+        int ax = -1, ay = -1;
+        CHECK(MapCaptureRectToAtlas(plan, r, ax, ay));
+        for (int y = 0; y < r.h; y++) {
+            for (int x = 0; x < r.w; x++) { CHECK_EQ(atlas[static_cast<size_t>(ay + y) * plan.atlasW + ax + x], GamePixel(r.x + x, r.y + y)); }
+        }
+    }
+}
+
+// Mirror input resolved the way MT_GetCapturePlan does it
+CaptureRect ResolveInput(const std::string& anchor, int x, int y, int w, int h, int gameW, int gameH) {
+    CaptureRect r = { 0, 0, w, h };
+    GetRelativeCoords(anchor, x, y, w, h, gameW, gameH, r.x, r.y);
+    return r;
+}
+
+} // namespace
+
+TEST_CASE(MergeJoinsOverlappingRects) {
+    const std::vector<CaptureRect> merged = MergeCaptureRects({ { 0, 0, 10, 10 }, { 5, 5, 10, 10 } });
+    CHECK_EQ(merged.size(), static_cast<size_t>(1));
+    CHECK(merged[0].x == 0 && merged[0].y == 0 && merged[0].w == 15 && merged[0].h == 15);
+}
+
+// A bounding box can swallow a third rectangle that overlapped neither input
+TEST_CASE(MergeReachesFixpoint) {
+    const std::vector<CaptureRect> merged = MergeCaptureRects({ { 0, 0, 10, 2 }, { 8, 0, 2, 10 }, { 2, 5, 2, 2 }, { 50, 50, 4, 4 } });
+    CHECK_EQ(merged.size(), static_cast<size_t>(2));
+    for (size_t i = 0; i < merged.size(); i++) {
+        for (size_t j = i + 1; j < merged.size(); j++) CHECK(!merged[i].Intersects(merged[j]));
+    }
+}
+
+TEST_CASE(MergeDropsContainedAndEmptyRects) {
+    const std::vector<CaptureRect> merged = MergeCaptureRects({ { 0, 0, 20, 20 }, { 5, 5, 3, 3 }, { 40, 40, 0, 5 }, { 60, 0, 5, -1 } });
+    CHECK_EQ(merged.size(), static_cast<size_t>(1));
+    CHECK_EQ(merged[0].w, 20);
+}
+
+// Touching edges don't overlap, so they stay separate blocks
+TEST_CASE(MergeKeepsAdjacentRectsApart) {
+    CHECK_EQ(MergeCaptureRects({ { 0, 0, 10, 10 }, { 10, 0, 10, 10 } }).size(), static_cast<size_t>(2));
+}
+
+TEST_CASE(PackPlacementsDoNotOverlap) {
+    std::vector<CaptureRect> rects;
+    for (int i = 0; i < 40; i++) rects.push_back({ 0, 0, 5 + (i * 7) % 60, 3 + (i * 11) % 45 });
+    std::vector<CaptureRect> positions;
+    int w = 0, h = 0;
+    PackCaptureRects(rects, 1, positions, w, h);
+    CHECK_EQ(positions.size(), rects.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        CHECK(positions[i].w == rects[i].w && positions[i].h == rects[i].h);
+        CHECK(positions[i].x >= 0 && positions[i].y >= 0 && positions[i].x + positions[i].w <= w && positions[i].y + positions[i].h <= h);
+        const CaptureRect padded = { positions[i].x, positions[i].y, positions[i].w + 1, positions[i].h + 1 };
+        for (size_t j = i + 1; j < positions.size(); j++) CHECK(!padded.Intersects(positions[j]));
+    }
+}
+
+TEST_CASE(PackEmptyInput) {
+    std::vector<CaptureRect> positions;
+    int w = -1, h = -1;
+    PackCaptureRects({}, 1, positions, w, h);
+    CHECK(positions.empty() && w == 0 && h == 0);
+}
+
+// Typical pie-chart + entity-counter setup on a 1080p game
+TEST_CASE(CompileRemapsTypicalMirrors) {
+    const int gameW = 1920, gameH = 1080;
+    const std::vector<CaptureRect> inputs = {
+        ResolveInput("pieRightScreen", -280, -10, 300, 170, gameW, gameH), ResolveInput("topLeftScreen", 10, 40, 60, 20, gameW, gameH),
+        ResolveInput("topLeftScreen", 30, 45, 60, 20, gameW, gameH),       ResolveInput("centerScreen", 0, 0, 50, 50, gameW, gameH),
+        ResolveInput("bottomRightScreen", 5, 5, 50, 50, gameW, gameH),
+    };
+    MirrorCapturePlan plan;
+    CHECK(CompileMirrorCapturePlan(inputs, gameW, gameH, plan));
+    CHECK(plan.gameW == gameW && plan.gameH == gameH);
+    CHECK(PlanIsWellFormed(plan));
+    CHECK_EQ(plan.entries.size(), static_cast<size_t>(4)); // The two counter regions overlap
+    CHECK(static_cast<long long>(plan.atlasW) * plan.atlasH < static_cast<long long>(gameW) * gameH / 10);
+    CheckRemapReproducesGame(plan, inputs);
+}
+
+// Pseudo-random mirror layouts: every compiled plan is well formed and remaps every input exactly
+TEST_CASE(CompileRandomLayoutsRemapExactly) {
+    uint32_t state = 2024;
+    auto next = [&](uint32_t n) {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int>((state >> 8) % n);
+    };
+    int compiled = 0;
+    for (int iter = 0; iter < 300; iter++) {
+        const int gameW = 320 + next(1600), gameH = 240 + next(900);
+        std::vector<CaptureRect> inputs;
+        const int count = 1 + next(12);
+        for (int i = 0; i < count; i++) {
+            const int w = 1 + next(90), h = 1 + next(90);
+            inputs.push_back({ next(gameW - w + 1), next(gameH - h + 1), w, h });
+        }
+        MirrorCapturePlan plan;
+        if (!CompileMirrorCapturePlan(inputs, gameW, gameH, plan)) continue;
+        compiled++;
+        CHECK(PlanIsWellFormed(plan));
+        CHECK(plan.atlasW <= gameW && plan.atlasH <= gameH); // Packed into full-frame copy storage
+        CheckRemapReproducesGame(plan, inputs);
+    }
+    CHECK(compiled > 200);
+}
+
+TEST_CASE(CompileFallsBackToFullCopy) {
+    MirrorCapturePlan plan;
+    CHECK(!CompileMirrorCapturePlan({}, 1920, 1080, plan));
+    CHECK(!CompileMirrorCapturePlan({ { 0, 0, 0, 0 } }, 1920, 1080, plan));
+    CHECK(!CompileMirrorCapturePlan({ { 10, 10, 50, 50 } }, 0, 1080, plan));
+    // Past the frame edge: the filter needs CLAMP_TO_EDGE sampling of the real frame
+    CHECK(!CompileMirrorCapturePlan({ { -5, 10, 50, 50 } }, 1920, 1080, plan));
+    CHECK(!CompileMirrorCapturePlan({ { 1900, 10, 50, 50 } }, 1920, 1080, plan));
+    // Atlas not meaningfully smaller than the frame
+    CHECK(!CompileMirrorCapturePlan({ { 0, 0, 1500, 900 } }, 1920, 1080, plan));
+    // Small enough by area, but the packed atlas is taller than a very wide, short frame
+    std::vector<CaptureRect> strip;
+    for (int i = 0; i < 20; i++) strip.push_back({ i * 100, 20, 60, 60 });
+    CHECK(!CompileMirrorCapturePlan(strip, 4000, 100, plan));
+    CHECK(plan.entries.empty());
+}
+
+TEST_CASE(MapRejectsUncoveredRects) {
+    MirrorCapturePlan plan;
+    CHECK(CompileMirrorCapturePlan({ { 100, 100, 50, 50 } }, 1920, 1080, plan));
+    int ax = 0, ay = 0;
+    CHECK(MapCaptureRectToAtlas(plan, { 110, 120, 20, 20 }, ax, ay));
+    CHECK(ax == plan.entries[0].atlasX + 10 && ay == plan.entries[0].atlasY + 20);
+    CHECK(!MapCaptureRectToAtlas(plan, { 140, 100, 20, 20 }, ax, ay)); // Straddles the entry edge
+    CHECK(!MapCaptureRectToAtlas(plan, { 500, 500, 10, 10 }, ax, ay));
+}
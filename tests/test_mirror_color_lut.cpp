@@ -0,0 +1,104 @@
+// ============================================================================
+// TEST_MIRROR_COLOR_LUT.CPP - Color-match tables vs the shader reference math
+// ============================================================================
+// Every table is compared with MirrorColorMatchesReference (the CPU port of the
+// original per-pixel filter shader) over all 2^24 RGB8 inputs.
+// ============================================================================
+
+#include "mirror_color_lut.h"
+
+#include "test_util.h"
+
+#include <cstdio>
+
+namespace {
+
+// Number of RGB8 colors where the table and the per-pixel reference disagree
+size_t CountTableMismatches(const MirrorColorMatchKey& key, const std::vector<uint32_t>& words) {
+    size_t mismatches = 0;
+    for (int r = 0; r < 256; r++) {
+        for (int g = 0; g < 256; g++) {
+            for (int b = 0; b < 256; b++) {
+                const uint8_t r8 = static_cast<uint8_t>(r), g8 = static_cast<uint8_t>(g), b8 = static_cast<uint8_t>(b);
+                if (MirrorColorMatchTableLookup(words, r8, g8, b8) != MirrorColorMatchesReference(key, r8, g8, b8)) {
+                    if (mismatches < 5) std::printf("         mismatch at (%d, %d, %d)\n", r, g, b);
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+size_t CountMatches(const std::vector<uint32_t>& words) {
+    size_t count = 0;
+    for (uint32_t word : words) {
+        for (; word; word &= word - 1) count++;
+    }
+    return count;
+}
+
+void CheckExact(const std::vector<Color>& targets, float sensitivity, MirrorGammaMode mode) {
+    const MirrorColorMatchKey key = MakeMirrorColorMatchKey(targets, sensitivity, mode);
+    std::vector<uint32_t> words;
+    BuildMirrorColorMatchTable(key, words);
+    CHECK_EQ(words.size(), static_cast<size_t>(MIRROR_COLOR_LUT_WORDS));
+    CHECK_EQ(CountTableMismatches(key, words), static_cast<size_t>(0));
+}
+
+const MirrorGammaMode kGammaModes[] = { MirrorGammaMode::Auto, MirrorGammaMode::AssumeSRGB, MirrorGammaMode::AssumeLinear };
+
+} // namespace
+
+// Default mirror sensitivity: a handful of colors around one target
+TEST_CASE(SingleTargetDefaultSensitivityMatchesReference) {
+    for (MirrorGammaMode mode : kGammaModes) { CheckExact({ { 0.8f, 0.2f, 0.2f } }, 0.001f, mode); }
+}
+
+// Pie-chart style: several targets, one close to black where sRGB and linear distances differ most
+TEST_CASE(MultipleTargetsMatchReference) {
+    const std::vector<Color> targets = { { 0.894f, 0.275f, 0.769f }, { 0.275f, 0.8f, 0.424f }, { 0.0f, 0.0f, 0.0f },
+                                         { 1.0f, 1.0f, 1.0f },       { 0.04f, 0.04f, 0.04f } };
+    for (MirrorGammaMode mode : kGammaModes) { CheckExact(targets, 0.05f, mode); }
+}
+
+// More targets than the old shader's 8-color cap
+TEST_CASE(ManyTargetsBeyondShaderCapMatchReference) {
+    std::vector<Color> targets;
+    for (int i = 0; i < 12; i++) { targets.push_back({ i / 11.0f, 1.0f - i / 11.0f, (i % 3) / 2.0f }); }
+    CheckExact(targets, 0.02f, MirrorGammaMode::Auto);
+}
+
+// Large spheres exercise the candidate range bounds at the cube edges
+TEST_CASE(LargeSensitivityMatchesReference) {
+    CheckExact({ { 0.5f, 0.5f, 0.5f }, { 0.0f, 1.0f, 0.0f } }, 0.35f, MirrorGammaMode::Auto);
+    CheckExact({ { 0.1f, 0.9f, 0.3f } }, 0.6f, MirrorGammaMode::AssumeLinear);
+}
+
+TEST_CASE(ZeroSensitivityMatchesNothing) {
+    const MirrorColorMatchKey key = MakeMirrorColorMatchKey({ { 1.0f, 0.0f, 0.0f } }, 0.0f, MirrorGammaMode::Auto);
+    std::vector<uint32_t> words;
+    BuildMirrorColorMatchTable(key, words);
+    CHECK_EQ(CountMatches(words), static_cast<size_t>(0));
+    CHECK(!MirrorColorMatchesReference(key, 255, 0, 0));
+}
+
+TEST_CASE(ExactTargetColorIsInTable) {
+    const MirrorColorMatchKey key = MakeMirrorColorMatchKey({ { 64 / 255.0f, 128 / 255.0f, 192 / 255.0f } }, 0.001f,
+                                                            MirrorGammaMode::AssumeSRGB);
+    std::vector<uint32_t> words;
+    BuildMirrorColorMatchTable(key, words);
+    CHECK(MirrorColorMatchTableLookup(words, 64, 128, 192));
+    CHECK(!MirrorColorMatchTableLookup(words, 192, 128, 64));
+}
+
+// Keys only differ by what can change a match decision
+TEST_CASE(KeyIgnoresAlpha) {
+    const MirrorColorMatchKey a = MakeMirrorColorMatchKey({ { 0.1f, 0.2f, 0.3f, 1.0f } }, 0.01f, MirrorGammaMode::Auto);
+    const MirrorColorMatchKey b = MakeMirrorColorMatchKey({ { 0.1f, 0.2f, 0.3f, 0.25f } }, 0.01f, MirrorGammaMode::Auto);
+    const MirrorColorMatchKey c = MakeMirrorColorMatchKey({ { 0.1f, 0.2f, 0.3f, 1.0f } }, 0.01f, MirrorGammaMode::AssumeSRGB);
+    const MirrorColorMatchKey d = MakeMirrorColorMatchKey({ { 0.1f, 0.2f, 0.3f, 1.0f } }, 0.02f, MirrorGammaMode::Auto);
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(a != d);
+}
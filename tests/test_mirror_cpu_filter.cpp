@@ -0,0 +1,139 @@
+// ============================================================================
+// TEST_MIRROR_CPU_FILTER.CPP - CPU mirror pipeline: SIMD levels vs scalar
+// ============================================================================
+// Every kernel level the CPU supports must produce byte-identical filter and
+// final images to the scalar path, for each filter mode and border type.
+// ============================================================================
+
+#include "mirror_color_lut.h"
+#include "mirror_cpu_filter.h"
+#include "mirror_test_frames.h"
+
+#include "test_util.h"
+
+#include <cstdio>
+
+namespace {
+
+const int kFrameW = 320;
+const int kFrameH = 200;
+
+struct PipelineOutput {
+    MirrorCpuImage filter;
+    MirrorCpuImage final;
+};
+
+PipelineOutput RunAt(const std::vector<uint8_t>& frame, const ThreadedMirrorConfig& conf, bool rawOutput, CpuSimdLevel level) {
+    std::vector<uint32_t> table;
+    BuildMirrorColorMatchTable(MakeMirrorColorMatchKey(conf.targetColors, conf.colorSensitivity, MirrorGammaMode::Auto), table);
+    MirrorCpuSource src{ frame.data(), kFrameW, kFrameH, kFrameW * 4 };
+    PipelineOutput out;
+    RunMirrorCpuPipeline(src, conf, table, rawOutput, out.filter, out.final, level);
+    return out;
+}
+
+size_t CountPixelDifferences(const MirrorCpuImage& a, const MirrorCpuImage& b) {
+    if (a.width != b.width || a.height != b.height) return static_cast<size_t>(b.width) * b.height + 1;
+    size_t diffs = 0;
+    for (size_t i = 0; i < a.rgba.size(); i += 4) {
+        if (a.rgba[i] != b.rgba[i] || a.rgba[i + 1] != b.rgba[i + 1] || a.rgba[i + 2] != b.rgba[i + 2] || a.rgba[i + 3] != b.rgba[i + 3]) {
+            diffs++;
+        }
+    }
+    return diffs;
+}
+
+size_t CountOpaquePixels(const MirrorCpuImage& image) {
+    size_t count = 0;
+    for (size_t i = 3; i < image.rgba.size(); i += 4) count += image.rgba[i] != 0;
+    return count;
+}
+
+// Runs conf at every supported level and compares both passes with the scalar output
+void CheckLevelsMatchScalar(const ThreadedMirrorConfig& conf, bool rawOutput) {
+    const std::vector<uint8_t> frame = MakeTestFrame(kFrameW, kFrameH, 1234);
+    const PipelineOutput scalar = RunAt(frame, conf, rawOutput, CpuSimdLevel::Scalar);
+    CHECK(CountOpaquePixels(scalar.filter) > 0); // The frame has matches in the region, so the comparison means something
+
+    for (CpuSimdLevel level : { CpuSimdLevel::SSE2, CpuSimdLevel::SSE41, CpuSimdLevel::AVX2 }) {
+        if (ResolveCpuSimdLevel(level) != level) continue;
+        const PipelineOutput simd = RunAt(frame, conf, rawOutput, level);
+        CHECK_EQ(CountPixelDifferences(simd.filter, scalar.filter), static_cast<size_t>(0));
+        CHECK_EQ(CountPixelDifferences(simd.final, scalar.final), static_cast<size_t>(0));
+    }
+}
+
+} // namespace
+
+TEST_CASE(ColorOutputMatchesScalar) {
+    for (int border : { 0, 1, 3, 8 }) { CheckLevelsMatchScalar(MakeTestMirrorConfig(67, 45, border), false); }
+}
+
+TEST_CASE(ColorPassthroughMatchesScalar) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(67, 45, 2);
+    conf.colorPassthrough = true;
+    CheckLevelsMatchScalar(conf, false);
+}
+
+TEST_CASE(RawOutputMatchesScalar) { CheckLevelsMatchScalar(MakeTestMirrorConfig(67, 45, 2), true); }
+
+TEST_CASE(StaticBorderMatchesScalar) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(64, 48, 0);
+    conf.borderType = MirrorBorderType::Static;
+    CheckLevelsMatchScalar(conf, false);
+}
+
+// Non-integer output scales exercise the nearest-texel maps
+TEST_CASE(ScaledOutputMatchesScalar) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(50, 33, 2);
+    conf.outputSeparateScale = true;
+    conf.outputScaleX = 2.5f;
+    conf.outputScaleY = 1.7f;
+    CheckLevelsMatchScalar(conf, false);
+    conf.outputScaleX = 0.6f;
+    conf.outputScaleY = 0.45f;
+    CheckLevelsMatchScalar(conf, false);
+}
+
+// Overlapping regions add (saturating), and regions past the frame edge clamp to it
+TEST_CASE(OverlappingAndClampedRegionsMatchScalar) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(60, 40, 1);
+    MirrorCaptureConfig a, b;
+    a.x = -20;
+    a.y = 10;
+    a.relativeTo = "topLeftScreen";
+    b.x = 5;
+    b.y = -15;
+    b.relativeTo = "topRightScreen";
+    conf.input.push_back(a);
+    conf.input.push_back(b);
+    conf.input.push_back(conf.input.front());
+    CheckLevelsMatchScalar(conf, false);
+    conf.colorPassthrough = true;
+    CheckLevelsMatchScalar(conf, false);
+}
+
+TEST_CASE(RawOutputIsOpaque) {
+    const ThreadedMirrorConfig conf = MakeTestMirrorConfig(40, 30, 0);
+    const PipelineOutput out = RunAt(MakeTestFrame(kFrameW, kFrameH, 7), conf, true, GetCpuSimdLevel());
+    CHECK_EQ(CountOpaquePixels(out.filter), static_cast<size_t>(40 * 30));
+}
+
+// Only matching pixels are drawn; a frame without target colors leaves the filter image empty
+TEST_CASE(ColorOutputDrawsMatchesOnly) {
+    ThreadedMirrorConfig conf = MakeTestMirrorConfig(40, 30, 0);
+    std::vector<uint8_t> frame(static_cast<size_t>(kFrameW) * kFrameH * 4, 0);
+    CHECK_EQ(CountOpaquePixels(RunAt(frame, conf, false, GetCpuSimdLevel()).filter), static_cast<size_t>(0));
+
+    // One target-colored pixel inside the region (bottom-right anchor, offset 40/30)
+    const int x = kFrameW - 40 - 40 + 5;
+    const int y = kFrameH - 30 - 30 + 7;
+    uint8_t* p = frame.data() + (static_cast<size_t>(y) * kFrameW + x) * 4;
+    p[0] = TestColorByte(kTestTargetColors[0].r);
+    p[1] = TestColorByte(kTestTargetColors[0].g);
+    p[2] = TestColorByte(kTestTargetColors[0].b);
+    const PipelineOutput out = RunAt(frame, conf, false, GetCpuSimdLevel());
+    CHECK_EQ(CountOpaquePixels(out.filter), static_cast<size_t>(1));
+    const uint8_t* hit = out.filter.Row(7) + 5 * 4;
+    CHECK(hit[0] == 255 && hit[1] == 128 && hit[2] == 0 && hit[3] == 255);
+}
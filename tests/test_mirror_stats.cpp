@@ -0,0 +1,250 @@
+// ============================================================================
+// TEST_MIRROR_STATS.CPP - Content statistics scans against a scalar reference
+// ============================================================================
+// Buffers are bottom-up RGBA8 like the glReadPixels readback. Every SIMD level
+// must agree with a plain per-pixel loop on the content check, matched count,
+// bounding box and centroid; per-target counts are checked against
+// MirrorColorMatchesReference for each target on its own.
+// ============================================================================
+
+#include "mirror_stats.h"
+
+#include "test_util.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const CpuSimdLevel kLevels[] = { CpuSimdLevel::Scalar, CpuSimdLevel::SSE2, CpuSimdLevel::SSE41, CpuSimdLevel::AVX2 };
+
+uint32_t NextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Random colors everywhere; alpha > 0 on roughly one pixel in `sparsity`
+std::vector<uint8_t> MakeReadback(int width, int height, uint32_t sparsity, uint32_t seed) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t state = seed;
+    for (size_t p = 0; p < rgba.size(); p += 4) {
+        for (int c = 0; c < 3; c++) rgba[p + c] = static_cast<uint8_t>(NextRandom(state));
+        rgba[p + 3] = (NextRandom(state) % sparsity == 0) ? static_cast<uint8_t>(1 + NextRandom(state) % 255) : 0;
+    }
+    return rgba;
+}
+
+struct ReferenceStats {
+    uint64_t matched = 0;
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    double centroidX = 0.0, centroidY = 0.0;
+};
+
+// Capture coordinates: top-left origin, padding removed
+ReferenceStats ComputeReference(const std::vector<uint8_t>& rgba, int width, int height, int padding) {
+    ReferenceStats ref;
+    double sumX = 0.0, sumY = 0.0;
+    for (int row = 0; row < height; row++) {
+        for (int x = 0; x < width; x++) {
+            if (rgba[(static_cast<size_t>(row) * width + x) * 4 + 3] == 0) continue;
+            const int cx = x - padding;
+            const int cy = (height - 1 - row) - padding;
+            if (ref.matched == 0) {
+                ref.minX = ref.maxX = cx;
+                ref.minY = ref.maxY = cy;
+            }
+            ref.minX = (std::min)(ref.minX, cx);
+            ref.maxX = (std::max)(ref.maxX, cx);
+            ref.minY = (std::min)(ref.minY, cy);
+            ref.maxY = (std::max)(ref.maxY, cy);
+            sumX += cx;
+            sumY += cy;
+            ref.matched++;
+        }
+    }
+    if (ref.matched) {
+        ref.centroidX = sumX / ref.matched;
+        ref.centroidY = sumY / ref.matched;
+    }
+    return ref;
+}
+
+void CheckMatchesReference(const std::vector<uint8_t>& rgba, int width, int height, int padding) {
+    const ReferenceStats ref = ComputeReference(rgba, width, height, padding);
+    for (CpuSimdLevel level : kLevels) {
+        MirrorContentStats stats;
+        ComputeMirrorContentStats(rgba.data(), width, height, padding, nullptr, stats, level);
+        CHECK(stats.valid);
+        CHECK_EQ(stats.captureWidth, width - 2 * padding);
+        CHECK_EQ(stats.captureHeight, height - 2 * padding);
+        CHECK_EQ(stats.matchedPixels, ref.matched);
+        CHECK_EQ(stats.hasContent, ref.matched > 0);
+        CHECK(stats.targetColorPixels.empty());
+        CHECK_EQ(MirrorScanHasContent(rgba.data(), rgba.size() / 4, level), ref.matched > 0);
+        if (!stats.hasContent) continue;
+        CHECK_EQ(stats.minX, ref.minX);
+        CHECK_EQ(stats.minY, ref.minY);
+        CHECK_EQ(stats.maxX, ref.maxX);
+        CHECK_EQ(stats.maxY, ref.maxY);
+        CHECK(std::fabs(stats.centroidX - ref.centroidX) < 1e-3);
+        CHECK(std::fabs(stats.centroidY - ref.centroidY) < 1e-3);
+    }
+}
+
+void SetPixel(std::vector<uint8_t>& rgba, int width, int x, int row, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    uint8_t* p = &rgba[(static_cast<size_t>(row) * width + x) * 4];
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+    p[3] = a;
+}
+
+} // namespace
+
+TEST_CASE(HasContentFindsASinglePixelAnywhere) {
+    // Lengths around the 16- and 32-pixel SIMD blocks; every position, so no tail or block is skipped
+    for (size_t count : { 1u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 100u }) {
+        std::vector<uint8_t> rgba(count * 4, 0xFF);
+        for (size_t p = 0; p < count; p++) rgba[p * 4 + 3] = 0; // Colors without alpha never count
+        for (CpuSimdLevel level : kLevels) CHECK(!MirrorScanHasContent(rgba.data(), count, level));
+        for (size_t hit = 0; hit < count; hit++) {
+            rgba[hit * 4 + 3] = 1;
+            for (CpuSimdLevel level : kLevels) CHECK(MirrorScanHasContent(rgba.data(), count, level));
+            rgba[hit * 4 + 3] = 0;
+        }
+    }
+    for (CpuSimdLevel level : kLevels) CHECK(!MirrorScanHasContent(nullptr, 0, level));
+}
+
+TEST_CASE(StatsMatchReferenceAcrossWidths) {
+    // Widths around the 64-pixel mask chunks and the 4/8-pixel SIMD steps
+    for (int width : { 1, 3, 8, 63, 64, 65, 127, 130, 257 }) {
+        for (uint32_t sparsity : { 1u, 7u, 500u }) {
+            const int height = 9;
+            CheckMatchesReference(MakeReadback(width, height, sparsity, static_cast<uint32_t>(width) * 13 + sparsity), width, height, 0);
+        }
+    }
+}
+
+TEST_CASE(StatsRemovePaddingAndFlipRows) {
+    const int width = 70, height = 40, padding = 5;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 0);
+    // Readback row 0 is the bottom of the image: capture y = height - 1 - row - padding
+    SetPixel(rgba, width, 10, 0, 255, 0, 0, 255);
+    SetPixel(rgba, width, 66, 30, 255, 0, 0, 255);
+    CheckMatchesReference(rgba, width, height, padding);
+
+    MirrorContentStats stats;
+    ComputeMirrorContentStats(rgba.data(), width, height, padding, nullptr, stats);
+    CHECK_EQ(stats.minX, 5);
+    CHECK_EQ(stats.maxX, 61);
+    CHECK_EQ(stats.minY, 4);  // Row 30
+    CHECK_EQ(stats.maxY, 34); // Row 0
+    CHECK(std::fabs(stats.centroidX - 33.0f) < 1e-4f);
+    CHECK(std::fabs(stats.centroidY - 19.0f) < 1e-4f);
+
+    CheckMatchesReference(MakeReadback(width, height, 3, 99), width, height, padding);
+}
+
+TEST_CASE(EmptyReadbackHasNoContent) {
+    const std::vector<uint8_t> rgba(64 * 8 * 4, 0);
+    CheckMatchesReference(rgba, 64, 8, 0);
+    MirrorContentStats stats;
+    stats.sequence = 7;
+    ComputeMirrorContentStats(rgba.data(), 64, 8, 0, nullptr, stats);
+    CHECK(stats.valid && !stats.hasContent);
+    CHECK_EQ(stats.maxX, -1);
+    CHECK_EQ(stats.sequence, static_cast<uint64_t>(7)); // Owned by the publisher
+}
+
+TEST_CASE(OverlappingTargetsCountEveryMatch) {
+    const std::vector<Color> targets = { { 1.0f, 0.0f, 0.0f }, { 0.9f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+    const MirrorColorMatchKey key = MakeMirrorColorMatchKey(targets, 0.15f, MirrorGammaMode::AssumeLinear);
+    MirrorColorAttribution attribution;
+    attribution.SetKey(key);
+    CHECK_EQ(attribution.TargetCount(), targets.size());
+
+    std::vector<MirrorColorMatchKey> single;
+    for (const Color& c : targets) single.push_back(MakeMirrorColorMatchKey({ c }, key.sensitivity, key.gammaMode));
+
+    // Reds between the two red targets, pure blue, and colors matching nothing (blended overlaps)
+    const int width = 96, height = 6;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 0);
+    uint32_t state = 3;
+    std::vector<uint64_t> expected(targets.size(), 0);
+    uint64_t expectedUnattributed = 0, matchedBoth = 0;
+    for (int row = 0; row < height; row++) {
+        for (int x = 0; x < width; x++) {
+            const uint32_t kind = NextRandom(state) % 5;
+            if (kind == 0) continue; // No content
+            const uint8_t r = kind <= 2 ? static_cast<uint8_t>(220 + NextRandom(state) % 36) : 0;
+            const uint8_t g = kind == 4 ? 200 : 0;
+            const uint8_t b = kind == 3 ? 255 : 0;
+            SetPixel(rgba, width, x, row, r, g, b, 255);
+            int matches = 0;
+            for (size_t t = 0; t < single.size(); t++) {
+                if (MirrorColorMatchesReference(single[t], r, g, b)) {
+                    expected[t]++;
+                    matches++;
+                }
+            }
+            if (matches == 0) expectedUnattributed++;
+            if (matches >= 2) matchedBoth++;
+        }
+    }
+    CHECK(matchedBoth > 0); // The case under test: a pixel inside both red targets
+    CHECK(expected[2] > 0 && expectedUnattributed > 0);
+
+    for (CpuSimdLevel level : kLevels) {
+        MirrorContentStats stats;
+        ComputeMirrorContentStats(rgba.data(), width, height, 0, &attribution, stats, level);
+        CHECK(stats.targetColorPixels == expected);
+        CHECK_EQ(stats.unattributedPixels, expectedUnattributed);
+        uint64_t perTargetSum = 0;
+        for (uint64_t n : stats.targetColorPixels) perTargetSum += n;
+        CHECK(perTargetSum + stats.unattributedPixels > stats.matchedPixels); // Overlaps counted twice
+    }
+}
+
+TEST_CASE(AttributionCacheFollowsTheKey) {
+    MirrorColorAttribution attribution;
+    attribution.SetKey(MakeMirrorColorMatchKey({ { 1.0f, 0.0f, 0.0f } }, 0.1f, MirrorGammaMode::AssumeLinear));
+    const uint32_t red = 0x000000FFu, blue = 0x00FF0000u;
+    CHECK_EQ(attribution.Classify(red).count, 1u);
+    CHECK_EQ(attribution.Classify(red | 0xFF000000u).count, 1u); // Alpha byte ignored
+    CHECK_EQ(attribution.Classify(blue).count, 0u);
+
+    attribution.SetKey(MakeMirrorColorMatchKey({ { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f } }, 0.1f, MirrorGammaMode::AssumeLinear));
+    const MirrorColorAttribution::Matches blueMatches = attribution.Classify(blue);
+    CHECK_EQ(blueMatches.count, 1u);
+    CHECK_EQ(blueMatches.indices[0], 0u);
+    const MirrorColorAttribution::Matches redMatches = attribution.Classify(red);
+    CHECK_EQ(redMatches.count, 1u);
+    CHECK_EQ(redMatches.indices[0], 1u);
+}
+
+TEST_CASE(PublishedStatsArePerMirror) {
+    MirrorContentStats stats;
+    stats.valid = true;
+    stats.matchedPixels = 42;
+    PublishMirrorContentStats("Pie", stats);
+    PublishMirrorContentStats("Pie", stats);
+    stats.matchedPixels = 5;
+    PublishMirrorContentStats("Counter", stats);
+
+    MirrorContentStats out;
+    CHECK(GetMirrorContentStats("Pie", out));
+    CHECK_EQ(out.matchedPixels, static_cast<uint64_t>(42));
+    CHECK_EQ(out.sequence, static_cast<uint64_t>(2));
+    CHECK(!GetMirrorContentStats("Missing", out));
+
+    const auto all = GetAllMirrorContentStats();
+    CHECK_EQ(all.size(), static_cast<size_t>(2));
+    CHECK_EQ(all[0].first, std::string("Counter")); // Sorted by name
+
+    PruneMirrorContentStats({ "Counter" });
+    CHECK(!GetMirrorContentStats("Pie", out));
+    CHECK(GetMirrorContentStats("Counter", out));
+    PruneMirrorContentStats({});
+    CHECK(GetAllMirrorContentStats().empty());
+}
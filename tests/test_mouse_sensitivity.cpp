@@ -0,0 +1,55 @@
+// ============================================================================
+// TEST_MOUSE_SENSITIVITY.CPP - Published sensitivity and raw packet scaling
+// ============================================================================
+
+#include "mouse_sensitivity.h"
+
+#include "test_util.h"
+
+#include <cstdint>
+
+TEST_CASE(DefaultsToUnitSensitivity) {
+    PublishedMouseSensitivity published;
+    float x = 0.0f, y = 0.0f;
+    published.Load(x, y);
+    CHECK(x == 1.0f && y == 1.0f);
+}
+
+TEST_CASE(PublishRoundTripsBothAxes) {
+    PublishedMouseSensitivity published;
+    published.Publish(0.35f, 2.125f);
+    float x = 0.0f, y = 0.0f;
+    published.Load(x, y);
+    CHECK(x == 0.35f && y == 2.125f);
+    published.Publish(-1.0f, 0.0f);
+    published.Load(x, y);
+    CHECK(x == -1.0f && y == 0.0f);
+}
+
+// One count per packet at 0.3: the output carries 3 counts per 10 packets instead of truncating every packet to 0
+TEST_CASE(AccumulatorKeepsSubCountMotion) {
+    RawMouseAccumulator accumulator;
+    int64_t totalX = 0, totalY = 0;
+    for (int i = 0; i < 8000; i++) {
+        long dx = 1, dy = -1;
+        accumulator.Scale(dx, dy, 0.3f, 0.3f);
+        totalX += dx;
+        totalY += dy;
+    }
+    CHECK(totalX >= 2399 && totalX <= 2400);
+    CHECK(totalY <= -2399 && totalY >= -2400);
+}
+
+// Direction reversals don't leak counts: the remainder stays below one count either way
+TEST_CASE(AccumulatorRemainderStaysBelowOneCount) {
+    RawMouseAccumulator accumulator;
+    const long moves[] = { 7, -3, 1, -1, 12, -20, 2 };
+    for (int lap = 0; lap < 500; lap++) {
+        for (long move : moves) {
+            long dx = move, dy = -move;
+            accumulator.Scale(dx, dy, 0.77f, 1.6f);
+            CHECK(accumulator.x > -1.0f && accumulator.x < 1.0f);
+            CHECK(accumulator.y > -1.0f && accumulator.y < 1.0f);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+// ============================================================================
+// TEST_NV12_CONVERT.CPP - RGBA -> NV12 kernels against the scalar fixed-point math
+// ============================================================================
+// Every SIMD level, banded or not, must produce byte-identical NV12 to the
+// scalar kernel, which in turn must match the per-pixel BT.601 formulas the
+// virtual camera always used. Levels above what this CPU supports resolve to
+// the highest supported one, so they are still exercised, just not distinctly.
+// ============================================================================
+
+#include "nv12_convert.h"
+
+#include "test_util.h"
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const CpuSimdLevel kLevels[] = { CpuSimdLevel::Scalar, CpuSimdLevel::SSE2, CpuSimdLevel::SSE41, CpuSimdLevel::AVX2 };
+
+uint32_t NextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Random pixels, with every tenth channel forced to an extreme so clamping edges are covered
+std::vector<uint8_t> MakeFrame(uint32_t width, uint32_t height, uint32_t seed) {
+    static const uint8_t kExtremes[] = { 0, 1, 127, 128, 254, 255 };
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t state = seed;
+    for (uint8_t& c : rgba) {
+        const uint32_t r = NextRandom(state);
+        c = (r % 10 == 0) ? kExtremes[r / 10 % 6] : static_cast<uint8_t>(r >> 4);
+    }
+    return rgba;
+}
+
+uint8_t Clamp(int32_t v) { return static_cast<uint8_t>(v < 0 ? 0 : v > 255 ? 255 : v); }
+
+// The per-pixel formulas, written independently of the row-pair kernels
+std::vector<uint8_t> ReferenceNV12(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+    std::vector<uint8_t> nv12(static_cast<size_t>(width) * height * 3 / 2);
+    auto pixel = [&](uint32_t x, uint32_t y) { return &rgba[(static_cast<size_t>(height - 1 - y) * width + x) * 4]; };
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            const uint8_t* p = pixel(x, y);
+            nv12[static_cast<size_t>(y) * width + x] = Clamp(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+        }
+    }
+    uint8_t* uv = nv12.data() + static_cast<size_t>(width) * height;
+    for (uint32_t y = 0; y < height; y += 2) {
+        for (uint32_t x = 0; x < width; x += 2) {
+            int32_t sum[3] = {};
+            for (uint32_t dy = 0; dy < 2; dy++) {
+                for (uint32_t dx = 0; dx < 2; dx++) {
+                    for (int c = 0; c < 3; c++) sum[c] += pixel(x + dx, y + dy)[c];
+                }
+            }
+            const int32_t r = (sum[0] + 2) >> 2, g = (sum[1] + 2) >> 2, b = (sum[2] + 2) >> 2;
+            uv[static_cast<size_t>(y / 2) * width + x] = Clamp(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            uv[static_cast<size_t>(y / 2) * width + x + 1] = Clamp(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+    return nv12;
+}
+
+// Converts rgba with the scalar kernel and with level (banded when large enough); number of differing NV12 bytes
+size_t CountNV12Mismatches(const uint8_t* rgba, uint32_t width, uint32_t height, CpuSimdLevel level) {
+    const size_t size = static_cast<size_t>(width) * height * 3 / 2;
+    std::vector<uint8_t> reference(size), converted(size);
+    ConvertRGBAtoNV12Rows(rgba, reference.data(), width, height, 0, height, CpuSimdLevel::Scalar);
+    ConvertRGBAtoNV12(rgba, converted.data(), width, height, level);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < size; i++) mismatches += reference[i] != converted[i];
+    return mismatches;
+}
+
+} // namespace
+
+TEST_CASE(ScalarKernelMatchesReferenceFormulas) {
+    const uint32_t sizes[][2] = { { 2, 2 }, { 6, 4 }, { 34, 6 }, { 320, 180 } };
+    for (const auto& size : sizes) {
+        const std::vector<uint8_t> rgba = MakeFrame(size[0], size[1], size[0] * 31 + size[1]);
+        std::vector<uint8_t> nv12(static_cast<size_t>(size[0]) * size[1] * 3 / 2);
+        ConvertRGBAtoNV12Rows(rgba.data(), nv12.data(), size[0], size[1], 0, size[1], CpuSimdLevel::Scalar);
+        CHECK(nv12 == ReferenceNV12(rgba, size[0], size[1]));
+    }
+}
+
+TEST_CASE(EveryLevelMatchesScalarAtEveryTailWidth) {
+    // Widths around the 8- and 16-pixel SIMD steps, so each kernel's scalar/SSE2 tail runs at every length
+    for (uint32_t width = 2; width <= 70; width += 2) {
+        for (uint32_t height : { 2u, 4u, 10u }) {
+            const std::vector<uint8_t> rgba = MakeFrame(width, height, width * 7 + height);
+            for (CpuSimdLevel level : kLevels) CHECK_EQ(CountNV12Mismatches(rgba.data(), width, height, level), static_cast<size_t>(0));
+        }
+    }
+}
+
+TEST_CASE(SaturatedAndGrayFramesMatchScalar) {
+    const uint32_t width = 64, height = 4;
+    for (uint8_t value : { 0, 16, 128, 235, 255 }) {
+        const std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, value);
+        for (CpuSimdLevel level : kLevels) CHECK_EQ(CountNV12Mismatches(rgba.data(), width, height, level), static_cast<size_t>(0));
+    }
+    // Pure primaries and their complements: the chroma extremes
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 0);
+    for (size_t p = 0; p < rgba.size() / 4; p++) {
+        const uint32_t pattern = static_cast<uint32_t>(p % 6) + 1; // 1..6: R, G, RG, B, RB, GB
+        for (int c = 0; c < 3; c++) rgba[p * 4 + c] = (pattern >> c & 1) ? 255 : 0;
+    }
+    for (CpuSimdLevel level : kLevels) CHECK_EQ(CountNV12Mismatches(rgba.data(), width, height, level), static_cast<size_t>(0));
+}
+
+TEST_CASE(KernelsStayInsideTheOutputBuffer) {
+    const uint32_t width = 46, height = 6;
+    const size_t size = static_cast<size_t>(width) * height * 3 / 2;
+    const std::vector<uint8_t> rgba = MakeFrame(width, height, 5);
+    for (CpuSimdLevel level : kLevels) {
+        std::vector<uint8_t> nv12(size + 64, 0xCD);
+        ConvertRGBAtoNV12(rgba.data(), nv12.data(), width, height, level);
+        for (size_t i = size; i < nv12.size(); i++) CHECK_EQ(nv12[i], 0xCD);
+    }
+}
+
+TEST_CASE(BandedFramesMatchScalar) {
+    // 1280x720 is the smallest banded frame; 1282x722 gives uneven bands and kernel tails
+    const uint32_t sizes[][2] = { { 1280, 720 }, { 1282, 722 }, { 1920, 1080 }, { 2560, 1440 } };
+    for (const auto& size : sizes) {
+        const std::vector<uint8_t> rgba = MakeFrame(size[0], size[1], size[0] + size[1]);
+        for (CpuSimdLevel level : kLevels) CHECK_EQ(CountNV12Mismatches(rgba.data(), size[0], size[1], level), static_cast<size_t>(0));
+    }
+}
+
+TEST_CASE(RowRangesComposeToTheFullFrame) {
+    const uint32_t width = 98, height = 40;
+    const std::vector<uint8_t> rgba = MakeFrame(width, height, 9);
+    const std::vector<uint8_t> expected = ReferenceNV12(rgba, width, height);
+    for (CpuSimdLevel level : kLevels) {
+        std::vector<uint8_t> nv12(expected.size(), 0);
+        const uint32_t bounds[] = { 0, 2, 12, 14, 30, height };
+        for (size_t i = 0; i + 1 < sizeof(bounds) / sizeof(bounds[0]); i++) {
+            ConvertRGBAtoNV12Rows(rgba.data(), nv12.data(), width, height, bounds[i], bounds[i + 1], level);
+        }
+        CHECK(nv12 == expected);
+    }
+}
+
+TEST_CASE(ConcurrentCallersAndWorkerRestart) {
+    const uint32_t width = 1920, height = 1080;
+    const std::vector<uint8_t> rgba = MakeFrame(width, height, 77);
+    const std::vector<uint8_t> expected = ReferenceNV12(rgba, width, height);
+
+    // Callers share one worker pool: jobs must queue up rather than mix bands
+    auto convertRepeatedly = [&](bool& exact) {
+        std::vector<uint8_t> nv12(expected.size());
+        exact = true;
+        for (int i = 0; i < 10; i++) {
+            ConvertRGBAtoNV12(rgba.data(), nv12.data(), width, height);
+            exact = exact && nv12 == expected;
+        }
+    };
+    bool exactA = false, exactB = false;
+    std::thread a(convertRepeatedly, std::ref(exactA));
+    std::thread b(convertRepeatedly, std::ref(exactB));
+    a.join();
+    b.join();
+    CHECK(exactA && exactB);
+
+    // Workers are joined at shutdown and started again by the next banded conversion
+    ShutdownNV12ConversionWorkers();
+    std::vector<uint8_t> nv12(expected.size());
+    ConvertRGBAtoNV12(rgba.data(), nv12.data(), width, height);
+    CHECK(nv12 == expected);
+    ShutdownNV12ConversionWorkers();
+}
@@ -0,0 +1,200 @@
+// ============================================================================
+// TEST_RING_BUFFER.CPP - LockFreeRing semantics and multithreaded stress
+// ============================================================================
+// The single-threaded cases pin down ordering, wraparound, the full-queue
+// policies and batch pop. The stress cases run real producer/consumer
+// threads and check that every element arrives exactly once and in per-
+// producer order; configure with -DTOOLSCREEN_TSAN=ON to run them under
+// ThreadSanitizer.
+// ============================================================================
+
+#include "ring_buffer.h"
+
+#include "test_util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Element carrying its producer and per-producer sequence number
+struct Tagged {
+    uint32_t producer = 0;
+    uint32_t seq = 0;
+};
+
+const uint32_t kStressPerProducer = 200000;
+
+// Producer loop that retries a DropNewest ring until the element fits
+template <typename Ring> void ProduceAll(Ring& ring, uint32_t producer, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        while (!ring.Push(Tagged{ producer, i })) std::this_thread::yield();
+    }
+}
+
+// Consumes until `total` elements have been seen across all consumers, checking per-producer order.
+// Returns the per-producer counts this consumer saw.
+template <typename Ring>
+std::vector<uint32_t> ConsumeChecked(Ring& ring, size_t producers, std::atomic<uint64_t>& consumedTotal, uint64_t total,
+                                     std::atomic<bool>& orderOk) {
+    std::vector<uint32_t> seen(producers, 0);
+    std::vector<int64_t> last(producers, -1);
+    Tagged item;
+    while (consumedTotal.load(std::memory_order_relaxed) < total) {
+        if (!ring.TryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (static_cast<int64_t>(item.seq) <= last[item.producer]) orderOk.store(false, std::memory_order_relaxed);
+        last[item.producer] = item.seq;
+        seen[item.producer]++;
+        consumedTotal.fetch_add(1, std::memory_order_relaxed);
+    }
+    return seen;
+}
+
+// Runs `producers` x `consumers` threads over ring and checks exactly-once delivery and per-producer order
+template <typename Ring> void RunStress(Ring& ring, size_t producers, size_t consumers) {
+    const uint64_t total = static_cast<uint64_t>(producers) * kStressPerProducer;
+    std::atomic<uint64_t> consumedTotal{ 0 };
+    std::atomic<bool> orderOk{ true };
+    std::vector<std::vector<uint32_t>> seen(consumers);
+
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c] { seen[c] = ConsumeChecked(ring, producers, consumedTotal, total, orderOk); });
+    }
+    for (size_t p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] { ProduceAll(ring, static_cast<uint32_t>(p), kStressPerProducer); });
+    }
+    for (std::thread& t : threads) t.join();
+
+    CHECK(orderOk.load());
+    for (size_t p = 0; p < producers; p++) {
+        uint64_t received = 0;
+        for (size_t c = 0; c < consumers; c++) received += seen[c][p];
+        CHECK_EQ(received, static_cast<uint64_t>(kStressPerProducer));
+    }
+    Tagged leftover;
+    CHECK(!ring.TryPop(leftover));
+}
+
+} // namespace
+
+TEST_CASE(PopsInPushOrderAcrossLaps) {
+    SpscRing<int, 4> ring;
+    int next = 0, expected = 0;
+    for (int lap = 0; lap < 100; lap++) {
+        for (int i = 0; i < 3; i++) CHECK(ring.Push(next++));
+        int value = -1;
+        for (int i = 0; i < 3; i++) {
+            CHECK(ring.TryPop(value));
+            CHECK_EQ(value, expected++);
+        }
+    }
+    int value = 0;
+    CHECK(!ring.TryPop(value));
+}
+
+TEST_CASE(DropNewestRejectsWhenFull) {
+    MpscRing<int, 4> ring;
+    for (int i = 0; i < 4; i++) CHECK(ring.Push(i));
+    CHECK_EQ(ring.SizeApprox(), static_cast<size_t>(4));
+    CHECK(!ring.Push(99));
+    int value = -1;
+    CHECK(ring.TryPop(value));
+    CHECK_EQ(value, 0);
+    CHECK(ring.Push(4));
+    std::vector<int> rest;
+    ring.ConsumeAll([&](int& v) { rest.push_back(v); });
+    CHECK(rest == std::vector<int>({ 1, 2, 3, 4 }));
+}
+
+TEST_CASE(OverwriteOldestEvictsInOrder) {
+    SpscRing<int, 2, RingFullPolicy::OverwriteOldest> ring;
+    std::vector<int> evicted;
+    for (int i = 0; i < 5; i++) CHECK(ring.Push(i, [&](int& v) { evicted.push_back(v); }));
+    CHECK(evicted == std::vector<int>({ 0, 1, 2 }));
+    int value = -1;
+    CHECK(ring.TryPop(value) && value == 3);
+    CHECK(ring.TryPop(value) && value == 4);
+    CHECK(ring.EmptyApprox());
+}
+
+TEST_CASE(ConsumeAllHonorsMaxItems) {
+    SpscRing<int, 8> ring;
+    for (int i = 0; i < 6; i++) ring.Push(i);
+    std::vector<int> batch;
+    CHECK_EQ(ring.ConsumeAll([&](int& v) { batch.push_back(v); }, 4), static_cast<size_t>(4));
+    CHECK(batch == std::vector<int>({ 0, 1, 2, 3 }));
+    CHECK_EQ(ring.SizeApprox(), static_cast<size_t>(2));
+    ring.Clear();
+    CHECK(ring.EmptyApprox());
+    CHECK_EQ(ring.ConsumeAll([&](int&) {}), static_cast<size_t>(0));
+}
+
+// Static rings (the log buffer, ImGui input queue) rely on all-zero storage being a valid empty ring
+TEST_CASE(ZeroInitializedStorageIsEmpty) {
+    static MpmcRing<int, 16> s_ring;
+    int value = 0;
+    CHECK(!s_ring.TryPop(value));
+    CHECK(s_ring.Push(7));
+    CHECK(s_ring.TryPop(value) && value == 7);
+}
+
+TEST_CASE(SpscStress) {
+    static SpscRing<Tagged, 64> s_ring;
+    RunStress(s_ring, 1, 1);
+}
+
+TEST_CASE(MpscStress) {
+    static MpscRing<Tagged, 64> s_ring;
+    RunStress(s_ring, 4, 1);
+}
+
+// The ImGui input queue and profiler buffers: one producer, Clear()/drain from other threads
+TEST_CASE(SpmcStress) {
+    static LockFreeRing<Tagged, 64, RingProducers::Single, RingConsumers::Multi> s_ring;
+    RunStress(s_ring, 1, 3);
+}
+
+TEST_CASE(MpmcStress) {
+    static MpmcRing<Tagged, 64> s_ring;
+    RunStress(s_ring, 3, 3);
+}
+
+// Capture-queue shape: the producer never blocks, so pushed == popped + evicted, and the consumer
+// still sees the survivors in order
+TEST_CASE(OverwriteOldestStress) {
+    static SpscRing<Tagged, 2, RingFullPolicy::OverwriteOldest> s_ring;
+    std::atomic<bool> done{ false };
+    std::atomic<bool> orderOk{ true };
+    uint64_t evicted = 0, popped = 0;
+
+    std::thread consumer([&] {
+        int64_t last = -1;
+        Tagged item;
+        for (;;) {
+            const bool finished = done.load(std::memory_order_acquire);
+            if (s_ring.TryPop(item)) {
+                if (static_cast<int64_t>(item.seq) <= last) orderOk.store(false, std::memory_order_relaxed);
+                last = item.seq;
+                popped++;
+            } else if (finished) {
+                break;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    bool pushesOk = true;
+    for (uint32_t i = 0; i < kStressPerProducer; i++) pushesOk &= s_ring.Push(Tagged{ 0, i }, [&](Tagged&) { evicted++; });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    CHECK(pushesOk);
+    CHECK(orderOk.load());
+    CHECK_EQ(popped + evicted, static_cast<uint64_t>(kStressPerProducer));
+}
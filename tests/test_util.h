@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// TEST_UTIL.H - Minimal unit test harness for the tests/ targets
+// ============================================================================
+// No third-party framework. A test executable defines TEST_CASEs and links
+// test_main.cpp, which runs every case (or the cases named on the command
+// line) and exits non-zero if any CHECK failed. A failed CHECK ends its case.
+// ============================================================================
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<TestCase>& TestRegistry() {
+    static std::vector<TestCase> s_cases;
+    return s_cases;
+}
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*fn)()) { TestRegistry().push_back({ name, fn }); }
+};
+
+struct TestFailure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+#define TEST_CASE(name)                                                                                                          \
+    static void name();                                                                                                          \
+    static TestRegistrar name##_registrar(#name, name);                                                                          \
+    static void name()
+
+#define CHECK(cond)                                                                                                              \
+    do {                                                                                                                         \
+        if (!(cond)) {                                                                                                           \
+            std::ostringstream _msg;                                                                                             \
+            _msg << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed";                                                   \
+            throw TestFailure(_msg.str());                                                                                       \
+        }                                                                                                                        \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                                                           \
+    do {                                                                                                                         \
+        const auto& _a = (a);                                                                                                    \
+        const auto& _b = (b);                                                                                                    \
+        if (!(_a == _b)) {                                                                                                       \
+            std::ostringstream _msg;                                                                                             \
+            _msg << __FILE__ << ":" << __LINE__ << ": CHECK_EQ(" #a ", " #b ") failed: " << _a << " vs " << _b;                    \
+            throw TestFailure(_msg.str());                                                                                       \
+        }                                                                                                                        \
+    } while (0)
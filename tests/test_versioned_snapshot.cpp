@@ -0,0 +1,172 @@
+// ============================================================================
+// TEST_VERSIONED_SNAPSHOT.CPP - Seqlock snapshot semantics and torture test
+// ============================================================================
+// The torture cases run several writers publishing self-consistent payloads
+// (every field derived from one counter) while readers check each copy they
+// get for tearing and version monotonicity. Configure with
+// -DTOOLSCREEN_TSAN=ON to run them under ThreadSanitizer.
+// ============================================================================
+
+#include "versioned_snapshot.h"
+
+#include "test_util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Large enough that a copy spans several cache lines and is easy to interrupt
+struct WidePayload {
+    uint64_t stamp = 0;
+    uint64_t words[23] = {};
+    uint32_t check = 0;
+
+    static WidePayload From(uint64_t stamp) {
+        WidePayload p;
+        p.stamp = stamp;
+        for (size_t i = 0; i < 23; i++) p.words[i] = stamp * 31 + i;
+        p.check = static_cast<uint32_t>(stamp ^ 0xA5A5A5A5u);
+        return p;
+    }
+    bool Consistent() const {
+        for (size_t i = 0; i < 23; i++) {
+            if (words[i] != stamp * 31 + i) return false;
+        }
+        return check == static_cast<uint32_t>(stamp ^ 0xA5A5A5A5u);
+    }
+};
+
+// Not a multiple of the word size, like the fixed-buffer text payloads (GameStateText)
+struct TextPayload {
+    char text[37] = {};
+
+    static TextPayload From(uint32_t n) {
+        TextPayload p;
+        std::memset(p.text, 'a' + static_cast<char>(n % 26), sizeof(p.text) - 1);
+        return p;
+    }
+    bool Consistent() const {
+        for (size_t i = 1; i + 1 < sizeof(text); i++) {
+            if (text[i] != text[0]) return false;
+        }
+        return text[sizeof(text) - 1] == '\0';
+    }
+};
+
+const int kWritesPerWriter = 50000;
+
+template <typename T, typename MakeFn>
+void Torture(VersionedSnapshot<T>& snapshot, int writers, int readers, MakeFn&& make) {
+    std::atomic<int> writersDone{ 0 };
+    std::atomic<bool> torn{ false };
+    std::atomic<bool> versionWentBack{ false };
+    std::atomic<uint64_t> reads{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&] {
+            uint64_t lastVersion = 0, count = 0;
+            while (writersDone.load(std::memory_order_acquire) < writers) {
+                uint64_t version = 0;
+                const T value = snapshot.Load(version);
+                if (!value.Consistent()) torn.store(true, std::memory_order_relaxed);
+                if (version < lastVersion) versionWentBack.store(true, std::memory_order_relaxed);
+                lastVersion = version;
+                count++;
+                if ((count & 63) == 0) std::this_thread::yield(); // Let writers interleave on few cores
+            }
+            reads.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < kWritesPerWriter; i++) {
+                snapshot.Publish(make(static_cast<uint32_t>(w * kWritesPerWriter + i)));
+                if ((i & 255) == 0) std::this_thread::yield();
+            }
+            writersDone.fetch_add(1, std::memory_order_release);
+        });
+    }
+    for (std::thread& t : threads) t.join();
+
+    CHECK(!torn.load());
+    CHECK(!versionWentBack.load());
+    CHECK(reads.load() > 0);
+    CHECK_EQ(snapshot.Version(), static_cast<uint64_t>(writers) * kWritesPerWriter);
+    CHECK(snapshot.Load().Consistent());
+}
+
+} // namespace
+
+TEST_CASE(LoadReturnsInitialValue) {
+    VersionedSnapshot<WidePayload> snapshot(WidePayload::From(7));
+    uint64_t version = 99;
+    CHECK_EQ(snapshot.Load(version).stamp, static_cast<uint64_t>(7));
+    CHECK_EQ(version, static_cast<uint64_t>(0));
+}
+
+TEST_CASE(PublishBumpsVersion) {
+    VersionedSnapshot<TextPayload> snapshot;
+    snapshot.Publish(TextPayload::From(1));
+    snapshot.Publish(TextPayload::From(2));
+    CHECK_EQ(snapshot.Version(), static_cast<uint64_t>(2));
+    CHECK_EQ(snapshot.Load().text[0], 'c');
+}
+
+TEST_CASE(AbandonedUpdateKeepsVersion) {
+    VersionedSnapshot<WidePayload> snapshot(WidePayload::From(3));
+    CHECK(!snapshot.Update([](WidePayload& p) {
+        p = WidePayload::From(4);
+        return false;
+    }));
+    CHECK_EQ(snapshot.Version(), static_cast<uint64_t>(0));
+    CHECK_EQ(snapshot.Load().stamp, static_cast<uint64_t>(3));
+    CHECK(snapshot.Update([](WidePayload& p) {
+        p = WidePayload::From(p.stamp + 1);
+        return true;
+    }));
+    CHECK_EQ(snapshot.Version(), static_cast<uint64_t>(1));
+    CHECK_EQ(snapshot.Load().stamp, static_cast<uint64_t>(4));
+}
+
+TEST_CASE(TortureSingleWriter) {
+    static VersionedSnapshot<WidePayload> s_snapshot(WidePayload::From(0));
+    Torture(s_snapshot, 1, 3, [](uint32_t n) { return WidePayload::From(n); });
+}
+
+// Back-to-back writes from several threads: the case that tore the old two-slot buffers
+TEST_CASE(TortureManyWriters) {
+    static VersionedSnapshot<WidePayload> s_snapshot(WidePayload::From(0));
+    Torture(s_snapshot, 3, 3, [](uint32_t n) { return WidePayload::From(n); });
+}
+
+TEST_CASE(TortureOddSizedPayload) {
+    static VersionedSnapshot<TextPayload> s_snapshot(TextPayload::From(0));
+    Torture(s_snapshot, 2, 2, [](uint32_t n) { return TextPayload::From(n); });
+}
+
+// Writers are mutually exclusive: concurrent read-modify-write updates never lose an increment
+TEST_CASE(ConcurrentUpdatesDoNotLoseWrites) {
+    static VersionedSnapshot<WidePayload> s_snapshot(WidePayload::From(0));
+    const int threadCount = 4, perThread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < perThread; i++) {
+                s_snapshot.Update([](WidePayload& p) {
+                    p = WidePayload::From(p.stamp + 1);
+                    return true;
+                });
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    const WidePayload final = s_snapshot.Load();
+    CHECK(final.Consistent());
+    CHECK_EQ(final.stamp, static_cast<uint64_t>(threadCount) * perThread);
+    CHECK_EQ(s_snapshot.Version(), static_cast<uint64_t>(threadCount) * perThread);
+}